@@ -0,0 +1,934 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A reverse-mode autograd tape.  Operations on tensors are run as they are recorded, and Backward() walks the record in reverse
+ *	to find the gradient of 1 result with respect to every variable that led to it.
+ */
+
+#include "NN9Tape.h"
+#include "../Buffers/NN9BufferManager.h"
+#include "../Ops/NN9Gemm.h"
+#include "../Ops/NN9Math.h"
+#include "../Ops/NN9Softmax.h"
+#include "../Utilities/NN9ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+
+namespace nn9 {
+
+	/**
+	 * Calls a function with a zero of the C++ type matching a tape type.
+	 *
+	 * \param _tType The type, NN9_T_FLOAT or NN9_T_DOUBLE.
+	 * \param _fFunc The function to call.
+	 **/
+	template <typename _tFunc>
+	static inline void Dispatch( NN9_TYPE _tType, const _tFunc &_fFunc ) {
+		if ( _tType == NN9_T_DOUBLE ) { _fFunc( double( 0 ) ); }
+		else { _fFunc( float( 0 ) ); }
+	}
+
+	/**
+	 * Calls a function over [0, _sTotal), splitting the range over the ThreadPool when there is enough work.
+	 *
+	 * \param _sTotal The size of the range.
+	 * \param _sCost The number of elements touched by each index.
+	 * \param _fFunc The function to call with the start and end of each subrange.
+	 **/
+	template <typename _tFunc>
+	static inline void ForEach( size_t _sTotal, size_t _sCost, const _tFunc &_fFunc ) {
+		const size_t sGrain = std::max<size_t>( 1, Tape::NN9_TP_PARALLEL_ELEMENTS / std::max<size_t>( 1, _sCost ) );
+		if ( _sTotal > sGrain ) { ThreadPool::Global().ParallelFor( 0, _sTotal, sGrain, _fFunc ); }
+		else if ( _sTotal ) { _fFunc( size_t( 0 ), _sTotal ); }
+	}
+
+	/**
+	 * Writes or adds an element-wise contribution into a gradient.
+	 *
+	 * \param _ptDst The gradient.
+	 * \param _sTotal The number of elements.
+	 * \param _bAdd If true, the contribution is added; otherwise it overwrites the gradient.
+	 * \param _fFunc The function returning the contribution to element I.
+	 **/
+	template <typename _tType, typename _tFunc>
+	static inline void Accumulate( _tType * _ptDst, size_t _sTotal, bool _bAdd, const _tFunc &_fFunc ) {
+		ForEach( _sTotal, 1, [&]( size_t _sBegin, size_t _sEnd ) {
+			if ( _bAdd ) {
+				for ( size_t I = _sBegin; I < _sEnd; ++I ) { _ptDst[I] += _fFunc( I ); }
+			}
+			else {
+				for ( size_t I = _sBegin; I < _sEnd; ++I ) { _ptDst[I] = _fFunc( I ); }
+			}
+		} );
+	}
+
+	// == Members.
+	Tape::Tape() :
+		m_ui64PeakMemory( 0 ),
+		m_bRun( false ) {
+	}
+	Tape::~Tape() {
+	}
+
+	// == Functions.
+	/**
+	 * Records a tensor that is not the result of a recorded operation, such as an input or a parameter.  The tape shares the tensor's
+	 *	buffer and never modifies it.
+	 *
+	 * \param _tValue The tensor to record.  It must be contiguous.
+	 * \param _bRequiresGrad If true, a gradient buffer is allocated now and filled by Backward().
+	 * \throw Throws if the tensor is not float or double or is not contiguous.
+	 * \return Returns the index of the new variable.
+	 **/
+	size_t Tape::Leaf( const Tensor &_tValue, bool _bRequiresGrad ) {
+		CheckRecord( _tValue.Type(), "Tape::Leaf" );
+		if ( !_tValue.IsContiguous() ) { throw std::invalid_argument( "Tape::Leaf: The tensor must be contiguous." ); }
+		NN9_NODE nNode;
+		nNode.upValue = std::make_unique<Tensor>( _tValue.Contiguous() );
+		nNode.vShape = _tValue.Shape();
+		nNode.tType = _tValue.Type();
+		nNode.bRequiresGrad = _bRequiresGrad;
+		if ( _bRequiresGrad ) { nNode.upGrad = NewTensor( nNode.vShape, nNode.tType ); }
+		m_vNodes.push_back( std::move( nNode ) );
+		return m_vNodes.size() - 1;
+	}
+
+	/**
+	 * Records a tensor that is not the result of a recorded operation and whose gradient is added into a caller-owned buffer.  The buffer
+	 *	is never cleared by the tape, so gradients accumulate across tapes until the caller clears it.
+	 *
+	 * \param _tValue The tensor to record.  It must be contiguous.
+	 * \param _tGrad The gradient buffer.  It must be contiguous and have the shape and type of _tValue.
+	 * \throw Throws if the tensor is not float or double or is not contiguous, or if the gradient does not match it.
+	 * \return Returns the index of the new variable.
+	 **/
+	size_t Tape::Leaf( const Tensor &_tValue, Tensor &_tGrad ) {
+		CheckRecord( _tValue.Type(), "Tape::Leaf" );
+		if ( !_tValue.IsContiguous() ) { throw std::invalid_argument( "Tape::Leaf: The tensor must be contiguous." ); }
+		if ( _tGrad.Type() != _tValue.Type() || _tGrad.Shape() != _tValue.Shape() || !_tGrad.IsContiguous() ) {
+			throw std::invalid_argument( "Tape::Leaf: The gradient must be contiguous and have the shape and type of the value." );
+		}
+		NN9_NODE nNode;
+		nNode.upValue = std::make_unique<Tensor>( _tValue.Contiguous() );
+		nNode.upGrad = std::make_unique<Tensor>( _tGrad.Contiguous() );
+		nNode.vShape = _tValue.Shape();
+		nNode.tType = _tValue.Type();
+		nNode.bRequiresGrad = true;
+		nNode.bGradWritten = true;
+		m_vNodes.push_back( std::move( nNode ) );
+		return m_vNodes.size() - 1;
+	}
+
+	/**
+	 * Records a + b with NumPy-style broadcasting.
+	 *
+	 * \param _sA The left variable.
+	 * \param _sB The right variable.
+	 * \throw Throws if a variable is invalid or released, the types differ, or the shapes cannot be broadcast together.
+	 * \return Returns the index of the result.
+	 **/
+	size_t Tape::Add( size_t _sA, size_t _sB ) { return Binary( NN9_TO_ADD, _sA, _sB, "Tape::Add" ); }
+
+	/**
+	 * Records a - b with NumPy-style broadcasting.
+	 *
+	 * \param _sA The left variable.
+	 * \param _sB The right variable.
+	 * \throw Throws if a variable is invalid or released, the types differ, or the shapes cannot be broadcast together.
+	 * \return Returns the index of the result.
+	 **/
+	size_t Tape::Sub( size_t _sA, size_t _sB ) { return Binary( NN9_TO_SUB, _sA, _sB, "Tape::Sub" ); }
+
+	/**
+	 * Records a * b (element-wise) with NumPy-style broadcasting.
+	 *
+	 * \param _sA The left variable.
+	 * \param _sB The right variable.
+	 * \throw Throws if a variable is invalid or released, the types differ, or the shapes cannot be broadcast together.
+	 * \return Returns the index of the result.
+	 **/
+	size_t Tape::Mul( size_t _sA, size_t _sB ) { return Binary( NN9_TO_MUL, _sA, _sB, "Tape::Mul" ); }
+
+	/**
+	 * Records the matrix product of an [M, K] variable and a [K, N] variable.
+	 *
+	 * \param _sA The left variable.
+	 * \param _sB The right variable.
+	 * \throw Throws if a variable is invalid or released, the types differ, or the shapes do not agree.
+	 * \return Returns the index of the [M, N] result.
+	 **/
+	size_t Tape::MatMul( size_t _sA, size_t _sB ) {
+		NN9_NODE & nA = Input( _sA, "Tape::MatMul" );
+		NN9_NODE & nB = Input( _sB, "Tape::MatMul" );
+		CheckRecord( nA.tType, "Tape::MatMul" );
+		if ( nB.tType != nA.tType ) { throw std::invalid_argument( "Tape::MatMul: Both variables must have the same type." ); }
+		if ( nA.vShape.size() != 2 || nB.vShape.size() != 2 || nA.vShape[1] != nB.vShape[0] ) {
+			throw std::invalid_argument( "Tape::MatMul: The variables must be [M, K] and [K, N]." );
+		}
+		const size_t sM = nA.vShape[0], sK = nA.vShape[1], sN = nB.vShape[1];
+		std::unique_ptr<Tensor> upOut = NewTensor( { sM, sN }, nA.tType );
+		Dispatch( nA.tType, [&]( auto _tZero ) {
+			using Type = decltype( _tZero );
+			StridedView<Type> svA = nA.upValue->Strided<Type>(), svB = nB.upValue->Strided<Type>(), svOut = upOut->Strided<Type>();
+			Gemm::Run<Type>( sM, sN, sK, svA.Data(), sK, 1, svB.Data(), sN, 1, svOut.Data(), sN, 1 );
+		} );
+		return Record( NN9_TO_MATMUL, std::move( upOut ), _sA, _sB );
+	}
+
+	/**
+	 * Records max( a, 0 ).
+	 *
+	 * \param _sA The input variable.
+	 * \throw Throws if the variable is invalid or released.
+	 * \return Returns the index of the result.
+	 **/
+	size_t Tape::Relu( size_t _sA ) { return Unary( NN9_TO_RELU, _sA, 0, "Tape::Relu" ); }
+
+	/**
+	 * Records tanh( a ).
+	 *
+	 * \param _sA The input variable.
+	 * \throw Throws if the variable is invalid or released.
+	 * \return Returns the index of the result.
+	 **/
+	size_t Tape::Tanh( size_t _sA ) { return Unary( NN9_TO_TANH, _sA, 0, "Tape::Tanh" ); }
+
+	/**
+	 * Records the softmax of a along 1 axis.
+	 *
+	 * \param _sA The input variable.
+	 * \param _sAxis The axis along which the results sum to 1.
+	 * \throw Throws if the variable is invalid or released or the axis is out of range.
+	 * \return Returns the index of the result.
+	 **/
+	size_t Tape::Softmax( size_t _sA, size_t _sAxis ) { return Unary( NN9_TO_SOFTMAX, _sA, _sAxis, "Tape::Softmax" ); }
+
+	/**
+	 * Records the log-softmax of a along 1 axis.
+	 *
+	 * \param _sA The input variable.
+	 * \param _sAxis The axis along which the exponentials of the results sum to 1.
+	 * \throw Throws if the variable is invalid or released or the axis is out of range.
+	 * \return Returns the index of the result.
+	 **/
+	size_t Tape::LogSoftmax( size_t _sA, size_t _sAxis ) { return Unary( NN9_TO_LOG_SOFTMAX, _sA, _sAxis, "Tape::LogSoftmax" ); }
+
+	/**
+	 * Records the sum of every element of a.
+	 *
+	 * \param _sA The input variable.
+	 * \throw Throws if the variable is invalid or released.
+	 * \return Returns the index of the { 1 } result.
+	 **/
+	size_t Tape::Sum( size_t _sA ) { return Reduce( NN9_TO_SUM, _sA, "Tape::Sum" ); }
+
+	/**
+	 * Records the mean of every element of a.
+	 *
+	 * \param _sA The input variable.
+	 * \throw Throws if the variable is invalid or released or empty.
+	 * \return Returns the index of the { 1 } result.
+	 **/
+	size_t Tape::Mean( size_t _sA ) { return Reduce( NN9_TO_MEAN, _sA, "Tape::Mean" ); }
+
+	/**
+	 * Records a with a new shape.  The result shares a's buffer.
+	 *
+	 * \param _sA The input variable.
+	 * \param _vShape The new shape, with the same number of elements.
+	 * \throw Throws if the variable is invalid or released or the number of elements differs.
+	 * \return Returns the index of the result.
+	 **/
+	size_t Tape::Reshape( size_t _sA, const std::vector<size_t> &_vShape ) {
+		NN9_NODE & nA = Input( _sA, "Tape::Reshape" );
+		CheckRecord( nA.tType, "Tape::Reshape" );
+		if ( _vShape.empty() || Elements( _vShape ) != Elements( nA.vShape ) ) {
+			throw std::invalid_argument( "Tape::Reshape: The new shape must have the same number of elements." );
+		}
+		return Record( NN9_TO_RESHAPE, std::make_unique<Tensor>( nA.upValue->Reshape( _vShape ) ), _sA );
+	}
+
+	/**
+	 * Records a 2-D convolution (see Conv2D::Forward()).
+	 *
+	 * \param _sIn The [N, C, H, W] input variable.
+	 * \param _sWeights The [O, C/Groups, Kh, Kw] weight variable.
+	 * \param _sBias The [O] bias variable, or NN9_TP_NONE.
+	 * \param _cpParms The convolution parameters.
+	 * \throw Throws if a variable is invalid or released, the types differ, or the shapes do not agree.
+	 * \return Returns the index of the [N, O, Oh, Ow] result.
+	 **/
+	size_t Tape::Convolve( size_t _sIn, size_t _sWeights, size_t _sBias, const Conv2D::NN9_CONV2D_PARAMS &_cpParms ) {
+		NN9_NODE & nIn = Input( _sIn, "Tape::Convolve" );
+		NN9_NODE & nW = Input( _sWeights, "Tape::Convolve" );
+		NN9_NODE * pnBias = _sBias == NN9_TP_NONE ? nullptr : &Input( _sBias, "Tape::Convolve" );
+		CheckRecord( nIn.tType, "Tape::Convolve" );
+		if ( nW.tType != nIn.tType || (pnBias && pnBias->tType != nIn.tType) ) {
+			throw std::invalid_argument( "Tape::Convolve: Every variable must have the same type." );
+		}
+		if ( nIn.vShape.size() != 4 || nW.vShape.size() != 4 ) {
+			throw std::invalid_argument( "Tape::Convolve: The input and weights must have 4 dimensions." );
+		}
+		std::unique_ptr<Tensor> upOut = NewTensor( { nIn.vShape[0], nW.vShape[0],
+			Conv2D::OutputSize( nIn.vShape[2], nW.vShape[2], _cpParms.sStrideH, _cpParms.sPadH, _cpParms.sDilationH ),
+			Conv2D::OutputSize( nIn.vShape[3], nW.vShape[3], _cpParms.sStrideW, _cpParms.sPadW, _cpParms.sDilationW ) }, nIn.tType );
+		Dispatch( nIn.tType, [&]( auto _tZero ) {
+			using Type = decltype( _tZero );
+			StridedView<Type> svIn = nIn.upValue->Strided<Type>(), svW = nW.upValue->Strided<Type>(), svOut = upOut->Strided<Type>();
+			if ( pnBias ) {
+				StridedView<Type> svBias = pnBias->upValue->Strided<Type>();
+				Conv2D::Forward<Type>( svIn, svW, &svBias, svOut, _cpParms );
+			}
+			else { Conv2D::Forward<Type>( svIn, svW, nullptr, svOut, _cpParms ); }
+		} );
+		size_t sRet = Record( NN9_TO_CONV2D, std::move( upOut ), _sIn, _sWeights, _sBias );
+		m_vNodes[sRet].cpParms = _cpParms;
+		return sRet;
+	}
+
+	/**
+	 * Records the mean negative log-likelihood of the labelled class of each row of an [N, C] variable of log-probabilities, such as the
+	 *	output of LogSoftmax( X, 1 ).
+	 *
+	 * \param _sLogProbs The [N, C] input variable.
+	 * \param _vLabels The class of each row.
+	 * \throw Throws if the variable is invalid or released, it is not 2-D, or the labels do not match its rows and columns.
+	 * \return Returns the index of the { 1 } result.
+	 **/
+	size_t Tape::Nll( size_t _sLogProbs, const std::vector<size_t> &_vLabels ) {
+		NN9_NODE & nA = Input( _sLogProbs, "Tape::Nll" );
+		CheckRecord( nA.tType, "Tape::Nll" );
+		if ( nA.vShape.size() != 2 || !nA.vShape[0] || _vLabels.size() != nA.vShape[0] ) {
+			throw std::invalid_argument( "Tape::Nll: The variable must be [N, C] with 1 label per row." );
+		}
+		const size_t sClasses = nA.vShape[1];
+		for ( size_t sLabel : _vLabels ) {
+			if ( sLabel >= sClasses ) { throw std::invalid_argument( "Tape::Nll: A label is out of range." ); }
+		}
+		std::unique_ptr<Tensor> upOut = NewTensor( { 1 }, nA.tType );
+		Dispatch( nA.tType, [&]( auto _tZero ) {
+			using Type = decltype( _tZero );
+			StridedView<Type> svA = nA.upValue->Strided<Type>(), svOut = upOut->Strided<Type>();
+			double dSum = 0.0;
+			for ( size_t I = 0; I < _vLabels.size(); ++I ) { dSum -= svA.Data()[I*sClasses+_vLabels[I]]; }
+			svOut.Data()[0] = static_cast<Type>(dSum / _vLabels.size());
+		} );
+		size_t sRet = Record( NN9_TO_NLL, std::move( upOut ), _sLogProbs );
+		m_vNodes[sRet].vLabels = _vLabels;
+		return sRet;
+	}
+
+	/**
+	 * Finds the gradient of a result with respect to every variable that led to it.  The result's gradient is seeded with 1's.  Steps run
+	 *	in reverse recording order, which is a topological order, and skip variables that do not lead to the result or do not require a
+	 *	gradient.  Intermediate values and gradients are released along the way, so read any intermediate values needed afterward first.
+	 *	The high-water mark of BufferManager::TotalMemory() during the pass is available from PeakMemory() afterward.
+	 *
+	 * \param _sRoot The result.
+	 * \throw Throws if the tape has already been run or the result does not require a gradient.
+	 **/
+	void Tape::Backward( size_t _sRoot ) {
+		if ( m_bRun ) { throw std::runtime_error( "Tape::Backward: The tape has already been run.  Clear() it and record again." ); }
+		NN9_NODE & nRoot = Input( _sRoot, "Tape::Backward" );
+		if ( !nRoot.bRequiresGrad ) { throw std::invalid_argument( "Tape::Backward: The result does not depend on anything that requires a gradient." ); }
+		m_bRun = true;
+		BufferManager::GblBufferManager.ResetPeakMemory();
+
+		// Every variable is recorded after its inputs, so walking down from the root reaches all consumers of a variable before the variable.
+		std::vector<uint8_t> vLive( _sRoot + 1 );
+		vLive[_sRoot] = 1;
+		for ( size_t I = _sRoot + 1; I--; ) {
+			m_vNodes[I].sReaders = 0;
+			if ( !vLive[I] ) { continue; }
+			for ( size_t J = 0; J < 3; ++J ) {
+				const size_t sIn = m_vNodes[I].saInputs[J];
+				if ( sIn != NN9_TP_NONE && m_vNodes[sIn].bRequiresGrad ) { vLive[sIn] = 1; }
+			}
+		}
+
+		// Count the steps that read each value.  Intermediate values that no step reads are not needed any more.
+		for ( size_t I = 0; I <= _sRoot; ++I ) {
+			const NN9_NODE & nNode = m_vNodes[I];
+			if ( !vLive[I] || nNode.toOp == NN9_TO_LEAF ) { continue; }
+			for ( size_t J = 0; J < 3; ++J ) {
+				if ( nNode.saInputs[J] != NN9_TP_NONE && ReadsInput( nNode, J ) ) { ++m_vNodes[nNode.saInputs[J]].sReaders; }
+			}
+			if ( ReadsOutput( nNode.toOp ) ) { ++m_vNodes[I].sReaders; }
+		}
+		for ( size_t I = 0; I < _sRoot; ++I ) {
+			if ( vLive[I] && m_vNodes[I].toOp != NN9_TO_LEAF && !m_vNodes[I].sReaders ) { m_vNodes[I].upValue.reset(); }
+		}
+		auto aRelease = [&]( size_t _sIdx ) {
+			NN9_NODE & nNode = m_vNodes[_sIdx];
+			if ( !--nNode.sReaders && nNode.toOp != NN9_TO_LEAF && _sIdx != _sRoot ) { nNode.upValue.reset(); }
+		};
+
+		Dispatch( nRoot.tType, [&]( auto _tZero ) {
+			using Type = decltype( _tZero );
+			Contribute<Type>( _sRoot, [&]( StridedView<Type> &_svDst, bool _bAdd ) {
+				Accumulate( _svDst.Data(), _svDst.size(), _bAdd, []( size_t ) { return Type( 1 ); } );
+			} );
+		} );
+
+		for ( size_t I = _sRoot + 1; I--; ) {
+			NN9_NODE & nNode = m_vNodes[I];
+			if ( !vLive[I] || nNode.toOp == NN9_TO_LEAF ) { continue; }
+			if ( nNode.upGrad ) {
+				Dispatch( nNode.tType, [&]( auto _tZero ) { BackwardStep<decltype( _tZero )>( I ); } );
+			}
+
+			// The gradient has been passed on, and the values the step read may not be needed any more.
+			nNode.upGrad.reset();
+			nNode.bGradWritten = false;
+			for ( size_t J = 0; J < 3; ++J ) {
+				if ( nNode.saInputs[J] != NN9_TP_NONE && ReadsInput( nNode, J ) ) { aRelease( nNode.saInputs[J] ); }
+			}
+			if ( ReadsOutput( nNode.toOp ) ) { aRelease( I ); }
+		}
+
+		// Leaves that received nothing have a gradient of 0.
+		for ( auto & nNode : m_vNodes ) {
+			if ( nNode.toOp == NN9_TO_LEAF && nNode.upGrad && !nNode.bGradWritten ) {
+				Dispatch( nNode.tType, [&]( auto _tZero ) {
+					using Type = decltype( _tZero );
+					StridedView<Type> svGrad = nNode.upGrad->Strided<Type>();
+					std::fill( svGrad.Data(), svGrad.Data() + svGrad.size(), Type( 0 ) );
+				} );
+				nNode.bGradWritten = true;
+			}
+		}
+		m_ui64PeakMemory = BufferManager::GblBufferManager.PeakMemory();
+	}
+
+	/**
+	 * Gets the value of a variable.
+	 *
+	 * \param _sIdx The variable.
+	 * \throw Throws if the variable is invalid or its value has been released by Backward().
+	 * \return Returns the value.
+	 **/
+	Tensor & Tape::Value( size_t _sIdx ) {
+		return (*Input( _sIdx, "Tape::Value" ).upValue);
+	}
+
+	/**
+	 * Gets the gradient of a variable.  After Backward(), leaf gradients hold their results and intermediate gradients have been released.
+	 *
+	 * \param _sIdx The variable.
+	 * \throw Throws if the variable is invalid.
+	 * \return Returns the gradient, or nullptr if the variable has none or it has not been written yet.
+	 **/
+	Tensor * Tape::Grad( size_t _sIdx ) {
+		if ( _sIdx >= m_vNodes.size() ) { throw std::out_of_range( "Tape::Grad: Invalid variable." ); }
+		return m_vNodes[_sIdx].bGradWritten ? m_vNodes[_sIdx].upGrad.get() : nullptr;
+	}
+
+	/**
+	 * Releases every variable so that the tape can be recorded again.
+	 **/
+	void Tape::Clear() {
+		m_vNodes.clear();
+		m_bRun = false;
+	}
+
+	/**
+	 * Gets a variable to be used as the input of an operation.
+	 *
+	 * \param _sIdx The variable.
+	 * \param _pcFunc The name of the calling function, for errors.
+	 * \throw Throws if the variable is invalid or its value has been released.
+	 * \return Returns the variable.
+	 **/
+	Tape::NN9_NODE & Tape::Input( size_t _sIdx, const char * _pcFunc ) {
+		if ( _sIdx >= m_vNodes.size() || !m_vNodes[_sIdx].upValue ) {
+			throw std::invalid_argument( std::string( _pcFunc ) + ": The variable is invalid or has been released." );
+		}
+		return m_vNodes[_sIdx];
+	}
+
+	/**
+	 * Adds a variable made by an operation.
+	 *
+	 * \param _toOp The operation.
+	 * \param _upValue The value.
+	 * \param _sA The first input.
+	 * \param _sB The second input, or NN9_TP_NONE.
+	 * \param _sC The third input, or NN9_TP_NONE.
+	 * \return Returns the index of the new variable.
+	 **/
+	size_t Tape::Record( NN9_TAPE_OP _toOp, std::unique_ptr<Tensor> _upValue, size_t _sA, size_t _sB, size_t _sC ) {
+		NN9_NODE nNode;
+		nNode.vShape = _upValue->Shape();
+		nNode.tType = _upValue->Type();
+		nNode.upValue = std::move( _upValue );
+		nNode.toOp = _toOp;
+		nNode.saInputs[0] = _sA;
+		nNode.saInputs[1] = _sB;
+		nNode.saInputs[2] = _sC;
+		for ( size_t I = 0; I < 3; ++I ) {
+			if ( nNode.saInputs[I] != NN9_TP_NONE && m_vNodes[nNode.saInputs[I]].bRequiresGrad ) { nNode.bRequiresGrad = true; }
+		}
+		m_vNodes.push_back( std::move( nNode ) );
+		return m_vNodes.size() - 1;
+	}
+
+	/**
+	 * Records a broadcasting element-wise operation.
+	 *
+	 * \param _toOp NN9_TO_ADD, NN9_TO_SUB, or NN9_TO_MUL.
+	 * \param _sA The left variable.
+	 * \param _sB The right variable.
+	 * \param _pcFunc The name of the calling function, for errors.
+	 * \return Returns the index of the result.
+	 **/
+	size_t Tape::Binary( NN9_TAPE_OP _toOp, size_t _sA, size_t _sB, const char * _pcFunc ) {
+		NN9_NODE & nA = Input( _sA, _pcFunc );
+		NN9_NODE & nB = Input( _sB, _pcFunc );
+		CheckRecord( nA.tType, _pcFunc );
+		if ( nB.tType != nA.tType ) { throw std::invalid_argument( std::string( _pcFunc ) + ": Both variables must have the same type." ); }
+
+		// Shapes are aligned on their last dimensions and each pair of dimensions must match or include a 1.
+		const size_t sDims = std::max( nA.vShape.size(), nB.vShape.size() );
+		std::vector<size_t> vShape( sDims );
+		for ( size_t I = 0; I < sDims; ++I ) {
+			const size_t sDimA = I + nA.vShape.size() >= sDims ? nA.vShape[I+nA.vShape.size()-sDims] : 1;
+			const size_t sDimB = I + nB.vShape.size() >= sDims ? nB.vShape[I+nB.vShape.size()-sDims] : 1;
+			if ( sDimA != sDimB && sDimA != 1 && sDimB != 1 ) {
+				throw std::invalid_argument( std::string( _pcFunc ) + ": The shapes cannot be broadcast together." );
+			}
+			vShape[I] = sDimA == 1 ? sDimB : sDimA;
+		}
+
+		std::unique_ptr<Tensor> upOut = NewTensor( vShape, nA.tType );
+		Dispatch( nA.tType, [&]( auto _tZero ) {
+			using Type = decltype( _tZero );
+			StridedView<Type> svA = nA.upValue->Strided<Type>(), svB = nB.upValue->Strided<Type>(), svOut = upOut->Strided<Type>();
+			switch ( _toOp ) {
+				case NN9_TO_ADD : { Math::BroadcastAdd( svA, svB, svOut ); break; }
+				case NN9_TO_SUB : { Math::BroadcastSub( svA, svB, svOut ); break; }
+				default : { Math::BroadcastMul( svA, svB, svOut ); }
+			}
+		} );
+		return Record( _toOp, std::move( upOut ), _sA, _sB );
+	}
+
+	/**
+	 * Records Relu(), Tanh(), Softmax(), or LogSoftmax().
+	 *
+	 * \param _toOp The operation.
+	 * \param _sA The input variable.
+	 * \param _sAxis The axis, for Softmax() and LogSoftmax().
+	 * \param _pcFunc The name of the calling function, for errors.
+	 * \return Returns the index of the result.
+	 **/
+	size_t Tape::Unary( NN9_TAPE_OP _toOp, size_t _sA, size_t _sAxis, const char * _pcFunc ) {
+		NN9_NODE & nA = Input( _sA, _pcFunc );
+		CheckRecord( nA.tType, _pcFunc );
+		if ( (_toOp == NN9_TO_SOFTMAX || _toOp == NN9_TO_LOG_SOFTMAX) && _sAxis >= nA.vShape.size() ) {
+			throw std::invalid_argument( std::string( _pcFunc ) + ": The axis is out of range." );
+		}
+
+		std::unique_ptr<Tensor> upOut = NewTensor( nA.vShape, nA.tType );
+		Dispatch( nA.tType, [&]( auto _tZero ) {
+			using Type = decltype( _tZero );
+			StridedView<Type> svA = nA.upValue->Strided<Type>(), svOut = upOut->Strided<Type>();
+			switch ( _toOp ) {
+				case NN9_TO_RELU : {
+					const Type * ptA = svA.Data();
+					Type * ptOut = svOut.Data();
+					// NaN is passed through.
+					ForEach( svA.size(), 1, [&]( size_t _sBegin, size_t _sEnd ) {
+						for ( size_t I = _sBegin; I < _sEnd; ++I ) { ptOut[I] = ptA[I] < Type( 0 ) ? Type( 0 ) : ptA[I]; }
+					} );
+					break;
+				}
+				case NN9_TO_TANH : { Math::Tanh( svA, svOut ); break; }
+				case NN9_TO_SOFTMAX : { nn9::Softmax::Forward<Type>( svA, svOut, _sAxis ); break; }
+				default : { nn9::Softmax::LogForward<Type>( svA, svOut, _sAxis ); }
+			}
+		} );
+		size_t sRet = Record( _toOp, std::move( upOut ), _sA );
+		m_vNodes[sRet].sAxis = _sAxis;
+		return sRet;
+	}
+
+	/**
+	 * Records Sum() or Mean().
+	 *
+	 * \param _toOp The operation.
+	 * \param _sA The input variable.
+	 * \param _pcFunc The name of the calling function, for errors.
+	 * \return Returns the index of the result.
+	 **/
+	size_t Tape::Reduce( NN9_TAPE_OP _toOp, size_t _sA, const char * _pcFunc ) {
+		NN9_NODE & nA = Input( _sA, _pcFunc );
+		CheckRecord( nA.tType, _pcFunc );
+		const size_t sTotal = Elements( nA.vShape );
+		if ( _toOp == NN9_TO_MEAN && !sTotal ) { throw std::invalid_argument( std::string( _pcFunc ) + ": Cannot average an empty variable." ); }
+
+		std::unique_ptr<Tensor> upOut = NewTensor( { 1 }, nA.tType );
+		Dispatch( nA.tType, [&]( auto _tZero ) {
+			using Type = decltype( _tZero );
+			StridedView<Type> svA = nA.upValue->Strided<Type>(), svOut = upOut->Strided<Type>();
+			auto aSum = Math::Sum( svA );
+			svOut.Data()[0] = static_cast<Type>(_toOp == NN9_TO_MEAN ? aSum / sTotal : aSum);
+		} );
+		return Record( _toOp, std::move( upOut ), _sA );
+	}
+
+	/**
+	 * Adds a contribution into the gradient of a variable, allocating the gradient first if needed.  The contribution is written by a
+	 *	function that receives the gradient and whether to add to it (true) or overwrite it (false).  Does nothing if the variable does not
+	 *	require a gradient.
+	 *
+	 * \tparam _tType The element type.
+	 * \tparam _tFunc The function type.
+	 * \param _sIdx The variable.
+	 * \param _fFunc The function that writes the contribution.
+	 **/
+	template <typename _tType, typename _tFunc>
+	void Tape::Contribute( size_t _sIdx, const _tFunc &_fFunc ) {
+		NN9_NODE & nNode = m_vNodes[_sIdx];
+		if ( !nNode.bRequiresGrad ) { return; }
+		if ( !nNode.upGrad ) { nNode.upGrad = NewTensor( nNode.vShape, nNode.tType ); }
+		StridedView<_tType> svGrad = nNode.upGrad->Strided<_tType>();
+		_fFunc( svGrad, nNode.bGradWritten );
+		nNode.bGradWritten = true;
+	}
+
+	/**
+	 * Gets a buffer into which to write a contribution to the gradient of a variable.  This is the gradient itself if it has not been
+	 *	written yet (allocating it if needed), or otherwise a temporary that Commit() adds into the gradient.
+	 *
+	 * \tparam _tType The element type.
+	 * \param _sIdx The variable.
+	 * \param _upTemp Holds the temporary, if one is needed.
+	 * \return Returns the buffer to overwrite with the contribution.
+	 **/
+	template <typename _tType>
+	StridedView<_tType> Tape::Target( size_t _sIdx, std::unique_ptr<Tensor> &_upTemp ) {
+		NN9_NODE & nNode = m_vNodes[_sIdx];
+		if ( nNode.bRequiresGrad && !nNode.bGradWritten ) {
+			if ( !nNode.upGrad ) { nNode.upGrad = NewTensor( nNode.vShape, nNode.tType ); }
+			nNode.bGradWritten = true;
+			return nNode.upGrad->Strided<_tType>();
+		}
+		_upTemp = NewTensor( nNode.vShape, nNode.tType );
+		return _upTemp->Strided<_tType>();
+	}
+
+	/**
+	 * Finishes a contribution started by Target(), adding the temporary into the gradient if there is one.
+	 *
+	 * \tparam _tType The element type.
+	 * \param _sIdx The variable.
+	 * \param _upTemp The temporary returned by Target(), which is released.
+	 **/
+	template <typename _tType>
+	void Tape::Commit( size_t _sIdx, std::unique_ptr<Tensor> &_upTemp ) {
+		if ( !_upTemp ) { return; }
+		NN9_NODE & nNode = m_vNodes[_sIdx];
+		if ( nNode.bRequiresGrad ) {
+			StridedView<_tType> svSrc = _upTemp->Strided<_tType>(), svDst = nNode.upGrad->Strided<_tType>();
+			const _tType * ptSrc = svSrc.Data();
+			Accumulate( svDst.Data(), svDst.size(), true, [ptSrc]( size_t _sI ) { return ptSrc[_sI]; } );
+		}
+		_upTemp.reset();
+	}
+
+	/**
+	 * Adds a gradient with the shape of a broadcast result into the gradient of a variable that was broadcast to that shape, summing over
+	 *	the broadcast dimensions.
+	 *
+	 * \tparam _tType The element type.
+	 * \param _sIdx The variable.
+	 * \param _svGrad The gradient with the broadcast shape.
+	 * \param _tScale The factor by which to scale the contribution.
+	 **/
+	template <typename _tType>
+	void Tape::Unbroadcast( size_t _sIdx, const StridedView<_tType> &_svGrad, _tType _tScale ) {
+		NN9_NODE & nNode = m_vNodes[_sIdx];
+		if ( !nNode.bRequiresGrad ) { return; }
+		const auto & vShape = _svGrad.Shape();
+		if ( nNode.vShape == vShape ) {
+			const _tType * ptSrc = _svGrad.Data();
+			Contribute<_tType>( _sIdx, [&]( StridedView<_tType> &_svDst, bool _bAdd ) {
+				Accumulate( _svDst.Data(), _svDst.size(), _bAdd, [&]( size_t _sI ) { return ptSrc[_sI] * _tScale; } );
+			} );
+			return;
+		}
+
+		// Sum over the leading dimensions the variable lacks and the dimensions along which it was repeated.
+		const size_t sLead = vShape.size() - nNode.vShape.size();
+		std::vector<size_t> vAxes;
+		for ( size_t I = 0; I < vShape.size(); ++I ) {
+			if ( I < sLead || (nNode.vShape[I-sLead] == 1 && vShape[I] != 1) ) { vAxes.push_back( I ); }
+		}
+		std::unique_ptr<Tensor> upTemp;
+		{
+			StridedView<_tType> svDst = Target<_tType>( _sIdx, upTemp );
+			Math::Sum( _svGrad, vAxes, svDst );
+			if ( _tScale != _tType( 1 ) ) {
+				_tType * ptDst = svDst.Data();
+				Accumulate( ptDst, svDst.size(), false, [&]( size_t _sI ) { return ptDst[_sI] * _tScale; } );
+			}
+		}
+		Commit<_tType>( _sIdx, upTemp );
+	}
+
+	/**
+	 * Runs the backward step of a variable, passing its gradient to its inputs.
+	 *
+	 * \tparam _tType The element type.
+	 * \param _sIdx The variable.
+	 **/
+	template <typename _tType>
+	void Tape::BackwardStep( size_t _sIdx ) {
+		NN9_NODE & nNode = m_vNodes[_sIdx];
+		StridedView<_tType> svGrad = nNode.upGrad->Strided<_tType>();
+		const _tType * ptGrad = svGrad.Data();
+		const size_t sTotal = svGrad.size();
+		const size_t sA = nNode.saInputs[0], sB = nNode.saInputs[1], sC = nNode.saInputs[2];
+		switch ( nNode.toOp ) {
+			case NN9_TO_ADD : {}
+			case NN9_TO_SUB : {
+				Unbroadcast<_tType>( sA, svGrad, _tType( 1 ) );
+				Unbroadcast<_tType>( sB, svGrad, nNode.toOp == NN9_TO_SUB ? _tType( -1 ) : _tType( 1 ) );
+				break;
+			}
+			case NN9_TO_MUL : {
+				// dA = dC * B and dB = dC * A, each summed over the dimensions along which its input was broadcast.
+				for ( size_t I = 0; I < 2; ++I ) {
+					const size_t sIn = nNode.saInputs[I];
+					const NN9_NODE & nOther = m_vNodes[nNode.saInputs[I^1]];
+					if ( !m_vNodes[sIn].bRequiresGrad ) { continue; }
+					StridedView<_tType> svOther = nOther.upValue->Strided<_tType>();
+					if ( m_vNodes[sIn].vShape == nNode.vShape && nOther.vShape == nNode.vShape ) {
+						const _tType * ptOther = svOther.Data();
+						Contribute<_tType>( sIn, [&]( StridedView<_tType> &_svDst, bool _bAdd ) {
+							Accumulate( _svDst.Data(), sTotal, _bAdd, [&]( size_t _sI ) { return ptGrad[_sI] * ptOther[_sI]; } );
+						} );
+					}
+					else {
+						std::unique_ptr<Tensor> upTemp = NewTensor( nNode.vShape, nNode.tType );
+						StridedView<_tType> svTemp = upTemp->Strided<_tType>();
+						Math::BroadcastMul( svGrad, svOther, svTemp );
+						Unbroadcast<_tType>( sIn, svTemp, _tType( 1 ) );
+					}
+				}
+				break;
+			}
+			case NN9_TO_MATMUL : {
+				const NN9_NODE & nA = m_vNodes[sA], & nB = m_vNodes[sB];
+				const size_t sM = nA.vShape[0], sK = nA.vShape[1], sN = nB.vShape[1];
+				if ( nA.bRequiresGrad ) {
+					// dA = dC * B^T.
+					StridedView<_tType> svB = nB.upValue->Strided<_tType>();
+					Contribute<_tType>( sA, [&]( StridedView<_tType> &_svDst, bool _bAdd ) {
+						Gemm::Run<_tType>( sM, sK, sN, ptGrad, sN, 1, svB.Data(), 1, sN, _svDst.Data(), sK, 1, 1.0, _bAdd ? 1.0 : 0.0 );
+					} );
+				}
+				if ( nB.bRequiresGrad ) {
+					// dB = A^T * dC.
+					StridedView<_tType> svA = nA.upValue->Strided<_tType>();
+					Contribute<_tType>( sB, [&]( StridedView<_tType> &_svDst, bool _bAdd ) {
+						Gemm::Run<_tType>( sK, sN, sM, svA.Data(), 1, sK, ptGrad, sN, 1, _svDst.Data(), sN, 1, 1.0, _bAdd ? 1.0 : 0.0 );
+					} );
+				}
+				break;
+			}
+			case NN9_TO_RELU : {
+				StridedView<_tType> svY = nNode.upValue->Strided<_tType>();
+				const _tType * ptY = svY.Data();
+				Contribute<_tType>( sA, [&]( StridedView<_tType> &_svDst, bool _bAdd ) {
+					Accumulate( _svDst.Data(), sTotal, _bAdd, [&]( size_t _sI ) { return ptY[_sI] > _tType( 0 ) ? ptGrad[_sI] : _tType( 0 ); } );
+				} );
+				break;
+			}
+			case NN9_TO_TANH : {
+				StridedView<_tType> svY = nNode.upValue->Strided<_tType>();
+				const _tType * ptY = svY.Data();
+				Contribute<_tType>( sA, [&]( StridedView<_tType> &_svDst, bool _bAdd ) {
+					Accumulate( _svDst.Data(), sTotal, _bAdd, [&]( size_t _sI ) { return ptGrad[_sI] * (_tType( 1 ) - ptY[_sI] * ptY[_sI]); } );
+				} );
+				break;
+			}
+			case NN9_TO_SOFTMAX : {}
+			case NN9_TO_LOG_SOFTMAX : {
+				StridedView<_tType> svY = nNode.upValue->Strided<_tType>();
+				const _tType * ptY = svY.Data();
+				const bool bLog = nNode.toOp == NN9_TO_LOG_SOFTMAX;
+				size_t sOuter = 1, sInner = 1;
+				for ( size_t I = 0; I < nNode.sAxis; ++I ) { sOuter *= nNode.vShape[I]; }
+				for ( size_t I = nNode.sAxis + 1; I < nNode.vShape.size(); ++I ) { sInner *= nNode.vShape[I]; }
+				const size_t sLen = nNode.vShape[nNode.sAxis];
+				Contribute<_tType>( sA, [&]( StridedView<_tType> &_svDst, bool _bAdd ) {
+					_tType * ptDst = _svDst.Data();
+					// Softmax: dX = Y * (dY - sum( dY * Y )).  Log-softmax: dX = dY - exp( Y ) * sum( dY ).  There is 1 sum per inner index.
+					ForEach( sOuter, sLen * sInner, [&]( size_t _sBegin, size_t _sEnd ) {
+						std::vector<_tType> vSum( sInner );
+						for ( size_t O = _sBegin; O < _sEnd; ++O ) {
+							const size_t sBase = O * sLen * sInner;
+							std::fill( vSum.begin(), vSum.end(), _tType( 0 ) );
+							for ( size_t L = 0; L < sLen; ++L ) {
+								const _tType * ptG = ptGrad + sBase + L * sInner, * ptRowY = ptY + sBase + L * sInner;
+								for ( size_t I = 0; I < sInner; ++I ) { vSum[I] += bLog ? ptG[I] : ptG[I] * ptRowY[I]; }
+							}
+							for ( size_t L = 0; L < sLen; ++L ) {
+								const _tType * ptG = ptGrad + sBase + L * sInner, * ptRowY = ptY + sBase + L * sInner;
+								_tType * ptD = ptDst + sBase + L * sInner;
+								for ( size_t I = 0; I < sInner; ++I ) {
+									const _tType tVal = bLog ? ptG[I] - std::exp( ptRowY[I] ) * vSum[I] : ptRowY[I] * (ptG[I] - vSum[I]);
+									ptD[I] = _bAdd ? ptD[I] + tVal : tVal;
+								}
+							}
+						}
+					} );
+				} );
+				break;
+			}
+			case NN9_TO_SUM : {}
+			case NN9_TO_MEAN : {
+				const size_t sIn = Elements( m_vNodes[sA].vShape );
+				const _tType tVal = nNode.toOp == NN9_TO_MEAN ? static_cast<_tType>(ptGrad[0] / sIn) : ptGrad[0];
+				Contribute<_tType>( sA, [&]( StridedView<_tType> &_svDst, bool _bAdd ) {
+					Accumulate( _svDst.Data(), sIn, _bAdd, [tVal]( size_t ) { return tVal; } );
+				} );
+				break;
+			}
+			case NN9_TO_RESHAPE : {
+				// The elements are in the same order in both shapes.
+				Contribute<_tType>( sA, [&]( StridedView<_tType> &_svDst, bool _bAdd ) {
+					Accumulate( _svDst.Data(), sTotal, _bAdd, [&]( size_t _sI ) { return ptGrad[_sI]; } );
+				} );
+				break;
+			}
+			case NN9_TO_CONV2D : {
+				const NN9_NODE & nIn = m_vNodes[sA], & nW = m_vNodes[sB];
+				const bool bBias = sC != NN9_TP_NONE && m_vNodes[sC].bRequiresGrad;
+				// Views pin their buffers, so each is closed before its temporary is committed and released.
+				if ( nIn.bRequiresGrad ) {
+					std::unique_ptr<Tensor> upTemp;
+					{
+						StridedView<_tType> svW = nW.upValue->Strided<_tType>();
+						StridedView<_tType> svDst = Target<_tType>( sA, upTemp );
+						Conv2D::BackwardData<_tType>( svGrad, svW, svDst, nNode.cpParms );
+					}
+					Commit<_tType>( sA, upTemp );
+				}
+				if ( nW.bRequiresGrad || bBias ) {
+					// Both come out of 1 call, so each is written directly if it can be and into a temporary if it must be added.
+					std::unique_ptr<Tensor> upTempW, upTempB;
+					{
+						StridedView<_tType> svIn = nIn.upValue->Strided<_tType>();
+						StridedView<_tType> svDw = Target<_tType>( sB, upTempW );
+						if ( sC != NN9_TP_NONE ) {
+							StridedView<_tType> svDb = Target<_tType>( sC, upTempB );
+							Conv2D::BackwardWeights<_tType>( svIn, svGrad, svDw, &svDb, nNode.cpParms );
+						}
+						else { Conv2D::BackwardWeights<_tType>( svIn, svGrad, svDw, nullptr, nNode.cpParms ); }
+					}
+					if ( sC != NN9_TP_NONE ) { Commit<_tType>( sC, upTempB ); }
+					Commit<_tType>( sB, upTempW );
+				}
+				break;
+			}
+			case NN9_TO_NLL : {
+				const size_t sClasses = m_vNodes[sA].vShape[1];
+				const _tType tVal = static_cast<_tType>(-ptGrad[0] / nNode.vLabels.size());
+				Contribute<_tType>( sA, [&]( StridedView<_tType> &_svDst, bool _bAdd ) {
+					_tType * ptDst = _svDst.Data();
+					if ( !_bAdd ) { std::fill( ptDst, ptDst + _svDst.size(), _tType( 0 ) ); }
+					for ( size_t I = 0; I < nNode.vLabels.size(); ++I ) { ptDst[I*sClasses+nNode.vLabels[I]] += tVal; }
+				} );
+				break;
+			}
+			default : {}
+		}
+	}
+
+	/**
+	 * Checks that the tape can record and that a type is supported.
+	 *
+	 * \param _tType The type to check.
+	 * \param _pcFunc The name of the calling function, for errors.
+	 * \throw Throws if the tape has already been run backward or the type is not float or double.
+	 **/
+	void Tape::CheckRecord( NN9_TYPE _tType, const char * _pcFunc ) const {
+		if ( m_bRun ) { throw std::runtime_error( std::string( _pcFunc ) + ": The tape has already been run.  Clear() it and record again." ); }
+		if ( _tType != NN9_T_FLOAT && _tType != NN9_T_DOUBLE ) {
+			throw std::invalid_argument( std::string( _pcFunc ) + ": Only float and double tensors are supported." );
+		}
+	}
+
+	/**
+	 * Determines whether the backward step of a variable reads the value of 1 of its inputs.  An input's value is only read to find the
+	 *	gradient of another input, so it depends on which inputs require gradients.
+	 *
+	 * \param _nNode The variable.
+	 * \param _sInput The index (0, 1, or 2) of the input.
+	 * \return Returns true if the step reads the input's value.
+	 **/
+	bool Tape::ReadsInput( const NN9_NODE &_nNode, size_t _sInput ) const {
+		switch ( _nNode.toOp ) {
+			case NN9_TO_MUL : {}
+			case NN9_TO_MATMUL : {
+				return _sInput < 2 && m_vNodes[_nNode.saInputs[_sInput^1]].bRequiresGrad;
+			}
+			case NN9_TO_CONV2D : {
+				// The input is read for the weight and bias gradients and the weights for the input gradient.
+				if ( _sInput == 0 ) {
+					return m_vNodes[_nNode.saInputs[1]].bRequiresGrad || (_nNode.saInputs[2] != NN9_TP_NONE && m_vNodes[_nNode.saInputs[2]].bRequiresGrad);
+				}
+				return _sInput == 1 && m_vNodes[_nNode.saInputs[0]].bRequiresGrad;
+			}
+			default : { return false; }
+		}
+	}
+
+	/**
+	 * Determines whether the backward step of an operation reads its own value.
+	 *
+	 * \param _toOp The operation.
+	 * \return Returns true if the step reads the operation's value.
+	 **/
+	bool Tape::ReadsOutput( NN9_TAPE_OP _toOp ) {
+		return _toOp == NN9_TO_RELU || _toOp == NN9_TO_TANH || _toOp == NN9_TO_SOFTMAX || _toOp == NN9_TO_LOG_SOFTMAX;
+	}
+
+	/**
+	 * Creates an uninitialized contiguous tensor.
+	 *
+	 * \param _vShape The shape of the tensor.
+	 * \param _tType The type of the tensor.
+	 * \return Returns the tensor.
+	 **/
+	std::unique_ptr<Tensor> Tape::NewTensor( const std::vector<size_t> &_vShape, NN9_TYPE _tType ) {
+		std::vector<size_t> vStride( _vShape.size() );
+		size_t sStride = 1;
+		for ( size_t I = _vShape.size(); I--; ) {
+			vStride[I] = sStride;
+			sStride *= _vShape[I];
+		}
+		return std::unique_ptr<Tensor>( new Tensor( _vShape, vStride, _tType, 1.0, 0.0 ) );
+	}
+
+	/**
+	 * Gets the number of elements in a shape.
+	 *
+	 * \param _vShape The shape.
+	 * \return Returns the product of the dimensions.
+	 **/
+	size_t Tape::Elements( const std::vector<size_t> &_vShape ) {
+		size_t sRet = 1;
+		for ( size_t sDim : _vShape ) { sRet *= sDim; }
+		return sRet;
+	}
+
+}	// namespace nn9
@@ -0,0 +1,461 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A reverse-mode autograd tape.  Operations on tensors are run as they are recorded, and Backward() walks the record in reverse
+ *	to find the gradient of 1 result with respect to every variable that led to it.
+ */
+
+#pragma once
+
+#include "../Ops/NN9Conv2D.h"
+#include "../Tensor/NN9Tensor.h"
+
+#include <memory>
+#include <vector>
+
+
+namespace nn9 {
+
+	/**
+	 * Class Tape
+	 * \brief A reverse-mode autograd tape.
+	 *
+	 * Description: A reverse-mode autograd tape.  Operations on tensors are run as they are recorded, and Backward() walks the record in reverse
+	 *	to find the gradient of 1 result with respect to every variable that led to it.  Variables are referred to by the indices the recording
+	 *	functions return.  Leaf gradients are allocated when the leaf is recorded (or supplied by the caller) and every contribution is added into
+	 *	them in place.  Intermediate gradients are allocated by their first contribution, which writes rather than adds, and are released as soon
+	 *	as they have been passed on.  Intermediate values are released as soon as the last backward step that reads them has run, so that the
+	 *	freed memory is reused by the gradients that follow.  Only float and double tensors are supported.
+	 */
+	class Tape {
+	public :
+		Tape();
+		~Tape();
+
+
+		// == Enumerations.
+		/** Tape constants. */
+		enum NN9_TAPE : size_t {
+			NN9_TP_NONE							= ~size_t( 0 ),							/**< No variable, such as a missing bias. */
+			NN9_TP_PARALLEL_ELEMENTS			= 1 << 15,								/**< Elements below which an element-wise step runs on the calling thread. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Records a tensor that is not the result of a recorded operation, such as an input or a parameter.  The tape shares the tensor's
+		 *	buffer and never modifies it.
+		 *
+		 * \param _tValue The tensor to record.  It must be contiguous.
+		 * \param _bRequiresGrad If true, a gradient buffer is allocated now and filled by Backward().
+		 * \throw Throws if the tensor is not float or double or is not contiguous.
+		 * \return Returns the index of the new variable.
+		 **/
+		size_t									Leaf( const Tensor &_tValue, bool _bRequiresGrad = true );
+
+		/**
+		 * Records a tensor that is not the result of a recorded operation and whose gradient is added into a caller-owned buffer.  The buffer
+		 *	is never cleared by the tape, so gradients accumulate across tapes until the caller clears it.
+		 *
+		 * \param _tValue The tensor to record.  It must be contiguous.
+		 * \param _tGrad The gradient buffer.  It must be contiguous and have the shape and type of _tValue.
+		 * \throw Throws if the tensor is not float or double or is not contiguous, or if the gradient does not match it.
+		 * \return Returns the index of the new variable.
+		 **/
+		size_t									Leaf( const Tensor &_tValue, Tensor &_tGrad );
+
+		/**
+		 * Records a + b with NumPy-style broadcasting.
+		 *
+		 * \param _sA The left variable.
+		 * \param _sB The right variable.
+		 * \throw Throws if a variable is invalid or released, the types differ, or the shapes cannot be broadcast together.
+		 * \return Returns the index of the result.
+		 **/
+		size_t									Add( size_t _sA, size_t _sB );
+
+		/**
+		 * Records a - b with NumPy-style broadcasting.
+		 *
+		 * \param _sA The left variable.
+		 * \param _sB The right variable.
+		 * \throw Throws if a variable is invalid or released, the types differ, or the shapes cannot be broadcast together.
+		 * \return Returns the index of the result.
+		 **/
+		size_t									Sub( size_t _sA, size_t _sB );
+
+		/**
+		 * Records a * b (element-wise) with NumPy-style broadcasting.
+		 *
+		 * \param _sA The left variable.
+		 * \param _sB The right variable.
+		 * \throw Throws if a variable is invalid or released, the types differ, or the shapes cannot be broadcast together.
+		 * \return Returns the index of the result.
+		 **/
+		size_t									Mul( size_t _sA, size_t _sB );
+
+		/**
+		 * Records the matrix product of an [M, K] variable and a [K, N] variable.
+		 *
+		 * \param _sA The left variable.
+		 * \param _sB The right variable.
+		 * \throw Throws if a variable is invalid or released, the types differ, or the shapes do not agree.
+		 * \return Returns the index of the [M, N] result.
+		 **/
+		size_t									MatMul( size_t _sA, size_t _sB );
+
+		/**
+		 * Records max( a, 0 ).
+		 *
+		 * \param _sA The input variable.
+		 * \throw Throws if the variable is invalid or released.
+		 * \return Returns the index of the result.
+		 **/
+		size_t									Relu( size_t _sA );
+
+		/**
+		 * Records tanh( a ).
+		 *
+		 * \param _sA The input variable.
+		 * \throw Throws if the variable is invalid or released.
+		 * \return Returns the index of the result.
+		 **/
+		size_t									Tanh( size_t _sA );
+
+		/**
+		 * Records the softmax of a along 1 axis.
+		 *
+		 * \param _sA The input variable.
+		 * \param _sAxis The axis along which the results sum to 1.
+		 * \throw Throws if the variable is invalid or released or the axis is out of range.
+		 * \return Returns the index of the result.
+		 **/
+		size_t									Softmax( size_t _sA, size_t _sAxis );
+
+		/**
+		 * Records the log-softmax of a along 1 axis.
+		 *
+		 * \param _sA The input variable.
+		 * \param _sAxis The axis along which the exponentials of the results sum to 1.
+		 * \throw Throws if the variable is invalid or released or the axis is out of range.
+		 * \return Returns the index of the result.
+		 **/
+		size_t									LogSoftmax( size_t _sA, size_t _sAxis );
+
+		/**
+		 * Records the sum of every element of a.
+		 *
+		 * \param _sA The input variable.
+		 * \throw Throws if the variable is invalid or released.
+		 * \return Returns the index of the { 1 } result.
+		 **/
+		size_t									Sum( size_t _sA );
+
+		/**
+		 * Records the mean of every element of a.
+		 *
+		 * \param _sA The input variable.
+		 * \throw Throws if the variable is invalid or released or empty.
+		 * \return Returns the index of the { 1 } result.
+		 **/
+		size_t									Mean( size_t _sA );
+
+		/**
+		 * Records a with a new shape.  The result shares a's buffer.
+		 *
+		 * \param _sA The input variable.
+		 * \param _vShape The new shape, with the same number of elements.
+		 * \throw Throws if the variable is invalid or released or the number of elements differs.
+		 * \return Returns the index of the result.
+		 **/
+		size_t									Reshape( size_t _sA, const std::vector<size_t> &_vShape );
+
+		/**
+		 * Records a 2-D convolution (see Conv2D::Forward()).
+		 *
+		 * \param _sIn The [N, C, H, W] input variable.
+		 * \param _sWeights The [O, C/Groups, Kh, Kw] weight variable.
+		 * \param _sBias The [O] bias variable, or NN9_TP_NONE.
+		 * \param _cpParms The convolution parameters.
+		 * \throw Throws if a variable is invalid or released, the types differ, or the shapes do not agree.
+		 * \return Returns the index of the [N, O, Oh, Ow] result.
+		 **/
+		size_t									Convolve( size_t _sIn, size_t _sWeights, size_t _sBias = NN9_TP_NONE,
+			const Conv2D::NN9_CONV2D_PARAMS &_cpParms = Conv2D::NN9_CONV2D_PARAMS() );
+
+		/**
+		 * Records the mean negative log-likelihood of the labelled class of each row of an [N, C] variable of log-probabilities, such as the
+		 *	output of LogSoftmax( X, 1 ).
+		 *
+		 * \param _sLogProbs The [N, C] input variable.
+		 * \param _vLabels The class of each row.
+		 * \throw Throws if the variable is invalid or released, it is not 2-D, or the labels do not match its rows and columns.
+		 * \return Returns the index of the { 1 } result.
+		 **/
+		size_t									Nll( size_t _sLogProbs, const std::vector<size_t> &_vLabels );
+
+		/**
+		 * Finds the gradient of a result with respect to every variable that led to it.  The result's gradient is seeded with 1's.  Steps run
+		 *	in reverse recording order, which is a topological order, and skip variables that do not lead to the result or do not require a
+		 *	gradient.  Intermediate values and gradients are released along the way, so read any intermediate values needed afterward first.
+		 *	The high-water mark of BufferManager::TotalMemory() during the pass is available from PeakMemory() afterward.
+		 *
+		 * \param _sRoot The result.
+		 * \throw Throws if the tape has already been run or the result does not require a gradient.
+		 **/
+		void									Backward( size_t _sRoot );
+
+		/**
+		 * Gets the value of a variable.
+		 *
+		 * \param _sIdx The variable.
+		 * \throw Throws if the variable is invalid or its value has been released by Backward().
+		 * \return Returns the value.
+		 **/
+		Tensor &								Value( size_t _sIdx );
+
+		/**
+		 * Gets the gradient of a variable.  After Backward(), leaf gradients hold their results and intermediate gradients have been released.
+		 *
+		 * \param _sIdx The variable.
+		 * \throw Throws if the variable is invalid.
+		 * \return Returns the gradient, or nullptr if the variable has none or it has not been written yet.
+		 **/
+		Tensor *								Grad( size_t _sIdx );
+
+		/**
+		 * Gets the number of recorded variables.
+		 *
+		 * \return Returns the number of recorded variables.
+		 **/
+		size_t									Size() const { return m_vNodes.size(); }
+
+		/**
+		 * Gets the high-water mark of BufferManager::TotalMemory() during the last Backward().
+		 *
+		 * \return Returns the peak memory, in bytes.
+		 **/
+		uint64_t								PeakMemory() const { return m_ui64PeakMemory; }
+
+		/**
+		 * Releases every variable so that the tape can be recorded again.
+		 **/
+		void									Clear();
+
+
+	protected :
+		// == Enumerations.
+		/** Recorded operations. */
+		enum NN9_TAPE_OP : size_t {
+			NN9_TO_LEAF,																/**< A leaf. */
+			NN9_TO_ADD,																	/**< Add(). */
+			NN9_TO_SUB,																	/**< Sub(). */
+			NN9_TO_MUL,																	/**< Mul(). */
+			NN9_TO_MATMUL,																/**< MatMul(). */
+			NN9_TO_RELU,																/**< Relu(). */
+			NN9_TO_TANH,																/**< Tanh(). */
+			NN9_TO_SOFTMAX,																/**< Softmax(). */
+			NN9_TO_LOG_SOFTMAX,															/**< LogSoftmax(). */
+			NN9_TO_SUM,																	/**< Sum(). */
+			NN9_TO_MEAN,																/**< Mean(). */
+			NN9_TO_RESHAPE,																/**< Reshape(). */
+			NN9_TO_CONV2D,																/**< Convolve(). */
+			NN9_TO_NLL,																	/**< Nll(). */
+		};
+
+
+		// == Types.
+		/** A recorded variable. */
+		struct NN9_NODE {
+			NN9_NODE() :
+				tType( NN9_T_FLOAT ),
+				toOp( NN9_TO_LEAF ),
+				sAxis( 0 ),
+				sReaders( 0 ),
+				bRequiresGrad( false ),
+				bGradWritten( false ) {
+				saInputs[0] = saInputs[1] = saInputs[2] = NN9_TP_NONE;
+			}
+
+
+			// == Members.
+			std::unique_ptr<Tensor>				upValue;								/**< The value, or nullptr once released. */
+			std::unique_ptr<Tensor>				upGrad;									/**< The gradient, or nullptr if not allocated. */
+			std::vector<size_t>					vShape;									/**< The shape of the value, kept after it is released. */
+			NN9_TYPE							tType;									/**< The type of the value. */
+			NN9_TAPE_OP							toOp;									/**< The operation that made the value. */
+			size_t								saInputs[3];							/**< The inputs to the operation, or NN9_TP_NONE. */
+			size_t								sAxis;									/**< Softmax()/LogSoftmax(): the axis. */
+			Conv2D::NN9_CONV2D_PARAMS			cpParms;								/**< Convolve(): the parameters. */
+			std::vector<size_t>					vLabels;								/**< Nll(): the labels. */
+			size_t								sReaders;								/**< Backward(): the steps yet to run that read the value. */
+			bool								bRequiresGrad;							/**< True if the value depends on a leaf that requires a gradient. */
+			bool								bGradWritten;							/**< True if upGrad holds values to which contributions are added. */
+		};
+
+
+		// == Members.
+		std::vector<NN9_NODE>					m_vNodes;								/**< The variables, in recording order. */
+		uint64_t								m_ui64PeakMemory;						/**< The peak memory during the last Backward(). */
+		bool									m_bRun;									/**< True once Backward() has run. */
+
+
+		// == Functions.
+		/**
+		 * Gets a variable to be used as the input of an operation.
+		 *
+		 * \param _sIdx The variable.
+		 * \param _pcFunc The name of the calling function, for errors.
+		 * \throw Throws if the variable is invalid or its value has been released.
+		 * \return Returns the variable.
+		 **/
+		NN9_NODE &								Input( size_t _sIdx, const char * _pcFunc );
+
+		/**
+		 * Adds a variable made by an operation.
+		 *
+		 * \param _toOp The operation.
+		 * \param _upValue The value.
+		 * \param _sA The first input.
+		 * \param _sB The second input, or NN9_TP_NONE.
+		 * \param _sC The third input, or NN9_TP_NONE.
+		 * \return Returns the index of the new variable.
+		 **/
+		size_t									Record( NN9_TAPE_OP _toOp, std::unique_ptr<Tensor> _upValue, size_t _sA, size_t _sB = NN9_TP_NONE, size_t _sC = NN9_TP_NONE );
+
+		/**
+		 * Records a broadcasting element-wise operation.
+		 *
+		 * \param _toOp NN9_TO_ADD, NN9_TO_SUB, or NN9_TO_MUL.
+		 * \param _sA The left variable.
+		 * \param _sB The right variable.
+		 * \param _pcFunc The name of the calling function, for errors.
+		 * \return Returns the index of the result.
+		 **/
+		size_t									Binary( NN9_TAPE_OP _toOp, size_t _sA, size_t _sB, const char * _pcFunc );
+
+		/**
+		 * Records Relu(), Tanh(), Softmax(), or LogSoftmax().
+		 *
+		 * \param _toOp The operation.
+		 * \param _sA The input variable.
+		 * \param _sAxis The axis, for Softmax() and LogSoftmax().
+		 * \param _pcFunc The name of the calling function, for errors.
+		 * \return Returns the index of the result.
+		 **/
+		size_t									Unary( NN9_TAPE_OP _toOp, size_t _sA, size_t _sAxis, const char * _pcFunc );
+
+		/**
+		 * Records Sum() or Mean().
+		 *
+		 * \param _toOp The operation.
+		 * \param _sA The input variable.
+		 * \param _pcFunc The name of the calling function, for errors.
+		 * \return Returns the index of the result.
+		 **/
+		size_t									Reduce( NN9_TAPE_OP _toOp, size_t _sA, const char * _pcFunc );
+
+		/**
+		 * Runs the backward step of a variable, passing its gradient to its inputs.
+		 *
+		 * \tparam _tType The element type.
+		 * \param _sIdx The variable.
+		 **/
+		template <typename _tType>
+		void									BackwardStep( size_t _sIdx );
+
+		/**
+		 * Adds a contribution into the gradient of a variable, allocating the gradient first if needed.  The contribution is written by a
+		 *	function that receives the gradient and whether to add to it (true) or overwrite it (false).  Does nothing if the variable does not
+		 *	require a gradient.
+		 *
+		 * \tparam _tType The element type.
+		 * \tparam _tFunc The function type.
+		 * \param _sIdx The variable.
+		 * \param _fFunc The function that writes the contribution.
+		 **/
+		template <typename _tType, typename _tFunc>
+		void									Contribute( size_t _sIdx, const _tFunc &_fFunc );
+
+		/**
+		 * Gets a buffer into which to write a contribution to the gradient of a variable.  This is the gradient itself if it has not been
+		 *	written yet (allocating it if needed), or otherwise a temporary that Commit() adds into the gradient.
+		 *
+		 * \tparam _tType The element type.
+		 * \param _sIdx The variable.
+		 * \param _upTemp Holds the temporary, if one is needed.
+		 * \return Returns the buffer to overwrite with the contribution.
+		 **/
+		template <typename _tType>
+		StridedView<_tType>						Target( size_t _sIdx, std::unique_ptr<Tensor> &_upTemp );
+
+		/**
+		 * Finishes a contribution started by Target(), adding the temporary into the gradient if there is one.
+		 *
+		 * \tparam _tType The element type.
+		 * \param _sIdx The variable.
+		 * \param _upTemp The temporary returned by Target(), which is released.
+		 **/
+		template <typename _tType>
+		void									Commit( size_t _sIdx, std::unique_ptr<Tensor> &_upTemp );
+
+		/**
+		 * Adds a gradient with the shape of a broadcast result into the gradient of a variable that was broadcast to that shape, summing over
+		 *	the broadcast dimensions.
+		 *
+		 * \tparam _tType The element type.
+		 * \param _sIdx The variable.
+		 * \param _svGrad The gradient with the broadcast shape.
+		 * \param _tScale The factor by which to scale the contribution.
+		 **/
+		template <typename _tType>
+		void									Unbroadcast( size_t _sIdx, const StridedView<_tType> &_svGrad, _tType _tScale );
+
+		/**
+		 * Checks that the tape can record and that a type is supported.
+		 *
+		 * \param _tType The type to check.
+		 * \param _pcFunc The name of the calling function, for errors.
+		 * \throw Throws if the tape has already been run backward or the type is not float or double.
+		 **/
+		void									CheckRecord( NN9_TYPE _tType, const char * _pcFunc ) const;
+
+		/**
+		 * Determines whether the backward step of a variable reads the value of 1 of its inputs.  An input's value is only read to find the
+		 *	gradient of another input, so it depends on which inputs require gradients.
+		 *
+		 * \param _nNode The variable.
+		 * \param _sInput The index (0, 1, or 2) of the input.
+		 * \return Returns true if the step reads the input's value.
+		 **/
+		bool									ReadsInput( const NN9_NODE &_nNode, size_t _sInput ) const;
+
+		/**
+		 * Determines whether the backward step of an operation reads its own value.
+		 *
+		 * \param _toOp The operation.
+		 * \return Returns true if the step reads the operation's value.
+		 **/
+		static bool								ReadsOutput( NN9_TAPE_OP _toOp );
+
+		/**
+		 * Creates an uninitialized contiguous tensor.
+		 *
+		 * \param _vShape The shape of the tensor.
+		 * \param _tType The type of the tensor.
+		 * \return Returns the tensor.
+		 **/
+		static std::unique_ptr<Tensor>			NewTensor( const std::vector<size_t> &_vShape, NN9_TYPE _tType );
+
+		/**
+		 * Gets the number of elements in a shape.
+		 *
+		 * \param _vShape The shape.
+		 * \return Returns the product of the dimensions.
+		 **/
+		static size_t							Elements( const std::vector<size_t> &_vShape );
+	};
+
+}	// namespace nn9
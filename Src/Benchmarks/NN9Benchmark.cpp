@@ -0,0 +1,912 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Timed micro-benchmarks for the core systems.  Each benchmark prints its results to std::wcout.
+ */
+
+#include "NN9Benchmark.h"
+#include "../Autograd/NN9Tape.h"
+#include "../Buffers/NN9BufferManager.h"
+#include "../Foundation/NN9Kernels.h"
+#include "../Graph/NN9Graph.h"
+#include "../Ops/NN9Bf16Dot.h"
+#include "../Ops/NN9Conv2D.h"
+#include "../Ops/NN9Gemm.h"
+#include "../Ops/NN9Math.h"
+#include "../Ops/NN9Optimizer.h"
+#include "../Ops/NN9QGemm.h"
+#include "../Ops/NN9Quantize.h"
+#include "../Ops/NN9Softmax.h"
+#include "../Tensor/NN9Tensor.h"
+#include "../Utilities/NN9ThreadPool.h"
+#include "../Utilities/NN9Timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+
+namespace nn9 {
+
+	// == Functions.
+	/**
+	 * Runs every benchmark at the sizes used for tuning.  This takes minutes, so it runs only when requested (NeuralNet9 --bench).
+	 **/
+	void Benchmark::RunAll() {
+		BufferChurn( std::thread::hardware_concurrency(), 4096, 100000 );
+		ParallelFor( 1 << 24, 100 );
+		ParallelReduce( 1 << 24, 100 );
+		Gemm( 256, 256, 256, 100 );
+		Gemm( 1024, 1024, 1024, 10 );
+		Gemm( 64, 4096, 1024, 10 );
+		Gemm( 4096, 64, 1024, 10 );
+		Bf16Gemm( 1024, 1024, 1024, 10 );
+		Int8Gemm( 1024, 1024, 1024, 10 );
+		Int8Gemm( 64, 4096, 1024, 10 );
+		Reduce( 4096, 4096, 20 );
+		Reduce( 64, 65536, 20 );
+		Softmax( 8192, 1000, 10 );
+		Softmax( 64, 65536, 10 );
+		Conv2D( 64, 1, 28, 6, 5, 1, 0, 10 );
+		Conv2D( 64, 6, 12, 16, 5, 1, 0, 10 );
+		Conv2D( 8, 3, 224, 64, 7, 2, 3, 3 );
+		Conv2D( 8, 64, 56, 64, 3, 1, 1, 3 );
+		Conv2D( 8, 256, 14, 256, 3, 1, 1, 3 );
+		Conv2D( 8, 256, 14, 1024, 1, 1, 0, 3 );
+		Autograd( 256, 1024, 10, 4, 10 );
+		Autograd( 4096, 256, 10, 8, 10 );
+		Optimizer( 4, 4 * 1024 * 1024, 10 );
+		Optimizer( 2000, 512, 100 );
+		Graph( 4096, 4096, 10 );
+		Graph( 64, 1000, 1000 );
+		GraphMemory( 256, 1024, 8, 10 );
+		Dispatch( 1 << 24, 10 );
+	}
+
+	/**
+	 * Churns tensors from many threads at once while a large set of tensors stays alive, measuring the cost of buffer creation and release
+	 *	under contention.
+	 * 
+	 * \param _sThreads The number of threads to run concurrently.
+	 * \param _sLiveTensors The number of tensors each thread keeps alive for the duration of the test.
+	 * \param _sIterations The number of create/release cycles each thread performs.
+	 * \return Returns the number of create/release cycles per second across all threads.
+	 **/
+	double Benchmark::BufferChurn( size_t _sThreads, size_t _sLiveTensors, size_t _sIterations ) {
+		auto aWorker = [_sLiveTensors, _sIterations]() {
+			std::vector<std::unique_ptr<Tensor>> vLive;
+			vLive.reserve( _sLiveTensors );
+			for ( size_t I = 0; I < _sLiveTensors; ++I ) {
+				vLive.emplace_back( std::make_unique<Tensor>( std::initializer_list<size_t>{ 4, 4 }, NN9_T_FLOAT ) );
+			}
+			// Replace live tensors in a strided order so releases do not always hit the most-recently created buffer.
+			for ( size_t I = 0; I < _sIterations; ++I ) {
+				size_t sIdx = (I * 7919) % _sLiveTensors;
+				vLive[sIdx] = std::make_unique<Tensor>( std::initializer_list<size_t>{ 4, 4 }, NN9_T_FLOAT );
+			}
+		};
+
+		auto & caAllocator = BufferManager::GblBufferManager.Allocator();
+		caAllocator.ResetStats();
+		Timer tTimer;
+		tTimer.Start();
+		{
+			std::vector<std::thread> vThreads;
+			vThreads.reserve( _sThreads );
+			for ( size_t I = 0; I < _sThreads; ++I ) {
+				vThreads.emplace_back( aWorker );
+			}
+			for ( auto & tThis : vThreads ) {
+				tThis.join();
+			}
+		}
+		tTimer.Stop();
+
+		double dCycles = double( _sThreads ) * double( _sIterations + _sLiveTensors );
+		double dPerSec = dCycles / tTimer.ElapsedSeconds();
+		std::wcout << L"Benchmark::BufferChurn( " << _sThreads << L" threads, " << _sLiveTensors << L" live, " << _sIterations << L" iterations ): " <<
+			tTimer.ElapsedSeconds() << L" seconds, " << dPerSec << L" create/release per second." << std::endl;
+		std::wcout << L"	Allocator: " << caAllocator.Hits() << L" hits, " << caAllocator.Misses() << L" misses, " << caAllocator.CachedBytes() << L" bytes cached." << std::endl;
+		return dPerSec;
+	}
+
+	/**
+	 * Runs an element-wise kernel (y = a * x + y) over a float array with ThreadPool::ParallelFor() and with a hand-rolled baseline that
+	 *	starts one std::thread per core, gives each an equal slice, and joins them.
+	 * 
+	 * \param _sElements The number of elements in the arrays.
+	 * \param _sIterations The number of times the kernel is run by each method.
+	 * \return Returns the baseline time divided by the ThreadPool::ParallelFor() time.
+	 **/
+	double Benchmark::ParallelFor( size_t _sElements, size_t _sIterations ) {
+		std::vector<float> vX( _sElements, 1.0f ), vY( _sElements, 0.0f );
+		auto aKernel = [&]( size_t _sBegin, size_t _sEnd ) {
+			for ( size_t I = _sBegin; I < _sEnd; ++I ) { vY[I] = 0.5f * vX[I] + vY[I]; }
+		};
+		const size_t sThreads = std::max<size_t>( std::thread::hardware_concurrency(), 1 );
+
+		Timer tBaseline;
+		tBaseline.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) {
+			std::vector<std::thread> vThreads;
+			vThreads.reserve( sThreads );
+			for ( size_t I = 0; I < sThreads; ++I ) {
+				vThreads.emplace_back( aKernel, _sElements * I / sThreads, _sElements * (I + 1) / sThreads );
+			}
+			for ( auto & tThis : vThreads ) {
+				tThis.join();
+			}
+		}
+		tBaseline.Stop();
+
+		ThreadPool & tpPool = ThreadPool::Global();
+		Timer tPool;
+		tPool.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) {
+			tpPool.ParallelFor( 0, _sElements, 0, aKernel );
+		}
+		tPool.Stop();
+
+		double dSpeedUp = tBaseline.ElapsedSeconds() / tPool.ElapsedSeconds();
+		std::wcout << L"Benchmark::ParallelFor( " << _sElements << L" elements, " << _sIterations << L" iterations ): std::thread " <<
+			tBaseline.ElapsedSeconds() << L" seconds, ThreadPool " << tPool.ElapsedSeconds() << L" seconds (" << dSpeedUp << L"x)." << std::endl;
+		return dSpeedUp;
+	}
+
+	/**
+	 * Sums a float array with ThreadPool::ParallelReduce() and with a hand-rolled baseline that starts one std::thread per core, has each
+	 *	sum an equal slice into its own slot, joins them, and adds the slots.
+	 * 
+	 * \param _sElements The number of elements in the array.
+	 * \param _sIterations The number of times the sum is run by each method.
+	 * \return Returns the baseline time divided by the ThreadPool::ParallelReduce() time.
+	 **/
+	double Benchmark::ParallelReduce( size_t _sElements, size_t _sIterations ) {
+		std::vector<float> vX( _sElements, 1.0f );
+		auto aSum = [&]( size_t _sBegin, size_t _sEnd ) {
+			double dSum = 0.0;
+			for ( size_t I = _sBegin; I < _sEnd; ++I ) { dSum += vX[I]; }
+			return dSum;
+		};
+		const size_t sThreads = std::max<size_t>( std::thread::hardware_concurrency(), 1 );
+
+		double dBaseline = 0.0;
+		Timer tBaseline;
+		tBaseline.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) {
+			std::vector<double> vSums( sThreads );
+			std::vector<std::thread> vThreads;
+			vThreads.reserve( sThreads );
+			for ( size_t I = 0; I < sThreads; ++I ) {
+				vThreads.emplace_back( [&, I]() { vSums[I] = aSum( _sElements * I / sThreads, _sElements * (I + 1) / sThreads ); } );
+			}
+			for ( auto & tThis : vThreads ) {
+				tThis.join();
+			}
+			dBaseline = 0.0;
+			for ( auto dThis : vSums ) { dBaseline += dThis; }
+		}
+		tBaseline.Stop();
+
+		ThreadPool & tpPool = ThreadPool::Global();
+		double dPool = 0.0;
+		Timer tPool;
+		tPool.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) {
+			dPool = tpPool.ParallelReduce( 0, _sElements, 0, 0.0, aSum, []( double _dLeft, double _dRight ) { return _dLeft + _dRight; } );
+		}
+		tPool.Stop();
+
+		double dSpeedUp = tBaseline.ElapsedSeconds() / tPool.ElapsedSeconds();
+		std::wcout << L"Benchmark::ParallelReduce( " << _sElements << L" elements, " << _sIterations << L" iterations ): std::thread " <<
+			tBaseline.ElapsedSeconds() << L" seconds, ThreadPool " << tPool.ElapsedSeconds() << L" seconds (" << dSpeedUp << L"x).  Sums: " <<
+			dBaseline << L", " << dPool << L"." << std::endl;
+		return dSpeedUp;
+	}
+
+	/**
+	 * Multiplies 2 float matrices with Gemm::Run() and with naive triple loops (i-k-j order), printing the GFLOP/s of each.
+	 * 
+	 * \param _sM The number of rows in A and C.
+	 * \param _sN The number of columns in B and C.
+	 * \param _sK The number of columns in A and rows in B.
+	 * \param _sIterations The number of times Gemm::Run() is run.  The naive loops run once.
+	 * \return Returns the Gemm::Run() GFLOP/s divided by the naive GFLOP/s.
+	 **/
+	double Benchmark::Gemm( size_t _sM, size_t _sN, size_t _sK, size_t _sIterations ) {
+		std::vector<float> vA( _sM * _sK ), vB( _sK * _sN ), vC( _sM * _sN ), vNaive( _sM * _sN, 0.0f );
+		std::mt19937 mGen( 0 );
+		std::uniform_real_distribution<float> urdDist( -1.0f, 1.0f );
+		for ( auto & fThis : vA ) { fThis = urdDist( mGen ); }
+		for ( auto & fThis : vB ) { fThis = urdDist( mGen ); }
+		const double dFlops = 2.0 * double( _sM ) * double( _sN ) * double( _sK );
+
+		Timer tNaive;
+		tNaive.Start();
+		for ( size_t I = 0; I < _sM; ++I ) {
+			for ( size_t K = 0; K < _sK; ++K ) {
+				const float fA = vA[I*_sK+K];
+				for ( size_t J = 0; J < _sN; ++J ) { vNaive[I*_sN+J] += fA * vB[K*_sN+J]; }
+			}
+		}
+		tNaive.Stop();
+
+		Timer tGemm;
+		tGemm.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) {
+			nn9::Gemm::Run<float>( _sM, _sN, _sK, vA.data(), _sK, 1, vB.data(), _sN, 1, vC.data(), _sN, 1 );
+		}
+		tGemm.Stop();
+
+		float fMaxErr = 0.0f;
+		for ( size_t I = 0; I < vC.size(); ++I ) { fMaxErr = std::max( fMaxErr, std::abs( vC[I] - vNaive[I] ) ); }
+		double dNaive = dFlops / tNaive.ElapsedSeconds() * 1.0e-9;
+		double dGemm = dFlops * double( _sIterations ) / tGemm.ElapsedSeconds() * 1.0e-9;
+		std::wcout << L"Benchmark::Gemm( " << _sM << L" x " << _sN << L" x " << _sK << L", " << _sIterations << L" iterations ): naive " <<
+			dNaive << L" GFLOP/s, Gemm " << dGemm << L" GFLOP/s (" << (dGemm / dNaive) << L"x).  Max difference: " << fMaxErr << L"." << std::endl;
+		return dGemm / dNaive;
+	}
+
+	/**
+	 * Multiplies 2 bfloat16 matrices with Gemm::Run() using the widen-to-float kernel, the vdpbf16ps kernel (when the CPU has
+	 *	AVX512-BF16), and the emulated vdpbf16ps kernel, and times Bf16Dot::Dot() over a long vector with each kernel.
+	 * 
+	 * \param _sM The number of rows in A and C.
+	 * \param _sN The number of columns in B and C.
+	 * \param _sK The number of columns in A and rows in B.
+	 * \param _sIterations The number of times each kernel is run.
+	 * \return Returns the vdpbf16ps GEMM GFLOP/s divided by the widen-to-float GEMM GFLOP/s, or 0 if the CPU does not have AVX512-BF16.
+	 **/
+	double Benchmark::Bf16Gemm( size_t _sM, size_t _sN, size_t _sK, size_t _sIterations ) {
+		std::vector<bfloat16_t> vA( _sM * _sK ), vB( _sK * _sN ), vC( _sM * _sN );
+		std::mt19937 mGen( 0 );
+		std::uniform_real_distribution<float> urdDist( -1.0f, 1.0f );
+		for ( auto & bThis : vA ) { bThis = bfloat16_t( urdDist( mGen ) ); }
+		for ( auto & bThis : vB ) { bThis = bfloat16_t( urdDist( mGen ) ); }
+		const double dFlops = 2.0 * double( _sM ) * double( _sN ) * double( _sK ) * double( _sIterations );
+		const bool bNative = Bf16Dot::Resolve( Bf16Dot::NN9_BK_NATIVE ) == Bf16Dot::NN9_BK_NATIVE;
+
+		const struct {
+			Bf16Dot::NN9_BF16_KERNEL					bkKernel;
+			const wchar_t *								pwcName;
+		} sKernels[] = {
+			{ Bf16Dot::NN9_BK_WIDEN, L"widen" },
+			{ Bf16Dot::NN9_BK_NATIVE, L"vdpbf16ps" },
+			{ Bf16Dot::NN9_BK_EMULATED, L"emulated" },
+		};
+		double dGflops[3] = {};
+		for ( size_t I = 0; I < 3; ++I ) {
+			if ( sKernels[I].bkKernel == Bf16Dot::NN9_BK_NATIVE && !bNative ) { continue; }
+			Timer tGemm;
+			tGemm.Start();
+			for ( size_t J = 0; J < _sIterations; ++J ) {
+				nn9::Gemm::Run<bfloat16_t>( _sM, _sN, _sK, vA.data(), _sK, 1, vB.data(), _sN, 1, vC.data(), _sN, 1, 1.0, 0.0, sKernels[I].bkKernel );
+			}
+			tGemm.Stop();
+			float fDot = 0.0f;
+			Timer tDot;
+			tDot.Start();
+			for ( size_t J = 0; J < _sIterations; ++J ) {
+				fDot = Bf16Dot::Dot( vA.data(), vA.data(), vA.size(), sKernels[I].bkKernel );
+			}
+			tDot.Stop();
+			dGflops[I] = dFlops / tGemm.ElapsedSeconds() * 1.0e-9;
+			std::wcout << L"Benchmark::Bf16Gemm( " << _sM << L" x " << _sN << L" x " << _sK << L", " << _sIterations << L" iterations ): " <<
+				sKernels[I].pwcName << L" " << dGflops[I] << L" GFLOP/s, Dot( " << vA.size() << L" ) " <<
+				(2.0 * double( vA.size() ) * double( _sIterations ) / tDot.ElapsedSeconds() * 1.0e-9) << L" GFLOP/s = " << fDot << L"." << std::endl;
+		}
+		return bNative ? dGflops[1] / dGflops[0] : 0.0;
+	}
+
+
+	/**
+	 * Multiplies a uint8_t matrix by int8_t weights with QGemm::Run() using each int8 kernel the CPU supports, followed by requantization
+	 *	to uint8_t, and compares the time with a float Gemm::Run() of the same size.  Also reports the memory used by each form of the weights.
+	 * 
+	 * \param _sM The number of rows in A and C.
+	 * \param _sN The number of columns in B and C.
+	 * \param _sK The number of columns in A and rows in B.
+	 * \param _sIterations The number of times each kernel is run.
+	 * \return Returns the fastest int8 GOP/s divided by the float GFLOP/s.
+	 **/
+	double Benchmark::Int8Gemm( size_t _sM, size_t _sN, size_t _sK, size_t _sIterations ) {
+		std::vector<float> vA( _sM * _sK ), vB( _sK * _sN ), vC( _sM * _sN );
+		std::mt19937 mGen( 0 );
+		std::uniform_real_distribution<float> urdDist( -1.0f, 1.0f );
+		for ( auto & fThis : vA ) { fThis = std::max( urdDist( mGen ), 0.0f ); }
+		for ( auto & fThis : vB ) { fThis = urdDist( mGen ); }
+		const double dOps = 2.0 * double( _sM ) * double( _sN ) * double( _sK ) * double( _sIterations );
+
+		Timer tFloat;
+		tFloat.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) {
+			nn9::Gemm::Run<float>( _sM, _sN, _sK, vA.data(), _sK, 1, vB.data(), _sN, 1, vC.data(), _sN, 1 );
+		}
+		tFloat.Stop();
+		const double dFloat = dOps / tFloat.ElapsedSeconds() * 1.0e-9;
+
+		// Activations are asymmetric uint8_t and weights are symmetric int8_t.
+		const Quantize::NN9_QPARAMS qpA = Quantize::ChooseParams<uint8_t>( vA.data(), vA.size() );
+		const Quantize::NN9_QPARAMS qpB = Quantize::ChooseParams<int8_t>( vB.data(), vB.size(), true );
+		std::vector<uint8_t> vQa( vA.size() ), vQc( vC.size() );
+		std::vector<int8_t> vQb( vB.size() );
+		std::vector<int32_t> vAcc( vC.size() );
+		Quantize::QuantizeLinear( vA.data(), vQa.data(), vQa.size(), qpA.fScale, qpA.i32Zero );
+		Quantize::QuantizeLinear( vB.data(), vQb.data(), vQb.size(), qpB.fScale, qpB.i32Zero );
+		const QGemm::NN9_PACKED_B pbB = QGemm::PackB( _sK, _sN, vQb.data(), _sN, 1 );
+		const float fRequant = qpA.fScale * qpB.fScale / 0.05f;
+		std::wcout << L"Benchmark::Int8Gemm( " << _sM << L" x " << _sN << L" x " << _sK << L" ): float " << dFloat << L" GFLOP/s, weights " <<
+			vB.size() * sizeof( float ) << L" bytes as float, " << pbB.vData.size() << L" bytes packed as int8." << std::endl;
+
+		const struct {
+			QGemm::NN9_QGEMM_KERNEL						qkKernel;
+			const wchar_t *								pwcName;
+		} sKernels[] = {
+			{ QGemm::NN9_QK_AVX512VNNI, L"AVX512-VNNI" },
+			{ QGemm::NN9_QK_AVXVNNI, L"AVX-VNNI" },
+			{ QGemm::NN9_QK_AVX2, L"AVX2" },
+			{ QGemm::NN9_QK_SCALAR, L"scalar" },
+		};
+		double dBest = 0.0;
+		for ( const auto & kThis : sKernels ) {
+			if ( QGemm::Resolve( kThis.qkKernel ) != kThis.qkKernel ) { continue; }
+			Timer tInt8;
+			tInt8.Start();
+			for ( size_t J = 0; J < _sIterations; ++J ) {
+				QGemm::Run( _sM, vQa.data(), _sK, qpA.i32Zero, pbB, vAcc.data(), _sN, kThis.qkKernel );
+				Quantize::Requantize( vAcc.data(), vQc.data(), _sM, _sN, &fRequant, false, 0 );
+			}
+			tInt8.Stop();
+			const double dInt8 = dOps / tInt8.ElapsedSeconds() * 1.0e-9;
+			dBest = std::max( dBest, dInt8 );
+			std::wcout << L"Benchmark::Int8Gemm( " << _sM << L" x " << _sN << L" x " << _sK << L", " << _sIterations << L" iterations ): " <<
+				kThis.pwcName << L" " << dInt8 << L" GOP/s (" << (dInt8 / dFloat) << L"x float)." << std::endl;
+		}
+		return dBest / dFloat;
+	}
+
+	/**
+	 * Sums a float tensor over its inner and outer axes with Math::Sum() and with naive scalar loops, and times the Kahan sum, Math::Max(),
+	 *	and Math::ArgMax() over the same axes.
+	 * 
+	 * \param _sRows The number of rows in the tensor.
+	 * \param _sCols The number of columns in the tensor.
+	 * \param _sIterations The number of times each reduction is run.
+	 * \return Returns the naive outer-axis time divided by the Math::Sum() outer-axis time.
+	 **/
+	double Benchmark::Reduce( size_t _sRows, size_t _sCols, size_t _sIterations ) {
+		Tensor tIn( { _sRows, _sCols }, NN9_T_FLOAT ), tRows( { _sRows }, NN9_T_FLOAT ), tCols( { _sCols }, NN9_T_FLOAT );
+		Tensor tArgRows( { _sRows }, NN9_T_INT64 ), tArgCols( { _sCols }, NN9_T_INT64 );
+		auto vIn = tIn.FullView<float>();
+		std::mt19937 mGen( 0 );
+		std::uniform_real_distribution<float> urdDist( -1.0f, 1.0f );
+		for ( size_t I = 0; I < vIn.size(); ++I ) { vIn[I] = urdDist( mGen ); }
+		auto svIn = tIn.Strided<float>();
+		auto svRows = tRows.Strided<float>(), svCols = tCols.Strided<float>();
+		auto svArgRows = tArgRows.Strided<int64_t>(), svArgCols = tArgCols.Strided<int64_t>();
+		const double dBytes = double( vIn.size() ) * sizeof( float ) * double( _sIterations ) * 1.0e-9;
+		const float * pfIn = &vIn[0];
+		std::vector<float> vNaive( std::max( _sRows, _sCols ) );
+
+		// Naive loops: 1 running sum per output, walking the reduced axis with its stride.
+		Timer tNaiveInner, tNaiveOuter;
+		tNaiveInner.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) {
+			for ( size_t R = 0; R < _sRows; ++R ) {
+				float fSum = 0.0f;
+				for ( size_t C = 0; C < _sCols; ++C ) { fSum += pfIn[R*_sCols+C]; }
+				vNaive[R] = fSum;
+			}
+		}
+		tNaiveInner.Stop();
+		tNaiveOuter.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) {
+			for ( size_t C = 0; C < _sCols; ++C ) {
+				float fSum = 0.0f;
+				for ( size_t R = 0; R < _sRows; ++R ) { fSum += pfIn[R*_sCols+C]; }
+				vNaive[C] = fSum;
+			}
+		}
+		tNaiveOuter.Stop();
+
+		const struct {
+			const wchar_t *								pwcName;
+			size_t										sAxis;
+			size_t										sOp;
+		} sTests[] = {
+			{ L"Sum inner", 1, 0 },
+			{ L"Sum outer", 0, 0 },
+			{ L"KahanSum inner", 1, 1 },
+			{ L"KahanSum outer", 0, 1 },
+			{ L"Max inner", 1, 2 },
+			{ L"Max outer", 0, 2 },
+			{ L"ArgMax inner", 1, 3 },
+			{ L"ArgMax outer", 0, 3 },
+		};
+		double dOuter = 0.0;
+		std::wcout << L"Benchmark::Reduce( " << _sRows << L" x " << _sCols << L", " << _sIterations << L" iterations ): naive inner " <<
+			dBytes / tNaiveInner.ElapsedSeconds() << L" GB/s, naive outer " << dBytes / tNaiveOuter.ElapsedSeconds() << L" GB/s." << std::endl;
+		for ( const auto & tThis : sTests ) {
+			auto & svOut = tThis.sAxis ? svRows : svCols;
+			auto & svArg = tThis.sAxis ? svArgRows : svArgCols;
+			Timer tReduce;
+			tReduce.Start();
+			for ( size_t J = 0; J < _sIterations; ++J ) {
+				switch ( tThis.sOp ) {
+					case 0 : { Math::Sum( svIn, { tThis.sAxis }, svOut ); break; }
+					case 1 : { Math::Sum( svIn, { tThis.sAxis }, svOut, Math::NN9_RM_KAHAN ); break; }
+					case 2 : { Math::Max( svIn, { tThis.sAxis }, svOut ); break; }
+					default : { Math::ArgMax( svIn, tThis.sAxis, svArg ); }
+				}
+			}
+			tReduce.Stop();
+			if ( tThis.sAxis == 0 && tThis.sOp == 0 ) { dOuter = tNaiveOuter.ElapsedSeconds() / tReduce.ElapsedSeconds(); }
+			std::wcout << L"Benchmark::Reduce( " << _sRows << L" x " << _sCols << L" ): " << tThis.pwcName << L" " << dBytes / tReduce.ElapsedSeconds() <<
+				L" GB/s." << std::endl;
+		}
+		return dOuter;
+	}
+
+	/**
+	 * Runs a row-wise softmax over a float matrix with Softmax::Forward() and with separate max, subtract, exp, sum, and divide passes
+	 *	using std::exp(), and times Softmax::Forward() on bfloat16 and Softmax::LogForward() on float.
+	 * 
+	 * \param _sRows The number of rows in the matrix.
+	 * \param _sCols The number of columns in the matrix.
+	 * \param _sIterations The number of times each softmax is run.
+	 * \return Returns the separate-pass time divided by the float Softmax::Forward() time.
+	 **/
+	double Benchmark::Softmax( size_t _sRows, size_t _sCols, size_t _sIterations ) {
+		Tensor tIn( { _sRows, _sCols }, NN9_T_FLOAT ), tOut( { _sRows, _sCols }, NN9_T_FLOAT );
+		Tensor tInBf( { _sRows, _sCols }, NN9_T_BFLOAT16 ), tOutBf( { _sRows, _sCols }, NN9_T_BFLOAT16 );
+		auto vIn = tIn.FullView<float>();
+		auto vInBf = tInBf.FullView<bfloat16_t>();
+		std::mt19937 mGen( 0 );
+		std::uniform_real_distribution<float> urdDist( -8.0f, 8.0f );
+		for ( size_t I = 0; I < vIn.size(); ++I ) {
+			vIn[I] = urdDist( mGen );
+			vInBf[I] = bfloat16_t( vIn[I] );
+		}
+		const float * pfIn = &vIn[0];
+		std::vector<float> vMax( _sRows ), vSum( _sRows ), vTmp( vIn.size() );
+
+		// Separate passes, each over the whole matrix.
+		Timer tPasses;
+		tPasses.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) {
+			for ( size_t R = 0; R < _sRows; ++R ) {
+				float fMax = -std::numeric_limits<float>::infinity();
+				for ( size_t C = 0; C < _sCols; ++C ) { fMax = std::max( fMax, pfIn[R*_sCols+C] ); }
+				vMax[R] = fMax;
+			}
+			for ( size_t I = 0; I < vTmp.size(); ++I ) { vTmp[I] = pfIn[I] - vMax[I/_sCols]; }
+			for ( size_t I = 0; I < vTmp.size(); ++I ) { vTmp[I] = std::exp( vTmp[I] ); }
+			for ( size_t R = 0; R < _sRows; ++R ) {
+				float fSum = 0.0f;
+				for ( size_t C = 0; C < _sCols; ++C ) { fSum += vTmp[R*_sCols+C]; }
+				vSum[R] = fSum;
+			}
+			for ( size_t I = 0; I < vTmp.size(); ++I ) { vTmp[I] /= vSum[I/_sCols]; }
+		}
+		tPasses.Stop();
+
+		Timer tFused, tFusedBf, tLog;
+		tFused.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) { nn9::Softmax::Forward( tIn, tOut, 1 ); }
+		tFused.Stop();
+		tFusedBf.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) { nn9::Softmax::Forward( tInBf, tOutBf, 1 ); }
+		tFusedBf.Stop();
+		tLog.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) { nn9::Softmax::LogForward( tIn, tOut, 1 ); }
+		tLog.Stop();
+
+		const double dElements = double( vIn.size() ) * double( _sIterations ) * 1.0e-9;
+		std::wcout << L"Benchmark::Softmax( " << _sRows << L" x " << _sCols << L", " << _sIterations << L" iterations ): separate passes " <<
+			dElements / tPasses.ElapsedSeconds() << L" G elements/s, fused float " << dElements / tFused.ElapsedSeconds() << L" G elements/s, fused bfloat16 " <<
+			dElements / tFusedBf.ElapsedSeconds() << L" G elements/s, fused log-softmax float " << dElements / tLog.ElapsedSeconds() << L" G elements/s." << std::endl;
+		return tPasses.ElapsedSeconds() / tFused.ElapsedSeconds();
+	}
+
+	/**
+	 * Runs a float convolution with a naive scalar loop and with Conv2D::Forward() using each algorithm, and times Conv2D::BackwardData()
+	 *	and Conv2D::BackwardWeights().  Square images and kernels are used.
+	 * 
+	 * \param _sN The number of images.
+	 * \param _sC The number of input channels.
+	 * \param _sSize The width and height of the input.
+	 * \param _sO The number of output channels.
+	 * \param _sKernel The width and height of the kernel.
+	 * \param _sStride The stride.
+	 * \param _sPad The padding on each side.
+	 * \param _sIterations The number of times each pass is run.
+	 * \return Returns the naive time divided by the NN9_CA_AUTO time.
+	 **/
+	double Benchmark::Conv2D( size_t _sN, size_t _sC, size_t _sSize, size_t _sO, size_t _sKernel, size_t _sStride, size_t _sPad, size_t _sIterations ) {
+		nn9::Conv2D::NN9_CONV2D_PARAMS cpParms;
+		cpParms.sStrideH = cpParms.sStrideW = _sStride;
+		cpParms.sPadH = cpParms.sPadW = _sPad;
+		const size_t sOut = nn9::Conv2D::OutputSize( _sSize, _sKernel, _sStride, _sPad, 1 );
+		Tensor tIn( { _sN, _sC, _sSize, _sSize }, NN9_T_FLOAT ), tWeights( { _sO, _sC, _sKernel, _sKernel }, NN9_T_FLOAT ), tBias( { _sO }, NN9_T_FLOAT );
+		Tensor tOut( { _sN, _sO, sOut, sOut }, NN9_T_FLOAT ), tGradIn( { _sN, _sC, _sSize, _sSize }, NN9_T_FLOAT ), tGradWeights( { _sO, _sC, _sKernel, _sKernel }, NN9_T_FLOAT );
+		auto vIn = tIn.FullView<float>();
+		auto vWeights = tWeights.FullView<float>();
+		auto vBias = tBias.FullView<float>();
+		auto vOut = tOut.FullView<float>();
+		std::mt19937 mGen( 0 );
+		std::uniform_real_distribution<float> urdDist( -1.0f, 1.0f );
+		for ( size_t I = 0; I < vIn.size(); ++I ) { vIn[I] = urdDist( mGen ); }
+		for ( size_t I = 0; I < vWeights.size(); ++I ) { vWeights[I] = urdDist( mGen ); }
+		for ( size_t I = 0; I < vBias.size(); ++I ) { vBias[I] = urdDist( mGen ); }
+		const double dFlops = 2.0 * double( _sN ) * double( _sO ) * double( sOut * sOut ) * double( _sC * _sKernel * _sKernel );
+
+		// Naive direct loops, run once.
+		std::vector<float> vNaive( vOut.size() );
+		Timer tNaive;
+		tNaive.Start();
+		for ( size_t N = 0; N < _sN; ++N ) {
+			for ( size_t O = 0; O < _sO; ++O ) {
+				for ( size_t Y = 0; Y < sOut; ++Y ) {
+					for ( size_t X = 0; X < sOut; ++X ) {
+						float fSum = vBias[O];
+						for ( size_t C = 0; C < _sC; ++C ) {
+							for ( size_t KY = 0; KY < _sKernel; ++KY ) {
+								const size_t sY = Y * _sStride + KY;
+								if ( sY < _sPad || sY - _sPad >= _sSize ) { continue; }
+								for ( size_t KX = 0; KX < _sKernel; ++KX ) {
+									const size_t sX = X * _sStride + KX;
+									if ( sX < _sPad || sX - _sPad >= _sSize ) { continue; }
+									fSum += vIn[((N*_sC+C)*_sSize+sY-_sPad)*_sSize+sX-_sPad] * vWeights[((O*_sC+C)*_sKernel+KY)*_sKernel+KX];
+								}
+							}
+						}
+						vNaive[((N*_sO+O)*sOut+Y)*sOut+X] = fSum;
+					}
+				}
+			}
+		}
+		tNaive.Stop();
+
+		auto aTime = [&]( nn9::Conv2D::NN9_CONV_ALGO _caAlgo, float &_fMaxErr ) {
+			Timer tTime;
+			tTime.Start();
+			for ( size_t J = 0; J < _sIterations; ++J ) { nn9::Conv2D::Forward( tIn, tWeights, &tBias, tOut, cpParms, _caAlgo ); }
+			tTime.Stop();
+			_fMaxErr = 0.0f;
+			for ( size_t I = 0; I < vNaive.size(); ++I ) { _fMaxErr = std::max( _fMaxErr, std::abs( vOut[I] - vNaive[I] ) ); }
+			return dFlops * double( _sIterations ) / tTime.ElapsedSeconds() * 1.0e-9;
+		};
+		float fErrIm2Col, fErrDirect, fErrAuto;
+		const double dIm2Col = aTime( nn9::Conv2D::NN9_CA_IM2COL, fErrIm2Col );
+		const double dDirect = aTime( nn9::Conv2D::NN9_CA_DIRECT, fErrDirect );
+		const double dAuto = aTime( nn9::Conv2D::NN9_CA_AUTO, fErrAuto );
+
+		Timer tData, tWeight;
+		tData.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) { nn9::Conv2D::BackwardData( tOut, tWeights, tGradIn, cpParms ); }
+		tData.Stop();
+		tWeight.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) { nn9::Conv2D::BackwardWeights( tIn, tOut, tGradWeights, nullptr, cpParms ); }
+		tWeight.Stop();
+
+		const double dNaive = dFlops / tNaive.ElapsedSeconds() * 1.0e-9;
+		const bool bDirect = nn9::Conv2D::Select<float>( tIn.Shape(), tWeights.Shape(), cpParms ) == nn9::Conv2D::NN9_CA_DIRECT;
+		std::wcout << L"Benchmark::Conv2D( " << _sN << L" x " << _sC << L" x " << _sSize << L" x " << _sSize << L" -> " << _sO << L", " << _sKernel << L"x" << _sKernel <<
+			L" stride " << _sStride << L" pad " << _sPad << L", " << _sIterations << L" iterations ): naive " << dNaive << L" GFLOP/s, im2col " << dIm2Col <<
+			L" GFLOP/s, direct " << dDirect << L" GFLOP/s, auto (" << (bDirect ? L"direct" : L"im2col") << L") " << dAuto << L" GFLOP/s (" << (dAuto / dNaive) <<
+			L"x), backward data " << dFlops * double( _sIterations ) / tData.ElapsedSeconds() * 1.0e-9 << L" GFLOP/s, backward weights " <<
+			dFlops * double( _sIterations ) / tWeight.ElapsedSeconds() * 1.0e-9 << L" GFLOP/s.  Max difference: " << std::max( { fErrIm2Col, fErrDirect, fErrAuto } ) << L"." << std::endl;
+		return dAuto / dNaive;
+	}
+
+
+	/**
+	 * Runs training steps of a float multi-layer perceptron (MatMul(), bias Add(), and Relu() per layer, then LogSoftmax() and Nll()) through
+	 *	a Tape, and reports the forward and backward times, the memory live at the end of the forward pass, and the peak during Backward().
+	 * 
+	 * \param _sBatch The number of samples per step.
+	 * \param _sWidth The width of the input and of each hidden layer.
+	 * \param _sClasses The number of output classes.
+	 * \param _sLayers The number of hidden layers.
+	 * \param _sIterations The number of training steps.
+	 * \return Returns the peak memory during Backward() divided by the memory live at the end of the forward pass, both above the memory in use
+	 *	before the step.
+	 **/
+	double Benchmark::Autograd( size_t _sBatch, size_t _sWidth, size_t _sClasses, size_t _sLayers, size_t _sIterations ) {
+		std::mt19937 mGen( 0 );
+		std::uniform_real_distribution<float> urdDist( -1.0f, 1.0f );
+		auto aRandom = [&]( std::initializer_list<size_t> _ilShape, float _fScale ) {
+			Tensor tRet( _ilShape, NN9_T_FLOAT );
+			auto vRet = tRet.FullView<float>();
+			for ( size_t I = 0; I < vRet.size(); ++I ) { vRet[I] = urdDist( mGen ) * _fScale; }
+			return tRet;
+		};
+		const float fScale = 1.0f / std::sqrt( float( _sWidth ) );
+		Tensor tIn = aRandom( { _sBatch, _sWidth }, 1.0f );
+		std::vector<Tensor> vWeights, vBiases, vWeightGrads, vBiasGrads;
+		for ( size_t I = 0; I <= _sLayers; ++I ) {
+			const size_t sOut = I == _sLayers ? _sClasses : _sWidth;
+			vWeights.push_back( aRandom( { _sWidth, sOut }, fScale ) );
+			vBiases.push_back( aRandom( { sOut }, fScale ) );
+			vWeightGrads.emplace_back( std::initializer_list<size_t>{ _sWidth, sOut }, NN9_T_FLOAT, 0.0 );
+			vBiasGrads.emplace_back( std::initializer_list<size_t>{ sOut }, NN9_T_FLOAT, 0.0 );
+		}
+		std::vector<size_t> vLabels( _sBatch );
+		for ( size_t I = 0; I < _sBatch; ++I ) { vLabels[I] = mGen() % _sClasses; }
+
+		Timer tForward, tBackward;
+		double dForward = 0.0, dBackward = 0.0;
+		uint64_t ui64Forward = 0, ui64Backward = 0;
+		for ( size_t J = 0; J < _sIterations; ++J ) {
+			Tape tTape;
+			const uint64_t ui64Base = BufferManager::GblBufferManager.TotalMemory();
+			tForward.Start();
+			size_t sX = tTape.Leaf( tIn, false );
+			for ( size_t I = 0; I <= _sLayers; ++I ) {
+				sX = tTape.Add( tTape.MatMul( sX, tTape.Leaf( vWeights[I], vWeightGrads[I] ) ), tTape.Leaf( vBiases[I], vBiasGrads[I] ) );
+				if ( I != _sLayers ) { sX = tTape.Relu( sX ); }
+			}
+			const size_t sLoss = tTape.Nll( tTape.LogSoftmax( sX, 1 ), vLabels );
+			tForward.Stop();
+			const uint64_t ui64Live = BufferManager::GblBufferManager.TotalMemory();
+			tBackward.Start();
+			tTape.Backward( sLoss );
+			tBackward.Stop();
+			dForward += tForward.ElapsedSeconds();
+			dBackward += tBackward.ElapsedSeconds();
+			ui64Forward = std::max( ui64Forward, ui64Live - ui64Base );
+			ui64Backward = std::max( ui64Backward, tTape.PeakMemory() - ui64Base );
+		}
+
+		std::wcout << L"Benchmark::Autograd( " << _sBatch << L" x " << _sWidth << L" -> " << _sClasses << L", " << _sLayers << L" hidden layers, " << _sIterations <<
+			L" iterations ): forward " << dForward * 1000.0 / double( _sIterations ) << L" ms/step, backward " <<
+			dBackward * 1000.0 / double( _sIterations ) << L" ms/step, forward live " << ui64Forward / 1024 << L" KB, backward peak " <<
+			ui64Backward / 1024 << L" KB." << std::endl;
+		return double( ui64Backward ) / double( std::max<uint64_t>( ui64Forward, 1 ) );
+	}
+
+
+	/**
+	 * Runs float Adam steps over a group of equally sized parameters with separate scalar passes (as a chain of element-wise tensor
+	 *	operations would make), with 1 Optimizer::Adam() call per tensor, and with 1 multi-tensor Optimizer::Adam() call for the group, and
+	 *	times a bfloat16 Optimizer::AdamW() group step.
+	 * 
+	 * \param _sTensors The number of parameter tensors.
+	 * \param _sElements The number of elements in each tensor.
+	 * \param _sIterations The number of steps each method runs.
+	 * \return Returns the separate-pass time divided by the multi-tensor time.
+	 **/
+	double Benchmark::Optimizer( size_t _sTensors, size_t _sElements, size_t _sIterations ) {
+		std::mt19937 mGen( 0 );
+		std::uniform_real_distribution<float> urdDist( -1.0f, 1.0f );
+		std::vector<Tensor> vParams, vGrads, vM, vV, vParamsBf, vGradsBf;
+		for ( size_t I = 0; I < _sTensors; ++I ) {
+			vParams.emplace_back( std::initializer_list<size_t>{ _sElements }, NN9_T_FLOAT );
+			vGrads.emplace_back( std::initializer_list<size_t>{ _sElements }, NN9_T_FLOAT );
+			vM.emplace_back( std::initializer_list<size_t>{ _sElements }, NN9_T_FLOAT, 0.0 );
+			vV.emplace_back( std::initializer_list<size_t>{ _sElements }, NN9_T_FLOAT, 0.0 );
+			auto vP = vParams.back().FullView<float>();
+			auto vG = vGrads.back().FullView<float>();
+			for ( size_t J = 0; J < _sElements; ++J ) {
+				vP[J] = urdDist( mGen );
+				vG[J] = urdDist( mGen );
+			}
+			vParamsBf.emplace_back( vParams.back().CopyAs( NN9_T_BFLOAT16 ) );
+			vGradsBf.emplace_back( vGrads.back().CopyAs( NN9_T_BFLOAT16 ) );
+		}
+		std::vector<nn9::Optimizer::NN9_PARAM> vGroup, vGroupBf;
+		for ( size_t I = 0; I < _sTensors; ++I ) {
+			vGroup.emplace_back( &vParams[I], &vGrads[I], &vM[I], &vV[I] );
+			vGroupBf.emplace_back( &vParamsBf[I], &vGradsBf[I], &vM[I], &vV[I] );
+		}
+		const nn9::Optimizer::NN9_ADAM_PARAMS apParms( 1.0e-3 );
+
+		// Separate passes: 1 per operation, each over every tensor.
+		std::vector<float> vTmp( _sElements );
+		Timer tPasses;
+		tPasses.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) {
+			const float fBias1 = float( 1.0 - std::pow( apParms.dBeta1, double( J + 1 ) ) );
+			const float fBias2 = float( 1.0 - std::pow( apParms.dBeta2, double( J + 1 ) ) );
+			for ( size_t I = 0; I < _sTensors; ++I ) {
+				auto vP = vParams[I].FullView<float>();
+				auto vG = vGrads[I].FullView<float>();
+				auto vMom = vM[I].FullView<float>();
+				auto vVar = vV[I].FullView<float>();
+				float * pfP = &vP[0];
+				const float * pfG = &vG[0];
+				float * pfM = &vMom[0];
+				float * pfV = &vVar[0];
+				for ( size_t K = 0; K < _sElements; ++K ) { pfM[K] *= float( apParms.dBeta1 ); }
+				for ( size_t K = 0; K < _sElements; ++K ) { pfM[K] += float( 1.0 - apParms.dBeta1 ) * pfG[K]; }
+				for ( size_t K = 0; K < _sElements; ++K ) { pfV[K] *= float( apParms.dBeta2 ); }
+				for ( size_t K = 0; K < _sElements; ++K ) { vTmp[K] = pfG[K] * pfG[K]; }
+				for ( size_t K = 0; K < _sElements; ++K ) { pfV[K] += float( 1.0 - apParms.dBeta2 ) * vTmp[K]; }
+				for ( size_t K = 0; K < _sElements; ++K ) { vTmp[K] = std::sqrt( pfV[K] / fBias2 ) + float( apParms.dEps ); }
+				for ( size_t K = 0; K < _sElements; ++K ) { vTmp[K] = pfM[K] / fBias1 / vTmp[K]; }
+				for ( size_t K = 0; K < _sElements; ++K ) { pfP[K] -= float( apParms.dLr ) * vTmp[K]; }
+			}
+		}
+		tPasses.Stop();
+
+		Timer tPerTensor, tGroup, tGroupBf;
+		tPerTensor.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) {
+			for ( size_t I = 0; I < _sTensors; ++I ) { nn9::Optimizer::Adam( vParams[I], vGrads[I], vM[I], vV[I], apParms, J + 1 ); }
+		}
+		tPerTensor.Stop();
+		tGroup.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) { nn9::Optimizer::Adam( vGroup, apParms, J + 1 ); }
+		tGroup.Stop();
+		tGroupBf.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) { nn9::Optimizer::AdamW( vGroupBf, apParms, J + 1, J ); }
+		tGroupBf.Stop();
+
+		// Bytes read and written once each: parameter, gradient, and 2 moments in, parameter and 2 moments out.
+		const double dBytes = double( _sTensors ) * double( _sElements ) * double( _sIterations ) * 28.0 * 1.0e-9;
+		const double dBytesBf = double( _sTensors ) * double( _sElements ) * double( _sIterations ) * 22.0 * 1.0e-9;
+		std::wcout << L"Benchmark::Optimizer( " << _sTensors << L" x " << _sElements << L", " << _sIterations << L" iterations ): separate passes " <<
+			tPasses.ElapsedSeconds() * 1000.0 / double( _sIterations ) << L" ms/step, fused per tensor " << tPerTensor.ElapsedSeconds() * 1000.0 / double( _sIterations ) <<
+			L" ms/step, fused multi-tensor " << tGroup.ElapsedSeconds() * 1000.0 / double( _sIterations ) << L" ms/step (" << dBytes / tGroup.ElapsedSeconds() <<
+			L" GB/s), bfloat16 AdamW multi-tensor " << tGroupBf.ElapsedSeconds() * 1000.0 / double( _sIterations ) << L" ms/step (" << dBytesBf / tGroupBf.ElapsedSeconds() <<
+			L" GB/s)." << std::endl;
+		return tPasses.ElapsedSeconds() / tGroup.ElapsedSeconds();
+	}
+
+	/**
+	 * Runs the float chain tanh( x * x + b ) * c, with x [rows, columns], b [columns], and c [rows, 1], as a Graph that writes every
+	 *	intermediate (1 kernel per operation) and as a Graph that fuses the chain into 1 kernel.
+	 * 
+	 * \param _sRows The number of rows.
+	 * \param _sCols The number of columns.
+	 * \param _sIterations The number of times each graph runs.
+	 * \return Returns the unfused time divided by the fused time.
+	 **/
+	double Benchmark::Graph( size_t _sRows, size_t _sCols, size_t _sIterations ) {
+		Tensor tX( { _sRows, _sCols }, NN9_T_FLOAT ), tB( { _sCols }, NN9_T_FLOAT ), tC( { _sRows, size_t( 1 ) }, NN9_T_FLOAT );
+		std::mt19937 mGen( 0 );
+		std::uniform_real_distribution<float> urdDist( -1.0f, 1.0f );
+		auto vX = tX.FullView<float>();
+		auto vB = tB.FullView<float>();
+		auto vC = tC.FullView<float>();
+		for ( size_t I = 0; I < vX.size(); ++I ) { vX[I] = urdDist( mGen ); }
+		for ( size_t I = 0; I < vB.size(); ++I ) { vB[I] = urdDist( mGen ); }
+		for ( size_t I = 0; I < vC.size(); ++I ) { vC[I] = urdDist( mGen ); }
+		const std::vector<Tensor *> vInputs = { &tX, &tB, &tC };
+
+		// Marking every intermediate as an output keeps it from being fused.
+		nn9::Graph gUnfused, gFused;
+		for ( auto pgGraph : { &gUnfused, &gFused } ) {
+			const size_t sX = pgGraph->Input( { _sRows, _sCols } ), sB = pgGraph->Input( { _sCols } ), sC = pgGraph->Input( { _sRows, 1 } );
+			const size_t sSquare = pgGraph->Square( sX );
+			const size_t sAdd = pgGraph->Add( sSquare, sB );
+			const size_t sTanh = pgGraph->Tanh( sAdd );
+			const size_t sY = pgGraph->Mul( sTanh, sC );
+			if ( pgGraph == &gUnfused ) {
+				pgGraph->Output( sSquare );
+				pgGraph->Output( sAdd );
+				pgGraph->Output( sTanh );
+			}
+			pgGraph->Output( sY );
+			pgGraph->Compile();
+		}
+		std::vector<Tensor> vUnfused = gUnfused.Run( vInputs ), vFused = gFused.Run( vInputs );
+		std::vector<Tensor *> vUnfusedOut, vFusedOut;
+		for ( auto & tOut : vUnfused ) { vUnfusedOut.push_back( &tOut ); }
+		for ( auto & tOut : vFused ) { vFusedOut.push_back( &tOut ); }
+
+		Timer tUnfused, tFused;
+		tUnfused.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) { gUnfused.Run( vInputs, vUnfusedOut ); }
+		tUnfused.Stop();
+		tFused.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) { gFused.Run( vInputs, vFusedOut ); }
+		tFused.Stop();
+
+		// The fused chain's traffic: x read once and y written once.
+		const double dBytes = double( _sRows ) * double( _sCols ) * double( _sIterations ) * 8.0 * 1.0e-9;
+		std::wcout << L"Benchmark::Graph( " << _sRows << L" x " << _sCols << L", " << _sIterations << L" iterations ): unfused (" << gUnfused.Kernels() <<
+			L" kernels) " << tUnfused.ElapsedSeconds() * 1000.0 / double( _sIterations ) << L" ms, fused (" << gFused.Kernels() << L" kernel) " <<
+			tFused.ElapsedSeconds() * 1000.0 / double( _sIterations ) << L" ms (" << dBytes / tFused.ElapsedSeconds() << L" GB/s of 1 read and 1 write)." << std::endl;
+		return tUnfused.ElapsedSeconds() / tFused.ElapsedSeconds();
+	}
+
+	/**
+	 * Compiles and runs a float Graph of layers of relu( h * W + b ) ending in a log-softmax, and reports the memory planned for its
+	 *	intermediate values against the memory they would take with 1 buffer each, along with the peak memory measured during Run().
+	 * 
+	 * \param _sBatch The number of rows of h.
+	 * \param _sWidth The width of every layer.
+	 * \param _sLayers The number of layers.
+	 * \param _sIterations The number of times the graph runs.
+	 * \return Returns the naive size divided by the planned size.
+	 **/
+	double Benchmark::GraphMemory( size_t _sBatch, size_t _sWidth, size_t _sLayers, size_t _sIterations ) {
+		std::mt19937 mGen( 0 );
+		std::uniform_real_distribution<float> urdDist( -1.0f, 1.0f );
+		auto aRandom = [&]( Tensor &_tDst, float _fScale ) {
+			auto vDst = _tDst.FullView<float>();
+			for ( size_t I = 0; I < vDst.size(); ++I ) { vDst[I] = urdDist( mGen ) * _fScale; }
+		};
+		Tensor tX( { _sBatch, _sWidth }, NN9_T_FLOAT );
+		aRandom( tX, 1.0f );
+		std::vector<Tensor> vWeights, vBiases;
+		for ( size_t I = 0; I < _sLayers; ++I ) {
+			vWeights.emplace_back( std::initializer_list<size_t>{ _sWidth, _sWidth }, NN9_T_FLOAT );
+			vBiases.emplace_back( std::initializer_list<size_t>{ _sWidth }, NN9_T_FLOAT );
+			aRandom( vWeights.back(), 1.0f / std::sqrt( float( _sWidth ) ) );
+			aRandom( vBiases.back(), 0.1f );
+		}
+
+		nn9::Graph gGraph;
+		std::vector<Tensor *> vInputs = { &tX };
+		size_t sH = gGraph.Input( { _sBatch, _sWidth } );
+		for ( size_t I = 0; I < _sLayers; ++I ) {
+			const size_t sW = gGraph.Input( { _sWidth, _sWidth } ), sB = gGraph.Input( { _sWidth } );
+			vInputs.push_back( &vWeights[I] );
+			vInputs.push_back( &vBiases[I] );
+			sH = gGraph.Relu( gGraph.Add( gGraph.MatMul( sH, sW ), sB ) );
+		}
+		gGraph.Output( gGraph.LogSoftmax( sH, 1 ) );
+		gGraph.Compile();
+
+		Tensor tOut( { _sBatch, _sWidth }, NN9_T_FLOAT );
+		std::vector<Tensor *> vOutputs = { &tOut };
+		const uint64_t ui64Base = BufferManager::GblBufferManager.TotalMemory();
+		BufferManager::GblBufferManager.ResetPeakMemory();
+		Timer tRun;
+		tRun.Start();
+		for ( size_t J = 0; J < _sIterations; ++J ) { gGraph.Run( vInputs, vOutputs ); }
+		tRun.Stop();
+		const uint64_t ui64Peak = BufferManager::GblBufferManager.PeakMemory() - ui64Base;
+
+		std::wcout << L"Benchmark::GraphMemory( " << _sBatch << L" x " << _sWidth << L", " << _sLayers << L" layers, " << _sIterations << L" iterations ): " <<
+			gGraph.Kernels() << L" kernels, intermediates planned " << gGraph.PlannedBytes() / 1024 << L" KB vs. naive " << gGraph.NaiveBytes() / 1024 <<
+			L" KB, " << tRun.ElapsedSeconds() * 1000.0 / double( _sIterations ) << L" ms/run, " << ui64Peak / 1024 << L" KB allocated during runs." << std::endl;
+		return double( gGraph.NaiveBytes() ) / double( std::max<size_t>( gGraph.PlannedBytes(), 1 ) );
+	}
+
+	/**
+	 * Runs Exp() and the float-to-bfloat16 conversion from the Kernels table built for each instruction set the CPU supports, from plain
+	 *	C++ up to the tier Kernels::Table() selects.  Each kernel runs on 1 thread over the whole array.
+	 * 
+	 * \param _sElements The number of elements in the arrays.
+	 * \param _sIterations The number of times each kernel is run.
+	 * \return Returns the scalar Exp() time divided by the Exp() time of the selected tier.
+	 **/
+	double Benchmark::Dispatch( size_t _sElements, size_t _sIterations ) {
+		std::vector<float> vX( _sElements ), vY( _sElements );
+		std::vector<uint16_t> vBf16( _sElements );
+		std::mt19937 mGen( 0 );
+		std::uniform_real_distribution<float> urdDist( -10.0f, 10.0f );
+		for ( auto & fThis : vX ) { fThis = urdDist( mGen ); }
+
+		double dScalar = 0.0, dBest = 0.0;
+		for ( size_t I = Kernels::NN9_KI_SCALAR; I <= size_t( Kernels::Table().kiIsa ); ++I ) {
+			const Kernels::NN9_TABLE tTable = Kernels::Build( Kernels::NN9_KERNEL_ISA( I ) );
+			// Tiers the build does not include fall back to the one below; skip the repeat.
+			if ( tTable.kiIsa != Kernels::NN9_KERNEL_ISA( I ) ) { continue; }
+			Timer tExp;
+			tExp.Start();
+			for ( size_t J = 0; J < _sIterations; ++J ) { tTable.pfExpF32( vX.data(), vY.data(), _sElements ); }
+			tExp.Stop();
+			Timer tConvert;
+			tConvert.Start();
+			for ( size_t J = 0; J < _sIterations; ++J ) { tTable.pfF32ToBf16( vY.data(), vBf16.data(), _sElements ); }
+			tConvert.Stop();
+			if ( I == Kernels::NN9_KI_SCALAR ) { dScalar = tExp.ElapsedSeconds(); }
+			dBest = tExp.ElapsedSeconds();
+			std::wcout << L"Benchmark::Dispatch( " << _sElements << L" elements, " << _sIterations << L" iterations ): " << Kernels::Name( tTable.kiIsa ) <<
+				L" Exp() " << tExp.ElapsedSeconds() << L" seconds, float to bfloat16 " << tConvert.ElapsedSeconds() << L" seconds." << std::endl;
+		}
+		return dScalar / dBest;
+	}
+
+}	// namespace nn9
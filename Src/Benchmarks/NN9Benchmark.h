@@ -0,0 +1,194 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Timed micro-benchmarks for the core systems.  Each benchmark prints its results to std::wcout.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+
+namespace nn9 {
+
+	/**
+	 * Class Benchmark
+	 * \brief Timed micro-benchmarks for the core systems.
+	 *
+	 * Description: Timed micro-benchmarks for the core systems.  Each benchmark prints its results to std::wcout.
+	 */
+	class Benchmark {
+	public :
+		// == Functions.
+		/**
+		 * Runs every benchmark at the sizes used for tuning.  This takes minutes, so it runs only when requested (NeuralNet9 --bench).
+		 **/
+		static void											RunAll();
+
+		/**
+		 * Churns tensors from many threads at once while a large set of tensors stays alive, measuring the cost of buffer creation and release
+		 *	under contention.
+		 * 
+		 * \param _sThreads The number of threads to run concurrently.
+		 * \param _sLiveTensors The number of tensors each thread keeps alive for the duration of the test.
+		 * \param _sIterations The number of create/release cycles each thread performs.
+		 * \return Returns the number of create/release cycles per second across all threads.
+		 **/
+		static double										BufferChurn( size_t _sThreads, size_t _sLiveTensors, size_t _sIterations );
+
+		/**
+		 * Runs an element-wise kernel (y = a * x + y) over a float array with ThreadPool::ParallelFor() and with a hand-rolled baseline that
+		 *	starts one std::thread per core, gives each an equal slice, and joins them.
+		 * 
+		 * \param _sElements The number of elements in the arrays.
+		 * \param _sIterations The number of times the kernel is run by each method.
+		 * \return Returns the baseline time divided by the ThreadPool::ParallelFor() time.
+		 **/
+		static double										ParallelFor( size_t _sElements, size_t _sIterations );
+
+		/**
+		 * Sums a float array with ThreadPool::ParallelReduce() and with a hand-rolled baseline that starts one std::thread per core, has each
+		 *	sum an equal slice into its own slot, joins them, and adds the slots.
+		 * 
+		 * \param _sElements The number of elements in the array.
+		 * \param _sIterations The number of times the sum is run by each method.
+		 * \return Returns the baseline time divided by the ThreadPool::ParallelReduce() time.
+		 **/
+		static double										ParallelReduce( size_t _sElements, size_t _sIterations );
+
+		/**
+		 * Multiplies 2 float matrices with Gemm::Run() and with naive triple loops (i-k-j order), printing the GFLOP/s of each.
+		 * 
+		 * \param _sM The number of rows in A and C.
+		 * \param _sN The number of columns in B and C.
+		 * \param _sK The number of columns in A and rows in B.
+		 * \param _sIterations The number of times Gemm::Run() is run.  The naive loops run once.
+		 * \return Returns the Gemm::Run() GFLOP/s divided by the naive GFLOP/s.
+		 **/
+		static double										Gemm( size_t _sM, size_t _sN, size_t _sK, size_t _sIterations );
+
+		/**
+		 * Multiplies 2 bfloat16 matrices with Gemm::Run() using the widen-to-float kernel, the vdpbf16ps kernel (when the CPU has
+		 *	AVX512-BF16), and the emulated vdpbf16ps kernel, and times Bf16Dot::Dot() over a long vector with each kernel.
+		 * 
+		 * \param _sM The number of rows in A and C.
+		 * \param _sN The number of columns in B and C.
+		 * \param _sK The number of columns in A and rows in B.
+		 * \param _sIterations The number of times each kernel is run.
+		 * \return Returns the vdpbf16ps GEMM GFLOP/s divided by the widen-to-float GEMM GFLOP/s, or 0 if the CPU does not have AVX512-BF16.
+		 **/
+		static double										Bf16Gemm( size_t _sM, size_t _sN, size_t _sK, size_t _sIterations );
+
+		/**
+		 * Multiplies a uint8_t matrix by int8_t weights with QGemm::Run() and each int8 kernel the CPU supports, requantizing each result, and
+		 *	compares the time and the weight memory with a float Gemm::Run() of the same size.
+		 * 
+		 * \param _sM The number of rows in A and C.
+		 * \param _sN The number of columns in B and C.
+		 * \param _sK The number of columns in A and rows in B.
+		 * \param _sIterations The number of times each kernel is run.
+		 * \return Returns the fastest int8 GOP/s divided by the float GFLOP/s.
+		 **/
+		static double										Int8Gemm( size_t _sM, size_t _sN, size_t _sK, size_t _sIterations );
+
+		/**
+		 * Sums a float tensor over its inner and outer axes with Math::Sum() and with naive scalar loops, and times the Kahan sum, Math::Max(),
+		 *	and Math::ArgMax() over the same axes.
+		 * 
+		 * \param _sRows The number of rows in the tensor.
+		 * \param _sCols The number of columns in the tensor.
+		 * \param _sIterations The number of times each reduction is run.
+		 * \return Returns the naive outer-axis time divided by the Math::Sum() outer-axis time.
+		 **/
+		static double										Reduce( size_t _sRows, size_t _sCols, size_t _sIterations );
+
+		/**
+		 * Runs a row-wise softmax over a float matrix with Softmax::Forward() and with separate max, subtract, exp, sum, and divide passes
+		 *	using std::exp(), and times Softmax::Forward() on bfloat16 and Softmax::LogForward() on float.
+		 * 
+		 * \param _sRows The number of rows in the matrix.
+		 * \param _sCols The number of columns in the matrix.
+		 * \param _sIterations The number of times each softmax is run.
+		 * \return Returns the separate-pass time divided by the float Softmax::Forward() time.
+		 **/
+		static double										Softmax( size_t _sRows, size_t _sCols, size_t _sIterations );
+
+		/**
+		 * Runs a float convolution with a naive scalar loop and with Conv2D::Forward() using each algorithm, and times Conv2D::BackwardData()
+		 *	and Conv2D::BackwardWeights().  Square images and kernels are used.
+		 * 
+		 * \param _sN The number of images.
+		 * \param _sC The number of input channels.
+		 * \param _sSize The width and height of the input.
+		 * \param _sO The number of output channels.
+		 * \param _sKernel The width and height of the kernel.
+		 * \param _sStride The stride.
+		 * \param _sPad The padding on each side.
+		 * \param _sIterations The number of times each pass is run.
+		 * \return Returns the naive time divided by the NN9_CA_AUTO time.
+		 **/
+		static double										Conv2D( size_t _sN, size_t _sC, size_t _sSize, size_t _sO, size_t _sKernel, size_t _sStride, size_t _sPad, size_t _sIterations );
+
+		/**
+		 * Runs training steps of a float multi-layer perceptron (MatMul(), bias Add(), and Relu() per layer, then LogSoftmax() and Nll()) through
+		 *	a Tape, and reports the forward and backward times, the memory live at the end of the forward pass, and the peak during Backward().
+		 * 
+		 * \param _sBatch The number of samples per step.
+		 * \param _sWidth The width of the input and of each hidden layer.
+		 * \param _sClasses The number of output classes.
+		 * \param _sLayers The number of hidden layers.
+		 * \param _sIterations The number of training steps.
+		 * \return Returns the peak memory during Backward() divided by the memory live at the end of the forward pass, both above the memory in use
+		 *	before the step.
+		 **/
+		static double										Autograd( size_t _sBatch, size_t _sWidth, size_t _sClasses, size_t _sLayers, size_t _sIterations );
+
+		/**
+		 * Runs float Adam steps over a group of equally sized parameters with separate scalar passes (as a chain of element-wise tensor
+		 *	operations would make), with 1 Optimizer::Adam() call per tensor, and with 1 multi-tensor Optimizer::Adam() call for the group, and
+		 *	times a bfloat16 Optimizer::AdamW() group step.
+		 * 
+		 * \param _sTensors The number of parameter tensors.
+		 * \param _sElements The number of elements in each tensor.
+		 * \param _sIterations The number of steps each method runs.
+		 * \return Returns the separate-pass time divided by the multi-tensor time.
+		 **/
+		static double										Optimizer( size_t _sTensors, size_t _sElements, size_t _sIterations );
+
+		/**
+		 * Runs the float chain tanh( x * x + b ) * c, with x [rows, columns], b [columns], and c [rows, 1], as a Graph that writes every
+		 *	intermediate (1 kernel per operation) and as a Graph that fuses the chain into 1 kernel.
+		 * 
+		 * \param _sRows The number of rows.
+		 * \param _sCols The number of columns.
+		 * \param _sIterations The number of times each graph runs.
+		 * \return Returns the unfused time divided by the fused time.
+		 **/
+		static double										Graph( size_t _sRows, size_t _sCols, size_t _sIterations );
+
+		/**
+		 * Compiles and runs a float Graph of layers of relu( h * W + b ) ending in a log-softmax, and reports the memory planned for its
+		 *	intermediate values against the memory they would take with 1 buffer each, along with the peak memory measured during Run().
+		 * 
+		 * \param _sBatch The number of rows of h.
+		 * \param _sWidth The width of every layer.
+		 * \param _sLayers The number of layers.
+		 * \param _sIterations The number of times the graph runs.
+		 * \return Returns the naive size divided by the planned size.
+		 **/
+		static double										GraphMemory( size_t _sBatch, size_t _sWidth, size_t _sLayers, size_t _sIterations );
+
+		/**
+		 * Runs Exp() and the float-to-bfloat16 conversion from the Kernels table built for each instruction set the CPU supports, from plain
+		 *	C++ up to the tier Kernels::Table() selects.  Each kernel runs on 1 thread over the whole array.
+		 * 
+		 * \param _sElements The number of elements in the arrays.
+		 * \param _sIterations The number of times each kernel is run.
+		 * \return Returns the scalar Exp() time divided by the Exp() time of the selected tier.
+		 **/
+		static double										Dispatch( size_t _sElements, size_t _sIterations );
+	};
+
+}	// namespace nn9
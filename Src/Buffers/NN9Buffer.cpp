@@ -9,19 +9,181 @@
  
  #include "NN9Buffer.h"
  #include "NN9BufferManager.h"
+ #include "../Files/NN9FileMap.h"
+
+ #include <algorithm>
+ #include <cstring>
 
  namespace nn9 {
 
-	Buffer::Buffer( NN9_TYPE _tType, size_t _sSize, RefCnt * _rcOwner ) :
-		m_tType( _tType ),
-		m_vBuffer( Types::SizeOf( _tType ) * _sSize ),
-		m_prcOwner( _rcOwner ) {
+	Buffer::Buffer( NN9_TYPE _tType, size_t _sSize, RefCnt * _rcOwner, NN9_BUFFER_INIT _biInit ) :
+		m_sSize( Types::SizeOf( _tType ) * _sSize ),
+		m_prcOwner( _rcOwner ),
+		m_tType( _tType ) {
+		m_pui8Data = BufferManager::GblBufferManager.Allocator().Allocate( m_sSize, m_sAllocated );
+		if ( _biInit == NN9_BI_ZERO ) {
+			std::memset( m_pui8Data, 0, m_sSize );
+		}
+		m_ui64LastUse = BufferManager::GblBufferManager.Tick();
 		BufferManager::GblBufferManager.AddMem( MemUsed() );
 		//if ( m_prcOwner ) { m_prcOwner->IncRef(); }
 	}
+	Buffer::Buffer( NN9_TYPE _tType, size_t _sSize, std::shared_ptr<FileMap> _spfmFile, uint64_t _ui64Offset, RefCnt * _rcOwner, bool _bCopyOnWrite ) :
+		m_sSize( Types::SizeOf( _tType ) * _sSize ),
+		m_prcOwner( _rcOwner ),
+		m_tType( _tType ),
+		m_spfmFile( std::move( _spfmFile ) ),
+		m_ui64FileOffset( _ui64Offset ),
+		m_bCopyOnWrite( _bCopyOnWrite ) {
+		if ( !m_spfmFile || m_ui64FileOffset + m_sSize > m_spfmFile->Size() ) {
+			throw std::invalid_argument( "Buffer: File range is out of bounds." );
+		}
+		m_ui64LastUse = BufferManager::GblBufferManager.Tick();
+	}
+	Buffer::Buffer( NN9_TYPE _tType, size_t _sSize, Buffer * _pbArena, size_t _sOffset, RefCnt * _rcOwner ) :
+		m_sSize( Types::SizeOf( _tType ) * _sSize ),
+		m_prcOwner( _rcOwner ),
+		m_tType( _tType ),
+		m_pbArena( _pbArena ) {
+		if ( !m_pbArena || m_pbArena->m_pbArena || _sOffset + m_sSize > m_pbArena->Size() ) {
+			throw std::invalid_argument( "Buffer: Arena range is out of bounds." );
+		}
+		// Holding the arena keeps it alive; the pin's extra reference keeps it from being evicted out from under m_pui8Data.
+		m_pbArena->AddHolder();
+		m_pui8Data = m_pbArena->Pin() + _sOffset;
+		m_ui64LastUse = BufferManager::GblBufferManager.Tick();
+	}
 	Buffer::~Buffer() {
+		if ( m_pbArena ) {
+			m_pbArena->DecRef();
+			BufferManager::GblBufferManager.DeleteBuffer( m_pbArena );
+			return;
+		}
+		for ( auto & upWindow : m_vWindows ) {
+			FileMap::UnmapRegion( upWindow->pvBase, upWindow->sBaseSize );
+		}
 		BufferManager::GblBufferManager.DelMem( MemUsed() );
+		BufferManager::GblBufferManager.Allocator().Deallocate( m_pui8Data, m_sAllocated );
+		BufferManager::GblBufferManager.FreeSpill( this );
 		//if ( m_prcOwner ) { m_prcOwner->DecRef(); }
 	}
 
+	// == Functions.
+	/**
+	 * Ensures the buffer's data is in memory and adds a reference so that it cannot be evicted until the caller releases it with DecRef().
+	 * 
+	 * \throw Throws if the buffer could not be paged back in.
+	 * \return Returns a pointer to the buffer's data.
+	 **/
+	uint8_t * Buffer::Pin() {
+		bool bPagedIn = false;
+		uint8_t * pui8Ret;
+		{
+			std::lock_guard<std::mutex> lgLock( m_mResidency );
+			if ( !m_pui8Data && m_sSize ) {
+				BufferManager::GblBufferManager.PageIn( this );
+				bPagedIn = true;
+			}
+			IncRef();
+			m_ui64LastUse = BufferManager::GblBufferManager.Tick();
+			pui8Ret = m_pui8Data;
+		}
+		// Paging in may have pushed us over budget.  This buffer is pinned so it will not be chosen.
+		if ( bPagedIn ) { BufferManager::GblBufferManager.EnforceBudget(); }
+		return pui8Ret;
+	}
+
+	/**
+	 * Maps the window of a file-backed buffer covering a byte range, reusing an already-mapped window if one covers it.  The window is
+	 *	returned with a reference that the caller releases with DecRef().
+	 * 
+	 * \param _ui64Start The start of the byte range, relative to the buffer's data.
+	 * \param _sSize The size of the byte range.
+	 * \param _prcWindow Holds the object to reference-count for the lifetime of the returned pointer.
+	 * \throw Throws if the window could not be mapped.
+	 * \return Returns a pointer to byte _ui64Start of the buffer.
+	 **/
+	uint8_t * Buffer::MapWindow( uint64_t _ui64Start, size_t _sSize, RefCnt * &_prcWindow ) {
+		if ( !_sSize ) {
+			// Nothing to map.  The buffer itself is the reference.
+			IncRef();
+			_prcWindow = this;
+			return nullptr;
+		}
+		uint64_t ui64End = _ui64Start + _sSize;
+
+		std::lock_guard<std::mutex> lgLock( m_mResidency );
+		for ( auto & upWindow : m_vWindows ) {
+			if ( upWindow->ui64Start <= _ui64Start && upWindow->ui64End >= ui64End ) {
+				upWindow->IncRef();
+				upWindow->ui64LastUse = BufferManager::GblBufferManager.Tick();
+				_prcWindow = upWindow.get();
+				return upWindow->pui8Data + (_ui64Start - upWindow->ui64Start);
+			}
+		}
+
+		uint64_t ui64WinStart, ui64WinEnd;
+		if ( m_bCopyOnWrite ) {
+			// Unmapping a copy-on-write window would discard its modified pages, so the whole buffer is mapped once and kept.  Pages are
+			//	still only read (and shared with other mappings of the file) when touched.
+			ui64WinStart = 0;
+			ui64WinEnd = m_sSize;
+		}
+		else {
+			// Round out to whole windows so that neighboring small ranges (rows of a matrix, etc.) share a mapping.
+			ui64WinStart = _ui64Start & ~uint64_t( NN9_B_WINDOW_ALIGN - 1 );
+			ui64WinEnd = std::min<uint64_t>( (ui64End + (NN9_B_WINDOW_ALIGN - 1)) & ~uint64_t( NN9_B_WINDOW_ALIGN - 1 ), m_sSize );
+			TrimWindows( ui64WinEnd - ui64WinStart );
+		}
+
+		auto upWindow = std::make_unique<NN9_WINDOW>();
+		upWindow->pbOwner = this;
+		upWindow->ui64Start = ui64WinStart;
+		upWindow->ui64End = ui64WinEnd;
+		upWindow->pui8Data = m_spfmFile->MapRegion( m_ui64FileOffset + ui64WinStart, static_cast<size_t>(ui64WinEnd - ui64WinStart),
+			upWindow->pvBase, upWindow->sBaseSize, m_bCopyOnWrite );
+		if ( !upWindow->pui8Data ) {
+			throw std::runtime_error( "Buffer::MapWindow: Failed to map file window." );
+		}
+		try {
+			m_vWindows.push_back( std::move( upWindow ) );
+		}
+		catch ( ... ) {
+			FileMap::UnmapRegion( upWindow->pvBase, upWindow->sBaseSize );
+			throw;
+		}
+		NN9_WINDOW * pwWindow = m_vWindows.back().get();
+		pwWindow->IncRef();
+		pwWindow->ui64LastUse = BufferManager::GblBufferManager.Tick();
+		_prcWindow = pwWindow;
+		return pwWindow->pui8Data + (_ui64Start - ui64WinStart);
+	}
+
+	/**
+	 * Unmaps least-recently-used unreferenced windows until at most NN9_B_WINDOW_CACHE bytes would remain mapped after mapping _ui64Needed
+	 *	more.  The caller holds m_mResidency.
+	 * 
+	 * \param _ui64Needed The size of the window about to be mapped.
+	 **/
+	void Buffer::TrimWindows( uint64_t _ui64Needed ) {
+		// Only views take references to windows, and views can only be created under m_mResidency, so a count of 0 seen here cannot change.
+		uint64_t ui64Mapped = _ui64Needed;
+		for ( auto & upWindow : m_vWindows ) {
+			if ( upWindow->GetRefCnt() == 0 ) { ui64Mapped += upWindow->ui64End - upWindow->ui64Start; }
+		}
+		while ( ui64Mapped > NN9_B_WINDOW_CACHE ) {
+			size_t sOldest = m_vWindows.size();
+			for ( size_t I = 0; I < m_vWindows.size(); ++I ) {
+				if ( m_vWindows[I]->GetRefCnt() == 0 && (sOldest == m_vWindows.size() || m_vWindows[I]->ui64LastUse < m_vWindows[sOldest]->ui64LastUse) ) {
+					sOldest = I;
+				}
+			}
+			if ( sOldest == m_vWindows.size() ) { break; }
+			ui64Mapped -= m_vWindows[sOldest]->ui64End - m_vWindows[sOldest]->ui64Start;
+			FileMap::UnmapRegion( m_vWindows[sOldest]->pvBase, m_vWindows[sOldest]->sBaseSize );
+			m_vWindows[sOldest] = std::move( m_vWindows.back() );
+			m_vWindows.pop_back();
+		}
+	}
+
  }	// namespace nn9
@@ -14,11 +14,20 @@
 #include "../Tensor/NN9View.h"
 #include "../Types/NN9Types.h"
 
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace nn9 {
 
 	class BufferManager;
+	class FileMap;
+
+	/** How the contents of a new buffer are initialized. */
+	enum NN9_BUFFER_INIT {
+		NN9_BI_UNINITIALIZED,																				/**< Contents are undefined.  Use when every element is about to be overwritten. */
+		NN9_BI_ZERO,																						/**< Every byte is set to 0. */
+	};
 
 	/**
 	 * Class Buffer
@@ -29,12 +38,18 @@ namespace nn9 {
 	 */
 	class Buffer : public RefCnt {
 	public :
-		Buffer( NN9_TYPE _tType, size_t _sSize, RefCnt * _rcOwner = nullptr );
+		Buffer( NN9_TYPE _tType, size_t _sSize, RefCnt * _rcOwner = nullptr, NN9_BUFFER_INIT _biInit = NN9_BI_UNINITIALIZED );
+		Buffer( NN9_TYPE _tType, size_t _sSize, std::shared_ptr<FileMap> _spfmFile, uint64_t _ui64Offset, RefCnt * _rcOwner = nullptr, bool _bCopyOnWrite = false );
+		Buffer( NN9_TYPE _tType, size_t _sSize, Buffer * _pbArena, size_t _sOffset, RefCnt * _rcOwner = nullptr );
 		~Buffer();
 
 
-		// == Types.
-		typedef std::vector<uint8_t, AlignmentAllocator<uint8_t, 64>>				BufferType;
+		// == Enumerations.
+		/** File-backed buffer settings. */
+		enum NN9_BUFFER : uint64_t {
+			NN9_B_WINDOW_ALIGN														= 1024 * 1024,				/**< File windows are mapped in multiples of this size.  Must be a multiple of FileMap::Granularity(). */
+			NN9_B_WINDOW_CACHE														= 256 * 1024 * 1024,		/**< Bytes of unreferenced windows a buffer keeps mapped for reuse. */
+		};
 
 
 		// == Functions.
@@ -45,12 +60,37 @@ namespace nn9 {
 		 **/
 		NN9_TYPE																	Type() const { return m_tType; }
 
+		/**
+		 * Sets the object that is reference-counted along with the buffer.  Used when the owner is moved.
+		 * 
+		 * \param _prcOwner The new owner.
+		 **/
+		void																		SetOwner( RefCnt * _prcOwner ) { m_prcOwner = _prcOwner; }
+
+		/**
+		 * Gets the object that is reference-counted along with the buffer.
+		 * 
+		 * \return Returns the owner, or nullptr if the buffer has none or is shared.
+		 **/
+		RefCnt *																	Owner() const { return m_prcOwner; }
+
+		/**
+		 * Adds a reference for another tensor sharing the buffer.  The holder releases it through BufferManager::DeleteBuffer() like the
+		 *	original owner.  Shared buffers stop forwarding references to an owner, since any of the sharing tensors may be destroyed first.
+		 **/
+		void																		AddHolder() {
+			m_prcOwner = nullptr;
+			++m_aHolders;
+			Parent::IncRef();
+		}
+
 		/**
 		 * Increases the reference count.
 		 **/
 		virtual void																IncRef() {
 			Parent::IncRef();
-			if ( m_prcOwner ) { m_prcOwner->IncRef(); }
+			RefCnt * prcOwner = m_prcOwner;
+			if ( prcOwner ) { prcOwner->IncRef(); }
 		}
 
 		/**
@@ -60,24 +100,32 @@ namespace nn9 {
 		 **/
 		virtual int32_t																DecRef() {
 			auto aRet = Parent::DecRef();
-			if ( m_prcOwner ) { m_prcOwner->DecRef(); }
+			RefCnt * prcOwner = m_prcOwner;
+			if ( prcOwner ) { prcOwner->DecRef(); }
 			
 			return aRet;
 		}
 
 		/**
-		 * Gets the total amount of memory allocated by the buffer.
+		 * Gets the buffer whose memory this buffer views.
+		 * 
+		 * \return Returns the arena, or nullptr if the buffer owns its memory.
+		 **/
+		Buffer *																	Arena() const { return m_pbArena; }
+
+		/**
+		 * Gets the total amount of memory allocated by the buffer.  Buffers that have been spilled to disk or that view an arena use no memory.
 		 * 
 		 * \return Returns the total amount of memory allocated by the buffer.
 		 **/
-		size_t																		MemUsed() const { return m_vBuffer.capacity() * sizeof( BufferType::value_type ); }
+		size_t																		MemUsed() const { return m_pui8Data ? m_sAllocated : 0; }
 
 		/**
 		 * Gets the total number of bytes referenced by the buffer.
 		 * 
 		 * \return Returns the total number of bytes referenced by the buffer.
 		 **/
-		size_t																		Size() const { return m_vBuffer.size() * sizeof( BufferType::value_type ); }
+		size_t																		Size() const { return m_sSize; }
 
 		/**
 		 * Gets the total number of elements when interpreted as the given templated type.
@@ -85,7 +133,7 @@ namespace nn9 {
 		 * \return Returns the total number of elements when interpreted as the given templated type.
 		 **/
 		template <typename _tType>
-		size_t																		Size() const { return m_vBuffer.size() * sizeof( BufferType::value_type ) / sizeof( _tType ); }
+		size_t																		Size() const { return m_sSize / sizeof( _tType ); }
 
 		/**
 		 * Gets the total number of elements when interpreted as the given type.
@@ -93,25 +141,32 @@ namespace nn9 {
 		 * \param _tType The type as which to reinterpret the buffer.
 		 * \return Returns the total number of elements when interpreted as the given type.
 		 **/
-		size_t																		Size( NN9_TYPE _tType ) const { return m_vBuffer.size() * sizeof( BufferType::value_type ) / Types::SizeOf( _tType ); }
+		size_t																		Size( NN9_TYPE _tType ) const { return m_sSize / Types::SizeOf( _tType ); }
 
 		/**
-		 * Gets a view to the whole buffer.
+		 * Gets a view to the whole buffer.  If the buffer has been spilled to disk it is paged back in first.
 		 * 
 		 * \tparam _tType The type to which to interpret the buffer.
+		 * \throw Throws if the buffer could not be paged back in.
 		 * \return Returns a view to the entire buffer interpreted as the given type.
 		 **/
 		template <typename _tType>
 		View<_tType>																FullView() {
-			return View<_tType>( reinterpret_cast<_tType *>(m_vBuffer.data()), Size<_tType>(), this );
+			if ( m_spfmFile ) { return MappedView<_tType>( 0, Size<_tType>() ); }
+			View<_tType> vRet( reinterpret_cast<_tType *>(Pin()), Size<_tType>(), this );
+			DecRef();
+			return vRet;
 		}
 
 		/**
 		 * Gets a view of a part of the buffer.  If NN9_SAFETY_CHECK, throws if any part of the requested range is out of range of the buffer.
+		 *	If the buffer has been spilled to disk it is paged back in first.  If the buffer is file-backed, only the pages covering the range are
+		 *	mapped.
 		 * 
 		 * \param _sStart the starting index for the view.
 		 * \param _sTotal The total number of elements to map into the view.
-		 * \throw If NN9_SAFETY_CHECK, it will throw if the requested range extends beyond the valid buffer range.
+		 * \throw If NN9_SAFETY_CHECK, it will throw if the requested range extends beyond the valid buffer range.  Throws if the buffer could not
+		 *	be paged back in.
 		 * \return Returns a view of the given range within the buffer.
 		 **/
 		template <typename _tType>
@@ -121,19 +176,120 @@ namespace nn9 {
 				throw std::out_of_range( "Buffer::RangeView: Range is out of bounds." );
 			}
 #endif	// #ifdef NN9_SAFETY_CHECK
-			return View<_tType>( reinterpret_cast<_tType *>(m_vBuffer.data()) + _sStart, _sTotal, this );
+			if ( m_spfmFile ) { return MappedView<_tType>( _sStart, _sTotal ); }
+			View<_tType> vRet( reinterpret_cast<_tType *>(Pin()) + _sStart, _sTotal, this );
+			DecRef();
+			return vRet;
+		}
+
+		/**
+		 * Determines whether the buffer's data is in memory or spilled to disk.  File-backed buffers are never resident.
+		 * 
+		 * \return Returns true if the buffer's data is in memory.
+		 **/
+		bool																		Resident() {
+			std::lock_guard<std::mutex> lgLock( m_mResidency );
+			return m_pui8Data != nullptr || !m_sSize;
 		}
 
 
 	protected :
 		// == Members.
-		BufferType																	m_vBuffer;					/**< The actual data buffer. */
-		RefCnt *																	m_prcOwner = nullptr;		/**< An optional pointer to an owning object which also needs to be reference-counted when this one is. */
+		uint8_t *																	m_pui8Data = nullptr;		/**< The actual data buffer, taken from the BufferManager's allocator. */
+		size_t																		m_sSize = 0;				/**< The size of the data, in bytes. */
+		size_t																		m_sAllocated = 0;			/**< The size of the allocated block, in bytes. */
+		uint64_t																	m_ui64SpillOffset = ~0ULL;	/**< Offset of this buffer's region in the BufferManager's spill file, or ~0 if it has none. */
+		uint64_t																	m_ui64LastUse = 0;			/**< BufferManager tick of the most recent view, for least-recently-used eviction. */
+		std::mutex																	m_mResidency;				/**< Guards m_pui8Data against concurrent eviction and page-in. */
+		std::atomic<RefCnt *>														m_prcOwner = nullptr;		/**< An optional pointer to an owning object which also needs to be reference-counted when this one is. */
+		std::atomic<int32_t>														m_aHolders = 1;				/**< The number of tensors sharing the buffer.  References beyond these belong to views. */
 		NN9_TYPE																	m_tType = NN9_T_FLOAT;		/**< the buffer data type. */
+		uint32_t																	m_ui32Shard = 0;			/**< The BufferManager shard that owns this buffer. */
+		size_t																		m_sSlot = 0;				/**< The index of this buffer inside its BufferManager shard. */
+		std::shared_ptr<FileMap>													m_spfmFile;					/**< The file backing the buffer, if any. */
+		uint64_t																	m_ui64FileOffset = 0;		/**< Byte offset of the buffer's data within m_spfmFile. */
+		bool																		m_bCopyOnWrite = false;		/**< If true, writes to the file-backed data go to private pages instead of the file. */
+		Buffer *																	m_pbArena = nullptr;		/**< The buffer whose memory this buffer views, if any.  It stays pinned while this buffer exists. */
 
 
 	private :
 		typedef RefCnt																Parent;
+
+		friend class																BufferManager;
+
+
+		// == Types.
+		/** A mapped window of a file-backed buffer.  Views of the window reference-count it, and through it the buffer. */
+		struct NN9_WINDOW : public RefCnt {
+			virtual void															IncRef() {
+				RefCnt::IncRef();
+				pbOwner->IncRef();
+			}
+			virtual int32_t															DecRef() {
+				auto aRet = RefCnt::DecRef();
+				pbOwner->DecRef();
+				return aRet;
+			}
+
+			Buffer *																pbOwner = nullptr;			/**< The buffer whose data is mapped. */
+			void *																	pvBase = nullptr;			/**< The base of the mapping. */
+			size_t																	sBaseSize = 0;				/**< The size of the mapping. */
+			uint8_t *																pui8Data = nullptr;			/**< Points to byte ui64Start of the buffer. */
+			uint64_t																ui64Start = 0;				/**< Start of the window, relative to the buffer's data. */
+			uint64_t																ui64End = 0;				/**< End of the window, relative to the buffer's data. */
+			uint64_t																ui64LastUse = 0;			/**< Recency tick for least-recently-used unmapping. */
+		};
+
+
+		// == Members.
+		std::vector<std::unique_ptr<NN9_WINDOW>>									m_vWindows;					/**< Mapped windows of a file-backed buffer.  Guarded by m_mResidency. */
+
+
+		// == Functions.
+		/**
+		 * Ensures the buffer's data is in memory and adds a reference so that it cannot be evicted until the caller releases it with DecRef().
+		 * 
+		 * \throw Throws if the buffer could not be paged back in.
+		 * \return Returns a pointer to the buffer's data.
+		 **/
+		uint8_t *																	Pin();
+
+		/**
+		 * Maps the window of a file-backed buffer covering a byte range, reusing an already-mapped window if one covers it.  The window is
+		 *	returned with a reference that the caller releases with DecRef().
+		 * 
+		 * \param _ui64Start The start of the byte range, relative to the buffer's data.
+		 * \param _sSize The size of the byte range.
+		 * \param _prcWindow Holds the object to reference-count for the lifetime of the returned pointer.
+		 * \throw Throws if the window could not be mapped.
+		 * \return Returns a pointer to byte _ui64Start of the buffer.
+		 **/
+		uint8_t *																	MapWindow( uint64_t _ui64Start, size_t _sSize, RefCnt * &_prcWindow );
+
+		/**
+		 * Unmaps least-recently-used unreferenced windows until at most NN9_B_WINDOW_CACHE bytes would remain mapped after mapping _ui64Needed
+		 *	more.  The caller holds m_mResidency.
+		 * 
+		 * \param _ui64Needed The size of the window about to be mapped.
+		 **/
+		void																		TrimWindows( uint64_t _ui64Needed );
+
+		/**
+		 * Creates a view over a range of a file-backed buffer.
+		 * 
+		 * \param _sStart the starting index for the view.
+		 * \param _sTotal The total number of elements to map into the view.
+		 * \throw Throws if the window could not be mapped.
+		 * \return Returns a view of the given range within the buffer.
+		 **/
+		template <typename _tType>
+		View<_tType>																MappedView( size_t _sStart, size_t _sTotal ) {
+			RefCnt * prcWindow;
+			uint8_t * pui8Data = MapWindow( uint64_t( _sStart ) * sizeof( _tType ), _sTotal * sizeof( _tType ), prcWindow );
+			View<_tType> vRet( reinterpret_cast<_tType *>(pui8Data), _sTotal, prcWindow );
+			prcWindow->DecRef();
+			return vRet;
+		}
 	};
 
 }	// namespace nn9
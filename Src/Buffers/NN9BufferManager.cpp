@@ -7,9 +7,15 @@
  */
  
 #include "NN9BufferManager.h"
+#include "../Files/NN9FileMap.h"
+#include "../Utilities/NN9Timer.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <string>
 
 
 namespace nn9 {
@@ -21,15 +27,25 @@ namespace nn9 {
 	BufferManager::BufferManager() {
 	}
 	BufferManager::~BufferManager() {
-		{
-			std::unique_lock<std::mutex> ulLock( m_mMutex );
-			if ( m_ui64TotalMemory != 0 ) {
-				std::wcout << L"BufferManager Warning: " << m_ui64TotalMemory << L" still-allocated bytes." << std::endl;
-			}
-			if ( m_vBuffers.size() ) {
-				std::wcout << L"BufferManager Warning: " << m_vBuffers.size() << L" unreleased buffers." << std::endl;
-			}
-			m_vBuffers = std::vector<std::unique_ptr<Buffer>>();
+		size_t sTotal = 0;
+		for ( auto & sShard : m_aShards ) {
+			std::unique_lock<std::mutex> ulLock( sShard.mMutex );
+			sTotal += sShard.vBuffers.size();
+		}
+		if ( m_ui64TotalMemory != 0 ) {
+			std::wcout << L"BufferManager Warning: " << m_ui64TotalMemory << L" still-allocated bytes." << std::endl;
+		}
+		if ( sTotal ) {
+			std::wcout << L"BufferManager Warning: " << sTotal << L" unreleased buffers." << std::endl;
+		}
+		for ( auto & sShard : m_aShards ) {
+			std::unique_lock<std::mutex> ulLock( sShard.mMutex );
+			sShard.vBuffers = std::vector<std::unique_ptr<Buffer>>();
+		}
+		if ( m_upfmSpill ) {
+			m_upfmSpill.reset();
+			std::error_code ecError;
+			std::filesystem::remove( m_pSpillPath, ecError );
 		}
 	}
 
@@ -40,51 +56,96 @@ namespace nn9 {
 	 * \param _tType The data type of the buffer to create.
 	 * \param _sSize The size of the buffer to create, in bytes.
 	 * \param _prcOwner A pointer to the owning object, which the buffer will also reference.
+	 * \param _biInit How the contents of the buffer are initialized.  By default they are left undefined.
 	 * \return Returns a pointer to the created buffer.
 	 **/
-	Buffer * BufferManager::CreateBuffer( NN9_TYPE _tType, size_t _sSize, RefCnt * _prcOwner ) {
-		Buffer * pbBuffer = nullptr;
-		{
-			std::unique_lock<std::mutex> ulLock( m_mMutex );
-			try {
-				m_vBuffers.emplace_back( std::make_unique<Buffer>( _tType, _sSize, _prcOwner ) );
-				pbBuffer = m_vBuffers.back().get();
-				if ( pbBuffer ) {
-					pbBuffer->IncRef();
-				}
-				else {
-					throw std::runtime_error( "BufferManager::CreateBuffer: Failed to create Buffer." );
-				}
-			}
-			catch ( ... ) {
-				throw std::runtime_error( "BufferManager::CreateBuffer: Failed to create Buffer." );
-			}
+	Buffer * BufferManager::CreateBuffer( NN9_TYPE _tType, size_t _sSize, RefCnt * _prcOwner, NN9_BUFFER_INIT _biInit ) {
+		// Allocate and fill the buffer outside of any lock; only the registration is serialized.
+		std::unique_ptr<Buffer> upBuffer;
+		try {
+			upBuffer = std::make_unique<Buffer>( _tType, _sSize, _prcOwner, _biInit );
+		}
+		catch ( ... ) {
+			throw std::runtime_error( "BufferManager::CreateBuffer: Failed to create Buffer." );
 		}
+		Buffer * pbBuffer = Register( std::move( upBuffer ) );
+		EnforceBudget();
 		return pbBuffer;
 	}
 
 	/**
-	 * Dereferences a buffer.  If the reference count reaches 0, the buffer is deleted from memory.
+	 * Creates a buffer whose data lives in a file and returns its pointer.  Views of the buffer map only the parts of the file they cover.
+	 *	The buffer starts with a reference counter of 1.
+	 * 
+	 * \param _tType The data type of the buffer to create.
+	 * \param _sSize The size of the buffer to create, in elements.
+	 * \param _spfmFile The opened file containing the buffer's data.
+	 * \param _ui64Offset The byte offset of the buffer's data within the file.
+	 * \param _prcOwner A pointer to the owning object, which the buffer will also reference.
+	 * \param _bCopyOnWrite If true, writes through views go to private pages and never reach the file.
+	 * \throw Throws if the range lies outside of the file.
+	 * \return Returns a pointer to the created buffer.
+	 **/
+	Buffer * BufferManager::CreateBuffer( NN9_TYPE _tType, size_t _sSize, std::shared_ptr<FileMap> _spfmFile, uint64_t _ui64Offset, RefCnt * _prcOwner, bool _bCopyOnWrite ) {
+		return Register( std::make_unique<Buffer>( _tType, _sSize, std::move( _spfmFile ), _ui64Offset, _prcOwner, _bCopyOnWrite ) );
+	}
+
+	/**
+	 * Creates a buffer whose data is a range of another buffer (an arena) and returns its pointer.  The arena is kept alive and resident
+	 *	until every buffer viewing it is deleted.  The buffer starts with a reference counter of 1.
+	 * 
+	 * \param _tType The data type of the buffer to create.
+	 * \param _sSize The size of the buffer to create, in elements.
+	 * \param _pbArena The buffer whose memory to view.  It must own its memory.
+	 * \param _sOffset The byte offset of the buffer's data within the arena.
+	 * \param _prcOwner A pointer to the owning object, which the buffer will also reference.
+	 * \throw Throws if the range lies outside of the arena.
+	 * \return Returns a pointer to the created buffer.
+	 **/
+	Buffer * BufferManager::CreateBuffer( NN9_TYPE _tType, size_t _sSize, Buffer * _pbArena, size_t _sOffset, RefCnt * _prcOwner ) {
+		return Register( std::make_unique<Buffer>( _tType, _sSize, _pbArena, _sOffset, _prcOwner ) );
+	}
+
+	/**
+	 * Dereferences a buffer.  If the reference count reaches 0, the buffer is deleted from memory.  The buffer is found through the shard
+	 *	and slot it holds, so it must be a live buffer created by this manager; passing a pointer that was never registered or has already
+	 *	been deleted is undefined.
 	 * 
 	 * \param _pbBuffer The buffer to dereference and possibly delete.
 	 * \return Returns true if the reference count reached 0 and the buffer was deleted from memory, or if the passed-in buffer is nullptr.
 	 **/
 	bool BufferManager::DeleteBuffer( Buffer * _pbBuffer ) {
 		if ( !_pbBuffer ) { return true; }
-		{
-			std::unique_lock<std::mutex> ulLock( m_mMutex );
-			for ( auto I = m_vBuffers.size(); I--; ) {
-				if ( m_vBuffers[I].get() == _pbBuffer ) {
-					if ( _pbBuffer->DecRef() == 0 ) {
-						m_vBuffers.erase( m_vBuffers.begin() + I );
-						return true;
-					}
-					return false;
-				}
-			}
+		uint32_t ui32Shard = _pbBuffer->m_ui32Shard;
+		if ( ui32Shard >= NN9_BM_SHARDS ) {
 			std::wcout << L"BufferManager Warning: Buffer 0x" << std::uppercase << std::hex << std::setfill( L'0' ) << std::setw( 8 ) << _pbBuffer << L" not found." << std::endl;
 			return false;
 		}
+		auto & sShard = m_aShards[ui32Shard];
+
+		std::unique_ptr<Buffer> upDead;
+		{
+			std::unique_lock<std::mutex> ulLock( sShard.mMutex );
+			size_t sSlot = _pbBuffer->m_sSlot;
+			if ( sSlot >= sShard.vBuffers.size() || sShard.vBuffers[sSlot].get() != _pbBuffer ) {
+				std::wcout << L"BufferManager Warning: Buffer 0x" << std::uppercase << std::hex << std::setfill( L'0' ) << std::setw( 8 ) << _pbBuffer << L" not found." << std::endl;
+				return false;
+			}
+			--_pbBuffer->m_aHolders;
+			if ( _pbBuffer->DecRef() != 0 ) { return false; }
+
+			// Swap-and-pop: move the last buffer into the vacated slot and fix its back-index.
+			upDead = std::move( sShard.vBuffers[sSlot] );
+			if ( sSlot != sShard.vBuffers.size() - 1 ) {
+				sShard.vBuffers[sSlot] = std::move( sShard.vBuffers.back() );
+				sShard.vBuffers[sSlot]->m_sSlot = sSlot;
+			}
+			sShard.vBuffers.pop_back();
+		}
+		// The actual deallocation happens outside of the lock, after any eviction that locked the buffer before it died has finished.
+		{ std::lock_guard<std::mutex> lgResidency( upDead->m_mResidency ); }
+		upDead.reset();
+		return true;
 	}
 
 	/**
@@ -93,7 +154,9 @@ namespace nn9 {
 	 * \param _ui64Allocated The amount of memory allocated.
 	 **/
 	void BufferManager::AddMem( uint64_t _ui64Allocated ) {
-		m_ui64TotalMemory += _ui64Allocated;
+		const uint64_t ui64Total = m_ui64TotalMemory += _ui64Allocated;
+		uint64_t ui64Peak = m_ui64PeakMemory;
+		while ( ui64Total > ui64Peak && !m_ui64PeakMemory.compare_exchange_weak( ui64Peak, ui64Total ) ) {}
 	}
 
 	/**
@@ -105,4 +168,275 @@ namespace nn9 {
 		m_ui64TotalMemory -= _ui64DeAllocated;
 	}
 
+	/**
+	 * Gets the total number of live buffers across all shards.
+	 * 
+	 * \return Returns the total number of live buffers.
+	 **/
+	size_t BufferManager::TotalBuffers() {
+		size_t sTotal = 0;
+		for ( auto & sShard : m_aShards ) {
+			std::unique_lock<std::mutex> ulLock( sShard.mMutex );
+			sTotal += sShard.vBuffers.size();
+		}
+		return sTotal;
+	}
+
+	/**
+	 * Sets the number of bytes buffers may keep resident.  When the total exceeds the budget, the least-recently-viewed buffers that have no
+	 *	outstanding views are written to a spill file and their memory is released.  They are paged back in by the next FullView() or
+	 *	RangeView().
+	 * 
+	 * \param _ui64Budget The memory budget in bytes, or 0 for no limit.
+	 * \param _pSpillPath The spill file to create on first eviction.  If empty, a file in the system's temporary directory is used.  Ignored
+	 *	once the spill file has been created.
+	 **/
+	void BufferManager::SetMemoryBudget( uint64_t _ui64Budget, const std::filesystem::path &_pSpillPath ) {
+		{
+			std::unique_lock<std::shared_mutex> ulLock( m_smSpill );
+			if ( !m_upfmSpill ) { m_pSpillPath = _pSpillPath; }
+		}
+		m_ui64Budget = _ui64Budget;
+		EnforceBudget();
+	}
+
+	/**
+	 * Resets the eviction and page-in counters.
+	 **/
+	void BufferManager::ResetSpillStats() {
+		m_ui64EvictedBytes = 0;
+		m_ui64Evictions = 0;
+		m_ui64PageIns = 0;
+		m_ui64PageInBytes = 0;
+		m_ui64PageInNanoseconds = 0;
+	}
+
+	/**
+	 * Adds a newly created buffer to the calling thread's shard and gives it its initial reference.
+	 * 
+	 * \param _upBuffer The buffer to register.
+	 * \throw Throws if the buffer could not be registered.
+	 * \return Returns a pointer to the registered buffer.
+	 **/
+	Buffer * BufferManager::Register( std::unique_ptr<Buffer> _upBuffer ) {
+		Buffer * pbBuffer = _upBuffer.get();
+
+		uint32_t ui32Shard = ThreadShard();
+		auto & sShard = m_aShards[ui32Shard];
+		{
+			std::unique_lock<std::mutex> ulLock( sShard.mMutex );
+			try {
+				pbBuffer->m_ui32Shard = ui32Shard;
+				pbBuffer->m_sSlot = sShard.vBuffers.size();
+				sShard.vBuffers.emplace_back( std::move( _upBuffer ) );
+			}
+			catch ( ... ) {
+				throw std::runtime_error( "BufferManager::Register: Failed to register Buffer." );
+			}
+		}
+		pbBuffer->IncRef();
+		return pbBuffer;
+	}
+
+	/**
+	 * Gets the shard index to be used by the calling thread for new buffers.
+	 * 
+	 * \return Returns the index of the shard into which the calling thread inserts its buffers.
+	 **/
+	uint32_t BufferManager::ThreadShard() {
+		// Threads are assigned shards round-robin on first use so that concurrently churning threads do not collide.
+		static std::atomic<uint32_t> aNext = 0;
+		thread_local uint32_t ui32Shard = (aNext++) & (NN9_BM_SHARDS - 1);
+		return ui32Shard;
+	}
+
+	/**
+	 * If over budget, evicts least-recently-viewed buffers until the total is comfortably below the budget.  Must not be called while
+	 *	holding any buffer's residency lock.
+	 **/
+	void BufferManager::EnforceBudget() {
+		uint64_t ui64Budget = m_ui64Budget;
+		if NN9_LIKELY( !ui64Budget || m_ui64TotalMemory <= ui64Budget ) { return; }
+
+		std::lock_guard<std::mutex> lgEvict( m_mEvict );
+		// Evict down to a low-water mark so that each pass frees a batch rather than just enough to get back under the budget.
+		uint64_t ui64Target = ui64Budget - ui64Budget / 8;
+		uint64_t ui64Total = m_ui64TotalMemory;
+		if ( ui64Total <= ui64Budget ) { return; }
+		uint64_t ui64ToFree = ui64Total - ui64Target;
+
+		// Pass 1: find the recency tick at or below which enough evictable memory lies.  Buffers are only ever try-locked here, so a thread
+		//	holding a residency lock and waiting on a shard can never deadlock with us.
+		std::vector<std::pair<uint64_t, uint64_t>> vCandidates;
+		for ( auto & sShard : m_aShards ) {
+			std::lock_guard<std::mutex> lgShard( sShard.mMutex );
+			for ( auto & upBuffer : sShard.vBuffers ) {
+				std::unique_lock<std::mutex> ulBuffer( upBuffer->m_mResidency, std::try_to_lock );
+				if ( ulBuffer.owns_lock() && upBuffer->m_pui8Data && upBuffer->m_sSize && !upBuffer->m_pbArena && upBuffer->GetRefCnt() <= upBuffer->m_aHolders ) {
+					vCandidates.emplace_back( upBuffer->m_ui64LastUse, upBuffer->m_sAllocated );
+				}
+			}
+		}
+		if ( vCandidates.empty() ) { return; }
+		std::sort( vCandidates.begin(), vCandidates.end() );
+		uint64_t ui64Threshold = vCandidates.back().first;
+		uint64_t ui64Sum = 0;
+		for ( auto & pThis : vCandidates ) {
+			ui64Sum += pThis.second;
+			if ( ui64Sum >= ui64ToFree ) {
+				ui64Threshold = pThis.first;
+				break;
+			}
+		}
+
+		// Pass 2: evict everything not used since the threshold.  Each shard's victims are locked under the shard lock but written out after
+		//	it is released, so the spill I/O does not block the shard.  DeleteBuffer() takes a dead buffer's residency lock before freeing it,
+		//	so a locked victim stays alive.
+		std::vector<std::pair<Buffer *, std::unique_lock<std::mutex>>> vVictims;
+		for ( auto & sShard : m_aShards ) {
+			if ( m_ui64TotalMemory <= ui64Target ) { break; }
+			{
+				std::lock_guard<std::mutex> lgShard( sShard.mMutex );
+				for ( auto & upBuffer : sShard.vBuffers ) {
+					std::unique_lock<std::mutex> ulBuffer( upBuffer->m_mResidency, std::try_to_lock );
+					if ( ulBuffer.owns_lock() && upBuffer->m_ui64LastUse <= ui64Threshold ) {
+						vVictims.emplace_back( upBuffer.get(), std::move( ulBuffer ) );
+					}
+				}
+			}
+			for ( auto & pThis : vVictims ) {
+				Evict( pThis.first );
+				pThis.second.unlock();
+			}
+			vVictims.clear();
+		}
+	}
+
+	/**
+	 * Writes a buffer to the spill file and releases its memory.  The caller holds the buffer's residency lock.
+	 * 
+	 * \param _pbBuffer The buffer to evict.
+	 * \return Returns true if the buffer was evicted.
+	 **/
+	bool BufferManager::Evict( Buffer * _pbBuffer ) {
+		// Any reference beyond the holders' means a view is outstanding and its pointer must stay valid.  Arena views own no memory to free.
+		//	A buffer with no references is being deleted.
+		if ( !_pbBuffer->m_pui8Data || !_pbBuffer->m_sSize || _pbBuffer->m_pbArena || !_pbBuffer->GetRefCnt() || _pbBuffer->GetRefCnt() > _pbBuffer->m_aHolders ) { return false; }
+		if ( _pbBuffer->m_ui64SpillOffset == ~0ULL ) {
+			if ( !AllocSpill( _pbBuffer->m_sSize, _pbBuffer->m_ui64SpillOffset ) ) { return false; }
+		}
+		{
+			std::shared_lock<std::shared_mutex> slLock( m_smSpill );
+			void * pvBase;
+			size_t sBaseSize;
+			uint8_t * pui8Dst = m_upfmSpill->MapRegion( _pbBuffer->m_ui64SpillOffset, _pbBuffer->m_sSize, pvBase, sBaseSize );
+			if ( !pui8Dst ) { return false; }
+			std::memcpy( pui8Dst, _pbBuffer->m_pui8Data, _pbBuffer->m_sSize );
+			FileMap::UnmapRegion( pvBase, sBaseSize );
+		}
+		m_caAllocator.Deallocate( _pbBuffer->m_pui8Data, _pbBuffer->m_sAllocated );
+		DelMem( _pbBuffer->m_sAllocated );
+		_pbBuffer->m_pui8Data = nullptr;
+
+		m_ui64EvictedBytes += _pbBuffer->m_sSize;
+		++m_ui64Evictions;
+		return true;
+	}
+
+	/**
+	 * Reads a spilled buffer back into memory.  The caller holds the buffer's residency lock.
+	 * 
+	 * \param _pbBuffer The buffer to page in.
+	 * \throw Throws if memory could not be allocated or the spill file could not be read.
+	 **/
+	void BufferManager::PageIn( Buffer * _pbBuffer ) {
+		Timer tTimer;
+		tTimer.Start();
+		size_t sAllocated;
+		uint8_t * pui8Data = m_caAllocator.Allocate( _pbBuffer->m_sSize, sAllocated );
+		{
+			std::shared_lock<std::shared_mutex> slLock( m_smSpill );
+			void * pvBase;
+			size_t sBaseSize;
+			const uint8_t * pui8Src = m_upfmSpill->MapRegion( _pbBuffer->m_ui64SpillOffset, _pbBuffer->m_sSize, pvBase, sBaseSize );
+			if ( !pui8Src ) {
+				m_caAllocator.Deallocate( pui8Data, sAllocated );
+				throw std::runtime_error( "BufferManager::PageIn: Failed to map spilled buffer." );
+			}
+			std::memcpy( pui8Data, pui8Src, _pbBuffer->m_sSize );
+			FileMap::UnmapRegion( pvBase, sBaseSize );
+		}
+		// The spill region is kept so that the next eviction of this buffer does not need to allocate one.
+		_pbBuffer->m_pui8Data = pui8Data;
+		_pbBuffer->m_sAllocated = sAllocated;
+		AddMem( sAllocated );
+		tTimer.Stop();
+
+		++m_ui64PageIns;
+		m_ui64PageInBytes += _pbBuffer->m_sSize;
+		m_ui64PageInNanoseconds += static_cast<uint64_t>(tTimer.ElapsedNanoseconds());
+	}
+
+	/**
+	 * Reserves a region of the spill file.
+	 * 
+	 * \param _sSize The size of the region, in bytes.
+	 * \param _ui64Offset Holds the offset of the region.
+	 * \return Returns true if the spill file could be created or grown as necessary.
+	 **/
+	bool BufferManager::AllocSpill( size_t _sSize, uint64_t &_ui64Offset ) {
+		uint64_t ui64Size = (uint64_t( _sSize ) + (NN9_BM_SPILL_ALIGN - 1)) & ~uint64_t( NN9_BM_SPILL_ALIGN - 1 );
+		std::unique_lock<std::shared_mutex> ulLock( m_smSpill );
+
+		// Best fit from released regions.
+		auto aIt = m_mmSpillFree.lower_bound( ui64Size );
+		if ( aIt != m_mmSpillFree.end() ) {
+			_ui64Offset = aIt->second;
+			if ( aIt->first > ui64Size ) {
+				m_mmSpillFree.emplace( aIt->first - ui64Size, aIt->second + ui64Size );
+			}
+			m_mmSpillFree.erase( aIt );
+			return true;
+		}
+
+		try {
+			if ( !m_upfmSpill ) {
+				if ( m_pSpillPath.empty() ) {
+					m_pSpillPath = std::filesystem::temp_directory_path() / ("nn9_spill_" +
+						std::to_string( std::chrono::steady_clock::now().time_since_epoch().count() ) + "_" +
+						std::to_string( reinterpret_cast<uintptr_t>(this) ) + ".bin");
+				}
+				auto upfmFile = std::make_unique<FileMap>();
+				if ( upfmFile->Create( m_pSpillPath ) != NN9_E_SUCCESS ) { return false; }
+				m_upfmSpill = std::move( upfmFile );
+			}
+		}
+		catch ( ... ) { return false; }
+
+		uint64_t ui64End = m_ui64SpillEnd + ui64Size;
+		if ( ui64End > m_upfmSpill->Size() ) {
+			// Grow geometrically so that a steady stream of evictions does not resize the file every time.
+			if ( m_upfmSpill->SetSize( std::max( ui64End, m_upfmSpill->Size() * 2 ) ) != NN9_E_SUCCESS ) { return false; }
+		}
+		_ui64Offset = m_ui64SpillEnd;
+		m_ui64SpillEnd = ui64End;
+		return true;
+	}
+
+	/**
+	 * Releases a buffer's spill-file region, if it has one.
+	 * 
+	 * \param _pbBuffer The buffer whose region is to be released.
+	 **/
+	void BufferManager::FreeSpill( Buffer * _pbBuffer ) {
+		if ( _pbBuffer->m_ui64SpillOffset == ~0ULL ) { return; }
+		uint64_t ui64Size = (uint64_t( _pbBuffer->m_sSize ) + (NN9_BM_SPILL_ALIGN - 1)) & ~uint64_t( NN9_BM_SPILL_ALIGN - 1 );
+		std::unique_lock<std::shared_mutex> ulLock( m_smSpill );
+		try {
+			m_mmSpillFree.emplace( ui64Size, _pbBuffer->m_ui64SpillOffset );
+		}
+		catch ( ... ) {}	// The region is simply lost.
+		_pbBuffer->m_ui64SpillOffset = ~0ULL;
+	}
+
 }	// namespace nn9
@@ -9,8 +9,15 @@
 #pragma once
 
 #include "NN9Buffer.h"
+#include "NN9CachingAllocator.h"
+#include "../Foundation/NN9Macros.h"
 
+#include <array>
+#include <filesystem>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <vector>
 
 // Include platform-specific headers
@@ -22,6 +29,8 @@
 
 namespace nn9 {
 
+	class FileMap;
+
 	/**
 	 * Class BufferManager
 	 * \brief Manages buffers.
@@ -43,12 +52,44 @@ namespace nn9 {
 		 * \param _tType The data type of the buffer to create.
 		 * \param _sSize The size of the buffer to create, in bytes.
 		 * \param _prcOwner A pointer to the owning object, which the buffer will also reference.
+		 * \param _biInit How the contents of the buffer are initialized.  By default they are left undefined.
+		 * \return Returns a pointer to the created buffer.
+		 **/
+		Buffer *								CreateBuffer( NN9_TYPE _tType, size_t _sSize, RefCnt * _prcOwner = nullptr, NN9_BUFFER_INIT _biInit = NN9_BI_UNINITIALIZED );
+
+		/**
+		 * Creates a buffer whose data lives in a file and returns its pointer.  Views of the buffer map only the parts of the file they cover.
+		 *	The buffer starts with a reference counter of 1.
+		 * 
+		 * \param _tType The data type of the buffer to create.
+		 * \param _sSize The size of the buffer to create, in elements.
+		 * \param _spfmFile The opened file containing the buffer's data.
+		 * \param _ui64Offset The byte offset of the buffer's data within the file.
+		 * \param _prcOwner A pointer to the owning object, which the buffer will also reference.
+		 * \param _bCopyOnWrite If true, writes through views go to private pages and never reach the file.
+		 * \throw Throws if the range lies outside of the file.
 		 * \return Returns a pointer to the created buffer.
 		 **/
-		Buffer *								CreateBuffer( NN9_TYPE _tType, size_t _sSize, RefCnt * _prcOwner = nullptr );
+		Buffer *								CreateBuffer( NN9_TYPE _tType, size_t _sSize, std::shared_ptr<FileMap> _spfmFile, uint64_t _ui64Offset, RefCnt * _prcOwner = nullptr, bool _bCopyOnWrite = false );
 
 		/**
-		 * Dereferences a buffer.  If the reference count reaches 0, the buffer is deleted from memory.
+		 * Creates a buffer whose data is a range of another buffer (an arena) and returns its pointer.  The arena is kept alive and resident
+		 *	until every buffer viewing it is deleted.  The buffer starts with a reference counter of 1.
+		 * 
+		 * \param _tType The data type of the buffer to create.
+		 * \param _sSize The size of the buffer to create, in elements.
+		 * \param _pbArena The buffer whose memory to view.  It must own its memory.
+		 * \param _sOffset The byte offset of the buffer's data within the arena.
+		 * \param _prcOwner A pointer to the owning object, which the buffer will also reference.
+		 * \throw Throws if the range lies outside of the arena.
+		 * \return Returns a pointer to the created buffer.
+		 **/
+		Buffer *								CreateBuffer( NN9_TYPE _tType, size_t _sSize, Buffer * _pbArena, size_t _sOffset, RefCnt * _prcOwner = nullptr );
+
+		/**
+		 * Dereferences a buffer.  If the reference count reaches 0, the buffer is deleted from memory.  The buffer is found through the shard
+		 *	and slot it holds, so it must be a live buffer created by this manager; passing a pointer that was never registered or has already
+		 *	been deleted is undefined.
 		 * 
 		 * \param _pbBuffer The buffer to dereference and possibly delete.
 		 * \return Returns true if the reference count reached 0 and the buffer was deleted from memory, or if the passed-in buffer is nullptr.
@@ -69,11 +110,208 @@ namespace nn9 {
 		 **/
 		void									DelMem( uint64_t _ui64DeAllocated );
 
+		/**
+		 * Gets the total number of live buffers across all shards.
+		 * 
+		 * \return Returns the total number of live buffers.
+		 **/
+		size_t									TotalBuffers();
+
+		/**
+		 * Gets the total memory consumed by live buffers.
+		 * 
+		 * \return Returns the total number of bytes allocated by live buffers.
+		 **/
+		uint64_t								TotalMemory() const { return m_ui64TotalMemory; }
+
+		/**
+		 * Gets the most memory consumed by live buffers at any one time since the last call to ResetPeakMemory().
+		 * 
+		 * \return Returns the high-water mark of TotalMemory(), in bytes.
+		 **/
+		uint64_t								PeakMemory() const { return m_ui64PeakMemory; }
+
+		/**
+		 * Restarts the high-water mark at the memory currently consumed by live buffers.
+		 **/
+		void									ResetPeakMemory() { m_ui64PeakMemory = m_ui64TotalMemory.load(); }
+
+		/**
+		 * Gets the allocator from which buffer memory is taken.
+		 * 
+		 * \return Returns a reference to the allocator from which buffer memory is taken.
+		 **/
+		CachingAllocator &						Allocator() { return m_caAllocator; }
+
+		/**
+		 * Releases all cached (unused) buffer memory back to the OS.
+		 * 
+		 * \return Returns the number of bytes released.
+		 **/
+		uint64_t								Trim() { return m_caAllocator.Trim(); }
+
+		/**
+		 * Sets the number of bytes buffers may keep resident.  When the total exceeds the budget, the least-recently-viewed buffers that have no
+		 *	outstanding views are written to a spill file and their memory is released.  They are paged back in by the next FullView() or
+		 *	RangeView().
+		 * 
+		 * \param _ui64Budget The memory budget in bytes, or 0 for no limit.
+		 * \param _pSpillPath The spill file to create on first eviction.  If empty, a file in the system's temporary directory is used.  Ignored
+		 *	once the spill file has been created.
+		 **/
+		void									SetMemoryBudget( uint64_t _ui64Budget, const std::filesystem::path &_pSpillPath = std::filesystem::path() );
+
+		/**
+		 * Gets the memory budget.
+		 * 
+		 * \return Returns the memory budget in bytes, or 0 if there is no limit.
+		 **/
+		uint64_t								MemoryBudget() const { return m_ui64Budget; }
+
+		/**
+		 * Gets the total number of bytes written to the spill file by evictions.
+		 * 
+		 * \return Returns the total number of bytes evicted.
+		 **/
+		uint64_t								EvictedBytes() const { return m_ui64EvictedBytes; }
+
+		/**
+		 * Gets the number of buffers evicted.
+		 * 
+		 * \return Returns the number of buffers evicted.
+		 **/
+		uint64_t								Evictions() const { return m_ui64Evictions; }
+
+		/**
+		 * Gets the number of buffers paged back in.
+		 * 
+		 * \return Returns the number of buffers paged back in.
+		 **/
+		uint64_t								PageIns() const { return m_ui64PageIns; }
+
+		/**
+		 * Gets the total number of bytes paged back in.
+		 * 
+		 * \return Returns the total number of bytes paged back in.
+		 **/
+		uint64_t								PageInBytes() const { return m_ui64PageInBytes; }
+
+		/**
+		 * Gets the total time spent paging buffers back in.
+		 * 
+		 * \return Returns the total page-in latency, in seconds.
+		 **/
+		double									PageInSeconds() const { return m_ui64PageInNanoseconds / 1000000000.0; }
+
+		/**
+		 * Resets the eviction and page-in counters.
+		 **/
+		void									ResetSpillStats();
+
 
 	protected :
+		// == Enumerations.
+		/** Registry settings. */
+		enum NN9_BUFFER_MANAGER : uint32_t {
+			NN9_BM_SHARDS						= 64,									/**< The number of independently locked buffer registries.  Must be a power of 2. */
+			NN9_BM_SPILL_ALIGN					= 64 * 1024,							/**< Alignment of buffer regions in the spill file.  Matches the largest mapping granularity. */
+		};
+
+
+		// == Types.
+		/** A single independently locked slice of the buffer registry. */
+		struct NN9_ALIGN( 64 ) NN9_SHARD {
+			std::mutex							mMutex;									/**< Mutex for synchronizing access to this shard. */
+			std::vector<std::unique_ptr<Buffer>>
+												vBuffers;								/**< The buffers in this shard.  Each buffer knows its own index. */
+		};
+
+
+		// == Members.
+		CachingAllocator						m_caAllocator;							/**< Buffer memory.  Declared first so that it outlives any buffers freed in our destructor. */
 		std::atomic<uint64_t>					m_ui64TotalMemory = 0;					/**< The total memory consumed by the buffers we manage. */
-		std::mutex								m_mMutex;								/**< Mutex for synchronizing access to the task queue. */
-		std::vector<std::unique_ptr<Buffer>>	m_vBuffers;								/**< The buffers we manage. */
+		std::atomic<uint64_t>					m_ui64PeakMemory = 0;					/**< The high-water mark of m_ui64TotalMemory. */
+		std::atomic<uint64_t>					m_ui64Budget = 0;						/**< The memory budget, or 0 for no limit. */
+		std::atomic<uint64_t>					m_ui64Tick = 0;							/**< Incremented on every view; used to order buffers by recency. */
+		std::atomic<uint64_t>					m_ui64EvictedBytes = 0;					/**< Total bytes written out by evictions. */
+		std::atomic<uint64_t>					m_ui64Evictions = 0;					/**< Total buffers evicted. */
+		std::atomic<uint64_t>					m_ui64PageIns = 0;						/**< Total buffers paged back in. */
+		std::atomic<uint64_t>					m_ui64PageInBytes = 0;					/**< Total bytes paged back in. */
+		std::atomic<uint64_t>					m_ui64PageInNanoseconds = 0;			/**< Total time spent paging in. */
+		std::mutex								m_mEvict;								/**< Serializes eviction passes. */
+		std::shared_mutex						m_smSpill;								/**< Exclusive for spill-file allocation and growth, shared for reads and writes. */
+		std::unique_ptr<FileMap>				m_upfmSpill;							/**< The spill file, created on first eviction. */
+		std::filesystem::path					m_pSpillPath;							/**< Path of the spill file. */
+		uint64_t								m_ui64SpillEnd = 0;						/**< End of the used part of the spill file. */
+		std::multimap<uint64_t, uint64_t>		m_mmSpillFree;							/**< Released spill regions, size to offset. */
+		std::array<NN9_SHARD, NN9_BM_SHARDS>	m_aShards;								/**< The buffers we manage, spread across shards to reduce lock contention. */
+
+
+		// == Functions.
+		/**
+		 * Gets the shard index to be used by the calling thread for new buffers.
+		 * 
+		 * \return Returns the index of the shard into which the calling thread inserts its buffers.
+		 **/
+		static uint32_t							ThreadShard();
+
+		/**
+		 * Adds a newly created buffer to the calling thread's shard and gives it its initial reference.
+		 * 
+		 * \param _upBuffer The buffer to register.
+		 * \throw Throws if the buffer could not be registered.
+		 * \return Returns a pointer to the registered buffer.
+		 **/
+		Buffer *								Register( std::unique_ptr<Buffer> _upBuffer );
+
+		/**
+		 * Gets the next recency tick.
+		 * 
+		 * \return Returns a value greater than any previously returned.
+		 **/
+		uint64_t								Tick() { return ++m_ui64Tick; }
+
+		/**
+		 * If over budget, evicts least-recently-viewed buffers until the total is comfortably below the budget.  Must not be called while
+		 *	holding any buffer's residency lock.
+		 **/
+		void									EnforceBudget();
+
+		/**
+		 * Writes a buffer to the spill file and releases its memory.  The caller holds the buffer's shard lock and residency lock.
+		 * 
+		 * \param _pbBuffer The buffer to evict.
+		 * \return Returns true if the buffer was evicted.
+		 **/
+		bool									Evict( Buffer * _pbBuffer );
+
+		/**
+		 * Reads a spilled buffer back into memory.  The caller holds the buffer's residency lock.
+		 * 
+		 * \param _pbBuffer The buffer to page in.
+		 * \throw Throws if memory could not be allocated or the spill file could not be read.
+		 **/
+		void									PageIn( Buffer * _pbBuffer );
+
+		/**
+		 * Reserves a region of the spill file.
+		 * 
+		 * \param _sSize The size of the region, in bytes.
+		 * \param _ui64Offset Holds the offset of the region.
+		 * \return Returns true if the spill file could be created or grown as necessary.
+		 **/
+		bool									AllocSpill( size_t _sSize, uint64_t &_ui64Offset );
+
+		/**
+		 * Releases a buffer's spill-file region, if it has one.
+		 * 
+		 * \param _pbBuffer The buffer whose region is to be released.
+		 **/
+		void									FreeSpill( Buffer * _pbBuffer );
+
+
+	private :
+		friend class							Buffer;
 	};
 
 }	// namespace nn9
@@ -0,0 +1,297 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A caching, size-class allocator for 64-byte-aligned buffer memory.  Released blocks are kept in per-size-class free lists
+ *	(with a small per-thread cache in front of them) so that training loops which allocate the same shapes every step stop hitting the OS.
+ */
+
+#include "NN9CachingAllocator.h"
+
+#include <bit>
+#include <new>
+
+
+namespace nn9 {
+
+	// == Members.
+	thread_local bool CachingAllocator::m_bThreadCacheGone = false;				/**< Set once the calling thread's cache has been destroyed. */
+
+	// == Functions.
+	CachingAllocator::CachingAllocator() {
+	}
+	CachingAllocator::~CachingAllocator() {
+		// Threads still running keep their caches, so empty them and cut them loose.
+		{
+			std::unique_lock<std::mutex> ulLock( m_mCaches );
+			for ( auto ptcCache : m_vCaches ) {
+				std::unique_lock<std::mutex> ulCacheLock( ptcCache->mMutex );
+				FreeThreadCache( ptcCache );
+				ptcCache->pcaOwner = nullptr;
+			}
+			m_vCaches.clear();
+		}
+		Trim( 0 );
+	}
+
+	CachingAllocator::NN9_THREAD_CACHE::~NN9_THREAD_CACHE() {
+		if ( pcaOwner ) {
+			std::unique_lock<std::mutex> ulLock( pcaOwner->m_mCaches );
+			auto & vCaches = pcaOwner->m_vCaches;
+			for ( size_t I = 0; I < vCaches.size(); ++I ) {
+				if ( vCaches[I] == this ) {
+					vCaches[I] = vCaches.back();
+					vCaches.pop_back();
+					break;
+				}
+			}
+		}
+		// Hand this thread's blocks back to the shared lists so other threads can reuse them.
+		for ( size_t I = 0; I < aBlocks.size(); ++I ) {
+			for ( auto pui8Block : aBlocks[I] ) {
+				if ( pcaOwner ) {
+					pcaOwner->PushShared( pui8Block, I, BlockSize( I ) );
+				}
+				else {
+					OsFree( pui8Block, BlockSize( I ) );
+				}
+			}
+			aBlocks[I].clear();
+		}
+		m_bThreadCacheGone = true;
+	}
+
+	/**
+	 * Allocates a 64-byte-aligned block of at least the given size.  The contents are undefined.
+	 * 
+	 * \param _sSize The requested size in bytes.
+	 * \param _sAllocated Holds the actual size of the returned block, which must be passed back to Deallocate().
+	 * \throw Throws std::bad_alloc if the memory could not be allocated.
+	 * \return Returns a pointer to the allocated block.
+	 **/
+	uint8_t * CachingAllocator::Allocate( size_t _sSize, size_t &_sAllocated ) {
+		size_t sClass = SizeClass( _sSize, _sAllocated );
+
+		if ( _sAllocated <= NN9_CA_THREAD_MAX_SIZE ) {
+			auto ptcCache = ThreadCache();
+			if ( ptcCache ) {
+				std::unique_lock<std::mutex> ulLock( ptcCache->mMutex );
+				if ( ptcCache->aBlocks[sClass].size() ) {
+					uint8_t * pui8Ret = ptcCache->aBlocks[sClass].back();
+					ptcCache->aBlocks[sClass].pop_back();
+					++m_ui64Hits;
+					return pui8Ret;
+				}
+			}
+		}
+
+		{
+			auto & flList = m_aLists[sClass];
+			std::unique_lock<std::mutex> ulLock( flList.mMutex );
+			if ( flList.vBlocks.size() ) {
+				uint8_t * pui8Ret = flList.vBlocks.back();
+				flList.vBlocks.pop_back();
+				m_ui64Cached -= _sAllocated;
+				++m_ui64Hits;
+				return pui8Ret;
+			}
+		}
+
+		++m_ui64Misses;
+		try {
+			return OsAlloc( _sAllocated );
+		}
+		catch ( const std::bad_alloc & ) {
+			// Under memory pressure, give back everything we are hoarding and try once more.
+			Trim();
+			return OsAlloc( _sAllocated );
+		}
+	}
+
+	/**
+	 * Returns a block to the cache, or to the OS if the cache is full.
+	 * 
+	 * \param _pui8Block The block to release.  May be nullptr.
+	 * \param _sAllocated The size of the block as returned by Allocate().
+	 **/
+	void CachingAllocator::Deallocate( uint8_t * _pui8Block, size_t _sAllocated ) {
+		if ( !_pui8Block ) { return; }
+		size_t sRounded;
+		size_t sClass = SizeClass( _sAllocated, sRounded );
+
+		if ( _sAllocated <= NN9_CA_THREAD_MAX_SIZE ) {
+			auto ptcCache = ThreadCache();
+			if ( ptcCache ) {
+				std::unique_lock<std::mutex> ulLock( ptcCache->mMutex );
+				if ( ptcCache->aBlocks[sClass].size() < NN9_CA_THREAD_MAX_BLOCKS ) {
+					try {
+						ptcCache->aBlocks[sClass].push_back( _pui8Block );
+						return;
+					}
+					catch ( ... ) {}
+				}
+			}
+		}
+		PushShared( _pui8Block, sClass, _sAllocated );
+	}
+
+	/**
+	 * Releases every block held in the shared free lists and in every thread's cache back to the OS.
+	 * 
+	 * \return Returns the number of bytes released.
+	 **/
+	uint64_t CachingAllocator::Trim() {
+		uint64_t ui64Freed = 0;
+		{
+			std::unique_lock<std::mutex> ulLock( m_mCaches );
+			for ( auto ptcCache : m_vCaches ) {
+				std::unique_lock<std::mutex> ulCacheLock( ptcCache->mMutex );
+				ui64Freed += FreeThreadCache( ptcCache );
+			}
+		}
+		return ui64Freed + Trim( 0 );
+	}
+
+	/**
+	 * Releases blocks held in the shared free lists back to the OS, largest size classes first, until at most _ui64Keep bytes remain cached.
+	 * 
+	 * \param _ui64Keep The number of cached bytes to retain.
+	 * \return Returns the number of bytes released.
+	 **/
+	uint64_t CachingAllocator::Trim( uint64_t _ui64Keep ) {
+		uint64_t ui64Freed = 0;
+		for ( size_t I = m_aLists.size(); I-- && m_ui64Cached > _ui64Keep; ) {
+			std::vector<uint8_t *> vFree;
+			{
+				auto & flList = m_aLists[I];
+				std::unique_lock<std::mutex> ulLock( flList.mMutex );
+				while ( flList.vBlocks.size() && m_ui64Cached > _ui64Keep ) {
+					vFree.push_back( flList.vBlocks.back() );
+					flList.vBlocks.pop_back();
+					m_ui64Cached -= BlockSize( I );
+				}
+			}
+			for ( auto pui8Block : vFree ) {
+				OsFree( pui8Block, BlockSize( I ) );
+				ui64Freed += BlockSize( I );
+			}
+		}
+		return ui64Freed;
+	}
+
+	/**
+	 * Gets the size class for a given request size and the rounded-up block size of that class.
+	 * 
+	 * \param _sSize The requested size in bytes.
+	 * \param _sRounded Holds the block size of the returned class.
+	 * \return Returns the size-class index.
+	 **/
+	size_t CachingAllocator::SizeClass( size_t _sSize, size_t &_sRounded ) {
+		if ( _sSize <= NN9_CA_ALIGN ) {
+			_sRounded = NN9_CA_ALIGN;
+			return 0;
+		}
+		// Four classes per power of 2 keeps the worst-case internal waste at 25%.
+		size_t sPow = std::bit_width( _sSize - 1 ) - 1;
+		size_t sStep = size_t( 1 ) << (sPow - 2);
+		_sRounded = (_sSize + sStep - 1) & ~(sStep - 1);
+		return 1 + (sPow - 6) * 4 + ((_sRounded >> (sPow - 2)) - 5);
+	}
+
+	/**
+	 * Gets the block size of a size class.
+	 * 
+	 * \param _sClass The size class.
+	 * \return Returns the size of every block in the given class.
+	 **/
+	size_t CachingAllocator::BlockSize( size_t _sClass ) {
+		if ( _sClass == 0 ) { return NN9_CA_ALIGN; }
+		size_t sPow = (_sClass - 1) / 4 + 6;
+		size_t sSub = (_sClass - 1) % 4 + 5;
+		return sSub << (sPow - 2);
+	}
+
+	/**
+	 * Gets the calling thread's cache if it belongs to this allocator.
+	 * 
+	 * \return Returns the calling thread's cache or nullptr if it is bound to another allocator.
+	 **/
+	CachingAllocator::NN9_THREAD_CACHE * CachingAllocator::ThreadCache() {
+		// Buffers freed during static destruction arrive after this thread's cache has been torn down.
+		if NN9_UNLIKELY( m_bThreadCacheGone ) { return nullptr; }
+		thread_local NN9_THREAD_CACHE tcCache;
+		if NN9_UNLIKELY( !tcCache.pcaOwner ) {
+			std::unique_lock<std::mutex> ulLock( m_mCaches );
+			try {
+				m_vCaches.push_back( &tcCache );
+			}
+			catch ( ... ) { return nullptr; }
+			tcCache.pcaOwner = this;
+		}
+		return tcCache.pcaOwner == this ? &tcCache : nullptr;
+	}
+
+	/**
+	 * Frees every block in a thread cache back to the OS.  The cache's mutex must be held.
+	 * 
+	 * \param _ptcCache The cache to empty.
+	 * \return Returns the number of bytes released.
+	 **/
+	uint64_t CachingAllocator::FreeThreadCache( NN9_THREAD_CACHE * _ptcCache ) {
+		uint64_t ui64Freed = 0;
+		for ( size_t I = 0; I < _ptcCache->aBlocks.size(); ++I ) {
+			for ( auto pui8Block : _ptcCache->aBlocks[I] ) {
+				OsFree( pui8Block, BlockSize( I ) );
+				ui64Freed += BlockSize( I );
+			}
+			_ptcCache->aBlocks[I].clear();
+		}
+		return ui64Freed;
+	}
+
+	/**
+	 * Allocates a block directly from the OS.
+	 * 
+	 * \param _sSize The size of the block to allocate.
+	 * \throw Throws std::bad_alloc if the memory could not be allocated.
+	 * \return Returns the allocated block.
+	 **/
+	uint8_t * CachingAllocator::OsAlloc( size_t _sSize ) {
+		uint8_t * pui8Ret = AlignmentAllocator<uint8_t, NN9_CA_ALIGN>().allocate( _sSize );
+		if ( !pui8Ret ) { throw std::bad_alloc(); }
+		return pui8Ret;
+	}
+
+	/**
+	 * Frees a block directly to the OS.
+	 * 
+	 * \param _pui8Block The block to free.
+	 * \param _sSize The size of the block.
+	 **/
+	void CachingAllocator::OsFree( uint8_t * _pui8Block, size_t _sSize ) {
+		AlignmentAllocator<uint8_t, NN9_CA_ALIGN>().deallocate( _pui8Block, _sSize );
+	}
+
+	/**
+	 * Pushes a block onto a shared free list or frees it if the cache is full.
+	 * 
+	 * \param _pui8Block The block to release.
+	 * \param _sClass The size class of the block.
+	 * \param _sAllocated The size of the block.
+	 **/
+	void CachingAllocator::PushShared( uint8_t * _pui8Block, size_t _sClass, size_t _sAllocated ) {
+		if ( m_ui64Cached + _sAllocated <= m_ui64Limit ) {
+			auto & flList = m_aLists[_sClass];
+			std::unique_lock<std::mutex> ulLock( flList.mMutex );
+			try {
+				flList.vBlocks.push_back( _pui8Block );
+				m_ui64Cached += _sAllocated;
+				return;
+			}
+			catch ( ... ) {}
+		}
+		OsFree( _pui8Block, _sAllocated );
+	}
+
+}	// namespace nn9
@@ -0,0 +1,207 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A caching, size-class allocator for 64-byte-aligned buffer memory.  Released blocks are kept in per-size-class free lists
+ *	(with a small per-thread cache in front of them) so that training loops which allocate the same shapes every step stop hitting the OS.
+ */
+
+#pragma once
+
+#include "../Foundation/NN9AlignmentAllocator.h"
+#include "../Foundation/NN9Macros.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+
+namespace nn9 {
+
+	/**
+	 * Class CachingAllocator
+	 * \brief A caching, size-class allocator for 64-byte-aligned buffer memory.
+	 *
+	 * Description: A caching, size-class allocator for 64-byte-aligned buffer memory.  Released blocks are kept in per-size-class free lists
+	 *	(with a small per-thread cache in front of them) so that training loops which allocate the same shapes every step stop hitting the OS.
+	 */
+	class CachingAllocator {
+	public :
+		CachingAllocator();
+		~CachingAllocator();
+
+
+		// == Enumerations.
+		/** Allocator settings. */
+		enum NN9_CACHING_ALLOCATOR : uint64_t {
+			NN9_CA_ALIGN						= 64,									/**< Alignment of every block. */
+			NN9_CA_CLASSES						= 1 + (64 - 6) * 4,						/**< Total size classes: 64 bytes, then 4 classes per power of 2. */
+			NN9_CA_THREAD_MAX_SIZE				= 1024 * 1024,							/**< Blocks larger than this bypass the per-thread caches. */
+			NN9_CA_THREAD_MAX_BLOCKS			= 8,									/**< Blocks of a single size class each thread may hold. */
+			NN9_CA_DEFAULT_LIMIT				= 2ULL * 1024 * 1024 * 1024,			/**< Default maximum number of bytes held in the shared free lists. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Allocates a 64-byte-aligned block of at least the given size.  The contents are undefined.
+		 * 
+		 * \param _sSize The requested size in bytes.
+		 * \param _sAllocated Holds the actual size of the returned block, which must be passed back to Deallocate().
+		 * \throw Throws std::bad_alloc if the memory could not be allocated.
+		 * \return Returns a pointer to the allocated block.
+		 **/
+		uint8_t *								Allocate( size_t _sSize, size_t &_sAllocated );
+
+		/**
+		 * Returns a block to the cache, or to the OS if the cache is full.
+		 * 
+		 * \param _pui8Block The block to release.  May be nullptr.
+		 * \param _sAllocated The size of the block as returned by Allocate().
+		 **/
+		void									Deallocate( uint8_t * _pui8Block, size_t _sAllocated );
+
+		/**
+		 * Releases every block held in the shared free lists and in every thread's cache back to the OS.
+		 * 
+		 * \return Returns the number of bytes released.
+		 **/
+		uint64_t								Trim();
+
+		/**
+		 * Releases blocks held in the shared free lists back to the OS, largest size classes first, until at most _ui64Keep bytes remain cached.
+		 * 
+		 * \param _ui64Keep The number of cached bytes to retain.
+		 * \return Returns the number of bytes released.
+		 **/
+		uint64_t								Trim( uint64_t _ui64Keep );
+
+		/**
+		 * Sets the maximum number of bytes the shared free lists may hold.  Blocks released beyond this limit go straight back to the OS.
+		 * 
+		 * \param _ui64Limit The new limit in bytes.
+		 **/
+		void									SetCacheLimit( uint64_t _ui64Limit ) { m_ui64Limit = _ui64Limit; }
+
+		/**
+		 * Gets the number of allocations served from the cache.
+		 * 
+		 * \return Returns the number of allocations served from the cache.
+		 **/
+		uint64_t								Hits() const { return m_ui64Hits; }
+
+		/**
+		 * Gets the number of allocations that had to go to the OS.
+		 * 
+		 * \return Returns the number of allocations that had to go to the OS.
+		 **/
+		uint64_t								Misses() const { return m_ui64Misses; }
+
+		/**
+		 * Gets the number of bytes currently held in the shared free lists.
+		 * 
+		 * \return Returns the number of bytes currently held in the shared free lists.
+		 **/
+		uint64_t								CachedBytes() const { return m_ui64Cached; }
+
+		/**
+		 * Resets the hit and miss counters.
+		 **/
+		void									ResetStats() { m_ui64Hits = 0; m_ui64Misses = 0; }
+
+		/**
+		 * Gets the size class for a given request size and the rounded-up block size of that class.
+		 * 
+		 * \param _sSize The requested size in bytes.
+		 * \param _sRounded Holds the block size of the returned class.
+		 * \return Returns the size-class index.
+		 **/
+		static size_t							SizeClass( size_t _sSize, size_t &_sRounded );
+
+		/**
+		 * Gets the block size of a size class.
+		 * 
+		 * \param _sClass The size class.
+		 * \return Returns the size of every block in the given class.
+		 **/
+		static size_t							BlockSize( size_t _sClass );
+
+
+	protected :
+		// == Types.
+		/** A free list for a single size class. */
+		struct NN9_ALIGN( 64 ) NN9_FREE_LIST {
+			std::mutex							mMutex;									/**< Guards vBlocks. */
+			std::vector<uint8_t *>				vBlocks;								/**< Cached blocks of this size class. */
+		};
+
+		/** A per-thread cache of small blocks. */
+		struct NN9_THREAD_CACHE {
+			~NN9_THREAD_CACHE();
+
+			std::mutex							mMutex;									/**< Guards aBlocks against Trim() on another thread. */
+			CachingAllocator *					pcaOwner = nullptr;						/**< The allocator whose blocks are cached here. */
+			std::array<std::vector<uint8_t *>, NN9_CA_CLASSES>
+												aBlocks;								/**< Cached blocks per size class. */
+		};
+
+
+		// == Members.
+		std::array<NN9_FREE_LIST, NN9_CA_CLASSES>
+												m_aLists;								/**< The shared free lists. */
+		std::atomic<uint64_t>					m_ui64Hits = 0;							/**< Allocations served from the cache. */
+		std::atomic<uint64_t>					m_ui64Misses = 0;						/**< Allocations served by the OS. */
+		std::atomic<uint64_t>					m_ui64Cached = 0;						/**< Bytes currently in the shared free lists. */
+		std::atomic<uint64_t>					m_ui64Limit = NN9_CA_DEFAULT_LIMIT;		/**< Maximum bytes in the shared free lists. */
+		std::mutex								m_mCaches;								/**< Guards m_vCaches.  Taken before any thread cache's mutex. */
+		std::vector<NN9_THREAD_CACHE *>			m_vCaches;								/**< Every live thread cache bound to this allocator. */
+		static thread_local bool				m_bThreadCacheGone;						/**< Set once the calling thread's cache has been destroyed. */
+
+
+		// == Functions.
+		/**
+		 * Gets the calling thread's cache if it belongs to this allocator.
+		 * 
+		 * \return Returns the calling thread's cache or nullptr if it is bound to another allocator.
+		 **/
+		NN9_THREAD_CACHE *						ThreadCache();
+
+		/**
+		 * Frees every block in a thread cache back to the OS.  The cache's mutex must be held.
+		 * 
+		 * \param _ptcCache The cache to empty.
+		 * \return Returns the number of bytes released.
+		 **/
+		static uint64_t							FreeThreadCache( NN9_THREAD_CACHE * _ptcCache );
+
+		/**
+		 * Allocates a block directly from the OS.
+		 * 
+		 * \param _sSize The size of the block to allocate.
+		 * \throw Throws std::bad_alloc if the memory could not be allocated.
+		 * \return Returns the allocated block.
+		 **/
+		static uint8_t *						OsAlloc( size_t _sSize );
+
+		/**
+		 * Frees a block directly to the OS.
+		 * 
+		 * \param _pui8Block The block to free.
+		 * \param _sSize The size of the block.
+		 **/
+		static void								OsFree( uint8_t * _pui8Block, size_t _sSize );
+
+		/**
+		 * Pushes a block onto a shared free list or frees it if the cache is full.
+		 * 
+		 * \param _pui8Block The block to release.
+		 * \param _sClass The size class of the block.
+		 * \param _sAllocated The size of the block.
+		 **/
+		void									PushShared( uint8_t * _pui8Block, size_t _sClass, size_t _sAllocated );
+	};
+
+}	// namespace nn9
@@ -55,6 +55,35 @@ namespace nn9 {
 		return CreateFileMap();
 	}
 
+	/**
+	 * Opens a file for reading only.  Other processes can keep reading the file while it is open, and regions can only be mapped
+	 *	read-only or copy-on-write.
+	 *
+	 * \param _pFile Path to the file to open.
+	 * \return Returns an error code indicating the result of the operation.
+	 */
+	NN9_ERRORS FileMap::OpenReadOnly( const std::filesystem::path &_pFile ) {
+		Close();
+		try {
+			m_hFile = ::CreateFileW( _pFile.native().c_str(),
+				GENERIC_READ,
+				FILE_SHARE_READ,
+				NULL,
+				OPEN_EXISTING,
+				FILE_ATTRIBUTE_NORMAL,
+				NULL );
+
+			if ( m_hFile == FileMap_Null ) {
+				auto aCode = Errors::GetLastError_To_Native();
+				Close();
+				return aCode;
+			}
+			m_bWritable = false;
+		}
+		catch ( ... ) { return NN9_E_OUT_OF_MEMORY; }		// _pFile.native() fails if out of memory.
+		return CreateFileMap();
+	}
+
 	/**
 	 * Creates a file.
 	 *
@@ -166,6 +195,86 @@ namespace nn9 {
 		m_ui32MapSize = 0;
 		return NN9_E_SUCCESS;
 	}
+
+	/**
+	 * Resizes the file.  Any region previously returned by MapRegion() must be unmapped first.
+	 * 
+	 * \param _ui64Size The new size of the file, in bytes.
+	 * \return Returns an error code indicating the result of the operation.
+	 **/
+	NN9_ERRORS FileMap::SetSize( uint64_t _ui64Size ) {
+		if ( m_hFile == FileMap_Null ) { return NN9_E_INVALID_HANDLE; }
+		if ( !m_bWritable ) { return NN9_E_INVALID_PERMISSIONS; }
+		// The mapping object fixes the maximum size, so it has to be recreated.
+		if ( m_hMap != FileMap_Null ) {
+			::CloseHandle( m_hMap );
+			m_hMap = FileMap_Null;
+		}
+		LARGE_INTEGER largeSize;
+		largeSize.QuadPart = static_cast<LONGLONG>(_ui64Size);
+		if ( !::SetFilePointerEx( m_hFile, largeSize, NULL, FILE_BEGIN ) ||
+			!::SetEndOfFile( m_hFile ) ) {
+			// The file keeps its old size and contents, so map it again at that size rather than losing what is already in it.
+			auto aCode = Errors::GetLastError_To_Native();
+			m_ui64Size = 0;
+			CreateFileMap();
+			return aCode;
+		}
+		m_ui64Size = 0;
+		return CreateFileMap();
+	}
+
+	/**
+	 * Maps a region of the file into memory.  The mapping starts on an allocation-granularity boundary at or before _ui64Offset and must be
+	 *	released with UnmapRegion() using the base and size returned here.
+	 * 
+	 * \param _ui64Offset The byte offset within the file of the start of the region.
+	 * \param _sSize The size of the region, in bytes.
+	 * \param _pvBase Holds the start of the actual mapping.
+	 * \param _sBaseSize Holds the size of the actual mapping.
+	 * \param _bCopyOnWrite If true, the region is writable but writes go to private copies of the pages and never reach the file.
+	 * \return Returns a pointer to the byte at _ui64Offset or nullptr on failure.
+	 **/
+	uint8_t * FileMap::MapRegion( uint64_t _ui64Offset, size_t _sSize, void * &_pvBase, size_t &_sBaseSize, bool _bCopyOnWrite ) const {
+		_pvBase = nullptr;
+		_sBaseSize = 0;
+		if ( m_hMap == FileMap_Null || !_sSize || _ui64Offset + _sSize > Size() ) { return nullptr; }
+
+		uint64_t ui64Base = _ui64Offset - (_ui64Offset % Granularity());
+		size_t sSize = static_cast<size_t>(_ui64Offset - ui64Base) + _sSize;
+		_pvBase = ::MapViewOfFile( m_hMap,
+			_bCopyOnWrite ? FILE_MAP_COPY : (m_bWritable ? (FILE_MAP_READ | FILE_MAP_WRITE) : FILE_MAP_READ),
+			static_cast<DWORD>(ui64Base >> 32),
+			static_cast<DWORD>(ui64Base),
+			sSize );
+		if ( !_pvBase ) { return nullptr; }
+		_sBaseSize = sSize;
+		return static_cast<uint8_t *>(_pvBase) + (_ui64Offset - ui64Base);
+	}
+
+	/**
+	 * Unmaps a region mapped by MapRegion().
+	 * 
+	 * \param _pvBase The base of the mapping as returned by MapRegion().
+	 * \param _sBaseSize The size of the mapping as returned by MapRegion().
+	 **/
+	void FileMap::UnmapRegion( void * _pvBase, size_t /*_sBaseSize*/ ) {
+		if ( _pvBase ) { ::UnmapViewOfFile( _pvBase ); }
+	}
+
+	/**
+	 * Gets the granularity at which file regions can be mapped.
+	 * 
+	 * \return Returns the allocation granularity of file mappings.
+	 **/
+	uint64_t FileMap::Granularity() {
+		static const uint64_t ui64Granularity = []() {
+			SYSTEM_INFO siInfo;
+			::GetSystemInfo( &siInfo );
+			return static_cast<uint64_t>(siInfo.dwAllocationGranularity);
+		}();
+		return ui64Granularity;
+	}
 #else
 
 	/**
@@ -191,6 +300,18 @@ namespace nn9 {
 		return CreateFileMap();
 	}
 
+	/**
+	 * Opens a file for reading only.  Other processes can keep reading the file while it is open, and regions can only be mapped
+	 *	read-only or copy-on-write.
+	 *
+	 * \param _pFile Path to the file to open.
+	 * \return Returns an error code indicating the result of the operation.
+	 */
+	NN9_ERRORS FileMap::OpenReadOnly( const std::filesystem::path &_pFile ) {
+		// Open() is already read-only here.
+		return Open( _pFile );
+	}
+
 	/**
 	 * Creates a file.
 	 *
@@ -278,6 +399,72 @@ namespace nn9 {
 		return NN9_E_SUCCESS;
 	}
 
+	/**
+	 * Resizes the file.  Any region previously returned by MapRegion() must be unmapped first.
+	 * 
+	 * \param _ui64Size The new size of the file, in bytes.
+	 * \return Returns an error code indicating the result of the operation.
+	 **/
+	NN9_ERRORS FileMap::SetSize( uint64_t _ui64Size ) {
+		if ( m_hFile == FileMap_Null ) { return NN9_E_INVALID_HANDLE; }
+		if ( !m_bWritable ) { return NN9_E_INVALID_PERMISSIONS; }
+		if ( ::ftruncate( m_hFile, static_cast<off_t>(_ui64Size) ) != 0 ) {
+			return Errors::ErrNo_T_To_Native( errno );
+		}
+		m_ui64Size = _ui64Size;
+		m_bIsEmpty = _ui64Size == 0;
+		return NN9_E_SUCCESS;
+	}
+
+	/**
+	 * Maps a region of the file into memory.  The mapping starts on an allocation-granularity boundary at or before _ui64Offset and must be
+	 *	released with UnmapRegion() using the base and size returned here.
+	 * 
+	 * \param _ui64Offset The byte offset within the file of the start of the region.
+	 * \param _sSize The size of the region, in bytes.
+	 * \param _pvBase Holds the start of the actual mapping.
+	 * \param _sBaseSize Holds the size of the actual mapping.
+	 * \param _bCopyOnWrite If true, the region is writable but writes go to private copies of the pages and never reach the file.
+	 * \return Returns a pointer to the byte at _ui64Offset or nullptr on failure.
+	 **/
+	uint8_t * FileMap::MapRegion( uint64_t _ui64Offset, size_t _sSize, void * &_pvBase, size_t &_sBaseSize, bool _bCopyOnWrite ) const {
+		_pvBase = nullptr;
+		_sBaseSize = 0;
+		if ( m_hMap == FileMap_Null || !_sSize || _ui64Offset + _sSize > Size() ) { return nullptr; }
+
+		uint64_t ui64Base = _ui64Offset - (_ui64Offset % Granularity());
+		size_t sSize = static_cast<size_t>(_ui64Offset - ui64Base) + _sSize;
+		void * pvMap = ::mmap( nullptr, sSize,
+			(m_bWritable || _bCopyOnWrite) ? (PROT_READ | PROT_WRITE) : PROT_READ,
+			_bCopyOnWrite ? MAP_PRIVATE : MAP_SHARED,
+			m_hMap,
+			static_cast<off_t>(ui64Base) );
+		if ( pvMap == MAP_FAILED ) { return nullptr; }
+		_pvBase = pvMap;
+		_sBaseSize = sSize;
+		return static_cast<uint8_t *>(_pvBase) + (_ui64Offset - ui64Base);
+	}
+
+	/**
+	 * Unmaps a region mapped by MapRegion().
+	 * 
+	 * \param _pvBase The base of the mapping as returned by MapRegion().
+	 * \param _sBaseSize The size of the mapping as returned by MapRegion().
+	 **/
+	void FileMap::UnmapRegion( void * _pvBase, size_t _sBaseSize ) {
+		if ( _pvBase ) { ::munmap( _pvBase, _sBaseSize ); }
+	}
+
+	/**
+	 * Gets the granularity at which file regions can be mapped.
+	 * 
+	 * \return Returns the allocation granularity of file mappings.
+	 **/
+	uint64_t FileMap::Granularity() {
+		static const uint64_t ui64Granularity = static_cast<uint64_t>(::sysconf( _SC_PAGESIZE ));
+		return ui64Granularity;
+	}
+
 #endif	// #ifdef _WIN32
 
 }	// namespace nn9
@@ -48,6 +48,15 @@ namespace nn9 {
 		 */
 		virtual NN9_ERRORS									Open( const std::filesystem::path &_pFile );
 
+		/**
+		 * Opens a file for reading only.  Other processes can keep reading the file while it is open, and regions can only be mapped
+		 *	read-only or copy-on-write.
+		 *
+		 * \param _pFile Path to the file to open.
+		 * \return Returns an error code indicating the result of the operation.
+		 */
+		NN9_ERRORS											OpenReadOnly( const std::filesystem::path &_pFile );
+
 		/**
 		 * Creates a file.
 		 *
@@ -68,6 +77,50 @@ namespace nn9 {
 		 **/
 		virtual uint64_t									Size() const;
 
+		/**
+		 * Resizes the file.  Any region previously returned by MapRegion() must be unmapped first.  On failure the file stays open with its
+		 *	old size and contents.
+		 * 
+		 * \param _ui64Size The new size of the file, in bytes.
+		 * \return Returns an error code indicating the result of the operation.
+		 **/
+		NN9_ERRORS											SetSize( uint64_t _ui64Size );
+
+		/**
+		 * Maps a region of the file into memory.  The mapping starts on an allocation-granularity boundary at or before _ui64Offset and must be
+		 *	released with UnmapRegion() using the base and size returned here.
+		 * 
+		 * \param _ui64Offset The byte offset within the file of the start of the region.
+		 * \param _sSize The size of the region, in bytes.
+		 * \param _pvBase Holds the start of the actual mapping.
+		 * \param _sBaseSize Holds the size of the actual mapping.
+		 * \param _bCopyOnWrite If true, the region is writable but writes go to private copies of the pages and never reach the file.
+		 * \return Returns a pointer to the byte at _ui64Offset or nullptr on failure.
+		 **/
+		uint8_t *											MapRegion( uint64_t _ui64Offset, size_t _sSize, void * &_pvBase, size_t &_sBaseSize, bool _bCopyOnWrite = false ) const;
+
+		/**
+		 * Unmaps a region mapped by MapRegion().
+		 * 
+		 * \param _pvBase The base of the mapping as returned by MapRegion().
+		 * \param _sBaseSize The size of the mapping as returned by MapRegion().
+		 **/
+		static void											UnmapRegion( void * _pvBase, size_t _sBaseSize );
+
+		/**
+		 * Gets the granularity at which file regions can be mapped.
+		 * 
+		 * \return Returns the allocation granularity of file mappings.
+		 **/
+		static uint64_t										Granularity();
+
+		/**
+		 * Determines whether the file was opened for writing.
+		 * 
+		 * \return Returns true if the file was opened for writing.
+		 **/
+		inline bool											Writable() const { return m_bWritable; }
+
 
 	protected :
 		// == Members.
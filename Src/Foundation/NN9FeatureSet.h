@@ -107,6 +107,7 @@ namespace nn9 {
 		static bool								INVPCID() { return m_iiCpuRep.m_bEbx7[10]; }
 		static bool								RTM() { return m_iiCpuRep.m_bIsIntel && m_iiCpuRep.m_bEbx7[11]; }
 		static bool								AVX512F() { return m_iiCpuRep.m_bEbx7[16]; }
+		static bool								AVX512DQ() { return m_iiCpuRep.m_bEbx7[17]; }
 		static bool								RDSEED() { return m_iiCpuRep.m_bEbx7[18]; }
 		static bool								ADX() { return m_iiCpuRep.m_bEbx7[19]; }
 		static bool								AVX512PF() { return m_iiCpuRep.m_bEbx7[26]; }
@@ -117,7 +118,8 @@ namespace nn9 {
 		static bool								AVX512BW() { return m_iiCpuRep.m_bEbx7[30]; }
 		static bool								AVX512VL() { return m_iiCpuRep.m_bEbx7[31]; }
 		static bool								AVX512BF16() { return m_iiCpuRep.m_bEax7_1[5]; }
-		static bool								AVX_VNNI() { return m_iiCpuRep.m_bEbx7_1[11];  }
+		static bool								AVX_VNNI() { return m_iiCpuRep.m_bEax7_1[4];  }
+		static bool								AVX512VNNI() { return m_iiCpuRep.m_bEcx7[11]; }
 
 		static bool								PREFETCHWT1() { return m_iiCpuRep.m_bEcx7[0]; }
 
@@ -356,6 +358,7 @@ namespace nn9 {
         static constexpr  bool					INVPCID() { return false; }
         static constexpr  bool					RTM() { return false; }
         static constexpr  bool					AVX512F() { return false; }
+        static constexpr  bool					AVX512DQ() { return false; }
         static constexpr  bool					RDSEED() { return false; }
         static constexpr  bool					ADX() { return false; }
         static constexpr  bool					AVX512PF() { return false; }
@@ -367,6 +370,7 @@ namespace nn9 {
         static constexpr  bool					AVX512VL() { return false; }
         static constexpr  bool					AVX512BF16() { return false; }
 		static constexpr  bool					AVX_VNNI() { return false; }
+		static constexpr  bool					AVX512VNNI() { return false; }
 
         static constexpr  bool					PREFETCHWT1() { return false; }
 
@@ -2152,16 +2152,10 @@ namespace nn9 {
 		 * \param _m0 The first 8 return values.
 		 **/
 		static inline void										uint32x8_to_float32x8( __m256i _mUint32, __m256 &_m0 ) {
-			//_m0 = _mm256_cvtepu32_ps( _mUint32 );
-			__m256 mFMax = _mm256_set1_ps( static_cast<float>(UINT32_MAX) );
-			__m256 mFClamp = _mm256_min_ps( _mm256_max_ps( _mm256_castsi256_ps( _mUint32 ), _mm256_setzero_ps() ), mFMax );
-
-			__m256 mMask = _mm256_cmp_ps( mFClamp, _mm256_set1_ps( 2147483648.0f ), _CMP_GE_OS );
-			__m256i mi32 = _mm256_cvttps_epi32( mFClamp );
-			__m256i mMaskI = _mm256_castps_si256( mMask );
-			__m256i mOffset = _mm256_set1_epi32( 2147483648u );
-			__m256i mu32 = _mm256_or_si256( mi32, _mm256_and_si256( mMaskI, mOffset ) );
-			_m0 = _mm256_cvtepi32_ps( mu32 );
+			// AVX2 has no unsigned conversion; convert the high and low halves separately (each exactly) and combine them.
+			__m256 mHi = _mm256_cvtepi32_ps( _mm256_srli_epi32( _mUint32, 16 ) );
+			__m256 mLo = _mm256_cvtepi32_ps( _mm256_and_si256( _mUint32, _mm256_set1_epi32( 0xFFFF ) ) );
+			_m0 = _mm256_add_ps( _mm256_mul_ps( mHi, _mm256_set1_ps( 65536.0f ) ), mLo );
 		}
 
 		/**
@@ -3228,15 +3222,11 @@ namespace nn9 {
 			__m512 mClamped2 = _mm512_min_ps( _mm512_max_ps( _mFloat2, fMin ), fMax );
 			__m512 mClamped3 = _mm512_min_ps( _mm512_max_ps( _mFloat3, fMin ), fMax );
 
-			__m512i m0 = _mm512_cvttps_epi32( mClamped0 );
-			__m512i m1 = _mm512_cvttps_epi32( mClamped1 );
-			__m512i m2 = _mm512_cvttps_epi32( mClamped2 );
-			__m512i m3 = _mm512_cvttps_epi32( mClamped3 );
-
-			__m512i mPacked160 = _mm512_packs_epi32( m0, m1 );
-			__m512i mPacked161 = _mm512_packs_epi32( m2, m3 );
-
-			return _mm512_packs_epi16( mPacked160, mPacked161 );
+			// Down-convert rather than pack so that the elements stay in order (packing interleaves the 128-bit lanes).
+			__m512i mRet = _mm512_castsi128_si512( _mm512_cvtsepi32_epi8( _mm512_cvttps_epi32( mClamped0 ) ) );
+			mRet = _mm512_inserti32x4( mRet, _mm512_cvtsepi32_epi8( _mm512_cvttps_epi32( mClamped1 ) ), 1 );
+			mRet = _mm512_inserti32x4( mRet, _mm512_cvtsepi32_epi8( _mm512_cvttps_epi32( mClamped2 ) ), 2 );
+			return _mm512_inserti32x4( mRet, _mm512_cvtsepi32_epi8( _mm512_cvttps_epi32( mClamped3 ) ), 3 );
 		}
 
 		/**
@@ -3260,15 +3250,11 @@ namespace nn9 {
 			__m512 mClamped2 = _mm512_min_ps( _mm512_max_ps( _mFloat2, fMin ), fMax );
 			__m512 mClamped3 = _mm512_min_ps( _mm512_max_ps( _mFloat3, fMin ), fMax );
 
-			__m512i m0 = _mm512_cvttps_epu32( mClamped0 );
-			__m512i m1 = _mm512_cvttps_epu32( mClamped1 );
-			__m512i m2 = _mm512_cvttps_epu32( mClamped2 );
-			__m512i m3 = _mm512_cvttps_epu32( mClamped3 );
-
-			__m512i mPacked160 = _mm512_packus_epi32( m0, m1 );
-			__m512i mPacked161 = _mm512_packus_epi32( m2, m3 );
-
-			return _mm512_packus_epi16( mPacked160, mPacked161 );
+			// Down-convert rather than pack so that the elements stay in order (packing interleaves the 128-bit lanes).
+			__m512i mRet = _mm512_castsi128_si512( _mm512_cvtusepi32_epi8( _mm512_cvttps_epu32( mClamped0 ) ) );
+			mRet = _mm512_inserti32x4( mRet, _mm512_cvtusepi32_epi8( _mm512_cvttps_epu32( mClamped1 ) ), 1 );
+			mRet = _mm512_inserti32x4( mRet, _mm512_cvtusepi32_epi8( _mm512_cvttps_epu32( mClamped2 ) ), 2 );
+			return _mm512_inserti32x4( mRet, _mm512_cvtusepi32_epi8( _mm512_cvttps_epu32( mClamped3 ) ), 3 );
 		}
 
 		/**
@@ -3325,7 +3311,7 @@ namespace nn9 {
 			__m512 mClamped1 = _mm512_min_ps( _mm512_max_ps( _mFloat1, _mm512_set1_ps( -32768.0f ) ), _mm512_set1_ps( 32767.0f ) );
 			__m512i mConv0 = _mm512_cvttps_epi32( mClamped0 );
 			__m512i mConv1 = _mm512_cvttps_epi32( mClamped1 );
-			return _mm512_packs_epi16( mConv0, mConv1 );
+			return _mm512_inserti64x4( _mm512_castsi256_si512( _mm512_cvtsepi32_epi16( mConv0 ) ), _mm512_cvtsepi32_epi16( mConv1 ), 1 );
 		}
 
 		/**
@@ -3340,7 +3326,7 @@ namespace nn9 {
 			__m512 mClamped1 = _mm512_min_ps( _mm512_max_ps( _mFloat1, _mm512_setzero_ps() ), _mm512_set1_ps( 65535.0f ) );
 			__m512i m0 = _mm512_cvttps_epu32( mClamped0 );
 			__m512i m1 = _mm512_cvttps_epu32( mClamped1 );
-			return _mm512_packus_epi32( m0, m1 );
+			return _mm512_inserti64x4( _mm512_castsi256_si512( _mm512_cvtusepi32_epi16( m0 ) ), _mm512_cvtusepi32_epi16( m1 ), 1 );
 		}
 
 		/**
@@ -3602,7 +3588,8 @@ namespace nn9 {
 			__m256i mPacked0 = _mm256_packs_epi32( m0, m1 );
 			__m256i mPacked1 = _mm256_packs_epi32( m2, m3 );
 
-			return _mm256_packs_epi16( mPacked0, mPacked1 );
+			// Packing works within 128-bit lanes; put the 32-bit groups back in order.
+			return _mm256_permutevar8x32_epi32( _mm256_packs_epi16( mPacked0, mPacked1 ), _mm256_setr_epi32( 0, 4, 1, 5, 2, 6, 3, 7 ) );
 		}
 
 		/**
@@ -3623,15 +3610,17 @@ namespace nn9 {
 			__m256 mClamped2 = _mm256_min_ps( _mm256_max_ps( _mFloat2, fMin ), fMax );
 			__m256 mClamped3 = _mm256_min_ps( _mm256_max_ps( _mFloat3, fMin ), fMax );
 
-			__m256i m0 = _mm256_cvttps_epu32( mClamped0 );
-			__m256i m1 = _mm256_cvttps_epu32( mClamped1 );
-			__m256i m2 = _mm256_cvttps_epu32( mClamped2 );
-			__m256i m3 = _mm256_cvttps_epu32( mClamped3 );
+			// The clamped values fit in a signed 32-bit integer.
+			__m256i m0 = _mm256_cvttps_epi32( mClamped0 );
+			__m256i m1 = _mm256_cvttps_epi32( mClamped1 );
+			__m256i m2 = _mm256_cvttps_epi32( mClamped2 );
+			__m256i m3 = _mm256_cvttps_epi32( mClamped3 );
 
 			__m256i mPacked0 = _mm256_packus_epi32( m0, m1 );
 			__m256i mPacked1 = _mm256_packus_epi32( m2, m3 );
 
-			return _mm256_packus_epi16( mPacked0, mPacked1 );
+			// Packing works within 128-bit lanes; put the 32-bit groups back in order.
+			return _mm256_permutevar8x32_epi32( _mm256_packus_epi16( mPacked0, mPacked1 ), _mm256_setr_epi32( 0, 4, 1, 5, 2, 6, 3, 7 ) );
 		}
 
 		/**
@@ -3690,7 +3679,8 @@ namespace nn9 {
 			__m256 mClamped1 = _mm256_min_ps( _mm256_max_ps( _mFloat1, fMin ), fMax );
 			__m256i m0 = _mm256_cvttps_epi32( mClamped0 );
 			__m256i m1 = _mm256_cvttps_epi32( mClamped1 );
-			return _mm256_packs_epi32( m0, m1 );
+			// Packing works within 128-bit lanes; put the 64-bit groups back in order.
+			return _mm256_permute4x64_epi64( _mm256_packs_epi32( m0, m1 ), _MM_SHUFFLE( 3, 1, 2, 0 ) );
 		}
 
 		/**
@@ -3705,9 +3695,11 @@ namespace nn9 {
 			__m256 fMax = _mm256_set1_ps( 65535.0f );
 			__m256 mClamped0 = _mm256_min_ps( _mm256_max_ps( _mFloat0, fMin ), fMax );
 			__m256 mClamped1 = _mm256_min_ps( _mm256_max_ps( _mFloat1, fMin ), fMax );
-			__m256i m0 = _mm256_cvttps_epu32( mClamped0 );
-			__m256i m1 = _mm256_cvttps_epu32( mClamped1 );
-			return _mm256_packus_epi32( m0, m1 );
+			// The clamped values fit in a signed 32-bit integer.
+			__m256i m0 = _mm256_cvttps_epi32( mClamped0 );
+			__m256i m1 = _mm256_cvttps_epi32( mClamped1 );
+			// Packing works within 128-bit lanes; put the 64-bit groups back in order.
+			return _mm256_permute4x64_epi64( _mm256_packus_epi32( m0, m1 ), _MM_SHUFFLE( 3, 1, 2, 0 ) );
 		}
 
 		/**
@@ -3757,9 +3749,14 @@ namespace nn9 {
 		 */
 		static inline __m256i									float32x8_to_uint32x8_saturated( __m256 _mFloat ) {
 			__m256 fMin = _mm256_setzero_ps();
-			__m256 fMax = _mm256_set1_ps( static_cast<float>(UINT32_MAX) );
+			__m256 fMax = _mm256_set1_ps( 4294967040.0f );	// The largest float below 2^32.
 			__m256 mClamped = _mm256_min_ps( _mm256_max_ps( _mFloat, fMin ), fMax );
-			return _mm256_cvttps_epu32( mClamped );
+
+			// AVX2 has no unsigned conversion; values at or above 2^31 are shifted down into signed range and the top bit restored.
+			__m256 mBig = _mm256_set1_ps( 2147483648.0f );
+			__m256 mMask = _mm256_cmp_ps( mClamped, mBig, _CMP_GE_OQ );
+			__m256i mConv = _mm256_cvttps_epi32( _mm256_sub_ps( mClamped, _mm256_and_ps( mMask, mBig ) ) );
+			return _mm256_xor_si256( mConv, _mm256_and_si256( _mm256_castps_si256( mMask ), _mm256_set1_epi32( INT_MIN ) ) );
 		}
 
 		/**
@@ -4651,7 +4648,7 @@ namespace nn9 {
 			_i16Dst = std::min<uint16_t>( _u16Src, INT16_MAX );
 		}
 		static inline void										scast( uint16_t _u16Src, uint16_t &_u16Dst ) {
-			_u16Dst = _u16Dst;
+			_u16Dst = _u16Src;
 		}
 		static inline void										scast( uint16_t _u16Src, int32_t &_i32Dst ) {
 			_i32Dst = _u16Src;
@@ -5591,10 +5588,10 @@ namespace nn9 {
 			_u64Dst = static_cast<uint64_t>(std::clamp<float>( _fSrc, 0.0f, static_cast<float>(UINT64_MAX) ));
 		}
 		static inline void										scast( bfloat16_t _fSrc, nn9::float16 &_f16Dst ) {
-			_f16Dst.m_u16Value = _fSrc.m_u16Value;
+			_f16Dst = static_cast<float>(_fSrc);
 		}
 		static inline void										scast( bfloat16_t _fSrc, bfloat16_t &_f16Dst ) {
-			_f16Dst = static_cast<float>(_fSrc);
+			_f16Dst.m_u16Value = _fSrc.m_u16Value;
 		}
 		static inline void										scast( bfloat16_t _fSrc, float &_fDst ) {
 			_fDst = _fSrc;
@@ -0,0 +1,224 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Tables of kernels compiled once per instruction set, each in its own translation unit, from which the best table for the
+ *	running CPU is selected once at run time.  This file holds the plain C++ kernels and the selection.
+ */
+
+#include "NN9Kernels.h"
+#include "../Utilities/NN9Utilities.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+namespace nn9 {
+
+	// == Functions.
+	/**
+	 * _pfOut[I] = exp( _pfIn[I] ), computed in double as the generic element-wise path does.
+	 *
+	 * \param _pfIn The input.
+	 * \param _pfOut The output.
+	 * \param _sTotal The number of elements.
+	 **/
+	void Kernels::ScalarExpF32( const float * _pfIn, float * _pfOut, size_t _sTotal ) {
+		for ( size_t I = 0; I < _sTotal; ++I ) { _pfOut[I] = float( std::exp( double( _pfIn[I] ) ) ); }
+	}
+
+	/**
+	 * _pfOut[I] = log( _pfIn[I] ), computed in double as the generic element-wise path does.
+	 *
+	 * \param _pfIn The input.
+	 * \param _pfOut The output.
+	 * \param _sTotal The number of elements.
+	 **/
+	void Kernels::ScalarLogF32( const float * _pfIn, float * _pfOut, size_t _sTotal ) {
+		for ( size_t I = 0; I < _sTotal; ++I ) { _pfOut[I] = float( std::log( double( _pfIn[I] ) ) ); }
+	}
+
+	/**
+	 * _pfOut[I] = tanh( _pfIn[I] ), computed in double as the generic element-wise path does.
+	 *
+	 * \param _pfIn The input.
+	 * \param _pfOut The output.
+	 * \param _sTotal The number of elements.
+	 **/
+	void Kernels::ScalarTanhF32( const float * _pfIn, float * _pfOut, size_t _sTotal ) {
+		for ( size_t I = 0; I < _sTotal; ++I ) { _pfOut[I] = float( std::tanh( double( _pfIn[I] ) ) ); }
+	}
+
+	/**
+	 * _pdOut[I] = exp( _pdIn[I] ).
+	 *
+	 * \param _pdIn The input.
+	 * \param _pdOut The output.
+	 * \param _sTotal The number of elements.
+	 **/
+	void Kernels::ScalarExpF64( const double * _pdIn, double * _pdOut, size_t _sTotal ) {
+		for ( size_t I = 0; I < _sTotal; ++I ) { _pdOut[I] = std::exp( _pdIn[I] ); }
+	}
+
+	/**
+	 * _pdOut[I] = log( _pdIn[I] ).
+	 *
+	 * \param _pdIn The input.
+	 * \param _pdOut The output.
+	 * \param _sTotal The number of elements.
+	 **/
+	void Kernels::ScalarLogF64( const double * _pdIn, double * _pdOut, size_t _sTotal ) {
+		for ( size_t I = 0; I < _sTotal; ++I ) { _pdOut[I] = std::log( _pdIn[I] ); }
+	}
+
+	/**
+	 * _pdOut[I] = tanh( _pdIn[I] ).
+	 *
+	 * \param _pdIn The input.
+	 * \param _pdOut The output.
+	 * \param _sTotal The number of elements.
+	 **/
+	void Kernels::ScalarTanhF64( const double * _pdIn, double * _pdOut, size_t _sTotal ) {
+		for ( size_t I = 0; I < _sTotal; ++I ) { _pdOut[I] = std::tanh( _pdIn[I] ); }
+	}
+
+	/**
+	 * Widens bfloat16 bits to float.
+	 *
+	 * \param _pui16In The input.
+	 * \param _pfOut The output.
+	 * \param _sTotal The number of elements.
+	 **/
+	void Kernels::ScalarBf16ToF32( const uint16_t * _pui16In, float * _pfOut, size_t _sTotal ) {
+		for ( size_t I = 0; I < _sTotal; ++I ) {
+			const uint32_t ui32Bits = uint32_t( _pui16In[I] ) << 16;
+			std::memcpy( &_pfOut[I], &ui32Bits, sizeof( ui32Bits ) );
+		}
+	}
+
+	/**
+	 * Narrows float to bfloat16 bits by truncation.
+	 *
+	 * \param _pfIn The input.
+	 * \param _pui16Out The output.
+	 * \param _sTotal The number of elements.
+	 **/
+	void Kernels::ScalarF32ToBf16( const float * _pfIn, uint16_t * _pui16Out, size_t _sTotal ) {
+		for ( size_t I = 0; I < _sTotal; ++I ) {
+			uint32_t ui32Bits;
+			std::memcpy( &ui32Bits, &_pfIn[I], sizeof( ui32Bits ) );
+			_pui16Out[I] = uint16_t( ui32Bits >> 16 );
+		}
+	}
+
+	/**
+	 * Widens float to double.
+	 *
+	 * \param _pfIn The input.
+	 * \param _pdOut The output.
+	 * \param _sTotal The number of elements.
+	 **/
+	void Kernels::ScalarF32ToF64( const float * _pfIn, double * _pdOut, size_t _sTotal ) {
+		for ( size_t I = 0; I < _sTotal; ++I ) { _pdOut[I] = double( _pfIn[I] ); }
+	}
+
+	/**
+	 * Narrows double to float.
+	 *
+	 * \param _pdIn The input.
+	 * \param _pfOut The output.
+	 * \param _sTotal The number of elements.
+	 **/
+	void Kernels::ScalarF64ToF32( const double * _pdIn, float * _pfOut, size_t _sTotal ) {
+		for ( size_t I = 0; I < _sTotal; ++I ) { _pfOut[I] = float( _pdIn[I] ); }
+	}
+
+	/**
+	 * Gets the table for the running CPU.  It is built on the first call.
+	 *
+	 * \return Returns the table built from every tier the CPU and the build support.
+	 **/
+	const Kernels::NN9_TABLE & Kernels::Table() {
+		static const NN9_TABLE tTable = Build( NN9_KI_AVX512BF16 );
+		return tTable;
+	}
+
+	/**
+	 * Gets the highest tier the running CPU supports.
+	 *
+	 * \return Returns the highest tier the running CPU supports, whether or not the build includes it.
+	 **/
+	Kernels::NN9_KERNEL_ISA Kernels::Detect() {
+#ifdef NN9_CPUID
+		// /arch:AVX512 lets MSVC emit AVX-512BW, DQ, and VL instructions as well, so AVX-512F alone (Knights Landing) is not enough.
+		if ( Utilities::IsAvx512FSupported() && FeatureSet::AVX512BW() && FeatureSet::AVX512DQ() && FeatureSet::AVX512VL() ) { return Utilities::IsAvx512BF16Supported() ? NN9_KI_AVX512BF16 : NN9_KI_AVX512; }
+		if ( Utilities::IsAvx2Supported() && FeatureSet::FMA() ) { return NN9_KI_AVX2; }
+		if ( FeatureSet::SSE42() ) { return NN9_KI_SSE42; }
+#endif	// #ifdef NN9_CPUID
+		return NN9_KI_SCALAR;
+	}
+
+	/**
+	 * Builds a table from the tiers up to a given tier.  Tiers the running CPU does not support are never used.
+	 *
+	 * \param _kiMax The highest tier to use.
+	 * \return Returns the table.
+	 **/
+	Kernels::NN9_TABLE Kernels::Build( NN9_KERNEL_ISA _kiMax ) {
+		_kiMax = std::min( _kiMax, Detect() );
+		NN9_TABLE tRet;
+		FillScalar( tRet );
+		if ( _kiMax >= NN9_KI_SSE42 && FillSse42( tRet ) ) { tRet.kiIsa = NN9_KI_SSE42; }
+		if ( _kiMax >= NN9_KI_AVX2 && FillAvx2( tRet ) ) {
+			tRet.kiIsa = NN9_KI_AVX2;
+			// AVX-VNNI and AVX-512 VNNI only add int8_t kernels, and each can be present without the other.
+			if ( Utilities::IsAvxVNNISupported() ) { FillAvxVnni( tRet ); }
+		}
+		if ( _kiMax >= NN9_KI_AVX512 && FillAvx512( tRet ) ) {
+			tRet.kiIsa = NN9_KI_AVX512;
+			if ( Utilities::IsAvx512VNNISupported() ) { FillAvx512Vnni( tRet ); }
+		}
+		if ( _kiMax >= NN9_KI_AVX512BF16 && FillAvx512Bf16( tRet ) ) { tRet.kiIsa = NN9_KI_AVX512BF16; }
+		return tRet;
+	}
+
+	/**
+	 * Gets the name of a tier.
+	 *
+	 * \param _kiIsa The tier.
+	 * \return Returns the name of the tier.
+	 **/
+	const wchar_t * Kernels::Name( NN9_KERNEL_ISA _kiIsa ) {
+		switch ( _kiIsa ) {
+			case NN9_KI_SSE42 : { return L"SSE4.2"; }
+			case NN9_KI_AVX2 : { return L"AVX2"; }
+			case NN9_KI_AVX512 : { return L"AVX-512"; }
+			case NN9_KI_AVX512BF16 : { return L"AVX512-BF16"; }
+			default : { return L"scalar"; }
+		}
+	}
+
+	/**
+	 * Fills a table with the plain C++ kernels.
+	 *
+	 * \param _tTable The table to fill.
+	 **/
+	void Kernels::FillScalar( NN9_TABLE &_tTable ) {
+		_tTable.pfExpF32 = ScalarExpF32;
+		_tTable.pfLogF32 = ScalarLogF32;
+		_tTable.pfTanhF32 = ScalarTanhF32;
+		_tTable.pfExpF64 = ScalarExpF64;
+		_tTable.pfLogF64 = ScalarLogF64;
+		_tTable.pfTanhF64 = ScalarTanhF64;
+		_tTable.pfBf16ToF32 = ScalarBf16ToF32;
+		_tTable.pfF32ToBf16 = ScalarF32ToBf16;
+		_tTable.pfF32ToF64 = ScalarF32ToF64;
+		_tTable.pfF64ToF32 = ScalarF64ToF32;
+		_tTable.kiGemm = NN9_KI_SCALAR;
+		_tTable.kiConv = NN9_KI_SCALAR;
+		_tTable.kiIsa = NN9_KI_SCALAR;
+	}
+
+}	// namespace nn9
@@ -0,0 +1,593 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Tables of kernels compiled once per instruction set, each in its own translation unit, from which the best table for the
+ *	running CPU is selected once at run time.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace nn9 {
+
+	/**
+	 * Class Kernels
+	 * \brief Kernel tables selected at run time.
+	 *
+	 * Description: Tables of kernels compiled once per instruction set, each in its own translation unit, from which the best table for the
+	 *	running CPU is selected once at run time.  Only the per-instruction-set files need to be compiled for their instruction sets:
+	 *	NN9KernelsSse42.cpp with SSE4.2, NN9KernelsAvx2.cpp with AVX2 and FMA, NN9KernelsAvxVnni.cpp with AVX2 and AVX-VNNI,
+	 *	NN9KernelsAvx512.cpp with AVX-512F, NN9KernelsAvx512Vnni.cpp with AVX-512F and AVX-512 VNNI, and NN9KernelsAvx512Bf16.cpp with
+	 *	AVX-512F and AVX512-BF16 (/arch:AVX2 or /arch:AVX512 per file on MSVC, which defines none of __SSE4_1__, __AVXVNNI__,
+	 *	__AVX512VNNI__, or __AVX512BF16__ itself, so those files also define them; -msse4.2, -mavx2 -mfma, -mavx2 -mfma -mavxvnni,
+	 *	-mavx512f, -mavx512f -mavx512vnni, and -mavx512f -mavx512bf16 on GCC and Clang), so the rest of the library can target baseline
+	 *	x86-64 and still run the widest kernels the CPU has.  A file compiled without its instruction set contributes nothing and its tier is
+	 *	skipped.  The element-wise transcendental functions and conversions, Math's arithmetic, reductions, and arg-extremes,
+	 *	Softmax, Bf16Dot's pair kernels, Gemm's float, double, and bfloat16 pair tiles, QGemm's int8_t tiles, Quantize's conversions,
+	 *	Conv2D's direct tiles, Optimizer's steps, and Graph's fused instructions go through the table.  What remains behind #ifdef
+	 *	__AVX2__ or __AVX512F__ elsewhere (Intrin, Utilities' horizontal sums, and the bfloat16_t and float16 array helpers) is compiled
+	 *	only into files built for those instruction sets, so the project needs no instruction-set defines of its own.
+	 *
+	 * Tiers build on each other: each fills the entries it accelerates and leaves the rest of the table to the tiers below it.  The
+	 *	per-instruction-set files include only NN9SimdMath.h (with NN9_SIMDMATH_LOCAL), NN9KernelsSimd.h, and system headers, keep their code
+	 *	in an anonymous namespace, and hand the elements after their last full register to the Scalar*() kernels, so nothing with external linkage but
+	 *	their Fill*() is compiled there with instructions the baseline code cannot run.  bfloat16 values are passed as their bits (uint16_t)
+	 *	for the same reason.  Every kernel processes 1 contiguous range on the calling thread; splitting work across threads is left to the
+	 *	callers.
+	 */
+	class Kernels {
+	public :
+		// == Enumerations.
+		/** The instruction-set tiers, lowest first. */
+		enum NN9_KERNEL_ISA : size_t {
+			NN9_KI_SCALAR,																		/**< Plain C++. */
+			NN9_KI_SSE42,																		/**< SSE4.2. */
+			NN9_KI_AVX2,																		/**< AVX2 and FMA. */
+			NN9_KI_AVX512,																		/**< AVX-512F, BW, DQ, and VL. */
+			NN9_KI_AVX512BF16,																	/**< AVX-512F, BW, DQ, VL, and AVX512-BF16. */
+		};
+
+		/** The binary operations of pfBinaryF32 and pfBinaryF64. */
+		enum NN9_KERNEL_BINARY : size_t {
+			NN9_KB_ADD,																			/**< a + b. */
+			NN9_KB_SUB,																			/**< a - b. */
+			NN9_KB_MUL,																			/**< a * b. */
+			NN9_KB_DIV,																			/**< a / b. */
+			NN9_KB_TOTAL
+		};
+
+		/** The reductions of pfFoldF32, pfFoldF64, pfFoldRowF32, and pfFoldRowF64, in the order of Math's reductions. */
+		enum NN9_KERNEL_REDUCE : size_t {
+			NN9_KR_SUM,																			/**< Sum of the values. */
+			NN9_KR_SUM_SQ,																		/**< Sum of the squares of the values. */
+			NN9_KR_SUM_ABS,																		/**< Sum of the absolute values. */
+			NN9_KR_MAX,																			/**< Largest value.  NaN is kept. */
+			NN9_KR_MIN,																			/**< Smallest value.  NaN is kept. */
+			NN9_KR_MAX_ABS,																		/**< Largest absolute value.  NaN is kept. */
+			NN9_KR_TOTAL
+		};
+
+		/** The operations of pfSoftmaxF32 and pfSoftmaxF64, in the order of Softmax's operations. */
+		enum NN9_KERNEL_SOFTMAX : size_t {
+			NN9_KS_SOFTMAX,																		/**< exp( x - max ) / sum( exp( x - max ) ). */
+			NN9_KS_LOG_SOFTMAX,																	/**< x - log( sum( exp( x ) ) ). */
+			NN9_KS_LOG_SUM_EXP,																	/**< log( sum( exp( x ) ) ), 1 value per row. */
+		};
+
+		/** The bfloat16 pair kernels of pfDotBf16 and pfGemmBf16, in the order of Bf16Dot's kernels after NN9_BK_AUTO. */
+		enum NN9_KERNEL_BF16 : size_t {
+			NN9_KP_NATIVE,																		/**< vdpbf16ps. */
+			NN9_KP_EMULATED,																	/**< The emulation of vdpbf16ps, which gives the same bits as the instruction. */
+			NN9_KP_WIDEN,																		/**< Ordinary FMA on the widened pairs, keeping denormals. */
+			NN9_KP_TOTAL
+		};
+
+		/** The GEMM tile sizes of each tier that fills pfGemmF32 and pfGemmF64. */
+		enum NN9_KERNEL_GEMM : size_t {
+			NN9_KG_AVX2_MR						= 6,											/**< AVX2 rows. */
+			NN9_KG_AVX2_NR_F32					= 16,											/**< AVX2 float columns. */
+			NN9_KG_AVX2_NR_F64					= 8,											/**< AVX2 double columns. */
+			NN9_KG_AVX512_MR					= 8,											/**< AVX-512 rows. */
+			NN9_KG_AVX512_NR_F32				= 32,											/**< AVX-512 float columns. */
+			NN9_KG_AVX512_NR_F64				= 16,											/**< AVX-512 double columns. */
+			NN9_KG_I8_PANEL						= 16,											/**< Columns in each packed panel of int8_t B (QGemm::PackB()). */
+			NN9_KG_I8_KGROUP					= 4,											/**< Consecutive k values in each column of a panel. */
+			NN9_KG_I8_AVX2_MR					= 4,											/**< AVX2 int8_t rows. */
+			NN9_KG_I8_AVX2_NR					= 16,											/**< AVX2 int8_t columns. */
+			NN9_KG_I8_AVXVNNI_MR				= 6,											/**< AVX-VNNI int8_t rows. */
+			NN9_KG_I8_AVXVNNI_NR				= 16,											/**< AVX-VNNI int8_t columns. */
+			NN9_KG_I8_AVX512VNNI_MR				= 8,											/**< AVX-512 VNNI int8_t rows. */
+			NN9_KG_I8_AVX512VNNI_NR				= 32,											/**< AVX-512 VNNI int8_t columns. */
+		};
+
+		/** The direct-convolution tile widths, in output pixels, of each tier that fills pfConvF32 and pfConvF64.  A tile is 1 register
+		 *	of output channels, so channels are blocked by the register width of the tier. */
+		enum NN9_KERNEL_CONV : size_t {
+			NN9_KC_AVX2_COLS					= 12,											/**< AVX2 output pixels. */
+			NN9_KC_AVX512_COLS					= 14,											/**< AVX-512 output pixels. */
+		};
+
+		/** The int8_t GEMM kernels of pfGemmI8. */
+		enum NN9_KERNEL_INT8 : size_t {
+			NN9_KQ_AVX2,																		/**< pmaddubsw and pmaddwd, for weights in [-64, 64]. */
+			NN9_KQ_AVX2_SPLIT,																	/**< pmaddubsw and pmaddwd on the nibbles of A, for any weights. */
+			NN9_KQ_AVXVNNI,																		/**< vpdpbusd on 256-bit registers. */
+			NN9_KQ_AVX512VNNI,																	/**< vpdpbusd on 512-bit registers. */
+			NN9_KQ_TOTAL
+		};
+
+		/** The element types of pfToF32, pfFromF32, pfToF64, and pfFromF64. */
+		enum NN9_KERNEL_TYPE : size_t {
+			NN9_KT_INT8,																		/**< int8_t. */
+			NN9_KT_UINT8,																		/**< uint8_t. */
+			NN9_KT_INT16,																		/**< int16_t. */
+			NN9_KT_UINT16,																		/**< uint16_t. */
+			NN9_KT_INT32,																		/**< int32_t. */
+			NN9_KT_UINT32,																		/**< uint32_t. */
+			NN9_KT_FLOAT16,																		/**< nn9::float16, passed as its bits. */
+			NN9_KT_BFLOAT16,																	/**< bfloat16_t, passed as its bits. */
+			NN9_KT_FLOAT32,																		/**< float. */
+			NN9_KT_FLOAT64,																		/**< double. */
+			NN9_KT_TOTAL
+		};
+
+		/** The element-wise operations of pfUnaryF32 and pfUnaryF64.  exp(), log(), and tanh() have entries of their own. */
+		enum NN9_KERNEL_UNARY : size_t {
+			NN9_KU_EXPM1,																		/**< exp( x ) - 1. */
+			NN9_KU_LOG1P,																		/**< log( 1 + x ). */
+			NN9_KU_SIN,																			/**< sin( x ). */
+			NN9_KU_COS,																			/**< cos( x ). */
+			NN9_KU_ERF,																			/**< erf( x ). */
+			NN9_KU_SQUARE,																		/**< x * x. */
+			NN9_KU_SQRT,																		/**< sqrt( x ). */
+			NN9_KU_RSQRT,																		/**< 1 / sqrt( x ). */
+			NN9_KU_CEIL,																		/**< ceil( x ). */
+			NN9_KU_FLOOR,																		/**< floor( x ). */
+			NN9_KU_ROUND,																		/**< round( x ), halfway cases away from 0. */
+			NN9_KU_ROUND_EVEN,																	/**< x rounded to the nearest integer, halfway cases to even. */
+			NN9_KU_ABS,																			/**< |x|. */
+			NN9_KU_TOTAL
+		};
+
+		/** The instructions of pfFusedF32 and pfFusedF64, in the order of Graph's element-wise operations. */
+		enum NN9_KERNEL_FUSED : size_t {
+			NN9_KF_NEG,																			/**< -a. */
+			NN9_KF_ABS,																			/**< |a|. */
+			NN9_KF_SQUARE,																		/**< a * a. */
+			NN9_KF_SQRT,																		/**< sqrt( a ). */
+			NN9_KF_EXP,																			/**< exp( a ). */
+			NN9_KF_LOG,																			/**< log( a ). */
+			NN9_KF_TANH,																		/**< tanh( a ). */
+			NN9_KF_SIGMOID,																		/**< 1 / (1 + exp( -a )). */
+			NN9_KF_RELU,																		/**< a > 0 ? a : 0. */
+			NN9_KF_ADD,																			/**< a + b. */
+			NN9_KF_SUB,																			/**< a - b. */
+			NN9_KF_MUL,																			/**< a * b. */
+			NN9_KF_DIV,																			/**< a / b. */
+			NN9_KF_MAX,																			/**< a > b ? a : b. */
+			NN9_KF_MIN,																			/**< a < b ? a : b. */
+			NN9_KF_TOTAL
+		};
+
+
+		// == Types.
+		/** The strides of the blocked buffers of Conv2D's direct algorithm, in elements. */
+		struct NN9_DIRECT_LAYOUT {
+			size_t												sBlocks;										/**< Input-channel blocks per group. */
+			size_t												sLastLanes;										/**< Channels in the last input-channel block. */
+			size_t												sKh;											/**< Kernel height. */
+			size_t												sKw;											/**< Kernel width. */
+			size_t												sBlockIn;										/**< The distance between input-channel blocks. */
+			size_t												sTapY;											/**< The distance between vertical kernel taps. */
+			size_t												sTapX;											/**< The distance between horizontal kernel taps. */
+			size_t												sPixel;											/**< The distance between the inputs of adjacent output pixels. */
+		};
+
+		/** SGD constants in the compute precision (see Optimizer::Sgd()). */
+		template <typename _tScalar>
+		struct NN9_SGD_CONSTS {
+			_tScalar											sLr;											/**< The learning rate. */
+			_tScalar											sMomentum;										/**< The momentum. */
+			_tScalar											sDampening;										/**< 1 - the dampening. */
+			_tScalar											sWeightDecay;									/**< The L2 penalty. */
+			bool												bNesterov;										/**< Nesterov momentum. */
+		};
+
+		/** Adam constants in the compute precision, with the bias corrections folded in (see Optimizer::Adam()). */
+		template <typename _tScalar>
+		struct NN9_ADAM_CONSTS {
+			_tScalar											sBeta1;											/**< beta1. */
+			_tScalar											sOneMinusBeta1;									/**< 1 - beta1. */
+			_tScalar											sBeta2;											/**< beta2. */
+			_tScalar											sOneMinusBeta2;									/**< 1 - beta2. */
+			_tScalar											sStepSize;										/**< lr / (1 - beta1^t). */
+			_tScalar											sInvSqrtBias2;									/**< 1 / sqrt( 1 - beta2^t ). */
+			_tScalar											sEps;											/**< eps. */
+			_tScalar											sL2;											/**< The weight decay added to the gradient (Adam). */
+			_tScalar											sDecay;											/**< 1 - lr * weight_decay (AdamW), or 1. */
+		};
+
+		/** A table of kernels.  The entries before pfDotBf16 are set in every table.  pfDotBf16 and the entries after it are set from the
+		 *	AVX2 tier up and are nullptr below it, where their callers run their own loops. */
+		struct NN9_TABLE {
+			NN9_TABLE() :
+				pfExpF32( nullptr ),
+				pfLogF32( nullptr ),
+				pfTanhF32( nullptr ),
+				pfExpF64( nullptr ),
+				pfLogF64( nullptr ),
+				pfTanhF64( nullptr ),
+				pfBf16ToF32( nullptr ),
+				pfF32ToBf16( nullptr ),
+				pfF32ToF64( nullptr ),
+				pfF64ToF32( nullptr ),
+				pfDotBf16(),
+				pfToF32(),
+				pfFromF32(),
+				pfToF64(),
+				pfFromF64(),
+				pfUnaryF32(),
+				pfUnaryF64(),
+				pfBinaryF32(),
+				pfBinaryF64(),
+				pfFoldF32(),
+				pfFoldF64(),
+				pfFoldRowF32(),
+				pfFoldRowF64(),
+				pfKahanF32(),
+				pfKahanF64(),
+				pfKahanRowF32(),
+				pfKahanRowF64(),
+				pfArgF32(),
+				pfArgRowF32(),
+				pfSoftmaxF32( nullptr ),
+				pfSoftmaxF64( nullptr ),
+				pfGemmF32( nullptr ),
+				pfGemmF64( nullptr ),
+				pfGemmBf16(),
+				pfGemmI8(),
+				pfQuantizeF32(),
+				pfQuantizeI32(),
+				pfDequantize(),
+				pfConvF32( nullptr ),
+				pfConvF64( nullptr ),
+				pfSgdF32( nullptr ),
+				pfSgdF64( nullptr ),
+				pfSgdBf16( nullptr ),
+				pfAdamF32( nullptr ),
+				pfAdamF64( nullptr ),
+				pfAdamBf16( nullptr ),
+				pfFusedF32( nullptr ),
+				pfFusedF64( nullptr ),
+				kiGemm( NN9_KI_SCALAR ),
+				kiConv( NN9_KI_SCALAR ),
+				kiIsa( NN9_KI_SCALAR ) {
+			}
+
+
+			// == Members.
+			/** _pfOut[I] = exp( _pfIn[I] ).  The arrays may be the same. */
+			void												(*pfExpF32)( const float * _pfIn, float * _pfOut, size_t _sTotal );
+			/** _pfOut[I] = log( _pfIn[I] ).  The arrays may be the same. */
+			void												(*pfLogF32)( const float * _pfIn, float * _pfOut, size_t _sTotal );
+			/** _pfOut[I] = tanh( _pfIn[I] ).  The arrays may be the same. */
+			void												(*pfTanhF32)( const float * _pfIn, float * _pfOut, size_t _sTotal );
+			/** _pdOut[I] = exp( _pdIn[I] ).  The arrays may be the same. */
+			void												(*pfExpF64)( const double * _pdIn, double * _pdOut, size_t _sTotal );
+			/** _pdOut[I] = log( _pdIn[I] ).  The arrays may be the same. */
+			void												(*pfLogF64)( const double * _pdIn, double * _pdOut, size_t _sTotal );
+			/** _pdOut[I] = tanh( _pdIn[I] ).  The arrays may be the same. */
+			void												(*pfTanhF64)( const double * _pdIn, double * _pdOut, size_t _sTotal );
+			/** Widens bfloat16 bits to float. */
+			void												(*pfBf16ToF32)( const uint16_t * _pui16In, float * _pfOut, size_t _sTotal );
+			/** Narrows float to bfloat16 bits by truncation, as bfloat16's constructor does. */
+			void												(*pfF32ToBf16)( const float * _pfIn, uint16_t * _pui16Out, size_t _sTotal );
+			/** Widens float to double. */
+			void												(*pfF32ToF64)( const float * _pfIn, double * _pdOut, size_t _sTotal );
+			/** Narrows double to float, rounding to nearest. */
+			void												(*pfF64ToF32)( const double * _pdIn, float * _pfOut, size_t _sTotal );
+			/** The dot product of 2 arrays of bfloat16 bits in pairs (4 accumulators, as Bf16Dot's kernels), or the sum of _pui16A if
+			 *	_pui16B is nullptr, indexed by NN9_KERNEL_BF16.  The NN9_KP_NATIVE entry is set only when the CPU has AVX512-BF16. */
+			float												(*pfDotBf16[NN9_KP_TOTAL])( const uint16_t * _pui16A, const uint16_t * _pui16B, size_t _sTotal );
+			/** Widens an array of the element type given by the NN9_KERNEL_TYPE index to float. */
+			void												(*pfToF32[NN9_KT_TOTAL])( const void * _pvIn, float * _pfOut, size_t _sTotal );
+			/** Narrows float to the element type given by the NN9_KERNEL_TYPE index.  Integers saturate and truncate toward 0 as
+			 *	Intrin::scast() does; float16 rounds and bfloat16 truncates as their constructors do. */
+			void												(*pfFromF32[NN9_KT_TOTAL])( const float * _pfIn, void * _pvOut, size_t _sTotal );
+			/** Widens an array of the element type given by the NN9_KERNEL_TYPE index to double. */
+			void												(*pfToF64[NN9_KT_TOTAL])( const void * _pvIn, double * _pdOut, size_t _sTotal );
+			/** Narrows double to the element type given by the NN9_KERNEL_TYPE index, as pfFromF32 does.  float16 and bfloat16 are rounded
+			 *	to float first. */
+			void												(*pfFromF64[NN9_KT_TOTAL])( const double * _pdIn, void * _pvOut, size_t _sTotal );
+			/** _pfOut[I] = op( _pfIn[I] ), indexed by NN9_KERNEL_UNARY.  The arrays may be the same. */
+			void												(*pfUnaryF32[NN9_KU_TOTAL])( const float * _pfIn, float * _pfOut, size_t _sTotal );
+			/** _pdOut[I] = op( _pdIn[I] ), indexed by NN9_KERNEL_UNARY. */
+			void												(*pfUnaryF64[NN9_KU_TOTAL])( const double * _pdIn, double * _pdOut, size_t _sTotal );
+			/** _pfOut[I] = _pfA[I*_sStrideA] (op) _pfB[I*_sStrideB], indexed by NN9_KERNEL_BINARY.  A stride is 1, or 0 to pair 1 value with
+			 *	every element of the other input.  The output may be either input. */
+			void												(*pfBinaryF32[NN9_KB_TOTAL])( const float * _pfA, size_t _sStrideA, const float * _pfB, size_t _sStrideB, float * _pfOut, size_t _sTotal );
+			/** _pdOut[I] = _pdA[I*_sStrideA] (op) _pdB[I*_sStrideB], indexed by NN9_KERNEL_BINARY. */
+			void												(*pfBinaryF64[NN9_KB_TOTAL])( const double * _pdA, size_t _sStrideA, const double * _pdB, size_t _sStrideB, double * _pdOut, size_t _sTotal );
+			/** Folds a run into an accumulator and returns the result, indexed by NN9_KERNEL_REDUCE.  Sums are taken over the run in 4
+			 *	registers, folded pairwise, and added to _fAcc; maximums and minimums start from _fAcc. */
+			float												(*pfFoldF32[NN9_KR_TOTAL])( const float * _pfIn, size_t _sTotal, float _fAcc );
+			/** Folds a run into an accumulator and returns the result, indexed by NN9_KERNEL_REDUCE. */
+			double												(*pfFoldF64[NN9_KR_TOTAL])( const double * _pdIn, size_t _sTotal, double _dAcc );
+			/** _pfAcc[I] = _pfAcc[I] (op) _pfRow[I], indexed by NN9_KERNEL_REDUCE. */
+			void												(*pfFoldRowF32[NN9_KR_TOTAL])( const float * _pfRow, float * _pfAcc, size_t _sTotal );
+			/** _pdAcc[I] = _pdAcc[I] (op) _pdRow[I], indexed by NN9_KERNEL_REDUCE. */
+			void												(*pfFoldRowF64[NN9_KR_TOTAL])( const double * _pdRow, double * _pdAcc, size_t _sTotal );
+			/** Adds the terms of a run (the values, their squares, or their absolute values) to a Neumaier sum whose total is (*_pfSum) +
+			 *	(*_pfComp), indexed by NN9_KR_SUM, NN9_KR_SUM_SQ, or NN9_KR_SUM_ABS.  Each lane of 2 registers keeps a Kahan sum and the lanes
+			 *	join the Neumaier sum at the end, as Math's ReduceRun() does. */
+			void												(*pfKahanF32[NN9_KR_TOTAL])( const float * _pfIn, size_t _sTotal, float * _pfSum, float * _pfComp );
+			/** Adds the terms of a run to a Neumaier sum, indexed by NN9_KR_SUM, NN9_KR_SUM_SQ, or NN9_KR_SUM_ABS. */
+			void												(*pfKahanF64[NN9_KR_TOTAL])( const double * _pdIn, size_t _sTotal, double * _pdSum, double * _pdComp );
+			/** Adds the terms of a row to column Kahan sums whose totals are _pfAcc[I] - _pfComp[I], indexed by NN9_KR_SUM, NN9_KR_SUM_SQ, or
+			 *	NN9_KR_SUM_ABS. */
+			void												(*pfKahanRowF32[NN9_KR_TOTAL])( const float * _pfRow, float * _pfAcc, float * _pfComp, size_t _sTotal );
+			/** Adds the terms of a row to column Kahan sums, indexed by NN9_KR_SUM, NN9_KR_SUM_SQ, or NN9_KR_SUM_ABS. */
+			void												(*pfKahanRowF64[NN9_KR_TOTAL])( const double * _pdRow, double * _pdAcc, double * _pdComp, size_t _sTotal );
+			/** Gets the index of the first largest (NN9_KR_MAX) or smallest (NN9_KR_MIN) of 1 to INT32_MAX values, or of the first NaN. */
+			size_t												(*pfArgF32[NN9_KR_TOTAL])( const float * _pfIn, size_t _sTotal );
+			/** Folds row _ui32Row into the running extremes of columns for NN9_KR_MAX or NN9_KR_MIN: where a column's extreme is not NaN and
+			 *	the row's value is NaN or beyond it, the value replaces the extreme and _ui32Row its index. */
+			void												(*pfArgRowF32[NN9_KR_TOTAL])( const float * _pfRow, float * _pfBest, uint32_t * _pui32Idx, uint32_t _ui32Row, size_t _sTotal );
+			/** Runs a softmax operation over 1 contiguous row (see Softmax).  _pfOut receives the row, or 1 value for NN9_KS_LOG_SUM_EXP, and
+			 *	may be _pfIn.  If _bOnline, the maximum and the sum are found in 1 pass; otherwise the exponentials are kept in _pfOut. */
+			void												(*pfSoftmaxF32)( NN9_KERNEL_SOFTMAX _ksOp, const float * _pfIn, size_t _sCols, float * _pfOut, bool _bOnline );
+			/** Runs a softmax operation over 1 contiguous row. */
+			void												(*pfSoftmaxF64)( NN9_KERNEL_SOFTMAX _ksOp, const double * _pdIn, size_t _sCols, double * _pdOut, bool _bOnline );
+			/** Computes a full tile of C = alpha * A * B + beta * C from slivers packed as Gemm packs them, with the tile size of kiGemm. */
+			void												(*pfGemmF32)( size_t _sSteps, const float * _pfA, const float * _pfB, float * _pfC, size_t _sRowC, float _fAlpha, float _fBeta );
+			/** Computes a full tile of C = alpha * A * B + beta * C with the tile size of kiGemm. */
+			void												(*pfGemmF64)( size_t _sSteps, const double * _pdA, const double * _pdB, double * _pdC, size_t _sRowC, double _dAlpha, double _dBeta );
+			/** Computes a full tile of float C = alpha * A * B + beta * C from bfloat16 slivers packed in pairs as Gemm packs them, with the
+			 *	float tile size of kiGemm, indexed by NN9_KERNEL_BF16.  The NN9_KP_NATIVE entry is set only when the CPU has AVX512-BF16
+			 *	and kiGemm is NN9_KI_AVX512.  NN9_KP_WIDEN is never set; Gemm widens those operands to float and uses pfGemmF32. */
+			void												(*pfGemmBf16[NN9_KP_TOTAL])( size_t _sSteps, const uint16_t * _pui16A, const uint16_t * _pui16B, float * _pfC, size_t _sRowC,
+				float _fAlpha, float _fBeta );
+			/** Computes a full tile of int32_t C (or adds it to C) from an Mr-row sliver of A packed by QGemm::PackA() and the panels of B
+			 *	packed by QGemm::PackB(), indexed by NN9_KERNEL_INT8 with that kernel's NN9_KG_I8_* tile size.  _pi8B points at the first
+			 *	group of the tile's first column and _sPanelStride is the bytes between panels.  The AVX-VNNI and AVX-512 VNNI entries are set
+			 *	only when the CPU has those extensions. */
+			void												(*pfGemmI8[NN9_KQ_TOTAL])( size_t _sSteps, const uint8_t * _pui8A, const int8_t * _pi8B, size_t _sPanelStride,
+				int32_t * _pi32C, size_t _sRowC, bool _bAdd );
+			/** Quantizes floats: _pvOut[I] = clamp( round( _pfIn[I] * _fScale * _pfScale[I] ) + _i32Zero ), indexed by the NN9_KERNEL_TYPE of
+			 *	the output (only NN9_KT_INT8 and NN9_KT_UINT8 are set).  _pfScale may be nullptr.  Each value is clamped as a float before it
+			 *	is rounded to nearest-even, and NaN becomes the smallest value, as Quantize does
+			 *	(int8_t's smallest value is -127; see Quantize::Min()). */
+			void												(*pfQuantizeF32[NN9_KT_TOTAL])( const float * _pfScale, const float * _pfIn, void * _pvOut, size_t _sTotal,
+				float _fScale, int32_t _i32Zero );
+			/** Quantizes int32_t accumulators as pfQuantizeF32 quantizes floats. */
+			void												(*pfQuantizeI32[NN9_KT_TOTAL])( const float * _pfScale, const int32_t * _pi32In, void * _pvOut, size_t _sTotal,
+				float _fScale, int32_t _i32Zero );
+			/** Dequantizes: _pfOut[I] = (_pvIn[I] - _i32Zero) * _fScale, indexed by the NN9_KERNEL_TYPE of the input (only NN9_KT_INT8,
+			 *	NN9_KT_UINT8, and NN9_KT_INT32 are set). */
+			void												(*pfDequantize[NN9_KT_TOTAL])( const void * _pvIn, float * _pfOut, size_t _sTotal, float _fScale, int32_t _i32Zero );
+			/** Computes a tile of 1 to Cols output pixels of Conv2D's direct algorithm for 1 block of output channels into _pfTile,
+			 *	[_sCols, Lanes], from the buffers blocked as Conv2D::ForwardDirect() blocks them.  Lanes is the register width of kiConv and
+			 *	Cols is its NN9_KERNEL_CONV tile width. */
+			void												(*pfConvF32)( size_t _sCols, const NN9_DIRECT_LAYOUT &_dlLayout, const float * _pfIn, const float * _pfW, float * _pfTile );
+			/** Computes a tile of 1 to Cols output pixels of Conv2D's direct algorithm for 1 block of output channels. */
+			void												(*pfConvF64)( size_t _sCols, const NN9_DIRECT_LAYOUT &_dlLayout, const double * _pdIn, const double * _pdW, double * _pdTile );
+			/** Applies an SGD step to a run of float parameters, as Optimizer::Sgd() does.  _pfMom is nullptr when the momentum is 0.  The key
+			 *	and index are unused. */
+			void												(*pfSgdF32)( size_t _sTotal, float * _pfParam, const float * _pfGrad, float * _pfMom, const NN9_SGD_CONSTS<float> &_scConsts,
+				uint32_t _ui32Key, uint32_t _ui32Idx );
+			/** Applies an SGD step to a run of double parameters. */
+			void												(*pfSgdF64)( size_t _sTotal, double * _pdParam, const double * _pdGrad, double * _pdMom, const NN9_SGD_CONSTS<double> &_scConsts,
+				uint32_t _ui32Key, uint32_t _ui32Idx );
+			/** Applies an SGD step to a run of bfloat16 bits against float state.  The results are rounded as Optimizer::StochasticRound()
+			 *	rounds them, with _ui32Key and the element indices from _ui32Idx up. */
+			void												(*pfSgdBf16)( size_t _sTotal, uint16_t * _pui16Param, const uint16_t * _pui16Grad, float * _pfMom,
+				const NN9_SGD_CONSTS<float> &_scConsts, uint32_t _ui32Key, uint32_t _ui32Idx );
+			/** Applies an Adam step to a run of float parameters, as Optimizer::Adam() does.  The key and index are unused. */
+			void												(*pfAdamF32)( size_t _sTotal, float * _pfParam, const float * _pfGrad, float * _pfM, float * _pfV,
+				const NN9_ADAM_CONSTS<float> &_acConsts, uint32_t _ui32Key, uint32_t _ui32Idx );
+			/** Applies an Adam step to a run of double parameters. */
+			void												(*pfAdamF64)( size_t _sTotal, double * _pdParam, const double * _pdGrad, double * _pdM, double * _pdV,
+				const NN9_ADAM_CONSTS<double> &_acConsts, uint32_t _ui32Key, uint32_t _ui32Idx );
+			/** Applies an Adam step to a run of bfloat16 bits against float state, rounding as pfSgdBf16 does. */
+			void												(*pfAdamBf16)( size_t _sTotal, uint16_t * _pui16Param, const uint16_t * _pui16Grad, float * _pfM, float * _pfV,
+				const NN9_ADAM_CONSTS<float> &_acConsts, uint32_t _ui32Key, uint32_t _ui32Idx );
+			/** Runs 1 instruction of a fused Graph kernel: _pfOut[I] = op( _pfA[I], _pfB[I] ).  _pfB is unused by the 1-operand instructions and
+			 *	the output may be either input. */
+			void												(*pfFusedF32)( NN9_KERNEL_FUSED _kfOp, const float * _pfA, const float * _pfB, float * _pfOut, size_t _sTotal );
+			/** Runs 1 instruction of a fused Graph kernel. */
+			void												(*pfFusedF64)( NN9_KERNEL_FUSED _kfOp, const double * _pdA, const double * _pdB, double * _pdOut, size_t _sTotal );
+			NN9_KERNEL_ISA										kiGemm;							/**< The tier whose NN9_KERNEL_GEMM tile sizes pfGemmF32, pfGemmF64, and pfGemmBf16 use. */
+			NN9_KERNEL_ISA										kiConv;							/**< The tier whose register width and NN9_KERNEL_CONV tile width pfConvF32 and pfConvF64 use. */
+			NN9_KERNEL_ISA										kiIsa;							/**< The highest tier that filled any entry. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Gets the table for the running CPU.  It is built on the first call.
+		 *
+		 * \return Returns the table built from every tier the CPU and the build support.
+		 **/
+		static const NN9_TABLE &								Table();
+
+		/**
+		 * Gets the highest tier the running CPU supports.
+		 *
+		 * \return Returns the highest tier the running CPU supports, whether or not the build includes it.
+		 **/
+		static NN9_KERNEL_ISA									Detect();
+
+		/**
+		 * Builds a table from the tiers up to a given tier.  Tiers the running CPU does not support are never used.
+		 *
+		 * \param _kiMax The highest tier to use.
+		 * \return Returns the table.
+		 **/
+		static NN9_TABLE										Build( NN9_KERNEL_ISA _kiMax );
+
+		/**
+		 * Gets the name of a tier.
+		 *
+		 * \param _kiIsa The tier.
+		 * \return Returns the name of the tier.
+		 **/
+		static const wchar_t *									Name( NN9_KERNEL_ISA _kiIsa );
+
+		// The plain C++ kernels.  The per-instruction-set kernels call them for the elements after their last full register.
+		/**
+		 * _pfOut[I] = exp( _pfIn[I] ), computed in double as the generic element-wise path does.
+		 *
+		 * \param _pfIn The input.
+		 * \param _pfOut The output.
+		 * \param _sTotal The number of elements.
+		 **/
+		static void												ScalarExpF32( const float * _pfIn, float * _pfOut, size_t _sTotal );
+
+		/**
+		 * _pfOut[I] = log( _pfIn[I] ), computed in double as the generic element-wise path does.
+		 *
+		 * \param _pfIn The input.
+		 * \param _pfOut The output.
+		 * \param _sTotal The number of elements.
+		 **/
+		static void												ScalarLogF32( const float * _pfIn, float * _pfOut, size_t _sTotal );
+
+		/**
+		 * _pfOut[I] = tanh( _pfIn[I] ), computed in double as the generic element-wise path does.
+		 *
+		 * \param _pfIn The input.
+		 * \param _pfOut The output.
+		 * \param _sTotal The number of elements.
+		 **/
+		static void												ScalarTanhF32( const float * _pfIn, float * _pfOut, size_t _sTotal );
+
+		/**
+		 * _pdOut[I] = exp( _pdIn[I] ).
+		 *
+		 * \param _pdIn The input.
+		 * \param _pdOut The output.
+		 * \param _sTotal The number of elements.
+		 **/
+		static void												ScalarExpF64( const double * _pdIn, double * _pdOut, size_t _sTotal );
+
+		/**
+		 * _pdOut[I] = log( _pdIn[I] ).
+		 *
+		 * \param _pdIn The input.
+		 * \param _pdOut The output.
+		 * \param _sTotal The number of elements.
+		 **/
+		static void												ScalarLogF64( const double * _pdIn, double * _pdOut, size_t _sTotal );
+
+		/**
+		 * _pdOut[I] = tanh( _pdIn[I] ).
+		 *
+		 * \param _pdIn The input.
+		 * \param _pdOut The output.
+		 * \param _sTotal The number of elements.
+		 **/
+		static void												ScalarTanhF64( const double * _pdIn, double * _pdOut, size_t _sTotal );
+
+		/**
+		 * Widens bfloat16 bits to float.
+		 *
+		 * \param _pui16In The input.
+		 * \param _pfOut The output.
+		 * \param _sTotal The number of elements.
+		 **/
+		static void												ScalarBf16ToF32( const uint16_t * _pui16In, float * _pfOut, size_t _sTotal );
+
+		/**
+		 * Narrows float to bfloat16 bits by truncation.
+		 *
+		 * \param _pfIn The input.
+		 * \param _pui16Out The output.
+		 * \param _sTotal The number of elements.
+		 **/
+		static void												ScalarF32ToBf16( const float * _pfIn, uint16_t * _pui16Out, size_t _sTotal );
+
+		/**
+		 * Widens float to double.
+		 *
+		 * \param _pfIn The input.
+		 * \param _pdOut The output.
+		 * \param _sTotal The number of elements.
+		 **/
+		static void												ScalarF32ToF64( const float * _pfIn, double * _pdOut, size_t _sTotal );
+
+		/**
+		 * Narrows double to float.
+		 *
+		 * \param _pdIn The input.
+		 * \param _pfOut The output.
+		 * \param _sTotal The number of elements.
+		 **/
+		static void												ScalarF64ToF32( const double * _pdIn, float * _pfOut, size_t _sTotal );
+
+
+	protected :
+		// == Functions.
+		/**
+		 * Fills a table with the plain C++ kernels.
+		 *
+		 * \param _tTable The table to fill.
+		 **/
+		static void												FillScalar( NN9_TABLE &_tTable );
+
+		/**
+		 * Fills a table with the SSE4.2 kernels.  Defined in NN9KernelsSse42.cpp.
+		 *
+		 * \param _tTable The table to fill.
+		 * \return Returns false if the file was not compiled with SSE4.2.
+		 **/
+		static bool												FillSse42( NN9_TABLE &_tTable );
+
+		/**
+		 * Fills a table with the AVX2 kernels.  Defined in NN9KernelsAvx2.cpp.
+		 *
+		 * \param _tTable The table to fill.
+		 * \return Returns false if the file was not compiled with AVX2 and FMA.
+		 **/
+		static bool												FillAvx2( NN9_TABLE &_tTable );
+
+		/**
+		 * Fills a table with the AVX-512 kernels.  Defined in NN9KernelsAvx512.cpp.
+		 *
+		 * \param _tTable The table to fill.
+		 * \return Returns false if the file was not compiled with AVX-512F.
+		 **/
+		static bool												FillAvx512( NN9_TABLE &_tTable );
+
+		/**
+		 * Fills a table with the AVX512-BF16 kernels.  Defined in NN9KernelsAvx512Bf16.cpp.
+		 *
+		 * \param _tTable The table to fill.
+		 * \return Returns false if the file was not compiled with AVX-512F and AVX512-BF16.
+		 **/
+		static bool												FillAvx512Bf16( NN9_TABLE &_tTable );
+
+		/**
+		 * Fills a table with the AVX-VNNI kernels.  Defined in NN9KernelsAvxVnni.cpp.  These do not make a tier of their own; they are
+		 *	added over the AVX2 tier when the CPU has AVX-VNNI.
+		 *
+		 * \param _tTable The table to fill.
+		 * \return Returns false if the file was not compiled with AVX2 and AVX-VNNI.
+		 **/
+		static bool												FillAvxVnni( NN9_TABLE &_tTable );
+
+		/**
+		 * Fills a table with the AVX-512 VNNI kernels.  Defined in NN9KernelsAvx512Vnni.cpp.  These are added over the AVX-512 tier when
+		 *	the CPU has AVX-512 VNNI.
+		 *
+		 * \param _tTable The table to fill.
+		 * \return Returns false if the file was not compiled with AVX-512F and AVX-512 VNNI.
+		 **/
+		static bool												FillAvx512Vnni( NN9_TABLE &_tTable );
+	};
+
+}	// namespace nn9
@@ -0,0 +1,650 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: The AVX2 kernels.  Compile this file with AVX2 and FMA enabled (/arch:AVX2 on MSVC; -mavx2 -mfma on GCC and Clang).
+ *	Nothing outside of NN9SimdMath.h, NN9KernelsSimd.h, and the system headers may be included here, and everything but
+ *	Kernels::FillAvx2() stays in an anonymous namespace (see Kernels).
+ */
+
+#include "NN9Kernels.h"
+#define NN9_SIMDMATH_LOCAL
+#include "NN9SimdMath.h"
+#include "NN9KernelsSimd.h"
+
+
+namespace nn9 {
+
+#if defined( __AVX2__ ) && (defined( __FMA__ ) || defined( _MSC_VER ))
+namespace {
+
+	/**
+	 * Widens 8 float16 values, zero-extended to 32 bits, to float as float16::Uint16ToFloat() does.
+	 *
+	 * \param _mBits The float16 bits.
+	 * \return Returns the floats.
+	 **/
+	inline __m256 HalfToFloat( __m256i _mBits ) {
+		const __m256i mZero = _mm256_setzero_si256();
+		const __m256i mExpo = _mm256_srli_epi32( _mm256_and_si256( _mBits, _mm256_set1_epi32( 0x7C00 ) ), 10 );
+		const __m256i mMant = _mm256_slli_epi32( _mm256_and_si256( _mBits, _mm256_set1_epi32( 0x03FF ) ), 13 );
+		const __m256i mLdZ0 = _mm256_srli_epi32( _mm256_castps_si256( _mm256_cvtepi32_ps( mMant ) ), 23 );
+		const __m256i mExpoZero = _mm256_cmpeq_epi32( mExpo, mZero );
+
+		// Normal values keep their mantissas; subnormal values are normalized from the position of their leading 1.
+		const __m256i mNorm = _mm256_or_si256( _mm256_slli_epi32( _mm256_add_epi32( mExpo, _mm256_set1_epi32( 112 ) ), 23 ), mMant );
+		__m256i mSub = _mm256_or_si256( _mm256_slli_epi32( _mm256_sub_epi32( mLdZ0, _mm256_set1_epi32( 37 ) ), 23 ),
+			_mm256_and_si256( _mm256_sllv_epi32( mMant, _mm256_sub_epi32( _mm256_set1_epi32( 150 ), mLdZ0 ) ), _mm256_set1_epi32( 0x007FE000 ) ) );
+		mSub = _mm256_andnot_si256( _mm256_cmpeq_epi32( mMant, mZero ), _mm256_and_si256( mSub, mExpoZero ) );
+		__m256i mRet = _mm256_or_si256( _mm256_slli_epi32( _mm256_and_si256( _mBits, _mm256_set1_epi32( 0x8000 ) ), 16 ),
+			_mm256_or_si256( _mm256_andnot_si256( mExpoZero, mNorm ), mSub ) );
+
+		// Infinity and NaN.
+		const __m256i mInfNan = _mm256_cmpeq_epi32( _mm256_and_si256( _mBits, _mm256_set1_epi32( 0x7C00 ) ), _mm256_set1_epi32( 0x7C00 ) );
+		const __m256i mNan = _mm256_andnot_si256( _mm256_cmpeq_epi32( _mm256_and_si256( _mBits, _mm256_set1_epi32( 0x03FF ) ), mZero ), mInfNan );
+		mRet = _mm256_or_si256( mRet, _mm256_and_si256( mNan, _mm256_set1_epi32( 0x7FC00000 ) ) );
+		const __m256i mInf = _mm256_andnot_si256( mNan, mInfNan );
+		mRet = _mm256_blendv_epi8( mRet, _mm256_or_si256( _mm256_set1_epi32( 0x7F800000 ), _mm256_and_si256( mRet, _mm256_set1_epi32( int32_t( 0x80000000 ) ) ) ), mInf );
+		return _mm256_castsi256_ps( mRet );
+	}
+
+	/**
+	 * Narrows 8 floats to float16 as float16::FloatToUint16() does.
+	 *
+	 * \param _mVal The floats.
+	 * \return Returns the float16 bits, zero-extended to 32 bits.
+	 **/
+	inline __m256i FloatToHalf( __m256 _mVal ) {
+		const __m256i mBits = _mm256_add_epi32( _mm256_castps_si256( _mVal ), _mm256_set1_epi32( 0x1000 ) );
+		const __m256i mExpo = _mm256_srli_epi32( _mm256_and_si256( mBits, _mm256_set1_epi32( 0x7F800000 ) ), 23 );
+		const __m256i mMant = _mm256_and_si256( mBits, _mm256_set1_epi32( 0x007FFFFF ) );
+
+		// Normal results, then subnormal results, then overflow.
+		__m256i mNorm = _mm256_or_si256( _mm256_and_si256( _mm256_slli_epi32( _mm256_sub_epi32( mExpo, _mm256_set1_epi32( 112 ) ), 10 ), _mm256_set1_epi32( 0x7C00 ) ),
+			_mm256_srli_epi32( mMant, 13 ) );
+		mNorm = _mm256_and_si256( mNorm, _mm256_cmpgt_epi32( mExpo, _mm256_set1_epi32( 112 ) ) );
+		__m256i mSub = _mm256_srli_epi32( _mm256_add_epi32( _mm256_srlv_epi32( _mm256_add_epi32( mMant, _mm256_set1_epi32( 0x007FF000 ) ),
+			_mm256_sub_epi32( _mm256_set1_epi32( 125 ), mExpo ) ), _mm256_set1_epi32( 1 ) ), 1 );
+		mSub = _mm256_and_si256( mSub, _mm256_and_si256( _mm256_cmpgt_epi32( _mm256_set1_epi32( 113 ), mExpo ), _mm256_cmpgt_epi32( mExpo, _mm256_set1_epi32( 101 ) ) ) );
+		__m256i mRet = _mm256_or_si256( _mm256_srli_epi32( _mm256_and_si256( mBits, _mm256_set1_epi32( int32_t( 0x80000000 ) ) ), 16 ), _mm256_or_si256( mNorm, mSub ) );
+		mRet = _mm256_or_si256( mRet, _mm256_and_si256( _mm256_cmpgt_epi32( mExpo, _mm256_set1_epi32( 143 ) ), _mm256_set1_epi32( 0x7FFF ) ) );
+
+		// Everything that reached the infinity exponent but was not NaN becomes infinity.
+		const __m256i mInf = _mm256_andnot_si256( _mm256_castps_si256( _mm256_cmp_ps( _mVal, _mVal, _CMP_UNORD_Q ) ),
+			_mm256_cmpeq_epi32( _mm256_and_si256( mRet, _mm256_set1_epi32( 0x7C00 ) ), _mm256_set1_epi32( 0x7C00 ) ) );
+		return _mm256_blendv_epi8( mRet, _mm256_or_si256( _mm256_set1_epi32( 0x7C00 ), _mm256_and_si256( mRet, _mm256_set1_epi32( 0x8000 ) ) ), mInf );
+	}
+
+	/**
+	 * Packs 8 int32_t lanes into 8 int16_t (or uint16_t) lanes with saturation.
+	 *
+	 * \tparam _bSigned If true, the lanes saturate to int16_t; otherwise to uint16_t.
+	 * \param _mVal The lanes.
+	 * \return Returns the packed lanes.
+	 **/
+	template <bool _bSigned>
+	inline __m128i Pack16( __m256i _mVal ) {
+		if constexpr ( _bSigned ) { return _mm_packs_epi32( _mm256_castsi256_si128( _mVal ), _mm256_extracti128_si256( _mVal, 1 ) ); }
+		else { return _mm_packus_epi32( _mm256_castsi256_si128( _mVal ), _mm256_extracti128_si256( _mVal, 1 ) ); }
+	}
+
+	/** float registers for SimdKernels. */
+	struct NN9_F32 {
+		typedef float											Scalar;
+		typedef __m256											Reg;
+		static constexpr size_t									Lanes = 8;
+
+		static inline Reg										Zero() { return _mm256_setzero_ps(); }
+		static inline Reg										Set1( Scalar _sVal ) { return _mm256_set1_ps( _sVal ); }
+		static inline Reg										Load( const Scalar * _psSrc ) { return _mm256_loadu_ps( _psSrc ); }
+		static inline void										Store( Scalar * _psDst, Reg _rVal ) { _mm256_storeu_ps( _psDst, _rVal ); }
+		static inline Reg										Add( Reg _rA, Reg _rB ) { return _mm256_add_ps( _rA, _rB ); }
+		static inline Reg										Sub( Reg _rA, Reg _rB ) { return _mm256_sub_ps( _rA, _rB ); }
+		static inline Reg										Mul( Reg _rA, Reg _rB ) { return _mm256_mul_ps( _rA, _rB ); }
+		static inline Reg										Div( Reg _rA, Reg _rB ) { return _mm256_div_ps( _rA, _rB ); }
+		static inline Reg										Fma( Reg _rA, Reg _rB, Reg _rC ) { return _mm256_fmadd_ps( _rA, _rB, _rC ); }
+		static inline Reg										Abs( Reg _rA ) { return _mm256_andnot_ps( _mm256_set1_ps( -0.0f ), _rA ); }
+		static inline Reg										Neg( Reg _rA ) { return _mm256_xor_ps( _rA, _mm256_set1_ps( -0.0f ) ); }
+		static inline Reg										Max( Reg _rAcc, Reg _rVal ) {
+			return _mm256_blendv_ps( _mm256_max_ps( _rVal, _rAcc ), _rVal, _mm256_cmp_ps( _rVal, _rVal, _CMP_UNORD_Q ) );
+		}
+		static inline Reg										Min( Reg _rAcc, Reg _rVal ) {
+			return _mm256_blendv_ps( _mm256_min_ps( _rVal, _rAcc ), _rVal, _mm256_cmp_ps( _rVal, _rVal, _CMP_UNORD_Q ) );
+		}
+		static inline Reg										Greater( Reg _rA, Reg _rB ) { return _mm256_max_ps( _rA, _rB ); }
+		static inline Reg										Lesser( Reg _rA, Reg _rB ) { return _mm256_min_ps( _rA, _rB ); }
+		static inline Reg										FiniteOrZero( Reg _rA ) {
+			return _mm256_and_ps( _rA, _mm256_cmp_ps( _rA, _mm256_set1_ps( -INFINITY ), _CMP_NEQ_UQ ) );
+		}
+		static inline Reg										Sqrt( Reg _rA ) { return _mm256_sqrt_ps( _rA ); }
+		static inline Reg										Ceil( Reg _rA ) { return _mm256_round_ps( _rA, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC ); }
+		static inline Reg										Floor( Reg _rA ) { return _mm256_round_ps( _rA, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC ); }
+		static inline Reg										Trunc( Reg _rA ) { return _mm256_round_ps( _rA, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC ); }
+		static inline Reg										RoundEven( Reg _rA ) { return _mm256_round_ps( _rA, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }
+		static inline Reg										Round( Reg _rA ) {
+			// Halfway cases away from 0, as std::round().
+			const Reg rT = Trunc( _rA );
+			const Reg rUp = _mm256_cmp_ps( Abs( _mm256_sub_ps( _rA, rT ) ), _mm256_set1_ps( 0.5f ), _CMP_GE_OQ );
+			return _mm256_blendv_ps( rT, _mm256_add_ps( rT, _mm256_or_ps( _mm256_set1_ps( 1.0f ), _mm256_and_ps( _rA, _mm256_set1_ps( -0.0f ) ) ) ), rUp );
+		}
+		static inline __m256i									Truncate( Reg _rA, Scalar _sMin, Scalar _sMax ) {
+			return _mm256_cvttps_epi32( _mm256_min_ps( _mm256_max_ps( _rA, _mm256_set1_ps( _sMin ) ), _mm256_set1_ps( _sMax ) ) );
+		}
+		template <Kernels::NN9_KERNEL_TYPE _ktType>
+		static inline Reg										LoadAs( const void * _pvSrc ) {
+			const __m128i * pmSrc = static_cast<const __m128i *>(_pvSrc);
+			if constexpr ( _ktType == Kernels::NN9_KT_INT8 ) { return _mm256_cvtepi32_ps( _mm256_cvtepi8_epi32( _mm_loadl_epi64( pmSrc ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT8 ) { return _mm256_cvtepi32_ps( _mm256_cvtepu8_epi32( _mm_loadl_epi64( pmSrc ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_INT16 ) { return _mm256_cvtepi32_ps( _mm256_cvtepi16_epi32( _mm_loadu_si128( pmSrc ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT16 ) { return _mm256_cvtepi32_ps( _mm256_cvtepu16_epi32( _mm_loadu_si128( pmSrc ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_INT32 ) { return _mm256_cvtepi32_ps( _mm256_loadu_si256( static_cast<const __m256i *>(_pvSrc) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT32 ) {
+				// Both 16-bit halves are exact in float, so only the sum rounds.
+				const __m256i mVal = _mm256_loadu_si256( static_cast<const __m256i *>(_pvSrc) );
+				return _mm256_fmadd_ps( _mm256_cvtepi32_ps( _mm256_srli_epi32( mVal, 16 ) ), _mm256_set1_ps( 65536.0f ),
+					_mm256_cvtepi32_ps( _mm256_and_si256( mVal, _mm256_set1_epi32( 0xFFFF ) ) ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_FLOAT16 ) { return HalfToFloat( _mm256_cvtepu16_epi32( _mm_loadu_si128( pmSrc ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_BFLOAT16 ) { return _mm256_castsi256_ps( _mm256_slli_epi32( _mm256_cvtepu16_epi32( _mm_loadu_si128( pmSrc ) ), 16 ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_FLOAT32 ) { return _mm256_loadu_ps( static_cast<const float *>(_pvSrc) ); }
+			else {
+				const double * pdSrc = static_cast<const double *>(_pvSrc);
+				return _mm256_set_m128( _mm256_cvtpd_ps( _mm256_loadu_pd( pdSrc + 4 ) ), _mm256_cvtpd_ps( _mm256_loadu_pd( pdSrc ) ) );
+			}
+		}
+		template <Kernels::NN9_KERNEL_TYPE _ktType>
+		static inline void										StoreAs( void * _pvDst, Reg _rVal ) {
+			__m128i * pmDst = static_cast<__m128i *>(_pvDst);
+			if constexpr ( _ktType == Kernels::NN9_KT_INT8 ) {
+				const __m128i mVal = Pack16<true>( Truncate( _rVal, -128.0f, 127.0f ) );
+				_mm_storel_epi64( pmDst, _mm_packs_epi16( mVal, mVal ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT8 ) {
+				const __m128i mVal = Pack16<false>( Truncate( _rVal, 0.0f, 255.0f ) );
+				_mm_storel_epi64( pmDst, _mm_packus_epi16( mVal, mVal ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_INT16 ) { _mm_storeu_si128( pmDst, Pack16<true>( Truncate( _rVal, -32768.0f, 32767.0f ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT16 ) { _mm_storeu_si128( pmDst, Pack16<false>( Truncate( _rVal, 0.0f, 65535.0f ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_INT32 ) { _mm256_storeu_si256( static_cast<__m256i *>(_pvDst), Truncate( _rVal, -2147483648.0f, 2147483520.0f ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT32 ) {
+				// Values from 2^31 up are converted less 2^32, which gives the same bits.
+				const Reg rT = Trunc( _mm256_min_ps( _mm256_max_ps( _rVal, _mm256_setzero_ps() ), _mm256_set1_ps( 4294967040.0f ) ) );
+				const Reg rBig = _mm256_and_ps( _mm256_cmp_ps( rT, _mm256_set1_ps( 2147483648.0f ), _CMP_GE_OQ ), _mm256_set1_ps( 4294967296.0f ) );
+				_mm256_storeu_si256( static_cast<__m256i *>(_pvDst), _mm256_cvttps_epi32( _mm256_sub_ps( rT, rBig ) ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_FLOAT16 ) { _mm_storeu_si128( pmDst, Pack16<false>( FloatToHalf( _rVal ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_BFLOAT16 ) { _mm_storeu_si128( pmDst, Pack16<false>( _mm256_srli_epi32( _mm256_castps_si256( _rVal ), 16 ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_FLOAT32 ) { _mm256_storeu_ps( static_cast<float *>(_pvDst), _rVal ); }
+			else {
+				double * pdDst = static_cast<double *>(_pvDst);
+				_mm256_storeu_pd( pdDst, _mm256_cvtps_pd( _mm256_castps256_ps128( _rVal ) ) );
+				_mm256_storeu_pd( pdDst + 4, _mm256_cvtps_pd( _mm256_extractf128_ps( _rVal, 1 ) ) );
+			}
+		}
+		static inline void										StoreSr( uint16_t * _pui16Dst, Reg _rVal, uint32_t _ui32Key, uint32_t _ui32Idx ) {
+			__m256i mIdx = _mm256_add_epi32( _mm256_set1_epi32( int( _ui32Idx ) ), _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ) );
+			__m256i mX = _mm256_add_epi32( _mm256_mullo_epi32( mIdx, _mm256_set1_epi32( int( 0x9E3779B9U ) ) ), _mm256_set1_epi32( int( _ui32Key ) ) );
+			mX = _mm256_xor_si256( mX, _mm256_srli_epi32( mX, 16 ) );
+			mX = _mm256_mullo_epi32( mX, _mm256_set1_epi32( int( 0x85EBCA6BU ) ) );
+			mX = _mm256_xor_si256( mX, _mm256_srli_epi32( mX, 13 ) );
+			mX = _mm256_mullo_epi32( mX, _mm256_set1_epi32( int( 0xC2B2AE35U ) ) );
+			mX = _mm256_xor_si256( mX, _mm256_srli_epi32( mX, 16 ) );
+			__m256i mBits = _mm256_castps_si256( _rVal );
+			mBits = _mm256_or_si256( mBits, _mm256_and_si256( _mm256_castps_si256( _mm256_cmp_ps( _rVal, _rVal, _CMP_UNORD_Q ) ), _mm256_set1_epi32( 0x00400000 ) ) );
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(_pui16Dst), Pack16<false>( _mm256_srli_epi32( _mm256_add_epi32( mBits, _mm256_srli_epi32( mX, 16 ) ), 16 ) ) );
+		}
+	};
+
+	/** double registers for SimdKernels. */
+	struct NN9_F64 {
+		typedef double											Scalar;
+		typedef __m256d											Reg;
+		static constexpr size_t									Lanes = 4;
+
+		static inline Reg										Zero() { return _mm256_setzero_pd(); }
+		static inline Reg										Set1( Scalar _sVal ) { return _mm256_set1_pd( _sVal ); }
+		static inline Reg										Load( const Scalar * _psSrc ) { return _mm256_loadu_pd( _psSrc ); }
+		static inline void										Store( Scalar * _psDst, Reg _rVal ) { _mm256_storeu_pd( _psDst, _rVal ); }
+		static inline Reg										Add( Reg _rA, Reg _rB ) { return _mm256_add_pd( _rA, _rB ); }
+		static inline Reg										Sub( Reg _rA, Reg _rB ) { return _mm256_sub_pd( _rA, _rB ); }
+		static inline Reg										Mul( Reg _rA, Reg _rB ) { return _mm256_mul_pd( _rA, _rB ); }
+		static inline Reg										Div( Reg _rA, Reg _rB ) { return _mm256_div_pd( _rA, _rB ); }
+		static inline Reg										Fma( Reg _rA, Reg _rB, Reg _rC ) { return _mm256_fmadd_pd( _rA, _rB, _rC ); }
+		static inline Reg										Abs( Reg _rA ) { return _mm256_andnot_pd( _mm256_set1_pd( -0.0 ), _rA ); }
+		static inline Reg										Neg( Reg _rA ) { return _mm256_xor_pd( _rA, _mm256_set1_pd( -0.0 ) ); }
+		static inline Reg										Max( Reg _rAcc, Reg _rVal ) {
+			return _mm256_blendv_pd( _mm256_max_pd( _rVal, _rAcc ), _rVal, _mm256_cmp_pd( _rVal, _rVal, _CMP_UNORD_Q ) );
+		}
+		static inline Reg										Min( Reg _rAcc, Reg _rVal ) {
+			return _mm256_blendv_pd( _mm256_min_pd( _rVal, _rAcc ), _rVal, _mm256_cmp_pd( _rVal, _rVal, _CMP_UNORD_Q ) );
+		}
+		static inline Reg										Greater( Reg _rA, Reg _rB ) { return _mm256_max_pd( _rA, _rB ); }
+		static inline Reg										Lesser( Reg _rA, Reg _rB ) { return _mm256_min_pd( _rA, _rB ); }
+		static inline Reg										FiniteOrZero( Reg _rA ) {
+			return _mm256_and_pd( _rA, _mm256_cmp_pd( _rA, _mm256_set1_pd( -INFINITY ), _CMP_NEQ_UQ ) );
+		}
+		static inline Reg										Sqrt( Reg _rA ) { return _mm256_sqrt_pd( _rA ); }
+		static inline Reg										Ceil( Reg _rA ) { return _mm256_round_pd( _rA, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC ); }
+		static inline Reg										Floor( Reg _rA ) { return _mm256_round_pd( _rA, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC ); }
+		static inline Reg										Trunc( Reg _rA ) { return _mm256_round_pd( _rA, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC ); }
+		static inline Reg										RoundEven( Reg _rA ) { return _mm256_round_pd( _rA, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }
+		static inline Reg										Round( Reg _rA ) {
+			const Reg rT = Trunc( _rA );
+			const Reg rUp = _mm256_cmp_pd( Abs( _mm256_sub_pd( _rA, rT ) ), _mm256_set1_pd( 0.5 ), _CMP_GE_OQ );
+			return _mm256_blendv_pd( rT, _mm256_add_pd( rT, _mm256_or_pd( _mm256_set1_pd( 1.0 ), _mm256_and_pd( _rA, _mm256_set1_pd( -0.0 ) ) ) ), rUp );
+		}
+		static inline __m128i									Truncate( Reg _rA, Scalar _sMin, Scalar _sMax ) {
+			return _mm256_cvttpd_epi32( _mm256_min_pd( _mm256_max_pd( _rA, _mm256_set1_pd( _sMin ) ), _mm256_set1_pd( _sMax ) ) );
+		}
+		template <Kernels::NN9_KERNEL_TYPE _ktType>
+		static inline Reg										LoadAs( const void * _pvSrc ) {
+			const __m128i * pmSrc = static_cast<const __m128i *>(_pvSrc);
+			if constexpr ( _ktType == Kernels::NN9_KT_INT8 ) {
+				return _mm256_cvtepi32_pd( _mm_cvtepi8_epi32( _mm_cvtsi32_si128( SimdKernels::Read32( static_cast<const uint8_t *>(_pvSrc) ) ) ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT8 ) {
+				return _mm256_cvtepi32_pd( _mm_cvtepu8_epi32( _mm_cvtsi32_si128( SimdKernels::Read32( static_cast<const uint8_t *>(_pvSrc) ) ) ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_INT16 ) { return _mm256_cvtepi32_pd( _mm_cvtepi16_epi32( _mm_loadl_epi64( pmSrc ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT16 ) { return _mm256_cvtepi32_pd( _mm_cvtepu16_epi32( _mm_loadl_epi64( pmSrc ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_INT32 ) { return _mm256_cvtepi32_pd( _mm_loadu_si128( pmSrc ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT32 ) {
+				// Flipping the sign bit offsets the values by 2^31, which is added back exactly.
+				return _mm256_add_pd( _mm256_cvtepi32_pd( _mm_xor_si128( _mm_loadu_si128( pmSrc ), _mm_set1_epi32( int32_t( 0x80000000 ) ) ) ), _mm256_set1_pd( 2147483648.0 ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_FLOAT16 ) {
+				return _mm256_cvtps_pd( _mm256_castps256_ps128( HalfToFloat( _mm256_cvtepu16_epi32( _mm_loadl_epi64( pmSrc ) ) ) ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_BFLOAT16 ) {
+				return _mm256_cvtps_pd( _mm_castsi128_ps( _mm_slli_epi32( _mm_cvtepu16_epi32( _mm_loadl_epi64( pmSrc ) ), 16 ) ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_FLOAT32 ) { return _mm256_cvtps_pd( _mm_loadu_ps( static_cast<const float *>(_pvSrc) ) ); }
+			else { return _mm256_loadu_pd( static_cast<const double *>(_pvSrc) ); }
+		}
+		template <Kernels::NN9_KERNEL_TYPE _ktType>
+		static inline void										StoreAs( void * _pvDst, Reg _rVal ) {
+			__m128i * pmDst = static_cast<__m128i *>(_pvDst);
+			if constexpr ( _ktType == Kernels::NN9_KT_INT8 || _ktType == Kernels::NN9_KT_UINT8 ) {
+				__m128i mVal;
+				if constexpr ( _ktType == Kernels::NN9_KT_INT8 ) {
+					mVal = _mm_packs_epi32( Truncate( _rVal, -128.0, 127.0 ), _mm_setzero_si128() );
+					mVal = _mm_packs_epi16( mVal, mVal );
+				}
+				else {
+					mVal = _mm_packus_epi32( Truncate( _rVal, 0.0, 255.0 ), _mm_setzero_si128() );
+					mVal = _mm_packus_epi16( mVal, mVal );
+				}
+				const int32_t i32Val = _mm_cvtsi128_si32( mVal );
+				std::memcpy( _pvDst, &i32Val, sizeof( i32Val ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_INT16 ) { _mm_storel_epi64( pmDst, _mm_packs_epi32( Truncate( _rVal, -32768.0, 32767.0 ), _mm_setzero_si128() ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT16 ) { _mm_storel_epi64( pmDst, _mm_packus_epi32( Truncate( _rVal, 0.0, 65535.0 ), _mm_setzero_si128() ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_INT32 ) { _mm_storeu_si128( pmDst, Truncate( _rVal, -2147483648.0, 2147483647.0 ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT32 ) {
+				// Values from 2^31 up are converted less 2^32, which gives the same bits.
+				const Reg rT = Trunc( _mm256_min_pd( _mm256_max_pd( _rVal, _mm256_setzero_pd() ), _mm256_set1_pd( 4294967295.0 ) ) );
+				const Reg rBig = _mm256_and_pd( _mm256_cmp_pd( rT, _mm256_set1_pd( 2147483648.0 ), _CMP_GE_OQ ), _mm256_set1_pd( 4294967296.0 ) );
+				_mm_storeu_si128( pmDst, _mm256_cvttpd_epi32( _mm256_sub_pd( rT, rBig ) ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_FLOAT16 ) {
+				const __m256i mBits = FloatToHalf( _mm256_set_m128( _mm_setzero_ps(), _mm256_cvtpd_ps( _rVal ) ) );
+				_mm_storel_epi64( pmDst, _mm_packus_epi32( _mm256_castsi256_si128( mBits ), _mm_setzero_si128() ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_BFLOAT16 ) {
+				_mm_storel_epi64( pmDst, _mm_packus_epi32( _mm_srli_epi32( _mm_castps_si128( _mm256_cvtpd_ps( _rVal ) ), 16 ), _mm_setzero_si128() ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_FLOAT32 ) { _mm_storeu_ps( static_cast<float *>(_pvDst), _mm256_cvtpd_ps( _rVal ) ); }
+			else { _mm256_storeu_pd( static_cast<double *>(_pvDst), _rVal ); }
+		}
+	};
+
+	/**
+	 * int8_t registers for SimdKernels::GemmI8Tile().  pmaddubsw multiplies the bytes and adds adjacent pairs into 16 bits, and pmaddwd
+	 *	with 1s adds those pairs into 32 bits.
+	 *
+	 * \tparam _bSplit If true, A is split into high and low nibbles so that the 16-bit sums cannot saturate for weights outside [-64, 64].
+	 */
+	template <bool _bSplit>
+	struct NN9_I8 {
+		/** A broadcast group of A, whole or split into nibbles. */
+		struct NN9_A {
+			__m256i												mHi;									/**< The high nibbles, or the whole bytes if !_bSplit. */
+			__m256i												mLo;									/**< The low nibbles.  Unused if !_bSplit. */
+		};
+		typedef __m256i											Reg;
+		typedef NN9_A											AOp;
+		typedef __m256i											BOp;
+		static constexpr size_t									Lanes = 8;
+
+		static inline Reg										Zero() { return _mm256_setzero_si256(); }
+		static inline AOp										SetA( const uint8_t * _pui8A ) {
+			const __m256i mA = _mm256_set1_epi32( SimdKernels::Read32( _pui8A ) );
+			if constexpr ( _bSplit ) {
+				const __m256i mMask = _mm256_set1_epi8( 0x0F );
+				return { _mm256_and_si256( _mm256_srli_epi16( mA, 4 ), mMask ), _mm256_and_si256( mA, mMask ) };
+			}
+			else { return { mA, mA }; }
+		}
+		static inline BOp										LoadB( const int8_t * _pi8B ) { return _mm256_load_si256( reinterpret_cast<const __m256i *>(_pi8B) ); }
+		static inline Reg										Load( const int32_t * _pi32Src ) { return _mm256_loadu_si256( reinterpret_cast<const __m256i *>(_pi32Src) ); }
+		static inline void										Store( int32_t * _pi32Dst, Reg _rVal ) { _mm256_storeu_si256( reinterpret_cast<__m256i *>(_pi32Dst), _rVal ); }
+		static inline Reg										Add( Reg _rA, Reg _rB ) { return _mm256_add_epi32( _rA, _rB ); }
+		static inline Reg										Dp( Reg _rAcc, AOp _aA, BOp _bB ) {
+			if constexpr ( _bSplit ) {
+				// 16 * (hi * b) + (lo * b); the multiply by 16 is folded into pmaddwd.
+				const __m256i mHi = _mm256_madd_epi16( _mm256_maddubs_epi16( _aA.mHi, _bB ), _mm256_set1_epi16( 16 ) );
+				const __m256i mLo = _mm256_madd_epi16( _mm256_maddubs_epi16( _aA.mLo, _bB ), _mm256_set1_epi16( 1 ) );
+				return _mm256_add_epi32( _rAcc, _mm256_add_epi32( mHi, mLo ) );
+			}
+			else {
+				return _mm256_add_epi32( _rAcc, _mm256_madd_epi16( _mm256_maddubs_epi16( _aA.mHi, _bB ), _mm256_set1_epi16( 1 ) ) );
+			}
+		}
+	};
+
+	/**
+	 * bfloat16 pair registers for SimdKernels::DotBf16() and SimdKernels::GemmBf16Tile().  Pairs holds 16 bfloat16 values; each float
+	 *	lane adds the product of its odd pair members and then that of its even pair members, each rounded once, as vdpbf16ps does.
+	 *
+	 * \tparam _bDazFtz If true, denormal inputs are read as 0 and denormal results are flushed to 0, as vdpbf16ps does.
+	 */
+	template <bool _bDazFtz>
+	struct NN9_BF16 : public NN9_F32 {
+		typedef __m256i											Pairs;
+
+		static inline Pairs										LoadPairs( const uint16_t * _pui16Src ) { return _mm256_loadu_si256( reinterpret_cast<const __m256i *>(_pui16Src) ); }
+		static inline Pairs										Set1Pair( const uint16_t * _pui16Src ) {
+			return _mm256_set1_epi32( SimdKernels::Read32( reinterpret_cast<const uint8_t *>(_pui16Src) ) );
+		}
+		static inline Reg										Dp( Reg _rAcc, Pairs _pA, Pairs _pB ) {
+			const __m256i mHi = _mm256_set1_epi32( int32_t( 0xFFFF0000U ) );
+			__m256i mAcc = Flush( _mm256_castps_si256( _rAcc ) );
+			mAcc = Flush( _mm256_castps_si256( _mm256_fmadd_ps( _mm256_castsi256_ps( Flush( _mm256_and_si256( _pA, mHi ) ) ),
+				_mm256_castsi256_ps( Flush( _mm256_and_si256( _pB, mHi ) ) ), _mm256_castsi256_ps( mAcc ) ) ) );
+			mAcc = Flush( _mm256_castps_si256( _mm256_fmadd_ps( _mm256_castsi256_ps( Flush( _mm256_slli_epi32( _pA, 16 ) ) ),
+				_mm256_castsi256_ps( Flush( _mm256_slli_epi32( _pB, 16 ) ) ), _mm256_castsi256_ps( mAcc ) ) ) );
+			return _mm256_castsi256_ps( mAcc );
+		}
+		static inline __m256i									Flush( __m256i _mBits ) {
+			if constexpr ( _bDazFtz ) {
+				const __m256i mDenorm = _mm256_cmpeq_epi32( _mm256_and_si256( _mBits, _mm256_set1_epi32( 0x7F800000 ) ), _mm256_setzero_si256() );
+				return _mm256_blendv_epi8( _mBits, _mm256_and_si256( _mBits, _mm256_set1_epi32( int32_t( 0x80000000U ) ) ), mDenorm );
+			}
+			else { return _mBits; }
+		}
+	};
+
+	/**
+	 * Applies a SimdMath function to 8 floats at a time, finishing with the plain C++ kernel.
+	 *
+	 * \param _pfIn The input.
+	 * \param _pfOut The output.
+	 * \param _sTotal The number of elements.
+	 * \param _fSimd The function to call on each register.
+	 * \param _pfTail The kernel to call on the remaining elements.
+	 **/
+	template <typename _tSimd>
+	inline void UnaryF32( const float * _pfIn, float * _pfOut, size_t _sTotal, _tSimd _fSimd, void (*_pfTail)( const float *, float *, size_t ) ) {
+		size_t I = 0;
+		for ( ; I + 8 <= _sTotal; I += 8 ) { _mm256_storeu_ps( _pfOut + I, _fSimd( _mm256_loadu_ps( _pfIn + I ) ) ); }
+		if ( I < _sTotal ) { _pfTail( _pfIn + I, _pfOut + I, _sTotal - I ); }
+	}
+
+	/**
+	 * Applies a SimdMath function to 4 doubles at a time, finishing with the plain C++ kernel.
+	 *
+	 * \param _pdIn The input.
+	 * \param _pdOut The output.
+	 * \param _sTotal The number of elements.
+	 * \param _fSimd The function to call on each register.
+	 * \param _pfTail The kernel to call on the remaining elements.
+	 **/
+	template <typename _tSimd>
+	inline void UnaryF64( const double * _pdIn, double * _pdOut, size_t _sTotal, _tSimd _fSimd, void (*_pfTail)( const double *, double *, size_t ) ) {
+		size_t I = 0;
+		for ( ; I + 4 <= _sTotal; I += 4 ) { _mm256_storeu_pd( _pdOut + I, _fSimd( _mm256_loadu_pd( _pdIn + I ) ) ); }
+		if ( I < _sTotal ) { _pfTail( _pdIn + I, _pdOut + I, _sTotal - I ); }
+	}
+
+	/**
+	 * Loads 8 values to quantize as floats.
+	 *
+	 * \param _pfSrc The values.
+	 * \return Returns the values.
+	 **/
+	inline __m256 LoadReal( const float * _pfSrc ) { return _mm256_loadu_ps( _pfSrc ); }
+
+	/**
+	 * Loads 8 accumulators to quantize as floats.
+	 *
+	 * \param _pi32Src The accumulators.
+	 * \return Returns the accumulators converted to float.
+	 **/
+	inline __m256 LoadReal( const int32_t * _pi32Src ) { return _mm256_cvtepi32_ps( _mm256_loadu_si256( reinterpret_cast<const __m256i *>(_pi32Src) ) ); }
+
+	/**
+	 * Loads 8 quantized values as 32-bit integers.
+	 *
+	 * \tparam _tQ The quantized type: int8_t, uint8_t, or int32_t.
+	 * \param _ptSrc The values.
+	 * \return Returns the values widened to 32 bits.
+	 **/
+	template <typename _tQ>
+	inline __m256i Widen( const _tQ * _ptSrc ) {
+		if constexpr ( _tQ( -1 ) > _tQ( 0 ) ) { return _mm256_cvtepu8_epi32( _mm_loadl_epi64( reinterpret_cast<const __m128i *>(_ptSrc) ) ); }
+		else if constexpr ( sizeof( _tQ ) == 1 ) { return _mm256_cvtepi8_epi32( _mm_loadl_epi64( reinterpret_cast<const __m128i *>(_ptSrc) ) ); }
+		else { return _mm256_loadu_si256( reinterpret_cast<const __m256i *>(_ptSrc) ); }
+	}
+
+	/**
+	 * Quantizes 8 values: clamp( round( _ptIn[I] * _mScale * _pfScale[I] ) + _mZero ).
+	 *
+	 * \tparam _tSrc The source type: float or int32_t.
+	 * \tparam _bSigned If true, the output is int8_t, otherwise uint8_t.
+	 * \param _ptIn The values.
+	 * \param _pfScale The per-element multipliers, or nullptr.
+	 * \param _mScale The multiplier applied to every value.
+	 * \param _mLo The smallest scaled value, less the zero point.
+	 * \param _mHi The largest scaled value, less the zero point.
+	 * \param _mZero The zero point.
+	 * \return Returns the 8 quantized values in the low 8 bytes.
+	 **/
+	template <typename _tSrc, bool _bSigned>
+	inline __m128i QuantizeStep( const _tSrc * _ptIn, const float * _pfScale, __m256 _mScale, __m256 _mLo, __m256 _mHi, __m256i _mZero ) {
+		__m256 mVal = _mm256_mul_ps( LoadReal( _ptIn ), _mScale );
+		if ( _pfScale ) { mVal = _mm256_mul_ps( mVal, _mm256_loadu_ps( _pfScale ) ); }
+		// maxps returns its second operand for NaN, so NaN becomes the smallest value.
+		mVal = _mm256_min_ps( _mm256_max_ps( mVal, _mLo ), _mHi );
+		const __m256i mI32 = _mm256_add_epi32( _mm256_cvtps_epi32( mVal ), _mZero );
+		// The values are already in range, so the saturating packs only narrow them.
+		const __m128i mI16 = _mm_packs_epi32( _mm256_castsi256_si128( mI32 ), _mm256_extracti128_si256( mI32, 1 ) );
+		if constexpr ( _bSigned ) { return _mm_packs_epi16( mI16, mI16 ); }
+		else { return _mm_packus_epi16( mI16, mI16 ); }
+	}
+
+	// The kernels.  See Kernels::NN9_TABLE for what each computes.
+	void ExpF32( const float * _pfIn, float * _pfOut, size_t _sTotal ) {
+		UnaryF32( _pfIn, _pfOut, _sTotal, []( __m256 _rX ) { return SimdMath::Exp( _rX ); }, Kernels::ScalarExpF32 );
+	}
+
+	void LogF32( const float * _pfIn, float * _pfOut, size_t _sTotal ) {
+		UnaryF32( _pfIn, _pfOut, _sTotal, []( __m256 _rX ) { return SimdMath::Log( _rX ); }, Kernels::ScalarLogF32 );
+	}
+
+	void TanhF32( const float * _pfIn, float * _pfOut, size_t _sTotal ) {
+		UnaryF32( _pfIn, _pfOut, _sTotal, []( __m256 _rX ) { return SimdMath::Tanh( _rX ); }, Kernels::ScalarTanhF32 );
+	}
+
+	void ExpF64( const double * _pdIn, double * _pdOut, size_t _sTotal ) {
+		UnaryF64( _pdIn, _pdOut, _sTotal, []( __m256d _rX ) { return SimdMath::Exp( _rX ); }, Kernels::ScalarExpF64 );
+	}
+
+	void LogF64( const double * _pdIn, double * _pdOut, size_t _sTotal ) {
+		UnaryF64( _pdIn, _pdOut, _sTotal, []( __m256d _rX ) { return SimdMath::Log( _rX ); }, Kernels::ScalarLogF64 );
+	}
+
+	void TanhF64( const double * _pdIn, double * _pdOut, size_t _sTotal ) {
+		UnaryF64( _pdIn, _pdOut, _sTotal, []( __m256d _rX ) { return SimdMath::Tanh( _rX ); }, Kernels::ScalarTanhF64 );
+	}
+
+	void Bf16ToF32( const uint16_t * _pui16In, float * _pfOut, size_t _sTotal ) {
+		size_t I = 0;
+		for ( ; I + 8 <= _sTotal; I += 8 ) {
+			__m256i mBits = _mm256_cvtepu16_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i *>(_pui16In + I) ) );
+			_mm256_storeu_si256( reinterpret_cast<__m256i *>(_pfOut + I), _mm256_slli_epi32( mBits, 16 ) );
+		}
+		if ( I < _sTotal ) { Kernels::ScalarBf16ToF32( _pui16In + I, _pfOut + I, _sTotal - I ); }
+	}
+
+	void F32ToBf16( const float * _pfIn, uint16_t * _pui16Out, size_t _sTotal ) {
+		size_t I = 0;
+		for ( ; I + 8 <= _sTotal; I += 8 ) {
+			__m256i mBits = _mm256_srli_epi32( _mm256_castps_si256( _mm256_loadu_ps( _pfIn + I ) ), 16 );
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(_pui16Out + I), _mm_packus_epi32( _mm256_castsi256_si128( mBits ), _mm256_extracti128_si256( mBits, 1 ) ) );
+		}
+		if ( I < _sTotal ) { Kernels::ScalarF32ToBf16( _pfIn + I, _pui16Out + I, _sTotal - I ); }
+	}
+
+	void F32ToF64( const float * _pfIn, double * _pdOut, size_t _sTotal ) {
+		size_t I = 0;
+		for ( ; I + 4 <= _sTotal; I += 4 ) { _mm256_storeu_pd( _pdOut + I, _mm256_cvtps_pd( _mm_loadu_ps( _pfIn + I ) ) ); }
+		if ( I < _sTotal ) { Kernels::ScalarF32ToF64( _pfIn + I, _pdOut + I, _sTotal - I ); }
+	}
+
+	void F64ToF32( const double * _pdIn, float * _pfOut, size_t _sTotal ) {
+		size_t I = 0;
+		for ( ; I + 4 <= _sTotal; I += 4 ) { _mm_storeu_ps( _pfOut + I, _mm256_cvtpd_ps( _mm256_loadu_pd( _pdIn + I ) ) ); }
+		if ( I < _sTotal ) { Kernels::ScalarF64ToF32( _pdIn + I, _pfOut + I, _sTotal - I ); }
+	}
+
+	template <bool _bMax>
+	size_t ArgF32( const float * _pfIn, size_t _sTotal ) {
+		if ( _sTotal >= 8 ) {
+			// Each lane keeps the first extreme of its own indices.
+			__m256 mBest = _mm256_loadu_ps( _pfIn );
+			__m256i mIdx = _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ), mBestIdx = mIdx;
+			const __m256i mStep = _mm256_set1_epi32( 8 );
+			__m256 mNan = _mm256_cmp_ps( mBest, mBest, _CMP_UNORD_Q );
+			size_t I = 8;
+			for ( ; I + 8 <= _sTotal; I += 8 ) {
+				const __m256 mVal = _mm256_loadu_ps( _pfIn + I );
+				mIdx = _mm256_add_epi32( mIdx, mStep );
+				mNan = _mm256_or_ps( mNan, _mm256_cmp_ps( mVal, mVal, _CMP_UNORD_Q ) );
+				const __m256 mBetter = _mm256_cmp_ps( mVal, mBest, _bMax ? _CMP_GT_OQ : _CMP_LT_OQ );
+				mBest = _mm256_blendv_ps( mBest, mVal, mBetter );
+				mBestIdx = _mm256_castps_si256( _mm256_blendv_ps( _mm256_castsi256_ps( mBestIdx ), _mm256_castsi256_ps( mIdx ), mBetter ) );
+			}
+			// A NaN wins, so a run with one is searched again for the first.
+			if ( !_mm256_movemask_ps( mNan ) ) {
+				float fLanes[8];
+				int32_t i32Lanes[8];
+				_mm256_storeu_ps( fLanes, mBest );
+				_mm256_storeu_si256( reinterpret_cast<__m256i *>(i32Lanes), mBestIdx );
+				const size_t sLane = SimdKernels::ArgLanes<_bMax>( fLanes, i32Lanes, 8 );
+				return SimdKernels::ArgFinish<_bMax>( _pfIn, I, _sTotal, fLanes[sLane], size_t( i32Lanes[sLane] ) );
+			}
+		}
+		return SimdKernels::ArgFinish<_bMax>( _pfIn, 1, _sTotal, _pfIn[0], 0 );
+	}
+
+	template <bool _bMax>
+	void ArgRowF32( const float * _pfRow, float * _pfBest, uint32_t * _pui32Idx, uint32_t _ui32Row, size_t _sTotal ) {
+		const __m256i mRow = _mm256_set1_epi32( int32_t( _ui32Row ) );
+		size_t J = 0;
+		for ( ; J + 8 <= _sTotal; J += 8 ) {
+			const __m256 mVal = _mm256_loadu_ps( _pfRow + J );
+			const __m256 mBest = _mm256_loadu_ps( _pfBest + J );
+			const __m256 mBetter = _mm256_or_ps( _mm256_cmp_ps( mVal, mBest, _bMax ? _CMP_GT_OQ : _CMP_LT_OQ ),
+				_mm256_and_ps( _mm256_cmp_ps( mVal, mVal, _CMP_UNORD_Q ), _mm256_cmp_ps( mBest, mBest, _CMP_ORD_Q ) ) );
+			_mm256_storeu_ps( _pfBest + J, _mm256_blendv_ps( mBest, mVal, mBetter ) );
+			_mm256_maskstore_epi32( reinterpret_cast<int *>(_pui32Idx + J), _mm256_castps_si256( mBetter ), mRow );
+		}
+		SimdKernels::ArgRowFinish<_bMax>( _pfRow, _pfBest, _pui32Idx, _ui32Row, J, _sTotal );
+	}
+	template <typename _tSrc, bool _bSigned>
+	void QuantizeQ( const float * _pfScale, const _tSrc * _ptIn, void * _pvOut, size_t _sTotal, float _fScale, int32_t _i32Zero ) {
+		const __m256 mScale = _mm256_set1_ps( _fScale );
+		const __m256 mLo = _mm256_set1_ps( float( (_bSigned ? -127 : 0) - _i32Zero ) ), mHi = _mm256_set1_ps( float( (_bSigned ? 127 : 255) - _i32Zero ) );
+		const __m256i mZero = _mm256_set1_epi32( _i32Zero );
+		uint8_t * pui8Out = static_cast<uint8_t *>(_pvOut);
+		size_t I = 0;
+		for ( ; I + 8 <= _sTotal; I += 8 ) {
+			_mm_storel_epi64( reinterpret_cast<__m128i *>(pui8Out + I),
+				QuantizeStep<_tSrc, _bSigned>( _ptIn + I, _pfScale ? _pfScale + I : nullptr, mScale, mLo, mHi, mZero ) );
+		}
+		if ( I < _sTotal ) {
+			// The last values go through a padded register so that they round as the others do.
+			_tSrc tIn[8] = {};
+			float fScale[8] = {};
+			uint8_t ui8Out[16];
+			for ( size_t J = I; J < _sTotal; ++J ) {
+				tIn[J-I] = _ptIn[J];
+				if ( _pfScale ) { fScale[J-I] = _pfScale[J]; }
+			}
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(ui8Out), QuantizeStep<_tSrc, _bSigned>( tIn, _pfScale ? fScale : nullptr, mScale, mLo, mHi, mZero ) );
+			for ( size_t J = I; J < _sTotal; ++J ) { pui8Out[J] = ui8Out[J-I]; }
+		}
+	}
+
+	template <typename _tQ>
+	void DequantizeQ( const void * _pvIn, float * _pfOut, size_t _sTotal, float _fScale, int32_t _i32Zero ) {
+		const _tQ * ptIn = static_cast<const _tQ *>(_pvIn);
+		const __m256 mScale = _mm256_set1_ps( _fScale );
+		const __m256i mZero = _mm256_set1_epi32( _i32Zero );
+		size_t I = 0;
+		for ( ; I + 8 <= _sTotal; I += 8 ) {
+			_mm256_storeu_ps( _pfOut + I, _mm256_mul_ps( _mm256_cvtepi32_ps( _mm256_sub_epi32( Widen( ptIn + I ), mZero ) ), mScale ) );
+		}
+		for ( ; I < _sTotal; ++I ) { _pfOut[I] = float( int32_t( ptIn[I] ) - _i32Zero ) * _fScale; }
+	}
+}	// namespace
+#endif	// #if defined( __AVX2__ ) && (defined( __FMA__ ) || defined( _MSC_VER ))
+
+	// == Functions.
+	/**
+	 * Fills a table with the AVX2 kernels.
+	 *
+	 * \param _tTable The table to fill.
+	 * \return Returns false if the file was not compiled with AVX2 and FMA.
+	 **/
+	bool Kernels::FillAvx2( NN9_TABLE &_tTable ) {
+#if defined( __AVX2__ ) && (defined( __FMA__ ) || defined( _MSC_VER ))
+		_tTable.pfExpF32 = ExpF32;
+		_tTable.pfLogF32 = LogF32;
+		_tTable.pfTanhF32 = TanhF32;
+		_tTable.pfExpF64 = ExpF64;
+		_tTable.pfLogF64 = LogF64;
+		_tTable.pfTanhF64 = TanhF64;
+		_tTable.pfBf16ToF32 = Bf16ToF32;
+		_tTable.pfF32ToBf16 = F32ToBf16;
+		_tTable.pfF32ToF64 = F32ToF64;
+		_tTable.pfF64ToF32 = F64ToF32;
+		SimdKernels::Fill<NN9_F32, NN9_F64, NN9_KG_AVX2_MR, NN9_KG_AVX2_NR_F32, NN9_KG_AVX2_NR_F64>( _tTable, NN9_KI_AVX2 );
+		_tTable.pfArgF32[NN9_KR_MAX] = ArgF32<true>;
+		_tTable.pfArgF32[NN9_KR_MIN] = ArgF32<false>;
+		_tTable.pfArgRowF32[NN9_KR_MAX] = ArgRowF32<true>;
+		_tTable.pfArgRowF32[NN9_KR_MIN] = ArgRowF32<false>;
+		_tTable.pfGemmI8[NN9_KQ_AVX2] = SimdKernels::GemmI8Tile<NN9_I8<false>, NN9_KG_I8_AVX2_MR, NN9_KG_I8_AVX2_NR / 8>;
+		_tTable.pfGemmI8[NN9_KQ_AVX2_SPLIT] = SimdKernels::GemmI8Tile<NN9_I8<true>, NN9_KG_I8_AVX2_MR, NN9_KG_I8_AVX2_NR / 8>;
+		_tTable.pfDotBf16[NN9_KP_EMULATED] = SimdKernels::DotBf16<NN9_BF16<true>>;
+		_tTable.pfDotBf16[NN9_KP_WIDEN] = SimdKernels::DotBf16<NN9_BF16<false>>;
+		_tTable.pfGemmBf16[NN9_KP_EMULATED] = SimdKernels::GemmBf16Tile<NN9_BF16<true>, NN9_KG_AVX2_MR, NN9_KG_AVX2_NR_F32 / 8>;
+		_tTable.pfQuantizeF32[NN9_KT_INT8] = QuantizeQ<float, true>;
+		_tTable.pfQuantizeF32[NN9_KT_UINT8] = QuantizeQ<float, false>;
+		_tTable.pfQuantizeI32[NN9_KT_INT8] = QuantizeQ<int32_t, true>;
+		_tTable.pfQuantizeI32[NN9_KT_UINT8] = QuantizeQ<int32_t, false>;
+		_tTable.pfDequantize[NN9_KT_INT8] = DequantizeQ<int8_t>;
+		_tTable.pfDequantize[NN9_KT_UINT8] = DequantizeQ<uint8_t>;
+		_tTable.pfDequantize[NN9_KT_INT32] = DequantizeQ<int32_t>;
+		_tTable.pfConvF32 = SimdKernels::ConvTile<NN9_F32, NN9_KC_AVX2_COLS>;
+		_tTable.pfConvF64 = SimdKernels::ConvTile<NN9_F64, NN9_KC_AVX2_COLS>;
+		_tTable.kiConv = NN9_KI_AVX2;
+		return true;
+#else
+		static_cast<void>(_tTable);
+		return false;
+#endif	// #if defined( __AVX2__ ) && (defined( __FMA__ ) || defined( _MSC_VER ))
+	}
+
+}	// namespace nn9
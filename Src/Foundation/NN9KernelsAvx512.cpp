@@ -0,0 +1,538 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: The AVX-512 kernels.  Compile this file with AVX-512F enabled (/arch:AVX512 on MSVC; -mavx512f on GCC and Clang).
+ *	Nothing outside of NN9SimdMath.h, NN9KernelsSimd.h, and the system headers may be included here, and everything but
+ *	Kernels::FillAvx512() stays in an anonymous namespace (see Kernels).
+ */
+
+#include "NN9Kernels.h"
+#define NN9_SIMDMATH_LOCAL
+#include "NN9SimdMath.h"
+#include "NN9KernelsSimd.h"
+
+
+namespace nn9 {
+
+#ifdef __AVX512F__
+namespace {
+
+	/**
+	 * Narrows 16 floats to float16 as float16::FloatToUint16() does.  _mm512_cvtps_ph() rounds ties to even, which float16 does not.
+	 *
+	 * \param _mVal The floats.
+	 * \return Returns the float16 bits, zero-extended to 32 bits.
+	 **/
+	inline __m512i FloatToHalf( __m512 _mVal ) {
+		const __m512i mBits = _mm512_add_epi32( _mm512_castps_si512( _mVal ), _mm512_set1_epi32( 0x1000 ) );
+		const __m512i mExpo = _mm512_srli_epi32( _mm512_and_si512( mBits, _mm512_set1_epi32( 0x7F800000 ) ), 23 );
+		const __m512i mMant = _mm512_and_si512( mBits, _mm512_set1_epi32( 0x007FFFFF ) );
+
+		// Normal results, then subnormal results, then overflow.
+		const __m512i mNorm = _mm512_maskz_mov_epi32( _mm512_cmpgt_epi32_mask( mExpo, _mm512_set1_epi32( 112 ) ),
+			_mm512_or_si512( _mm512_and_si512( _mm512_slli_epi32( _mm512_sub_epi32( mExpo, _mm512_set1_epi32( 112 ) ), 10 ), _mm512_set1_epi32( 0x7C00 ) ),
+			_mm512_srli_epi32( mMant, 13 ) ) );
+		const __m512i mSub = _mm512_maskz_mov_epi32( _mm512_cmplt_epi32_mask( mExpo, _mm512_set1_epi32( 113 ) ) & _mm512_cmpgt_epi32_mask( mExpo, _mm512_set1_epi32( 101 ) ),
+			_mm512_srli_epi32( _mm512_add_epi32( _mm512_srlv_epi32( _mm512_add_epi32( mMant, _mm512_set1_epi32( 0x007FF000 ) ),
+			_mm512_sub_epi32( _mm512_set1_epi32( 125 ), mExpo ) ), _mm512_set1_epi32( 1 ) ), 1 ) );
+		__m512i mRet = _mm512_or_si512( _mm512_srli_epi32( _mm512_and_si512( mBits, _mm512_set1_epi32( int32_t( 0x80000000 ) ) ), 16 ), _mm512_or_si512( mNorm, mSub ) );
+		mRet = _mm512_mask_or_epi32( mRet, _mm512_cmpgt_epi32_mask( mExpo, _mm512_set1_epi32( 143 ) ), mRet, _mm512_set1_epi32( 0x7FFF ) );
+
+		// Everything that reached the infinity exponent but was not NaN becomes infinity.
+		const __mmask16 mInf = _mm512_cmpeq_epi32_mask( _mm512_and_si512( mRet, _mm512_set1_epi32( 0x7C00 ) ), _mm512_set1_epi32( 0x7C00 ) ) &
+			_mm512_cmp_ps_mask( _mVal, _mVal, _CMP_ORD_Q );
+		return _mm512_mask_or_epi32( mRet, mInf, _mm512_and_si512( mRet, _mm512_set1_epi32( 0x8000 ) ), _mm512_set1_epi32( 0x7C00 ) );
+	}
+
+	/** float registers for SimdKernels. */
+	struct NN9_F32 {
+		typedef float											Scalar;
+		typedef __m512											Reg;
+		static constexpr size_t									Lanes = 16;
+
+		static inline Reg										Zero() { return _mm512_setzero_ps(); }
+		static inline Reg										Set1( Scalar _sVal ) { return _mm512_set1_ps( _sVal ); }
+		static inline Reg										Load( const Scalar * _psSrc ) { return _mm512_loadu_ps( _psSrc ); }
+		static inline void										Store( Scalar * _psDst, Reg _rVal ) { _mm512_storeu_ps( _psDst, _rVal ); }
+		static inline Reg										Add( Reg _rA, Reg _rB ) { return _mm512_add_ps( _rA, _rB ); }
+		static inline Reg										Sub( Reg _rA, Reg _rB ) { return _mm512_sub_ps( _rA, _rB ); }
+		static inline Reg										Mul( Reg _rA, Reg _rB ) { return _mm512_mul_ps( _rA, _rB ); }
+		static inline Reg										Div( Reg _rA, Reg _rB ) { return _mm512_div_ps( _rA, _rB ); }
+		static inline Reg										Fma( Reg _rA, Reg _rB, Reg _rC ) { return _mm512_fmadd_ps( _rA, _rB, _rC ); }
+		static inline Reg										Abs( Reg _rA ) { return _mm512_abs_ps( _rA ); }
+		static inline Reg										Neg( Reg _rA ) { return _mm512_castsi512_ps( _mm512_xor_si512( _mm512_castps_si512( _rA ), _mm512_set1_epi32( int32_t( 0x80000000 ) ) ) ); }
+		static inline Reg										Max( Reg _rAcc, Reg _rVal ) {
+			return _mm512_mask_mov_ps( _mm512_max_ps( _rVal, _rAcc ), _mm512_cmp_ps_mask( _rVal, _rVal, _CMP_UNORD_Q ), _rVal );
+		}
+		static inline Reg										Min( Reg _rAcc, Reg _rVal ) {
+			return _mm512_mask_mov_ps( _mm512_min_ps( _rVal, _rAcc ), _mm512_cmp_ps_mask( _rVal, _rVal, _CMP_UNORD_Q ), _rVal );
+		}
+		static inline Reg										Greater( Reg _rA, Reg _rB ) { return _mm512_max_ps( _rA, _rB ); }
+		static inline Reg										Lesser( Reg _rA, Reg _rB ) { return _mm512_min_ps( _rA, _rB ); }
+		static inline Reg										FiniteOrZero( Reg _rA ) {
+			return _mm512_maskz_mov_ps( _mm512_cmp_ps_mask( _rA, _mm512_set1_ps( -INFINITY ), _CMP_NEQ_UQ ), _rA );
+		}
+		static inline Reg										Sqrt( Reg _rA ) { return _mm512_sqrt_ps( _rA ); }
+		static inline Reg										Ceil( Reg _rA ) { return _mm512_roundscale_ps( _rA, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC ); }
+		static inline Reg										Floor( Reg _rA ) { return _mm512_roundscale_ps( _rA, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC ); }
+		static inline Reg										Trunc( Reg _rA ) { return _mm512_roundscale_ps( _rA, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC ); }
+		static inline Reg										RoundEven( Reg _rA ) { return _mm512_roundscale_ps( _rA, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }
+		static inline Reg										Round( Reg _rA ) {
+			// Halfway cases away from 0, as std::round().
+			const Reg rT = Trunc( _rA );
+			const __mmask16 mUp = _mm512_cmp_ps_mask( Abs( _mm512_sub_ps( _rA, rT ) ), _mm512_set1_ps( 0.5f ), _CMP_GE_OQ );
+			const Reg rOne = _mm512_castsi512_ps( _mm512_or_si512( _mm512_castps_si512( _mm512_set1_ps( 1.0f ) ),
+				_mm512_and_si512( _mm512_castps_si512( _rA ), _mm512_set1_epi32( int32_t( 0x80000000 ) ) ) ) );
+			return _mm512_mask_add_ps( rT, mUp, rT, rOne );
+		}
+		static inline __m512i									Truncate( Reg _rA, Scalar _sMin, Scalar _sMax ) {
+			return _mm512_cvttps_epi32( _mm512_min_ps( _mm512_max_ps( _rA, _mm512_set1_ps( _sMin ) ), _mm512_set1_ps( _sMax ) ) );
+		}
+		template <Kernels::NN9_KERNEL_TYPE _ktType>
+		static inline Reg										LoadAs( const void * _pvSrc ) {
+			const __m128i * pmSrc = static_cast<const __m128i *>(_pvSrc);
+			const __m256i * pmSrc256 = static_cast<const __m256i *>(_pvSrc);
+			if constexpr ( _ktType == Kernels::NN9_KT_INT8 ) { return _mm512_cvtepi32_ps( _mm512_cvtepi8_epi32( _mm_loadu_si128( pmSrc ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT8 ) { return _mm512_cvtepi32_ps( _mm512_cvtepu8_epi32( _mm_loadu_si128( pmSrc ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_INT16 ) { return _mm512_cvtepi32_ps( _mm512_cvtepi16_epi32( _mm256_loadu_si256( pmSrc256 ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT16 ) { return _mm512_cvtepi32_ps( _mm512_cvtepu16_epi32( _mm256_loadu_si256( pmSrc256 ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_INT32 ) { return _mm512_cvtepi32_ps( _mm512_loadu_si512( _pvSrc ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT32 ) { return _mm512_cvtepu32_ps( _mm512_loadu_si512( _pvSrc ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_FLOAT16 ) { return _mm512_cvtph_ps( _mm256_loadu_si256( pmSrc256 ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_BFLOAT16 ) { return _mm512_castsi512_ps( _mm512_slli_epi32( _mm512_cvtepu16_epi32( _mm256_loadu_si256( pmSrc256 ) ), 16 ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_FLOAT32 ) { return _mm512_loadu_ps( _pvSrc ); }
+			else {
+				const double * pdSrc = static_cast<const double *>(_pvSrc);
+				const __m256d mLo = _mm256_castps_pd( _mm512_cvtpd_ps( _mm512_loadu_pd( pdSrc ) ) );
+				const __m256d mHi = _mm256_castps_pd( _mm512_cvtpd_ps( _mm512_loadu_pd( pdSrc + 8 ) ) );
+				return _mm512_castpd_ps( _mm512_insertf64x4( _mm512_castpd256_pd512( mLo ), mHi, 1 ) );
+			}
+		}
+		template <Kernels::NN9_KERNEL_TYPE _ktType>
+		static inline void										StoreAs( void * _pvDst, Reg _rVal ) {
+			__m128i * pmDst = static_cast<__m128i *>(_pvDst);
+			__m256i * pmDst256 = static_cast<__m256i *>(_pvDst);
+			if constexpr ( _ktType == Kernels::NN9_KT_INT8 ) { _mm_storeu_si128( pmDst, _mm512_cvtepi32_epi8( Truncate( _rVal, -128.0f, 127.0f ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT8 ) { _mm_storeu_si128( pmDst, _mm512_cvtepi32_epi8( Truncate( _rVal, 0.0f, 255.0f ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_INT16 ) { _mm256_storeu_si256( pmDst256, _mm512_cvtepi32_epi16( Truncate( _rVal, -32768.0f, 32767.0f ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT16 ) { _mm256_storeu_si256( pmDst256, _mm512_cvtepi32_epi16( Truncate( _rVal, 0.0f, 65535.0f ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_INT32 ) { _mm512_storeu_si512( _pvDst, Truncate( _rVal, -2147483648.0f, 2147483520.0f ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT32 ) {
+				_mm512_storeu_si512( _pvDst, _mm512_cvttps_epu32( _mm512_min_ps( _mm512_max_ps( _rVal, _mm512_setzero_ps() ), _mm512_set1_ps( 4294967040.0f ) ) ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_FLOAT16 ) { _mm256_storeu_si256( pmDst256, _mm512_cvtepi32_epi16( FloatToHalf( _rVal ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_BFLOAT16 ) {
+				_mm256_storeu_si256( pmDst256, _mm512_cvtepi32_epi16( _mm512_srli_epi32( _mm512_castps_si512( _rVal ), 16 ) ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_FLOAT32 ) { _mm512_storeu_ps( _pvDst, _rVal ); }
+			else {
+				double * pdDst = static_cast<double *>(_pvDst);
+				_mm512_storeu_pd( pdDst, _mm512_cvtps_pd( _mm512_castps512_ps256( _rVal ) ) );
+				_mm512_storeu_pd( pdDst + 8, _mm512_cvtps_pd( _mm256_castpd_ps( _mm512_extractf64x4_pd( _mm512_castps_pd( _rVal ), 1 ) ) ) );
+			}
+		}
+		static inline void										StoreSr( uint16_t * _pui16Dst, Reg _rVal, uint32_t _ui32Key, uint32_t _ui32Idx ) {
+			__m512i mIdx = _mm512_add_epi32( _mm512_set1_epi32( int( _ui32Idx ) ), _mm512_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 ) );
+			__m512i mX = _mm512_add_epi32( _mm512_mullo_epi32( mIdx, _mm512_set1_epi32( int( 0x9E3779B9U ) ) ), _mm512_set1_epi32( int( _ui32Key ) ) );
+			mX = _mm512_xor_si512( mX, _mm512_srli_epi32( mX, 16 ) );
+			mX = _mm512_mullo_epi32( mX, _mm512_set1_epi32( int( 0x85EBCA6BU ) ) );
+			mX = _mm512_xor_si512( mX, _mm512_srli_epi32( mX, 13 ) );
+			mX = _mm512_mullo_epi32( mX, _mm512_set1_epi32( int( 0xC2B2AE35U ) ) );
+			mX = _mm512_xor_si512( mX, _mm512_srli_epi32( mX, 16 ) );
+			__m512i mBits = _mm512_castps_si512( _rVal );
+			mBits = _mm512_mask_or_epi32( mBits, _mm512_cmp_ps_mask( _rVal, _rVal, _CMP_UNORD_Q ), mBits, _mm512_set1_epi32( 0x00400000 ) );
+			mBits = _mm512_srli_epi32( _mm512_add_epi32( mBits, _mm512_srli_epi32( mX, 16 ) ), 16 );
+			_mm256_storeu_si256( reinterpret_cast<__m256i *>(_pui16Dst), _mm512_cvtepi32_epi16( mBits ) );
+		}
+	};
+
+	/** double registers for SimdKernels. */
+	struct NN9_F64 {
+		typedef double											Scalar;
+		typedef __m512d											Reg;
+		static constexpr size_t									Lanes = 8;
+
+		static inline Reg										Zero() { return _mm512_setzero_pd(); }
+		static inline Reg										Set1( Scalar _sVal ) { return _mm512_set1_pd( _sVal ); }
+		static inline Reg										Load( const Scalar * _psSrc ) { return _mm512_loadu_pd( _psSrc ); }
+		static inline void										Store( Scalar * _psDst, Reg _rVal ) { _mm512_storeu_pd( _psDst, _rVal ); }
+		static inline Reg										Add( Reg _rA, Reg _rB ) { return _mm512_add_pd( _rA, _rB ); }
+		static inline Reg										Sub( Reg _rA, Reg _rB ) { return _mm512_sub_pd( _rA, _rB ); }
+		static inline Reg										Mul( Reg _rA, Reg _rB ) { return _mm512_mul_pd( _rA, _rB ); }
+		static inline Reg										Div( Reg _rA, Reg _rB ) { return _mm512_div_pd( _rA, _rB ); }
+		static inline Reg										Fma( Reg _rA, Reg _rB, Reg _rC ) { return _mm512_fmadd_pd( _rA, _rB, _rC ); }
+		static inline Reg										Abs( Reg _rA ) { return _mm512_abs_pd( _rA ); }
+		static inline Reg										Neg( Reg _rA ) { return _mm512_castsi512_pd( _mm512_xor_si512( _mm512_castpd_si512( _rA ), _mm512_set1_epi64( int64_t( 0x8000000000000000ULL ) ) ) ); }
+		static inline Reg										Max( Reg _rAcc, Reg _rVal ) {
+			return _mm512_mask_mov_pd( _mm512_max_pd( _rVal, _rAcc ), _mm512_cmp_pd_mask( _rVal, _rVal, _CMP_UNORD_Q ), _rVal );
+		}
+		static inline Reg										Min( Reg _rAcc, Reg _rVal ) {
+			return _mm512_mask_mov_pd( _mm512_min_pd( _rVal, _rAcc ), _mm512_cmp_pd_mask( _rVal, _rVal, _CMP_UNORD_Q ), _rVal );
+		}
+		static inline Reg										Greater( Reg _rA, Reg _rB ) { return _mm512_max_pd( _rA, _rB ); }
+		static inline Reg										Lesser( Reg _rA, Reg _rB ) { return _mm512_min_pd( _rA, _rB ); }
+		static inline Reg										FiniteOrZero( Reg _rA ) {
+			return _mm512_maskz_mov_pd( _mm512_cmp_pd_mask( _rA, _mm512_set1_pd( -INFINITY ), _CMP_NEQ_UQ ), _rA );
+		}
+		static inline Reg										Sqrt( Reg _rA ) { return _mm512_sqrt_pd( _rA ); }
+		static inline Reg										Ceil( Reg _rA ) { return _mm512_roundscale_pd( _rA, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC ); }
+		static inline Reg										Floor( Reg _rA ) { return _mm512_roundscale_pd( _rA, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC ); }
+		static inline Reg										Trunc( Reg _rA ) { return _mm512_roundscale_pd( _rA, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC ); }
+		static inline Reg										RoundEven( Reg _rA ) { return _mm512_roundscale_pd( _rA, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }
+		static inline Reg										Round( Reg _rA ) {
+			const Reg rT = Trunc( _rA );
+			const __mmask8 mUp = _mm512_cmp_pd_mask( Abs( _mm512_sub_pd( _rA, rT ) ), _mm512_set1_pd( 0.5 ), _CMP_GE_OQ );
+			const Reg rOne = _mm512_castsi512_pd( _mm512_or_si512( _mm512_castpd_si512( _mm512_set1_pd( 1.0 ) ),
+				_mm512_and_si512( _mm512_castpd_si512( _rA ), _mm512_set1_epi64( int64_t( 0x8000000000000000ULL ) ) ) ) );
+			return _mm512_mask_add_pd( rT, mUp, rT, rOne );
+		}
+		static inline __m256i									Truncate( Reg _rA, Scalar _sMin, Scalar _sMax ) {
+			return _mm512_cvttpd_epi32( _mm512_min_pd( _mm512_max_pd( _rA, _mm512_set1_pd( _sMin ) ), _mm512_set1_pd( _sMax ) ) );
+		}
+		template <Kernels::NN9_KERNEL_TYPE _ktType>
+		static inline Reg										LoadAs( const void * _pvSrc ) {
+			const __m128i * pmSrc = static_cast<const __m128i *>(_pvSrc);
+			if constexpr ( _ktType == Kernels::NN9_KT_INT8 ) { return _mm512_cvtepi32_pd( _mm256_cvtepi8_epi32( _mm_loadl_epi64( pmSrc ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT8 ) { return _mm512_cvtepi32_pd( _mm256_cvtepu8_epi32( _mm_loadl_epi64( pmSrc ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_INT16 ) { return _mm512_cvtepi32_pd( _mm256_cvtepi16_epi32( _mm_loadu_si128( pmSrc ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT16 ) { return _mm512_cvtepi32_pd( _mm256_cvtepu16_epi32( _mm_loadu_si128( pmSrc ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_INT32 ) { return _mm512_cvtepi32_pd( _mm256_loadu_si256( static_cast<const __m256i *>(_pvSrc) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT32 ) { return _mm512_cvtepu32_pd( _mm256_loadu_si256( static_cast<const __m256i *>(_pvSrc) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_FLOAT16 ) {
+				return _mm512_cvtps_pd( _mm512_castps512_ps256( _mm512_cvtph_ps( _mm256_castsi128_si256( _mm_loadu_si128( pmSrc ) ) ) ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_BFLOAT16 ) {
+				return _mm512_cvtps_pd( _mm256_castsi256_ps( _mm256_slli_epi32( _mm256_cvtepu16_epi32( _mm_loadu_si128( pmSrc ) ), 16 ) ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_FLOAT32 ) { return _mm512_cvtps_pd( _mm256_loadu_ps( static_cast<const float *>(_pvSrc) ) ); }
+			else { return _mm512_loadu_pd( _pvSrc ); }
+		}
+		template <Kernels::NN9_KERNEL_TYPE _ktType>
+		static inline void										StoreAs( void * _pvDst, Reg _rVal ) {
+			__m128i * pmDst = static_cast<__m128i *>(_pvDst);
+			if constexpr ( _ktType == Kernels::NN9_KT_INT8 ) { _mm_storel_epi64( pmDst, _mm512_cvtepi32_epi8( _mm512_castsi256_si512( Truncate( _rVal, -128.0, 127.0 ) ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT8 ) { _mm_storel_epi64( pmDst, _mm512_cvtepi32_epi8( _mm512_castsi256_si512( Truncate( _rVal, 0.0, 255.0 ) ) ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_INT16 ) {
+				_mm_storeu_si128( pmDst, _mm256_castsi256_si128( _mm512_cvtepi32_epi16( _mm512_castsi256_si512( Truncate( _rVal, -32768.0, 32767.0 ) ) ) ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT16 ) {
+				_mm_storeu_si128( pmDst, _mm256_castsi256_si128( _mm512_cvtepi32_epi16( _mm512_castsi256_si512( Truncate( _rVal, 0.0, 65535.0 ) ) ) ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_INT32 ) { _mm256_storeu_si256( static_cast<__m256i *>(_pvDst), Truncate( _rVal, -2147483648.0, 2147483647.0 ) ); }
+			else if constexpr ( _ktType == Kernels::NN9_KT_UINT32 ) {
+				_mm256_storeu_si256( static_cast<__m256i *>(_pvDst), _mm512_cvttpd_epu32( _mm512_min_pd( _mm512_max_pd( _rVal, _mm512_setzero_pd() ), _mm512_set1_pd( 4294967295.0 ) ) ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_FLOAT16 ) {
+				const __m512 mVal = _mm512_castpd_ps( _mm512_insertf64x4( _mm512_setzero_pd(), _mm256_castps_pd( _mm512_cvtpd_ps( _rVal ) ), 0 ) );
+				_mm_storeu_si128( pmDst, _mm256_castsi256_si128( _mm512_cvtepi32_epi16( FloatToHalf( mVal ) ) ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_BFLOAT16 ) {
+				const __m256i mBits = _mm256_srli_epi32( _mm256_castps_si256( _mm512_cvtpd_ps( _rVal ) ), 16 );
+				_mm_storeu_si128( pmDst, _mm_packus_epi32( _mm256_castsi256_si128( mBits ), _mm256_extracti128_si256( mBits, 1 ) ) );
+			}
+			else if constexpr ( _ktType == Kernels::NN9_KT_FLOAT32 ) { _mm256_storeu_ps( static_cast<float *>(_pvDst), _mm512_cvtpd_ps( _rVal ) ); }
+			else { _mm512_storeu_pd( _pvDst, _rVal ); }
+		}
+	};
+
+	/**
+	 * bfloat16 pair registers for SimdKernels::DotBf16() and SimdKernels::GemmBf16Tile().  Pairs holds 32 bfloat16 values; each float
+	 *	lane adds the product of its odd pair members and then that of its even pair members, each rounded once, as vdpbf16ps does.
+	 *
+	 * \tparam _bDazFtz If true, denormal inputs are read as 0 and denormal results are flushed to 0, as vdpbf16ps does.
+	 */
+	template <bool _bDazFtz>
+	struct NN9_BF16 : public NN9_F32 {
+		typedef __m512i											Pairs;
+
+		static inline Pairs										LoadPairs( const uint16_t * _pui16Src ) { return _mm512_loadu_si512( _pui16Src ); }
+		static inline Pairs										Set1Pair( const uint16_t * _pui16Src ) {
+			return _mm512_set1_epi32( SimdKernels::Read32( reinterpret_cast<const uint8_t *>(_pui16Src) ) );
+		}
+		static inline Reg										Dp( Reg _rAcc, Pairs _pA, Pairs _pB ) {
+			const __m512i mHi = _mm512_set1_epi32( int32_t( 0xFFFF0000U ) );
+			__m512i mAcc = Flush( _mm512_castps_si512( _rAcc ) );
+			mAcc = Flush( _mm512_castps_si512( _mm512_fmadd_ps( _mm512_castsi512_ps( Flush( _mm512_and_si512( _pA, mHi ) ) ),
+				_mm512_castsi512_ps( Flush( _mm512_and_si512( _pB, mHi ) ) ), _mm512_castsi512_ps( mAcc ) ) ) );
+			mAcc = Flush( _mm512_castps_si512( _mm512_fmadd_ps( _mm512_castsi512_ps( Flush( _mm512_slli_epi32( _pA, 16 ) ) ),
+				_mm512_castsi512_ps( Flush( _mm512_slli_epi32( _pB, 16 ) ) ), _mm512_castsi512_ps( mAcc ) ) ) );
+			return _mm512_castsi512_ps( mAcc );
+		}
+		static inline __m512i									Flush( __m512i _mBits ) {
+			if constexpr ( _bDazFtz ) {
+				const __mmask16 mDenorm = _mm512_testn_epi32_mask( _mBits, _mm512_set1_epi32( 0x7F800000 ) );
+				return _mm512_mask_and_epi32( _mBits, mDenorm, _mBits, _mm512_set1_epi32( int32_t( 0x80000000U ) ) );
+			}
+			else { return _mBits; }
+		}
+	};
+
+	/**
+	 * Applies a SimdMath function to 16 floats at a time, finishing with the plain C++ kernel.
+	 *
+	 * \param _pfIn The input.
+	 * \param _pfOut The output.
+	 * \param _sTotal The number of elements.
+	 * \param _fSimd The function to call on each register.
+	 * \param _pfTail The kernel to call on the remaining elements.
+	 **/
+	template <typename _tSimd>
+	inline void UnaryF32( const float * _pfIn, float * _pfOut, size_t _sTotal, _tSimd _fSimd, void (*_pfTail)( const float *, float *, size_t ) ) {
+		size_t I = 0;
+		for ( ; I + 16 <= _sTotal; I += 16 ) { _mm512_storeu_ps( _pfOut + I, _fSimd( _mm512_loadu_ps( _pfIn + I ) ) ); }
+		if ( I < _sTotal ) { _pfTail( _pfIn + I, _pfOut + I, _sTotal - I ); }
+	}
+
+	/**
+	 * Applies a SimdMath function to 8 doubles at a time, finishing with the plain C++ kernel.
+	 *
+	 * \param _pdIn The input.
+	 * \param _pdOut The output.
+	 * \param _sTotal The number of elements.
+	 * \param _fSimd The function to call on each register.
+	 * \param _pfTail The kernel to call on the remaining elements.
+	 **/
+	template <typename _tSimd>
+	inline void UnaryF64( const double * _pdIn, double * _pdOut, size_t _sTotal, _tSimd _fSimd, void (*_pfTail)( const double *, double *, size_t ) ) {
+		size_t I = 0;
+		for ( ; I + 8 <= _sTotal; I += 8 ) { _mm512_storeu_pd( _pdOut + I, _fSimd( _mm512_loadu_pd( _pdIn + I ) ) ); }
+		if ( I < _sTotal ) { _pfTail( _pdIn + I, _pdOut + I, _sTotal - I ); }
+	}
+
+	/**
+	 * Loads 16 values to quantize as floats.
+	 *
+	 * \param _pfSrc The values.
+	 * \return Returns the values.
+	 **/
+	inline __m512 LoadReal( const float * _pfSrc ) { return _mm512_loadu_ps( _pfSrc ); }
+
+	/**
+	 * Loads 16 accumulators to quantize as floats.
+	 *
+	 * \param _pi32Src The accumulators.
+	 * \return Returns the accumulators converted to float.
+	 **/
+	inline __m512 LoadReal( const int32_t * _pi32Src ) { return _mm512_cvtepi32_ps( _mm512_loadu_si512( _pi32Src ) ); }
+
+	/**
+	 * Loads 16 quantized values as 32-bit integers.
+	 *
+	 * \tparam _tQ The quantized type: int8_t, uint8_t, or int32_t.
+	 * \param _ptSrc The values.
+	 * \return Returns the values widened to 32 bits.
+	 **/
+	template <typename _tQ>
+	inline __m512i Widen( const _tQ * _ptSrc ) {
+		if constexpr ( _tQ( -1 ) > _tQ( 0 ) ) { return _mm512_cvtepu8_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i *>(_ptSrc) ) ); }
+		else if constexpr ( sizeof( _tQ ) == 1 ) { return _mm512_cvtepi8_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i *>(_ptSrc) ) ); }
+		else { return _mm512_loadu_si512( _ptSrc ); }
+	}
+
+	/**
+	 * Quantizes 16 values: clamp( round( _ptIn[I] * _mScale * _pfScale[I] ) + _mZero ).
+	 *
+	 * \tparam _tSrc The source type: float or int32_t.
+	 * \param _ptIn The values.
+	 * \param _pfScale The per-element multipliers, or nullptr.
+	 * \param _mScale The multiplier applied to every value.
+	 * \param _mLo The smallest scaled value, less the zero point.
+	 * \param _mHi The largest scaled value, less the zero point.
+	 * \param _mZero The zero point.
+	 * \return Returns the 16 quantized values.
+	 **/
+	template <typename _tSrc>
+	inline __m128i QuantizeStep( const _tSrc * _ptIn, const float * _pfScale, __m512 _mScale, __m512 _mLo, __m512 _mHi, __m512i _mZero ) {
+		__m512 mVal = _mm512_mul_ps( LoadReal( _ptIn ), _mScale );
+		if ( _pfScale ) { mVal = _mm512_mul_ps( mVal, _mm512_loadu_ps( _pfScale ) ); }
+		// maxps returns its second operand for NaN, so NaN becomes the smallest value.
+		mVal = _mm512_min_ps( _mm512_max_ps( mVal, _mLo ), _mHi );
+		// The values are already in range, so truncating to 8 bits only narrows them.
+		return _mm512_cvtepi32_epi8( _mm512_add_epi32( _mm512_cvtps_epi32( mVal ), _mZero ) );
+	}
+
+	// The kernels.  See Kernels::NN9_TABLE for what each computes.
+	void ExpF32( const float * _pfIn, float * _pfOut, size_t _sTotal ) {
+		UnaryF32( _pfIn, _pfOut, _sTotal, []( __m512 _rX ) { return SimdMath::Exp( _rX ); }, Kernels::ScalarExpF32 );
+	}
+
+	void LogF32( const float * _pfIn, float * _pfOut, size_t _sTotal ) {
+		UnaryF32( _pfIn, _pfOut, _sTotal, []( __m512 _rX ) { return SimdMath::Log( _rX ); }, Kernels::ScalarLogF32 );
+	}
+
+	void TanhF32( const float * _pfIn, float * _pfOut, size_t _sTotal ) {
+		UnaryF32( _pfIn, _pfOut, _sTotal, []( __m512 _rX ) { return SimdMath::Tanh( _rX ); }, Kernels::ScalarTanhF32 );
+	}
+
+	void ExpF64( const double * _pdIn, double * _pdOut, size_t _sTotal ) {
+		UnaryF64( _pdIn, _pdOut, _sTotal, []( __m512d _rX ) { return SimdMath::Exp( _rX ); }, Kernels::ScalarExpF64 );
+	}
+
+	void LogF64( const double * _pdIn, double * _pdOut, size_t _sTotal ) {
+		UnaryF64( _pdIn, _pdOut, _sTotal, []( __m512d _rX ) { return SimdMath::Log( _rX ); }, Kernels::ScalarLogF64 );
+	}
+
+	void TanhF64( const double * _pdIn, double * _pdOut, size_t _sTotal ) {
+		UnaryF64( _pdIn, _pdOut, _sTotal, []( __m512d _rX ) { return SimdMath::Tanh( _rX ); }, Kernels::ScalarTanhF64 );
+	}
+
+	void Bf16ToF32( const uint16_t * _pui16In, float * _pfOut, size_t _sTotal ) {
+		size_t I = 0;
+		for ( ; I + 16 <= _sTotal; I += 16 ) {
+			__m512i mBits = _mm512_cvtepu16_epi32( _mm256_loadu_si256( reinterpret_cast<const __m256i *>(_pui16In + I) ) );
+			_mm512_storeu_si512( _pfOut + I, _mm512_slli_epi32( mBits, 16 ) );
+		}
+		if ( I < _sTotal ) { Kernels::ScalarBf16ToF32( _pui16In + I, _pfOut + I, _sTotal - I ); }
+	}
+
+	void F32ToBf16( const float * _pfIn, uint16_t * _pui16Out, size_t _sTotal ) {
+		size_t I = 0;
+		for ( ; I + 16 <= _sTotal; I += 16 ) {
+			__m512i mBits = _mm512_srli_epi32( _mm512_castps_si512( _mm512_loadu_ps( _pfIn + I ) ), 16 );
+			_mm256_storeu_si256( reinterpret_cast<__m256i *>(_pui16Out + I), _mm512_cvtepi32_epi16( mBits ) );
+		}
+		if ( I < _sTotal ) { Kernels::ScalarF32ToBf16( _pfIn + I, _pui16Out + I, _sTotal - I ); }
+	}
+
+	void F32ToF64( const float * _pfIn, double * _pdOut, size_t _sTotal ) {
+		size_t I = 0;
+		for ( ; I + 8 <= _sTotal; I += 8 ) { _mm512_storeu_pd( _pdOut + I, _mm512_cvtps_pd( _mm256_loadu_ps( _pfIn + I ) ) ); }
+		if ( I < _sTotal ) { Kernels::ScalarF32ToF64( _pfIn + I, _pdOut + I, _sTotal - I ); }
+	}
+
+	void F64ToF32( const double * _pdIn, float * _pfOut, size_t _sTotal ) {
+		size_t I = 0;
+		for ( ; I + 8 <= _sTotal; I += 8 ) { _mm256_storeu_ps( _pfOut + I, _mm512_cvtpd_ps( _mm512_loadu_pd( _pdIn + I ) ) ); }
+		if ( I < _sTotal ) { Kernels::ScalarF64ToF32( _pdIn + I, _pfOut + I, _sTotal - I ); }
+	}
+
+	template <bool _bMax>
+	size_t ArgF32( const float * _pfIn, size_t _sTotal ) {
+		if ( _sTotal >= 16 ) {
+			// Each lane keeps the first extreme of its own indices.
+			__m512 mBest = _mm512_loadu_ps( _pfIn );
+			__m512i mIdx = _mm512_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 ), mBestIdx = mIdx;
+			const __m512i mStep = _mm512_set1_epi32( 16 );
+			__mmask16 mNan = _mm512_cmp_ps_mask( mBest, mBest, _CMP_UNORD_Q );
+			size_t I = 16;
+			for ( ; I + 16 <= _sTotal; I += 16 ) {
+				const __m512 mVal = _mm512_loadu_ps( _pfIn + I );
+				mIdx = _mm512_add_epi32( mIdx, mStep );
+				mNan |= _mm512_cmp_ps_mask( mVal, mVal, _CMP_UNORD_Q );
+				const __mmask16 mBetter = _mm512_cmp_ps_mask( mVal, mBest, _bMax ? _CMP_GT_OQ : _CMP_LT_OQ );
+				mBest = _mm512_mask_mov_ps( mBest, mBetter, mVal );
+				mBestIdx = _mm512_mask_mov_epi32( mBestIdx, mBetter, mIdx );
+			}
+			// A NaN wins, so a run with one is searched again for the first.
+			if ( !mNan ) {
+				float fLanes[16];
+				int32_t i32Lanes[16];
+				_mm512_storeu_ps( fLanes, mBest );
+				_mm512_storeu_si512( i32Lanes, mBestIdx );
+				const size_t sLane = SimdKernels::ArgLanes<_bMax>( fLanes, i32Lanes, 16 );
+				return SimdKernels::ArgFinish<_bMax>( _pfIn, I, _sTotal, fLanes[sLane], size_t( i32Lanes[sLane] ) );
+			}
+		}
+		return SimdKernels::ArgFinish<_bMax>( _pfIn, 1, _sTotal, _pfIn[0], 0 );
+	}
+
+	template <bool _bMax>
+	void ArgRowF32( const float * _pfRow, float * _pfBest, uint32_t * _pui32Idx, uint32_t _ui32Row, size_t _sTotal ) {
+		const __m512i mRow = _mm512_set1_epi32( int32_t( _ui32Row ) );
+		size_t J = 0;
+		for ( ; J + 16 <= _sTotal; J += 16 ) {
+			const __m512 mVal = _mm512_loadu_ps( _pfRow + J );
+			const __m512 mBest = _mm512_loadu_ps( _pfBest + J );
+			const __mmask16 mBetter = _mm512_cmp_ps_mask( mVal, mBest, _bMax ? _CMP_GT_OQ : _CMP_LT_OQ ) |
+				(_mm512_cmp_ps_mask( mVal, mVal, _CMP_UNORD_Q ) & _mm512_cmp_ps_mask( mBest, mBest, _CMP_ORD_Q ));
+			_mm512_storeu_ps( _pfBest + J, _mm512_mask_mov_ps( mBest, mBetter, mVal ) );
+			_mm512_mask_storeu_epi32( _pui32Idx + J, mBetter, mRow );
+		}
+		SimdKernels::ArgRowFinish<_bMax>( _pfRow, _pfBest, _pui32Idx, _ui32Row, J, _sTotal );
+	}
+	template <typename _tSrc, bool _bSigned>
+	void QuantizeQ( const float * _pfScale, const _tSrc * _ptIn, void * _pvOut, size_t _sTotal, float _fScale, int32_t _i32Zero ) {
+		const __m512 mScale = _mm512_set1_ps( _fScale );
+		const __m512 mLo = _mm512_set1_ps( float( (_bSigned ? -127 : 0) - _i32Zero ) ), mHi = _mm512_set1_ps( float( (_bSigned ? 127 : 255) - _i32Zero ) );
+		const __m512i mZero = _mm512_set1_epi32( _i32Zero );
+		uint8_t * pui8Out = static_cast<uint8_t *>(_pvOut);
+		size_t I = 0;
+		for ( ; I + 16 <= _sTotal; I += 16 ) {
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(pui8Out + I),
+				QuantizeStep( _ptIn + I, _pfScale ? _pfScale + I : nullptr, mScale, mLo, mHi, mZero ) );
+		}
+		if ( I < _sTotal ) {
+			// The last values go through a padded register so that they round as the others do.
+			_tSrc tIn[16] = {};
+			float fScale[16] = {};
+			uint8_t ui8Out[16];
+			for ( size_t J = I; J < _sTotal; ++J ) {
+				tIn[J-I] = _ptIn[J];
+				if ( _pfScale ) { fScale[J-I] = _pfScale[J]; }
+			}
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(ui8Out), QuantizeStep( tIn, _pfScale ? fScale : nullptr, mScale, mLo, mHi, mZero ) );
+			for ( size_t J = I; J < _sTotal; ++J ) { pui8Out[J] = ui8Out[J-I]; }
+		}
+	}
+
+	template <typename _tQ>
+	void DequantizeQ( const void * _pvIn, float * _pfOut, size_t _sTotal, float _fScale, int32_t _i32Zero ) {
+		const _tQ * ptIn = static_cast<const _tQ *>(_pvIn);
+		const __m512 mScale = _mm512_set1_ps( _fScale );
+		const __m512i mZero = _mm512_set1_epi32( _i32Zero );
+		size_t I = 0;
+		for ( ; I + 16 <= _sTotal; I += 16 ) {
+			_mm512_storeu_ps( _pfOut + I, _mm512_mul_ps( _mm512_cvtepi32_ps( _mm512_sub_epi32( Widen( ptIn + I ), mZero ) ), mScale ) );
+		}
+		for ( ; I < _sTotal; ++I ) { _pfOut[I] = float( int32_t( ptIn[I] ) - _i32Zero ) * _fScale; }
+	}
+}	// namespace
+#endif	// #ifdef __AVX512F__
+
+	// == Functions.
+	/**
+	 * Fills a table with the AVX-512 kernels.
+	 *
+	 * \param _tTable The table to fill.
+	 * \return Returns false if the file was not compiled with AVX-512F.
+	 **/
+	bool Kernels::FillAvx512( NN9_TABLE &_tTable ) {
+#ifdef __AVX512F__
+		_tTable.pfExpF32 = ExpF32;
+		_tTable.pfLogF32 = LogF32;
+		_tTable.pfTanhF32 = TanhF32;
+		_tTable.pfExpF64 = ExpF64;
+		_tTable.pfLogF64 = LogF64;
+		_tTable.pfTanhF64 = TanhF64;
+		_tTable.pfBf16ToF32 = Bf16ToF32;
+		_tTable.pfF32ToBf16 = F32ToBf16;
+		_tTable.pfF32ToF64 = F32ToF64;
+		_tTable.pfF64ToF32 = F64ToF32;
+		SimdKernels::Fill<NN9_F32, NN9_F64, NN9_KG_AVX512_MR, NN9_KG_AVX512_NR_F32, NN9_KG_AVX512_NR_F64>( _tTable, NN9_KI_AVX512 );
+		_tTable.pfArgF32[NN9_KR_MAX] = ArgF32<true>;
+		_tTable.pfArgF32[NN9_KR_MIN] = ArgF32<false>;
+		_tTable.pfArgRowF32[NN9_KR_MAX] = ArgRowF32<true>;
+		_tTable.pfArgRowF32[NN9_KR_MIN] = ArgRowF32<false>;
+		_tTable.pfDotBf16[NN9_KP_EMULATED] = SimdKernels::DotBf16<NN9_BF16<true>>;
+		_tTable.pfDotBf16[NN9_KP_WIDEN] = SimdKernels::DotBf16<NN9_BF16<false>>;
+		_tTable.pfGemmBf16[NN9_KP_EMULATED] = SimdKernels::GemmBf16Tile<NN9_BF16<true>, NN9_KG_AVX512_MR, NN9_KG_AVX512_NR_F32 / 16>;
+		_tTable.pfQuantizeF32[NN9_KT_INT8] = QuantizeQ<float, true>;
+		_tTable.pfQuantizeF32[NN9_KT_UINT8] = QuantizeQ<float, false>;
+		_tTable.pfQuantizeI32[NN9_KT_INT8] = QuantizeQ<int32_t, true>;
+		_tTable.pfQuantizeI32[NN9_KT_UINT8] = QuantizeQ<int32_t, false>;
+		_tTable.pfDequantize[NN9_KT_INT8] = DequantizeQ<int8_t>;
+		_tTable.pfDequantize[NN9_KT_UINT8] = DequantizeQ<uint8_t>;
+		_tTable.pfDequantize[NN9_KT_INT32] = DequantizeQ<int32_t>;
+		_tTable.pfConvF32 = SimdKernels::ConvTile<NN9_F32, NN9_KC_AVX512_COLS>;
+		_tTable.pfConvF64 = SimdKernels::ConvTile<NN9_F64, NN9_KC_AVX512_COLS>;
+		_tTable.kiConv = NN9_KI_AVX512;
+		return true;
+#else
+		static_cast<void>(_tTable);
+		return false;
+#endif	// #ifdef __AVX512F__
+	}
+
+}	// namespace nn9
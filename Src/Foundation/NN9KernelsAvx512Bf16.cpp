@@ -0,0 +1,77 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: The AVX512-BF16 kernels.  Compile this file with AVX-512F and AVX512-BF16 enabled (/arch:AVX512 and __AVX512BF16__ defined
+ *	for this file on MSVC; -mavx512f -mavx512bf16 on GCC and Clang).  Nothing outside of NN9SimdMath.h, NN9KernelsSimd.h, and the system
+ *	headers may be included here, and everything but Kernels::FillAvx512Bf16() stays in an anonymous namespace (see Kernels).
+ *
+ * Only the native bfloat16 pair kernels are added.  vcvtneps2bf16 rounds to nearest where bfloat16's constructor truncates, so the
+ *	AVX-512 conversions are kept to give the same bits on every CPU.
+ */
+
+#include "NN9Kernels.h"
+#define NN9_SIMDMATH_LOCAL
+#include "NN9SimdMath.h"
+#include "NN9KernelsSimd.h"
+
+
+namespace nn9 {
+
+#if defined( __AVX512F__ ) && defined( __AVX512BF16__ )
+namespace {
+
+	/** bfloat16 pair registers for SimdKernels::DotBf16() and SimdKernels::GemmBf16Tile(), multiplied with vdpbf16ps. */
+	struct NN9_BF16 {
+		typedef float											Scalar;
+		typedef __m512											Reg;
+		typedef __m512i											Pairs;
+		static constexpr size_t									Lanes = 16;
+
+		static inline Reg										Zero() { return _mm512_setzero_ps(); }
+		static inline Reg										Set1( Scalar _sVal ) { return _mm512_set1_ps( _sVal ); }
+		static inline Reg										Load( const Scalar * _psSrc ) { return _mm512_loadu_ps( _psSrc ); }
+		static inline void										Store( Scalar * _psDst, Reg _rVal ) { _mm512_storeu_ps( _psDst, _rVal ); }
+		static inline Reg										Add( Reg _rA, Reg _rB ) { return _mm512_add_ps( _rA, _rB ); }
+		static inline Reg										Mul( Reg _rA, Reg _rB ) { return _mm512_mul_ps( _rA, _rB ); }
+		static inline Reg										Fma( Reg _rA, Reg _rB, Reg _rC ) { return _mm512_fmadd_ps( _rA, _rB, _rC ); }
+		static inline Pairs										LoadPairs( const uint16_t * _pui16Src ) { return _mm512_loadu_si512( _pui16Src ); }
+		static inline Pairs										Set1Pair( const uint16_t * _pui16Src ) {
+			return _mm512_set1_epi32( SimdKernels::Read32( reinterpret_cast<const uint8_t *>(_pui16Src) ) );
+		}
+		static inline Reg										Dp( Reg _rAcc, Pairs _pA, Pairs _pB ) {
+			union {
+				__m512i											m512iVal;
+				__m512bh										m512bhVal;
+			} uA, uB;
+			uA.m512iVal = _pA;
+			uB.m512iVal = _pB;
+			return _mm512_dpbf16_ps( _rAcc, uA.m512bhVal, uB.m512bhVal );
+		}
+	};
+}	// namespace
+#endif	// #if defined( __AVX512F__ ) && defined( __AVX512BF16__ )
+
+	// == Functions.
+	/**
+	 * Fills a table with the AVX512-BF16 kernels.
+	 *
+	 * \param _tTable The table to fill.
+	 * \return Returns false if the file was not compiled with AVX-512F and AVX512-BF16.
+	 **/
+	bool Kernels::FillAvx512Bf16( NN9_TABLE &_tTable ) {
+#if defined( __AVX512F__ ) && defined( __AVX512BF16__ )
+		_tTable.pfDotBf16[NN9_KP_NATIVE] = SimdKernels::DotBf16<NN9_BF16>;
+		// The tile has the AVX-512 size, so it is only usable when Gemm packs for that size.
+		if ( _tTable.kiGemm == NN9_KI_AVX512 ) {
+			_tTable.pfGemmBf16[NN9_KP_NATIVE] = SimdKernels::GemmBf16Tile<NN9_BF16, NN9_KG_AVX512_MR, NN9_KG_AVX512_NR_F32 / 16>;
+		}
+		return true;
+#else
+		static_cast<void>(_tTable);
+		return false;
+#endif	// #if defined( __AVX512F__ ) && defined( __AVX512BF16__ )
+	}
+
+}	// namespace nn9
@@ -0,0 +1,57 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: The AVX-512 VNNI kernels.  Compile this file with AVX-512F and AVX-512 VNNI enabled (/arch:AVX512 and __AVX512VNNI__
+ *	defined for this file on MSVC; -mavx512f -mavx512vnni on GCC and Clang).  Nothing outside of NN9SimdMath.h, NN9KernelsSimd.h, and the
+ *	system headers may be included here, and everything but Kernels::FillAvx512Vnni() stays in an anonymous namespace (see Kernels).
+ */
+
+#include "NN9Kernels.h"
+#define NN9_SIMDMATH_LOCAL
+#include "NN9SimdMath.h"
+#include "NN9KernelsSimd.h"
+
+
+namespace nn9 {
+
+#if defined( __AVX512F__ ) && defined( __AVX512VNNI__ )
+namespace {
+
+	/** int8_t registers for SimdKernels::GemmI8Tile(). */
+	struct NN9_I8 {
+		typedef __m512i											Reg;
+		typedef __m512i											AOp;
+		typedef __m512i											BOp;
+		static constexpr size_t									Lanes = 16;
+
+		static inline Reg										Zero() { return _mm512_setzero_si512(); }
+		static inline AOp										SetA( const uint8_t * _pui8A ) { return _mm512_set1_epi32( SimdKernels::Read32( _pui8A ) ); }
+		static inline BOp										LoadB( const int8_t * _pi8B ) { return _mm512_load_si512( _pi8B ); }
+		static inline Reg										Load( const int32_t * _pi32Src ) { return _mm512_loadu_si512( _pi32Src ); }
+		static inline void										Store( int32_t * _pi32Dst, Reg _rVal ) { _mm512_storeu_si512( _pi32Dst, _rVal ); }
+		static inline Reg										Add( Reg _rA, Reg _rB ) { return _mm512_add_epi32( _rA, _rB ); }
+		static inline Reg										Dp( Reg _rAcc, AOp _aA, BOp _bB ) { return _mm512_dpbusd_epi32( _rAcc, _aA, _bB ); }
+	};
+}	// namespace
+#endif	// #if defined( __AVX512F__ ) && defined( __AVX512VNNI__ )
+
+	// == Functions.
+	/**
+	 * Fills a table with the AVX-512 VNNI kernels.
+	 *
+	 * \param _tTable The table to fill.
+	 * \return Returns false if the file was not compiled with AVX-512F and AVX-512 VNNI.
+	 **/
+	bool Kernels::FillAvx512Vnni( NN9_TABLE &_tTable ) {
+#if defined( __AVX512F__ ) && defined( __AVX512VNNI__ )
+		_tTable.pfGemmI8[NN9_KQ_AVX512VNNI] = SimdKernels::GemmI8Tile<NN9_I8, NN9_KG_I8_AVX512VNNI_MR, NN9_KG_I8_AVX512VNNI_NR / 16>;
+		return true;
+#else
+		static_cast<void>(_tTable);
+		return false;
+#endif	// #if defined( __AVX512F__ ) && defined( __AVX512VNNI__ )
+	}
+
+}	// namespace nn9
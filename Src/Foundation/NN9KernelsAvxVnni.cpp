@@ -0,0 +1,57 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: The AVX-VNNI kernels.  Compile this file with AVX2 and AVX-VNNI enabled (/arch:AVX2 and __AVXVNNI__ defined for this file
+ *	on MSVC; -mavx2 -mfma -mavxvnni on GCC and Clang).  Nothing outside of NN9SimdMath.h, NN9KernelsSimd.h, and the system headers may be
+ *	included here, and everything but Kernels::FillAvxVnni() stays in an anonymous namespace (see Kernels).
+ */
+
+#include "NN9Kernels.h"
+#define NN9_SIMDMATH_LOCAL
+#include "NN9SimdMath.h"
+#include "NN9KernelsSimd.h"
+
+
+namespace nn9 {
+
+#if defined( __AVX2__ ) && defined( __AVXVNNI__ )
+namespace {
+
+	/** int8_t registers for SimdKernels::GemmI8Tile(). */
+	struct NN9_I8 {
+		typedef __m256i											Reg;
+		typedef __m256i											AOp;
+		typedef __m256i											BOp;
+		static constexpr size_t									Lanes = 8;
+
+		static inline Reg										Zero() { return _mm256_setzero_si256(); }
+		static inline AOp										SetA( const uint8_t * _pui8A ) { return _mm256_set1_epi32( SimdKernels::Read32( _pui8A ) ); }
+		static inline BOp										LoadB( const int8_t * _pi8B ) { return _mm256_load_si256( reinterpret_cast<const __m256i *>(_pi8B) ); }
+		static inline Reg										Load( const int32_t * _pi32Src ) { return _mm256_loadu_si256( reinterpret_cast<const __m256i *>(_pi32Src) ); }
+		static inline void										Store( int32_t * _pi32Dst, Reg _rVal ) { _mm256_storeu_si256( reinterpret_cast<__m256i *>(_pi32Dst), _rVal ); }
+		static inline Reg										Add( Reg _rA, Reg _rB ) { return _mm256_add_epi32( _rA, _rB ); }
+		static inline Reg										Dp( Reg _rAcc, AOp _aA, BOp _bB ) { return _mm256_dpbusd_avx_epi32( _rAcc, _aA, _bB ); }
+	};
+}	// namespace
+#endif	// #if defined( __AVX2__ ) && defined( __AVXVNNI__ )
+
+	// == Functions.
+	/**
+	 * Fills a table with the AVX-VNNI kernels.
+	 *
+	 * \param _tTable The table to fill.
+	 * \return Returns false if the file was not compiled with AVX2 and AVX-VNNI.
+	 **/
+	bool Kernels::FillAvxVnni( NN9_TABLE &_tTable ) {
+#if defined( __AVX2__ ) && defined( __AVXVNNI__ )
+		_tTable.pfGemmI8[NN9_KQ_AVXVNNI] = SimdKernels::GemmI8Tile<NN9_I8, NN9_KG_I8_AVXVNNI_MR, NN9_KG_I8_AVXVNNI_NR / 8>;
+		return true;
+#else
+		static_cast<void>(_tTable);
+		return false;
+#endif	// #if defined( __AVX2__ ) && defined( __AVXVNNI__ )
+	}
+
+}	// namespace nn9
@@ -0,0 +1,1420 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: The conversion, element-wise, binary-operation, reduction, softmax, bfloat16 pair, GEMM (float, double, bfloat16, and
+ *	int8_t), direct convolution, optimizer, and fused-instruction kernels of the per-instruction-set files, written once over register
+ *	traits that each of those files defines.  Include only from those files.
+ */
+
+#pragma once
+
+#ifndef NN9_SIMDMATH_LOCAL
+#error "NN9KernelsSimd.h may only be included by the per-instruction-set kernel files, after defining NN9_SIMDMATH_LOCAL."
+#endif	// #ifndef NN9_SIMDMATH_LOCAL
+
+#include "NN9Kernels.h"
+#include "NN9SimdMath.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+
+namespace nn9 {
+namespace {
+
+	/**
+	 * Class SimdKernels
+	 * \brief The table kernels shared by the per-instruction-set files.
+	 *
+	 * Description: The conversion, element-wise, binary-operation, reduction, softmax, GEMM, optimizer, and fused-instruction kernels of
+	 *	Kernels::NN9_TABLE, written once over register traits _tR that provide Scalar, Reg, Lanes, Zero(), Set1(), Load(), Store(), Add(),
+	 *	Sub(), Mul(), Div(), Fma(), Abs(), Neg(), Max(), Min(), Greater(), Lesser(), FiniteOrZero(), Sqrt(), Ceil(), Floor(), Round(),
+	 *	RoundEven(), and LoadAs() and StoreAs(), which convert Lanes elements of a Kernels::NN9_KERNEL_TYPE to and from a register.  Max()
+	 *	and Min() fold a value into an accumulator and keep the value where it is NaN, as Math's reductions do; Greater() and Lesser() are
+	 *	a > b ? a : b and a < b ? a : b, as Graph's scalar code does.  The float traits also provide StoreSr(), which narrows a register
+	 *	to bfloat16 bits with Optimizer::StochasticRound()'s rounding.  Each kernel follows the order of operations of the portable code it
+	 *	replaces, so that a table kernel and the loop in its caller agree on everything but the rounding of exp() and log().  Elements after
+	 *	the last full register are handled with plain arithmetic or through a padded register, so nothing from the standard library is
+	 *	called here (see Kernels).
+	 */
+	class SimdKernels {
+	public :
+		// == Functions.
+		/**
+		 * Widens an array of another element type to the register's scalar type.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _ktType The input element type.
+		 * \param _pvIn The input.
+		 * \param _psOut The output.
+		 * \param _sTotal The number of elements.
+		 **/
+		template <typename _tR, Kernels::NN9_KERNEL_TYPE _ktType>
+		static void													ToReal( const void * _pvIn, typename _tR::Scalar * _psOut, size_t _sTotal ) {
+			constexpr size_t L = _tR::Lanes;
+			constexpr size_t sSize = TypeSize( _ktType );
+			const uint8_t * pui8In = static_cast<const uint8_t *>(_pvIn);
+			size_t I = 0;
+			for ( ; I + L <= _sTotal; I += L ) { _tR::Store( _psOut + I, _tR::template LoadAs<_ktType>( pui8In + I * sSize ) ); }
+			if ( I < _sTotal ) {
+				uint8_t ui8Part[L*sizeof( double )] = {};
+				std::memcpy( ui8Part, pui8In + I * sSize, (_sTotal - I) * sSize );
+				StorePart<_tR>( _psOut + I, _sTotal - I, _tR::template LoadAs<_ktType>( ui8Part ) );
+			}
+		}
+
+		/**
+		 * Narrows an array of the register's scalar type to another element type.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _ktType The output element type.
+		 * \param _psIn The input.
+		 * \param _pvOut The output.
+		 * \param _sTotal The number of elements.
+		 **/
+		template <typename _tR, Kernels::NN9_KERNEL_TYPE _ktType>
+		static void													FromReal( const typename _tR::Scalar * _psIn, void * _pvOut, size_t _sTotal ) {
+			constexpr size_t L = _tR::Lanes;
+			constexpr size_t sSize = TypeSize( _ktType );
+			uint8_t * pui8Out = static_cast<uint8_t *>(_pvOut);
+			size_t I = 0;
+			for ( ; I + L <= _sTotal; I += L ) { _tR::template StoreAs<_ktType>( pui8Out + I * sSize, _tR::Load( _psIn + I ) ); }
+			if ( I < _sTotal ) {
+				uint8_t ui8Part[L*sizeof( double )];
+				_tR::template StoreAs<_ktType>( ui8Part, LoadPart<_tR>( _psIn + I, _sTotal - I, 0 ) );
+				std::memcpy( pui8Out + I * sSize, ui8Part, (_sTotal - I) * sSize );
+			}
+		}
+
+		/**
+		 * _psOut[I] = op( _psIn[I] ).  The elements after the last full register are computed in a padded register.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _kuOp The operation.
+		 * \param _psIn The input.
+		 * \param _psOut The output.  May be _psIn.
+		 * \param _sTotal The number of elements.
+		 **/
+		template <typename _tR, Kernels::NN9_KERNEL_UNARY _kuOp>
+		static void													Unary( const typename _tR::Scalar * _psIn, typename _tR::Scalar * _psOut, size_t _sTotal ) {
+			constexpr size_t L = _tR::Lanes;
+			size_t I = 0;
+			for ( ; I + L <= _sTotal; I += L ) { _tR::Store( _psOut + I, UnaryOp<_tR, _kuOp>( _tR::Load( _psIn + I ) ) ); }
+			if ( I < _sTotal ) { StorePart<_tR>( _psOut + I, _sTotal - I, UnaryOp<_tR, _kuOp>( LoadPart<_tR>( _psIn + I, _sTotal - I, 0 ) ) ); }
+		}
+
+		/**
+		 * _psOut[I] = _psA[I*_sStrideA] (op) _psB[I*_sStrideB].  A stride of 0 pairs 1 value with every element of the other input.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _kbOp The operation.
+		 * \param _psA The left input.
+		 * \param _sStrideA 1, or 0 if _psA holds 1 value.
+		 * \param _psB The right input.
+		 * \param _sStrideB 1, or 0 if _psB holds 1 value.
+		 * \param _psOut The output.  May be either input.
+		 * \param _sTotal The number of elements.
+		 **/
+		template <typename _tR, Kernels::NN9_KERNEL_BINARY _kbOp>
+		static void													Binary( const typename _tR::Scalar * _psA, size_t _sStrideA, const typename _tR::Scalar * _psB, size_t _sStrideB,
+			typename _tR::Scalar * _psOut, size_t _sTotal ) {
+			using Scalar = typename _tR::Scalar;
+			constexpr size_t L = _tR::Lanes;
+			size_t I = 0;
+			if ( _sStrideA && _sStrideB ) {
+				for ( ; I + L <= _sTotal; I += L ) { _tR::Store( _psOut + I, BinaryOp<_tR, _kbOp>( _tR::Load( _psA + I ), _tR::Load( _psB + I ) ) ); }
+			}
+			else if ( _sStrideA ) {
+				const auto rB = _tR::Set1( (*_psB) );
+				for ( ; I + L <= _sTotal; I += L ) { _tR::Store( _psOut + I, BinaryOp<_tR, _kbOp>( _tR::Load( _psA + I ), rB ) ); }
+			}
+			else if ( _sStrideB ) {
+				const auto rA = _tR::Set1( (*_psA) );
+				for ( ; I + L <= _sTotal; I += L ) { _tR::Store( _psOut + I, BinaryOp<_tR, _kbOp>( rA, _tR::Load( _psB + I ) ) ); }
+			}
+			else {
+				const auto rOut = BinaryOp<_tR, _kbOp>( _tR::Set1( (*_psA) ), _tR::Set1( (*_psB) ) );
+				for ( ; I + L <= _sTotal; I += L ) { _tR::Store( _psOut + I, rOut ); }
+			}
+			for ( ; I < _sTotal; ++I ) { _psOut[I] = BinaryOp<NN9_SCALAR<Scalar>, _kbOp>( _psA[I*_sStrideA], _psB[I*_sStrideB] ); }
+		}
+
+		/**
+		 * Folds a run of values into an accumulator.  Sums are taken in 4 registers, folded pairwise, and added to _sAcc last (Math's
+		 *	ReduceBlock()); maximums and minimums start every register at _sAcc and keep NaN (Math's ReduceRun()).
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _krOp The operation.
+		 * \param _psIn The values.
+		 * \param _sTotal The number of values.
+		 * \param _sAcc The accumulator to fold into.
+		 * \return Returns the updated accumulator.
+		 **/
+		template <typename _tR, Kernels::NN9_KERNEL_REDUCE _krOp>
+		static typename _tR::Scalar									Fold( const typename _tR::Scalar * _psIn, size_t _sTotal, typename _tR::Scalar _sAcc ) {
+			using Scalar = typename _tR::Scalar;
+			using S = NN9_SCALAR<Scalar>;
+			constexpr size_t L = _tR::Lanes;
+			constexpr bool bSum = _krOp == Kernels::NN9_KR_SUM || _krOp == Kernels::NN9_KR_SUM_SQ || _krOp == Kernels::NN9_KR_SUM_ABS;
+			Scalar sRet = bSum ? Scalar( 0 ) : _sAcc;
+			size_t I = 0;
+			if ( _sTotal >= L ) {
+				auto rA0 = _tR::Set1( sRet ), rA1 = rA0, rA2 = rA0, rA3 = rA0;
+				for ( ; I + L * 4 <= _sTotal; I += L * 4 ) {
+					rA0 = Step<_tR, _krOp>( rA0, _tR::Load( _psIn + I ) );
+					rA1 = Step<_tR, _krOp>( rA1, _tR::Load( _psIn + I + L ) );
+					rA2 = Step<_tR, _krOp>( rA2, _tR::Load( _psIn + I + L * 2 ) );
+					rA3 = Step<_tR, _krOp>( rA3, _tR::Load( _psIn + I + L * 3 ) );
+				}
+				for ( ; I + L <= _sTotal; I += L ) { rA0 = Step<_tR, _krOp>( rA0, _tR::Load( _psIn + I ) ); }
+				sRet = Horizontal<_tR, _krOp>( Combine<_tR, _krOp>( Combine<_tR, _krOp>( rA0, rA1 ), Combine<_tR, _krOp>( rA2, rA3 ) ) );
+			}
+			for ( ; I < _sTotal; ++I ) { sRet = Step<S, _krOp>( sRet, _psIn[I] ); }
+			return bSum ? _sAcc + sRet : sRet;
+		}
+
+		/**
+		 * Folds a row into column accumulators: _psAcc[I] = _psAcc[I] (op) _psRow[I].
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _krOp The operation.
+		 * \param _psRow The row.
+		 * \param _psAcc The column accumulators.
+		 * \param _sTotal The number of columns.
+		 **/
+		template <typename _tR, Kernels::NN9_KERNEL_REDUCE _krOp>
+		static void													FoldRow( const typename _tR::Scalar * _psRow, typename _tR::Scalar * _psAcc, size_t _sTotal ) {
+			using S = NN9_SCALAR<typename _tR::Scalar>;
+			constexpr size_t L = _tR::Lanes;
+			size_t I = 0;
+			for ( ; I + L <= _sTotal; I += L ) { _tR::Store( _psAcc + I, Step<_tR, _krOp>( _tR::Load( _psAcc + I ), _tR::Load( _psRow + I ) ) ); }
+			for ( ; I < _sTotal; ++I ) { _psAcc[I] = Step<S, _krOp>( _psAcc[I], _psRow[I] ); }
+		}
+
+		/**
+		 * Adds the terms of a run to a Neumaier sum.  Each lane of 2 registers keeps a Kahan sum, and the sums and compensations of the lanes
+		 *	join the Neumaier sum after the last full pair of registers (Math's ReduceRun()).
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _krOp The operation: NN9_KR_SUM, NN9_KR_SUM_SQ, or NN9_KR_SUM_ABS.
+		 * \param _psIn The values.
+		 * \param _sTotal The number of values.
+		 * \param _psSum The running sum.
+		 * \param _psComp The running compensation.  The total is (*_psSum) + (*_psComp).
+		 **/
+		template <typename _tR, Kernels::NN9_KERNEL_REDUCE _krOp>
+		static void													Kahan( const typename _tR::Scalar * _psIn, size_t _sTotal, typename _tR::Scalar * _psSum, typename _tR::Scalar * _psComp ) {
+			using Scalar = typename _tR::Scalar;
+			using S = NN9_SCALAR<Scalar>;
+			constexpr size_t L = _tR::Lanes;
+			size_t I = 0;
+			if ( _sTotal >= L * 2 ) {
+				auto rS0 = _tR::Zero(), rC0 = rS0, rS1 = rS0, rC1 = rS0;
+				for ( ; I + L * 2 <= _sTotal; I += L * 2 ) {
+					KahanStep<_tR, _krOp>( rS0, rC0, _tR::Load( _psIn + I ) );
+					KahanStep<_tR, _krOp>( rS1, rC1, _tR::Load( _psIn + I + L ) );
+				}
+				Scalar sSums[L*2], sComps[L*2];
+				_tR::Store( sSums, rS0 );
+				_tR::Store( sSums + L, rS1 );
+				_tR::Store( sComps, rC0 );
+				_tR::Store( sComps + L, rC1 );
+				for ( size_t J = 0; J < L * 2; ++J ) {
+					Neumaier( (*_psSum), (*_psComp), sSums[J] );
+					Neumaier( (*_psSum), (*_psComp), -sComps[J] );
+				}
+			}
+			for ( ; I < _sTotal; ++I ) { Neumaier( (*_psSum), (*_psComp), Term<S, _krOp>( _psIn[I] ) ); }
+		}
+
+		/**
+		 * Adds the terms of a row to column Kahan sums.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _krOp The operation: NN9_KR_SUM, NN9_KR_SUM_SQ, or NN9_KR_SUM_ABS.
+		 * \param _psRow The row.
+		 * \param _psAcc The column sums.
+		 * \param _psComp The column compensations.  The totals are _psAcc[I] - _psComp[I].
+		 * \param _sTotal The number of columns.
+		 **/
+		template <typename _tR, Kernels::NN9_KERNEL_REDUCE _krOp>
+		static void													KahanRow( const typename _tR::Scalar * _psRow, typename _tR::Scalar * _psAcc, typename _tR::Scalar * _psComp, size_t _sTotal ) {
+			using S = NN9_SCALAR<typename _tR::Scalar>;
+			constexpr size_t L = _tR::Lanes;
+			size_t I = 0;
+			for ( ; I + L <= _sTotal; I += L ) {
+				auto rSum = _tR::Load( _psAcc + I ), rComp = _tR::Load( _psComp + I );
+				KahanStep<_tR, _krOp>( rSum, rComp, _tR::Load( _psRow + I ) );
+				_tR::Store( _psAcc + I, rSum );
+				_tR::Store( _psComp + I, rComp );
+			}
+			for ( ; I < _sTotal; ++I ) { KahanStep<S, _krOp>( _psAcc[I], _psComp[I], _psRow[I] ); }
+		}
+
+		/**
+		 * Runs a softmax, log-softmax, or log-sum-exp over 1 contiguous row, as Softmax::Row() does.
+		 *
+		 * \tparam _tR The register traits.
+		 * \param _ksOp The operation.
+		 * \param _psIn The row.
+		 * \param _sCols The number of elements in the row.
+		 * \param _psOut The output row, or the output value for NN9_KS_LOG_SUM_EXP.  May be _psIn.
+		 * \param _bOnline If true, the maximum and the sum are found in 1 pass and a softmax exponentiates each element again; otherwise the
+		 *	exponentials of a softmax are kept in _psOut.
+		 **/
+		template <typename _tR>
+		static void													Softmax( Kernels::NN9_KERNEL_SOFTMAX _ksOp, const typename _tR::Scalar * _psIn, size_t _sCols,
+			typename _tR::Scalar * _psOut, bool _bOnline ) {
+			using Scalar = typename _tR::Scalar;
+			Scalar sMax, sSum;
+			if ( !_bOnline ) {
+				sMax = RowMax<_tR>( _psIn, _sCols );
+				sSum = RowSumExp<_tR>( _psIn, _sCols, sMax, _ksOp == Kernels::NN9_KS_SOFTMAX ? _psOut : nullptr );
+			}
+			else { RowOnline<_tR>( _psIn, _sCols, sMax, sSum ); }
+
+			// An empty row or a row of -inf sums to 0 and has no defined softmax.
+			const bool bZero = sMax == -Scalar( INFINITY ) && sSum == sSum;
+			if ( _ksOp == Kernels::NN9_KS_SOFTMAX ) {
+				const Scalar sScale = bZero ? Scalar( NAN ) : Scalar( 1 ) / sSum;
+				if ( !_bOnline ) { RowScale<_tR>( _psOut, _sCols, sScale, _psOut ); }
+				else { RowExpScale<_tR>( _psIn, _sCols, sMax, sScale, _psOut ); }
+				return;
+			}
+			const Scalar sLse = sMax + First<_tR>( SimdMath::Log( _tR::Set1( sSum ) ) );
+			if ( _ksOp == Kernels::NN9_KS_LOG_SUM_EXP ) { (*_psOut) = bZero ? -Scalar( INFINITY ) : sLse; }
+			else { RowSubtract<_tR>( _psIn, _sCols, bZero ? Scalar( NAN ) : sLse, _psOut ); }
+		}
+
+		/**
+		 * Computes a full _sMr x (_sNv * Lanes) tile of C = alpha * A * B + beta * C from packed slivers, as Gemm::MicroKernel() does.  When
+		 *	beta is 0, C is not read.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _sMr The rows in the tile.
+		 * \tparam _sNv The registers across the tile.
+		 * \param _sSteps The depth of the slivers.
+		 * \param _psA The packed sliver of A.
+		 * \param _psB The packed sliver of B.
+		 * \param _psC The top-left element of the tile of C.
+		 * \param _sRowC The distance between rows of C.
+		 * \param _sAlpha The scale applied to A * B.
+		 * \param _sBeta The scale applied to the existing contents of C.
+		 **/
+		template <typename _tR, size_t _sMr, size_t _sNv>
+		static void													GemmTile( size_t _sSteps, const typename _tR::Scalar * _psA, const typename _tR::Scalar * _psB,
+			typename _tR::Scalar * _psC, size_t _sRowC, typename _tR::Scalar _sAlpha, typename _tR::Scalar _sBeta ) {
+			GemmTile<_tR, _sMr, _sNv>( _sSteps, _psA, _psB, _psC, _sRowC, _sAlpha, _sBeta, std::make_index_sequence<_sMr * _sNv>() );
+		}
+
+		/**
+		 * Computes the dot product of 2 arrays of bfloat16 bits in pairs, or the sum of the first if the second is nullptr, as Bf16Dot's
+		 *	kernels do: 4 accumulators, a tail padded with 0, and the accumulators folded pairwise at the end.  _tP extends the float
+		 *	register traits with Pairs (Lanes pairs of bfloat16 values), LoadPairs(), Set1Pair(), and Dp(), which adds the products of each
+		 *	lane's pairs to the lane.
+		 *
+		 * \tparam _tP The bfloat16 pair traits.
+		 * \param _pui16A The left array.
+		 * \param _pui16B The right array, or nullptr to sum _pui16A.
+		 * \param _sTotal The number of elements in each array.
+		 * \return Returns the dot product.
+		 **/
+		template <typename _tP>
+		static float												DotBf16( const uint16_t * _pui16A, const uint16_t * _pui16B, size_t _sTotal ) {
+			using Reg = typename _tP::Reg;
+			using Pairs = typename _tP::Pairs;
+			constexpr size_t sStep = _tP::Lanes * 2;
+			const uint16_t ui16One[2] = { 0x3F80, 0x3F80 };
+			const Pairs pOne = _tP::Set1Pair( ui16One );
+			const bool bSum = _pui16B == nullptr;
+
+			Reg rAcc0 = _tP::Zero(), rAcc1 = _tP::Zero(), rAcc2 = _tP::Zero(), rAcc3 = _tP::Zero();
+			size_t I = 0;
+			for ( ; I + sStep * 4 <= _sTotal; I += sStep * 4 ) {
+				rAcc0 = _tP::Dp( rAcc0, _tP::LoadPairs( _pui16A + I ), bSum ? pOne : _tP::LoadPairs( _pui16B + I ) );
+				rAcc1 = _tP::Dp( rAcc1, _tP::LoadPairs( _pui16A + I + sStep ), bSum ? pOne : _tP::LoadPairs( _pui16B + I + sStep ) );
+				rAcc2 = _tP::Dp( rAcc2, _tP::LoadPairs( _pui16A + I + sStep * 2 ), bSum ? pOne : _tP::LoadPairs( _pui16B + I + sStep * 2 ) );
+				rAcc3 = _tP::Dp( rAcc3, _tP::LoadPairs( _pui16A + I + sStep * 3 ), bSum ? pOne : _tP::LoadPairs( _pui16B + I + sStep * 3 ) );
+			}
+			for ( ; I + sStep <= _sTotal; I += sStep ) {
+				rAcc0 = _tP::Dp( rAcc0, _tP::LoadPairs( _pui16A + I ), bSum ? pOne : _tP::LoadPairs( _pui16B + I ) );
+			}
+			if ( I < _sTotal ) {
+				uint16_t ui16A[sStep] = {};
+				uint16_t ui16B[sStep] = {};
+				std::memcpy( ui16A, _pui16A + I, (_sTotal - I) * sizeof( uint16_t ) );
+				if ( !bSum ) { std::memcpy( ui16B, _pui16B + I, (_sTotal - I) * sizeof( uint16_t ) ); }
+				rAcc0 = _tP::Dp( rAcc0, _tP::LoadPairs( ui16A ), bSum ? pOne : _tP::LoadPairs( ui16B ) );
+			}
+			return Horizontal<_tP, Kernels::NN9_KR_SUM>( _tP::Add( _tP::Add( rAcc0, rAcc1 ), _tP::Add( rAcc2, rAcc3 ) ) );
+		}
+
+		/**
+		 * Computes a full _sMr x (_sNv * Lanes) tile of float C = alpha * A * B + beta * C from bfloat16 slivers packed in pairs, as
+		 *	Gemm::MicroKernel() does with a pair kernel.  When beta is 0, C is not read.
+		 *
+		 * \tparam _tP The bfloat16 pair traits (see DotBf16()).
+		 * \tparam _sMr The rows in the tile.
+		 * \tparam _sNv The registers across the tile.
+		 * \param _sSteps The depth of the slivers divided by 2.
+		 * \param _pui16A The packed sliver of A.
+		 * \param _pui16B The packed sliver of B.
+		 * \param _pfC The top-left element of the tile of C.
+		 * \param _sRowC The distance between rows of C.
+		 * \param _fAlpha The scale applied to A * B.
+		 * \param _fBeta The scale applied to the existing contents of C.
+		 **/
+		template <typename _tP, size_t _sMr, size_t _sNv>
+		static void													GemmBf16Tile( size_t _sSteps, const uint16_t * _pui16A, const uint16_t * _pui16B,
+			float * _pfC, size_t _sRowC, float _fAlpha, float _fBeta ) {
+			GemmBf16Tile<_tP, _sMr, _sNv>( _sSteps, _pui16A, _pui16B, _pfC, _sRowC, _fAlpha, _fBeta, std::make_index_sequence<_sMr * _sNv>() );
+		}
+
+		/**
+		 * Computes a full _sMr x (_sNv * Lanes) tile of int32_t C (or adds it to C) from a packed sliver of A and packed panels of B, as
+		 *	QGemm::MicroKernel() does.  _tQ provides Reg (Lanes int32_t accumulators), AOp (4 bytes of A in every lane), BOp (4 bytes of B
+		 *	for each lane), Lanes, Zero(), SetA(), LoadB(), Load(), Store(), Add(), and Dp().
+		 *
+		 * \tparam _tQ The int8_t register traits.
+		 * \tparam _sMr The rows in the tile.
+		 * \tparam _sNv The registers across the tile.
+		 * \param _sSteps The number of 4-deep groups.
+		 * \param _pui8A The packed sliver of A.
+		 * \param _pi8B The first group of the tile's first column in packed B.
+		 * \param _sPanelStride The bytes between the starts of 2 panels of B.
+		 * \param _pi32C The top-left element of the tile of C.
+		 * \param _sRowC The distance between rows of C.
+		 * \param _bAdd If true, the tile is added to C instead of replacing it.
+		 **/
+		template <typename _tQ, size_t _sMr, size_t _sNv>
+		static void													GemmI8Tile( size_t _sSteps, const uint8_t * _pui8A, const int8_t * _pi8B, size_t _sPanelStride,
+			int32_t * _pi32C, size_t _sRowC, bool _bAdd ) {
+			GemmI8Tile<_tQ, _sMr, _sNv>( _sSteps, _pui8A, _pi8B, _sPanelStride, _pi32C, _sRowC, _bAdd, std::make_index_sequence<_sMr * _sNv>() );
+		}
+
+		/**
+		 * Computes a tile of 1 to _sMaxCols output pixels of Conv2D's direct algorithm for 1 block of output channels, as
+		 *	Conv2D::DirectTile() does, by selecting the instantiation for the tile's width.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _sMaxCols The widest tile.
+		 * \param _sCols The number of output pixels in the tile, 1 to _sMaxCols.
+		 * \param _dlLayout The strides of the blocked buffers.
+		 * \param _psIn The blocked input at the first tap of the first pixel.
+		 * \param _psW The blocked weights of the output-channel block.
+		 * \param _psTile The output tile, [_sCols, Lanes].
+		 **/
+		template <typename _tR, size_t _sMaxCols>
+		static void													ConvTile( size_t _sCols, const Kernels::NN9_DIRECT_LAYOUT &_dlLayout, const typename _tR::Scalar * _psIn,
+			const typename _tR::Scalar * _psW, typename _tR::Scalar * _psTile ) {
+			ConvTile<_tR>( _sCols, _dlLayout, _psIn, _psW, _psTile, std::make_index_sequence<_sMaxCols>() );
+		}
+
+		/**
+		 * Applies an SGD step to a run of parameters, as Optimizer::SgdKernel() does.  _tParam is the register's Scalar, or uint16_t for
+		 *	bfloat16 bits, which are widened on load and narrowed by _tR::StoreSr().  The elements after the last full register go through a
+		 *	padded register.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _tParam The parameter type.
+		 * \param _sTotal The number of elements.
+		 * \param _ptParam The parameters.
+		 * \param _ptGrad The gradients.
+		 * \param _psMom The momentum buffer, or nullptr if the momentum is 0.
+		 * \param _scConsts The constants.
+		 * \param _ui32Key The stochastic-rounding key.
+		 * \param _ui32Idx The index of the first element within its tensor.
+		 **/
+		template <typename _tR, typename _tParam>
+		static void													Sgd( size_t _sTotal, _tParam * _ptParam, const _tParam * _ptGrad, typename _tR::Scalar * _psMom,
+			const Kernels::NN9_SGD_CONSTS<typename _tR::Scalar> &_scConsts, uint32_t _ui32Key, uint32_t _ui32Idx ) {
+			using Scalar = typename _tR::Scalar;
+			using Reg = typename _tR::Reg;
+			constexpr size_t L = _tR::Lanes;
+			const Reg rLr = _tR::Set1( _scConsts.sLr );
+			const Reg rMom = _tR::Set1( _scConsts.sMomentum );
+			const Reg rDamp = _tR::Set1( _scConsts.sDampening );
+			const Reg rWd = _tR::Set1( _scConsts.sWeightDecay );
+			const bool bWd = _scConsts.sWeightDecay != 0;
+			const bool bNesterov = _scConsts.bNesterov;
+			auto aStep = [&]( _tParam * _ptP, const _tParam * _ptG, Scalar * _psM, uint32_t _ui32I ) {
+				Reg rP = LoadParam<_tR>( _ptP );
+				Reg rG = LoadParam<_tR>( _ptG );
+				if ( bWd ) { rG = _tR::Add( rG, _tR::Mul( rWd, rP ) ); }
+				if ( _psM ) {
+					const Reg rB = _tR::Add( _tR::Mul( rMom, _tR::Load( _psM ) ), _tR::Mul( rDamp, rG ) );
+					_tR::Store( _psM, rB );
+					rG = bNesterov ? _tR::Add( rG, _tR::Mul( rMom, rB ) ) : rB;
+				}
+				StoreParam<_tR>( _ptP, _tR::Sub( rP, _tR::Mul( rLr, rG ) ), _ui32Key, _ui32I );
+			};
+
+			size_t I = 0;
+			for ( ; I + L <= _sTotal; I += L ) { aStep( _ptParam + I, _ptGrad + I, _psMom ? _psMom + I : nullptr, _ui32Idx + uint32_t( I ) ); }
+			if ( I < _sTotal ) {
+				const size_t sLeft = _sTotal - I;
+				_tParam tP[L] = {}, tG[L] = {};
+				Scalar sM[L] = {};
+				std::memcpy( tP, _ptParam + I, sLeft * sizeof( _tParam ) );
+				std::memcpy( tG, _ptGrad + I, sLeft * sizeof( _tParam ) );
+				if ( _psMom ) { std::memcpy( sM, _psMom + I, sLeft * sizeof( Scalar ) ); }
+				aStep( tP, tG, _psMom ? sM : nullptr, _ui32Idx + uint32_t( I ) );
+				std::memcpy( _ptParam + I, tP, sLeft * sizeof( _tParam ) );
+				if ( _psMom ) { std::memcpy( _psMom + I, sM, sLeft * sizeof( Scalar ) ); }
+			}
+		}
+
+		/**
+		 * Applies an Adam step to a run of parameters, as Optimizer::AdamKernel() does.  _tParam is as in Sgd().
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _tParam The parameter type.
+		 * \param _sTotal The number of elements.
+		 * \param _ptParam The parameters.
+		 * \param _ptGrad The gradients.
+		 * \param _psM The first moments.
+		 * \param _psV The second moments.
+		 * \param _acConsts The constants.
+		 * \param _ui32Key The stochastic-rounding key.
+		 * \param _ui32Idx The index of the first element within its tensor.
+		 **/
+		template <typename _tR, typename _tParam>
+		static void													Adam( size_t _sTotal, _tParam * _ptParam, const _tParam * _ptGrad, typename _tR::Scalar * _psM, typename _tR::Scalar * _psV,
+			const Kernels::NN9_ADAM_CONSTS<typename _tR::Scalar> &_acConsts, uint32_t _ui32Key, uint32_t _ui32Idx ) {
+			using Scalar = typename _tR::Scalar;
+			using Reg = typename _tR::Reg;
+			constexpr size_t L = _tR::Lanes;
+			const Reg rBeta1 = _tR::Set1( _acConsts.sBeta1 );
+			const Reg rOneMinusBeta1 = _tR::Set1( _acConsts.sOneMinusBeta1 );
+			const Reg rBeta2 = _tR::Set1( _acConsts.sBeta2 );
+			const Reg rOneMinusBeta2 = _tR::Set1( _acConsts.sOneMinusBeta2 );
+			const Reg rStepSize = _tR::Set1( _acConsts.sStepSize );
+			const Reg rInvSqrtBias2 = _tR::Set1( _acConsts.sInvSqrtBias2 );
+			const Reg rEps = _tR::Set1( _acConsts.sEps );
+			const Reg rL2 = _tR::Set1( _acConsts.sL2 );
+			const Reg rDecay = _tR::Set1( _acConsts.sDecay );
+			const bool bL2 = _acConsts.sL2 != 0;
+			const bool bDecay = _acConsts.sDecay != 1;
+			auto aStep = [&]( _tParam * _ptP, const _tParam * _ptG, Scalar * _psM1, Scalar * _psV1, uint32_t _ui32I ) {
+				Reg rP = LoadParam<_tR>( _ptP );
+				Reg rG = LoadParam<_tR>( _ptG );
+				if ( bL2 ) { rG = _tR::Add( rG, _tR::Mul( rL2, rP ) ); }
+				if ( bDecay ) { rP = _tR::Mul( rP, rDecay ); }
+				const Reg rM = _tR::Add( _tR::Mul( rBeta1, _tR::Load( _psM1 ) ), _tR::Mul( rOneMinusBeta1, rG ) );
+				const Reg rV = _tR::Add( _tR::Mul( rBeta2, _tR::Load( _psV1 ) ), _tR::Mul( rOneMinusBeta2, _tR::Mul( rG, rG ) ) );
+				_tR::Store( _psM1, rM );
+				_tR::Store( _psV1, rV );
+				const Reg rDenom = _tR::Add( _tR::Mul( _tR::Sqrt( rV ), rInvSqrtBias2 ), rEps );
+				StoreParam<_tR>( _ptP, _tR::Sub( rP, _tR::Div( _tR::Mul( rStepSize, rM ), rDenom ) ), _ui32Key, _ui32I );
+			};
+
+			size_t I = 0;
+			for ( ; I + L <= _sTotal; I += L ) { aStep( _ptParam + I, _ptGrad + I, _psM + I, _psV + I, _ui32Idx + uint32_t( I ) ); }
+			if ( I < _sTotal ) {
+				const size_t sLeft = _sTotal - I;
+				_tParam tP[L] = {}, tG[L] = {};
+				Scalar sM[L] = {}, sV[L] = {};
+				std::memcpy( tP, _ptParam + I, sLeft * sizeof( _tParam ) );
+				std::memcpy( tG, _ptGrad + I, sLeft * sizeof( _tParam ) );
+				std::memcpy( sM, _psM + I, sLeft * sizeof( Scalar ) );
+				std::memcpy( sV, _psV + I, sLeft * sizeof( Scalar ) );
+				aStep( tP, tG, sM, sV, _ui32Idx + uint32_t( I ) );
+				std::memcpy( _ptParam + I, tP, sLeft * sizeof( _tParam ) );
+				std::memcpy( _psM + I, sM, sLeft * sizeof( Scalar ) );
+				std::memcpy( _psV + I, sV, sLeft * sizeof( Scalar ) );
+			}
+		}
+
+		/**
+		 * Runs 1 instruction of a fused Graph kernel over a run, as Graph::Exec() does.  The elements after the last full register go
+		 *	through a padded register.
+		 *
+		 * \tparam _tR The register traits.
+		 * \param _kfOp The instruction.
+		 * \param _psA The left (or only) operand.
+		 * \param _psB The right operand.
+		 * \param _psOut The output.
+		 * \param _sTotal The number of elements.
+		 **/
+		template <typename _tR>
+		static void													Fused( Kernels::NN9_KERNEL_FUSED _kfOp, const typename _tR::Scalar * _psA, const typename _tR::Scalar * _psB,
+			typename _tR::Scalar * _psOut, size_t _sTotal ) {
+			using Reg = typename _tR::Reg;
+			constexpr size_t L = _tR::Lanes;
+			auto aUnary = [&]( auto _fFunc ) {
+				size_t I = 0;
+				for ( ; I + L <= _sTotal; I += L ) { _tR::Store( _psOut + I, _fFunc( _tR::Load( _psA + I ) ) ); }
+				if ( I < _sTotal ) { StorePart<_tR>( _psOut + I, _sTotal - I, _fFunc( LoadPart<_tR>( _psA + I, _sTotal - I, 0 ) ) ); }
+			};
+			auto aBinary = [&]( auto _fFunc ) {
+				size_t I = 0;
+				for ( ; I + L <= _sTotal; I += L ) { _tR::Store( _psOut + I, _fFunc( _tR::Load( _psA + I ), _tR::Load( _psB + I ) ) ); }
+				if ( I < _sTotal ) {
+					StorePart<_tR>( _psOut + I, _sTotal - I, _fFunc( LoadPart<_tR>( _psA + I, _sTotal - I, 1 ), LoadPart<_tR>( _psB + I, _sTotal - I, 1 ) ) );
+				}
+			};
+			switch ( _kfOp ) {
+				case Kernels::NN9_KF_NEG : { aUnary( []( Reg _rX ) { return _tR::Neg( _rX ); } ); break; }
+				case Kernels::NN9_KF_ABS : { aUnary( []( Reg _rX ) { return _tR::Abs( _rX ); } ); break; }
+				case Kernels::NN9_KF_SQUARE : { aUnary( []( Reg _rX ) { return _tR::Mul( _rX, _rX ); } ); break; }
+				case Kernels::NN9_KF_SQRT : { aUnary( []( Reg _rX ) { return _tR::Sqrt( _rX ); } ); break; }
+				case Kernels::NN9_KF_EXP : { aUnary( []( Reg _rX ) { return SimdMath::Exp( _rX ); } ); break; }
+				case Kernels::NN9_KF_LOG : { aUnary( []( Reg _rX ) { return SimdMath::Log( _rX ); } ); break; }
+				case Kernels::NN9_KF_TANH : { aUnary( []( Reg _rX ) { return SimdMath::Tanh( _rX ); } ); break; }
+				case Kernels::NN9_KF_SIGMOID : {
+					const Reg rOne = _tR::Set1( 1 );
+					aUnary( [&]( Reg _rX ) { return _tR::Div( rOne, _tR::Add( rOne, SimdMath::Exp( _tR::Neg( _rX ) ) ) ); } );
+					break;
+				}
+				case Kernels::NN9_KF_RELU : {
+					const Reg rZero = _tR::Zero();
+					aUnary( [&]( Reg _rX ) { return _tR::Greater( _rX, rZero ); } );
+					break;
+				}
+				case Kernels::NN9_KF_ADD : { aBinary( []( Reg _rA, Reg _rB ) { return _tR::Add( _rA, _rB ); } ); break; }
+				case Kernels::NN9_KF_SUB : { aBinary( []( Reg _rA, Reg _rB ) { return _tR::Sub( _rA, _rB ); } ); break; }
+				case Kernels::NN9_KF_MUL : { aBinary( []( Reg _rA, Reg _rB ) { return _tR::Mul( _rA, _rB ); } ); break; }
+				case Kernels::NN9_KF_DIV : { aBinary( []( Reg _rA, Reg _rB ) { return _tR::Div( _rA, _rB ); } ); break; }
+				case Kernels::NN9_KF_MAX : { aBinary( []( Reg _rA, Reg _rB ) { return _tR::Greater( _rA, _rB ); } ); break; }
+				case Kernels::NN9_KF_MIN : { aBinary( []( Reg _rA, Reg _rB ) { return _tR::Lesser( _rA, _rB ); } ); break; }
+				default : {}
+			}
+		}
+
+		/**
+		 * Reads 4 unaligned bytes as an int32_t.
+		 *
+		 * \param _pui8Src The bytes.
+		 * \return Returns the bytes as an int32_t.
+		 **/
+		static inline int32_t										Read32( const uint8_t * _pui8Src ) {
+			int32_t i32Ret;
+			std::memcpy( &i32Ret, _pui8Src, sizeof( i32Ret ) );
+			return i32Ret;
+		}
+
+		/**
+		 * Picks the lane holding the first extreme after an arg-extreme search in which each lane kept the first extreme of its own
+		 *	indices.  The lowest index wins ties between lanes.
+		 *
+		 * \tparam _bMax If true, the maximum is picked; otherwise the minimum.
+		 * \param _pfLanes The extreme of each lane.
+		 * \param _pi32Lanes The index of each lane's extreme.
+		 * \param _sLanes The number of lanes.
+		 * \return Returns the lane holding the first extreme.
+		 **/
+		template <bool _bMax>
+		static size_t												ArgLanes( const float * _pfLanes, const int32_t * _pi32Lanes, size_t _sLanes ) {
+			size_t sLane = 0;
+			for ( size_t J = 1; J < _sLanes; ++J ) {
+				if ( (_bMax ? _pfLanes[J] > _pfLanes[sLane] : _pfLanes[J] < _pfLanes[sLane]) ||
+					(_pfLanes[J] == _pfLanes[sLane] && _pi32Lanes[J] < _pi32Lanes[sLane]) ) { sLane = J; }
+			}
+			return sLane;
+		}
+
+		/**
+		 * Finishes an arg-extreme search 1 value at a time.  A NaN beats everything.
+		 *
+		 * \tparam _bMax If true, the maximum is found; otherwise the minimum.
+		 * \param _pfIn The values.
+		 * \param _sBegin The index of the first value left to search.
+		 * \param _sTotal The number of values.
+		 * \param _fBest The extreme so far.
+		 * \param _sBest The index of _fBest.
+		 * \return Returns the index of the first extreme, or of the first NaN.
+		 **/
+		template <bool _bMax>
+		static size_t												ArgFinish( const float * _pfIn, size_t _sBegin, size_t _sTotal, float _fBest, size_t _sBest ) {
+			if ( _fBest != _fBest ) { return _sBest; }
+			for ( size_t I = _sBegin; I < _sTotal; ++I ) {
+				const float fVal = _pfIn[I];
+				if ( fVal != fVal ) { return I; }
+				if ( _bMax ? fVal > _fBest : fVal < _fBest ) {
+					_fBest = fVal;
+					_sBest = I;
+				}
+			}
+			return _sBest;
+		}
+
+		/**
+		 * Folds the columns of a row into running extremes 1 at a time.
+		 *
+		 * \tparam _bMax If true, maximums are kept; otherwise minimums.
+		 * \param _pfRow The row.
+		 * \param _pfBest The extreme of each column.
+		 * \param _pui32Idx The row index of each column's extreme.
+		 * \param _ui32Row The index of the row.
+		 * \param _sBegin The first column to fold.
+		 * \param _sTotal The number of columns.
+		 **/
+		template <bool _bMax>
+		static void													ArgRowFinish( const float * _pfRow, float * _pfBest, uint32_t * _pui32Idx, uint32_t _ui32Row, size_t _sBegin, size_t _sTotal ) {
+			for ( size_t J = _sBegin; J < _sTotal; ++J ) {
+				const float fVal = _pfRow[J];
+				if ( _pfBest[J] == _pfBest[J] && (fVal != fVal || (_bMax ? fVal > _pfBest[J] : fVal < _pfBest[J])) ) {
+					_pfBest[J] = fVal;
+					_pui32Idx[J] = _ui32Row;
+				}
+			}
+		}
+
+		/**
+		 * Fills the conversion, element-wise, binary-operation, reduction, compensated-sum, softmax, GEMM, optimizer, and fused-instruction
+		 *	entries of a table.
+		 *
+		 * \tparam _tR32 The float register traits.
+		 * \tparam _tR64 The double register traits.
+		 * \tparam _sMr The rows in a GEMM tile.
+		 * \tparam _sNrF32 The columns in a float GEMM tile.
+		 * \tparam _sNrF64 The columns in a double GEMM tile.
+		 * \param _tTable The table to fill.
+		 * \param _kiGemm The tier whose tile sizes are given.
+		 **/
+		template <typename _tR32, typename _tR64, size_t _sMr, size_t _sNrF32, size_t _sNrF64>
+		static void													Fill( Kernels::NN9_TABLE &_tTable, Kernels::NN9_KERNEL_ISA _kiGemm ) {
+			static_assert( _sNrF32 % _tR32::Lanes == 0 && _sNrF64 % _tR64::Lanes == 0, "SimdKernels::Fill: A GEMM tile must be whole registers wide." );
+			FillConvert<_tR32>( _tTable.pfToF32, _tTable.pfFromF32, std::make_index_sequence<Kernels::NN9_KT_TOTAL>() );
+			FillConvert<_tR64>( _tTable.pfToF64, _tTable.pfFromF64, std::make_index_sequence<Kernels::NN9_KT_TOTAL>() );
+			FillUnary<_tR32>( _tTable.pfUnaryF32, std::make_index_sequence<Kernels::NN9_KU_TOTAL>() );
+			FillUnary<_tR64>( _tTable.pfUnaryF64, std::make_index_sequence<Kernels::NN9_KU_TOTAL>() );
+			FillBinary<_tR32>( _tTable.pfBinaryF32, std::make_index_sequence<Kernels::NN9_KB_TOTAL>() );
+			FillBinary<_tR64>( _tTable.pfBinaryF64, std::make_index_sequence<Kernels::NN9_KB_TOTAL>() );
+			FillFold<_tR32>( _tTable.pfFoldF32, _tTable.pfFoldRowF32, std::make_index_sequence<Kernels::NN9_KR_TOTAL>() );
+			FillFold<_tR64>( _tTable.pfFoldF64, _tTable.pfFoldRowF64, std::make_index_sequence<Kernels::NN9_KR_TOTAL>() );
+			FillKahan<_tR32>( _tTable.pfKahanF32, _tTable.pfKahanRowF32, std::index_sequence<Kernels::NN9_KR_SUM, Kernels::NN9_KR_SUM_SQ, Kernels::NN9_KR_SUM_ABS>() );
+			FillKahan<_tR64>( _tTable.pfKahanF64, _tTable.pfKahanRowF64, std::index_sequence<Kernels::NN9_KR_SUM, Kernels::NN9_KR_SUM_SQ, Kernels::NN9_KR_SUM_ABS>() );
+			_tTable.pfSoftmaxF32 = Softmax<_tR32>;
+			_tTable.pfSoftmaxF64 = Softmax<_tR64>;
+			_tTable.pfGemmF32 = GemmTile<_tR32, _sMr, _sNrF32 / _tR32::Lanes>;
+			_tTable.pfGemmF64 = GemmTile<_tR64, _sMr, _sNrF64 / _tR64::Lanes>;
+			_tTable.kiGemm = _kiGemm;
+			_tTable.pfSgdF32 = Sgd<_tR32, float>;
+			_tTable.pfSgdF64 = Sgd<_tR64, double>;
+			_tTable.pfSgdBf16 = Sgd<_tR32, uint16_t>;
+			_tTable.pfAdamF32 = Adam<_tR32, float>;
+			_tTable.pfAdamF64 = Adam<_tR64, double>;
+			_tTable.pfAdamBf16 = Adam<_tR32, uint16_t>;
+			_tTable.pfFusedF32 = Fused<_tR32>;
+			_tTable.pfFusedF64 = Fused<_tR64>;
+		}
+
+
+	protected :
+		// == Types.
+		/** Plain scalar registers, for the elements after the last full register. */
+		template <typename _tScalar>
+		struct NN9_SCALAR {
+			typedef _tScalar										Scalar;
+			typedef _tScalar										Reg;
+
+			static inline Reg										Add( Reg _rA, Reg _rB ) { return _rA + _rB; }
+			static inline Reg										Sub( Reg _rA, Reg _rB ) { return _rA - _rB; }
+			static inline Reg										Mul( Reg _rA, Reg _rB ) { return _rA * _rB; }
+			static inline Reg										Div( Reg _rA, Reg _rB ) { return _rA / _rB; }
+			static inline Reg										Abs( Reg _rA ) { return _rA < Scalar( 0 ) ? -_rA : _rA; }
+			static inline Reg										Max( Reg _rAcc, Reg _rVal ) { return (_rVal != _rVal || _rVal > _rAcc) ? _rVal : _rAcc; }
+			static inline Reg										Min( Reg _rAcc, Reg _rVal ) { return (_rVal != _rVal || _rVal < _rAcc) ? _rVal : _rAcc; }
+		};
+
+
+		// == Functions.
+		/**
+		 * Gets the size of an element type.
+		 *
+		 * \param _ktType The element type.
+		 * \return Returns the size of 1 element in bytes.
+		 **/
+		static constexpr size_t										TypeSize( Kernels::NN9_KERNEL_TYPE _ktType ) {
+			if ( _ktType == Kernels::NN9_KT_INT8 || _ktType == Kernels::NN9_KT_UINT8 ) { return 1; }
+			if ( _ktType == Kernels::NN9_KT_INT32 || _ktType == Kernels::NN9_KT_UINT32 || _ktType == Kernels::NN9_KT_FLOAT32 ) { return 4; }
+			return _ktType == Kernels::NN9_KT_FLOAT64 ? 8 : 2;
+		}
+
+		/**
+		 * Applies an element-wise operation to a register.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _kuOp The operation.
+		 * \param _rX The operand.
+		 * \return Returns op( _rX ).
+		 **/
+		template <typename _tR, Kernels::NN9_KERNEL_UNARY _kuOp>
+		static inline typename _tR::Reg								UnaryOp( typename _tR::Reg _rX ) {
+			if constexpr ( _kuOp == Kernels::NN9_KU_EXPM1 ) { return SimdMath::Expm1( _rX ); }
+			else if constexpr ( _kuOp == Kernels::NN9_KU_LOG1P ) { return SimdMath::Log1p( _rX ); }
+			else if constexpr ( _kuOp == Kernels::NN9_KU_SIN ) { return SimdMath::Sin( _rX ); }
+			else if constexpr ( _kuOp == Kernels::NN9_KU_COS ) { return SimdMath::Cos( _rX ); }
+			else if constexpr ( _kuOp == Kernels::NN9_KU_ERF ) { return SimdMath::Erf( _rX ); }
+			else if constexpr ( _kuOp == Kernels::NN9_KU_SQUARE ) { return _tR::Mul( _rX, _rX ); }
+			else if constexpr ( _kuOp == Kernels::NN9_KU_SQRT ) { return _tR::Sqrt( _rX ); }
+			else if constexpr ( _kuOp == Kernels::NN9_KU_RSQRT ) { return _tR::Div( _tR::Set1( 1 ), _tR::Sqrt( _rX ) ); }
+			else if constexpr ( _kuOp == Kernels::NN9_KU_CEIL ) { return _tR::Ceil( _rX ); }
+			else if constexpr ( _kuOp == Kernels::NN9_KU_FLOOR ) { return _tR::Floor( _rX ); }
+			else if constexpr ( _kuOp == Kernels::NN9_KU_ROUND ) { return _tR::Round( _rX ); }
+			else if constexpr ( _kuOp == Kernels::NN9_KU_ROUND_EVEN ) { return _tR::RoundEven( _rX ); }
+			else { return _tR::Abs( _rX ); }
+		}
+
+		/**
+		 * Applies a binary operation to 2 registers.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _kbOp The operation.
+		 * \param _rA The left operand.
+		 * \param _rB The right operand.
+		 * \return Returns _rA (op) _rB.
+		 **/
+		template <typename _tR, Kernels::NN9_KERNEL_BINARY _kbOp>
+		static inline typename _tR::Reg								BinaryOp( typename _tR::Reg _rA, typename _tR::Reg _rB ) {
+			if constexpr ( _kbOp == Kernels::NN9_KB_ADD ) { return _tR::Add( _rA, _rB ); }
+			else if constexpr ( _kbOp == Kernels::NN9_KB_SUB ) { return _tR::Sub( _rA, _rB ); }
+			else if constexpr ( _kbOp == Kernels::NN9_KB_MUL ) { return _tR::Mul( _rA, _rB ); }
+			else { return _tR::Div( _rA, _rB ); }
+		}
+
+		/**
+		 * Combines 2 partial results of a reduction.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _krOp The operation.
+		 * \param _rA The left partial result.
+		 * \param _rB The right partial result.
+		 * \return Returns the combined result.
+		 **/
+		template <typename _tR, Kernels::NN9_KERNEL_REDUCE _krOp>
+		static inline typename _tR::Reg								Combine( typename _tR::Reg _rA, typename _tR::Reg _rB ) {
+			if constexpr ( _krOp == Kernels::NN9_KR_MIN ) { return _tR::Min( _rA, _rB ); }
+			else if constexpr ( _krOp == Kernels::NN9_KR_MAX || _krOp == Kernels::NN9_KR_MAX_ABS ) { return _tR::Max( _rA, _rB ); }
+			else { return _tR::Add( _rA, _rB ); }
+		}
+
+		/**
+		 * Folds a value into an accumulator: the value, its square, or its absolute value is combined with the accumulator.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _krOp The operation.
+		 * \param _rAcc The accumulator.
+		 * \param _rVal The value.
+		 * \return Returns the updated accumulator.
+		 **/
+		template <typename _tR, Kernels::NN9_KERNEL_REDUCE _krOp>
+		static inline typename _tR::Reg								Step( typename _tR::Reg _rAcc, typename _tR::Reg _rVal ) {
+			return Combine<_tR, _krOp>( _rAcc, Term<_tR, _krOp>( _rVal ) );
+		}
+
+		/**
+		 * Gets the term that a value adds to a reduction: the value, its square, or its absolute value.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _krOp The operation.
+		 * \param _rVal The value.
+		 * \return Returns the term.
+		 **/
+		template <typename _tR, Kernels::NN9_KERNEL_REDUCE _krOp>
+		static inline typename _tR::Reg								Term( typename _tR::Reg _rVal ) {
+			if constexpr ( _krOp == Kernels::NN9_KR_SUM_SQ ) { return _tR::Mul( _rVal, _rVal ); }
+			else if constexpr ( _krOp == Kernels::NN9_KR_SUM_ABS || _krOp == Kernels::NN9_KR_MAX_ABS ) { return _tR::Abs( _rVal ); }
+			else { return _rVal; }
+		}
+
+		/**
+		 * Folds a value into a Kahan sum.  The true sum is _rSum - _rComp.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _krOp The operation.
+		 * \param _rSum The running sum.
+		 * \param _rComp The running compensation.
+		 * \param _rVal The value.
+		 **/
+		template <typename _tR, Kernels::NN9_KERNEL_REDUCE _krOp>
+		static inline void											KahanStep( typename _tR::Reg &_rSum, typename _tR::Reg &_rComp, typename _tR::Reg _rVal ) {
+			const auto rY = _tR::Sub( Term<_tR, _krOp>( _rVal ), _rComp );
+			const auto rT = _tR::Add( _rSum, rY );
+			_rComp = _tR::Sub( _tR::Sub( rT, _rSum ), rY );
+			_rSum = rT;
+		}
+
+		/**
+		 * Adds a value to a Neumaier sum.  The true sum is _sSum + _sComp.
+		 *
+		 * \tparam _tScalar The value type.
+		 * \param _sSum The running sum.
+		 * \param _sComp The running compensation.
+		 * \param _sVal The value to add.
+		 **/
+		template <typename _tScalar>
+		static inline void											Neumaier( _tScalar &_sSum, _tScalar &_sComp, _tScalar _sVal ) {
+			using S = NN9_SCALAR<_tScalar>;
+			const _tScalar sT = _sSum + _sVal;
+			if ( S::Abs( _sSum ) >= S::Abs( _sVal ) ) { _sComp += (_sSum - sT) + _sVal; }
+			else { _sComp += (_sVal - sT) + _sSum; }
+			_sSum = sT;
+		}
+
+		/**
+		 * Folds the lanes of a register pairwise.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _krOp The operation.
+		 * \param _rVal The register to fold.
+		 * \return Returns the folded lanes.
+		 **/
+		template <typename _tR, Kernels::NN9_KERNEL_REDUCE _krOp>
+		static inline typename _tR::Scalar							Horizontal( typename _tR::Reg _rVal ) {
+			typename _tR::Scalar sLanes[_tR::Lanes];
+			_tR::Store( sLanes, _rVal );
+			for ( size_t sWidth = _tR::Lanes / 2; sWidth; sWidth /= 2 ) {
+				for ( size_t I = 0; I < sWidth; ++I ) { sLanes[I] = Combine<NN9_SCALAR<typename _tR::Scalar>, _krOp>( sLanes[I], sLanes[I+sWidth] ); }
+			}
+			return sLanes[0];
+		}
+
+		/**
+		 * Gets the first lane of a register.
+		 *
+		 * \tparam _tR The register traits.
+		 * \param _rVal The register.
+		 * \return Returns the first lane.
+		 **/
+		template <typename _tR>
+		static inline typename _tR::Scalar							First( typename _tR::Reg _rVal ) {
+			typename _tR::Scalar sLanes[_tR::Lanes];
+			_tR::Store( sLanes, _rVal );
+			return sLanes[0];
+		}
+
+		/**
+		 * Loads fewer elements than a register holds, filling the remaining lanes with a given value.
+		 *
+		 * \tparam _tR The register traits.
+		 * \param _psSrc The elements.
+		 * \param _sTotal The number of elements, less than Lanes.
+		 * \param _sPad The value of the remaining lanes.
+		 * \return Returns the register.
+		 **/
+		template <typename _tR>
+		static inline typename _tR::Reg								LoadPart( const typename _tR::Scalar * _psSrc, size_t _sTotal, typename _tR::Scalar _sPad ) {
+			typename _tR::Scalar sLanes[_tR::Lanes];
+			for ( size_t I = 0; I < _tR::Lanes; ++I ) { sLanes[I] = I < _sTotal ? _psSrc[I] : _sPad; }
+			return _tR::Load( sLanes );
+		}
+
+		/**
+		 * Stores the first lanes of a register.
+		 *
+		 * \tparam _tR The register traits.
+		 * \param _psDst The destination.
+		 * \param _sTotal The number of lanes to store, less than Lanes.
+		 * \param _rVal The register.
+		 **/
+		template <typename _tR>
+		static inline void											StorePart( typename _tR::Scalar * _psDst, size_t _sTotal, typename _tR::Reg _rVal ) {
+			typename _tR::Scalar sLanes[_tR::Lanes];
+			_tR::Store( sLanes, _rVal );
+			for ( size_t I = 0; I < _sTotal; ++I ) { _psDst[I] = sLanes[I]; }
+		}
+
+		/**
+		 * Replaces -inf with 0.
+		 *
+		 * \tparam _tScalar The value type.
+		 * \param _sVal The value.
+		 * \return Returns 0 if _sVal is -inf, otherwise _sVal.
+		 **/
+		template <typename _tScalar>
+		static inline _tScalar										FiniteOrZero( _tScalar _sVal ) { return _sVal == -_tScalar( INFINITY ) ? _tScalar( 0 ) : _sVal; }
+
+		/**
+		 * Finds the largest value in a row.
+		 *
+		 * \tparam _tR The register traits.
+		 * \param _psIn The row.
+		 * \param _sCols The number of elements in the row.
+		 * \return Returns the largest value, or -inf for an empty row.
+		 **/
+		template <typename _tR>
+		static typename _tR::Scalar									RowMax( const typename _tR::Scalar * _psIn, size_t _sCols ) {
+			using Scalar = typename _tR::Scalar;
+			constexpr size_t L = _tR::Lanes;
+			auto rMax0 = _tR::Set1( -Scalar( INFINITY ) ), rMax1 = rMax0;
+			size_t I = 0;
+			for ( ; I + 2 * L <= _sCols; I += 2 * L ) {
+				rMax0 = _tR::Max( rMax0, _tR::Load( _psIn + I ) );
+				rMax1 = _tR::Max( rMax1, _tR::Load( _psIn + I + L ) );
+			}
+			for ( ; I + L <= _sCols; I += L ) { rMax0 = _tR::Max( rMax0, _tR::Load( _psIn + I ) ); }
+			if ( I < _sCols ) { rMax1 = _tR::Max( rMax1, LoadPart<_tR>( _psIn + I, _sCols - I, -Scalar( INFINITY ) ) ); }
+			return Horizontal<_tR, Kernels::NN9_KR_MAX>( _tR::Max( rMax0, rMax1 ) );
+		}
+
+		/**
+		 * Sums exp( x - max ) over a row, optionally keeping each exponential.
+		 *
+		 * \tparam _tR The register traits.
+		 * \param _psIn The row.
+		 * \param _sCols The number of elements in the row.
+		 * \param _sMax The largest value in the row.
+		 * \param _psExp If not nullptr, receives each exponential.  May be _psIn.
+		 * \return Returns the sum.
+		 **/
+		template <typename _tR>
+		static typename _tR::Scalar									RowSumExp( const typename _tR::Scalar * _psIn, size_t _sCols, typename _tR::Scalar _sMax, typename _tR::Scalar * _psExp ) {
+			using Scalar = typename _tR::Scalar;
+			constexpr size_t L = _tR::Lanes;
+			// A row of -inf subtracts 0 so that its exponentials are 0 rather than NaN.
+			const auto rMax = _tR::Set1( FiniteOrZero( _sMax ) );
+			auto rSum0 = _tR::Zero(), rSum1 = rSum0;
+			size_t I = 0;
+			for ( ; I + 2 * L <= _sCols; I += 2 * L ) {
+				const auto rE0 = SimdMath::Exp( _tR::Sub( _tR::Load( _psIn + I ), rMax ) );
+				const auto rE1 = SimdMath::Exp( _tR::Sub( _tR::Load( _psIn + I + L ), rMax ) );
+				if ( _psExp ) {
+					_tR::Store( _psExp + I, rE0 );
+					_tR::Store( _psExp + I + L, rE1 );
+				}
+				rSum0 = _tR::Add( rSum0, rE0 );
+				rSum1 = _tR::Add( rSum1, rE1 );
+			}
+			for ( ; I + L <= _sCols; I += L ) {
+				const auto rE = SimdMath::Exp( _tR::Sub( _tR::Load( _psIn + I ), rMax ) );
+				if ( _psExp ) { _tR::Store( _psExp + I, rE ); }
+				rSum0 = _tR::Add( rSum0, rE );
+			}
+			if ( I < _sCols ) {
+				// Padding with -inf gives exponentials of 0.
+				const auto rE = SimdMath::Exp( _tR::Sub( LoadPart<_tR>( _psIn + I, _sCols - I, -Scalar( INFINITY ) ), rMax ) );
+				if ( _psExp ) { StorePart<_tR>( _psExp + I, _sCols - I, rE ); }
+				rSum1 = _tR::Add( rSum1, rE );
+			}
+			return Horizontal<_tR, Kernels::NN9_KR_SUM>( _tR::Add( rSum0, rSum1 ) );
+		}
+
+		/**
+		 * Finds the largest value in a row and the sum of exp( x - max ) in 1 pass.  Each lane keeps its own maximum and sum, and when a block
+		 *	of registers raises the maximum, the sum is multiplied by exp( old - new ) once for the whole block.
+		 *
+		 * \tparam _tR The register traits.
+		 * \param _psIn The row.
+		 * \param _sCols The number of elements in the row.
+		 * \param _sMax Holds the returned maximum.
+		 * \param _sSum Holds the returned sum.
+		 **/
+		template <typename _tR>
+		static void													RowOnline( const typename _tR::Scalar * _psIn, size_t _sCols, typename _tR::Scalar &_sMax, typename _tR::Scalar &_sSum ) {
+			using Scalar = typename _tR::Scalar;
+			constexpr size_t L = _tR::Lanes;
+			auto rMax = _tR::Set1( -Scalar( INFINITY ) );
+			auto rSum = _tR::Zero();
+			size_t I = 0;
+			for ( ; I + 4 * L <= _sCols; I += 4 * L ) {
+				const auto rX0 = _tR::Load( _psIn + I ), rX1 = _tR::Load( _psIn + I + L );
+				const auto rX2 = _tR::Load( _psIn + I + 2 * L ), rX3 = _tR::Load( _psIn + I + 3 * L );
+				const auto rNew = _tR::Max( rMax, _tR::Max( _tR::Max( rX0, rX1 ), _tR::Max( rX2, rX3 ) ) );
+				// Lanes still at -inf subtract 0 so that exp() gives 0 rather than NaN.
+				const auto rSafe = _tR::FiniteOrZero( rNew );
+				const auto rE01 = _tR::Add( SimdMath::Exp( _tR::Sub( rX0, rSafe ) ), SimdMath::Exp( _tR::Sub( rX1, rSafe ) ) );
+				const auto rE23 = _tR::Add( SimdMath::Exp( _tR::Sub( rX2, rSafe ) ), SimdMath::Exp( _tR::Sub( rX3, rSafe ) ) );
+				rSum = _tR::Add( _tR::Mul( rSum, SimdMath::Exp( _tR::Sub( rMax, rSafe ) ) ), _tR::Add( rE01, rE23 ) );
+				rMax = rNew;
+			}
+			for ( ; I < _sCols; I += L ) {
+				const auto rX = I + L <= _sCols ? _tR::Load( _psIn + I ) : LoadPart<_tR>( _psIn + I, _sCols - I, -Scalar( INFINITY ) );
+				const auto rNew = _tR::Max( rMax, rX );
+				const auto rSafe = _tR::FiniteOrZero( rNew );
+				rSum = _tR::Add( _tR::Mul( rSum, SimdMath::Exp( _tR::Sub( rMax, rSafe ) ) ), SimdMath::Exp( _tR::Sub( rX, rSafe ) ) );
+				rMax = rNew;
+			}
+
+			// Rescale every lane to the row maximum.
+			const Scalar sMax = Horizontal<_tR, Kernels::NN9_KR_MAX>( rMax );
+			_sSum = Horizontal<_tR, Kernels::NN9_KR_SUM>( _tR::Mul( rSum, SimdMath::Exp( _tR::Sub( rMax, _tR::Set1( FiniteOrZero( sMax ) ) ) ) ) );
+			_sMax = sMax;
+		}
+
+		/**
+		 * Multiplies exponentials by a scale.
+		 *
+		 * \tparam _tR The register traits.
+		 * \param _psExp The exponentials.  May be _psOut.
+		 * \param _sCols The number of elements in the row.
+		 * \param _sScale The reciprocal of the sum.
+		 * \param _psOut The output row.
+		 **/
+		template <typename _tR>
+		static void													RowScale( const typename _tR::Scalar * _psExp, size_t _sCols, typename _tR::Scalar _sScale, typename _tR::Scalar * _psOut ) {
+			constexpr size_t L = _tR::Lanes;
+			const auto rScale = _tR::Set1( _sScale );
+			size_t I = 0;
+			for ( ; I + L <= _sCols; I += L ) { _tR::Store( _psOut + I, _tR::Mul( _tR::Load( _psExp + I ), rScale ) ); }
+			for ( ; I < _sCols; ++I ) { _psOut[I] = _psExp[I] * _sScale; }
+		}
+
+		/**
+		 * Writes exp( x - max ) multiplied by a scale.
+		 *
+		 * \tparam _tR The register traits.
+		 * \param _psIn The row.  May be _psOut.
+		 * \param _sCols The number of elements in the row.
+		 * \param _sMax The largest value in the row.
+		 * \param _sScale The reciprocal of the sum.
+		 * \param _psOut The output row.
+		 **/
+		template <typename _tR>
+		static void													RowExpScale( const typename _tR::Scalar * _psIn, size_t _sCols, typename _tR::Scalar _sMax, typename _tR::Scalar _sScale,
+			typename _tR::Scalar * _psOut ) {
+			constexpr size_t L = _tR::Lanes;
+			const auto rMax = _tR::Set1( FiniteOrZero( _sMax ) ), rScale = _tR::Set1( _sScale );
+			size_t I = 0;
+			for ( ; I + L <= _sCols; I += L ) { _tR::Store( _psOut + I, _tR::Mul( SimdMath::Exp( _tR::Sub( _tR::Load( _psIn + I ), rMax ) ), rScale ) ); }
+			if ( I < _sCols ) {
+				StorePart<_tR>( _psOut + I, _sCols - I, _tR::Mul( SimdMath::Exp( _tR::Sub( LoadPart<_tR>( _psIn + I, _sCols - I, 0 ), rMax ) ), rScale ) );
+			}
+		}
+
+		/**
+		 * Writes x - log( sum( exp( x ) ) ).
+		 *
+		 * \tparam _tR The register traits.
+		 * \param _psIn The row.  May be _psOut.
+		 * \param _sCols The number of elements in the row.
+		 * \param _sLse The log of the sum of the exponentials.
+		 * \param _psOut The output row.
+		 **/
+		template <typename _tR>
+		static void													RowSubtract( const typename _tR::Scalar * _psIn, size_t _sCols, typename _tR::Scalar _sLse, typename _tR::Scalar * _psOut ) {
+			constexpr size_t L = _tR::Lanes;
+			const auto rLse = _tR::Set1( _sLse );
+			size_t I = 0;
+			for ( ; I + L <= _sCols; I += L ) { _tR::Store( _psOut + I, _tR::Sub( _tR::Load( _psIn + I ), rLse ) ); }
+			for ( ; I < _sCols; ++I ) { _psOut[I] = _psIn[I] - _sLse; }
+		}
+
+		/**
+		 * Computes a full GEMM tile.  The accumulators are expanded from an index sequence rather than looped over so that every compiler
+		 *	keeps them in registers.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _sMr The rows in the tile.
+		 * \tparam _sNv The registers across the tile.
+		 * \tparam _sIdx The accumulator indices, 0 to _sMr * _sNv - 1; accumulator I holds row I / _sNv, register I % _sNv.
+		 * \param _sSteps The depth of the slivers.
+		 * \param _psA The packed sliver of A.
+		 * \param _psB The packed sliver of B.
+		 * \param _psC The top-left element of the tile of C.
+		 * \param _sRowC The distance between rows of C.
+		 * \param _sAlpha The scale applied to A * B.
+		 * \param _sBeta The scale applied to the existing contents of C.
+		 **/
+		template <typename _tR, size_t _sMr, size_t _sNv, size_t ... _sIdx>
+		static inline void											GemmTile( size_t _sSteps, const typename _tR::Scalar * _psA, const typename _tR::Scalar * _psB,
+			typename _tR::Scalar * _psC, size_t _sRowC, typename _tR::Scalar _sAlpha, typename _tR::Scalar _sBeta, std::index_sequence<_sIdx...> ) {
+			using Reg = typename _tR::Reg;
+			constexpr size_t L = _tR::Lanes;
+
+			Reg rAcc[_sMr*_sNv] = { ((void)_sIdx, _tR::Zero())... };
+			for ( size_t K = 0; K < _sSteps; ++K ) {
+				Reg rB[_sNv];
+				for ( size_t V = 0; V < _sNv; ++V ) { rB[V] = _tR::Load( _psB + V * L ); }
+				((rAcc[_sIdx] = _tR::Fma( _tR::Set1( _psA[_sIdx/_sNv] ), rB[_sIdx%_sNv], rAcc[_sIdx] )), ...);
+				_psA += _sMr;
+				_psB += _sNv * L;
+			}
+
+			GemmStore<_tR, _sNv, _sIdx...>( rAcc, _psC, _sRowC, _sAlpha, _sBeta );
+		}
+
+		/**
+		 * Computes a full bfloat16 pair GEMM tile.  The accumulators are expanded from an index sequence so that every compiler keeps them
+		 *	in registers.
+		 *
+		 * \tparam _tP The bfloat16 pair traits.
+		 * \tparam _sMr The rows in the tile.
+		 * \tparam _sNv The registers across the tile.
+		 * \tparam _sIdx The accumulator indices, 0 to _sMr * _sNv - 1; accumulator I holds row I / _sNv, register I % _sNv.
+		 * \param _sSteps The depth of the slivers divided by 2.
+		 * \param _pui16A The packed sliver of A.
+		 * \param _pui16B The packed sliver of B.
+		 * \param _pfC The top-left element of the tile of C.
+		 * \param _sRowC The distance between rows of C.
+		 * \param _fAlpha The scale applied to A * B.
+		 * \param _fBeta The scale applied to the existing contents of C.
+		 **/
+		template <typename _tP, size_t _sMr, size_t _sNv, size_t ... _sIdx>
+		static inline void											GemmBf16Tile( size_t _sSteps, const uint16_t * _pui16A, const uint16_t * _pui16B,
+			float * _pfC, size_t _sRowC, float _fAlpha, float _fBeta, std::index_sequence<_sIdx...> ) {
+			using Reg = typename _tP::Reg;
+			constexpr size_t L = _tP::Lanes;
+
+			Reg rAcc[_sMr*_sNv] = { ((void)_sIdx, _tP::Zero())... };
+			for ( size_t K = 0; K < _sSteps; ++K ) {
+				typename _tP::Pairs pB[_sNv];
+				for ( size_t V = 0; V < _sNv; ++V ) { pB[V] = _tP::LoadPairs( _pui16B + V * L * 2 ); }
+				((rAcc[_sIdx] = _tP::Dp( rAcc[_sIdx], _tP::Set1Pair( _pui16A + (_sIdx / _sNv) * 2 ), pB[_sIdx%_sNv] )), ...);
+				_pui16A += _sMr * 2;
+				_pui16B += _sNv * L * 2;
+			}
+
+			GemmStore<_tP, _sNv, _sIdx...>( rAcc, _pfC, _sRowC, _fAlpha, _fBeta );
+		}
+
+		/**
+		 * Loads a register of optimizer parameters or gradients, widening bfloat16 bits.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _tParam The parameter type: the register's Scalar, or uint16_t for bfloat16 bits.
+		 * \param _ptSrc The values.
+		 * \return Returns the values.
+		 **/
+		template <typename _tR, typename _tParam>
+		static inline typename _tR::Reg								LoadParam( const _tParam * _ptSrc ) {
+			if constexpr ( std::is_same<_tParam, uint16_t>::value ) { return _tR::template LoadAs<Kernels::NN9_KT_BFLOAT16>( _ptSrc ); }
+			else { return _tR::Load( _ptSrc ); }
+		}
+
+		/**
+		 * Stores a register of updated optimizer parameters, rounding bfloat16 bits stochastically.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _tParam The parameter type: the register's Scalar, or uint16_t for bfloat16 bits.
+		 * \param _ptDst The destination.
+		 * \param _rVal The values.
+		 * \param _ui32Key The stochastic-rounding key.
+		 * \param _ui32Idx The index of the first element.
+		 **/
+		template <typename _tR, typename _tParam>
+		static inline void											StoreParam( _tParam * _ptDst, typename _tR::Reg _rVal, uint32_t _ui32Key, uint32_t _ui32Idx ) {
+			if constexpr ( std::is_same<_tParam, uint16_t>::value ) { _tR::StoreSr( _ptDst, _rVal, _ui32Key, _ui32Idx ); }
+			else { _tR::Store( _ptDst, _rVal ); }
+		}
+
+		/**
+		 * Scales the accumulators of a GEMM tile and stores them to C, adding beta times the existing contents of C unless beta is 0.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _sNv The registers across the tile.
+		 * \tparam _sIdx The accumulator indices; accumulator I holds row I / _sNv, register I % _sNv.
+		 * \param _prAcc The accumulators.
+		 * \param _psC The top-left element of the tile of C.
+		 * \param _sRowC The distance between rows of C.
+		 * \param _sAlpha The scale applied to the accumulators.
+		 * \param _sBeta The scale applied to the existing contents of C.
+		 **/
+		template <typename _tR, size_t _sNv, size_t ... _sIdx>
+		static inline void											GemmStore( const typename _tR::Reg * _prAcc, typename _tR::Scalar * _psC, size_t _sRowC,
+			typename _tR::Scalar _sAlpha, typename _tR::Scalar _sBeta ) {
+			using Reg = typename _tR::Reg;
+			constexpr size_t L = _tR::Lanes;
+
+			Reg rAlpha = _tR::Set1( _sAlpha );
+			if ( _sBeta == 0 ) {
+				(_tR::Store( _psC + (_sIdx / _sNv) * _sRowC + (_sIdx % _sNv) * L, _tR::Mul( _prAcc[_sIdx], rAlpha ) ), ...);
+			}
+			else {
+				Reg rBeta = _tR::Set1( _sBeta );
+				(_tR::Store( _psC + (_sIdx / _sNv) * _sRowC + (_sIdx % _sNv) * L,
+					_tR::Fma( _tR::Load( _psC + (_sIdx / _sNv) * _sRowC + (_sIdx % _sNv) * L ), rBeta, _tR::Mul( _prAcc[_sIdx], rAlpha ) ) ), ...);
+			}
+		}
+
+		/**
+		 * Computes a full int8_t GEMM tile.  The accumulators are expanded from an index sequence so that every compiler keeps them in
+		 *	registers.
+		 *
+		 * \tparam _tQ The int8_t register traits.
+		 * \tparam _sMr The rows in the tile.
+		 * \tparam _sNv The registers across the tile.
+		 * \tparam _sIdx The accumulator indices, 0 to _sMr * _sNv - 1; accumulator I holds row I / _sNv, register I % _sNv.
+		 * \param _sSteps The number of 4-deep groups.
+		 * \param _pui8A The packed sliver of A.
+		 * \param _pi8B The first group of the tile's first column in packed B.
+		 * \param _sPanelStride The bytes between the starts of 2 panels of B.
+		 * \param _pi32C The top-left element of the tile of C.
+		 * \param _sRowC The distance between rows of C.
+		 * \param _bAdd If true, the tile is added to C instead of replacing it.
+		 **/
+		template <typename _tQ, size_t _sMr, size_t _sNv, size_t ... _sIdx>
+		static inline void											GemmI8Tile( size_t _sSteps, const uint8_t * _pui8A, const int8_t * _pi8B, size_t _sPanelStride,
+			int32_t * _pi32C, size_t _sRowC, bool _bAdd, std::index_sequence<_sIdx...> ) {
+			using Reg = typename _tQ::Reg;
+			constexpr size_t L = _tQ::Lanes;
+			constexpr size_t sPanel = Kernels::NN9_KG_I8_PANEL;
+			constexpr size_t sGroup = Kernels::NN9_KG_I8_KGROUP;
+
+			// Register V covers columns V * Lanes and up, which may lie in a later panel.
+			const int8_t * pi8B[_sNv];
+			for ( size_t V = 0; V < _sNv; ++V ) {
+				pi8B[V] = _pi8B + ((V * L) / sPanel) * _sPanelStride + ((V * L) % sPanel) * sGroup;
+			}
+			Reg rAcc[_sMr*_sNv] = { ((void)_sIdx, _tQ::Zero())... };
+			for ( size_t K = 0; K < _sSteps; ++K ) {
+				typename _tQ::BOp bB[_sNv];
+				for ( size_t V = 0; V < _sNv; ++V ) { bB[V] = _tQ::LoadB( pi8B[V] + K * sPanel * sGroup ); }
+				((rAcc[_sIdx] = _tQ::Dp( rAcc[_sIdx], _tQ::SetA( _pui8A + (_sIdx / _sNv) * sGroup ), bB[_sIdx%_sNv] )), ...);
+				_pui8A += _sMr * sGroup;
+			}
+
+			if ( _bAdd ) {
+				(_tQ::Store( _pi32C + (_sIdx / _sNv) * _sRowC + (_sIdx % _sNv) * L,
+					_tQ::Add( _tQ::Load( _pi32C + (_sIdx / _sNv) * _sRowC + (_sIdx % _sNv) * L ), rAcc[_sIdx] ) ), ...);
+			}
+			else {
+				(_tQ::Store( _pi32C + (_sIdx / _sNv) * _sRowC + (_sIdx % _sNv) * L, rAcc[_sIdx] ), ...);
+			}
+		}
+
+		/**
+		 * Selects the direct convolution kernel for a tile's width.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _sWidths The tile widths less 1.
+		 * \param _sCols The number of output pixels in the tile.
+		 * \param _dlLayout The strides of the blocked buffers.
+		 * \param _psIn The blocked input at the first tap of the first pixel.
+		 * \param _psW The blocked weights of the output-channel block.
+		 * \param _psTile The output tile.
+		 **/
+		template <typename _tR, size_t ... _sWidths>
+		static inline void											ConvTile( size_t _sCols, const Kernels::NN9_DIRECT_LAYOUT &_dlLayout, const typename _tR::Scalar * _psIn,
+			const typename _tR::Scalar * _psW, typename _tR::Scalar * _psTile, std::index_sequence<_sWidths...> ) {
+			using Scalar = typename _tR::Scalar;
+			typedef void (* PfTile)( const Kernels::NN9_DIRECT_LAYOUT &, const Scalar *, const Scalar *, Scalar * );
+			static constexpr PfTile pfTiles[] = { &ConvKernel<_tR, _sWidths + 1>... };
+			pfTiles[_sCols-1]( _dlLayout, _psIn, _psW, _psTile );
+		}
+
+		/**
+		 * The direct convolution kernel for a tile of _sCols output pixels.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _sCols The number of output pixels in the tile.
+		 * \param _dlLayout The strides of the blocked buffers.
+		 * \param _psIn The blocked input at the first tap of the first pixel.
+		 * \param _psW The blocked weights of the output-channel block.
+		 * \param _psTile The output tile, [_sCols, Lanes].
+		 **/
+		template <typename _tR, size_t _sCols>
+		static void													ConvKernel( const Kernels::NN9_DIRECT_LAYOUT &_dlLayout, const typename _tR::Scalar * _psIn,
+			const typename _tR::Scalar * _psW, typename _tR::Scalar * _psTile ) {
+			ConvKernel<_tR>( _dlLayout, _psIn, _psW, _psTile, std::make_index_sequence<_sCols>() );
+		}
+
+		/**
+		 * The direct convolution kernel, as Conv2D::DirectKernel() computes it.  Each input value is broadcast and multiplied by a register
+		 *	of weights, 1 per output channel of the block, into the accumulator of its pixel.  The accumulators are expanded from an index
+		 *	sequence so that every compiler keeps them in registers.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _sIdx The pixel indices, 0 to the tile width - 1.
+		 * \param _dlLayout The strides of the blocked buffers.
+		 * \param _psIn The blocked input at the first tap of the first pixel.
+		 * \param _psW The blocked weights of the output-channel block.
+		 * \param _psTile The output tile, [width, Lanes].
+		 **/
+		template <typename _tR, size_t ... _sIdx>
+		static inline void											ConvKernel( const Kernels::NN9_DIRECT_LAYOUT &_dlLayout, const typename _tR::Scalar * _psIn,
+			const typename _tR::Scalar * _psW, typename _tR::Scalar * _psTile, std::index_sequence<_sIdx...> ) {
+			using Reg = typename _tR::Reg;
+			constexpr size_t L = _tR::Lanes;
+			const size_t sPixel = _dlLayout.sPixel;
+
+			Reg rAcc[sizeof...( _sIdx )] = { ((void)_sIdx, _tR::Zero())... };
+			for ( size_t B = 0; B < _dlLayout.sBlocks; ++B ) {
+				const size_t sChannels = B + 1 == _dlLayout.sBlocks ? _dlLayout.sLastLanes : L;
+				for ( size_t KY = 0; KY < _dlLayout.sKh; ++KY ) {
+					for ( size_t KX = 0; KX < _dlLayout.sKw; ++KX ) {
+						const typename _tR::Scalar * psIn = _psIn + B * _dlLayout.sBlockIn + KY * _dlLayout.sTapY + KX * _dlLayout.sTapX;
+						const typename _tR::Scalar * psW = _psW + ((B * _dlLayout.sKh + KY) * _dlLayout.sKw + KX) * L * L;
+						for ( size_t C = 0; C < sChannels; ++C ) {
+							const Reg rW = _tR::Load( psW + C * L );
+							((rAcc[_sIdx] = _tR::Fma( _tR::Set1( psIn[_sIdx*sPixel+C] ), rW, rAcc[_sIdx] )), ...);
+						}
+					}
+				}
+			}
+			(_tR::Store( _psTile + _sIdx * L, rAcc[_sIdx] ), ...);
+		}
+
+		/**
+		 * Fills the binary-operation entries of a table.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _tKernel The entry type.
+		 * \tparam _sOp The operations, 0 to NN9_KB_TOTAL - 1.
+		 * \param _pkDst The entries to fill.
+		 **/
+		template <typename _tR, typename _tKernel, size_t ... _sOp>
+		static void													FillBinary( _tKernel * _pkDst, std::index_sequence<_sOp...> ) {
+			((_pkDst[_sOp] = Binary<_tR, Kernels::NN9_KERNEL_BINARY( _sOp )>), ...);
+		}
+
+		/**
+		 * Fills the conversion entries of a table.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _tTo The widening entry type.
+		 * \tparam _tFrom The narrowing entry type.
+		 * \tparam _sType The element types, 0 to NN9_KT_TOTAL - 1.
+		 * \param _ptDst The widening entries to fill.
+		 * \param _pfDst The narrowing entries to fill.
+		 **/
+		template <typename _tR, typename _tTo, typename _tFrom, size_t ... _sType>
+		static void													FillConvert( _tTo * _ptDst, _tFrom * _pfDst, std::index_sequence<_sType...> ) {
+			((_ptDst[_sType] = ToReal<_tR, Kernels::NN9_KERNEL_TYPE( _sType )>), ...);
+			((_pfDst[_sType] = FromReal<_tR, Kernels::NN9_KERNEL_TYPE( _sType )>), ...);
+		}
+
+		/**
+		 * Fills the element-wise entries of a table.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _tKernel The entry type.
+		 * \tparam _sOp The operations, 0 to NN9_KU_TOTAL - 1.
+		 * \param _pkDst The entries to fill.
+		 **/
+		template <typename _tR, typename _tKernel, size_t ... _sOp>
+		static void													FillUnary( _tKernel * _pkDst, std::index_sequence<_sOp...> ) {
+			((_pkDst[_sOp] = Unary<_tR, Kernels::NN9_KERNEL_UNARY( _sOp )>), ...);
+		}
+
+		/**
+		 * Fills the reduction entries of a table.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _tFold The run entry type.
+		 * \tparam _tFoldRow The row entry type.
+		 * \tparam _sOp The operations, 0 to NN9_KR_TOTAL - 1.
+		 * \param _pfDst The run entries to fill.
+		 * \param _pfrDst The row entries to fill.
+		 **/
+		template <typename _tR, typename _tFold, typename _tFoldRow, size_t ... _sOp>
+		static void													FillFold( _tFold * _pfDst, _tFoldRow * _pfrDst, std::index_sequence<_sOp...> ) {
+			((_pfDst[_sOp] = Fold<_tR, Kernels::NN9_KERNEL_REDUCE( _sOp )>), ...);
+			((_pfrDst[_sOp] = FoldRow<_tR, Kernels::NN9_KERNEL_REDUCE( _sOp )>), ...);
+		}
+
+		/**
+		 * Fills the compensated-sum entries of a table.
+		 *
+		 * \tparam _tR The register traits.
+		 * \tparam _tKahan The run entry type.
+		 * \tparam _tKahanRow The row entry type.
+		 * \tparam _sOp The sums.
+		 * \param _pkDst The run entries to fill.
+		 * \param _pkrDst The row entries to fill.
+		 **/
+		template <typename _tR, typename _tKahan, typename _tKahanRow, size_t ... _sOp>
+		static void													FillKahan( _tKahan * _pkDst, _tKahanRow * _pkrDst, std::index_sequence<_sOp...> ) {
+			((_pkDst[_sOp] = Kahan<_tR, Kernels::NN9_KERNEL_REDUCE( _sOp )>), ...);
+			((_pkrDst[_sOp] = KahanRow<_tR, Kernels::NN9_KERNEL_REDUCE( _sOp )>), ...);
+		}
+	};
+
+}	// namespace
+}	// namespace nn9
@@ -0,0 +1,145 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: The SSE4.2 kernels.  Compile this file with SSE4.2 enabled (-msse4.2 on GCC and Clang; on MSVC, which has no such flag
+ *	and never defines them, define __SSE4_1__ and __SSE4_2__ for this file).  Nothing outside of NN9SimdMath.h and the system headers may
+ *	be included here, and everything but Kernels::FillSse42() stays in an anonymous namespace (see Kernels).
+ */
+
+#include "NN9Kernels.h"
+#define NN9_SIMDMATH_LOCAL
+#include "NN9SimdMath.h"
+
+
+namespace nn9 {
+
+#ifdef __SSE4_1__
+namespace {
+
+	/**
+	 * Applies a SimdMath function to 4 floats at a time, finishing with the plain C++ kernel.
+	 *
+	 * \param _pfIn The input.
+	 * \param _pfOut The output.
+	 * \param _sTotal The number of elements.
+	 * \param _fSimd The function to call on each register.
+	 * \param _pfTail The kernel to call on the remaining elements.
+	 **/
+	template <typename _tSimd>
+	inline void UnaryF32( const float * _pfIn, float * _pfOut, size_t _sTotal, _tSimd _fSimd, void (*_pfTail)( const float *, float *, size_t ) ) {
+		size_t I = 0;
+		for ( ; I + 4 <= _sTotal; I += 4 ) { _mm_storeu_ps( _pfOut + I, _fSimd( _mm_loadu_ps( _pfIn + I ) ) ); }
+		if ( I < _sTotal ) { _pfTail( _pfIn + I, _pfOut + I, _sTotal - I ); }
+	}
+
+	/**
+	 * Applies a SimdMath function to 2 doubles at a time, finishing with the plain C++ kernel.
+	 *
+	 * \param _pdIn The input.
+	 * \param _pdOut The output.
+	 * \param _sTotal The number of elements.
+	 * \param _fSimd The function to call on each register.
+	 * \param _pfTail The kernel to call on the remaining elements.
+	 **/
+	template <typename _tSimd>
+	inline void UnaryF64( const double * _pdIn, double * _pdOut, size_t _sTotal, _tSimd _fSimd, void (*_pfTail)( const double *, double *, size_t ) ) {
+		size_t I = 0;
+		for ( ; I + 2 <= _sTotal; I += 2 ) { _mm_storeu_pd( _pdOut + I, _fSimd( _mm_loadu_pd( _pdIn + I ) ) ); }
+		if ( I < _sTotal ) { _pfTail( _pdIn + I, _pdOut + I, _sTotal - I ); }
+	}
+
+	// The kernels.  See Kernels::NN9_TABLE for what each computes.
+	void ExpF32( const float * _pfIn, float * _pfOut, size_t _sTotal ) {
+		UnaryF32( _pfIn, _pfOut, _sTotal, []( __m128 _rX ) { return SimdMath::Exp( _rX ); }, Kernels::ScalarExpF32 );
+	}
+
+	void LogF32( const float * _pfIn, float * _pfOut, size_t _sTotal ) {
+		UnaryF32( _pfIn, _pfOut, _sTotal, []( __m128 _rX ) { return SimdMath::Log( _rX ); }, Kernels::ScalarLogF32 );
+	}
+
+	void TanhF32( const float * _pfIn, float * _pfOut, size_t _sTotal ) {
+		UnaryF32( _pfIn, _pfOut, _sTotal, []( __m128 _rX ) { return SimdMath::Tanh( _rX ); }, Kernels::ScalarTanhF32 );
+	}
+
+	void ExpF64( const double * _pdIn, double * _pdOut, size_t _sTotal ) {
+		UnaryF64( _pdIn, _pdOut, _sTotal, []( __m128d _rX ) { return SimdMath::Exp( _rX ); }, Kernels::ScalarExpF64 );
+	}
+
+	void LogF64( const double * _pdIn, double * _pdOut, size_t _sTotal ) {
+		UnaryF64( _pdIn, _pdOut, _sTotal, []( __m128d _rX ) { return SimdMath::Log( _rX ); }, Kernels::ScalarLogF64 );
+	}
+
+	void TanhF64( const double * _pdIn, double * _pdOut, size_t _sTotal ) {
+		UnaryF64( _pdIn, _pdOut, _sTotal, []( __m128d _rX ) { return SimdMath::Tanh( _rX ); }, Kernels::ScalarTanhF64 );
+	}
+
+	void Bf16ToF32( const uint16_t * _pui16In, float * _pfOut, size_t _sTotal ) {
+		size_t I = 0;
+		for ( ; I + 8 <= _sTotal; I += 8 ) {
+			// Interleaving with 0's puts each bfloat16 in the high half of its float.
+			__m128i mBits = _mm_loadu_si128( reinterpret_cast<const __m128i *>(_pui16In + I) );
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(_pfOut + I), _mm_unpacklo_epi16( _mm_setzero_si128(), mBits ) );
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(_pfOut + I + 4), _mm_unpackhi_epi16( _mm_setzero_si128(), mBits ) );
+		}
+		if ( I < _sTotal ) { Kernels::ScalarBf16ToF32( _pui16In + I, _pfOut + I, _sTotal - I ); }
+	}
+
+	void F32ToBf16( const float * _pfIn, uint16_t * _pui16Out, size_t _sTotal ) {
+		size_t I = 0;
+		for ( ; I + 8 <= _sTotal; I += 8 ) {
+			__m128i mLo = _mm_srli_epi32( _mm_castps_si128( _mm_loadu_ps( _pfIn + I ) ), 16 );
+			__m128i mHi = _mm_srli_epi32( _mm_castps_si128( _mm_loadu_ps( _pfIn + I + 4 ) ), 16 );
+			_mm_storeu_si128( reinterpret_cast<__m128i *>(_pui16Out + I), _mm_packus_epi32( mLo, mHi ) );
+		}
+		if ( I < _sTotal ) { Kernels::ScalarF32ToBf16( _pfIn + I, _pui16Out + I, _sTotal - I ); }
+	}
+
+	void F32ToF64( const float * _pfIn, double * _pdOut, size_t _sTotal ) {
+		size_t I = 0;
+		for ( ; I + 4 <= _sTotal; I += 4 ) {
+			__m128 mVal = _mm_loadu_ps( _pfIn + I );
+			_mm_storeu_pd( _pdOut + I, _mm_cvtps_pd( mVal ) );
+			_mm_storeu_pd( _pdOut + I + 2, _mm_cvtps_pd( _mm_movehl_ps( mVal, mVal ) ) );
+		}
+		if ( I < _sTotal ) { Kernels::ScalarF32ToF64( _pfIn + I, _pdOut + I, _sTotal - I ); }
+	}
+
+	void F64ToF32( const double * _pdIn, float * _pfOut, size_t _sTotal ) {
+		size_t I = 0;
+		for ( ; I + 4 <= _sTotal; I += 4 ) {
+			_mm_storeu_ps( _pfOut + I, _mm_movelh_ps( _mm_cvtpd_ps( _mm_loadu_pd( _pdIn + I ) ), _mm_cvtpd_ps( _mm_loadu_pd( _pdIn + I + 2 ) ) ) );
+		}
+		if ( I < _sTotal ) { Kernels::ScalarF64ToF32( _pdIn + I, _pfOut + I, _sTotal - I ); }
+	}
+}	// namespace
+#endif	// #ifdef __SSE4_1__
+
+	// == Functions.
+	/**
+	 * Fills a table with the SSE4.2 kernels.
+	 *
+	 * \param _tTable The table to fill.
+	 * \return Returns false if the file was not compiled with SSE4.2.
+	 **/
+	bool Kernels::FillSse42( NN9_TABLE &_tTable ) {
+#ifdef __SSE4_1__
+		_tTable.pfExpF32 = ExpF32;
+		_tTable.pfLogF32 = LogF32;
+		_tTable.pfTanhF32 = TanhF32;
+		_tTable.pfExpF64 = ExpF64;
+		_tTable.pfLogF64 = LogF64;
+		_tTable.pfTanhF64 = TanhF64;
+		_tTable.pfBf16ToF32 = Bf16ToF32;
+		_tTable.pfF32ToBf16 = F32ToBf16;
+		_tTable.pfF32ToF64 = F32ToF64;
+		_tTable.pfF64ToF32 = F64ToF32;
+		return true;
+#else
+		static_cast<void>(_tTable);
+		return false;
+#endif	// #ifdef __SSE4_1__
+	}
+
+}	// namespace nn9
@@ -0,0 +1,793 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Vectorized transcendental functions (exp, log, sin, cos, tanh, erf, expm1, log1p) on SSE4.1, AVX2, and AVX-512 registers,
+ *	using range reduction and polynomial or rational approximations instead of per-lane libm calls.
+ */
+
+#pragma once
+
+#include "NN9Macros.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#include <utility>
+
+
+namespace nn9 {
+
+#ifdef NN9_SIMDMATH_LOCAL
+namespace {
+#endif	// #ifdef NN9_SIMDMATH_LOCAL
+
+	/**
+	 * Class SimdMath
+	 * \brief Vectorized transcendental functions.
+	 *
+	 * Description: Vectorized transcendental functions (exp, log, sin, cos, tanh, erf, expm1, log1p) on SSE4.1, AVX2, and AVX-512 registers,
+	 *	using range reduction and polynomial or rational approximations instead of per-lane libm calls.  Every function is a template over
+	 *	the register type (__m128, __m128d, __m256, __m256d, __m512, or __m512d) so that element-wise lambdas can be written once as
+	 *	[](auto x) { return SimdMath::Exp( x ); }.  Infinities and NaN are handled as libm does.  Maximum errors are measured against
+	 *	long-double libm over the stated domains and are the same for AVX2 and AVX-512; SSE4.1 has no FMA, so its errors can be slightly larger.
+	 *
+	 * Files compiled for a wider instruction set than the rest of the build define NN9_SIMDMATH_LOCAL before including this header, which
+	 *	puts SimdMath in an anonymous namespace.  Its functions then have internal linkage there, so the linker can never substitute a copy
+	 *	compiled with those instructions for the one baseline code calls.  Only constants (INFINITY, NAN) and the C library's ::sin() and
+	 *	::cos(), which are never inline, are taken from the standard library for the same reason.
+	 */
+	class SimdMath {
+	public :
+		// == Functions.
+		/**
+		 * Computes exp() on each lane.  Max error: float 1.3 ULP, double 1.0 ULP.  Results that underflow degrade gradually through the subnormal
+		 *	range as libm does.
+		 *
+		 * \tparam _tReg The register type.
+		 * \param _rX The input.
+		 * \return Returns exp( _rX ).
+		 **/
+		template <typename _tReg>
+		static inline _tReg											Exp( _tReg _rX ) {
+			using O = OpsOf<_tReg>;
+			if constexpr ( O::Is32 ) {
+				// Cephes expf().
+				_tReg rX = O::Min( O::Set( 89.0 ), O::Max( O::Set( -104.0 ), _rX ) );
+				_tReg rN = O::Round( O::Mul( rX, O::Set( 1.44269504088896341 ) ) );
+				_tReg rR = O::Fnma( rN, O::Set( 0.693359375 ), rX );
+				rR = O::Fnma( rN, O::Set( -2.12194440e-4 ), rR );
+				static constexpr double dP[] = { 1.9875691500E-4, 1.3981999507E-3, 8.3334519073E-3, 4.1665795894E-2, 1.6666665459E-1, 5.0000001201E-1 };
+				_tReg rY = O::Fma( O::Mul( rR, rR ), Horner( rR, dP ), O::Add( rR, O::Set( 1.0 ) ) );
+				return O::Ldexp( rY, rN );
+			}
+			else {
+				// e^r = 1 + r + r^2 P(r), with P the Taylor series of (e^r - 1 - r) / r^2 to 1/13!, |r| <= ln( 2 ) / 2.
+				_tReg rX = O::Min( O::Set( 710.0 ), O::Max( O::Set( -746.0 ), _rX ) );
+				_tReg rN = O::Round( O::Mul( rX, O::Set( 1.4426950408889634073599 ) ) );
+				_tReg rR = O::Fnma( rN, O::Set( 6.93145751953125E-1 ), rX );
+				rR = O::Fnma( rN, O::Set( 1.42860682030941723212E-6 ), rR );
+				_tReg rY = O::Add( O::Set( 1.0 ), O::Fma( O::Mul( rR, rR ), Horner( rR, m_dExpTaylor ), rR ) );
+				return O::Ldexp( rY, rN );
+			}
+		}
+
+		/**
+		 * Computes exp( x ) - 1 on each lane, accurately for x near 0.  Max error: float 1.5 ULP, double 1.8 ULP.
+		 *
+		 * \tparam _tReg The register type.
+		 * \param _rX The input.
+		 * \return Returns expm1( _rX ).
+		 **/
+		template <typename _tReg>
+		static inline _tReg											Expm1( _tReg _rX ) {
+			using O = OpsOf<_tReg>;
+			// expm1( x ) = 2^n (e^r - 1) + (2^n - 1), where e^r - 1 is evaluated without forming e^r.  Above the cut-off the - 1 is lost to
+			//	rounding and exp() is used directly; below the floor the result is -1.
+			constexpr double dHigh = O::Is32 ? 20.0 : 40.0;
+			_tReg rX = O::Min( O::Set( dHigh ), O::Max( O::Set( O::Is32 ? -30.0 : -60.0 ), _rX ) );
+			_tReg rN = O::Round( O::Mul( rX, O::Set( 1.4426950408889634073599 ) ) );
+			_tReg rR, rEm1;
+			if constexpr ( O::Is32 ) {
+				rR = O::Fnma( rN, O::Set( 0.693359375 ), rX );
+				rR = O::Fnma( rN, O::Set( -2.12194440e-4 ), rR );
+				static constexpr double dP[] = { 1.9875691500E-4, 1.3981999507E-3, 8.3334519073E-3, 4.1665795894E-2, 1.6666665459E-1, 5.0000001201E-1 };
+				rEm1 = O::Fma( O::Mul( rR, rR ), Horner( rR, dP ), rR );
+			}
+			else {
+				rR = O::Fnma( rN, O::Set( 6.93145751953125E-1 ), rX );
+				rR = O::Fnma( rN, O::Set( 1.42860682030941723212E-6 ), rR );
+				rEm1 = O::Fma( O::Mul( rR, rR ), Horner( rR, m_dExpTaylor ), rR );
+			}
+			_tReg rScale = O::Ldexp( O::Set( 1.0 ), rN );
+			_tReg rY = O::Fma( rScale, rEm1, O::Sub( rScale, O::Set( 1.0 ) ) );
+			return O::Select( O::Gt( _rX, O::Set( dHigh ) ), Exp( _rX ), rY );
+		}
+
+		/**
+		 * Computes log() on each lane.  Max error: float 0.9 ULP, double 0.9 ULP.  Negative inputs give NaN and 0 gives -infinity.
+		 *
+		 * \tparam _tReg The register type.
+		 * \param _rX The input.
+		 * \return Returns log( _rX ).
+		 **/
+		template <typename _tReg>
+		static inline _tReg											Log( _tReg _rX ) {
+			using O = OpsOf<_tReg>;
+			// x = m * 2^e, m in [1, 2); fold m into [sqrt( 0.5 ), sqrt( 2 )).
+			_tReg rE;
+			_tReg rM = O::Frexp( _rX, rE );
+			auto mBig = O::Gt( rM, O::Set( 1.41421356237309504880 ) );
+			rM = O::Select( mBig, O::Mul( rM, O::Set( 0.5 ) ), rM );
+			rE = O::Select( mBig, O::Add( rE, O::Set( 1.0 ) ), rE );
+			_tReg rF = O::Sub( rM, O::Set( 1.0 ) );
+			_tReg rZ = O::Mul( rF, rF );
+			_tReg rY;
+			if constexpr ( O::Is32 ) {
+				// Cephes logf().
+				static constexpr double dP[] = { 7.0376836292E-2, -1.1514610310E-1, 1.1676998740E-1, -1.2420140846E-1, 1.4249322787E-1,
+					-1.6668057665E-1, 2.0000714765E-1, -2.4999993993E-1, 3.3333331174E-1 };
+				rY = O::Mul( O::Mul( rF, rZ ), Horner( rF, dP ) );
+			}
+			else {
+				// Cephes log(): log( 1 + f ) = f - f^2/2 + f^3 P(f) / Q(f).
+				static constexpr double dP[] = { 1.01875663804580931796E-4, 4.97494994976747001425E-1, 4.70579119878881725854E0,
+					1.44989225341610930846E1, 1.79368678507819816313E1, 7.70838733755885391666E0 };
+				static constexpr double dQ[] = { 1.0, 1.12873587189167450590E1, 4.52279145837532221105E1, 8.29875266912776603211E1,
+					7.11544750618563894466E1, 2.31251620126765340583E1 };
+				rY = O::Mul( O::Mul( rF, rZ ), O::Div( Horner( rF, dP ), Horner( rF, dQ ) ) );
+			}
+			rY = O::Fnma( rE, O::Set( 2.121944400546905827679e-4 ), rY );
+			rY = O::Fnma( rZ, O::Set( 0.5 ), rY );
+			_tReg rRes = O::Fma( rE, O::Set( 0.693359375 ), O::Add( rF, rY ) );
+
+			// Special cases.
+			rRes = O::Select( O::Eq( _rX, O::Set( INFINITY ) ), _rX, rRes );
+			rRes = O::Select( O::Eq( _rX, O::Set( 0.0 ) ), O::Set( -INFINITY ), rRes );
+			return O::Select( O::NotGe( _rX, O::Set( 0.0 ) ), O::Set( NAN ), rRes );
+		}
+
+		/**
+		 * Computes log( 1 + x ) on each lane, accurately for x near 0.  Max error: float 1.5 ULP, double 1.0 ULP.
+		 *
+		 * \tparam _tReg The register type.
+		 * \param _rX The input.
+		 * \return Returns log1p( _rX ).
+		 **/
+		template <typename _tReg>
+		static inline _tReg											Log1p( _tReg _rX ) {
+			using O = OpsOf<_tReg>;
+			// log1p( x ) = log( u ) + (x - (u - 1)) / u, u = 1 + x; the second term restores the bits of x lost when forming u.
+			_tReg rU = O::Add( _rX, O::Set( 1.0 ) );
+			_tReg rC = O::Div( O::Sub( _rX, O::Sub( rU, O::Set( 1.0 ) ) ), rU );
+			_tReg rRes = O::Add( Log( rU ), rC );
+			rRes = O::Select( O::Eq( rU, O::Set( 0.0 ) ), O::Set( -INFINITY ), rRes );
+			return O::Select( O::Eq( _rX, O::Set( INFINITY ) ), _rX, rRes );
+		}
+
+		/**
+		 * Computes sin() on each lane.  Max error: float 1.6 ULP, double 1.6 ULP, except for float near multiples of pi when compiled without
+		 *	FMA.  Lanes beyond the range of the polynomial path (|x| > 8192 for float, |x| > 1e9 for double) are computed by the C library's sin().
+		 *
+		 * \tparam _tReg The register type.
+		 * \param _rX The input.
+		 * \return Returns sin( _rX ).
+		 **/
+		template <typename _tReg>
+		static inline _tReg											Sin( _tReg _rX ) {
+			using O = OpsOf<_tReg>;
+			_tReg rZ, rOctant;
+			ReducePi4( _rX, rZ, rOctant );
+			// Octants 2 and 6 use the cosine polynomial; octants 4 and 6 are negated.
+			auto mCos = O::Eq( O::Sub( rOctant, O::Mul( O::Set( 4.0 ), O::Floor( O::Mul( rOctant, O::Set( 0.25 ) ) ) ) ), O::Set( 2.0 ) );
+			_tReg rRes = O::Select( mCos, CosPoly( rZ ), SinPoly( rZ ) );
+			rRes = O::Select( O::Ge( rOctant, O::Set( 4.0 ) ), O::Neg( rRes ), rRes );
+			return LargeArgs( _rX, O::Xor( rRes, O::SignBit( _rX ) ), false );
+		}
+
+		/**
+		 * Computes cos() on each lane.  Max error: float 1.6 ULP, double 1.6 ULP, except for float near multiples of pi when compiled without
+		 *	FMA.  Lanes beyond the range of the polynomial path (|x| > 8192 for float, |x| > 1e9 for double) are computed by the C library's cos().
+		 *
+		 * \tparam _tReg The register type.
+		 * \param _rX The input.
+		 * \return Returns cos( _rX ).
+		 **/
+		template <typename _tReg>
+		static inline _tReg											Cos( _tReg _rX ) {
+			using O = OpsOf<_tReg>;
+			_tReg rZ, rOctant;
+			ReducePi4( _rX, rZ, rOctant );
+			// Octants 2 and 6 use the sine polynomial; octants 2 and 4 are negated.
+			auto mSin = O::Eq( O::Sub( rOctant, O::Mul( O::Set( 4.0 ), O::Floor( O::Mul( rOctant, O::Set( 0.25 ) ) ) ) ), O::Set( 2.0 ) );
+			_tReg rRes = O::Select( mSin, SinPoly( rZ ), CosPoly( rZ ) );
+			auto mNeg = O::Or( O::Eq( rOctant, O::Set( 2.0 ) ), O::Eq( rOctant, O::Set( 4.0 ) ) );
+			return LargeArgs( _rX, O::Select( mNeg, O::Neg( rRes ), rRes ), true );
+		}
+
+		/**
+		 * Computes tanh() on each lane.  Max error: float 1.4 ULP, double 1.4 ULP.
+		 *
+		 * \tparam _tReg The register type.
+		 * \param _rX The input.
+		 * \return Returns tanh( _rX ).
+		 **/
+		template <typename _tReg>
+		static inline _tReg											Tanh( _tReg _rX ) {
+			using O = OpsOf<_tReg>;
+			_tReg rAbs = O::Abs( _rX );
+			_tReg rZ = O::Mul( _rX, _rX );
+			_tReg rSmall;
+			if constexpr ( O::Is32 ) {
+				// Cephes tanhf(), |x| < 0.625.
+				static constexpr double dP[] = { -5.70498872745E-3, 2.06390887954E-2, -5.37397155531E-2, 1.33314422036E-1, -3.33332819422E-1 };
+				rSmall = O::Fma( O::Mul( _rX, rZ ), Horner( rZ, dP ), _rX );
+			}
+			else {
+				// Cephes tanh(), |x| < 0.625.
+				static constexpr double dP[] = { -9.64399179425052238628E-1, -9.92877231001918586564E1, -1.61468768441708447952E3 };
+				static constexpr double dQ[] = { 1.0, 1.12811678491632931402E2, 2.23548839060100448583E3, 4.84406305325125486048E3 };
+				rSmall = O::Fma( O::Mul( _rX, rZ ), O::Div( Horner( rZ, dP ), Horner( rZ, dQ ) ), _rX );
+			}
+			// tanh( |x| ) = 1 - 2 / (e^(2|x|) + 1).
+			_tReg rLarge = O::Sub( O::Set( 1.0 ), O::Div( O::Set( 2.0 ), O::Add( Exp( O::Add( rAbs, rAbs ) ), O::Set( 1.0 ) ) ) );
+			rLarge = O::Xor( rLarge, O::SignBit( _rX ) );
+			return O::Select( O::Lt( rAbs, O::Set( 0.625 ) ), rSmall, rLarge );
+		}
+
+		/**
+		 * Computes erf() on each lane.  Max error: float 1.1 ULP, double 1.1 ULP.
+		 *
+		 * \tparam _tReg The register type.
+		 * \param _rX The input.
+		 * \return Returns erf( _rX ).
+		 **/
+		template <typename _tReg>
+		static inline _tReg											Erf( _tReg _rX ) {
+			using O = OpsOf<_tReg>;
+			_tReg rAbs = O::Abs( _rX );
+			_tReg rZ = O::Mul( _rX, _rX );
+			// |x| < 1: erf( x ) = x + x P(x^2), with P the Taylor series of erf( x ) / x - 1.
+			_tReg rSmall;
+			if constexpr ( O::Is32 ) {
+				static constexpr double dP[] = { -1.22905553017179283506E-09, 1.48071928158792175650E-08, -1.63658446912349244681E-07,
+					1.64621143658892484563E-06, -1.49256503584062503526E-05, 1.20553329817896636030E-04, -8.54832702345085333404E-04,
+					5.22397762544218793174E-03, -2.68661706451312522204E-02, 1.12837916709551261407E-01, -3.76126389031837538024E-01,
+					1.28379167095512586316E-01 };
+				rSmall = O::Fma( _rX, Horner( rZ, dP ), _rX );
+			}
+			else {
+				static constexpr double dP[] = { 4.76334804051506830537E-18, -9.06397084280867277968E-17, 1.63426140953671520103E-15,
+					-2.78351620721092149680E-14, 4.46322426328647748650E-13, -6.71136685516411048235E-12, 9.42275906465041125293E-11,
+					-1.22905553017179283506E-09, 1.48071928158792175650E-08, -1.63658446912349244681E-07, 1.64621143658892484563E-06,
+					-1.49256503584062503526E-05, 1.20553329817896636030E-04, -8.54832702345085333404E-04, 5.22397762544218793174E-03,
+					-2.68661706451312522204E-02, 1.12837916709551261407E-01, -3.76126389031837538024E-01, 1.28379167095512586316E-01 };
+				rSmall = O::Fma( _rX, Horner( rZ, dP ), _rX );
+			}
+			// Otherwise: erf( x ) = 1 - erfc( |x| ), with Cephes' erfc() e^(-x^2) P(|x|) / Q(|x|).  erf() rounds to 1 beyond 4 (float) or
+			//	6 (double).
+			_tReg rA = O::Min( O::Set( O::Is32 ? 4.0 : 6.0 ), rAbs );
+			static constexpr double dP[] = { 2.46196981473530512524E-10, 5.64189564831068821977E-1, 7.46321056442269912687E0,
+				4.86371970985681366614E1, 1.96520832956077098242E2, 5.26445194995477358631E2, 9.34528527171957607540E2,
+				1.02755188689515710272E3, 5.57535335369399327526E2 };
+			static constexpr double dQ[] = { 1.0, 1.32281951154744992508E1, 8.67072140885989742329E1, 3.54937778887819891062E2,
+				9.75708501743205489753E2, 1.82390916687909736289E3, 2.24633760818710981792E3, 1.65666309194161350182E3,
+				5.57535340817727675546E2 };
+			_tReg rErfc = O::Mul( Exp( O::Neg( O::Mul( rA, rA ) ) ), O::Div( Horner( rA, dP ), Horner( rA, dQ ) ) );
+			_tReg rLarge = O::Xor( O::Sub( O::Set( 1.0 ), rErfc ), O::SignBit( _rX ) );
+			return O::Select( O::Lt( rAbs, O::Set( 1.0 ) ), rSmall, rLarge );
+		}
+
+
+	protected :
+		// == Types.
+		/**
+		 * The operations used by the generic implementations, specialized per element type and lane count.  Comparisons return the register's
+		 *	natural mask type.  Max() and Min() return their second operand when either is NaN, so clamping as Min( hi, Max( lo, x ) ) keeps NaN.
+		 *	FusedFma is true when Fma() and Fnma() round once.  Specializations are not keyed on the register types themselves because
+		 *	compilers drop the vector attributes of __m128/__m256/__m512 from template arguments (GCC's -Wignored-attributes).
+		 */
+		template <typename _tScalar, size_t _sLanes>
+		struct Ops;
+
+#ifdef __AVX512F__
+		static Ops<float, 16>										OpsFor( __m512 );
+		static Ops<double, 8>										OpsFor( __m512d );
+#endif	// #ifdef __AVX512F__
+#ifdef __AVX2__
+		static Ops<float, 8>										OpsFor( __m256 );
+		static Ops<double, 4>										OpsFor( __m256d );
+#endif	// #ifdef __AVX2__
+#ifdef __SSE4_1__
+		static Ops<float, 4>										OpsFor( __m128 );
+		static Ops<double, 2>										OpsFor( __m128d );
+#endif	// #ifdef __SSE4_1__
+
+		/** The operations for a given register type.  OpsFor() is only declared; overload resolution picks the specialization. */
+		template <typename _tReg>
+		using OpsOf = decltype( OpsFor( std::declval<_tReg>() ) );
+
+
+		// == Members.
+		/** The Taylor series of (e^r - 1 - r) / r^2 to 1/13!, highest order first. */
+		static constexpr double										m_dExpTaylor[] = { 1.60590438368216133409E-10, 2.08767569878681001866E-09,
+			2.50521083854417202239E-08, 2.75573192239858882758E-07, 2.75573192239858925110E-06, 2.48015873015873015658E-05,
+			1.98412698412698412526E-04, 1.38888888888888894189E-03, 8.33333333333333321769E-03, 4.16666666666666643537E-02,
+			1.66666666666666657415E-01, 5.00000000000000000000E-01 };
+		/** The largest float |x| that ReducePi4() reduces to within the stated error of Sin() and Cos(). */
+		static constexpr double										m_dReduceMax32 = 8192.0;
+		/** The largest double |x| that ReducePi4() reduces to within the stated error of Sin() and Cos(). */
+		static constexpr double										m_dReduceMax64 = 1.0e9;
+
+
+		// == Functions.
+		/**
+		 * Evaluates a polynomial with Horner's method, highest-order coefficient first.
+		 *
+		 * \tparam _tReg The register type.
+		 * \tparam _sN The number of coefficients.
+		 * \param _rX The variable.
+		 * \param _dCoeffs The coefficients, highest order first.
+		 * \return Returns the value of the polynomial at _rX.
+		 **/
+		template <typename _tReg, size_t _sN>
+		static inline _tReg											Horner( _tReg _rX, const double (&_dCoeffs)[_sN] ) {
+			using O = OpsOf<_tReg>;
+			_tReg rRes = O::Set( _dCoeffs[0] );
+			for ( size_t I = 1; I < _sN; ++I ) {
+				rRes = O::Fma( rRes, _rX, O::Set( _dCoeffs[I] ) );
+			}
+			return rRes;
+		}
+
+		/**
+		 * Reduces |x| to z in [-pi/4, pi/4] and an even octant index in [0, 6], using Cephes' 3-part Cody-Waite reduction.  The reduction
+		 *	loses accuracy above m_dReduceMax32 (float) or m_dReduceMax64 (double); see LargeArgs().
+		 *
+		 * \tparam _tReg The register type.
+		 * \param _rX The input.
+		 * \param _rZ Holds the reduced argument.
+		 * \param _rOctant Holds the octant: 0, 2, 4, or 6.
+		 **/
+		template <typename _tReg>
+		static inline void											ReducePi4( _tReg _rX, _tReg &_rZ, _tReg &_rOctant ) {
+			using O = OpsOf<_tReg>;
+			_tReg rAbs = O::Abs( _rX );
+			// y = the even integer nearest to |x| * 4/pi from above.
+			_tReg rY = O::Floor( O::Mul( rAbs, O::Set( 1.27323954473516268615 ) ) );
+			rY = O::Mul( O::Floor( O::Mul( O::Add( rY, O::Set( 1.0 ) ), O::Set( 0.5 ) ) ), O::Set( 2.0 ) );
+			_rOctant = O::Sub( rY, O::Mul( O::Floor( O::Mul( rY, O::Set( 0.125 ) ) ), O::Set( 8.0 ) ) );
+			if constexpr ( O::Is32 ) {
+				if constexpr ( O::FusedFma ) {
+					// pi/4 split into 3 floats; with FMA each product is subtracted without intermediate rounding.
+					_rZ = O::Fnma( rY, O::Set( 0.7853981852531433 ), rAbs );
+					_rZ = O::Fnma( rY, O::Set( -2.1855694143368964e-08 ), _rZ );
+					_rZ = O::Fnma( rY, O::Set( -8.575622550029409e-16 ), _rZ );
+				}
+				else {
+					// Cephes' split, whose leading parts have few enough bits that their products are exact.
+					_rZ = O::Fnma( rY, O::Set( 0.78515625 ), rAbs );
+					_rZ = O::Fnma( rY, O::Set( 2.4187564849853515625e-4 ), _rZ );
+					_rZ = O::Fnma( rY, O::Set( 3.77489497744594108e-8 ), _rZ );
+				}
+			}
+			else {
+				_rZ = O::Fnma( rY, O::Set( 7.85398125648498535156E-1 ), rAbs );
+				_rZ = O::Fnma( rY, O::Set( 3.77489470793079817668E-8 ), _rZ );
+				_rZ = O::Fnma( rY, O::Set( 2.69515142907905952645E-15 ), _rZ );
+			}
+		}
+
+		/**
+		 * Evaluates sin( z ) for z in [-pi/4, pi/4].
+		 *
+		 * \tparam _tReg The register type.
+		 * \param _rZ The reduced argument.
+		 * \return Returns sin( _rZ ).
+		 **/
+		template <typename _tReg>
+		static inline _tReg											SinPoly( _tReg _rZ ) {
+			using O = OpsOf<_tReg>;
+			_tReg rZz = O::Mul( _rZ, _rZ );
+			if constexpr ( O::Is32 ) {
+				static constexpr double dP[] = { -1.9515295891E-4, 8.3321608736E-3, -1.6666654611E-1 };
+				return O::Fma( O::Mul( _rZ, rZz ), Horner( rZz, dP ), _rZ );
+			}
+			else {
+				static constexpr double dP[] = { 1.58962301576546568060E-10, -2.50507477628578072866E-8, 2.75573136213857245213E-6,
+					-1.98412698295895385996E-4, 8.33333333332211858878E-3, -1.66666666666666307295E-1 };
+				return O::Fma( O::Mul( _rZ, rZz ), Horner( rZz, dP ), _rZ );
+			}
+		}
+
+		/**
+		 * Evaluates cos( z ) for z in [-pi/4, pi/4].
+		 *
+		 * \tparam _tReg The register type.
+		 * \param _rZ The reduced argument.
+		 * \return Returns cos( _rZ ).
+		 **/
+		template <typename _tReg>
+		static inline _tReg											CosPoly( _tReg _rZ ) {
+			using O = OpsOf<_tReg>;
+			_tReg rZz = O::Mul( _rZ, _rZ );
+			if constexpr ( O::Is32 ) {
+				static constexpr double dP[] = { 2.443315711809948E-005, -1.388731625493765E-003, 4.166664568298827E-002 };
+				return O::Fma( O::Mul( rZz, rZz ), Horner( rZz, dP ), O::Fnma( rZz, O::Set( 0.5 ), O::Set( 1.0 ) ) );
+			}
+			else {
+				static constexpr double dP[] = { -1.13585365213876817300E-11, 2.08757008419747316778E-9, -2.75573141792967388112E-7,
+					2.48015872888517045348E-5, -1.38888888888730564116E-3, 4.16666666666665929218E-2 };
+				return O::Fma( O::Mul( rZz, rZz ), Horner( rZz, dP ), O::Fnma( rZz, O::Set( 0.5 ), O::Set( 1.0 ) ) );
+			}
+		}
+		/**
+		 * Replaces the lanes of a sin() or cos() result whose input is beyond the range of ReducePi4() with the C library's result.  Only
+		 *	::sin() and ::cos() are called, since they are never inline (see NN9_SIMDMATH_LOCAL).  Infinities fall through to them and give NaN.
+		 *
+		 * \tparam _tReg The register type.
+		 * \param _rX The input.
+		 * \param _rRes The result of the polynomial path.
+		 * \param _bCos If true, the function is cos(); otherwise sin().
+		 * \return Returns _rRes with the large lanes replaced.
+		 **/
+		template <typename _tReg>
+		static inline _tReg											LargeArgs( _tReg _rX, _tReg _rRes, bool _bCos ) {
+			using O = OpsOf<_tReg>;
+			constexpr double dMax = O::Is32 ? m_dReduceMax32 : m_dReduceMax64;
+			if NN9_LIKELY( !O::Any( O::Gt( O::Abs( _rX ), O::Set( dMax ) ) ) ) { return _rRes; }
+			typename O::Scalar tX[O::Lanes], tRes[O::Lanes];
+			O::Store( tX, _rX );
+			O::Store( tRes, _rRes );
+			for ( size_t I = 0; I < O::Lanes; ++I ) {
+				if ( tX[I] > dMax || tX[I] < -dMax ) {
+					tRes[I] = static_cast<typename O::Scalar>(_bCos ? ::cos( double( tX[I] ) ) : ::sin( double( tX[I] ) ));
+				}
+			}
+			return O::Load( tRes );
+		}
+	};
+
+
+	// == Types.
+#ifdef __AVX512F__
+	/** AVX-512 float operations. */
+	template <>
+	struct SimdMath::Ops<float, 16> {
+		using Mask = __mmask16;
+		using Scalar = float;
+		static constexpr size_t Lanes = 16;
+		static constexpr bool Is32 = true;
+		static constexpr bool FusedFma = true;
+
+		static inline __m512										Set( double _dVal ) { return _mm512_set1_ps( float( _dVal ) ); }
+		static inline __m512										Add( __m512 _rA, __m512 _rB ) { return _mm512_add_ps( _rA, _rB ); }
+		static inline __m512										Sub( __m512 _rA, __m512 _rB ) { return _mm512_sub_ps( _rA, _rB ); }
+		static inline __m512										Mul( __m512 _rA, __m512 _rB ) { return _mm512_mul_ps( _rA, _rB ); }
+		static inline __m512										Div( __m512 _rA, __m512 _rB ) { return _mm512_div_ps( _rA, _rB ); }
+		static inline __m512										Fma( __m512 _rA, __m512 _rB, __m512 _rC ) { return _mm512_fmadd_ps( _rA, _rB, _rC ); }
+		static inline __m512										Fnma( __m512 _rA, __m512 _rB, __m512 _rC ) { return _mm512_fnmadd_ps( _rA, _rB, _rC ); }
+		static inline __m512										Min( __m512 _rA, __m512 _rB ) { return _mm512_min_ps( _rA, _rB ); }
+		static inline __m512										Max( __m512 _rA, __m512 _rB ) { return _mm512_max_ps( _rA, _rB ); }
+		static inline __m512										Abs( __m512 _rA ) { return _mm512_abs_ps( _rA ); }
+		static inline __m512										Neg( __m512 _rA ) { return Xor( _rA, Set( -0.0 ) ); }
+		static inline __m512										SignBit( __m512 _rA ) { return _mm512_castsi512_ps( _mm512_and_si512( _mm512_castps_si512( _rA ), _mm512_set1_epi32( int32_t( 0x80000000 ) ) ) ); }
+		static inline __m512										Xor( __m512 _rA, __m512 _rB ) { return _mm512_castsi512_ps( _mm512_xor_si512( _mm512_castps_si512( _rA ), _mm512_castps_si512( _rB ) ) ); }
+		static inline __m512										Round( __m512 _rA ) { return _mm512_roundscale_ps( _rA, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }
+		static inline __m512										Floor( __m512 _rA ) { return _mm512_roundscale_ps( _rA, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC ); }
+		static inline Mask											Lt( __m512 _rA, __m512 _rB ) { return _mm512_cmp_ps_mask( _rA, _rB, _CMP_LT_OQ ); }
+		static inline Mask											Gt( __m512 _rA, __m512 _rB ) { return _mm512_cmp_ps_mask( _rA, _rB, _CMP_GT_OQ ); }
+		static inline Mask											Ge( __m512 _rA, __m512 _rB ) { return _mm512_cmp_ps_mask( _rA, _rB, _CMP_GE_OQ ); }
+		static inline Mask											NotGe( __m512 _rA, __m512 _rB ) { return _mm512_cmp_ps_mask( _rA, _rB, _CMP_NGE_UQ ); }
+		static inline Mask											Eq( __m512 _rA, __m512 _rB ) { return _mm512_cmp_ps_mask( _rA, _rB, _CMP_EQ_OQ ); }
+		static inline Mask											Or( Mask _mA, Mask _mB ) { return Mask( _mA | _mB ); }
+		static inline bool											Any( Mask _mMask ) { return _mMask != 0; }
+		static inline __m512										Select( Mask _mMask, __m512 _rTrue, __m512 _rFalse ) { return _mm512_mask_blend_ps( _mMask, _rFalse, _rTrue ); }
+		static inline void											Store( float * _ptDst, __m512 _rA ) { _mm512_storeu_ps( _ptDst, _rA ); }
+		static inline __m512										Load( const float * _ptSrc ) { return _mm512_loadu_ps( _ptSrc ); }
+		static inline __m512										Ldexp( __m512 _rA, __m512 _rN ) { return _mm512_scalef_ps( _rA, _rN ); }
+		static inline __m512										Frexp( __m512 _rA, __m512 &_rE ) {
+			_rE = _mm512_getexp_ps( _rA );
+			return _mm512_getmant_ps( _rA, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero );
+		}
+	};
+
+	/** AVX-512 double operations. */
+	template <>
+	struct SimdMath::Ops<double, 8> {
+		using Mask = __mmask8;
+		using Scalar = double;
+		static constexpr size_t Lanes = 8;
+		static constexpr bool Is32 = false;
+		static constexpr bool FusedFma = true;
+
+		static inline __m512d										Set( double _dVal ) { return _mm512_set1_pd( _dVal ); }
+		static inline __m512d										Add( __m512d _rA, __m512d _rB ) { return _mm512_add_pd( _rA, _rB ); }
+		static inline __m512d										Sub( __m512d _rA, __m512d _rB ) { return _mm512_sub_pd( _rA, _rB ); }
+		static inline __m512d										Mul( __m512d _rA, __m512d _rB ) { return _mm512_mul_pd( _rA, _rB ); }
+		static inline __m512d										Div( __m512d _rA, __m512d _rB ) { return _mm512_div_pd( _rA, _rB ); }
+		static inline __m512d										Fma( __m512d _rA, __m512d _rB, __m512d _rC ) { return _mm512_fmadd_pd( _rA, _rB, _rC ); }
+		static inline __m512d										Fnma( __m512d _rA, __m512d _rB, __m512d _rC ) { return _mm512_fnmadd_pd( _rA, _rB, _rC ); }
+		static inline __m512d										Min( __m512d _rA, __m512d _rB ) { return _mm512_min_pd( _rA, _rB ); }
+		static inline __m512d										Max( __m512d _rA, __m512d _rB ) { return _mm512_max_pd( _rA, _rB ); }
+		static inline __m512d										Abs( __m512d _rA ) { return _mm512_abs_pd( _rA ); }
+		static inline __m512d										Neg( __m512d _rA ) { return Xor( _rA, Set( -0.0 ) ); }
+		static inline __m512d										SignBit( __m512d _rA ) { return _mm512_castsi512_pd( _mm512_and_si512( _mm512_castpd_si512( _rA ), _mm512_set1_epi64( int64_t( 0x8000000000000000ULL ) ) ) ); }
+		static inline __m512d										Xor( __m512d _rA, __m512d _rB ) { return _mm512_castsi512_pd( _mm512_xor_si512( _mm512_castpd_si512( _rA ), _mm512_castpd_si512( _rB ) ) ); }
+		static inline __m512d										Round( __m512d _rA ) { return _mm512_roundscale_pd( _rA, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }
+		static inline __m512d										Floor( __m512d _rA ) { return _mm512_roundscale_pd( _rA, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC ); }
+		static inline Mask											Lt( __m512d _rA, __m512d _rB ) { return _mm512_cmp_pd_mask( _rA, _rB, _CMP_LT_OQ ); }
+		static inline Mask											Gt( __m512d _rA, __m512d _rB ) { return _mm512_cmp_pd_mask( _rA, _rB, _CMP_GT_OQ ); }
+		static inline Mask											Ge( __m512d _rA, __m512d _rB ) { return _mm512_cmp_pd_mask( _rA, _rB, _CMP_GE_OQ ); }
+		static inline Mask											NotGe( __m512d _rA, __m512d _rB ) { return _mm512_cmp_pd_mask( _rA, _rB, _CMP_NGE_UQ ); }
+		static inline Mask											Eq( __m512d _rA, __m512d _rB ) { return _mm512_cmp_pd_mask( _rA, _rB, _CMP_EQ_OQ ); }
+		static inline Mask											Or( Mask _mA, Mask _mB ) { return Mask( _mA | _mB ); }
+		static inline bool											Any( Mask _mMask ) { return _mMask != 0; }
+		static inline __m512d										Select( Mask _mMask, __m512d _rTrue, __m512d _rFalse ) { return _mm512_mask_blend_pd( _mMask, _rFalse, _rTrue ); }
+		static inline void											Store( double * _ptDst, __m512d _rA ) { _mm512_storeu_pd( _ptDst, _rA ); }
+		static inline __m512d										Load( const double * _ptSrc ) { return _mm512_loadu_pd( _ptSrc ); }
+		static inline __m512d										Ldexp( __m512d _rA, __m512d _rN ) { return _mm512_scalef_pd( _rA, _rN ); }
+		static inline __m512d										Frexp( __m512d _rA, __m512d &_rE ) {
+			_rE = _mm512_getexp_pd( _rA );
+			return _mm512_getmant_pd( _rA, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero );
+		}
+	};
+#endif	// #ifdef __AVX512F__
+
+#ifdef __AVX2__
+	/** AVX2 float operations. */
+	template <>
+	struct SimdMath::Ops<float, 8> {
+		using Mask = __m256;
+		using Scalar = float;
+		static constexpr size_t Lanes = 8;
+		static constexpr bool Is32 = true;
+#if defined( __FMA__ ) || defined( _MSC_VER )
+		static constexpr bool FusedFma = true;
+#else
+		static constexpr bool FusedFma = false;
+#endif	// #if defined( __FMA__ ) || defined( _MSC_VER )
+
+		static inline __m256										Set( double _dVal ) { return _mm256_set1_ps( float( _dVal ) ); }
+		static inline __m256										Add( __m256 _rA, __m256 _rB ) { return _mm256_add_ps( _rA, _rB ); }
+		static inline __m256										Sub( __m256 _rA, __m256 _rB ) { return _mm256_sub_ps( _rA, _rB ); }
+		static inline __m256										Mul( __m256 _rA, __m256 _rB ) { return _mm256_mul_ps( _rA, _rB ); }
+		static inline __m256										Div( __m256 _rA, __m256 _rB ) { return _mm256_div_ps( _rA, _rB ); }
+#if defined( __FMA__ ) || defined( _MSC_VER )
+		static inline __m256										Fma( __m256 _rA, __m256 _rB, __m256 _rC ) { return _mm256_fmadd_ps( _rA, _rB, _rC ); }
+		static inline __m256										Fnma( __m256 _rA, __m256 _rB, __m256 _rC ) { return _mm256_fnmadd_ps( _rA, _rB, _rC ); }
+#else
+		static inline __m256										Fma( __m256 _rA, __m256 _rB, __m256 _rC ) { return _mm256_add_ps( _mm256_mul_ps( _rA, _rB ), _rC ); }
+		static inline __m256										Fnma( __m256 _rA, __m256 _rB, __m256 _rC ) { return _mm256_sub_ps( _rC, _mm256_mul_ps( _rA, _rB ) ); }
+#endif	// #if defined( __FMA__ ) || defined( _MSC_VER )
+		static inline __m256										Min( __m256 _rA, __m256 _rB ) { return _mm256_min_ps( _rA, _rB ); }
+		static inline __m256										Max( __m256 _rA, __m256 _rB ) { return _mm256_max_ps( _rA, _rB ); }
+		static inline __m256										Abs( __m256 _rA ) { return _mm256_andnot_ps( Set( -0.0 ), _rA ); }
+		static inline __m256										Neg( __m256 _rA ) { return _mm256_xor_ps( _rA, Set( -0.0 ) ); }
+		static inline __m256										SignBit( __m256 _rA ) { return _mm256_and_ps( _rA, Set( -0.0 ) ); }
+		static inline __m256										Xor( __m256 _rA, __m256 _rB ) { return _mm256_xor_ps( _rA, _rB ); }
+		static inline __m256										Round( __m256 _rA ) { return _mm256_round_ps( _rA, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }
+		static inline __m256										Floor( __m256 _rA ) { return _mm256_floor_ps( _rA ); }
+		static inline Mask											Lt( __m256 _rA, __m256 _rB ) { return _mm256_cmp_ps( _rA, _rB, _CMP_LT_OQ ); }
+		static inline Mask											Gt( __m256 _rA, __m256 _rB ) { return _mm256_cmp_ps( _rA, _rB, _CMP_GT_OQ ); }
+		static inline Mask											Ge( __m256 _rA, __m256 _rB ) { return _mm256_cmp_ps( _rA, _rB, _CMP_GE_OQ ); }
+		static inline Mask											NotGe( __m256 _rA, __m256 _rB ) { return _mm256_cmp_ps( _rA, _rB, _CMP_NGE_UQ ); }
+		static inline Mask											Eq( __m256 _rA, __m256 _rB ) { return _mm256_cmp_ps( _rA, _rB, _CMP_EQ_OQ ); }
+		static inline Mask											Or( Mask _mA, Mask _mB ) { return _mm256_or_ps( _mA, _mB ); }
+		static inline bool											Any( Mask _mMask ) { return _mm256_movemask_ps( _mMask ) != 0; }
+		static inline __m256										Select( Mask _mMask, __m256 _rTrue, __m256 _rFalse ) { return _mm256_blendv_ps( _rFalse, _rTrue, _mMask ); }
+		static inline void											Store( float * _ptDst, __m256 _rA ) { _mm256_storeu_ps( _ptDst, _rA ); }
+		static inline __m256										Load( const float * _ptSrc ) { return _mm256_loadu_ps( _ptSrc ); }
+
+		/** 2^n for integral n in [-126, 127]. */
+		static inline __m256										Pow2( __m256 _rN ) {
+			return _mm256_castsi256_ps( _mm256_slli_epi32( _mm256_add_epi32( _mm256_cvtps_epi32( _rN ), _mm256_set1_epi32( 127 ) ), 23 ) );
+		}
+		/** x * 2^n for integral n in [-252, 254], in 2 steps so that each factor is a normal number. */
+		static inline __m256										Ldexp( __m256 _rA, __m256 _rN ) {
+			__m256 rN0 = Floor( Mul( _rN, Set( 0.5 ) ) );
+			return Mul( Mul( _rA, Pow2( rN0 ) ), Pow2( Sub( _rN, rN0 ) ) );
+		}
+		static inline __m256										Frexp( __m256 _rA, __m256 &_rE ) {
+			// Scale subnormals up into the normal range first.
+			Mask mSub = Lt( Abs( _rA ), Set( 1.17549435082228750797e-38 ) );
+			_rA = Select( mSub, Mul( _rA, Set( 8388608.0 ) ), _rA );
+			__m256i iBits = _mm256_castps_si256( _rA );
+			_rE = _mm256_cvtepi32_ps( _mm256_sub_epi32( _mm256_and_si256( _mm256_srli_epi32( iBits, 23 ), _mm256_set1_epi32( 0xFF ) ), _mm256_set1_epi32( 127 ) ) );
+			_rE = Select( mSub, Sub( _rE, Set( 23.0 ) ), _rE );
+			return _mm256_castsi256_ps( _mm256_or_si256( _mm256_and_si256( iBits, _mm256_set1_epi32( 0x007FFFFF ) ), _mm256_set1_epi32( 0x3F800000 ) ) );
+		}
+	};
+
+	/** AVX2 double operations. */
+	template <>
+	struct SimdMath::Ops<double, 4> {
+		using Mask = __m256d;
+		using Scalar = double;
+		static constexpr size_t Lanes = 4;
+		static constexpr bool Is32 = false;
+#if defined( __FMA__ ) || defined( _MSC_VER )
+		static constexpr bool FusedFma = true;
+#else
+		static constexpr bool FusedFma = false;
+#endif	// #if defined( __FMA__ ) || defined( _MSC_VER )
+
+		static inline __m256d										Set( double _dVal ) { return _mm256_set1_pd( _dVal ); }
+		static inline __m256d										Add( __m256d _rA, __m256d _rB ) { return _mm256_add_pd( _rA, _rB ); }
+		static inline __m256d										Sub( __m256d _rA, __m256d _rB ) { return _mm256_sub_pd( _rA, _rB ); }
+		static inline __m256d										Mul( __m256d _rA, __m256d _rB ) { return _mm256_mul_pd( _rA, _rB ); }
+		static inline __m256d										Div( __m256d _rA, __m256d _rB ) { return _mm256_div_pd( _rA, _rB ); }
+#if defined( __FMA__ ) || defined( _MSC_VER )
+		static inline __m256d										Fma( __m256d _rA, __m256d _rB, __m256d _rC ) { return _mm256_fmadd_pd( _rA, _rB, _rC ); }
+		static inline __m256d										Fnma( __m256d _rA, __m256d _rB, __m256d _rC ) { return _mm256_fnmadd_pd( _rA, _rB, _rC ); }
+#else
+		static inline __m256d										Fma( __m256d _rA, __m256d _rB, __m256d _rC ) { return _mm256_add_pd( _mm256_mul_pd( _rA, _rB ), _rC ); }
+		static inline __m256d										Fnma( __m256d _rA, __m256d _rB, __m256d _rC ) { return _mm256_sub_pd( _rC, _mm256_mul_pd( _rA, _rB ) ); }
+#endif	// #if defined( __FMA__ ) || defined( _MSC_VER )
+		static inline __m256d										Min( __m256d _rA, __m256d _rB ) { return _mm256_min_pd( _rA, _rB ); }
+		static inline __m256d										Max( __m256d _rA, __m256d _rB ) { return _mm256_max_pd( _rA, _rB ); }
+		static inline __m256d										Abs( __m256d _rA ) { return _mm256_andnot_pd( Set( -0.0 ), _rA ); }
+		static inline __m256d										Neg( __m256d _rA ) { return _mm256_xor_pd( _rA, Set( -0.0 ) ); }
+		static inline __m256d										SignBit( __m256d _rA ) { return _mm256_and_pd( _rA, Set( -0.0 ) ); }
+		static inline __m256d										Xor( __m256d _rA, __m256d _rB ) { return _mm256_xor_pd( _rA, _rB ); }
+		static inline __m256d										Round( __m256d _rA ) { return _mm256_round_pd( _rA, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }
+		static inline __m256d										Floor( __m256d _rA ) { return _mm256_floor_pd( _rA ); }
+		static inline Mask											Lt( __m256d _rA, __m256d _rB ) { return _mm256_cmp_pd( _rA, _rB, _CMP_LT_OQ ); }
+		static inline Mask											Gt( __m256d _rA, __m256d _rB ) { return _mm256_cmp_pd( _rA, _rB, _CMP_GT_OQ ); }
+		static inline Mask											Ge( __m256d _rA, __m256d _rB ) { return _mm256_cmp_pd( _rA, _rB, _CMP_GE_OQ ); }
+		static inline Mask											NotGe( __m256d _rA, __m256d _rB ) { return _mm256_cmp_pd( _rA, _rB, _CMP_NGE_UQ ); }
+		static inline Mask											Eq( __m256d _rA, __m256d _rB ) { return _mm256_cmp_pd( _rA, _rB, _CMP_EQ_OQ ); }
+		static inline Mask											Or( Mask _mA, Mask _mB ) { return _mm256_or_pd( _mA, _mB ); }
+		static inline bool											Any( Mask _mMask ) { return _mm256_movemask_pd( _mMask ) != 0; }
+		static inline __m256d										Select( Mask _mMask, __m256d _rTrue, __m256d _rFalse ) { return _mm256_blendv_pd( _rFalse, _rTrue, _mMask ); }
+		static inline void											Store( double * _ptDst, __m256d _rA ) { _mm256_storeu_pd( _ptDst, _rA ); }
+		static inline __m256d										Load( const double * _ptSrc ) { return _mm256_loadu_pd( _ptSrc ); }
+
+		/** 2^n for integral n in [-1022, 1023]; adding 2^52 + 1023 leaves the biased exponent in the low mantissa bits. */
+		static inline __m256d										Pow2( __m256d _rN ) {
+			__m256i iBits = _mm256_castpd_si256( Add( _rN, Set( 4503599627371519.0 ) ) );
+			return _mm256_castsi256_pd( _mm256_slli_epi64( iBits, 52 ) );
+		}
+		/** x * 2^n for integral n in [-2044, 2046], in 2 steps so that each factor is a normal number. */
+		static inline __m256d										Ldexp( __m256d _rA, __m256d _rN ) {
+			__m256d rN0 = Floor( Mul( _rN, Set( 0.5 ) ) );
+			return Mul( Mul( _rA, Pow2( rN0 ) ), Pow2( Sub( _rN, rN0 ) ) );
+		}
+		static inline __m256d										Frexp( __m256d _rA, __m256d &_rE ) {
+			// Scale subnormals up into the normal range first.
+			Mask mSub = Lt( Abs( _rA ), Set( 2.2250738585072013831e-308 ) );
+			_rA = Select( mSub, Mul( _rA, Set( 4503599627370496.0 ) ), _rA );
+			__m256i iBits = _mm256_castpd_si256( _rA );
+			// The biased exponent is ORed into the mantissa of 2^52 to convert it without AVX-512DQ.
+			__m256i iExp = _mm256_and_si256( _mm256_srli_epi64( iBits, 52 ), _mm256_set1_epi64x( 0x7FF ) );
+			_rE = Sub( _mm256_castsi256_pd( _mm256_or_si256( iExp, _mm256_castpd_si256( Set( 4503599627370496.0 ) ) ) ), Set( 4503599627370496.0 + 1023.0 ) );
+			_rE = Select( mSub, Sub( _rE, Set( 52.0 ) ), _rE );
+			return _mm256_castsi256_pd( _mm256_or_si256( _mm256_and_si256( iBits, _mm256_set1_epi64x( 0x000FFFFFFFFFFFFFLL ) ),
+				_mm256_set1_epi64x( 0x3FF0000000000000LL ) ) );
+		}
+	};
+#endif	// #ifdef __AVX2__
+
+#ifdef __SSE4_1__
+	/** SSE4.1 float operations.  There is no FMA, so Fma() and Fnma() round twice. */
+	template <>
+	struct SimdMath::Ops<float, 4> {
+		using Mask = __m128;
+		using Scalar = float;
+		static constexpr size_t Lanes = 4;
+		static constexpr bool Is32 = true;
+		static constexpr bool FusedFma = false;
+
+		static inline __m128										Set( double _dVal ) { return _mm_set1_ps( float( _dVal ) ); }
+		static inline __m128										Add( __m128 _rA, __m128 _rB ) { return _mm_add_ps( _rA, _rB ); }
+		static inline __m128										Sub( __m128 _rA, __m128 _rB ) { return _mm_sub_ps( _rA, _rB ); }
+		static inline __m128										Mul( __m128 _rA, __m128 _rB ) { return _mm_mul_ps( _rA, _rB ); }
+		static inline __m128										Div( __m128 _rA, __m128 _rB ) { return _mm_div_ps( _rA, _rB ); }
+		static inline __m128										Fma( __m128 _rA, __m128 _rB, __m128 _rC ) { return _mm_add_ps( _mm_mul_ps( _rA, _rB ), _rC ); }
+		static inline __m128										Fnma( __m128 _rA, __m128 _rB, __m128 _rC ) { return _mm_sub_ps( _rC, _mm_mul_ps( _rA, _rB ) ); }
+		static inline __m128										Min( __m128 _rA, __m128 _rB ) { return _mm_min_ps( _rA, _rB ); }
+		static inline __m128										Max( __m128 _rA, __m128 _rB ) { return _mm_max_ps( _rA, _rB ); }
+		static inline __m128										Abs( __m128 _rA ) { return _mm_andnot_ps( Set( -0.0 ), _rA ); }
+		static inline __m128										Neg( __m128 _rA ) { return _mm_xor_ps( _rA, Set( -0.0 ) ); }
+		static inline __m128										SignBit( __m128 _rA ) { return _mm_and_ps( _rA, Set( -0.0 ) ); }
+		static inline __m128										Xor( __m128 _rA, __m128 _rB ) { return _mm_xor_ps( _rA, _rB ); }
+		static inline __m128										Round( __m128 _rA ) { return _mm_round_ps( _rA, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }
+		static inline __m128										Floor( __m128 _rA ) { return _mm_floor_ps( _rA ); }
+		static inline Mask											Lt( __m128 _rA, __m128 _rB ) { return _mm_cmplt_ps( _rA, _rB ); }
+		static inline Mask											Gt( __m128 _rA, __m128 _rB ) { return _mm_cmpgt_ps( _rA, _rB ); }
+		static inline Mask											Ge( __m128 _rA, __m128 _rB ) { return _mm_cmpge_ps( _rA, _rB ); }
+		static inline Mask											NotGe( __m128 _rA, __m128 _rB ) { return _mm_cmpnge_ps( _rA, _rB ); }
+		static inline Mask											Eq( __m128 _rA, __m128 _rB ) { return _mm_cmpeq_ps( _rA, _rB ); }
+		static inline Mask											Or( Mask _mA, Mask _mB ) { return _mm_or_ps( _mA, _mB ); }
+		static inline bool											Any( Mask _mMask ) { return _mm_movemask_ps( _mMask ) != 0; }
+		static inline __m128										Select( Mask _mMask, __m128 _rTrue, __m128 _rFalse ) { return _mm_blendv_ps( _rFalse, _rTrue, _mMask ); }
+		static inline void											Store( float * _ptDst, __m128 _rA ) { _mm_storeu_ps( _ptDst, _rA ); }
+		static inline __m128										Load( const float * _ptSrc ) { return _mm_loadu_ps( _ptSrc ); }
+
+		/** 2^n for integral n in [-126, 127]. */
+		static inline __m128										Pow2( __m128 _rN ) {
+			return _mm_castsi128_ps( _mm_slli_epi32( _mm_add_epi32( _mm_cvtps_epi32( _rN ), _mm_set1_epi32( 127 ) ), 23 ) );
+		}
+		/** x * 2^n for integral n in [-252, 254], in 2 steps so that each factor is a normal number. */
+		static inline __m128										Ldexp( __m128 _rA, __m128 _rN ) {
+			__m128 rN0 = Floor( Mul( _rN, Set( 0.5 ) ) );
+			return Mul( Mul( _rA, Pow2( rN0 ) ), Pow2( Sub( _rN, rN0 ) ) );
+		}
+		static inline __m128										Frexp( __m128 _rA, __m128 &_rE ) {
+			// Scale subnormals up into the normal range first.
+			Mask mSub = Lt( Abs( _rA ), Set( 1.17549435082228750797e-38 ) );
+			_rA = Select( mSub, Mul( _rA, Set( 8388608.0 ) ), _rA );
+			__m128i iBits = _mm_castps_si128( _rA );
+			_rE = _mm_cvtepi32_ps( _mm_sub_epi32( _mm_and_si128( _mm_srli_epi32( iBits, 23 ), _mm_set1_epi32( 0xFF ) ), _mm_set1_epi32( 127 ) ) );
+			_rE = Select( mSub, Sub( _rE, Set( 23.0 ) ), _rE );
+			return _mm_castsi128_ps( _mm_or_si128( _mm_and_si128( iBits, _mm_set1_epi32( 0x007FFFFF ) ), _mm_set1_epi32( 0x3F800000 ) ) );
+		}
+	};
+
+	/** SSE4.1 double operations.  There is no FMA, so Fma() and Fnma() round twice. */
+	template <>
+	struct SimdMath::Ops<double, 2> {
+		using Mask = __m128d;
+		using Scalar = double;
+		static constexpr size_t Lanes = 2;
+		static constexpr bool Is32 = false;
+		static constexpr bool FusedFma = false;
+
+		static inline __m128d										Set( double _dVal ) { return _mm_set1_pd( _dVal ); }
+		static inline __m128d										Add( __m128d _rA, __m128d _rB ) { return _mm_add_pd( _rA, _rB ); }
+		static inline __m128d										Sub( __m128d _rA, __m128d _rB ) { return _mm_sub_pd( _rA, _rB ); }
+		static inline __m128d										Mul( __m128d _rA, __m128d _rB ) { return _mm_mul_pd( _rA, _rB ); }
+		static inline __m128d										Div( __m128d _rA, __m128d _rB ) { return _mm_div_pd( _rA, _rB ); }
+		static inline __m128d										Fma( __m128d _rA, __m128d _rB, __m128d _rC ) { return _mm_add_pd( _mm_mul_pd( _rA, _rB ), _rC ); }
+		static inline __m128d										Fnma( __m128d _rA, __m128d _rB, __m128d _rC ) { return _mm_sub_pd( _rC, _mm_mul_pd( _rA, _rB ) ); }
+		static inline __m128d										Min( __m128d _rA, __m128d _rB ) { return _mm_min_pd( _rA, _rB ); }
+		static inline __m128d										Max( __m128d _rA, __m128d _rB ) { return _mm_max_pd( _rA, _rB ); }
+		static inline __m128d										Abs( __m128d _rA ) { return _mm_andnot_pd( Set( -0.0 ), _rA ); }
+		static inline __m128d										Neg( __m128d _rA ) { return _mm_xor_pd( _rA, Set( -0.0 ) ); }
+		static inline __m128d										SignBit( __m128d _rA ) { return _mm_and_pd( _rA, Set( -0.0 ) ); }
+		static inline __m128d										Xor( __m128d _rA, __m128d _rB ) { return _mm_xor_pd( _rA, _rB ); }
+		static inline __m128d										Round( __m128d _rA ) { return _mm_round_pd( _rA, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }
+		static inline __m128d										Floor( __m128d _rA ) { return _mm_floor_pd( _rA ); }
+		static inline Mask											Lt( __m128d _rA, __m128d _rB ) { return _mm_cmplt_pd( _rA, _rB ); }
+		static inline Mask											Gt( __m128d _rA, __m128d _rB ) { return _mm_cmpgt_pd( _rA, _rB ); }
+		static inline Mask											Ge( __m128d _rA, __m128d _rB ) { return _mm_cmpge_pd( _rA, _rB ); }
+		static inline Mask											NotGe( __m128d _rA, __m128d _rB ) { return _mm_cmpnge_pd( _rA, _rB ); }
+		static inline Mask											Eq( __m128d _rA, __m128d _rB ) { return _mm_cmpeq_pd( _rA, _rB ); }
+		static inline Mask											Or( Mask _mA, Mask _mB ) { return _mm_or_pd( _mA, _mB ); }
+		static inline bool											Any( Mask _mMask ) { return _mm_movemask_pd( _mMask ) != 0; }
+		static inline __m128d										Select( Mask _mMask, __m128d _rTrue, __m128d _rFalse ) { return _mm_blendv_pd( _rFalse, _rTrue, _mMask ); }
+		static inline void											Store( double * _ptDst, __m128d _rA ) { _mm_storeu_pd( _ptDst, _rA ); }
+		static inline __m128d										Load( const double * _ptSrc ) { return _mm_loadu_pd( _ptSrc ); }
+
+		/** 2^n for integral n in [-1022, 1023]; adding 2^52 + 1023 leaves the biased exponent in the low mantissa bits. */
+		static inline __m128d										Pow2( __m128d _rN ) {
+			__m128i iBits = _mm_castpd_si128( Add( _rN, Set( 4503599627371519.0 ) ) );
+			return _mm_castsi128_pd( _mm_slli_epi64( iBits, 52 ) );
+		}
+		/** x * 2^n for integral n in [-2044, 2046], in 2 steps so that each factor is a normal number. */
+		static inline __m128d										Ldexp( __m128d _rA, __m128d _rN ) {
+			__m128d rN0 = Floor( Mul( _rN, Set( 0.5 ) ) );
+			return Mul( Mul( _rA, Pow2( rN0 ) ), Pow2( Sub( _rN, rN0 ) ) );
+		}
+		static inline __m128d										Frexp( __m128d _rA, __m128d &_rE ) {
+			// Scale subnormals up into the normal range first.
+			Mask mSub = Lt( Abs( _rA ), Set( 2.2250738585072013831e-308 ) );
+			_rA = Select( mSub, Mul( _rA, Set( 4503599627370496.0 ) ), _rA );
+			__m128i iBits = _mm_castpd_si128( _rA );
+			// The biased exponent is ORed into the mantissa of 2^52 to convert it without AVX-512DQ.
+			__m128i iExp = _mm_and_si128( _mm_srli_epi64( iBits, 52 ), _mm_set1_epi64x( 0x7FF ) );
+			_rE = Sub( _mm_castsi128_pd( _mm_or_si128( iExp, _mm_castpd_si128( Set( 4503599627370496.0 ) ) ) ), Set( 4503599627370496.0 + 1023.0 ) );
+			_rE = Select( mSub, Sub( _rE, Set( 52.0 ) ), _rE );
+			return _mm_castsi128_pd( _mm_or_si128( _mm_and_si128( iBits, _mm_set1_epi64x( 0x000FFFFFFFFFFFFFLL ) ),
+				_mm_set1_epi64x( 0x3FF0000000000000LL ) ) );
+		}
+	};
+#endif	// #ifdef __SSE4_1__
+
+#ifdef NN9_SIMDMATH_LOCAL
+}	// namespace
+#endif	// #ifdef NN9_SIMDMATH_LOCAL
+
+}	// namespace nn9
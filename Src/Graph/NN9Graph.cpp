@@ -0,0 +1,714 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A static computation graph.  Operations are recorded once with known shapes, compiled into kernels in which chains of
+ *	element-wise and broadcast operations are fused into single loops, and then run any number of times over new inputs.
+ */
+
+#include "NN9Graph.h"
+#include "../Buffers/NN9BufferManager.h"
+#include "../Ops/NN9Gemm.h"
+#include "../Ops/NN9Math.h"
+#include "../Ops/NN9Softmax.h"
+#include "../Utilities/NN9ThreadPool.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+
+namespace nn9 {
+
+	/**
+	 * Calls a function with a null pointer to the C++ type matching a graph type.
+	 *
+	 * \param _tType The type: NN9_T_FLOAT, NN9_T_DOUBLE, NN9_T_BFLOAT16, or NN9_T_FLOAT16.
+	 * \param _fFunc The function to call.
+	 **/
+	template <typename _tFunc>
+	static inline void Dispatch( NN9_TYPE _tType, const _tFunc &_fFunc ) {
+		switch ( _tType ) {
+			case NN9_T_DOUBLE : { _fFunc( static_cast<double *>(nullptr) ); break; }
+			case NN9_T_BFLOAT16 : { _fFunc( static_cast<bfloat16_t *>(nullptr) ); break; }
+			case NN9_T_FLOAT16 : { _fFunc( static_cast<nn9::float16 *>(nullptr) ); break; }
+			default : { _fFunc( static_cast<float *>(nullptr) ); }
+		}
+	}
+
+	// == Members.
+	Graph::Graph( NN9_TYPE _tType ) :
+		m_tType( _tType ),
+		m_sPlannedBytes( 0 ),
+		m_sNaiveBytes( 0 ),
+		m_bCompiled( false ) {
+		if ( _tType != NN9_T_FLOAT && _tType != NN9_T_DOUBLE && _tType != NN9_T_BFLOAT16 && _tType != NN9_T_FLOAT16 ) {
+			throw std::invalid_argument( "Graph::Graph: The type must be NN9_T_FLOAT, NN9_T_DOUBLE, NN9_T_BFLOAT16, or NN9_T_FLOAT16." );
+		}
+	}
+	Graph::~Graph() {
+	}
+
+	// == Functions.
+	/**
+	 * Adds an input.  Inputs are bound, in the order in which they were added, by Run().
+	 *
+	 * \param _vShape The shape of the input.
+	 * \throw Throws if the shape is empty or has a dimension of 0.
+	 * \return Returns the index of the new value.
+	 **/
+	size_t Graph::Input( const std::vector<size_t> &_vShape ) {
+		if ( _vShape.empty() || std::find( _vShape.begin(), _vShape.end(), size_t( 0 ) ) != _vShape.end() ) {
+			throw std::invalid_argument( "Graph::Input: The shape must have at least 1 dimension and no dimension of 0." );
+		}
+		NN9_NODE nNode( NN9_GO_INPUT );
+		nNode.vShape = _vShape;
+		nNode.sIndex = m_vInputs.size();
+		const size_t sRet = Record( std::move( nNode ) );
+		m_vInputs.push_back( sRet );
+		return sRet;
+	}
+
+	/**
+	 * Adds a constant.  It has the shape { 1 } and broadcasts against anything.
+	 *
+	 * \param _dValue The value of the constant.
+	 * \return Returns the index of the new value.
+	 **/
+	size_t Graph::Constant( double _dValue ) {
+		NN9_NODE nNode( NN9_GO_CONSTANT );
+		nNode.vShape = { 1 };
+		nNode.dValue = _dValue;
+		return Record( std::move( nNode ) );
+	}
+
+	/**
+	 * Adds the matrix product of 2 2-D values.  Only float and double graphs can multiply matrices.
+	 *
+	 * \param _sA The [M,K] left operand.
+	 * \param _sB The [K,N] right operand.
+	 * \throw Throws if an operand is invalid, the shapes do not multiply, or the graph's type is not float or double.
+	 * \return Returns the index of the new [M,N] value.
+	 **/
+	size_t Graph::MatMul( size_t _sA, size_t _sB ) {
+		const NN9_NODE & nA = Node( _sA );
+		const NN9_NODE & nB = Node( _sB );
+		if ( m_tType != NN9_T_FLOAT && m_tType != NN9_T_DOUBLE ) { throw std::invalid_argument( "Graph::MatMul: Only float and double graphs can multiply matrices." ); }
+		if ( nA.vShape.size() != 2 || nB.vShape.size() != 2 || nA.vShape[1] != nB.vShape[0] ) {
+			throw std::invalid_argument( "Graph::MatMul: The operands must be [M,K] and [K,N]." );
+		}
+		NN9_NODE nNode( NN9_GO_MATMUL );
+		nNode.saInputs[0] = _sA;
+		nNode.saInputs[1] = _sB;
+		nNode.vShape = { nA.vShape[0], nB.vShape[1] };
+		return Record( std::move( nNode ) );
+	}
+
+	/**
+	 * Adds a sum over the given axes, which are removed from the shape.  Summing over every axis gives the shape { 1 }.
+	 *
+	 * \param _sA The operand.
+	 * \param _vAxes The axes to sum.
+	 * \throw Throws if the operand is invalid or an axis is out of range or repeated.
+	 * \return Returns the index of the new value.
+	 **/
+	size_t Graph::Sum( size_t _sA, const std::vector<size_t> &_vAxes ) {
+		const NN9_NODE & nA = Node( _sA );
+		std::vector<bool> vSummed( nA.vShape.size() );
+		for ( auto sAxis : _vAxes ) {
+			if ( sAxis >= vSummed.size() || vSummed[sAxis] ) { throw std::invalid_argument( "Graph::Sum: Axes must be unique and less than the number of dimensions." ); }
+			vSummed[sAxis] = true;
+		}
+		NN9_NODE nNode( NN9_GO_SUM );
+		nNode.saInputs[0] = _sA;
+		nNode.vAxes = _vAxes;
+		for ( size_t I = 0; I < vSummed.size(); ++I ) {
+			if ( !vSummed[I] ) { nNode.vShape.push_back( nA.vShape[I] ); }
+		}
+		if ( nNode.vShape.empty() ) { nNode.vShape = { 1 }; }
+		return Record( std::move( nNode ) );
+	}
+
+	/**
+	 * Marks a value as an output.  Outputs are returned, in the order in which they were marked, by Run().
+	 *
+	 * \param _sA The value.
+	 * \throw Throws if the value is invalid or is an input or constant.
+	 **/
+	void Graph::Output( size_t _sA ) {
+		const NN9_NODE & nA = Node( _sA );
+		if ( nA.goOp == NN9_GO_INPUT || nA.goOp == NN9_GO_CONSTANT ) { throw std::invalid_argument( "Graph::Output: Outputs must be the results of operations." ); }
+		if ( std::find( m_vOutputs.begin(), m_vOutputs.end(), _sA ) != m_vOutputs.end() ) { throw std::invalid_argument( "Graph::Output: The value is already an output." ); }
+		m_vOutputs.push_back( _sA );
+		m_bCompiled = false;
+		m_vSteps.clear();
+	}
+
+	/**
+	 * Removes values that do not lead to an output and builds the kernels.  Run() calls this if the graph has changed since it was last
+	 *	compiled.
+	 *
+	 * \throw Throws if there are no outputs.
+	 **/
+	void Graph::Compile() {
+		if ( m_vOutputs.empty() ) { throw std::runtime_error( "Graph::Compile: The graph has no outputs." ); }
+		const size_t sTotal = m_vNodes.size();
+
+		// Operands always precede their results, so 1 backward sweep finds every value that leads to an output.
+		std::vector<bool> vLive( sTotal ), vOutput( sTotal );
+		for ( auto sOut : m_vOutputs ) { vLive[sOut] = vOutput[sOut] = true; }
+		std::vector<size_t> vUsers( sTotal ), vUser( sTotal );
+		for ( size_t I = sTotal; I--; ) {
+			if ( !vLive[I] ) { continue; }
+			for ( auto sIn : m_vNodes[I].saInputs ) {
+				if ( sIn == ~size_t( 0 ) ) { continue; }
+				vLive[sIn] = true;
+				++vUsers[sIn];
+				vUser[sIn] = I;
+			}
+		}
+		// Binary( x, x ) uses x twice but has 1 consumer.
+		for ( size_t I = 0; I < sTotal; ++I ) {
+			if ( vLive[I] && m_vNodes[I].saInputs[0] != ~size_t( 0 ) && m_vNodes[I].saInputs[0] == m_vNodes[I].saInputs[1] ) { --vUsers[m_vNodes[I].saInputs[0]]; }
+		}
+
+		// An element-wise value is computed inside its consumer's kernel if it has no other use and the consumer has its shape, so
+		//	that fusing it never repeats its work.
+		std::vector<bool> vFused( sTotal );
+		for ( size_t I = 0; I < sTotal; ++I ) {
+			const NN9_NODE & nThis = m_vNodes[I];
+			if ( !vLive[I] || vOutput[I] || !Fusible( nThis.goOp ) || vUsers[I] != 1 ) { continue; }
+			const NN9_NODE & nUser = m_vNodes[vUser[I]];
+			vFused[I] = Fusible( nUser.goOp ) && nUser.vShape == nThis.vShape;
+		}
+
+		m_vSteps.clear();
+		for ( size_t I = 0; I < sTotal; ++I ) {
+			const NN9_NODE & nThis = m_vNodes[I];
+			if ( !vLive[I] || vFused[I] || nThis.goOp == NN9_GO_INPUT || nThis.goOp == NN9_GO_CONSTANT ) { continue; }
+			if ( Fusible( nThis.goOp ) ) { m_vSteps.push_back( BuildFused( I, vFused ) ); }
+			else {
+				NN9_STEP sStep;
+				sStep.sNode = I;
+				sStep.sSlots = 0;
+				m_vSteps.push_back( std::move( sStep ) );
+			}
+		}
+		PlanMemory( vOutput );
+		m_bCompiled = true;
+	}
+
+	/**
+	 * Runs the graph, writing the outputs into caller-owned tensors.  Inputs may have any strides; outputs must be contiguous.
+	 *
+	 * \param _vInputs The inputs, in the order in which they were added.
+	 * \param _vOutputs The outputs, in the order in which they were marked.
+	 * \throw Throws if the number, types, or shapes of the tensors are wrong, or if an output is not contiguous.
+	 **/
+	void Graph::Run( const std::vector<Tensor *> &_vInputs, const std::vector<Tensor *> &_vOutputs ) {
+		if ( !m_bCompiled ) { Compile(); }
+		if ( _vInputs.size() != m_vInputs.size() ) { throw std::invalid_argument( "Graph::Run: The number of inputs does not match the graph." ); }
+		if ( _vOutputs.size() != m_vOutputs.size() ) { throw std::invalid_argument( "Graph::Run: The number of outputs does not match the graph." ); }
+
+		std::vector<Tensor *> vValues( m_vNodes.size() );
+		auto aBind = [&]( Tensor * _ptTensor, size_t _sNode, bool _bOutput ) {
+			if ( !_ptTensor ) { throw std::invalid_argument( "Graph::Run: A tensor is missing." ); }
+			if ( _ptTensor->Type() != m_tType ) { throw std::invalid_argument( "Graph::Run: Every tensor must have the graph's type." ); }
+			if ( _ptTensor->Shape() != m_vNodes[_sNode].vShape ) { throw std::invalid_argument( "Graph::Run: A tensor does not have its value's shape." ); }
+			if ( _bOutput && !_ptTensor->IsContiguous() ) { throw std::invalid_argument( "Graph::Run: Outputs must be contiguous." ); }
+			vValues[_sNode] = _ptTensor;
+		};
+		for ( size_t I = 0; I < _vInputs.size(); ++I ) { aBind( _vInputs[I], m_vInputs[I], false ); }
+		for ( size_t I = 0; I < _vOutputs.size(); ++I ) { aBind( _vOutputs[I], m_vOutputs[I], true ); }
+
+		std::vector<std::unique_ptr<Tensor>> vOwned;
+		for ( size_t I = 0; I < m_vNodes.size(); ++I ) {
+			if ( m_vNodes[I].goOp != NN9_GO_CONSTANT ) { continue; }
+			vOwned.push_back( NewTensor( m_vNodes[I].vShape, m_tType ) );
+			vValues[I] = vOwned.back().get();
+			Dispatch( m_tType, [&]( auto _ptTag ) {
+				using Type = std::remove_pointer_t<decltype( _ptTag )>;
+				vValues[I]->Strided<Type>().Data()[0] = static_cast<Type>(m_vNodes[I].dValue);
+			} );
+		}
+
+		for ( const auto & sStep : m_vSteps ) {
+			if ( !vValues[sStep.sNode] ) { vValues[sStep.sNode] = m_vPlanned[sStep.sNode].get(); }
+			if ( sStep.vCode.empty() ) { RunOp( sStep, vValues ); }
+			else {
+				Dispatch( m_tType, [&]( auto _ptTag ) {
+					RunFused<std::remove_pointer_t<decltype( _ptTag )>>( sStep, vValues );
+				} );
+			}
+		}
+	}
+
+	/**
+	 * Runs the graph, creating the outputs.
+	 *
+	 * \param _vInputs The inputs, in the order in which they were added.
+	 * \throw Throws if the number, types, or shapes of the inputs are wrong.
+	 * \return Returns the outputs, in the order in which they were marked.
+	 **/
+	std::vector<Tensor> Graph::Run( const std::vector<Tensor *> &_vInputs ) {
+		std::vector<std::unique_ptr<Tensor>> vOut;
+		std::vector<Tensor *> vPtrs;
+		for ( auto sOut : m_vOutputs ) {
+			vOut.push_back( NewTensor( m_vNodes[sOut].vShape, m_tType ) );
+			vPtrs.push_back( vOut.back().get() );
+		}
+		Run( _vInputs, vPtrs );
+		std::vector<Tensor> vRet;
+		vRet.reserve( vOut.size() );
+		for ( auto & upOut : vOut ) { vRet.push_back( std::move( (*upOut) ) ); }
+		return vRet;
+	}
+
+	/**
+	 * Gets the shape of a value.
+	 *
+	 * \param _sA The value.
+	 * \throw Throws if the value is invalid.
+	 * \return Returns the shape of the value.
+	 **/
+	const std::vector<size_t> & Graph::Shape( size_t _sA ) const {
+		return Node( _sA ).vShape;
+	}
+
+	/**
+	 * Gets a recorded value, checking the index.
+	 *
+	 * \param _sA The value.
+	 * \throw Throws if the value is invalid.
+	 * \return Returns the node.
+	 **/
+	const Graph::NN9_NODE & Graph::Node( size_t _sA ) const {
+		if ( _sA >= m_vNodes.size() ) { throw std::out_of_range( "Graph::Node: Invalid value." ); }
+		return m_vNodes[_sA];
+	}
+
+	/**
+	 * Adds a node and marks the graph as needing compilation.
+	 *
+	 * \param _nNode The node to add.
+	 * \return Returns the index of the new value.
+	 **/
+	size_t Graph::Record( NN9_NODE &&_nNode ) {
+		m_vNodes.push_back( std::move( _nNode ) );
+		m_bCompiled = false;
+		m_vSteps.clear();
+		return m_vNodes.size() - 1;
+	}
+
+	/**
+	 * Adds an element-wise operation on 1 value.
+	 *
+	 * \param _goOp The operation.
+	 * \param _sA The operand.
+	 * \throw Throws if the operand is invalid.
+	 * \return Returns the index of the new value.
+	 **/
+	size_t Graph::Unary( NN9_GRAPH_OP _goOp, size_t _sA ) {
+		NN9_NODE nNode( _goOp );
+		nNode.saInputs[0] = _sA;
+		nNode.vShape = Node( _sA ).vShape;
+		return Record( std::move( nNode ) );
+	}
+
+	/**
+	 * Adds an element-wise operation on 2 values, broadcasting them against each other.
+	 *
+	 * \param _goOp The operation.
+	 * \param _sA The left operand.
+	 * \param _sB The right operand.
+	 * \throw Throws if an operand is invalid or the shapes do not broadcast.
+	 * \return Returns the index of the new value.
+	 **/
+	size_t Graph::Binary( NN9_GRAPH_OP _goOp, size_t _sA, size_t _sB ) {
+		const std::vector<size_t> & vA = Node( _sA ).vShape;
+		const std::vector<size_t> & vB = Node( _sB ).vShape;
+		NN9_NODE nNode( _goOp );
+		nNode.saInputs[0] = _sA;
+		nNode.saInputs[1] = _sB;
+		nNode.vShape.resize( std::max( vA.size(), vB.size() ) );
+		for ( size_t I = 0; I < nNode.vShape.size(); ++I ) {
+			// Align the shapes on their last dimensions.
+			const size_t sA = I < vA.size() ? vA[vA.size()-1-I] : 1;
+			const size_t sB = I < vB.size() ? vB[vB.size()-1-I] : 1;
+			if ( sA != sB && sA != 1 && sB != 1 ) { throw std::invalid_argument( "Graph::Binary: The shapes do not broadcast." ); }
+			nNode.vShape[nNode.vShape.size()-1-I] = std::max( sA, sB );
+		}
+		return Record( std::move( nNode ) );
+	}
+
+	/**
+	 * Adds an operation along 1 axis that keeps the shape.
+	 *
+	 * \param _goOp The operation.
+	 * \param _sA The operand.
+	 * \param _sAxis The axis.
+	 * \throw Throws if the operand or axis is invalid.
+	 * \return Returns the index of the new value.
+	 **/
+	size_t Graph::Axis( NN9_GRAPH_OP _goOp, size_t _sA, size_t _sAxis ) {
+		NN9_NODE nNode( _goOp );
+		nNode.saInputs[0] = _sA;
+		nNode.vShape = Node( _sA ).vShape;
+		if ( _sAxis >= nNode.vShape.size() ) { throw std::out_of_range( "Graph::Axis: Invalid axis." ); }
+		nNode.sIndex = _sAxis;
+		return Record( std::move( nNode ) );
+	}
+
+	/**
+	 * Builds a fused kernel for a value and every operation fused into it.
+	 *
+	 * \param _sRoot The value the kernel produces.
+	 * \param _vFused Per value, true if it is computed inside the kernel of its consumer.
+	 * \return Returns the kernel.
+	 **/
+	Graph::NN9_STEP Graph::BuildFused( size_t _sRoot, const std::vector<bool> &_vFused ) const {
+		NN9_STEP sStep;
+		sStep.sNode = _sRoot;
+
+		// Order the fused values so that operands come before their consumer, and give every other operand a leaf slot.
+		std::vector<size_t> vOrder;
+		std::vector<uint32_t> vSlot( m_vNodes.size(), ~uint32_t( 0 ) );
+		std::function<void ( size_t )> fVisit = [&]( size_t _sNode ) {
+			for ( auto sIn : m_vNodes[_sNode].saInputs ) {
+				if ( sIn == ~size_t( 0 ) ) { continue; }
+				if ( _vFused[sIn] ) { fVisit( sIn ); }
+				else if ( vSlot[sIn] == ~uint32_t( 0 ) ) {
+					vSlot[sIn] = uint32_t( sStep.vLeaves.size() );
+					sStep.vLeaves.push_back( sIn );
+				}
+			}
+			vOrder.push_back( _sNode );
+		};
+		fVisit( _sRoot );
+
+		// Every fused value has exactly 1 consumer, so its slot is free again once that consumer has read it.  The result gets a slot of
+		//	its own that is written only by the last instruction, so that it can point straight at the output.
+		std::vector<uint32_t> vFree;
+		uint32_t ui32Next = uint32_t( sStep.vLeaves.size() );
+		for ( auto sNode : vOrder ) {
+			const NN9_NODE & nThis = m_vNodes[sNode];
+			NN9_INSTR iInstr;
+			iInstr.goOp = nThis.goOp;
+			iInstr.ui32A = vSlot[nThis.saInputs[0]];
+			iInstr.ui32B = nThis.saInputs[1] == ~size_t( 0 ) ? iInstr.ui32A : vSlot[nThis.saInputs[1]];
+			for ( auto sIn : nThis.saInputs ) {
+				if ( sIn != ~size_t( 0 ) && _vFused[sIn] && vSlot[sIn] != ~uint32_t( 0 ) ) {
+					vFree.push_back( vSlot[sIn] );
+					vSlot[sIn] = ~uint32_t( 0 );
+				}
+			}
+			if ( sNode == _sRoot ) { iInstr.ui32Dst = ~uint32_t( 0 ); }
+			else if ( vFree.size() ) {
+				iInstr.ui32Dst = vFree.back();
+				vFree.pop_back();
+			}
+			else { iInstr.ui32Dst = ui32Next++; }
+			vSlot[sNode] = iInstr.ui32Dst;
+			sStep.vCode.push_back( iInstr );
+		}
+		sStep.sSlots = size_t( ui32Next ) + 1;
+		sStep.vCode.back().ui32Dst = ui32Next;
+		return sStep;
+	}
+
+	/**
+	 * Finds the lifetimes of the values the kernels produce that are not outputs and creates their tensors in 1 shared arena.
+	 *
+	 * \param _vOutput Per value, true if it is an output.
+	 **/
+	void Graph::PlanMemory( const std::vector<bool> &_vOutput ) {
+		m_vPlanned.clear();
+		m_vPlanned.resize( m_vNodes.size() );
+		m_sPlannedBytes = m_sNaiveBytes = 0;
+
+		// A value lives from the kernel that writes it through the last kernel that reads it.  Kernels never write over what they read,
+		//	so a value read by a kernel cannot share memory with the value the kernel writes.
+		std::vector<size_t> vLast( m_vNodes.size() );
+		for ( size_t I = 0; I < m_vSteps.size(); ++I ) {
+			const NN9_STEP & sStep = m_vSteps[I];
+			vLast[sStep.sNode] = I;
+			if ( sStep.vCode.size() ) {
+				for ( auto sLeaf : sStep.vLeaves ) { vLast[sLeaf] = I; }
+			}
+			else {
+				for ( auto sIn : m_vNodes[sStep.sNode].saInputs ) {
+					if ( sIn != ~size_t( 0 ) ) { vLast[sIn] = I; }
+				}
+			}
+		}
+		std::vector<MemoryPlanner::NN9_BLOCK> vBlocks;
+		std::vector<size_t> vBlockNodes;
+		for ( size_t I = 0; I < m_vSteps.size(); ++I ) {
+			const size_t sNode = m_vSteps[I].sNode;
+			if ( _vOutput[sNode] ) { continue; }
+			size_t sElements = 1;
+			for ( auto sDim : m_vNodes[sNode].vShape ) { sElements *= sDim; }
+			vBlocks.emplace_back( sElements * Types::SizeOf( m_tType ), I, vLast[sNode] );
+			vBlockNodes.push_back( sNode );
+		}
+		if ( vBlocks.empty() ) { return; }
+
+		m_sPlannedBytes = MemoryPlanner::Plan( vBlocks );
+		m_sNaiveBytes = MemoryPlanner::NaiveSize( vBlocks );
+		// The tensors hold the arena; once they exist, the graph's own reference is not needed.
+		Buffer * pbArena = BufferManager::GblBufferManager.CreateBuffer( NN9_T_UINT8, m_sPlannedBytes );
+		try {
+			for ( size_t I = 0; I < vBlocks.size(); ++I ) {
+				m_vPlanned[vBlockNodes[I]].reset( new Tensor( pbArena, vBlocks[I].sOffset, m_vNodes[vBlockNodes[I]].vShape, m_tType ) );
+			}
+		}
+		catch ( ... ) {
+			m_vPlanned.clear();
+			BufferManager::GblBufferManager.DeleteBuffer( pbArena );
+			throw;
+		}
+		BufferManager::GblBufferManager.DeleteBuffer( pbArena );
+	}
+
+	/**
+	 * Runs a kernel that is not fused.
+	 *
+	 * \param _sStep The kernel.
+	 * \param _vValues The tensor of each value, with those of the kernel's operands and result set.
+	 **/
+	void Graph::RunOp( const NN9_STEP &_sStep, const std::vector<Tensor *> &_vValues ) const {
+		const NN9_NODE & nThis = m_vNodes[_sStep.sNode];
+		Tensor & tOut = (*_vValues[_sStep.sNode]);
+		Tensor & tA = (*_vValues[nThis.saInputs[0]]);
+		Dispatch( m_tType, [&]( auto _ptTag ) {
+			using Type = std::remove_pointer_t<decltype( _ptTag )>;
+			StridedView<Type> svOut = tOut.Strided<Type>();
+			switch ( nThis.goOp ) {
+				case NN9_GO_MATMUL : {
+					if constexpr ( std::is_same<Type, float>::value || std::is_same<Type, double>::value ) {
+						const size_t sM = nThis.vShape[0], sN = nThis.vShape[1], sK = m_vNodes[nThis.saInputs[0]].vShape[1];
+						Tensor tAc = tA.Contiguous(), tBc = _vValues[nThis.saInputs[1]]->Contiguous();
+						StridedView<Type> svA = tAc.Strided<Type>(), svB = tBc.Strided<Type>();
+						Gemm::Run<Type>( sM, sN, sK, svA.Data(), sK, 1, svB.Data(), sN, 1, svOut.Data(), sN, 1 );
+					}
+					break;
+				}
+				case NN9_GO_SOFTMAX : {
+					nn9::Softmax::Forward<Type>( tA.Strided<Type>(), svOut, nThis.sIndex );
+					break;
+				}
+				case NN9_GO_LOG_SOFTMAX : {
+					nn9::Softmax::LogForward<Type>( tA.Strided<Type>(), svOut, nThis.sIndex );
+					break;
+				}
+				case NN9_GO_SUM : {
+					Math::Sum( tA.Strided<Type>(), nThis.vAxes, svOut );
+					break;
+				}
+				default : {}
+			}
+		} );
+	}
+
+	/**
+	 * Runs a fused kernel.
+	 *
+	 * \tparam _tType The graph's C++ type.
+	 * \param _sStep The kernel.
+	 * \param _vValues The tensor of each value, with those of the kernel's leaves and result set.
+	 **/
+	template <typename _tType>
+	void Graph::RunFused( const NN9_STEP &_sStep, const std::vector<Tensor *> &_vValues ) const {
+		using Scalar = typename std::conditional<std::is_same<_tType, double>::value, double, float>::type;
+		const std::vector<size_t> & vShape = m_vNodes[_sStep.sNode].vShape;
+		const size_t sRank = vShape.size();
+		const size_t sLeaves = _sStep.vLeaves.size();
+		const size_t sArrays = sLeaves + 1;
+
+		// The strides of every leaf (broadcast dimensions have stride 0) and, last, of the output, over the output's shape.
+		std::vector<const _tType *> vBases( sArrays );
+		std::vector<std::vector<size_t>> vStrides( sArrays, std::vector<size_t>( sRank ) );
+		for ( size_t A = 0; A < sArrays; ++A ) {
+			Tensor & tThis = (*_vValues[A < sLeaves ? _sStep.vLeaves[A] : _sStep.sNode]);
+			const std::vector<size_t> & vThisShape = tThis.Shape();
+			const size_t sSkip = sRank - vThisShape.size();
+			for ( size_t D = sSkip; D < sRank; ++D ) {
+				vStrides[A][D] = vThisShape[D-sSkip] == 1 ? 0 : tThis.Strides()[D-sSkip];
+			}
+			vBases[A] = tThis.Strided<_tType>().Data();
+		}
+
+		// Drop dimensions of 1 and merge neighbors that every array walks as 1 run, so that the innermost loop is as long as possible.
+		std::vector<size_t> vDims;
+		std::vector<std::vector<size_t>> vDimStrides( sArrays );
+		for ( size_t D = 0; D < sRank; ++D ) {
+			if ( vShape[D] == 1 ) { continue; }
+			bool bMerge = vDims.size() != 0;
+			for ( size_t A = 0; A < sArrays && bMerge; ++A ) { bMerge = vDimStrides[A].back() == vStrides[A][D] * vShape[D]; }
+			if ( bMerge ) {
+				vDims.back() *= vShape[D];
+				for ( size_t A = 0; A < sArrays; ++A ) { vDimStrides[A].back() = vStrides[A][D]; }
+			}
+			else {
+				vDims.push_back( vShape[D] );
+				for ( size_t A = 0; A < sArrays; ++A ) { vDimStrides[A].push_back( vStrides[A][D] ); }
+			}
+		}
+		if ( vDims.empty() ) {
+			vDims.push_back( 1 );
+			for ( size_t A = 0; A < sArrays; ++A ) { vDimStrides[A].push_back( 0 ); }
+		}
+		const size_t sWidth = vDims.back();
+		const size_t sTilesPerRow = (sWidth + NN9_G_TILE - 1) / NN9_G_TILE;
+		size_t sRows = 1;
+		for ( size_t D = 0; D + 1 < vDims.size(); ++D ) { sRows *= vDims[D]; }
+
+		auto aTask = [&]( size_t _sBegin, size_t _sEnd ) {
+			std::vector<Scalar> vScratch( _sStep.sSlots * NN9_G_TILE );
+			std::vector<Scalar *> vSlots( _sStep.sSlots );
+			for ( size_t S = 0; S < _sStep.sSlots; ++S ) { vSlots[S] = &vScratch[S*NN9_G_TILE]; }
+			std::vector<const _tType *> vFilled( sLeaves );
+			std::vector<size_t> vRowOff( sArrays );
+			size_t sCurRow = ~size_t( 0 );
+			for ( size_t U = _sBegin; U < _sEnd; ++U ) {
+				const size_t sRow = U / sTilesPerRow;
+				const size_t sCol = (U % sTilesPerRow) * NN9_G_TILE;
+				const size_t sCount = std::min<size_t>( NN9_G_TILE, sWidth - sCol );
+				if ( sRow != sCurRow ) {
+					sCurRow = sRow;
+					std::fill( vRowOff.begin(), vRowOff.end(), size_t( 0 ) );
+					size_t sRem = sRow;
+					for ( size_t D = vDims.size() - 1; D--; ) {
+						const size_t sIdx = sRem % vDims[D];
+						sRem /= vDims[D];
+						for ( size_t A = 0; A < sArrays; ++A ) { vRowOff[A] += sIdx * vDimStrides[A][D]; }
+					}
+				}
+
+				// Point each leaf slot at its input when it can be read in place, otherwise fill its scratch.
+				for ( size_t L = 0; L < sLeaves; ++L ) {
+					const size_t sInner = vDimStrides[L].back();
+					const _tType * ptSrc = vBases[L] + vRowOff[L] + sCol * sInner;
+					Scalar * psScratch = &vScratch[L*NN9_G_TILE];
+					if constexpr ( std::is_same<_tType, Scalar>::value ) {
+						if ( sInner == 1 ) {
+							vSlots[L] = const_cast<Scalar *>(ptSrc);
+							continue;
+						}
+					}
+					vSlots[L] = psScratch;
+					if ( sInner == 0 ) {
+						if ( vFilled[L] != ptSrc ) {
+							std::fill( psScratch, psScratch + NN9_G_TILE, static_cast<Scalar>(*ptSrc) );
+							vFilled[L] = ptSrc;
+						}
+					}
+					else {
+						for ( size_t I = 0; I < sCount; ++I ) { psScratch[I] = static_cast<Scalar>(ptSrc[I*sInner]); }
+					}
+				}
+
+				const size_t sRes = _sStep.sSlots - 1;
+				const size_t sOutInner = vDimStrides[sLeaves].back();
+				_tType * ptOut = const_cast<_tType *>(vBases[sLeaves]) + vRowOff[sLeaves] + sCol * sOutInner;
+				bool bDirect = false;
+				if constexpr ( std::is_same<_tType, Scalar>::value ) { bDirect = sOutInner == 1; }
+				vSlots[sRes] = bDirect ? reinterpret_cast<Scalar *>(ptOut) : &vScratch[sRes*NN9_G_TILE];
+
+				for ( const auto & iInstr : _sStep.vCode ) { Exec<Scalar>( iInstr, sCount, vSlots.data() ); }
+
+				if ( !bDirect ) {
+					const Scalar * psRes = vSlots[sRes];
+					for ( size_t I = 0; I < sCount; ++I ) { ptOut[I*sOutInner] = static_cast<_tType>(psRes[I]); }
+				}
+			}
+		};
+
+		const size_t sUnits = sRows * sTilesPerRow;
+		const size_t sGrain = std::max<size_t>( 1, NN9_G_PARALLEL_ELEMENTS / std::min<size_t>( sWidth, NN9_G_TILE ) );
+		if ( sUnits > sGrain ) { ThreadPool::Global().ParallelFor( 0, sUnits, sGrain, aTask ); }
+		else { aTask( 0, sUnits ); }
+	}
+
+	/**
+	 * Runs 1 instruction over the first _sTotal elements of its slots, through the kernel table's fused-instruction kernel when it has
+	 *	one.
+	 *
+	 * \tparam _tScalar The compute type.
+	 * \param _iInstr The instruction.
+	 * \param _sTotal The number of elements.
+	 * \param _ppsSlots The slots.
+	 **/
+	template <typename _tScalar>
+	void Graph::Exec( const NN9_INSTR &_iInstr, size_t _sTotal, _tScalar * const * _ppsSlots ) {
+		static_assert( size_t( NN9_GO_SIGMOID - NN9_GO_NEG ) == size_t( Kernels::NN9_KF_SIGMOID ) && size_t( NN9_GO_MIN - NN9_GO_NEG ) == size_t( Kernels::NN9_KF_MIN ),
+			"Graph::Exec: The element-wise NN9_GRAPH_OP values and Kernels::NN9_KERNEL_FUSED must match." );
+		const _tScalar * psA = _ppsSlots[_iInstr.ui32A];
+		const _tScalar * psB = _ppsSlots[_iInstr.ui32B];
+		_tScalar * psDst = _ppsSlots[_iInstr.ui32Dst];
+		if ( _iInstr.goOp >= NN9_GO_NEG && _iInstr.goOp <= NN9_GO_MIN ) {
+			const Kernels::NN9_KERNEL_FUSED kfOp = Kernels::NN9_KERNEL_FUSED( _iInstr.goOp - NN9_GO_NEG );
+			if constexpr ( std::is_same<_tScalar, double>::value ) {
+				if ( Kernels::Table().pfFusedF64 ) { return Kernels::Table().pfFusedF64( kfOp, psA, psB, psDst, _sTotal ); }
+			}
+			else {
+				if ( Kernels::Table().pfFusedF32 ) { return Kernels::Table().pfFusedF32( kfOp, psA, psB, psDst, _sTotal ); }
+			}
+		}
+
+		using Isa = NN9_ISA_SCALAR<_tScalar>;
+		using Reg = typename Isa::Reg;
+		auto aUnary = [&]( auto _fFunc ) {
+			for ( size_t I = 0; I < _sTotal; ++I ) { Isa::Store( psDst + I, _fFunc( Isa::Load( psA + I ) ) ); }
+		};
+		auto aBinary = [&]( auto _fFunc ) {
+			for ( size_t I = 0; I < _sTotal; ++I ) { Isa::Store( psDst + I, _fFunc( Isa::Load( psA + I ), Isa::Load( psB + I ) ) ); }
+		};
+		switch ( _iInstr.goOp ) {
+			case NN9_GO_NEG : { aUnary( []( Reg _rX ) { return Isa::Neg( _rX ); } ); break; }
+			case NN9_GO_ABS : { aUnary( []( Reg _rX ) { return Isa::Abs( _rX ); } ); break; }
+			case NN9_GO_SQUARE : { aUnary( []( Reg _rX ) { return Isa::Mul( _rX, _rX ); } ); break; }
+			case NN9_GO_SQRT : { aUnary( []( Reg _rX ) { return Isa::Sqrt( _rX ); } ); break; }
+			case NN9_GO_EXP : { aUnary( []( Reg _rX ) { return Isa::Exp( _rX ); } ); break; }
+			case NN9_GO_LOG : { aUnary( []( Reg _rX ) { return Isa::Log( _rX ); } ); break; }
+			case NN9_GO_TANH : { aUnary( []( Reg _rX ) { return Isa::Tanh( _rX ); } ); break; }
+			case NN9_GO_SIGMOID : {
+				const Reg rOne = Isa::Set1( 1 );
+				aUnary( [&]( Reg _rX ) { return Isa::Div( rOne, Isa::Add( rOne, Isa::Exp( Isa::Neg( _rX ) ) ) ); } );
+				break;
+			}
+			case NN9_GO_RELU : {
+				const Reg rZero = Isa::Set1( 0 );
+				aUnary( [&]( Reg _rX ) { return Isa::Max( _rX, rZero ); } );
+				break;
+			}
+			case NN9_GO_ADD : { aBinary( []( Reg _rA, Reg _rB ) { return Isa::Add( _rA, _rB ); } ); break; }
+			case NN9_GO_SUB : { aBinary( []( Reg _rA, Reg _rB ) { return Isa::Sub( _rA, _rB ); } ); break; }
+			case NN9_GO_MUL : { aBinary( []( Reg _rA, Reg _rB ) { return Isa::Mul( _rA, _rB ); } ); break; }
+			case NN9_GO_DIV : { aBinary( []( Reg _rA, Reg _rB ) { return Isa::Div( _rA, _rB ); } ); break; }
+			case NN9_GO_MAX : { aBinary( []( Reg _rA, Reg _rB ) { return Isa::Max( _rA, _rB ); } ); break; }
+			case NN9_GO_MIN : { aBinary( []( Reg _rA, Reg _rB ) { return Isa::Min( _rA, _rB ); } ); break; }
+			default : {}
+		}
+	}
+
+	/**
+	 * Creates a contiguous tensor.
+	 *
+	 * \param _vShape The shape.
+	 * \param _tType The type.
+	 * \return Returns the new tensor.
+	 **/
+	std::unique_ptr<Tensor> Graph::NewTensor( const std::vector<size_t> &_vShape, NN9_TYPE _tType ) {
+		std::vector<size_t> vStride( _vShape.size() );
+		size_t sStride = 1;
+		for ( size_t I = _vShape.size(); I--; ) {
+			vStride[I] = sStride;
+			sStride *= _vShape[I];
+		}
+		return std::unique_ptr<Tensor>( new Tensor( _vShape, vStride, _tType, 1.0, 0.0 ) );
+	}
+
+}	// namespace nn9
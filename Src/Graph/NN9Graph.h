@@ -0,0 +1,551 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A static computation graph.  Operations are recorded once with known shapes, compiled into kernels in which chains of
+ *	element-wise and broadcast operations are fused into single loops, and then run any number of times over new inputs.
+ */
+
+#pragma once
+
+#include "../Foundation/NN9Kernels.h"
+#include "NN9MemoryPlanner.h"
+#include "../Tensor/NN9Tensor.h"
+#include "../Types/NN9Types.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+
+namespace nn9 {
+
+	/**
+	 * Class Graph
+	 * \brief A static computation graph.
+	 *
+	 * Description: A static computation graph.  Recording an operation only adds a node; nothing runs until Run().  Compile() (called by
+	 *	Run() when needed) removes nodes that do not lead to an output and groups the rest into kernels.  Element-wise and broadcast
+	 *	operations are fused into the kernel of the value that consumes them as long as they have only that 1 consumer and its shape; a
+	 *	fused kernel walks its output once in tiles of NN9_G_TILE elements, loading each input once, running the whole chain on the tile
+	 *	with the same SIMD functions the element-wise Math functions use, and writing only the final value.  The intermediate values of a
+	 *	chain never reach memory beyond the tile, which stays in L1, so a memory-bound chain costs about 1 read of each input and 1 write.
+	 *	Matrix multiplies, softmaxes, and sums are run by their own kernels and always produce a tensor.
+	 *
+	 * Compile() also plans the memory of the values kernels produce that are not outputs.  Each is needed only from the kernel that writes
+	 *	it through the last kernel that reads it, so MemoryPlanner packs them all into 1 arena in which values that are never needed at the
+	 *	same time share memory, and every such value's tensor is a view into it.  The arena is allocated once and reused by every Run(),
+	 *	which is therefore not safe to call on 1 graph from more than 1 thread at a time.
+	 *
+	 * Every value in a graph has the graph's type: NN9_T_FLOAT, NN9_T_DOUBLE, NN9_T_BFLOAT16, or NN9_T_FLOAT16.  Fused chains compute in
+	 *	double for double graphs and in float otherwise.
+	 */
+	class Graph {
+	public :
+		Graph( NN9_TYPE _tType = NN9_T_FLOAT );
+		~Graph();
+
+
+		// == Enumerations.
+		/** Tuning constants. */
+		enum NN9_GRAPH : size_t {
+			NN9_G_TILE							= 256,									/**< The elements each fused instruction processes at a time. */
+			NN9_G_PARALLEL_ELEMENTS				= 1 << 15,								/**< The fewest elements given to each thread. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Adds an input.  Inputs are bound, in the order in which they were added, by Run().
+		 *
+		 * \param _vShape The shape of the input.
+		 * \throw Throws if the shape is empty or has a dimension of 0.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Input( const std::vector<size_t> &_vShape );
+
+		/**
+		 * Adds a constant.  It has the shape { 1 } and broadcasts against anything.
+		 *
+		 * \param _dValue The value of the constant.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Constant( double _dValue );
+
+		/**
+		 * Adds -a.
+		 *
+		 * \param _sA The operand.
+		 * \throw Throws if the operand is invalid.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Neg( size_t _sA ) { return Unary( NN9_GO_NEG, _sA ); }
+
+		/**
+		 * Adds |a|.
+		 *
+		 * \param _sA The operand.
+		 * \throw Throws if the operand is invalid.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Abs( size_t _sA ) { return Unary( NN9_GO_ABS, _sA ); }
+
+		/**
+		 * Adds a * a.
+		 *
+		 * \param _sA The operand.
+		 * \throw Throws if the operand is invalid.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Square( size_t _sA ) { return Unary( NN9_GO_SQUARE, _sA ); }
+
+		/**
+		 * Adds sqrt( a ).
+		 *
+		 * \param _sA The operand.
+		 * \throw Throws if the operand is invalid.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Sqrt( size_t _sA ) { return Unary( NN9_GO_SQRT, _sA ); }
+
+		/**
+		 * Adds exp( a ).
+		 *
+		 * \param _sA The operand.
+		 * \throw Throws if the operand is invalid.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Exp( size_t _sA ) { return Unary( NN9_GO_EXP, _sA ); }
+
+		/**
+		 * Adds log( a ).
+		 *
+		 * \param _sA The operand.
+		 * \throw Throws if the operand is invalid.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Log( size_t _sA ) { return Unary( NN9_GO_LOG, _sA ); }
+
+		/**
+		 * Adds tanh( a ).
+		 *
+		 * \param _sA The operand.
+		 * \throw Throws if the operand is invalid.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Tanh( size_t _sA ) { return Unary( NN9_GO_TANH, _sA ); }
+
+		/**
+		 * Adds 1 / (1 + exp( -a )).
+		 *
+		 * \param _sA The operand.
+		 * \throw Throws if the operand is invalid.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Sigmoid( size_t _sA ) { return Unary( NN9_GO_SIGMOID, _sA ); }
+
+		/**
+		 * Adds max( a, 0 ).
+		 *
+		 * \param _sA The operand.
+		 * \throw Throws if the operand is invalid.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Relu( size_t _sA ) { return Unary( NN9_GO_RELU, _sA ); }
+
+		/**
+		 * Adds a + b, broadcasting the operands against each other.
+		 *
+		 * \param _sA The left operand.
+		 * \param _sB The right operand.
+		 * \throw Throws if an operand is invalid or the shapes do not broadcast.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Add( size_t _sA, size_t _sB ) { return Binary( NN9_GO_ADD, _sA, _sB ); }
+
+		/**
+		 * Adds a - b, broadcasting the operands against each other.
+		 *
+		 * \param _sA The left operand.
+		 * \param _sB The right operand.
+		 * \throw Throws if an operand is invalid or the shapes do not broadcast.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Sub( size_t _sA, size_t _sB ) { return Binary( NN9_GO_SUB, _sA, _sB ); }
+
+		/**
+		 * Adds a * b, broadcasting the operands against each other.
+		 *
+		 * \param _sA The left operand.
+		 * \param _sB The right operand.
+		 * \throw Throws if an operand is invalid or the shapes do not broadcast.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Mul( size_t _sA, size_t _sB ) { return Binary( NN9_GO_MUL, _sA, _sB ); }
+
+		/**
+		 * Adds a / b, broadcasting the operands against each other.
+		 *
+		 * \param _sA The left operand.
+		 * \param _sB The right operand.
+		 * \throw Throws if an operand is invalid or the shapes do not broadcast.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Div( size_t _sA, size_t _sB ) { return Binary( NN9_GO_DIV, _sA, _sB ); }
+
+		/**
+		 * Adds max( a, b ), broadcasting the operands against each other.
+		 *
+		 * \param _sA The left operand.
+		 * \param _sB The right operand.
+		 * \throw Throws if an operand is invalid or the shapes do not broadcast.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Max( size_t _sA, size_t _sB ) { return Binary( NN9_GO_MAX, _sA, _sB ); }
+
+		/**
+		 * Adds min( a, b ), broadcasting the operands against each other.
+		 *
+		 * \param _sA The left operand.
+		 * \param _sB The right operand.
+		 * \throw Throws if an operand is invalid or the shapes do not broadcast.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Min( size_t _sA, size_t _sB ) { return Binary( NN9_GO_MIN, _sA, _sB ); }
+
+		/**
+		 * Adds the matrix product of 2 2-D values.  Only float and double graphs can multiply matrices.
+		 *
+		 * \param _sA The [M,K] left operand.
+		 * \param _sB The [K,N] right operand.
+		 * \throw Throws if an operand is invalid, the shapes do not multiply, or the graph's type is not float or double.
+		 * \return Returns the index of the new [M,N] value.
+		 **/
+		size_t									MatMul( size_t _sA, size_t _sB );
+
+		/**
+		 * Adds a softmax along 1 axis.
+		 *
+		 * \param _sA The operand.
+		 * \param _sAxis The axis along which the values sum to 1.
+		 * \throw Throws if the operand or axis is invalid.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Softmax( size_t _sA, size_t _sAxis ) { return Axis( NN9_GO_SOFTMAX, _sA, _sAxis ); }
+
+		/**
+		 * Adds a log-softmax along 1 axis.
+		 *
+		 * \param _sA The operand.
+		 * \param _sAxis The axis along which the exponentials of the values sum to 1.
+		 * \throw Throws if the operand or axis is invalid.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									LogSoftmax( size_t _sA, size_t _sAxis ) { return Axis( NN9_GO_LOG_SOFTMAX, _sA, _sAxis ); }
+
+		/**
+		 * Adds a sum over the given axes, which are removed from the shape.  Summing over every axis gives the shape { 1 }.
+		 *
+		 * \param _sA The operand.
+		 * \param _vAxes The axes to sum.
+		 * \throw Throws if the operand is invalid or an axis is out of range or repeated.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Sum( size_t _sA, const std::vector<size_t> &_vAxes );
+
+		/**
+		 * Marks a value as an output.  Outputs are returned, in the order in which they were marked, by Run().
+		 *
+		 * \param _sA The value.
+		 * \throw Throws if the value is invalid or is an input or constant.
+		 **/
+		void									Output( size_t _sA );
+
+		/**
+		 * Removes values that do not lead to an output and builds the kernels.  Run() calls this if the graph has changed since it was last
+		 *	compiled.
+		 *
+		 * \throw Throws if there are no outputs.
+		 **/
+		void									Compile();
+
+		/**
+		 * Runs the graph, writing the outputs into caller-owned tensors.  Inputs may have any strides; outputs must be contiguous.
+		 *
+		 * \param _vInputs The inputs, in the order in which they were added.
+		 * \param _vOutputs The outputs, in the order in which they were marked.
+		 * \throw Throws if the number, types, or shapes of the tensors are wrong, or if an output is not contiguous.
+		 **/
+		void									Run( const std::vector<Tensor *> &_vInputs, const std::vector<Tensor *> &_vOutputs );
+
+		/**
+		 * Runs the graph, creating the outputs.
+		 *
+		 * \param _vInputs The inputs, in the order in which they were added.
+		 * \throw Throws if the number, types, or shapes of the inputs are wrong.
+		 * \return Returns the outputs, in the order in which they were marked.
+		 **/
+		std::vector<Tensor>						Run( const std::vector<Tensor *> &_vInputs );
+
+		/**
+		 * Gets the shape of a value.
+		 *
+		 * \param _sA The value.
+		 * \throw Throws if the value is invalid.
+		 * \return Returns the shape of the value.
+		 **/
+		const std::vector<size_t> &				Shape( size_t _sA ) const;
+
+		/**
+		 * Gets the type of every value in the graph.
+		 *
+		 * \return Returns the graph's type.
+		 **/
+		inline NN9_TYPE							Type() const { return m_tType; }
+
+		/**
+		 * Gets the number of values recorded.
+		 *
+		 * \return Returns the number of values.
+		 **/
+		inline size_t							Size() const { return m_vNodes.size(); }
+
+		/**
+		 * Gets the number of kernels the graph runs.  This is 0 until the graph is compiled.
+		 *
+		 * \return Returns the number of kernels.
+		 **/
+		inline size_t							Kernels() const { return m_vSteps.size(); }
+
+		/**
+		 * Gets the size of the arena holding every value that is not an input, a constant, or an output.  This is 0 until the graph is compiled.
+		 *
+		 * \return Returns the planned peak memory of the graph's intermediate values, in bytes.
+		 **/
+		inline size_t							PlannedBytes() const { return m_sPlannedBytes; }
+
+		/**
+		 * Gets the memory the graph's intermediate values would take if each had a buffer of its own.  This is 0 until the graph is compiled.
+		 *
+		 * \return Returns the sum of the sizes of the graph's intermediate values, in bytes.
+		 **/
+		inline size_t							NaiveBytes() const { return m_sNaiveBytes; }
+
+
+	protected :
+		// == Enumerations.
+		/** The operations. */
+		enum NN9_GRAPH_OP : size_t {
+			NN9_GO_INPUT,																/**< Input(). */
+			NN9_GO_CONSTANT,															/**< Constant(). */
+			NN9_GO_NEG,																	/**< Neg(). */
+			NN9_GO_ABS,																	/**< Abs(). */
+			NN9_GO_SQUARE,																/**< Square(). */
+			NN9_GO_SQRT,																/**< Sqrt(). */
+			NN9_GO_EXP,																	/**< Exp(). */
+			NN9_GO_LOG,																	/**< Log(). */
+			NN9_GO_TANH,																/**< Tanh(). */
+			NN9_GO_SIGMOID,																/**< Sigmoid(). */
+			NN9_GO_RELU,																/**< Relu(). */
+			NN9_GO_ADD,																	/**< Add(). */
+			NN9_GO_SUB,																	/**< Sub(). */
+			NN9_GO_MUL,																	/**< Mul(). */
+			NN9_GO_DIV,																	/**< Div(). */
+			NN9_GO_MAX,																	/**< Max(). */
+			NN9_GO_MIN,																	/**< Min(). */
+			NN9_GO_MATMUL,																/**< MatMul(). */
+			NN9_GO_SOFTMAX,																/**< Softmax(). */
+			NN9_GO_LOG_SOFTMAX,															/**< LogSoftmax(). */
+			NN9_GO_SUM,																	/**< Sum(). */
+		};
+
+
+		// == Types.
+		/** A recorded value. */
+		struct NN9_NODE {
+			NN9_NODE( NN9_GRAPH_OP _goOp = NN9_GO_INPUT ) :
+				goOp( _goOp ),
+				saInputs { ~size_t( 0 ), ~size_t( 0 ) },
+				dValue( 0.0 ),
+				sIndex( 0 ) {
+			}
+
+
+			// == Members.
+			NN9_GRAPH_OP						goOp;									/**< The operation. */
+			size_t								saInputs[2];							/**< The operands, or ~0. */
+			std::vector<size_t>					vShape;									/**< The shape. */
+			std::vector<size_t>					vAxes;									/**< Sum(): the summed axes. */
+			double								dValue;									/**< Constant(): the value. */
+			size_t								sIndex;									/**< Input(): the position in Run()'s inputs.  Softmax(), LogSoftmax(): the axis. */
+		};
+
+		/** 1 instruction of a fused kernel, over slots of NN9_G_TILE values. */
+		struct NN9_INSTR {
+			NN9_GRAPH_OP						goOp;									/**< The operation. */
+			uint32_t							ui32Dst;								/**< The slot written. */
+			uint32_t							ui32A;									/**< The slot of the left (or only) operand. */
+			uint32_t							ui32B;									/**< The slot of the right operand. */
+		};
+
+		/** A kernel.  Fused kernels have code; others run their node's operation. */
+		struct NN9_STEP {
+			size_t								sNode;									/**< The value the kernel produces. */
+			std::vector<size_t>					vLeaves;								/**< Fused: the values loaded into slots 0 to vLeaves.size() - 1. */
+			std::vector<NN9_INSTR>				vCode;									/**< Fused: the instructions.  The last writes the final slot. */
+			size_t								sSlots;									/**< Fused: the number of slots. */
+		};
+
+		/** Scalar registers for Exec() when the kernel table has no fused-instruction kernel. */
+		template <typename _tScalar>
+		struct NN9_ISA_SCALAR {
+			typedef _tScalar								Scalar;
+			typedef _tScalar								Reg;
+			static constexpr size_t							Lanes = 1;
+
+			static inline Reg								Load( const Scalar * _psSrc ) { return (*_psSrc); }
+			static inline void								Store( Scalar * _psDst, Reg _rVal ) { (*_psDst) = _rVal; }
+			static inline Reg								Set1( Scalar _sVal ) { return _sVal; }
+			static inline Reg								Add( Reg _rA, Reg _rB ) { return _rA + _rB; }
+			static inline Reg								Sub( Reg _rA, Reg _rB ) { return _rA - _rB; }
+			static inline Reg								Mul( Reg _rA, Reg _rB ) { return _rA * _rB; }
+			static inline Reg								Div( Reg _rA, Reg _rB ) { return _rA / _rB; }
+			static inline Reg								Max( Reg _rA, Reg _rB ) { return _rA > _rB ? _rA : _rB; }
+			static inline Reg								Min( Reg _rA, Reg _rB ) { return _rA < _rB ? _rA : _rB; }
+			static inline Reg								Abs( Reg _rA ) { return std::abs( _rA ); }
+			static inline Reg								Neg( Reg _rA ) { return -_rA; }
+			static inline Reg								Sqrt( Reg _rA ) { return std::sqrt( _rA ); }
+			static inline Reg								Exp( Reg _rA ) { return std::exp( _rA ); }
+			static inline Reg								Log( Reg _rA ) { return std::log( _rA ); }
+			static inline Reg								Tanh( Reg _rA ) { return std::tanh( _rA ); }
+		};
+
+
+		// == Members.
+		NN9_TYPE								m_tType;								/**< The type of every value. */
+		std::vector<NN9_NODE>					m_vNodes;								/**< The recorded values. */
+		std::vector<size_t>						m_vInputs;								/**< The inputs, in the order Run() binds them. */
+		std::vector<size_t>						m_vOutputs;								/**< The outputs, in the order Run() returns them. */
+		std::vector<NN9_STEP>					m_vSteps;								/**< The kernels, in the order they run.  Empty until compiled. */
+		std::vector<std::unique_ptr<Tensor>>	m_vPlanned;								/**< Per value, its tensor in the arena if it is an intermediate value. */
+		size_t									m_sPlannedBytes;						/**< The size of the arena. */
+		size_t									m_sNaiveBytes;							/**< The sum of the sizes of the intermediate values. */
+		bool									m_bCompiled;							/**< True if m_vSteps matches m_vNodes and m_vOutputs. */
+
+
+		// == Functions.
+		/**
+		 * Gets a recorded value, checking the index.
+		 *
+		 * \param _sA The value.
+		 * \throw Throws if the value is invalid.
+		 * \return Returns the node.
+		 **/
+		const NN9_NODE &						Node( size_t _sA ) const;
+
+		/**
+		 * Adds a node and marks the graph as needing compilation.
+		 *
+		 * \param _nNode The node to add.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Record( NN9_NODE &&_nNode );
+
+		/**
+		 * Adds an element-wise operation on 1 value.
+		 *
+		 * \param _goOp The operation.
+		 * \param _sA The operand.
+		 * \throw Throws if the operand is invalid.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Unary( NN9_GRAPH_OP _goOp, size_t _sA );
+
+		/**
+		 * Adds an element-wise operation on 2 values, broadcasting them against each other.
+		 *
+		 * \param _goOp The operation.
+		 * \param _sA The left operand.
+		 * \param _sB The right operand.
+		 * \throw Throws if an operand is invalid or the shapes do not broadcast.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Binary( NN9_GRAPH_OP _goOp, size_t _sA, size_t _sB );
+
+		/**
+		 * Adds an operation along 1 axis that keeps the shape.
+		 *
+		 * \param _goOp The operation.
+		 * \param _sA The operand.
+		 * \param _sAxis The axis.
+		 * \throw Throws if the operand or axis is invalid.
+		 * \return Returns the index of the new value.
+		 **/
+		size_t									Axis( NN9_GRAPH_OP _goOp, size_t _sA, size_t _sAxis );
+
+		/**
+		 * Builds a fused kernel for a value and every operation fused into it.
+		 *
+		 * \param _sRoot The value the kernel produces.
+		 * \param _vFused Per value, true if it is computed inside the kernel of its consumer.
+		 * \return Returns the kernel.
+		 **/
+		NN9_STEP								BuildFused( size_t _sRoot, const std::vector<bool> &_vFused ) const;
+
+		/**
+		 * Finds the lifetimes of the values the kernels produce that are not outputs and creates their tensors in 1 shared arena.
+		 *
+		 * \param _vOutput Per value, true if it is an output.
+		 **/
+		void									PlanMemory( const std::vector<bool> &_vOutput );
+
+		/**
+		 * Runs a kernel that is not fused.
+		 *
+		 * \param _sStep The kernel.
+		 * \param _vValues The tensor of each value, with those of the kernel's operands and result set.
+		 **/
+		void									RunOp( const NN9_STEP &_sStep, const std::vector<Tensor *> &_vValues ) const;
+
+		/**
+		 * Runs a fused kernel.
+		 *
+		 * \tparam _tType The graph's C++ type.
+		 * \param _sStep The kernel.
+		 * \param _vValues The tensor of each value, with those of the kernel's leaves and result set.
+		 **/
+		template <typename _tType>
+		void									RunFused( const NN9_STEP &_sStep, const std::vector<Tensor *> &_vValues ) const;
+
+		/**
+		 * Runs 1 instruction over the first _sTotal elements of its slots, through the kernel table's fused-instruction kernel when it has
+		 *	one.
+		 *
+		 * \tparam _tScalar The compute type.
+		 * \param _iInstr The instruction.
+		 * \param _sTotal The number of elements.
+		 * \param _ppsSlots The slots.
+		 **/
+		template <typename _tScalar>
+		static void								Exec( const NN9_INSTR &_iInstr, size_t _sTotal, _tScalar * const * _ppsSlots );
+
+		/**
+		 * Determines whether an operation is element-wise and can be fused.
+		 *
+		 * \param _goOp The operation.
+		 * \return Returns true for the unary and binary element-wise operations.
+		 **/
+		static inline bool						Fusible( NN9_GRAPH_OP _goOp ) { return _goOp >= NN9_GO_NEG && _goOp <= NN9_GO_MIN; }
+
+		/**
+		 * Creates a contiguous tensor.
+		 *
+		 * \param _vShape The shape.
+		 * \param _tType The type.
+		 * \return Returns the new tensor.
+		 **/
+		static std::unique_ptr<Tensor>			NewTensor( const std::vector<size_t> &_vShape, NN9_TYPE _tType );
+	};
+
+}	// namespace nn9
@@ -0,0 +1,70 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Packs blocks of memory with known lifetimes into 1 arena, letting blocks whose lifetimes do not overlap share memory.
+ */
+
+#include "NN9MemoryPlanner.h"
+
+#include <algorithm>
+
+
+namespace nn9 {
+
+	// == Functions.
+	/**
+	 * Assigns each block an offset within an arena.
+	 *
+	 * \param _vBlocks The blocks.  Their sOffset members are set.
+	 * \return Returns the size of the arena, in bytes.
+	 **/
+	size_t MemoryPlanner::Plan( std::vector<NN9_BLOCK> &_vBlocks ) {
+		std::vector<size_t> vOrder( _vBlocks.size() );
+		for ( size_t I = 0; I < vOrder.size(); ++I ) { vOrder[I] = I; }
+		std::stable_sort( vOrder.begin(), vOrder.end(), [&]( size_t _sL, size_t _sR ) { return _vBlocks[_sL].sSize > _vBlocks[_sR].sSize; } );
+
+		size_t sArena = 0;
+		std::vector<size_t> vPlaced, vLive;
+		for ( auto sThis : vOrder ) {
+			NN9_BLOCK & bThis = _vBlocks[sThis];
+			const size_t sSize = Align( bThis.sSize );
+
+			// The placed blocks alive at the same time, by offset.  The gaps between them are the candidates.
+			vLive.clear();
+			for ( auto sOther : vPlaced ) {
+				const NN9_BLOCK & bOther = _vBlocks[sOther];
+				if ( bOther.sFirst <= bThis.sLast && bThis.sFirst <= bOther.sLast ) { vLive.push_back( sOther ); }
+			}
+			std::sort( vLive.begin(), vLive.end(), [&]( size_t _sL, size_t _sR ) { return _vBlocks[_sL].sOffset < _vBlocks[_sR].sOffset; } );
+
+			size_t sCursor = 0, sBest = ~size_t( 0 ), sBestGap = ~size_t( 0 );
+			for ( auto sOther : vLive ) {
+				const NN9_BLOCK & bOther = _vBlocks[sOther];
+				if ( bOther.sOffset >= sCursor + sSize && bOther.sOffset - sCursor < sBestGap ) {
+					sBest = sCursor;
+					sBestGap = bOther.sOffset - sCursor;
+				}
+				sCursor = std::max( sCursor, bOther.sOffset + Align( bOther.sSize ) );
+			}
+			bThis.sOffset = sBest != ~size_t( 0 ) ? sBest : sCursor;
+			sArena = std::max( sArena, bThis.sOffset + sSize );
+			vPlaced.push_back( sThis );
+		}
+		return sArena;
+	}
+
+	/**
+	 * Gets the size that giving every block memory of its own would take.
+	 *
+	 * \param _vBlocks The blocks.
+	 * \return Returns the sum of the sizes of the blocks, each rounded up to NN9_MP_ALIGN.
+	 **/
+	size_t MemoryPlanner::NaiveSize( const std::vector<NN9_BLOCK> &_vBlocks ) {
+		size_t sRet = 0;
+		for ( const auto & bThis : _vBlocks ) { sRet += Align( bThis.sSize ); }
+		return sRet;
+	}
+
+}	// namespace nn9
@@ -0,0 +1,79 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Packs blocks of memory with known lifetimes into 1 arena, letting blocks whose lifetimes do not overlap share memory.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+
+namespace nn9 {
+
+	/**
+	 * Class MemoryPlanner
+	 * \brief Packs blocks of memory with known lifetimes into 1 arena.
+	 *
+	 * Description: Packs blocks of memory with known lifetimes into 1 arena, letting blocks whose lifetimes do not overlap share memory.
+	 *	Blocks are placed from largest to smallest, each into the smallest gap left between the blocks already placed that are alive at the
+	 *	same time (greedy by size, best fit), or after all of them if no gap is large enough.  Every offset is a multiple of NN9_MP_ALIGN.
+	 */
+	class MemoryPlanner {
+	public :
+		// == Enumerations.
+		/** Planner constants. */
+		enum NN9_MEMORY_PLANNER : size_t {
+			NN9_MP_ALIGN						= 64,									/**< The alignment of every block, in bytes. */
+		};
+
+
+		// == Types.
+		/** A block of memory that is needed from step sFirst through step sLast, inclusive. */
+		struct NN9_BLOCK {
+			NN9_BLOCK( size_t _sSize = 0, size_t _sFirst = 0, size_t _sLast = 0 ) :
+				sSize( _sSize ),
+				sFirst( _sFirst ),
+				sLast( _sLast ),
+				sOffset( 0 ) {
+			}
+
+
+			// == Members.
+			size_t								sSize;									/**< The size, in bytes. */
+			size_t								sFirst;									/**< The first step that uses the block. */
+			size_t								sLast;									/**< The last step that uses the block. */
+			size_t								sOffset;								/**< Set by Plan(): the byte offset within the arena. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Assigns each block an offset within an arena.
+		 *
+		 * \param _vBlocks The blocks.  Their sOffset members are set.
+		 * \return Returns the size of the arena, in bytes.
+		 **/
+		static size_t							Plan( std::vector<NN9_BLOCK> &_vBlocks );
+
+		/**
+		 * Gets the size that giving every block memory of its own would take.
+		 *
+		 * \param _vBlocks The blocks.
+		 * \return Returns the sum of the sizes of the blocks, each rounded up to NN9_MP_ALIGN.
+		 **/
+		static size_t							NaiveSize( const std::vector<NN9_BLOCK> &_vBlocks );
+
+		/**
+		 * Rounds a size up to a multiple of NN9_MP_ALIGN.
+		 *
+		 * \param _sSize The size to round.
+		 * \return Returns the rounded size.
+		 **/
+		static inline size_t					Align( size_t _sSize ) { return (_sSize + (NN9_MP_ALIGN - 1)) & ~size_t( NN9_MP_ALIGN - 1 ); }
+	};
+
+}	// namespace nn9
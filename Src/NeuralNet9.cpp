@@ -1,11 +1,13 @@
 // NeuralNet9.cpp : This file contains the 'main' function. Program execution begins and ends there.
 //
 
+#include "Benchmarks/NN9Benchmark.h"
 #include "Foundation/NN9Intrin.h"
 #include "Ops/NN9Init.h"
 #include "Ops/NN9Math.h"
 #include "Utilities/NN9Timer.h"
 #include "Utilities/NN9Utilities.h"
+#include <cwchar>
 #include <iostream>
 
 #include "Tensor/NN9Tensor.h"
@@ -16,6 +18,10 @@ int wmain( int _iArgC, wchar_t const * _wcpArgV[] ) {
 
 	auto aCode = nn9::Utilities::DownloadMnist( u"C:\\MNIST\\DownLoadTest" );
 
+	for ( int I = 1; I <= _iArgC; ++I ) {
+		if ( std::wcscmp( _wcpArgV[I], L"--bench" ) == 0 ) { nn9::Benchmark::RunAll(); }
+	}
+
 	//{
 		nn9::Tensor tTensorTest( { 60, 28, 28 }, nn9::NN9_T_FLOAT, 33.2f );
 
@@ -100,6 +106,7 @@ int wmain( int _iArgC, wchar_t const * _wcpArgV[] ) {
 			};
 			//__m512i mVal = _mm512_loadu_si512( reinterpret_cast<const __m512i *>(iVales) );
 			//__m256i mVal = _mm256_loadu_si256( reinterpret_cast<const __m256i *>(iVales) );
+#ifdef __AVX512F__
 			__m512 mVal = _mm512_loadu_ps( iVales );
 			//__m512d mVal = _mm512_loadu_pd( iVales );
 			//__m256 mVal = _mm256_loadu_ps( iVales );
@@ -107,6 +114,7 @@ int wmain( int _iArgC, wchar_t const * _wcpArgV[] ) {
 			//float ui16Dst[64];
 			//nn9::Intrin::double_scast( mVal, ui16Dst );
 			auto aMul = nn9::Intrin::RoundToEven( mVal );
+#endif	// #ifdef __AVX512F__
 
 			float fVal = nn9::RoundToEven( -3.5 );
 
@@ -0,0 +1,310 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: bfloat16 dot products built on the AVX512-BF16 vdpbf16ps instruction, with a bit-exact software emulation of the
+ *	instruction for CPUs that do not have it and a plain widen-to-float path.
+ */
+
+#pragma once
+
+#include "../Foundation/NN9Intrin.h"
+#include "../Foundation/NN9Kernels.h"
+#include "../Types/NN9BFloat16.h"
+#include "../Utilities/NN9ThreadPool.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+
+namespace nn9 {
+
+	/**
+	 * Class Bf16Dot
+	 * \brief bfloat16 dot products.
+	 *
+	 * Description: bfloat16 dot products built on the AVX512-BF16 vdpbf16ps instruction, with a bit-exact software emulation of the
+	 *	instruction for CPUs that do not have it and a plain widen-to-float path.  vdpbf16ps treats 32 bfloat16 values as 16 pairs; each
+	 *	float lane accumulates the product of its odd pair members and then the product of its even pair members, each step being a single
+	 *	rounding (the products of 2 bfloat16 values are exact in float) with denormal inputs read as 0 and denormal results flushed to 0.
+	 *	The SIMD pair kernels are in the Kernels table; the scalar kernel below runs where the table has none and shares their interface
+	 *	so that the dot products here and the bfloat16 GEMM can be written once.
+	 */
+	class Bf16Dot {
+	public :
+		// == Enumerations.
+		/** Kernel selection. */
+		enum NN9_BF16_KERNEL : size_t {
+			NN9_BK_AUTO,																		/**< vdpbf16ps when the CPU has AVX512-BF16, otherwise NN9_BK_WIDEN. */
+			NN9_BK_NATIVE,																		/**< vdpbf16ps, emulated when the CPU does not have AVX512-BF16. */
+			NN9_BK_EMULATED,																	/**< The software emulation of vdpbf16ps, which gives the same bits as the instruction. */
+			NN9_BK_WIDEN,																		/**< Widens to float and uses ordinary FMA, keeping denormals. */
+		};
+
+		/** Tuning constants. */
+		enum NN9_BF16_DOT : size_t {
+			NN9_BD_GRAIN						= 1 << 15,										/**< Elements per parallel subrange.  Fixed so that results do not depend on the thread count. */
+		};
+
+
+		// == Types.
+		/**
+		 * Scalar pair kernel.  Reg is one float accumulator and Pairs is one pair of bfloat16 values.
+		 *
+		 * \tparam _bDazFtz If true, the vdpbf16ps flushing rules are applied.
+		 */
+		template <bool _bDazFtz>
+		struct NN9_SCALAR_PAIRS {
+			typedef float										Reg;
+			typedef uint32_t									Pairs;
+			static constexpr size_t								Lanes = 1;
+
+			static inline Reg									Zero() { return 0.0f; }
+			static inline Reg									Add( Reg _rA, Reg _rB ) { return _rA + _rB; }
+			static inline Pairs									Load( const bfloat16_t * _pbSrc ) { Pairs pRet; std::memcpy( &pRet, _pbSrc, sizeof( pRet ) ); return pRet; }
+			static inline Pairs									Set1( const bfloat16_t * _pbSrc ) { return Load( _pbSrc ); }
+			static inline float									HorizontalSum( Reg _rVal ) { return _rVal; }
+
+			/**
+			 * Accumulates the dot product of 1 pair of bfloat16 values.
+			 *
+			 * \param _rAcc The accumulator.
+			 * \param _pA The left pair.
+			 * \param _pB The right pair.
+			 * \return Returns the updated accumulator.
+			 **/
+			static inline Reg									Dp( Reg _rAcc, Pairs _pA, Pairs _pB ) {
+				_rAcc = Flush( _rAcc );
+				_rAcc = Flush( std::fma( Flush( Hi( _pA ) ), Flush( Hi( _pB ) ), _rAcc ) );
+				return Flush( std::fma( Flush( Lo( _pA ) ), Flush( Lo( _pB ) ), _rAcc ) );
+			}
+
+			/**
+			 * Gets the odd (high) member of a pair as a float.
+			 *
+			 * \param _pVal The pair.
+			 * \return Returns the high bfloat16 value as a float.
+			 **/
+			static inline float									Hi( Pairs _pVal ) { return Bits( _pVal & 0xFFFF0000U ); }
+
+			/**
+			 * Gets the even (low) member of a pair as a float.
+			 *
+			 * \param _pVal The pair.
+			 * \return Returns the low bfloat16 value as a float.
+			 **/
+			static inline float									Lo( Pairs _pVal ) { return Bits( _pVal << 16 ); }
+
+			/**
+			 * Reinterprets bits as a float.
+			 *
+			 * \param _ui32Bits The bits.
+			 * \return Returns the float with the given bits.
+			 **/
+			static inline float									Bits( uint32_t _ui32Bits ) { float fRet; std::memcpy( &fRet, &_ui32Bits, sizeof( fRet ) ); return fRet; }
+
+			/**
+			 * Replaces a denormal with a 0 of the same sign when _bDazFtz is true.
+			 *
+			 * \param _fVal The value to flush.
+			 * \return Returns the flushed value.
+			 **/
+			static inline float									Flush( float _fVal ) {
+				if constexpr ( _bDazFtz ) {
+					uint32_t ui32Bits;
+					std::memcpy( &ui32Bits, &_fVal, sizeof( ui32Bits ) );
+					if ( !(ui32Bits & 0x7F800000U) ) { return Bits( ui32Bits & 0x80000000U ); }
+				}
+				return _fVal;
+			}
+		};
+
+
+		// == Functions.
+		/**
+		 * Resolves NN9_BK_AUTO and NN9_BK_NATIVE to the kernel that will actually run on this CPU.
+		 *
+		 * \param _bkKernel The requested kernel.
+		 * \return Returns NN9_BK_NATIVE, NN9_BK_EMULATED, or NN9_BK_WIDEN.
+		 **/
+		static inline NN9_BF16_KERNEL							Resolve( NN9_BF16_KERNEL _bkKernel ) {
+			// The AVX512-BF16 kernel is built in its own file, so this does not depend on how this header was compiled.
+			const bool bNative = Kernels::Table().pfDotBf16[Kernels::NN9_KP_NATIVE] != nullptr;
+			switch ( _bkKernel ) {
+				case NN9_BK_AUTO : { return bNative ? NN9_BK_NATIVE : NN9_BK_WIDEN; }
+				case NN9_BK_NATIVE : { return bNative ? NN9_BK_NATIVE : NN9_BK_EMULATED; }
+				case NN9_BK_EMULATED : { return NN9_BK_EMULATED; }
+				default : { return NN9_BK_WIDEN; }
+			}
+		}
+
+		/**
+		 * Gets the Kernels table index of a resolved kernel.
+		 *
+		 * \param _bkKernel NN9_BK_NATIVE, NN9_BK_EMULATED, or NN9_BK_WIDEN.
+		 * \return Returns the matching NN9_KERNEL_BF16 index.
+		 **/
+		static inline Kernels::NN9_KERNEL_BF16					TableIndex( NN9_BF16_KERNEL _bkKernel ) {
+			return static_cast<Kernels::NN9_KERNEL_BF16>(_bkKernel - NN9_BK_NATIVE);
+		}
+
+		/**
+		 * Emulates 1 float lane of vdpbf16ps: _fAcc + _bA1 * _bB1 + _bA0 * _bB0, rounding after each product is added, reading denormal
+		 *	inputs as 0 and flushing denormal results to 0.
+		 *
+		 * \param _fAcc The accumulator.
+		 * \param _bA0 The even member of the left pair.
+		 * \param _bA1 The odd member of the left pair.
+		 * \param _bB0 The even member of the right pair.
+		 * \param _bB1 The odd member of the right pair.
+		 * \return Returns the updated accumulator.
+		 **/
+		static inline float										DpBf16( float _fAcc, bfloat16_t _bA0, bfloat16_t _bA1, bfloat16_t _bB0, bfloat16_t _bB1 ) {
+			return NN9_SCALAR_PAIRS<true>::Dp( _fAcc,
+				(uint32_t( _bA1.ToBits() ) << 16) | _bA0.ToBits(),
+				(uint32_t( _bB1.ToBits() ) << 16) | _bB0.ToBits() );
+		}
+
+		/**
+		 * Computes the dot product of 2 bfloat16 arrays, accumulating in float.
+		 *
+		 * \param _pbA The left array.
+		 * \param _pbB The right array.
+		 * \param _sTotal The number of elements in each array.
+		 * \param _bkKernel The kernel to use.
+		 * \return Returns the sum of _pbA[I] * _pbB[I].
+		 **/
+		static inline float										Dot( const bfloat16_t * _pbA, const bfloat16_t * _pbB, size_t _sTotal, NN9_BF16_KERNEL _bkKernel = NN9_BK_AUTO ) {
+			return Reduce<false>( _pbA, _pbB, _sTotal, _bkKernel );
+		}
+
+		/**
+		 * Sums a bfloat16 array, accumulating in float.  The values are multiplied by 1 in pairs, so the sum runs at the rate of Dot().
+		 *
+		 * \param _pbA The array.
+		 * \param _sTotal The number of elements in the array.
+		 * \param _bkKernel The kernel to use.
+		 * \return Returns the sum of _pbA[I].
+		 **/
+		static inline float										Sum( const bfloat16_t * _pbA, size_t _sTotal, NN9_BF16_KERNEL _bkKernel = NN9_BK_AUTO ) {
+			return Reduce<true>( _pbA, nullptr, _sTotal, _bkKernel );
+		}
+
+		/**
+		 * Sums the squares of a bfloat16 array, accumulating in float.
+		 *
+		 * \param _pbA The array.
+		 * \param _sTotal The number of elements in the array.
+		 * \param _bkKernel The kernel to use.
+		 * \return Returns the sum of _pbA[I] * _pbA[I].
+		 **/
+		static inline float										SumSquares( const bfloat16_t * _pbA, size_t _sTotal, NN9_BF16_KERNEL _bkKernel = NN9_BK_AUTO ) {
+			return Reduce<false>( _pbA, _pbA, _sTotal, _bkKernel );
+		}
+
+
+	protected :
+		// == Functions.
+		/**
+		 * Selects the pair kernel for the running CPU from the Kernels table, or the scalar kernel below the AVX2 tier, and reduces in
+		 *	parallel.
+		 *
+		 * \tparam _bSum If true, _pbB is ignored and every right-hand value is 1.
+		 * \param _pbA The left array.
+		 * \param _pbB The right array.
+		 * \param _sTotal The number of elements in each array.
+		 * \param _bkKernel The kernel to use.
+		 * \return Returns the reduction.
+		 **/
+		template <bool _bSum>
+		static float											Reduce( const bfloat16_t * _pbA, const bfloat16_t * _pbB, size_t _sTotal, NN9_BF16_KERNEL _bkKernel ) {
+			const NN9_BF16_KERNEL bkKernel = Resolve( _bkKernel );
+			// Resolve() returns NN9_BK_NATIVE only when the table has its kernel.
+			const auto pfKernel = Kernels::Table().pfDotBf16[TableIndex( bkKernel )];
+			if ( pfKernel ) { return Parallel( pfKernel, _pbA, _bSum ? nullptr : _pbB, _sTotal ); }
+			return bkKernel == NN9_BK_WIDEN ? Parallel<NN9_SCALAR_PAIRS<false>, _bSum>( _pbA, _pbB, _sTotal ) :
+				Parallel<NN9_SCALAR_PAIRS<true>, _bSum>( _pbA, _pbB, _sTotal );
+		}
+
+		/**
+		 * Splits a reduction into NN9_BD_GRAIN subranges over the ThreadPool.
+		 *
+		 * \tparam _tPairs The pair kernel.
+		 * \tparam _bSum If true, _pbB is ignored and every right-hand value is 1.
+		 * \param _pbA The left array.
+		 * \param _pbB The right array.
+		 * \param _sTotal The number of elements in each array.
+		 * \return Returns the reduction.
+		 **/
+		template <typename _tPairs, bool _bSum>
+		static float											Parallel( const bfloat16_t * _pbA, const bfloat16_t * _pbB, size_t _sTotal ) {
+			if ( _sTotal <= NN9_BD_GRAIN ) { return Kernel<_tPairs, _bSum>( _pbA, _pbB, _sTotal ); }
+			return ThreadPool::Global().ParallelReduce( 0, _sTotal, NN9_BD_GRAIN, 0.0f,
+				[&]( size_t _sBegin, size_t _sEnd ) { return Kernel<_tPairs, _bSum>( _pbA + _sBegin, _bSum ? nullptr : _pbB + _sBegin, _sEnd - _sBegin ); },
+				[]( float _fLeft, float _fRight ) { return _fLeft + _fRight; } );
+		}
+
+		/**
+		 * Splits a reduction into NN9_BD_GRAIN subranges over the ThreadPool, reducing each with a kernel from the Kernels table.
+		 *
+		 * \param _pfKernel The kernel.
+		 * \param _pbA The left array.
+		 * \param _pbB The right array, or nullptr to sum _pbA.
+		 * \param _sTotal The number of elements in each array.
+		 * \return Returns the reduction.
+		 **/
+		static float											Parallel( float (* _pfKernel)( const uint16_t *, const uint16_t *, size_t ), const bfloat16_t * _pbA, const bfloat16_t * _pbB, size_t _sTotal ) {
+			const uint16_t * pui16A = reinterpret_cast<const uint16_t *>(_pbA);
+			const uint16_t * pui16B = reinterpret_cast<const uint16_t *>(_pbB);
+			if ( _sTotal <= NN9_BD_GRAIN ) { return _pfKernel( pui16A, pui16B, _sTotal ); }
+			return ThreadPool::Global().ParallelReduce( 0, _sTotal, NN9_BD_GRAIN, 0.0f,
+				[&]( size_t _sBegin, size_t _sEnd ) { return _pfKernel( pui16A + _sBegin, pui16B ? pui16B + _sBegin : nullptr, _sEnd - _sBegin ); },
+				[]( float _fLeft, float _fRight ) { return _fLeft + _fRight; } );
+		}
+
+		/**
+		 * Reduces a contiguous range with a pair kernel.  4 accumulators hide the latency of the dot product; an odd tail is padded with 0.
+		 *
+		 * \tparam _tPairs The pair kernel.
+		 * \tparam _bSum If true, _pbB is ignored and every right-hand value is 1.
+		 * \param _pbA The left array.
+		 * \param _pbB The right array.
+		 * \param _sTotal The number of elements in each array.
+		 * \return Returns the reduction.
+		 **/
+		template <typename _tPairs, bool _bSum>
+		static float											Kernel( const bfloat16_t * _pbA, const bfloat16_t * _pbB, size_t _sTotal ) {
+			using Reg = typename _tPairs::Reg;
+			using Pairs = typename _tPairs::Pairs;
+			constexpr size_t sStep = _tPairs::Lanes * 2;
+			const uint16_t ui16One[2] = { 0x3F80, 0x3F80 };
+			const Pairs pOne = _tPairs::Set1( reinterpret_cast<const bfloat16_t *>(ui16One) );
+
+			Reg rAcc0 = _tPairs::Zero(), rAcc1 = _tPairs::Zero(), rAcc2 = _tPairs::Zero(), rAcc3 = _tPairs::Zero();
+			size_t I = 0;
+			for ( ; I + sStep * 4 <= _sTotal; I += sStep * 4 ) {
+				rAcc0 = _tPairs::Dp( rAcc0, _tPairs::Load( _pbA + I ), _bSum ? pOne : _tPairs::Load( _pbB + I ) );
+				rAcc1 = _tPairs::Dp( rAcc1, _tPairs::Load( _pbA + I + sStep ), _bSum ? pOne : _tPairs::Load( _pbB + I + sStep ) );
+				rAcc2 = _tPairs::Dp( rAcc2, _tPairs::Load( _pbA + I + sStep * 2 ), _bSum ? pOne : _tPairs::Load( _pbB + I + sStep * 2 ) );
+				rAcc3 = _tPairs::Dp( rAcc3, _tPairs::Load( _pbA + I + sStep * 3 ), _bSum ? pOne : _tPairs::Load( _pbB + I + sStep * 3 ) );
+			}
+			for ( ; I + sStep <= _sTotal; I += sStep ) {
+				rAcc0 = _tPairs::Dp( rAcc0, _tPairs::Load( _pbA + I ), _bSum ? pOne : _tPairs::Load( _pbB + I ) );
+			}
+			if ( I < _sTotal ) {
+				NN9_ALIGN( 64 )
+				uint16_t ui16A[sStep] = {};
+				NN9_ALIGN( 64 )
+				uint16_t ui16B[sStep] = {};
+				std::memcpy( ui16A, _pbA + I, (_sTotal - I) * sizeof( bfloat16_t ) );
+				if constexpr ( !_bSum ) { std::memcpy( ui16B, _pbB + I, (_sTotal - I) * sizeof( bfloat16_t ) ); }
+				rAcc0 = _tPairs::Dp( rAcc0, _tPairs::Load( reinterpret_cast<const bfloat16_t *>(ui16A) ),
+					_bSum ? pOne : _tPairs::Load( reinterpret_cast<const bfloat16_t *>(ui16B) ) );
+			}
+			return _tPairs::HorizontalSum( _tPairs::Add( _tPairs::Add( rAcc0, rAcc1 ), _tPairs::Add( rAcc2, rAcc3 ) ) );
+		}
+	};
+
+}	// namespace nn9
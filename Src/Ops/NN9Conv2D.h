@@ -0,0 +1,1051 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: 2D convolution with stride, padding, dilation, and groups.  The forward pass either unfolds patches into a matrix and
+ *	multiplies it with Gemm or convolves directly over channel-blocked (NCHW16c/NCHW8c) copies of the input and weights.  The backward
+ *	passes use the unfolded form.
+ */
+
+#pragma once
+
+#include "../Foundation/NN9AlignmentAllocator.h"
+#include "../Foundation/NN9Intrin.h"
+#include "../Foundation/NN9Kernels.h"
+#include "NN9Gemm.h"
+#include "../Tensor/NN9StridedView.h"
+#include "../Tensor/NN9Tensor.h"
+#include "../Types/NN9BFloat16.h"
+#include "../Types/NN9Float16.h"
+#include "../Types/NN9Types.h"
+#include "../Utilities/NN9ThreadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace nn9 {
+
+	/**
+	 * Class Conv2D
+	 * \brief 2D convolution.
+	 *
+	 * Description: 2D convolution (cross-correlation, as in every deep-learning framework) of an [N, C, H, W] input with [O, C/Groups, Kh, Kw]
+	 *	weights into an [N, O, Oh, Ow] output.  2 forward algorithms are offered:
+	 *	NN9_CA_IM2COL unfolds the patches of each image and group into a [C/Groups * Kh * Kw, Oh * Ow] matrix and multiplies the weights by it
+	 *	with Gemm.  1x1 convolutions with a stride of 1 and no padding skip the unfolding and multiply the input directly.
+	 *	NN9_CA_DIRECT copies the input into a zero-padded NCHWc layout, with channels in blocks of 1 register (16 floats on AVX-512, 8 on AVX2),
+	 *	and the weights into matching blocks, then accumulates a row of output pixels for a block of output channels entirely in registers.  It
+	 *	avoids the unfolded matrix, which is Kh * Kw times the size of the input, and is the faster algorithm for every kernel larger than 1x1.
+	 *	The gradients with respect to the input and the weights are computed with the unfolded form and Gemm.  float16 and bfloat16_t are
+	 *	widened to float; double is computed in double.
+	 */
+	class Conv2D {
+	public :
+		// == Enumerations.
+		/** Forward algorithms. */
+		enum NN9_CONV_ALGO : size_t {
+			NN9_CA_AUTO,																				/**< Chosen by Select() from the shapes. */
+			NN9_CA_IM2COL,																				/**< Unfold patches into a matrix and multiply it with Gemm. */
+			NN9_CA_DIRECT,																				/**< Convolve channel-blocked copies directly. */
+		};
+
+		/** Tuning constants. */
+		enum NN9_CONV2D : size_t {
+			NN9_C_COL_ELEMENTS					= 1 << 21,								/**< The largest unfolded matrix built for a batch of images when finding the weight gradient. */
+			NN9_C_PARALLEL_FLOPS				= 1 << 18,								/**< The fewest multiply-adds given to each thread by the direct algorithm. */
+		};
+
+
+		// == Types.
+		/** The parameters of a convolution. */
+		struct NN9_CONV2D_PARAMS {
+			NN9_CONV2D_PARAMS() :
+				sStrideH( 1 ),
+				sStrideW( 1 ),
+				sPadH( 0 ),
+				sPadW( 0 ),
+				sDilationH( 1 ),
+				sDilationW( 1 ),
+				sGroups( 1 ) {
+			}
+
+
+			// == Members.
+			size_t												sStrideH;										/**< The vertical distance between patches. */
+			size_t												sStrideW;										/**< The horizontal distance between patches. */
+			size_t												sPadH;											/**< Zero rows added above and below the input. */
+			size_t												sPadW;											/**< Zero columns added left and right of the input. */
+			size_t												sDilationH;										/**< The vertical distance between kernel taps. */
+			size_t												sDilationW;										/**< The horizontal distance between kernel taps. */
+			size_t												sGroups;										/**< Channel groups.  Each group of outputs sees only its group of inputs. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Gets the size of an output dimension.
+		 *
+		 * \param _sIn The size of the input dimension.
+		 * \param _sKernel The size of the kernel along the dimension.
+		 * \param _sStride The stride along the dimension.
+		 * \param _sPad The padding added to each side of the dimension.
+		 * \param _sDilation The dilation along the dimension.
+		 * \throw Throws if the stride or dilation is 0 or if the dilated kernel does not fit in the padded input.
+		 * \return Returns the size of the output dimension.
+		 **/
+		static size_t												OutputSize( size_t _sIn, size_t _sKernel, size_t _sStride, size_t _sPad, size_t _sDilation ) {
+			if ( !_sStride || !_sDilation || !_sKernel ) { throw std::invalid_argument( "Conv2D::OutputSize: Kernel size, stride, and dilation must not be 0." ); }
+			const size_t sExtent = _sDilation * (_sKernel - 1) + 1;
+			if ( _sIn + 2 * _sPad < sExtent ) { throw std::invalid_argument( "Conv2D::OutputSize: The kernel does not fit in the padded input." ); }
+			return (_sIn + 2 * _sPad - sExtent) / _sStride + 1;
+		}
+
+		/**
+		 * Chooses the forward algorithm for the running CPU.  The direct algorithm needs SIMD registers and is chosen for every kernel larger
+		 *	than 1x1: it beats the unfolded multiply even when most lanes of its output-channel blocks are unused, because the unfolded matrix
+		 *	of a small layer makes for a short, memory-bound multiply.  1x1 kernels use Gemm.
+		 *
+		 * \tparam _tType The element type: float, double, bfloat16_t, or nn9::float16.
+		 * \param _vShapeIn The input shape, [N, C, H, W].
+		 * \param _vShapeWeights The weight shape, [O, C/Groups, Kh, Kw].
+		 * \param _cpParms The convolution parameters.
+		 * \return Returns NN9_CA_IM2COL or NN9_CA_DIRECT.
+		 **/
+		template <typename _tType>
+		static NN9_CONV_ALGO										Select( const std::vector<size_t> &_vShapeIn, const std::vector<size_t> &_vShapeWeights, const NN9_CONV2D_PARAMS &_cpParms ) {
+			if ( _vShapeIn.size() != 4 || _vShapeWeights.size() != 4 || !_cpParms.sGroups ) { return NN9_CA_IM2COL; }
+			return Choose<ConvType<_tType>>( _vShapeWeights[2], _vShapeWeights[3] );
+		}
+
+		/**
+		 * Computes the forward pass of a convolution.
+		 *
+		 * \tparam _tType The element type: float, double, bfloat16_t, or nn9::float16.
+		 * \param _svIn The input, [N, C, H, W].
+		 * \param _svWeights The weights, [O, C/Groups, Kh, Kw].
+		 * \param _psvBias The bias, [O], or nullptr.
+		 * \param _svOut The output, [N, O, Oh, Ow].
+		 * \param _cpParms The convolution parameters.
+		 * \param _caAlgo The algorithm.  NN9_CA_AUTO calls Select().
+		 * \throw Throws if the shapes do not agree or _svOut has overlapping elements.
+		 * \return Returns _svOut.
+		 **/
+		template <typename _tType>
+		static StridedView<_tType> &								Forward( const StridedView<_tType> &_svIn, const StridedView<_tType> &_svWeights, const StridedView<_tType> * _psvBias,
+			StridedView<_tType> &_svOut, const NN9_CONV2D_PARAMS &_cpParms = NN9_CONV2D_PARAMS(), NN9_CONV_ALGO _caAlgo = NN9_CA_AUTO ) {
+			using Scalar = ConvType<_tType>;
+			const NN9_CONV2D_SHAPE csShape = Shapes( _svIn.Shape(), _svWeights.Shape(), _svOut.Shape(), _cpParms );
+			if ( _svOut.Overlaps() ) { throw std::invalid_argument( "Conv2D::Forward: Cannot write to an expanded view." ); }
+			std::vector<Scalar> vBias( csShape.sO );
+			if ( _psvBias ) {
+				if ( _psvBias->Shape().size() != 1 || _psvBias->Shape()[0] != csShape.sO ) { throw std::invalid_argument( "Conv2D::Forward: The bias must have 1 value per output channel." ); }
+				for ( size_t I = 0; I < csShape.sO; ++I ) { vBias[I] = static_cast<Scalar>(_psvBias->Data()[I*_psvBias->Strides()[0]]); }
+			}
+			if ( !csShape.sN ) { return _svOut; }
+
+			if ( _caAlgo == NN9_CA_AUTO ) { _caAlgo = Choose<Scalar>( csShape.sKh, csShape.sKw ); }
+			if ( _caAlgo == NN9_CA_DIRECT ) {
+				switch ( Kernels::Table().kiConv ) {
+					case Kernels::NN9_KI_AVX512 : {
+						ForwardDirect<NN9_ISA_TABLE<Scalar, 64 / sizeof( Scalar ), Kernels::NN9_KC_AVX512_COLS>>( csShape, _cpParms, _svIn, _svWeights, vBias, _svOut );
+						return _svOut;
+					}
+					case Kernels::NN9_KI_AVX2 : {
+						ForwardDirect<NN9_ISA_TABLE<Scalar, 32 / sizeof( Scalar ), Kernels::NN9_KC_AVX2_COLS>>( csShape, _cpParms, _svIn, _svWeights, vBias, _svOut );
+						return _svOut;
+					}
+					default : {}
+				}
+				ForwardDirect<NN9_ISA_SCALAR<Scalar>>( csShape, _cpParms, _svIn, _svWeights, vBias, _svOut );
+				return _svOut;
+			}
+			ForwardIm2Col( csShape, _cpParms, _svIn, _svWeights, vBias, _svOut );
+			return _svOut;
+		}
+
+		/**
+		 * Computes the gradient of a convolution with respect to its input.  _svGradIn is overwritten.
+		 *
+		 * \tparam _tType The element type: float, double, bfloat16_t, or nn9::float16.
+		 * \param _svGradOut The gradient with respect to the output, [N, O, Oh, Ow].
+		 * \param _svWeights The weights, [O, C/Groups, Kh, Kw].
+		 * \param _svGradIn The gradient with respect to the input, [N, C, H, W].
+		 * \param _cpParms The convolution parameters.
+		 * \throw Throws if the shapes do not agree or _svGradIn has overlapping elements.
+		 * \return Returns _svGradIn.
+		 **/
+		template <typename _tType>
+		static StridedView<_tType> &								BackwardData( const StridedView<_tType> &_svGradOut, const StridedView<_tType> &_svWeights, StridedView<_tType> &_svGradIn,
+			const NN9_CONV2D_PARAMS &_cpParms = NN9_CONV2D_PARAMS() ) {
+			using Scalar = ConvType<_tType>;
+			const NN9_CONV2D_SHAPE csShape = Shapes( _svGradIn.Shape(), _svWeights.Shape(), _svGradOut.Shape(), _cpParms );
+			if ( _svGradIn.Overlaps() ) { throw std::invalid_argument( "Conv2D::BackwardData: Cannot write to an expanded view." ); }
+			const std::vector<Scalar> vWeights = GatherWeights<Scalar>( csShape, _svWeights );
+			const bool bUnitKernel = IsUnitKernel( csShape, _cpParms );
+
+			auto aTasks = [&]( size_t _sBegin, size_t _sEnd ) {
+				std::vector<Scalar> vGrad, vCol, vImg;
+				for ( size_t T = _sBegin; T < _sEnd; ++T ) {
+					const size_t N = T / _cpParms.sGroups, G = T % _cpParms.sGroups;
+					size_t sRowB, sColB;
+					const Scalar * psGrad = GatherOutput( csShape, _svGradOut, N, G, vGrad, sRowB, sColB );
+
+					// Column (k, p) of the unfolded gradient is the sum over output channels of W[o][k] * dY[o][p].
+					const Scalar * psW = vWeights.data() + G * csShape.sOg * csShape.sK;
+					_tType * ptIn = _svGradIn.Data() + N * _svGradIn.Strides()[0] + G * csShape.sCg * _svGradIn.Strides()[1];
+					if constexpr ( std::is_same<_tType, Scalar>::value ) {
+						if ( bUnitKernel && Collapses( _svGradIn ) ) {
+							Gemm::Run<Scalar>( csShape.sCg, csShape.sOh * csShape.sOw, csShape.sOg, psW, 1, csShape.sK, psGrad, sRowB, sColB,
+								ptIn, _svGradIn.Strides()[1], _svGradIn.Strides()[3] );
+							continue;
+						}
+					}
+					vCol.resize( csShape.sK * csShape.sOh * csShape.sOw );
+					Gemm::Run<Scalar>( csShape.sK, csShape.sOh * csShape.sOw, csShape.sOg, psW, 1, csShape.sK, psGrad, sRowB, sColB,
+						vCol.data(), csShape.sOh * csShape.sOw, 1 );
+					vImg.assign( csShape.sCg * csShape.sH * csShape.sW, Scalar( 0 ) );
+					Col2Im( csShape, _cpParms, vCol.data(), vImg.data() );
+					for ( size_t C = 0; C < csShape.sCg; ++C ) {
+						for ( size_t Y = 0; Y < csShape.sH; ++Y ) {
+							_tType * ptRow = ptIn + C * _svGradIn.Strides()[1] + Y * _svGradIn.Strides()[2];
+							const Scalar * psRow = vImg.data() + (C * csShape.sH + Y) * csShape.sW;
+							for ( size_t X = 0; X < csShape.sW; ++X ) { ptRow[X*_svGradIn.Strides()[3]] = static_cast<_tType>(psRow[X]); }
+						}
+					}
+				}
+			};
+			const size_t sTasks = csShape.sN * _cpParms.sGroups;
+			if ( sTasks > 1 ) { ThreadPool::Global().ParallelFor( 0, sTasks, 1, aTasks ); }
+			else { aTasks( 0, sTasks ); }
+			return _svGradIn;
+		}
+
+		/**
+		 * Computes the gradients of a convolution with respect to its weights and bias.  _svGradWeights and the bias gradient are overwritten.
+		 *	The batch is split over the ThreadPool, each part summing into its own gradient, and each part unfolds as many images at once as fit
+		 *	in NN9_C_COL_ELEMENTS so that every multiply is long enough to be efficient.
+		 *
+		 * \tparam _tType The element type: float, double, bfloat16_t, or nn9::float16.
+		 * \param _svIn The input, [N, C, H, W].
+		 * \param _svGradOut The gradient with respect to the output, [N, O, Oh, Ow].
+		 * \param _svGradWeights The gradient with respect to the weights, [O, C/Groups, Kh, Kw].
+		 * \param _psvGradBias The gradient with respect to the bias, [O], or nullptr.
+		 * \param _cpParms The convolution parameters.
+		 * \throw Throws if the shapes do not agree or a gradient has overlapping elements.
+		 * \return Returns _svGradWeights.
+		 **/
+		template <typename _tType>
+		static StridedView<_tType> &								BackwardWeights( const StridedView<_tType> &_svIn, const StridedView<_tType> &_svGradOut, StridedView<_tType> &_svGradWeights,
+			StridedView<_tType> * _psvGradBias, const NN9_CONV2D_PARAMS &_cpParms = NN9_CONV2D_PARAMS() ) {
+			using Scalar = ConvType<_tType>;
+			const NN9_CONV2D_SHAPE csShape = Shapes( _svIn.Shape(), _svGradWeights.Shape(), _svGradOut.Shape(), _cpParms );
+			if ( _svGradWeights.Overlaps() ) { throw std::invalid_argument( "Conv2D::BackwardWeights: Cannot write to an expanded view." ); }
+			if ( _psvGradBias ) {
+				if ( _psvGradBias->Shape().size() != 1 || _psvGradBias->Shape()[0] != csShape.sO ) { throw std::invalid_argument( "Conv2D::BackwardWeights: The bias must have 1 value per output channel." ); }
+				if ( _psvGradBias->Overlaps() ) { throw std::invalid_argument( "Conv2D::BackwardWeights: Cannot write to an expanded view." ); }
+			}
+
+			const size_t sOhw = csShape.sOh * csShape.sOw;
+			const size_t sWeights = csShape.sO * csShape.sK;
+			const size_t sParts = std::max<size_t>( 1, std::min( csShape.sN, ThreadPool::Global().Size() ) );
+			const size_t sChunk = std::max<size_t>( 1, std::min( csShape.sN, NN9_C_COL_ELEMENTS / std::max<size_t>( 1, csShape.sK * sOhw ) ) );
+			std::vector<Scalar> vPartial( sParts * (sWeights + csShape.sO) );
+
+			auto aParts = [&]( size_t _sBegin, size_t _sEnd ) {
+				std::vector<Scalar> vCol, vGrad;
+				for ( size_t P = _sBegin; P < _sEnd; ++P ) {
+					Scalar * psDw = vPartial.data() + P * (sWeights + csShape.sO);
+					Scalar * psDb = psDw + sWeights;
+					const size_t sFirst = csShape.sN * P / sParts, sLast = csShape.sN * (P + 1) / sParts;
+					for ( size_t G = 0; G < _cpParms.sGroups; ++G ) {
+						for ( size_t N = sFirst; N < sLast; N += sChunk ) {
+							const size_t sImages = std::min( sChunk, sLast - N );
+							const size_t sCols = sImages * sOhw;
+							vCol.resize( csShape.sK * sCols );
+							vGrad.resize( csShape.sOg * sCols );
+							for ( size_t I = 0; I < sImages; ++I ) {
+								Im2Col( csShape, _cpParms, _svIn, N + I, G, vCol.data() + I * sOhw, sCols );
+								for ( size_t O = 0; O < csShape.sOg; ++O ) {
+									GatherPlane( _svGradOut, N + I, G * csShape.sOg + O, csShape.sOh, csShape.sOw, vGrad.data() + O * sCols + I * sOhw );
+								}
+							}
+							// dW[o][k] += sum over p of dY[o][p] * Col[k][p].
+							Gemm::Run<Scalar>( csShape.sOg, csShape.sK, sCols, vGrad.data(), sCols, 1, vCol.data(), 1, sCols,
+								psDw + G * csShape.sOg * csShape.sK, csShape.sK, 1, 1.0, N == sFirst ? 0.0 : 1.0 );
+							for ( size_t O = 0; O < csShape.sOg; ++O ) {
+								const Scalar * psRow = vGrad.data() + O * sCols;
+								Scalar sSum = Scalar( 0 );
+								for ( size_t J = 0; J < sCols; ++J ) { sSum += psRow[J]; }
+								psDb[G*csShape.sOg+O] += sSum;
+							}
+						}
+					}
+				}
+			};
+			if ( sParts > 1 ) { ThreadPool::Global().ParallelFor( 0, sParts, 1, aParts ); }
+			else { aParts( 0, sParts ); }
+
+			for ( size_t P = 1; P < sParts; ++P ) {
+				const Scalar * psSrc = vPartial.data() + P * (sWeights + csShape.sO);
+				for ( size_t I = 0; I < sWeights + csShape.sO; ++I ) { vPartial[I] += psSrc[I]; }
+			}
+			const auto & vStrides = _svGradWeights.Strides();
+			for ( size_t O = 0; O < csShape.sO; ++O ) {
+				for ( size_t C = 0; C < csShape.sCg; ++C ) {
+					for ( size_t Y = 0; Y < csShape.sKh; ++Y ) {
+						for ( size_t X = 0; X < csShape.sKw; ++X ) {
+							_svGradWeights.Data()[O*vStrides[0]+C*vStrides[1]+Y*vStrides[2]+X*vStrides[3]] =
+								static_cast<_tType>(vPartial[O*csShape.sK+(C*csShape.sKh+Y)*csShape.sKw+X]);
+						}
+					}
+				}
+			}
+			if ( _psvGradBias ) {
+				for ( size_t O = 0; O < csShape.sO; ++O ) { _psvGradBias->Data()[O*_psvGradBias->Strides()[0]] = static_cast<_tType>(vPartial[sWeights+O]); }
+			}
+			return _svGradWeights;
+		}
+
+		/**
+		 * Computes the forward pass of a convolution over tensors.  All tensors must have the same type, which must be NN9_T_FLOAT, NN9_T_DOUBLE,
+		 *	NN9_T_BFLOAT16, or NN9_T_FLOAT16.
+		 *
+		 * \param _tIn The input, [N, C, H, W].
+		 * \param _tWeights The weights, [O, C/Groups, Kh, Kw].
+		 * \param _ptBias The bias, [O], or nullptr.
+		 * \param _tOut The output, [N, O, Oh, Ow].
+		 * \param _cpParms The convolution parameters.
+		 * \param _caAlgo The algorithm.  NN9_CA_AUTO calls Select().
+		 * \throw Throws if the types are not supported or do not match, or if the shapes do not agree.
+		 * \return Returns _tOut.
+		 **/
+		static Tensor &												Forward( Tensor &_tIn, Tensor &_tWeights, Tensor * _ptBias, Tensor &_tOut,
+			const NN9_CONV2D_PARAMS &_cpParms = NN9_CONV2D_PARAMS(), NN9_CONV_ALGO _caAlgo = NN9_CA_AUTO ) {
+			if ( _tIn.Type() != _tWeights.Type() || _tIn.Type() != _tOut.Type() || (_ptBias && _ptBias->Type() != _tIn.Type()) ) {
+				throw std::invalid_argument( "Conv2D::Forward: All tensors must have the same type." );
+			}
+#define NN9_CONV2D_FORWARD( CASE, TYPE )																							\
+	case CASE : {																													\
+		auto svOut = _tOut.Strided<TYPE>();																							\
+		if ( _ptBias ) {																											\
+			auto svBias = _ptBias->Strided<TYPE>();																					\
+			Forward<TYPE>( _tIn.Strided<TYPE>(), _tWeights.Strided<TYPE>(), &svBias, svOut, _cpParms, _caAlgo );					\
+		}																															\
+		else { Forward<TYPE>( _tIn.Strided<TYPE>(), _tWeights.Strided<TYPE>(), nullptr, svOut, _cpParms, _caAlgo ); }				\
+		return _tOut;																												\
+	}
+			switch ( _tIn.Type() ) {
+				NN9_CONV2D_FORWARD( NN9_T_FLOAT, float )
+				NN9_CONV2D_FORWARD( NN9_T_DOUBLE, double )
+				NN9_CONV2D_FORWARD( NN9_T_BFLOAT16, bfloat16_t )
+				NN9_CONV2D_FORWARD( NN9_T_FLOAT16, nn9::float16 )
+				default : {
+					throw std::invalid_argument( "Conv2D::Forward: Unsupported tensor type." );
+				}
+			}
+#undef NN9_CONV2D_FORWARD
+		}
+
+		/**
+		 * Computes the gradient of a convolution with respect to its input over tensors.  All tensors must have the same type, which must be
+		 *	NN9_T_FLOAT, NN9_T_DOUBLE, NN9_T_BFLOAT16, or NN9_T_FLOAT16.
+		 *
+		 * \param _tGradOut The gradient with respect to the output, [N, O, Oh, Ow].
+		 * \param _tWeights The weights, [O, C/Groups, Kh, Kw].
+		 * \param _tGradIn The gradient with respect to the input, [N, C, H, W].
+		 * \param _cpParms The convolution parameters.
+		 * \throw Throws if the types are not supported or do not match, or if the shapes do not agree.
+		 * \return Returns _tGradIn.
+		 **/
+		static Tensor &												BackwardData( Tensor &_tGradOut, Tensor &_tWeights, Tensor &_tGradIn, const NN9_CONV2D_PARAMS &_cpParms = NN9_CONV2D_PARAMS() ) {
+			if ( _tGradOut.Type() != _tWeights.Type() || _tGradOut.Type() != _tGradIn.Type() ) {
+				throw std::invalid_argument( "Conv2D::BackwardData: All tensors must have the same type." );
+			}
+#define NN9_CONV2D_BACKWARD_DATA( CASE, TYPE )																						\
+	case CASE : {																													\
+		auto svGradIn = _tGradIn.Strided<TYPE>();																					\
+		BackwardData<TYPE>( _tGradOut.Strided<TYPE>(), _tWeights.Strided<TYPE>(), svGradIn, _cpParms );							\
+		return _tGradIn;																											\
+	}
+			switch ( _tGradOut.Type() ) {
+				NN9_CONV2D_BACKWARD_DATA( NN9_T_FLOAT, float )
+				NN9_CONV2D_BACKWARD_DATA( NN9_T_DOUBLE, double )
+				NN9_CONV2D_BACKWARD_DATA( NN9_T_BFLOAT16, bfloat16_t )
+				NN9_CONV2D_BACKWARD_DATA( NN9_T_FLOAT16, nn9::float16 )
+				default : {
+					throw std::invalid_argument( "Conv2D::BackwardData: Unsupported tensor type." );
+				}
+			}
+#undef NN9_CONV2D_BACKWARD_DATA
+		}
+
+		/**
+		 * Computes the gradients of a convolution with respect to its weights and bias over tensors.  All tensors must have the same type, which
+		 *	must be NN9_T_FLOAT, NN9_T_DOUBLE, NN9_T_BFLOAT16, or NN9_T_FLOAT16.
+		 *
+		 * \param _tIn The input, [N, C, H, W].
+		 * \param _tGradOut The gradient with respect to the output, [N, O, Oh, Ow].
+		 * \param _tGradWeights The gradient with respect to the weights, [O, C/Groups, Kh, Kw].
+		 * \param _ptGradBias The gradient with respect to the bias, [O], or nullptr.
+		 * \param _cpParms The convolution parameters.
+		 * \throw Throws if the types are not supported or do not match, or if the shapes do not agree.
+		 * \return Returns _tGradWeights.
+		 **/
+		static Tensor &												BackwardWeights( Tensor &_tIn, Tensor &_tGradOut, Tensor &_tGradWeights, Tensor * _ptGradBias,
+			const NN9_CONV2D_PARAMS &_cpParms = NN9_CONV2D_PARAMS() ) {
+			if ( _tIn.Type() != _tGradOut.Type() || _tIn.Type() != _tGradWeights.Type() || (_ptGradBias && _ptGradBias->Type() != _tIn.Type()) ) {
+				throw std::invalid_argument( "Conv2D::BackwardWeights: All tensors must have the same type." );
+			}
+#define NN9_CONV2D_BACKWARD_WEIGHTS( CASE, TYPE )																					\
+	case CASE : {																													\
+		auto svGradWeights = _tGradWeights.Strided<TYPE>();																			\
+		if ( _ptGradBias ) {																										\
+			auto svGradBias = _ptGradBias->Strided<TYPE>();																			\
+			BackwardWeights<TYPE>( _tIn.Strided<TYPE>(), _tGradOut.Strided<TYPE>(), svGradWeights, &svGradBias, _cpParms );		\
+		}																															\
+		else { BackwardWeights<TYPE>( _tIn.Strided<TYPE>(), _tGradOut.Strided<TYPE>(), svGradWeights, nullptr, _cpParms ); }		\
+		return _tGradWeights;																										\
+	}
+			switch ( _tIn.Type() ) {
+				NN9_CONV2D_BACKWARD_WEIGHTS( NN9_T_FLOAT, float )
+				NN9_CONV2D_BACKWARD_WEIGHTS( NN9_T_DOUBLE, double )
+				NN9_CONV2D_BACKWARD_WEIGHTS( NN9_T_BFLOAT16, bfloat16_t )
+				NN9_CONV2D_BACKWARD_WEIGHTS( NN9_T_FLOAT16, nn9::float16 )
+				default : {
+					throw std::invalid_argument( "Conv2D::BackwardWeights: Unsupported tensor type." );
+				}
+			}
+#undef NN9_CONV2D_BACKWARD_WEIGHTS
+		}
+
+
+	protected :
+		// == Types.
+		/** The internal type: double for double and float for everything else. */
+		template <typename _tType>
+		using ConvType = typename std::conditional<Types::SimdDouble<_tType>(), double, float>::type;
+
+		/** A 64-byte-aligned buffer. */
+		template <typename _tScalar>
+		using PackBuffer = std::vector<_tScalar, AlignmentAllocator<_tScalar, 64>>;
+
+		/** The sizes of a convolution. */
+		struct NN9_CONV2D_SHAPE {
+			size_t												sN;												/**< Images. */
+			size_t												sC;												/**< Input channels. */
+			size_t												sH;												/**< Input height. */
+			size_t												sW;												/**< Input width. */
+			size_t												sO;												/**< Output channels. */
+			size_t												sKh;											/**< Kernel height. */
+			size_t												sKw;											/**< Kernel width. */
+			size_t												sOh;											/**< Output height. */
+			size_t												sOw;											/**< Output width. */
+			size_t												sCg;											/**< Input channels per group. */
+			size_t												sOg;											/**< Output channels per group. */
+			size_t												sK;												/**< Values in each patch: sCg * sKh * sKw. */
+		};
+
+		/** The strides of the blocked buffers of the direct algorithm, in elements. */
+		typedef Kernels::NN9_DIRECT_LAYOUT					NN9_DIRECT_LAYOUT;
+
+		/**
+		 * Scalar registers for the direct algorithm.  Every ISA provides the same members so that 1 set of kernels serves them all.  Cols is
+		 *	the number of output pixels whose accumulators are kept in registers at once.
+		 */
+		template <typename _tScalar>
+		struct NN9_ISA_SCALAR {
+			typedef _tScalar								Scalar;
+			typedef _tScalar								Reg;
+			static constexpr size_t							Lanes = 1;
+			static constexpr size_t							Cols = 4;
+			static constexpr bool							FromTable = false;
+
+			static inline Reg								Zero() { return Reg( 0 ); }
+			static inline Reg								Set1( Scalar _sVal ) { return _sVal; }
+			static inline Reg								Load( const Scalar * _psSrc ) { return (*_psSrc); }
+			static inline void								Store( Scalar * _psDst, Reg _rVal ) { (*_psDst) = _rVal; }
+			static inline Reg								Fma( Reg _rA, Reg _rB, Reg _rC ) { return _rA * _rB + _rC; }
+		};
+
+		/**
+		 * Direct kernels from Kernels::Table().  Each tile goes to the table's pfConvF32 or pfConvF64; the members of NN9_ISA_SCALAR serve
+		 *	nothing else.  Lanes and Cols are the register width and tile width of the table's kiConv, so that ForwardDirect() blocks the
+		 *	buffers as the table's kernels expect.
+		 *
+		 * \tparam _tScalar The internal type (float or double).
+		 * \tparam _sLanes The lanes in a register.
+		 * \tparam _sTileCols The output pixels in a tile.
+		 */
+		template <typename _tScalar, size_t _sLanes, size_t _sTileCols>
+		struct NN9_ISA_TABLE : public NN9_ISA_SCALAR<_tScalar> {
+			static constexpr size_t							Lanes = _sLanes;
+			static constexpr size_t							Cols = _sTileCols;
+			static constexpr bool							FromTable = true;
+
+			/**
+			 * Computes a tile with the table's kernel.
+			 *
+			 * \param _sCols The number of output pixels in the tile, 1 to Cols.
+			 * \param _dlLayout The strides of the blocked buffers.
+			 * \param _psIn The blocked input at the first tap of the first pixel.
+			 * \param _psW The blocked weights of the output-channel block.
+			 * \param _psTile The output tile, [Cols, Lanes].
+			 **/
+			static inline void								Tile( size_t _sCols, const NN9_DIRECT_LAYOUT &_dlLayout, const _tScalar * _psIn, const _tScalar * _psW,
+				_tScalar * _psTile ) {
+				if constexpr ( std::is_same<_tScalar, double>::value ) { Kernels::Table().pfConvF64( _sCols, _dlLayout, _psIn, _psW, _psTile ); }
+				else { Kernels::Table().pfConvF32( _sCols, _dlLayout, _psIn, _psW, _psTile ); }
+			}
+		};
+
+
+		// == Functions.
+		/**
+		 * Checks the shapes of a convolution and gathers its sizes.
+		 *
+		 * \param _vShapeIn The input shape, [N, C, H, W].
+		 * \param _vShapeWeights The weight shape, [O, C/Groups, Kh, Kw].
+		 * \param _vShapeOut The output shape, [N, O, Oh, Ow].
+		 * \param _cpParms The convolution parameters.
+		 * \throw Throws if the shapes do not agree.
+		 * \return Returns the sizes of the convolution.
+		 **/
+		static NN9_CONV2D_SHAPE										Shapes( const std::vector<size_t> &_vShapeIn, const std::vector<size_t> &_vShapeWeights, const std::vector<size_t> &_vShapeOut,
+			const NN9_CONV2D_PARAMS &_cpParms ) {
+			if ( _vShapeIn.size() != 4 || _vShapeWeights.size() != 4 || _vShapeOut.size() != 4 ) {
+				throw std::invalid_argument( "Conv2D::Shapes: Inputs, weights, and outputs must have 4 dimensions." );
+			}
+			if ( !_cpParms.sGroups || _vShapeIn[1] % _cpParms.sGroups || _vShapeWeights[0] % _cpParms.sGroups ) {
+				throw std::invalid_argument( "Conv2D::Shapes: Input and output channels must be divisible by the groups." );
+			}
+			NN9_CONV2D_SHAPE csShape;
+			csShape.sN = _vShapeIn[0];
+			csShape.sC = _vShapeIn[1];
+			csShape.sH = _vShapeIn[2];
+			csShape.sW = _vShapeIn[3];
+			csShape.sO = _vShapeWeights[0];
+			csShape.sKh = _vShapeWeights[2];
+			csShape.sKw = _vShapeWeights[3];
+			csShape.sCg = csShape.sC / _cpParms.sGroups;
+			csShape.sOg = csShape.sO / _cpParms.sGroups;
+			csShape.sK = csShape.sCg * csShape.sKh * csShape.sKw;
+			if ( _vShapeWeights[1] != csShape.sCg ) {
+				throw std::invalid_argument( "Conv2D::Shapes: The weights must have 1 channel for each input channel in a group." );
+			}
+			csShape.sOh = OutputSize( csShape.sH, csShape.sKh, _cpParms.sStrideH, _cpParms.sPadH, _cpParms.sDilationH );
+			csShape.sOw = OutputSize( csShape.sW, csShape.sKw, _cpParms.sStrideW, _cpParms.sPadW, _cpParms.sDilationW );
+			if ( _vShapeOut[0] != csShape.sN || _vShapeOut[1] != csShape.sO || _vShapeOut[2] != csShape.sOh || _vShapeOut[3] != csShape.sOw ) {
+				throw std::invalid_argument( "Conv2D::Shapes: The output shape does not match the input, weights, and parameters." );
+			}
+			return csShape;
+		}
+
+		/**
+		 * Chooses the forward algorithm.
+		 *
+		 * \tparam _tScalar The internal type.
+		 * \param _sKh Kernel height.
+		 * \param _sKw Kernel width.
+		 * \return Returns NN9_CA_IM2COL or NN9_CA_DIRECT.
+		 **/
+		template <typename _tScalar>
+		static NN9_CONV_ALGO										Choose( size_t _sKh, size_t _sKw ) {
+			// A 1x1 kernel does too little work per input value to pay for blocking the input, and with a stride of 1 and no padding it is a
+			//	plain multiply that needs no unfolding.
+			if ( DirectLanes<_tScalar>() == 1 || (_sKh == 1 && _sKw == 1) ) { return NN9_CA_IM2COL; }
+			return NN9_CA_DIRECT;
+		}
+
+		/**
+		 * Gets the lanes in a register of the direct algorithm on the running CPU.
+		 *
+		 * \tparam _tScalar The internal type.
+		 * \return Returns the lanes in a register, or 1 if there are no SIMD registers.
+		 **/
+		template <typename _tScalar>
+		static size_t												DirectLanes() {
+			switch ( Kernels::Table().kiConv ) {
+				case Kernels::NN9_KI_AVX512 : { return 64 / sizeof( _tScalar ); }
+				case Kernels::NN9_KI_AVX2 : { return 32 / sizeof( _tScalar ); }
+				default : { return 1; }
+			}
+		}
+
+		/**
+		 * Determines whether a convolution is a plain matrix multiply: a 1x1 kernel with a stride of 1 and no padding.
+		 *
+		 * \param _csShape The sizes of the convolution.
+		 * \param _cpParms The convolution parameters.
+		 * \return Returns true if every output pixel reads only the input pixel at the same position.
+		 **/
+		static inline bool											IsUnitKernel( const NN9_CONV2D_SHAPE &_csShape, const NN9_CONV2D_PARAMS &_cpParms ) {
+			return _csShape.sKh == 1 && _csShape.sKw == 1 && _cpParms.sStrideH == 1 && _cpParms.sStrideW == 1 && !_cpParms.sPadH && !_cpParms.sPadW;
+		}
+
+		/**
+		 * Determines whether the last 2 dimensions of a view can be addressed as 1 dimension with the stride of the last.
+		 *
+		 * \tparam _tType The element type.
+		 * \param _svView The [N, C, H, W] view.
+		 * \return Returns true if each row starts where the previous one would continue.
+		 **/
+		template <typename _tType>
+		static inline bool											Collapses( const StridedView<_tType> &_svView ) {
+			return _svView.Shape()[2] <= 1 || _svView.Strides()[2] == _svView.Shape()[3] * _svView.Strides()[3];
+		}
+
+		/**
+		 * Copies the weights into a contiguous [O, K] matrix of the internal type.
+		 *
+		 * \tparam _tScalar The internal type.
+		 * \tparam _tType The element type.
+		 * \param _csShape The sizes of the convolution.
+		 * \param _svWeights The weights, [O, C/Groups, Kh, Kw].
+		 * \return Returns the copied weights.
+		 **/
+		template <typename _tScalar, typename _tType>
+		static std::vector<_tScalar>								GatherWeights( const NN9_CONV2D_SHAPE &_csShape, const StridedView<_tType> &_svWeights ) {
+			std::vector<_tScalar> vRet( _csShape.sO * _csShape.sK );
+			const auto & vStrides = _svWeights.Strides();
+			for ( size_t O = 0; O < _csShape.sO; ++O ) {
+				for ( size_t C = 0; C < _csShape.sCg; ++C ) {
+					for ( size_t Y = 0; Y < _csShape.sKh; ++Y ) {
+						for ( size_t X = 0; X < _csShape.sKw; ++X ) {
+							vRet[O*_csShape.sK+(C*_csShape.sKh+Y)*_csShape.sKw+X] =
+								static_cast<_tScalar>(_svWeights.Data()[O*vStrides[0]+C*vStrides[1]+Y*vStrides[2]+X*vStrides[3]]);
+						}
+					}
+				}
+			}
+			return vRet;
+		}
+
+		/**
+		 * Copies 1 channel of an [N, C, H, W] view into a contiguous plane of the internal type.
+		 *
+		 * \tparam _tType The element type.
+		 * \tparam _tScalar The internal type.
+		 * \param _svView The view.
+		 * \param _sN The image.
+		 * \param _sC The channel.
+		 * \param _sH The height of the view.
+		 * \param _sW The width of the view.
+		 * \param _psDst The plane, _sH * _sW values.
+		 **/
+		template <typename _tType, typename _tScalar>
+		static void													GatherPlane( const StridedView<_tType> &_svView, size_t _sN, size_t _sC, size_t _sH, size_t _sW, _tScalar * _psDst ) {
+			const auto & vStrides = _svView.Strides();
+			const _tType * ptPlane = _svView.Data() + _sN * vStrides[0] + _sC * vStrides[1];
+			for ( size_t Y = 0; Y < _sH; ++Y ) {
+				const _tType * ptRow = ptPlane + Y * vStrides[2];
+				for ( size_t X = 0; X < _sW; ++X ) { (*_psDst++) = static_cast<_tScalar>(ptRow[X*vStrides[3]]); }
+			}
+		}
+
+		/**
+		 * Gets the output-gradient matrix, [Og, Oh * Ow], of 1 image and group, either in place or gathered into a buffer.
+		 *
+		 * \tparam _tType The element type.
+		 * \tparam _tScalar The internal type.
+		 * \param _csShape The sizes of the convolution.
+		 * \param _svGradOut The gradient with respect to the output.
+		 * \param _sN The image.
+		 * \param _sG The group.
+		 * \param _vBuffer The buffer used if the matrix cannot be used in place.
+		 * \param _sRow Receives the distance between rows of the matrix.
+		 * \param _sCol Receives the distance between columns of the matrix.
+		 * \return Returns the first element of the matrix.
+		 **/
+		template <typename _tType, typename _tScalar>
+		static const _tScalar *										GatherOutput( const NN9_CONV2D_SHAPE &_csShape, const StridedView<_tType> &_svGradOut, size_t _sN, size_t _sG,
+			std::vector<_tScalar> &_vBuffer, size_t &_sRow, size_t &_sCol ) {
+			if constexpr ( std::is_same<_tType, _tScalar>::value ) {
+				if ( Collapses( _svGradOut ) ) {
+					_sRow = _svGradOut.Strides()[1];
+					_sCol = _svGradOut.Strides()[3];
+					return _svGradOut.Data() + _sN * _svGradOut.Strides()[0] + _sG * _csShape.sOg * _svGradOut.Strides()[1];
+				}
+			}
+			const size_t sOhw = _csShape.sOh * _csShape.sOw;
+			_vBuffer.resize( _csShape.sOg * sOhw );
+			for ( size_t O = 0; O < _csShape.sOg; ++O ) {
+				GatherPlane( _svGradOut, _sN, _sG * _csShape.sOg + O, _csShape.sOh, _csShape.sOw, _vBuffer.data() + O * sOhw );
+			}
+			_sRow = sOhw;
+			_sCol = 1;
+			return _vBuffer.data();
+		}
+
+		/**
+		 * Gets the range of output columns whose input column, Ow * Stride + _pOffset, lies inside the input.
+		 *
+		 * \param _pOffset The input column of output column 0.
+		 * \param _sStride The horizontal stride.
+		 * \param _sIn The input width.
+		 * \param _sOut The output width.
+		 * \param _sLo Receives the first valid output column.
+		 * \param _sHi Receives the end of the valid output columns.
+		 **/
+		static inline void											ValidRange( std::ptrdiff_t _pOffset, size_t _sStride, size_t _sIn, size_t _sOut, size_t &_sLo, size_t &_sHi ) {
+			const std::ptrdiff_t pStride = std::ptrdiff_t( _sStride );
+			const std::ptrdiff_t pLo = _pOffset >= 0 ? 0 : (-_pOffset + pStride - 1) / pStride;
+			const std::ptrdiff_t pHi = std::ptrdiff_t( _sIn ) - _pOffset <= 0 ? 0 : (std::ptrdiff_t( _sIn ) - _pOffset + pStride - 1) / pStride;
+			_sHi = std::min<size_t>( _sOut, size_t( pHi ) );
+			_sLo = std::min<size_t>( _sHi, size_t( pLo ) );
+		}
+
+		/**
+		 * Unfolds the patches of 1 image and group into a [K, Oh * Ow] matrix.  Row (c * Kh + y) * Kw + x holds input channel c shifted by
+		 *	kernel tap (y, x), with 0 wherever the tap falls in the padding.
+		 *
+		 * \tparam _tType The element type.
+		 * \tparam _tScalar The internal type.
+		 * \param _csShape The sizes of the convolution.
+		 * \param _cpParms The convolution parameters.
+		 * \param _svIn The input, [N, C, H, W].
+		 * \param _sN The image.
+		 * \param _sG The group.
+		 * \param _psCol The first element of the matrix.
+		 * \param _sRowCol The distance between rows of the matrix.
+		 **/
+		template <typename _tType, typename _tScalar>
+		static void													Im2Col( const NN9_CONV2D_SHAPE &_csShape, const NN9_CONV2D_PARAMS &_cpParms, const StridedView<_tType> &_svIn,
+			size_t _sN, size_t _sG, _tScalar * _psCol, size_t _sRowCol ) {
+			const auto & vStrides = _svIn.Strides();
+			const _tType * ptIn = _svIn.Data() + _sN * vStrides[0] + _sG * _csShape.sCg * vStrides[1];
+			const size_t sStepX = _cpParms.sStrideW * vStrides[3];
+			for ( size_t C = 0; C < _csShape.sCg; ++C ) {
+				for ( size_t KY = 0; KY < _csShape.sKh; ++KY ) {
+					for ( size_t KX = 0; KX < _csShape.sKw; ++KX ) {
+						_tScalar * psRow = _psCol + ((C * _csShape.sKh + KY) * _csShape.sKw + KX) * _sRowCol;
+						const std::ptrdiff_t pOffX = std::ptrdiff_t( KX * _cpParms.sDilationW ) - std::ptrdiff_t( _cpParms.sPadW );
+						size_t sLo, sHi;
+						ValidRange( pOffX, _cpParms.sStrideW, _csShape.sW, _csShape.sOw, sLo, sHi );
+						for ( size_t Y = 0; Y < _csShape.sOh; ++Y ) {
+							_tScalar * psDst = psRow + Y * _csShape.sOw;
+							const std::ptrdiff_t pY = std::ptrdiff_t( Y * _cpParms.sStrideH + KY * _cpParms.sDilationH ) - std::ptrdiff_t( _cpParms.sPadH );
+							if ( pY < 0 || pY >= std::ptrdiff_t( _csShape.sH ) || sLo == sHi ) {
+								std::fill( psDst, psDst + _csShape.sOw, _tScalar( 0 ) );
+								continue;
+							}
+							std::fill( psDst, psDst + sLo, _tScalar( 0 ) );
+							const _tType * ptSrc = ptIn + C * vStrides[1] + size_t( pY ) * vStrides[2] + size_t( std::ptrdiff_t( sLo * _cpParms.sStrideW ) + pOffX ) * vStrides[3];
+							if ( std::is_same<_tType, _tScalar>::value && sStepX == 1 ) {
+								std::copy( ptSrc, ptSrc + (sHi - sLo), psDst + sLo );
+							}
+							else {
+								for ( size_t X = sLo; X < sHi; ++X ) { psDst[X] = static_cast<_tScalar>(ptSrc[(X-sLo)*sStepX]); }
+							}
+							std::fill( psDst + sHi, psDst + _csShape.sOw, _tScalar( 0 ) );
+						}
+					}
+				}
+			}
+		}
+
+		/**
+		 * Folds a [K, Oh * Ow] matrix of 1 image and group back into a contiguous [Cg, H, W] image, summing the values that overlap.  This is
+		 *	the transpose of Im2Col().
+		 *
+		 * \tparam _tScalar The internal type.
+		 * \param _csShape The sizes of the convolution.
+		 * \param _cpParms The convolution parameters.
+		 * \param _psCol The contiguous matrix.
+		 * \param _psImg The image to which the values are added.
+		 **/
+		template <typename _tScalar>
+		static void													Col2Im( const NN9_CONV2D_SHAPE &_csShape, const NN9_CONV2D_PARAMS &_cpParms, const _tScalar * _psCol, _tScalar * _psImg ) {
+			const size_t sOhw = _csShape.sOh * _csShape.sOw;
+			for ( size_t C = 0; C < _csShape.sCg; ++C ) {
+				_tScalar * psPlane = _psImg + C * _csShape.sH * _csShape.sW;
+				for ( size_t KY = 0; KY < _csShape.sKh; ++KY ) {
+					for ( size_t KX = 0; KX < _csShape.sKw; ++KX ) {
+						const _tScalar * psRow = _psCol + ((C * _csShape.sKh + KY) * _csShape.sKw + KX) * sOhw;
+						const std::ptrdiff_t pOffX = std::ptrdiff_t( KX * _cpParms.sDilationW ) - std::ptrdiff_t( _cpParms.sPadW );
+						size_t sLo, sHi;
+						ValidRange( pOffX, _cpParms.sStrideW, _csShape.sW, _csShape.sOw, sLo, sHi );
+						for ( size_t Y = 0; Y < _csShape.sOh; ++Y ) {
+							const std::ptrdiff_t pY = std::ptrdiff_t( Y * _cpParms.sStrideH + KY * _cpParms.sDilationH ) - std::ptrdiff_t( _cpParms.sPadH );
+							if ( pY < 0 || pY >= std::ptrdiff_t( _csShape.sH ) ) { continue; }
+							_tScalar * psDst = psPlane + size_t( pY ) * _csShape.sW + size_t( std::ptrdiff_t( sLo * _cpParms.sStrideW ) + pOffX );
+							const _tScalar * psSrc = psRow + Y * _csShape.sOw;
+							for ( size_t X = sLo; X < sHi; ++X ) { psDst[(X-sLo)*_cpParms.sStrideW] += psSrc[X]; }
+						}
+					}
+				}
+			}
+		}
+
+		/**
+		 * The forward pass through unfolded patches and Gemm.  Each image and group is 1 task; every multiply also splits its own blocks, so
+		 *	large images are balanced by the pool as well.
+		 *
+		 * \tparam _tType The element type.
+		 * \tparam _tScalar The internal type.
+		 * \param _csShape The sizes of the convolution.
+		 * \param _cpParms The convolution parameters.
+		 * \param _svIn The input, [N, C, H, W].
+		 * \param _svWeights The weights, [O, C/Groups, Kh, Kw].
+		 * \param _vBias The bias, 1 value per output channel.
+		 * \param _svOut The output, [N, O, Oh, Ow].
+		 **/
+		template <typename _tType, typename _tScalar>
+		static void													ForwardIm2Col( const NN9_CONV2D_SHAPE &_csShape, const NN9_CONV2D_PARAMS &_cpParms, const StridedView<_tType> &_svIn,
+			const StridedView<_tType> &_svWeights, const std::vector<_tScalar> &_vBias, StridedView<_tType> &_svOut ) {
+			const std::vector<_tScalar> vWeights = GatherWeights<_tScalar>( _csShape, _svWeights );
+			const size_t sOhw = _csShape.sOh * _csShape.sOw;
+			const auto & vStridesI = _svIn.Strides();
+			const auto & vStridesO = _svOut.Strides();
+			constexpr bool bSame = std::is_same<_tType, _tScalar>::value;
+			// A 1x1 kernel multiplies the input itself when its pixels are evenly spaced.
+			const bool bInPlaceIn = bSame && IsUnitKernel( _csShape, _cpParms ) && Collapses( _svIn );
+			const bool bInPlaceOut = bSame && Collapses( _svOut );
+
+			auto aTasks = [&]( size_t _sBegin, size_t _sEnd ) {
+				std::vector<_tScalar> vCol, vOut;
+				for ( size_t T = _sBegin; T < _sEnd; ++T ) {
+					const size_t N = T / _cpParms.sGroups, G = T % _cpParms.sGroups;
+					const _tScalar * psB = nullptr;
+					size_t sRowB = 0, sColB = 0;
+					if constexpr ( bSame ) {
+						if ( bInPlaceIn ) {
+							psB = _svIn.Data() + N * vStridesI[0] + G * _csShape.sCg * vStridesI[1];
+							sRowB = vStridesI[1];
+							sColB = vStridesI[3];
+						}
+					}
+					if ( !bInPlaceIn ) {
+						vCol.resize( _csShape.sK * sOhw );
+						Im2Col( _csShape, _cpParms, _svIn, N, G, vCol.data(), sOhw );
+						psB = vCol.data();
+						sRowB = sOhw;
+						sColB = 1;
+					}
+
+					const _tScalar * psW = vWeights.data() + G * _csShape.sOg * _csShape.sK;
+					const _tScalar * psBias = _vBias.data() + G * _csShape.sOg;
+					if constexpr ( bSame ) {
+						if ( bInPlaceOut ) {
+							_tScalar * psOut = _svOut.Data() + N * vStridesO[0] + G * _csShape.sOg * vStridesO[1];
+							Gemm::Run<_tScalar>( _csShape.sOg, sOhw, _csShape.sK, psW, _csShape.sK, 1, psB, sRowB, sColB, psOut, vStridesO[1], vStridesO[3] );
+							for ( size_t O = 0; O < _csShape.sOg; ++O ) {
+								if ( psBias[O] == _tScalar( 0 ) ) { continue; }
+								_tScalar * psRow = psOut + O * vStridesO[1];
+								for ( size_t P = 0; P < sOhw; ++P ) { psRow[P*vStridesO[3]] += psBias[O]; }
+							}
+							continue;
+						}
+					}
+					vOut.resize( _csShape.sOg * sOhw );
+					Gemm::Run<_tScalar>( _csShape.sOg, sOhw, _csShape.sK, psW, _csShape.sK, 1, psB, sRowB, sColB, vOut.data(), sOhw, 1 );
+					for ( size_t O = 0; O < _csShape.sOg; ++O ) {
+						_tType * ptPlane = _svOut.Data() + N * vStridesO[0] + (G * _csShape.sOg + O) * vStridesO[1];
+						const _tScalar * psRow = vOut.data() + O * sOhw;
+						for ( size_t Y = 0; Y < _csShape.sOh; ++Y ) {
+							for ( size_t X = 0; X < _csShape.sOw; ++X ) {
+								ptPlane[Y*vStridesO[2]+X*vStridesO[3]] = static_cast<_tType>(_tScalar( psRow[Y*_csShape.sOw+X] + psBias[O] ));
+							}
+						}
+					}
+				}
+			};
+			const size_t sTasks = _csShape.sN * _cpParms.sGroups;
+			if ( sTasks > 1 ) { ThreadPool::Global().ParallelFor( 0, sTasks, 1, aTasks ); }
+			else { aTasks( 0, sTasks ); }
+		}
+
+		/**
+		 * The forward pass over channel-blocked copies of the input and weights.  The input is copied to [N, Groups, Cb, H + 2 * PadH,
+		 *	W + 2 * PadW, Lanes], with zeros in the padding and in the unused channels of the last block, and the weights to [Groups, Ob, Cb, Kh,
+		 *	Kw, Lanes (input), Lanes (output)].  Each task then produces whole rows of output pixels for 1 block of output channels.
+		 *
+		 * \tparam _tIsa The register traits.
+		 * \tparam _tType The element type.
+		 * \param _csShape The sizes of the convolution.
+		 * \param _cpParms The convolution parameters.
+		 * \param _svIn The input, [N, C, H, W].
+		 * \param _svWeights The weights, [O, C/Groups, Kh, Kw].
+		 * \param _vBias The bias, 1 value per output channel.
+		 * \param _svOut The output, [N, O, Oh, Ow].
+		 **/
+		template <typename _tIsa, typename _tType>
+		static void													ForwardDirect( const NN9_CONV2D_SHAPE &_csShape, const NN9_CONV2D_PARAMS &_cpParms, const StridedView<_tType> &_svIn,
+			const StridedView<_tType> &_svWeights, const std::vector<typename _tIsa::Scalar> &_vBias, StridedView<_tType> &_svOut ) {
+			using Scalar = typename _tIsa::Scalar;
+			constexpr size_t sLanes = _tIsa::Lanes;
+			const size_t sGroups = _cpParms.sGroups;
+			const size_t sCb = (_csShape.sCg + sLanes - 1) / sLanes;
+			const size_t sOb = (_csShape.sOg + sLanes - 1) / sLanes;
+			const size_t sHp = _csShape.sH + 2 * _cpParms.sPadH;
+			const size_t sWp = _csShape.sW + 2 * _cpParms.sPadW;
+			const size_t sBlockIn = sHp * sWp * sLanes;
+			const size_t sBlockW = _csShape.sKh * _csShape.sKw * sLanes * sLanes;
+			ThreadPool & tpPool = ThreadPool::Global();
+
+			// Block the input.
+			PackBuffer<Scalar> vIn( _csShape.sN * sGroups * sCb * sBlockIn );
+			const auto & vStridesI = _svIn.Strides();
+			auto aBlockIn = [&]( size_t _sBegin, size_t _sEnd ) {
+				for ( size_t B = _sBegin; B < _sEnd; ++B ) {
+					const size_t N = B / (sGroups * sCb), CB = B % sCb;
+					const size_t C0 = (B / sCb % sGroups) * _csShape.sCg + CB * sLanes;
+					const size_t sChannels = std::min( sLanes, _csShape.sCg - CB * sLanes );
+					Scalar * psBlock = vIn.data() + B * sBlockIn + (_cpParms.sPadH * sWp + _cpParms.sPadW) * sLanes;
+					for ( size_t L = 0; L < sChannels; ++L ) {
+						const _tType * ptPlane = _svIn.Data() + N * vStridesI[0] + (C0 + L) * vStridesI[1];
+						for ( size_t Y = 0; Y < _csShape.sH; ++Y ) {
+							const _tType * ptRow = ptPlane + Y * vStridesI[2];
+							Scalar * psRow = psBlock + Y * sWp * sLanes + L;
+							for ( size_t X = 0; X < _csShape.sW; ++X ) { psRow[X*sLanes] = static_cast<Scalar>(ptRow[X*vStridesI[3]]); }
+						}
+					}
+				}
+			};
+			const size_t sBlocksIn = _csShape.sN * sGroups * sCb;
+			if ( sBlocksIn > 1 ) { tpPool.ParallelFor( 0, sBlocksIn, 1, aBlockIn ); }
+			else { aBlockIn( 0, sBlocksIn ); }
+
+			// Block the weights.
+			PackBuffer<Scalar> vW( sGroups * sOb * sCb * sBlockW );
+			const auto & vStridesW = _svWeights.Strides();
+			for ( size_t G = 0; G < sGroups; ++G ) {
+				for ( size_t O = 0; O < _csShape.sOg; ++O ) {
+					for ( size_t C = 0; C < _csShape.sCg; ++C ) {
+						Scalar * psDst = vW.data() + ((G * sOb + O / sLanes) * sCb + C / sLanes) * sBlockW + (C % sLanes) * sLanes + (O % sLanes);
+						const _tType * ptSrc = _svWeights.Data() + (G * _csShape.sOg + O) * vStridesW[0] + C * vStridesW[1];
+						for ( size_t Y = 0; Y < _csShape.sKh; ++Y ) {
+							for ( size_t X = 0; X < _csShape.sKw; ++X ) {
+								psDst[(Y*_csShape.sKw+X)*sLanes*sLanes] = static_cast<Scalar>(ptSrc[Y*vStridesW[2]+X*vStridesW[3]]);
+							}
+						}
+					}
+				}
+			}
+
+			NN9_DIRECT_LAYOUT dlLayout;
+			dlLayout.sBlocks = sCb;
+			dlLayout.sLastLanes = _csShape.sCg - (sCb - 1) * sLanes;
+			dlLayout.sKh = _csShape.sKh;
+			dlLayout.sKw = _csShape.sKw;
+			dlLayout.sBlockIn = sBlockIn;
+			dlLayout.sTapY = _cpParms.sDilationH * sWp * sLanes;
+			dlLayout.sTapX = _cpParms.sDilationW * sLanes;
+			dlLayout.sPixel = _cpParms.sStrideW * sLanes;
+
+			// Each task is 1 row of output pixels for 1 block of output channels, ordered [N, Groups, Ob, Oh].
+			const auto & vStridesO = _svOut.Strides();
+			auto aRows = [&]( size_t _sBegin, size_t _sEnd ) {
+				NN9_ALIGN( 64 )
+				Scalar sTile[_tIsa::Cols*sLanes];
+				for ( size_t R = _sBegin; R < _sEnd; ++R ) {
+					const size_t Y = R % _csShape.sOh;
+					const size_t OB = R / _csShape.sOh % sOb;
+					const size_t G = R / (_csShape.sOh * sOb) % sGroups;
+					const size_t N = R / (_csShape.sOh * sOb * sGroups);
+					const Scalar * psIn = vIn.data() + (N * sGroups + G) * sCb * sBlockIn + Y * _cpParms.sStrideH * sWp * sLanes;
+					const Scalar * psW = vW.data() + (G * sOb + OB) * sCb * sBlockW;
+					const size_t O0 = G * _csShape.sOg + OB * sLanes;
+					const size_t sChannels = std::min( sLanes, _csShape.sOg - OB * sLanes );
+					_tType * ptOut = _svOut.Data() + N * vStridesO[0] + O0 * vStridesO[1] + Y * vStridesO[2];
+					for ( size_t X0 = 0; X0 < _csShape.sOw; X0 += _tIsa::Cols ) {
+						const size_t sCols = std::min( _tIsa::Cols, _csShape.sOw - X0 );
+						DirectTile<_tIsa>( sCols, dlLayout, psIn + X0 * dlLayout.sPixel, psW, sTile, std::make_index_sequence<_tIsa::Cols>() );
+						for ( size_t L = 0; L < sChannels; ++L ) {
+							_tType * ptRow = ptOut + L * vStridesO[1] + X0 * vStridesO[3];
+							const Scalar sBias = _vBias[O0+L];
+							for ( size_t X = 0; X < sCols; ++X ) { ptRow[X*vStridesO[3]] = static_cast<_tType>(Scalar( sTile[X*sLanes+L] + sBias )); }
+						}
+					}
+				}
+			};
+			const size_t sRows = _csShape.sN * sGroups * sOb * _csShape.sOh;
+			const size_t sRowFlops = _csShape.sOw * sLanes * _csShape.sCg * _csShape.sKh * _csShape.sKw;
+			const size_t sGrain = std::max<size_t>( 1, NN9_C_PARALLEL_FLOPS / std::max<size_t>( 1, sRowFlops ) );
+			if ( sRows > sGrain ) { tpPool.ParallelFor( 0, sRows, sGrain, aRows ); }
+			else { aRows( 0, sRows ); }
+		}
+
+		/**
+		 * Runs the direct kernel for a tile of up to Cols output pixels: the table's kernel for NN9_ISA_TABLE, or else the instantiation for
+		 *	the tile's width.
+		 *
+		 * \tparam _tIsa The register traits.
+		 * \tparam _sWidths The tile widths less 1, 0 to Cols - 1.
+		 * \param _sCols The number of output pixels in the tile, 1 to Cols.
+		 * \param _dlLayout The strides of the blocked buffers.
+		 * \param _psIn The blocked input at the first tap of the first pixel.
+		 * \param _psW The blocked weights of the output-channel block.
+		 * \param _psTile The output tile, [Cols, Lanes].
+		 **/
+		template <typename _tIsa, size_t ... _sWidths>
+		static inline void											DirectTile( size_t _sCols, const NN9_DIRECT_LAYOUT &_dlLayout, const typename _tIsa::Scalar * _psIn,
+			const typename _tIsa::Scalar * _psW, typename _tIsa::Scalar * _psTile, std::index_sequence<_sWidths...> ) {
+			using Scalar = typename _tIsa::Scalar;
+			if constexpr ( _tIsa::FromTable ) { _tIsa::Tile( _sCols, _dlLayout, _psIn, _psW, _psTile ); }
+			else {
+				typedef void (* PfTile)( const NN9_DIRECT_LAYOUT &, const Scalar *, const Scalar *, Scalar * );
+				static constexpr PfTile pfTiles[] = { &DirectKernel<_tIsa, _sWidths + 1>... };
+				pfTiles[_sCols-1]( _dlLayout, _psIn, _psW, _psTile );
+			}
+		}
+
+		/**
+		 * The direct kernel for a tile of _sCols output pixels.
+		 *
+		 * \tparam _tIsa The register traits.
+		 * \tparam _sCols The number of output pixels in the tile.
+		 * \param _dlLayout The strides of the blocked buffers.
+		 * \param _psIn The blocked input at the first tap of the first pixel.
+		 * \param _psW The blocked weights of the output-channel block.
+		 * \param _psTile The output tile, [_sCols, Lanes].
+		 **/
+		template <typename _tIsa, size_t _sCols>
+		static void													DirectKernel( const NN9_DIRECT_LAYOUT &_dlLayout, const typename _tIsa::Scalar * _psIn,
+			const typename _tIsa::Scalar * _psW, typename _tIsa::Scalar * _psTile ) {
+			DirectKernel<_tIsa>( _dlLayout, _psIn, _psW, _psTile, std::make_index_sequence<_sCols>() );
+		}
+
+		/**
+		 * The direct kernel for a tile of output pixels.  Each input value is broadcast and multiplied by a register of weights, 1 per output
+		 *	channel of the block, into the accumulator of its pixel.  The accumulators are expanded from an index sequence rather than looped
+		 *	over so that every compiler keeps them in registers.
+		 *
+		 * \tparam _tIsa The register traits.
+		 * \tparam _sIdx The pixel indices, 0 to the tile width - 1.
+		 * \param _dlLayout The strides of the blocked buffers.
+		 * \param _psIn The blocked input at the first tap of the first pixel.
+		 * \param _psW The blocked weights of the output-channel block.
+		 * \param _psTile The output tile, [width, Lanes].
+		 **/
+		template <typename _tIsa, size_t ... _sIdx>
+		static inline void											DirectKernel( const NN9_DIRECT_LAYOUT &_dlLayout, const typename _tIsa::Scalar * _psIn,
+			const typename _tIsa::Scalar * _psW, typename _tIsa::Scalar * _psTile, std::index_sequence<_sIdx...> ) {
+			using Reg = typename _tIsa::Reg;
+			constexpr size_t sLanes = _tIsa::Lanes;
+			const size_t sPixel = _dlLayout.sPixel;
+
+			Reg rAcc[sizeof...( _sIdx )] = { ((void)_sIdx, _tIsa::Zero())... };
+			for ( size_t B = 0; B < _dlLayout.sBlocks; ++B ) {
+				const size_t sChannels = B + 1 == _dlLayout.sBlocks ? _dlLayout.sLastLanes : sLanes;
+				for ( size_t KY = 0; KY < _dlLayout.sKh; ++KY ) {
+					for ( size_t KX = 0; KX < _dlLayout.sKw; ++KX ) {
+						const typename _tIsa::Scalar * psIn = _psIn + B * _dlLayout.sBlockIn + KY * _dlLayout.sTapY + KX * _dlLayout.sTapX;
+						const typename _tIsa::Scalar * psW = _psW + ((B * _dlLayout.sKh + KY) * _dlLayout.sKw + KX) * sLanes * sLanes;
+						for ( size_t L = 0; L < sChannels; ++L ) {
+							const Reg rW = _tIsa::Load( psW + L * sLanes );
+							((rAcc[_sIdx] = _tIsa::Fma( _tIsa::Set1( psIn[_sIdx*sPixel+L] ), rW, rAcc[_sIdx] )), ...);
+						}
+					}
+				}
+			}
+			(_tIsa::Store( _psTile + _sIdx * sLanes, rAcc[_sIdx] ), ...);
+		}
+	};
+
+}	// namespace nn9
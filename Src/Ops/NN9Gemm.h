@@ -0,0 +1,667 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Matrix multiplication.  A cache-blocked GEMM packs panels of both operands into contiguous buffers and runs them through
+ *	AVX-512, AVX2, or scalar micro-kernels, spreading the blocks over the ThreadPool.  bfloat16 operands can optionally be multiplied in
+ *	pairs with vdpbf16ps.
+ */
+
+#pragma once
+
+#include "../Foundation/NN9AlignmentAllocator.h"
+#include "../Foundation/NN9Intrin.h"
+#include "../Foundation/NN9Kernels.h"
+#include "NN9Bf16Dot.h"
+#include "../Tensor/NN9StridedView.h"
+#include "../Tensor/NN9Tensor.h"
+#include "../Types/NN9BFloat16.h"
+#include "../Types/NN9Float16.h"
+#include "../Types/NN9Types.h"
+#include "../Utilities/NN9ThreadPool.h"
+#include "../Utilities/NN9Utilities.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace nn9 {
+
+	/**
+	 * Class Gemm
+	 * \brief Matrix multiplication.
+	 *
+	 * Description: Matrix multiplication.  A cache-blocked GEMM packs panels of both operands into contiguous buffers and runs them through
+	 *	AVX-512, AVX2, or scalar micro-kernels, spreading the blocks over the ThreadPool.  Operands are addressed with a row stride and a
+	 *	column stride, so transposed and sliced matrices are multiplied without being copied first.  float16 and bfloat16 operands are
+	 *	widened to float while packing and accumulate in float.  bfloat16 operands can instead be packed as bfloat16 pairs and multiplied
+	 *	with vdpbf16ps (or its emulation; see Bf16Dot) by passing NN9_BK_NATIVE or NN9_BK_EMULATED to Run().
+	 */
+	class Gemm {
+	public :
+		// == Enumerations.
+		/** Blocking constants. */
+		enum NN9_GEMM : size_t {
+			NN9_G_KC							= 256,									/**< Depth of each packed panel.  A packed Mr x KC sliver of A stays in L1. */
+			NN9_G_MC_PANELS						= 16,									/**< Mr-row panels in each packed block of A.  The block stays in L2. */
+			NN9_G_NC							= 4096,									/**< Columns in each packed block of B.  The block stays in L3. */
+			NN9_G_PARALLEL_FLOPS				= 1 << 18,								/**< M * N * K below which a multiply runs on the calling thread. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Computes C = alpha * A * B + beta * C, where A is M x K, B is K x N, and C is M x N.  Each matrix is addressed by a row stride and a
+		 *	column stride in elements, so a transposed operand is passed by swapping its strides.  When beta is 0, C is not read.
+		 *
+		 * \tparam _tType The element type: float, double, bfloat16_t, or nn9::float16.
+		 * \param _sM The number of rows in A and C.
+		 * \param _sN The number of columns in B and C.
+		 * \param _sK The number of columns in A and rows in B.
+		 * \param _ptA The first element of A.
+		 * \param _sRowA The distance between rows of A.
+		 * \param _sColA The distance between columns of A.
+		 * \param _ptB The first element of B.
+		 * \param _sRowB The distance between rows of B.
+		 * \param _sColB The distance between columns of B.
+		 * \param _ptC The first element of C.
+		 * \param _sRowC The distance between rows of C.
+		 * \param _sColC The distance between columns of C.
+		 * \param _dAlpha The scale applied to A * B.
+		 * \param _dBeta The scale applied to the existing contents of C.
+		 * \param _bkKernel The bfloat16 kernel.  Ignored for other types.  NN9_BK_AUTO widens to float: vdpbf16ps does twice the work of an
+		 *	FMA but on current Intel cores issues at a quarter of the rate, so the float micro-kernels are faster once the operands are packed.
+		 **/
+		template <typename _tType>
+		static void													Run( size_t _sM, size_t _sN, size_t _sK,
+			const _tType * _ptA, size_t _sRowA, size_t _sColA,
+			const _tType * _ptB, size_t _sRowB, size_t _sColB,
+			_tType * _ptC, size_t _sRowC, size_t _sColC,
+			double _dAlpha = 1.0, double _dBeta = 0.0, Bf16Dot::NN9_BF16_KERNEL _bkKernel = Bf16Dot::NN9_BK_AUTO ) {
+			using Scalar = typename std::conditional<Types::Is64BitFloat<_tType>(), double, float>::type;
+			if ( !_sM || !_sN ) { return; }
+
+			if constexpr ( std::is_same<_tType, Scalar>::value ) {
+				Dispatch<_tType>( _sM, _sN, _sK, _ptA, _sRowA, _sColA, _ptB, _sRowB, _sColB, _ptC, _sRowC, _sColC,
+					Scalar( _dAlpha ), Scalar( _dBeta ) );
+			}
+			else {
+				// Accumulate into a float copy of C so that rounding to the narrow type happens once, after every K block.
+				std::vector<Scalar> vC( _sM * _sN );
+				if ( _dBeta != 0.0 ) {
+					for ( size_t I = 0; I < _sM; ++I ) {
+						for ( size_t J = 0; J < _sN; ++J ) { vC[I*_sN+J] = static_cast<Scalar>(_ptC[I*_sRowC+J*_sColC]); }
+					}
+				}
+				Dispatch<_tType>( _sM, _sN, _sK, _ptA, _sRowA, _sColA, _ptB, _sRowB, _sColB, vC.data(), _sN, 1,
+					Scalar( _dAlpha ), Scalar( _dBeta ), _bkKernel );
+				for ( size_t I = 0; I < _sM; ++I ) {
+					for ( size_t J = 0; J < _sN; ++J ) { _ptC[I*_sRowC+J*_sColC] = _tType( vC[I*_sN+J] ); }
+				}
+			}
+		}
+
+		/**
+		 * Multiplies the last 2 dimensions of A and B, treating any leading dimensions as a batch.  A is [..., M, K] ([..., K, M] if
+		 *	_bTransA), B is [..., K, N] ([..., N, K] if _bTransB), and _svOut is [..., M, N].  Batch dimensions are aligned on the right and
+		 *	each batch dimension of A and B must either match _svOut or be 1.
+		 *
+		 * \tparam _tType The element type: float, double, bfloat16_t, or nn9::float16.
+		 * \param _svA The left operand.
+		 * \param _svB The right operand.
+		 * \param _svOut The output.
+		 * \param _bTransA If true, the last 2 dimensions of A are used transposed.
+		 * \param _bTransB If true, the last 2 dimensions of B are used transposed.
+		 * \throw Throws if the shapes are not compatible or _svOut has overlapping elements.
+		 * \return Returns _svOut.
+		 **/
+		template <typename _tType>
+		static StridedView<_tType> &								MatMul( const StridedView<_tType> &_svA, const StridedView<_tType> &_svB, StridedView<_tType> &_svOut,
+			bool _bTransA = false, bool _bTransB = false ) {
+			const auto & vShapeA = _svA.Shape();
+			const auto & vShapeB = _svB.Shape();
+			const auto & vShapeO = _svOut.Shape();
+			if ( vShapeA.size() < 2 || vShapeB.size() < 2 || vShapeO.size() < 2 ) {
+				throw std::invalid_argument( "Gemm::MatMul: Operands must have at least 2 dimensions." );
+			}
+			if ( vShapeA.size() > vShapeO.size() || vShapeB.size() > vShapeO.size() ) {
+				throw std::invalid_argument( "Gemm::MatMul: Operands cannot have more dimensions than the output." );
+			}
+			if ( _svOut.Overlaps() ) {
+				throw std::invalid_argument( "Gemm::MatMul: Cannot write to an expanded view." );
+			}
+
+			// Row and column strides of each matrix.
+			const size_t sDimsA = vShapeA.size(), sDimsB = vShapeB.size(), sDimsO = vShapeO.size();
+			size_t sRowA = _svA.Strides()[sDimsA-2], sColA = _svA.Strides()[sDimsA-1];
+			size_t sM = vShapeA[sDimsA-2], sK = vShapeA[sDimsA-1];
+			if ( _bTransA ) { std::swap( sRowA, sColA ); std::swap( sM, sK ); }
+			size_t sRowB = _svB.Strides()[sDimsB-2], sColB = _svB.Strides()[sDimsB-1];
+			size_t sKB = vShapeB[sDimsB-2], sN = vShapeB[sDimsB-1];
+			if ( _bTransB ) { std::swap( sRowB, sColB ); std::swap( sKB, sN ); }
+			if ( sK != sKB || vShapeO[sDimsO-2] != sM || vShapeO[sDimsO-1] != sN ) {
+				throw std::invalid_argument( "Gemm::MatMul: Matrix dimensions do not agree." );
+			}
+
+			// Batch strides; a dimension of 1 in A or B is repeated with a stride of 0.
+			const size_t sBatchDims = sDimsO - 2;
+			std::vector<size_t> vBatchA( sBatchDims ), vBatchB( sBatchDims );
+			size_t sBatches = 1;
+			for ( size_t I = 0; I < sBatchDims; ++I ) {
+				const size_t sDim = vShapeO[I];
+				sBatches *= sDim;
+				if ( I + sDimsA >= sDimsO ) {
+					size_t sIdx = I + sDimsA - sDimsO;
+					if ( vShapeA[sIdx] != sDim && vShapeA[sIdx] != 1 ) { throw std::invalid_argument( "Gemm::MatMul: Batch dimensions of A cannot be broadcast to the output." ); }
+					vBatchA[I] = vShapeA[sIdx] == 1 ? 0 : _svA.Strides()[sIdx];
+				}
+				if ( I + sDimsB >= sDimsO ) {
+					size_t sIdx = I + sDimsB - sDimsO;
+					if ( vShapeB[sIdx] != sDim && vShapeB[sIdx] != 1 ) { throw std::invalid_argument( "Gemm::MatMul: Batch dimensions of B cannot be broadcast to the output." ); }
+					vBatchB[I] = vShapeB[sIdx] == 1 ? 0 : _svB.Strides()[sIdx];
+				}
+			}
+
+			auto aBatch = [&]( size_t _sBegin, size_t _sEnd ) {
+				for ( size_t B = _sBegin; B < _sEnd; ++B ) {
+					size_t sOffA = 0, sOffB = 0, sOffO = 0, sIdx = B;
+					for ( size_t I = sBatchDims; I--; ) {
+						size_t sThis = sIdx % vShapeO[I];
+						sIdx /= vShapeO[I];
+						sOffA += sThis * vBatchA[I];
+						sOffB += sThis * vBatchB[I];
+						sOffO += sThis * _svOut.Strides()[I];
+					}
+					Run<_tType>( sM, sN, sK, _svA.Data() + sOffA, sRowA, sColA, _svB.Data() + sOffB, sRowB, sColB,
+						_svOut.Data() + sOffO, _svOut.Strides()[sDimsO-2], _svOut.Strides()[sDimsO-1] );
+				}
+			};
+			// Each multiply also splits its own blocks, so batches and blocks are balanced by the pool together.
+			if ( sBatches > 1 ) { ThreadPool::Global().ParallelFor( 0, sBatches, 1, aBatch ); }
+			else { aBatch( 0, sBatches ); }
+			return _svOut;
+		}
+
+		/**
+		 * Multiplies the last 2 dimensions of A and B, treating any leading dimensions as a batch.  All 3 tensors must have the same type,
+		 *	which must be NN9_T_FLOAT, NN9_T_DOUBLE, NN9_T_BFLOAT16, or NN9_T_FLOAT16.
+		 *
+		 * \param _tA The left operand.
+		 * \param _tB The right operand.
+		 * \param _tOut The output.
+		 * \param _bTransA If true, the last 2 dimensions of A are used transposed.
+		 * \param _bTransB If true, the last 2 dimensions of B are used transposed.
+		 * \throw Throws if the types are not supported or do not match, or if the shapes are not compatible.
+		 * \return Returns _tOut.
+		 **/
+		static Tensor &												MatMul( Tensor &_tA, Tensor &_tB, Tensor &_tOut, bool _bTransA = false, bool _bTransB = false ) {
+			if ( _tA.Type() != _tB.Type() || _tA.Type() != _tOut.Type() ) {
+				throw std::invalid_argument( "Gemm::MatMul: All tensors must have the same type." );
+			}
+#define NN9_MATMUL( CASE, TYPE )																									\
+	case CASE : {																													\
+		auto svOut = _tOut.Strided<TYPE>();																							\
+		MatMul<TYPE>( _tA.Strided<TYPE>(), _tB.Strided<TYPE>(), svOut, _bTransA, _bTransB );										\
+		return _tOut;																												\
+	}
+			switch ( _tA.Type() ) {
+				NN9_MATMUL( NN9_T_FLOAT, float )
+				NN9_MATMUL( NN9_T_DOUBLE, double )
+				NN9_MATMUL( NN9_T_BFLOAT16, bfloat16_t )
+				NN9_MATMUL( NN9_T_FLOAT16, nn9::float16 )
+				default : {
+					throw std::invalid_argument( "Gemm::MatMul: Unsupported tensor type." );
+				}
+			}
+#undef NN9_MATMUL
+		}
+
+
+	protected :
+		// == Types.
+		/**
+		 * Scalar micro-kernel registers.  Every ISA provides the same members so that one micro-kernel serves them all.  Packed is the type
+		 *	that slivers of A and B are packed into and KPair is the number of consecutive k values that are multiplied by each step.
+		 */
+		template <typename _tScalar>
+		struct NN9_ISA_SCALAR {
+			typedef _tScalar								Scalar;
+			typedef _tScalar								Reg;
+			static constexpr size_t							Lanes = 1;
+			static constexpr size_t							Mr = 4;
+			static constexpr size_t							Nv = 4;
+			typedef Scalar									Packed;
+			static constexpr size_t							KPair = 1;
+			static constexpr bool							FromTable = false;
+
+			static inline Reg								Zero() { return Reg( 0 ); }
+			static inline Reg								Set1( Scalar _sVal ) { return _sVal; }
+			static inline Reg								Load( const Scalar * _psSrc ) { return (*_psSrc); }
+			static inline void								Store( Scalar * _psDst, Reg _rVal ) { (*_psDst) = _rVal; }
+			static inline Reg								Mul( Reg _rA, Reg _rB ) { return _rA * _rB; }
+			static inline Reg								Fma( Reg _rA, Reg _rB, Reg _rC ) { return _rA * _rB + _rC; }
+		};
+
+		/**
+		 * Micro-kernels from Kernels::Table().  Each full tile goes to the table's pfGemmF32 or pfGemmF64; the members of NN9_ISA_SCALAR
+		 *	serve nothing else.  Lanes is 1 and Nv is the width of the tile so that Blocked() packs B as the table's kernels expect.
+		 *
+		 * \tparam _tScalar The accumulation type (float or double).
+		 * \tparam _sMr The rows in a tile.
+		 * \tparam _sNr The columns in a tile.
+		 */
+		template <typename _tScalar, size_t _sMr, size_t _sNr>
+		struct NN9_ISA_TABLE : public NN9_ISA_SCALAR<_tScalar> {
+			static constexpr size_t							Mr = _sMr;
+			static constexpr size_t							Nv = _sNr;
+			static constexpr bool							FromTable = true;
+
+			/**
+			 * Computes a full tile with the table's kernel.
+			 *
+			 * \param _sSteps The depth of the slivers.
+			 * \param _psA The packed sliver of A.
+			 * \param _psB The packed sliver of B.
+			 * \param _psC The top-left element of the tile of C.
+			 * \param _sRowC The distance between rows of C.
+			 * \param _sAlpha The scale applied to A * B.
+			 * \param _sBeta The scale applied to the existing contents of C.
+			 **/
+			static inline void								Tile( size_t _sSteps, const _tScalar * _psA, const _tScalar * _psB, _tScalar * _psC, size_t _sRowC,
+				_tScalar _sAlpha, _tScalar _sBeta ) {
+				if constexpr ( std::is_same<_tScalar, double>::value ) { Kernels::Table().pfGemmF64( _sSteps, _psA, _psB, _psC, _sRowC, _sAlpha, _sBeta ); }
+				else { Kernels::Table().pfGemmF32( _sSteps, _psA, _psB, _psC, _sRowC, _sAlpha, _sBeta ); }
+			}
+		};
+
+		/**
+		 * bfloat16 pair micro-kernels from Kernels::Table().  A and B are packed as by NN9_ISA_BF16 and each full tile goes to the table's
+		 *	pfGemmBf16.
+		 *
+		 * \tparam _sMr The rows in a tile.
+		 * \tparam _sNr The columns in a tile.
+		 * \tparam _kpKernel The pair kernel.
+		 */
+		template <size_t _sMr, size_t _sNr, Kernels::NN9_KERNEL_BF16 _kpKernel>
+		struct NN9_ISA_TABLE_BF16 : public NN9_ISA_TABLE<float, _sMr, _sNr> {
+			typedef bfloat16_t								Packed;
+			static constexpr size_t							KPair = 2;
+
+			/**
+			 * Computes a full tile with the table's kernel.
+			 *
+			 * \param _sSteps The depth of the slivers divided by KPair.
+			 * \param _ppA The packed sliver of A.
+			 * \param _ppB The packed sliver of B.
+			 * \param _pfC The top-left element of the tile of C.
+			 * \param _sRowC The distance between rows of C.
+			 * \param _fAlpha The scale applied to A * B.
+			 * \param _fBeta The scale applied to the existing contents of C.
+			 **/
+			static inline void								Tile( size_t _sSteps, const Packed * _ppA, const Packed * _ppB, float * _pfC, size_t _sRowC,
+				float _fAlpha, float _fBeta ) {
+				Kernels::Table().pfGemmBf16[_kpKernel]( _sSteps, reinterpret_cast<const uint16_t *>(_ppA), reinterpret_cast<const uint16_t *>(_ppB),
+					_pfC, _sRowC, _fAlpha, _fBeta );
+			}
+		};
+
+		/**
+		 * bfloat16 pair micro-kernel.  A and B are packed as bfloat16 with each pair of consecutive k values together, so that each step
+		 *	broadcasts 1 pair of A and multiplies it by Lanes pairs of B with a Bf16Dot pair kernel.  C is handled as by the float ISA.
+		 *
+		 * \tparam _tIsa The float ISA whose registers and tile size are used.
+		 * \tparam _tPairs The Bf16Dot pair kernel.
+		 */
+		template <typename _tIsa, typename _tPairs>
+		struct NN9_ISA_BF16 : public _tIsa {
+			typedef bfloat16_t								Packed;
+			typedef typename _tPairs::Pairs					Operand;
+			static constexpr size_t							KPair = 2;
+
+			static inline Operand							LoadOperand( const Packed * _ppSrc ) { return _tPairs::Load( _ppSrc ); }
+			static inline Operand							Set1Operand( const Packed * _ppSrc ) { return _tPairs::Set1( _ppSrc ); }
+			static inline typename _tIsa::Reg				Dot( Operand _oA, Operand _oB, typename _tIsa::Reg _rAcc ) { return _tPairs::Dp( _rAcc, _oA, _oB ); }
+		};
+
+		/** A 64-byte-aligned packing buffer. */
+		template <typename _tScalar>
+		using PackBuffer = std::vector<_tScalar, AlignmentAllocator<_tScalar, 64>>;
+
+
+		// == Functions.
+		/**
+		 * Selects the micro-kernel for the running CPU and runs the blocked multiply.
+		 *
+		 * \tparam _tType The element type of A and B.
+		 * \tparam _tScalar The accumulation type (float or double).
+		 * \param _sM The number of rows in A and C.
+		 * \param _sN The number of columns in B and C.
+		 * \param _sK The number of columns in A and rows in B.
+		 * \param _ptA The first element of A.
+		 * \param _sRowA The distance between rows of A.
+		 * \param _sColA The distance between columns of A.
+		 * \param _ptB The first element of B.
+		 * \param _sRowB The distance between rows of B.
+		 * \param _sColB The distance between columns of B.
+		 * \param _psC The first element of C.
+		 * \param _sRowC The distance between rows of C.
+		 * \param _sColC The distance between columns of C.
+		 * \param _sAlpha The scale applied to A * B.
+		 * \param _sBeta The scale applied to the existing contents of C.
+		 * \param _bkKernel The bfloat16 kernel.  Ignored for other types.
+		 **/
+		template <typename _tType, typename _tScalar>
+		static void													Dispatch( size_t _sM, size_t _sN, size_t _sK,
+			const _tType * _ptA, size_t _sRowA, size_t _sColA,
+			const _tType * _ptB, size_t _sRowB, size_t _sColB,
+			_tScalar * _psC, size_t _sRowC, size_t _sColC,
+			_tScalar _sAlpha, _tScalar _sBeta, Bf16Dot::NN9_BF16_KERNEL _bkKernel = Bf16Dot::NN9_BK_AUTO ) {
+			if constexpr ( std::is_same<_tType, bfloat16_t>::value ) {
+				const Bf16Dot::NN9_BF16_KERNEL bkKernel = Bf16Dot::Resolve( _bkKernel == Bf16Dot::NN9_BK_AUTO ? Bf16Dot::NN9_BK_WIDEN : _bkKernel );
+				// NN9_BK_WIDEN falls through to the float micro-kernels below.  The native tile exists only with the AVX-512 tile size; without
+				//	it, NN9_BK_NATIVE runs the emulation, which gives the same bits.
+				if ( bkKernel == Bf16Dot::NN9_BK_NATIVE && Kernels::Table().pfGemmBf16[Kernels::NN9_KP_NATIVE] ) {
+					using Isa = NN9_ISA_TABLE_BF16<Kernels::NN9_KG_AVX512_MR, Kernels::NN9_KG_AVX512_NR_F32, Kernels::NN9_KP_NATIVE>;
+					return Blocked<Isa>( _sM, _sN, _sK, _ptA, _sRowA, _sColA, _ptB, _sRowB, _sColB, _psC, _sRowC, _sColC, _sAlpha, _sBeta );
+				}
+				if ( bkKernel == Bf16Dot::NN9_BK_EMULATED || bkKernel == Bf16Dot::NN9_BK_NATIVE ) {
+					switch ( Kernels::Table().kiGemm ) {
+						case Kernels::NN9_KI_AVX512 : {
+							using Isa = NN9_ISA_TABLE_BF16<Kernels::NN9_KG_AVX512_MR, Kernels::NN9_KG_AVX512_NR_F32, Kernels::NN9_KP_EMULATED>;
+							return Blocked<Isa>( _sM, _sN, _sK, _ptA, _sRowA, _sColA, _ptB, _sRowB, _sColB, _psC, _sRowC, _sColC, _sAlpha, _sBeta );
+						}
+						case Kernels::NN9_KI_AVX2 : {
+							using Isa = NN9_ISA_TABLE_BF16<Kernels::NN9_KG_AVX2_MR, Kernels::NN9_KG_AVX2_NR_F32, Kernels::NN9_KP_EMULATED>;
+							return Blocked<Isa>( _sM, _sN, _sK, _ptA, _sRowA, _sColA, _ptB, _sRowB, _sColB, _psC, _sRowC, _sColC, _sAlpha, _sBeta );
+						}
+						default : {}
+					}
+					return Blocked<NN9_ISA_BF16<NN9_ISA_SCALAR<float>, Bf16Dot::NN9_SCALAR_PAIRS<true>>>( _sM, _sN, _sK, _ptA, _sRowA, _sColA, _ptB, _sRowB, _sColB, _psC, _sRowC, _sColC, _sAlpha, _sBeta );
+				}
+			}
+
+			switch ( Kernels::Table().kiGemm ) {
+				case Kernels::NN9_KI_AVX512 : {
+					using Isa = NN9_ISA_TABLE<_tScalar, Kernels::NN9_KG_AVX512_MR,
+						std::is_same<_tScalar, double>::value ? Kernels::NN9_KG_AVX512_NR_F64 : Kernels::NN9_KG_AVX512_NR_F32>;
+					return Blocked<Isa>( _sM, _sN, _sK, _ptA, _sRowA, _sColA, _ptB, _sRowB, _sColB, _psC, _sRowC, _sColC, _sAlpha, _sBeta );
+				}
+				case Kernels::NN9_KI_AVX2 : {
+					using Isa = NN9_ISA_TABLE<_tScalar, Kernels::NN9_KG_AVX2_MR,
+						std::is_same<_tScalar, double>::value ? Kernels::NN9_KG_AVX2_NR_F64 : Kernels::NN9_KG_AVX2_NR_F32>;
+					return Blocked<Isa>( _sM, _sN, _sK, _ptA, _sRowA, _sColA, _ptB, _sRowB, _sColB, _psC, _sRowC, _sColC, _sAlpha, _sBeta );
+				}
+				default : {}
+			}
+
+			return Blocked<NN9_ISA_SCALAR<_tScalar>>( _sM, _sN, _sK, _ptA, _sRowA, _sColA, _ptB, _sRowB, _sColB, _psC, _sRowC, _sColC, _sAlpha, _sBeta );
+		}
+
+		/**
+		 * The blocked multiply.  For each NC-column block of B and each KC-deep slice of K, the slice of B is packed once and shared; the M
+		 *	rows and the NC columns are then split into tasks, each of which packs its own block of A and runs the micro-kernel over it.
+		 *
+		 * \tparam _tIsa The micro-kernel ISA.
+		 * \tparam _tType The element type of A and B.
+		 * \param _sM The number of rows in A and C.
+		 * \param _sN The number of columns in B and C.
+		 * \param _sK The number of columns in A and rows in B.
+		 * \param _ptA The first element of A.
+		 * \param _sRowA The distance between rows of A.
+		 * \param _sColA The distance between columns of A.
+		 * \param _ptB The first element of B.
+		 * \param _sRowB The distance between rows of B.
+		 * \param _sColB The distance between columns of B.
+		 * \param _psC The first element of C.
+		 * \param _sRowC The distance between rows of C.
+		 * \param _sColC The distance between columns of C.
+		 * \param _sAlpha The scale applied to A * B.
+		 * \param _sBeta The scale applied to the existing contents of C.
+		 **/
+		template <typename _tIsa, typename _tType>
+		static void													Blocked( size_t _sM, size_t _sN, size_t _sK,
+			const _tType * _ptA, size_t _sRowA, size_t _sColA,
+			const _tType * _ptB, size_t _sRowB, size_t _sColB,
+			typename _tIsa::Scalar * _psC, size_t _sRowC, size_t _sColC,
+			typename _tIsa::Scalar _sAlpha, typename _tIsa::Scalar _sBeta ) {
+			using Scalar = typename _tIsa::Scalar;
+			using Packed = typename _tIsa::Packed;
+			constexpr size_t sMr = _tIsa::Mr;
+			constexpr size_t sNr = _tIsa::Nv * _tIsa::Lanes;
+			constexpr size_t sMc = sMr * NN9_G_MC_PANELS;
+			constexpr size_t sNc = (NN9_G_NC / sNr) * sNr;
+
+			if ( !_sK ) {
+				for ( size_t I = 0; I < _sM; ++I ) {
+					for ( size_t J = 0; J < _sN; ++J ) {
+						Scalar & sC = _psC[I*_sRowC+J*_sColC];
+						sC = _sBeta == Scalar( 0 ) ? Scalar( 0 ) : sC * _sBeta;
+					}
+				}
+				return;
+			}
+
+			ThreadPool & tpPool = ThreadPool::Global();
+			const bool bParallel = tpPool.Size() && double( _sM ) * double( _sN ) * double( _sK ) > double( NN9_G_PARALLEL_FLOPS );
+			PackBuffer<Packed> vPackB( RoundUp( std::min<size_t>( _sK, NN9_G_KC ), _tIsa::KPair ) * ((std::min( _sN, sNc ) + sNr - 1) / sNr) * sNr );
+
+			for ( size_t JC = 0; JC < _sN; JC += sNc ) {
+				const size_t sNcThis = std::min( sNc, _sN - JC );
+				const size_t sPanelsB = (sNcThis + sNr - 1) / sNr;
+				for ( size_t PC = 0; PC < _sK; PC += NN9_G_KC ) {
+					const size_t sKc = std::min<size_t>( NN9_G_KC, _sK - PC );
+					// Packed depth; an odd K is padded with a 0 for the pair kernels.
+					const size_t sKp = RoundUp( sKc, _tIsa::KPair );
+					const Scalar sBeta = PC == 0 ? _sBeta : Scalar( 1 );
+
+					auto aPackB = [&]( size_t _sBegin, size_t _sEnd ) {
+						for ( size_t P = _sBegin; P < _sEnd; ++P ) {
+							const size_t sCol = JC + P * sNr;
+							PackB<sNr, _tIsa::KPair>( sKc, std::min( sNr, _sN - sCol ), _ptB + PC * _sRowB + sCol * _sColB, _sRowB, _sColB, vPackB.data() + P * sNr * sKp );
+						}
+					};
+					if ( bParallel ) { tpPool.ParallelFor( 0, sPanelsB, 0, aPackB ); }
+					else { aPackB( 0, sPanelsB ); }
+
+					// Split the columns further when there are too few row blocks to keep every thread busy.
+					const size_t sBlocksM = (_sM + sMc - 1) / sMc;
+					size_t sSplitsN = 1;
+					if ( bParallel ) {
+						const size_t sWanted = tpPool.Size() * 2;
+						sSplitsN = std::min( sPanelsB, std::max<size_t>( 1, (sWanted + sBlocksM - 1) / sBlocksM ) );
+					}
+					const size_t sPanelsPerSplit = (sPanelsB + sSplitsN - 1) / sSplitsN;
+					sSplitsN = (sPanelsB + sPanelsPerSplit - 1) / sPanelsPerSplit;
+
+					auto aTask = [&]( size_t _sBegin, size_t _sEnd ) {
+						thread_local PackBuffer<Packed> vPackA;
+						vPackA.resize( sMc * NN9_G_KC );
+						NN9_ALIGN( 64 )
+						Scalar sTile[sMr*sNr];
+						for ( size_t T = _sBegin; T < _sEnd; ++T ) {
+							const size_t IC = (T / sSplitsN) * sMc;
+							const size_t sMcThis = std::min( sMc, _sM - IC );
+							const size_t sPanelStart = (T % sSplitsN) * sPanelsPerSplit;
+							const size_t sPanelEnd = std::min( sPanelsB, sPanelStart + sPanelsPerSplit );
+							for ( size_t IR = 0; IR < sMcThis; IR += sMr ) {
+								PackA<sMr, _tIsa::KPair>( sKc, std::min( sMr, sMcThis - IR ), _ptA + (IC + IR) * _sRowA + PC * _sColA, _sRowA, _sColA, vPackA.data() + IR * sKp );
+							}
+							for ( size_t P = sPanelStart; P < sPanelEnd; ++P ) {
+								const size_t sCol = JC + P * sNr;
+								const size_t sNrThis = std::min( sNr, _sN - sCol );
+								const Packed * ppB = vPackB.data() + P * sNr * sKp;
+								for ( size_t IR = 0; IR < sMcThis; IR += sMr ) {
+									const size_t sMrThis = std::min( sMr, sMcThis - IR );
+									Scalar * psC = _psC + (IC + IR) * _sRowC + sCol * _sColC;
+									const Packed * ppA = vPackA.data() + IR * sKp;
+									if ( sMrThis == sMr && sNrThis == sNr && _sColC == 1 ) {
+										MicroKernel<_tIsa>( sKp / _tIsa::KPair, ppA, ppB, psC, _sRowC, _sAlpha, sBeta );
+									}
+									else {
+										// Edge tiles and strided outputs go through a local tile.
+										MicroKernel<_tIsa>( sKp / _tIsa::KPair, ppA, ppB, sTile, sNr, _sAlpha, Scalar( 0 ) );
+										for ( size_t I = 0; I < sMrThis; ++I ) {
+											for ( size_t J = 0; J < sNrThis; ++J ) {
+												Scalar & sC = psC[I*_sRowC+J*_sColC];
+												sC = sBeta == Scalar( 0 ) ? sTile[I*sNr+J] : sTile[I*sNr+J] + sBeta * sC;
+											}
+										}
+									}
+								}
+							}
+						}
+					};
+					const size_t sTasks = sBlocksM * sSplitsN;
+					if ( bParallel ) { tpPool.ParallelFor( 0, sTasks, 1, aTask ); }
+					else { aTask( 0, sTasks ); }
+				}
+			}
+		}
+
+		/**
+		 * Packs an Mr-row sliver of A into column-major order (Mr groups of KPair values per group of KPair k values), converting to the
+		 *	packed type and padding missing rows and the missing k value of an odd final pair with 0.
+		 *
+		 * \tparam _sMr The rows in a sliver.
+		 * \tparam _sKPair The consecutive k values kept together.
+		 * \tparam _tType The element type of A.
+		 * \tparam _tScalar The packed type.
+		 * \param _sK The number of columns to pack.
+		 * \param _sRows The number of valid rows (at most _sMr).
+		 * \param _ptA The first element of the sliver.
+		 * \param _sRowA The distance between rows of A.
+		 * \param _sColA The distance between columns of A.
+		 * \param _psDst The packed output.
+		 **/
+		template <size_t _sMr, size_t _sKPair, typename _tType, typename _tScalar>
+		static void													PackA( size_t _sK, size_t _sRows, const _tType * _ptA, size_t _sRowA, size_t _sColA, _tScalar * _psDst ) {
+			if ( _sRows < _sMr || _sK % _sKPair ) {
+				std::fill( _psDst, _psDst + RoundUp( _sK, _sKPair ) * _sMr, _tScalar( 0 ) );
+			}
+			for ( size_t I = 0; I < _sRows; ++I ) {
+				const _tType * ptRow = _ptA + I * _sRowA;
+				for ( size_t K = 0; K < _sK; ++K ) { _psDst[(K/_sKPair)*_sMr*_sKPair+I*_sKPair+K%_sKPair] = static_cast<_tScalar>(ptRow[K*_sColA]); }
+			}
+		}
+
+		/**
+		 * Packs an Nr-column sliver of B into row-major order (Nr groups of KPair values per group of KPair k values), converting to the
+		 *	packed type and padding missing columns and the missing k value of an odd final pair with 0.
+		 *
+		 * \tparam _sNr The columns in a sliver.
+		 * \tparam _sKPair The consecutive k values kept together.
+		 * \tparam _tType The element type of B.
+		 * \tparam _tScalar The packed type.
+		 * \param _sK The number of rows to pack.
+		 * \param _sCols The number of valid columns (at most _sNr).
+		 * \param _ptB The first element of the sliver.
+		 * \param _sRowB The distance between rows of B.
+		 * \param _sColB The distance between columns of B.
+		 * \param _psDst The packed output.
+		 **/
+		template <size_t _sNr, size_t _sKPair, typename _tType, typename _tScalar>
+		static void													PackB( size_t _sK, size_t _sCols, const _tType * _ptB, size_t _sRowB, size_t _sColB, _tScalar * _psDst ) {
+			if ( _sCols < _sNr || _sK % _sKPair ) {
+				std::fill( _psDst, _psDst + RoundUp( _sK, _sKPair ) * _sNr, _tScalar( 0 ) );
+			}
+			if ( _sColB == 1 ) {
+				for ( size_t K = 0; K < _sK; ++K ) {
+					const _tType * ptRow = _ptB + K * _sRowB;
+					_tScalar * psDst = _psDst + (K / _sKPair) * _sNr * _sKPair + K % _sKPair;
+					for ( size_t J = 0; J < _sCols; ++J ) { psDst[J*_sKPair] = static_cast<_tScalar>(ptRow[J]); }
+				}
+			}
+			else {
+				for ( size_t J = 0; J < _sCols; ++J ) {
+					const _tType * ptCol = _ptB + J * _sColB;
+					for ( size_t K = 0; K < _sK; ++K ) { _psDst[(K/_sKPair)*_sNr*_sKPair+J*_sKPair+K%_sKPair] = static_cast<_tScalar>(ptCol[K*_sRowB]); }
+				}
+			}
+		}
+
+		/**
+		 * Rounds a value up to a multiple of another.
+		 *
+		 * \param _sVal The value to round.
+		 * \param _sMultiple The multiple.
+		 * \return Returns the smallest multiple of _sMultiple not less than _sVal.
+		 **/
+		static inline constexpr size_t								RoundUp( size_t _sVal, size_t _sMultiple ) { return (_sVal + _sMultiple - 1) / _sMultiple * _sMultiple; }
+
+		/**
+		 * Computes a full Mr x Nr tile of C = alpha * A * B + beta * C from packed slivers.  C is row-major with unit column stride.  When
+		 *	beta is 0, C is not read.
+		 *
+		 * \tparam _tIsa The micro-kernel ISA.
+		 * \param _sSteps The depth of the slivers divided by KPair.
+		 * \param _ppA The packed sliver of A.
+		 * \param _ppB The packed sliver of B.
+		 * \param _psC The top-left element of the tile of C.
+		 * \param _sRowC The distance between rows of C.
+		 * \param _sAlpha The scale applied to A * B.
+		 * \param _sBeta The scale applied to the existing contents of C.
+		 **/
+		template <typename _tIsa>
+		static inline void											MicroKernel( size_t _sSteps, const typename _tIsa::Packed * _ppA, const typename _tIsa::Packed * _ppB,
+			typename _tIsa::Scalar * _psC, size_t _sRowC, typename _tIsa::Scalar _sAlpha, typename _tIsa::Scalar _sBeta ) {
+			if constexpr ( _tIsa::FromTable ) { _tIsa::Tile( _sSteps, _ppA, _ppB, _psC, _sRowC, _sAlpha, _sBeta ); }
+			else { MicroKernel<_tIsa>( _sSteps, _ppA, _ppB, _psC, _sRowC, _sAlpha, _sBeta, std::make_index_sequence<_tIsa::Mr * _tIsa::Nv>() ); }
+		}
+
+		/**
+		 * Computes a full Mr x Nr tile of C = alpha * A * B + beta * C from packed slivers.  The accumulators are expanded from an index
+		 *	sequence rather than looped over so that every compiler keeps them in registers.
+		 *
+		 * \tparam _tIsa The micro-kernel ISA.
+		 * \tparam _sIdx The accumulator indices, 0 to Mr * Nv - 1; accumulator I holds row I / Nv, register I % Nv.
+		 * \param _sSteps The depth of the slivers divided by KPair.
+		 * \param _ppA The packed sliver of A.
+		 * \param _ppB The packed sliver of B.
+		 * \param _psC The top-left element of the tile of C.
+		 * \param _sRowC The distance between rows of C.
+		 * \param _sAlpha The scale applied to A * B.
+		 * \param _sBeta The scale applied to the existing contents of C.
+		 **/
+		template <typename _tIsa, size_t ... _sIdx>
+		static inline void											MicroKernel( size_t _sSteps, const typename _tIsa::Packed * _ppA, const typename _tIsa::Packed * _ppB,
+			typename _tIsa::Scalar * _psC, size_t _sRowC, typename _tIsa::Scalar _sAlpha, typename _tIsa::Scalar _sBeta, std::index_sequence<_sIdx...> ) {
+			using Reg = typename _tIsa::Reg;
+			constexpr size_t sMr = _tIsa::Mr;
+			constexpr size_t sNv = _tIsa::Nv;
+			constexpr size_t sLanes = _tIsa::Lanes;
+			constexpr size_t sKPair = _tIsa::KPair;
+
+			Reg rAcc[sMr*sNv] = { ((void)_sIdx, _tIsa::Zero())... };
+			for ( size_t K = 0; K < _sSteps; ++K ) {
+				if constexpr ( sKPair == 1 ) {
+					Reg rB[sNv];
+					for ( size_t V = 0; V < sNv; ++V ) { rB[V] = _tIsa::Load( _ppB + V * sLanes ); }
+					((rAcc[_sIdx] = _tIsa::Fma( _tIsa::Set1( _ppA[_sIdx/sNv] ), rB[_sIdx%sNv], rAcc[_sIdx] )), ...);
+				}
+				else {
+					typename _tIsa::Operand oB[sNv];
+					for ( size_t V = 0; V < sNv; ++V ) { oB[V] = _tIsa::LoadOperand( _ppB + V * sLanes * sKPair ); }
+					((rAcc[_sIdx] = _tIsa::Dot( _tIsa::Set1Operand( _ppA + (_sIdx / sNv) * sKPair ), oB[_sIdx%sNv], rAcc[_sIdx] )), ...);
+				}
+				_ppA += sMr * sKPair;
+				_ppB += sNv * sLanes * sKPair;
+			}
+
+			Reg rAlpha = _tIsa::Set1( _sAlpha );
+			if ( _sBeta == 0 ) {
+				(_tIsa::Store( _psC + (_sIdx / sNv) * _sRowC + (_sIdx % sNv) * sLanes, _tIsa::Mul( rAcc[_sIdx], rAlpha ) ), ...);
+			}
+			else {
+				Reg rBeta = _tIsa::Set1( _sBeta );
+				(_tIsa::Store( _psC + (_sIdx / sNv) * _sRowC + (_sIdx % sNv) * sLanes,
+					_tIsa::Fma( _tIsa::Load( _psC + (_sIdx / sNv) * _sRowC + (_sIdx % sNv) * sLanes ), rBeta, _tIsa::Mul( rAcc[_sIdx], rAlpha ) ) ), ...);
+			}
+		}
+	};
+
+}	// namespace nn9
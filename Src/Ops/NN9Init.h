@@ -10,12 +10,15 @@
 
 #include "NN9Math.h"
 #include "../Foundation/NN9Intrin.h"
+#include "../Foundation/NN9Kernels.h"
 #include "../Types/NN9BFloat16.h"
 #include "../Types/NN9Float16.h"
 #include "../Types/NN9Types.h"
 #include "../Utilities/NN9Utilities.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <random>
 #include <stdexcept>
 #include <vector>
@@ -31,6 +34,12 @@ namespace nn9 {
 	 */
 	class Init {
 	public :
+		// == Enumerations.
+		/** Initialization constants. */
+		enum NN9_INIT : size_t {
+			NN9_I_RANDOM_BLOCK					= 1 << 16,								/**< Elements filled by each random generator; blocks are filled in parallel. */
+		};
+
 
 		// == Functions.
 		/**
@@ -46,13 +55,7 @@ namespace nn9 {
 		static _tType &												XavierInitialization( int _iFanIn, int _iFanOut, _tType &_vWeights ) {
 			double dLimit = std::sqrt( 6.0 / (_iFanIn + _iFanOut) );
 
-			std::random_device rdDev;
-			std::mt19937 mGen( rdDev() );
-			std::uniform_real_distribution<double> urdDis( -dLimit, dLimit );
-
-			for ( auto & fWeight : _vWeights ) {
-				fWeight = _tType::value_type( urdDis( mGen ) );
-			}
+			Fill( _vWeights, std::uniform_real_distribution<double>( -dLimit, dLimit ) );
 			return _vWeights;
 		}
 
@@ -68,13 +71,7 @@ namespace nn9 {
 		static _tType &												HeInitialization( int _iFanIn, _tType &_vWeights ) {
 			double dStdDev = std::sqrt( 2.0 / _iFanIn );
 
-			std::random_device rdDev;
-			std::mt19937 mGen( rdDev() );
-			std::normal_distribution<double> ndDis( 0.0, dStdDev );
-
-			for ( auto & fWeight : _vWeights ) {
-				fWeight = _tType::value_type( ndDis( mGen ) );
-			}
+			Fill( _vWeights, std::normal_distribution<double>( 0.0, dStdDev ) );
 			return _vWeights;
 		}
 
@@ -92,13 +89,7 @@ namespace nn9 {
 		static _tType &												LeCunInitialization( int _iFanIn, _tType &_vWeights ) {
 			double dStdDev = std::sqrt( 1.0 / _iFanIn );
 
-			std::random_device rdDev;
-			std::mt19937 mGen( rdDev() );
-			std::normal_distribution<double> ndDis( 0.0, dStdDev );
-
-			for ( auto & fWeight : _vWeights ) {
-				fWeight = _tType::value_type( ndDis( mGen ) );
-			}
+			Fill( _vWeights, std::normal_distribution<double>( 0.0, dStdDev ) );
 			return _vWeights;
 		}
 
@@ -122,14 +113,8 @@ namespace nn9 {
 				throw std::runtime_error("Size of _vWeights does not match _iRows*_iCols.");
 			}
 
-			std::random_device rdDev;
-			std::mt19937 mGen( rdDev() );
-			std::normal_distribution<double> ndDis( 0.0, 1.0 );
-
 			// Fill _vWeights with random values.
-			for ( auto & fWeight : _vWeights ) {
-				fWeight = _tType::value_type( ndDis( mGen ) );
-			}
+			Fill( _vWeights, std::normal_distribution<double>( 0.0, 1.0 ) );
 
 			// Reshape into matrix form (row-major)
 			// Compute QR decomposition to get orthogonal matrix
@@ -192,13 +177,7 @@ namespace nn9 {
 		 */
 		template <typename _tType>
 		static _tType &												UniformInitialization( double _dMin, double _dMax, _tType &_vWeights ) {
-			std::random_device rdDev;
-			std::mt19937 mGen( rdDev() );
-			std::uniform_real_distribution<double> urdDis( _dMin, _dMax );
-
-			for ( auto & fWeight : _vWeights ) {
-				fWeight = _tType::value_type( urdDis( mGen ) );
-			}
+			Fill( _vWeights, std::uniform_real_distribution<double>( _dMin, _dMax ) );
 			return _vWeights;
 		}
 
@@ -215,13 +194,7 @@ namespace nn9 {
 		 */
 		template <typename _tType>
 		static _tType &												NormalInitialization( double _dMean, double _dStdDev, _tType &_vWeights ) {
-			std::random_device rdDev;
-			std::mt19937 mGen( rdDev() );
-			std::normal_distribution<double> ndDis( _dMean, _dStdDev );
-
-			for ( auto & fWeight : _vWeights ) {
-				fWeight = _tType::value_type( ndDis( mGen ) );
-			}
+			Fill( _vWeights, std::normal_distribution<double>( _dMean, _dStdDev ) );
 			return _vWeights;
 		}
 
@@ -249,13 +222,7 @@ namespace nn9 {
 				dLimit = std::sqrt( 6.0 / (_iFanIn + _iFanOut) );
 			}
 
-			std::random_device rdDev;
-			std::mt19937 mGen( rdDev() );
-			std::uniform_real_distribution<double> urdDis( -dLimit, dLimit );
-
-			for ( auto & fWeight : _vWeights ) {
-				fWeight = _tType::value_type( urdDis( mGen ) );
-			}
+			Fill( _vWeights, std::uniform_real_distribution<double>( -dLimit, dLimit ) );
 			return _vWeights;
 		}
 
@@ -283,13 +250,7 @@ namespace nn9 {
 				dStdDev = std::sqrt( 2.0 / (_iFanIn + _iFanOut) );
 			}
 
-			std::random_device rdDev;
-			std::mt19937 mGen( rdDev() );
-			std::normal_distribution<double> ndDis( 0.0, dStdDev );
-
-			for ( auto & fWeight : _vWeights ) {
-				fWeight = _tType::value_type( ndDis( mGen ) );
-			}
+			Fill( _vWeights, std::normal_distribution<double>( 0.0, dStdDev ) );
 			return _vWeights;
 		}
 
@@ -312,6 +273,11 @@ namespace nn9 {
 				throw std::runtime_error( "Init::CopyView: The views must both have the same number of elements." );
 			}
 #endif		// #ifdef NN9_SAFETY_CHECK
+			if ( Math::ParallelRun( _vIn.size(), std::max( sizeof( ValueTypeIn ), sizeof( ValueTypeOut ) ), [&]( size_t _sStart, size_t _sTotal ) {
+					const View<ValueTypeIn> vChunkIn( const_cast<ValueTypeIn *>(&_vIn[_sStart]), _sTotal, nullptr );
+					View<ValueTypeOut> vChunkOut( &_vOut[_sStart], _sTotal, nullptr );
+					CopyView<View<ValueTypeIn>, View<ValueTypeOut>>( vChunkIn, vChunkOut );
+				} ) ) { return _vOut; }
 
 			if constexpr ( std::is_same<ValueTypeIn, ValueTypeOut>::value ) {
 				std::memcpy( &_vOut[0], &_vIn[0], _vIn.size() * sizeof( ValueTypeIn ) );
@@ -323,93 +289,53 @@ namespace nn9 {
 			auto * pvtoOut = &_vOut[0];
 			auto sSize = _vIn.size();
 
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( nn9::Types::SimdInt<ValueTypeIn>() ) {
-					constexpr size_t sRegSize = sizeof( __m512i ) / sizeof( ValueTypeIn );
-					while ( sSize >= sRegSize ) {
-						auto mReg = _mm512_loadu_epi8( pvtiIn );
-						Intrin::scast<ValueTypeIn>( mReg, pvtoOut );
-						sSize -= sRegSize;
-						pvtiIn += sRegSize;
-						pvtoOut += sRegSize;
-					}
-				}
-				else if constexpr ( nn9::Types::SimdFloat<ValueTypeIn>() ) {
-					constexpr size_t sRegSize = sizeof( __m512 ) / sizeof( float );
-					while ( sSize >= sRegSize ) {
-						__m512 mReg;
-						if constexpr ( nn9::Types::IsFloat16<ValueTypeIn>() ) {
-							mReg = nn9::float16::Convert16Float16ToFloat32( pvtiIn );
-						}
-						else if constexpr ( nn9::Types::IsBFloat16<ValueTypeIn>() ) {
-							mReg = nn9::bfloat16::loadu_bf16_to_fp32_16( pvtiIn );
-						}
-						else if constexpr ( nn9::Types::Is32BitFloat<ValueTypeIn>() ) {
-							mReg = _mm512_loadu_ps( reinterpret_cast<const float *>(pvtiIn) );
-						}
-						Intrin::scast<ValueTypeIn>( mReg, pvtoOut );
-						sSize -= sRegSize;
-						pvtiIn += sRegSize;
-						pvtoOut += sRegSize;
-					}
-				}
-				else if constexpr ( nn9::Types::SimdDouble<ValueTypeIn>() ) {
-					constexpr size_t sRegSize = sizeof( __m512d ) / sizeof( ValueTypeIn );
-					while ( sSize >= sRegSize ) {
-						auto mReg = _mm512_loadu_pd( pvtiIn );
-						Intrin::scast<ValueTypeIn>( mReg, pvtoOut );
-						sSize -= sRegSize;
-						pvtiIn += sRegSize;
-						pvtoOut += sRegSize;
-					}
-				}
+			// Conversions in the Kernels table run on the widest instruction set the CPU has, however this file was compiled.
+			if constexpr ( nn9::Types::Is32BitFloat<ValueTypeIn>() && nn9::Types::IsBFloat16<ValueTypeOut>() ) {
+				Kernels::Table().pfF32ToBf16( pvtiIn, reinterpret_cast<uint16_t *>(pvtoOut), sSize );
+				return _vOut;
 			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( nn9::Types::SimdInt<ValueTypeIn>() ) {
-					constexpr size_t sRegSize = sizeof( __m256i ) / sizeof( ValueTypeIn );
-					while ( sSize >= sRegSize ) {
-						auto mReg = _mm256_loadu_epi8( pvtiIn );
-						Intrin::scast<ValueTypeIn>( mReg, pvtoOut );
-						sSize -= sRegSize;
-						pvtiIn += sRegSize;
-						pvtoOut += sRegSize;
-					}
+			else if constexpr ( nn9::Types::IsBFloat16<ValueTypeIn>() && nn9::Types::Is32BitFloat<ValueTypeOut>() ) {
+				Kernels::Table().pfBf16ToF32( reinterpret_cast<const uint16_t *>(pvtiIn), pvtoOut, sSize );
+				return _vOut;
+			}
+			else if constexpr ( nn9::Types::Is32BitFloat<ValueTypeIn>() && nn9::Types::Is64BitFloat<ValueTypeOut>() ) {
+				Kernels::Table().pfF32ToF64( pvtiIn, pvtoOut, sSize );
+				return _vOut;
+			}
+			else if constexpr ( nn9::Types::Is64BitFloat<ValueTypeIn>() && nn9::Types::Is32BitFloat<ValueTypeOut>() ) {
+				Kernels::Table().pfF64ToF32( pvtiIn, pvtoOut, sSize );
+				return _vOut;
+			}
+
+			// Other conversions go through float, or through double if either side has values a float cannot hold.
+			constexpr Kernels::NN9_KERNEL_TYPE ktIn = Math::KernelType<ValueTypeIn>();
+			constexpr Kernels::NN9_KERNEL_TYPE ktOut = Math::KernelType<ValueTypeOut>();
+			if constexpr ( ktIn != Kernels::NN9_KT_TOTAL && ktOut != Kernels::NN9_KT_TOTAL ) {
+				constexpr bool bF64 = ktIn == Kernels::NN9_KT_INT32 || ktIn == Kernels::NN9_KT_UINT32 || ktIn == Kernels::NN9_KT_FLOAT64 ||
+					ktOut == Kernels::NN9_KT_INT32 || ktOut == Kernels::NN9_KT_UINT32 || ktOut == Kernels::NN9_KT_FLOAT64;
+				using Real = typename std::conditional<bF64, double, float>::type;
+				const Kernels::NN9_TABLE & tTable = Kernels::Table();
+				void (*pfToReal)( const void *, Real *, size_t );
+				void (*pfFromReal)( const Real *, void *, size_t );
+				if constexpr ( bF64 ) {
+					pfToReal = tTable.pfToF64[ktIn];
+					pfFromReal = tTable.pfFromF64[ktOut];
 				}
-				else if constexpr ( nn9::Types::SimdFloat<ValueTypeIn>() ) {
-					constexpr size_t sRegSize = sizeof( __m256 ) / sizeof( float );
-					while ( sSize >= sRegSize ) {
-						__m256 mReg;
-						if constexpr ( nn9::Types::IsFloat16<ValueTypeIn>() ) {
-							mReg = nn9::float16::Convert8Float16ToFloat32( pvtiIn );
-						}
-						else if constexpr ( nn9::Types::IsBFloat16<ValueTypeIn>() ) {
-							mReg = nn9::bfloat16::loadu_bf16_to_fp32_8( pvtiIn );
-						}
-						else if constexpr ( nn9::Types::Is32BitFloat<ValueTypeIn>() ) {
-							mReg = _mm256_loadu_ps( reinterpret_cast<const float *>(pvtiIn) );
-						}
-						Intrin::scast<ValueTypeIn>( mReg, pvtoOut );
-						sSize -= sRegSize;
-						pvtiIn += sRegSize;
-						pvtoOut += sRegSize;
-					}
+				else {
+					pfToReal = tTable.pfToF32[ktIn];
+					pfFromReal = tTable.pfFromF32[ktOut];
 				}
-				else if constexpr ( nn9::Types::SimdDouble<ValueTypeIn>() ) {
-					constexpr size_t sRegSize = sizeof( __m256d ) / sizeof( ValueTypeIn );
-					while ( sSize >= sRegSize ) {
-						auto mReg = _mm256_loadu_pd( pvtiIn );
-						Intrin::scast<ValueTypeIn>( mReg, pvtoOut );
-						sSize -= sRegSize;
-						pvtiIn += sRegSize;
-						pvtoOut += sRegSize;
+				if ( pfToReal && pfFromReal ) {
+					NN9_ALIGN( 64 )
+					Real rBlock[Math::NN9_TK_BLOCK];
+					for ( size_t I = 0; I < sSize; I += Math::NN9_TK_BLOCK ) {
+						size_t sBlock = std::min<size_t>( sSize - I, Math::NN9_TK_BLOCK );
+						pfToReal( pvtiIn + I, rBlock, sBlock );
+						pfFromReal( rBlock, pvtoOut + I, sBlock );
 					}
+					return _vOut;
 				}
 			}
-#endif	// #ifdef __AVX2__
 
 			while ( sSize-- ) {
 				Intrin::scast( (*pvtiIn++), (*pvtoOut++) );
@@ -418,6 +344,36 @@ namespace nn9 {
 		}
 
 
+	protected :
+		// == Functions.
+		/**
+		 * Fills a view with values drawn from a distribution.  The view is split into blocks of NN9_I_RANDOM_BLOCK elements that are filled
+		 *	in parallel, each by its own generator seeded from 1 shared random seed and the block index, so the values do not depend on how
+		 *	many threads ran.
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \tparam _tDist The distribution type.
+		 * \param _vWeights The view to fill.
+		 * \param _dDist The distribution from which to draw.  Each block draws from its own copy.
+		 * \return Returns _vWeights.
+		 **/
+		template <typename _tType, typename _tDist>
+		static _tType &												Fill( _tType &_vWeights, const _tDist &_dDist ) {
+			using ValueType = typename _tType::value_type;
+			std::random_device rdDev;
+			const uint32_t ui32Seed0 = rdDev(), ui32Seed1 = rdDev();
+
+			ThreadPool::Global().ParallelFor( 0, _vWeights.size(), NN9_I_RANDOM_BLOCK, [&]( size_t _sBegin, size_t _sEnd ) {
+				const uint64_t ui64Block = _sBegin / NN9_I_RANDOM_BLOCK;
+				std::seed_seq ssSeed{ ui32Seed0, ui32Seed1, uint32_t( ui64Block ), uint32_t( ui64Block >> 32 ) };
+				std::mt19937 mGen( ssSeed );
+				_tDist dDist = _dDist;
+				for ( size_t I = _sBegin; I < _sEnd; ++I ) {
+					_vWeights[I] = ValueType( dDist( mGen ) );
+				}
+			} );
+			return _vWeights;
+		}
 	};
 
 }	// namespace nn9
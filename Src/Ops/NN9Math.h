@@ -9,15 +9,23 @@
 #pragma once
 
 #include "../Foundation/NN9Intrin.h"
+#include "../Foundation/NN9Kernels.h"
 #include "../Foundation/NN9Math.h"
+#include "../Foundation/NN9SimdMath.h"
+#include "../Tensor/NN9StridedView.h"
 #include "../Types/NN9BFloat16.h"
 #include "../Types/NN9Float16.h"
 #include "../Types/NN9Types.h"
+#include "../Utilities/NN9ThreadPool.h"
 #include "../Utilities/NN9Utilities.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <limits>
 #include <random>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 
@@ -31,10 +39,82 @@ namespace nn9 {
 	 */
 	class Math {
 	public :
+		// == Enumerations.
+		/** Parallel-execution constants. */
+		enum NN9_PARALLEL : size_t {
+			NN9_P_THRESHOLD						= 1 << 18,								/**< Default number of elements below which views are processed serially. */
+			NN9_P_CHUNK_BYTES					= 32 * 1024,							/**< Target number of bytes per chunk handed to a worker. */
+			NN9_P_CHUNK_ALIGN					= 64,									/**< Chunks are a multiple of this many elements, which keeps register-sized steps and 64-byte alignment intact. */
+		};
+
+		/** Summation modes of reductions. */
+		enum NN9_REDUCE_MODE : size_t {
+			NN9_RM_PAIRWISE,															/**< Values are summed in SIMD registers into leaves of up to NN9_R_LEAF values and leaves are added pairwise. */
+			NN9_RM_KAHAN,																/**< Values are summed with compensated (Kahan) summation in each SIMD lane.  Slower but more accurate. */
+		};
+
+		/** Reduction constants. */
+		enum NN9_REDUCE : size_t {
+			NN9_R_LEAF							= 1024,									/**< Values summed in registers before the partial sum joins the pairwise cascade. */
+			NN9_R_LEAF_ROWS						= 16,									/**< Rows summed into columns before the partial sums join the pairwise cascade. */
+			NN9_R_COLS							= 1024,									/**< Columns per block when reducing an outer axis. */
+		};
+
+		/** Kernel-table constants. */
+		enum NN9_TABLE_KERNEL : size_t {
+			NN9_TK_BLOCK						= 512,									/**< Values converted to float or double at a time when a Kernels table entry is applied to another type. */
+		};
+
+
+		// == Types.
+		/** The type in which values are summed: float for bfloat16_t, float16, and float, and double for everything else. */
+		template <typename _tType>
+		using ReduceType									= typename std::conditional<nn9::Types::SimdFloat<_tType>(), float, double>::type;
+
+
 		// == Functions.
 		// ===============================
 		// Utilities
 		// ===============================
+		/**
+		 * Sets the number of elements at or above which Func() and the Kernels::Table() paths split a view across ThreadPool::Global().
+		 *	Smaller views are processed serially on the calling thread.
+		 * 
+		 * \param _sThreshold The new threshold.  Pass SIZE_MAX to disable parallel execution.
+		 **/
+		static inline void											SetParallelThreshold( size_t _sThreshold ) { m_aParallelThreshold.store( _sThreshold, std::memory_order_relaxed ); }
+
+		/**
+		 * Gets the number of elements at or above which Func() and the Kernels::Table() paths split a view across ThreadPool::Global().
+		 * 
+		 * \return Returns the parallel threshold.
+		 **/
+		static inline size_t										ParallelThreshold() { return m_aParallelThreshold.load( std::memory_order_relaxed ); }
+
+		/**
+		 * Splits a flat range of elements into chunks and runs them with ThreadPool::Global().ParallelFor().  Chunks are a multiple of
+		 *	NN9_P_CHUNK_ALIGN elements long, so every chunk but the last covers whole registers and begins on a 64-byte boundary (if the data
+		 *	does), and the last chunk ends with the same scalar tail as the serial path; results are therefore identical to running serially.
+		 *	Nothing is split when the range is below ParallelThreshold() or fits in 1 chunk, which also stops a kernel that calls back into
+		 *	the same function from splitting its chunk again.
+		 * 
+		 * \tparam _tKernel The kernel type, called with the start and length of each chunk.
+		 * \param _sTotal The number of elements in the range.
+		 * \param _sElementSize The size of the largest element type involved, used to size the chunks.
+		 * \param _kKernel The kernel to run on each chunk.
+		 * \throw Rethrows the first exception thrown by the kernel, after all chunks have stopped.
+		 * \return Returns true if the range was processed in parallel, false if the caller should process it serially.
+		 **/
+		template <typename _tKernel>
+		static bool													ParallelRun( size_t _sTotal, size_t _sElementSize, const _tKernel &_kKernel ) {
+			if ( _sTotal < ParallelThreshold() ) { return false; }
+			const size_t sChunk = std::max<size_t>( NN9_P_CHUNK_BYTES / _sElementSize / NN9_P_CHUNK_ALIGN, 1 ) * NN9_P_CHUNK_ALIGN;
+			ThreadPool & tpPool = ThreadPool::Global();
+			if ( _sTotal <= sChunk || !tpPool.Size() ) { return false; }
+			tpPool.ParallelFor( 0, _sTotal, sChunk, [&]( size_t _sBegin, size_t _sEnd ) { _kKernel( _sBegin, _sEnd - _sBegin ); } );
+			return true;
+		}
+
 		/**
 		 * Applies the given function to each item in the view.
 		 * 
@@ -47,163 +127,27 @@ namespace nn9 {
 		template <typename _tType, typename _tFunc>
 		static _tType &												Func( _tType &_vValues, _tFunc _fFunc ) {
 			using ValueType = typename _tType::value_type;
-#ifdef __AVX512F__
-			if constexpr ( nn9::Types::IsBFloat16<ValueType>() ) {
-				if ( Utilities::IsAvx512FSupported() ) {
-					// Decode 16 bfloat16_t's at once for super-fast processing.
-					bfloat16_t * pSrc = reinterpret_cast<bfloat16_t *>(&_vValues[0]);
-					size_t sSize = _vValues.size();
+			if ( ParallelRun( _vValues.size(), sizeof( ValueType ), [&]( size_t _sStart, size_t _sTotal ) {
+					View<ValueType> vChunk( &_vValues[_sStart], _sTotal, nullptr );
+					Func<View<ValueType>>( vChunk, _fFunc );
+				} ) ) { return _vValues; }
+			if constexpr ( nn9::Types::IsBFloat16<ValueType>() || nn9::Types::IsFloat16<ValueType>() ) {
+				const Kernels::NN9_TABLE & tTable = Kernels::Table();
+				constexpr Kernels::NN9_KERNEL_TYPE ktType = KernelType<ValueType>();
+				if ( tTable.pfToF32[ktType] && tTable.pfFromF32[ktType] ) {
+					// Decode NN9_TK_BLOCK halves at once for super-fast processing.
+					ValueType * pValues = _vValues.size() ? &_vValues[0] : nullptr;
 					NN9_ALIGN( 64 )
-					float fTmp[16];
-
-					while ( sSize >= 16 ) {
-						__m512 mSrc = bfloat16::loadu_bf16_to_fp32_16( reinterpret_cast<uint16_t *>(pSrc) );
-						_mm512_store_ps( fTmp, mSrc );
-
-						Intrin::scast( _fFunc( fTmp[0] ), fTmp[0] );
-						Intrin::scast( _fFunc( fTmp[1] ), fTmp[1] );
-						Intrin::scast( _fFunc( fTmp[2] ), fTmp[2] );
-						Intrin::scast( _fFunc( fTmp[3] ), fTmp[3] );
-						Intrin::scast( _fFunc( fTmp[4] ), fTmp[4] );
-						Intrin::scast( _fFunc( fTmp[5] ), fTmp[5] );
-						Intrin::scast( _fFunc( fTmp[6] ), fTmp[6] );
-						Intrin::scast( _fFunc( fTmp[7] ), fTmp[7] );
-						Intrin::scast( _fFunc( fTmp[8] ), fTmp[8] );
-						Intrin::scast( _fFunc( fTmp[9] ), fTmp[9] );
-						Intrin::scast( _fFunc( fTmp[10] ), fTmp[10] );
-						Intrin::scast( _fFunc( fTmp[11] ), fTmp[11] );
-						Intrin::scast( _fFunc( fTmp[12] ), fTmp[12] );
-						Intrin::scast( _fFunc( fTmp[13] ), fTmp[13] );
-						Intrin::scast( _fFunc( fTmp[14] ), fTmp[14] );
-						Intrin::scast( _fFunc( fTmp[15] ), fTmp[15] );
-
-						sSize -= 16;
-						__m512 mDst = _mm512_load_ps( fTmp );
-						bfloat16::storeu_fp32_to_bf16( reinterpret_cast<uint16_t *>(pSrc), mDst );
-						pSrc += 16;
-					}
-					while ( sSize ) {
-						Intrin::scast( _fFunc( (*pSrc) ), (*pSrc) );
-						++pSrc;
-						--sSize;
-					}
-					return _vValues;
-				}
-			}
-			if constexpr ( nn9::Types::IsFloat16<ValueType>() ) {
-				if ( Utilities::IsAvx512FSupported() ) {
-					nn9::float16 * pSrc = reinterpret_cast<nn9::float16 *>(&_vValues[0]);
-					size_t sSize = _vValues.size();
-					NN9_ALIGN( 64 )
-					float fTmp[16];
-
-					while ( sSize >= 16 ) {
-						__m512 mVal = nn9::float16::Convert16Float16ToFloat32( pSrc );
-						_mm512_store_ps( fTmp, mVal );
-
-						Intrin::scast( _fFunc( fTmp[0] ), fTmp[0] );
-						Intrin::scast( _fFunc( fTmp[1] ), fTmp[1] );
-						Intrin::scast( _fFunc( fTmp[2] ), fTmp[2] );
-						Intrin::scast( _fFunc( fTmp[3] ), fTmp[3] );
-						Intrin::scast( _fFunc( fTmp[4] ), fTmp[4] );
-						Intrin::scast( _fFunc( fTmp[5] ), fTmp[5] );
-						Intrin::scast( _fFunc( fTmp[6] ), fTmp[6] );
-						Intrin::scast( _fFunc( fTmp[7] ), fTmp[7] );
-						Intrin::scast( _fFunc( fTmp[8] ), fTmp[8] );
-						Intrin::scast( _fFunc( fTmp[9] ), fTmp[9] );
-						Intrin::scast( _fFunc( fTmp[10] ), fTmp[10] );
-						Intrin::scast( _fFunc( fTmp[11] ), fTmp[11] );
-						Intrin::scast( _fFunc( fTmp[12] ), fTmp[12] );
-						Intrin::scast( _fFunc( fTmp[13] ), fTmp[13] );
-						Intrin::scast( _fFunc( fTmp[14] ), fTmp[14] );
-						Intrin::scast( _fFunc( fTmp[15] ), fTmp[15] );
-
-						__m512 mDst = _mm512_load_ps( fTmp );
-						nn9::float16::Convert16Float32ToFloat16( pSrc, mDst );
-
-						pSrc += 16;
-						sSize -= 16;
-					}
-					while ( sSize ) {
-						Intrin::scast( _fFunc( (*pSrc) ), (*pSrc) );
-						++pSrc;
-						--sSize;
-					}
-					return _vValues;
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if constexpr ( nn9::Types::IsBFloat16<ValueType>() ) {
-				if ( Utilities::IsAvx2Supported() ) {
-					// Decode 8 bfloat16_t's at once for super-fast processing.
-					bfloat16_t * pSrc = reinterpret_cast<bfloat16_t *>(&_vValues[0]);
-					size_t sSize = _vValues.size();
-					NN9_ALIGN( 32 )
-					float fTmp[8];
-
-					while ( sSize >= 8 ) {
-						__m256 mSrc = bfloat16::loadu_bf16_to_fp32_8( reinterpret_cast<uint16_t *>(pSrc) );
-						_mm256_store_ps( fTmp, mSrc );
-
-						Intrin::scast( _fFunc( fTmp[0] ), fTmp[0] );
-						Intrin::scast( _fFunc( fTmp[1] ), fTmp[1] );
-						Intrin::scast( _fFunc( fTmp[2] ), fTmp[2] );
-						Intrin::scast( _fFunc( fTmp[3] ), fTmp[3] );
-						Intrin::scast( _fFunc( fTmp[4] ), fTmp[4] );
-						Intrin::scast( _fFunc( fTmp[5] ), fTmp[5] );
-						Intrin::scast( _fFunc( fTmp[6] ), fTmp[6] );
-						Intrin::scast( _fFunc( fTmp[7] ), fTmp[7] );
-
-						sSize -= 8;
-						__m256 mDst = _mm256_load_ps( fTmp );
-						bfloat16::storeu_fp32_to_bf16( reinterpret_cast<uint16_t *>(pSrc), mDst );
-						pSrc += 8;
-					}
-					while ( sSize ) {
-						Intrin::scast( _fFunc( (*pSrc) ), (*pSrc) );
-						++pSrc;
-						--sSize;
-					}
-					return _vValues;
-				}
-			}
-			if constexpr ( nn9::Types::IsFloat16<ValueType>() ) {
-				if ( Utilities::IsAvx2Supported() ) {
-					nn9::float16 * pSrc = reinterpret_cast<nn9::float16 *>(&_vValues[0]);
-					size_t sSize = _vValues.size();
-					NN9_ALIGN( 32 )
-					float fTmp[8];
-
-					while ( sSize >= 8 ) {
-						__m256 mVal = nn9::float16::Convert8Float16ToFloat32( pSrc );
-						_mm256_store_ps( fTmp, mVal );
-
-						Intrin::scast( _fFunc( fTmp[0] ), fTmp[0] );
-						Intrin::scast( _fFunc( fTmp[1] ), fTmp[1] );
-						Intrin::scast( _fFunc( fTmp[2] ), fTmp[2] );
-						Intrin::scast( _fFunc( fTmp[3] ), fTmp[3] );
-						Intrin::scast( _fFunc( fTmp[4] ), fTmp[4] );
-						Intrin::scast( _fFunc( fTmp[5] ), fTmp[5] );
-						Intrin::scast( _fFunc( fTmp[6] ), fTmp[6] );
-						Intrin::scast( _fFunc( fTmp[7] ), fTmp[7] );
-
-						__m256 mDst = _mm256_load_ps( fTmp );
-						nn9::float16::Convert8Float32ToFloat16( pSrc, mDst );
-
-						pSrc += 8;
-						sSize -= 8;
-					}
-					while ( sSize ) {
-						Intrin::scast( _fFunc( (*pSrc) ), (*pSrc) );
-						++pSrc;
-						--sSize;
+					float fBlock[NN9_TK_BLOCK];
+					for ( size_t I = 0; I < _vValues.size(); I += NN9_TK_BLOCK ) {
+						size_t sBlock = std::min<size_t>( _vValues.size() - I, NN9_TK_BLOCK );
+						tTable.pfToF32[ktType]( pValues + I, fBlock, sBlock );
+						for ( size_t J = 0; J < sBlock; ++J ) { Intrin::scast( _fFunc( fBlock[J] ), fBlock[J] ); }
+						tTable.pfFromF32[ktType]( fBlock, pValues + I, sBlock );
 					}
 					return _vValues;
 				}
 			}
-#endif	// #ifdef __AVX2__
 			for ( auto & aThis : _vValues ) {
 				Intrin::scast( _fFunc( aThis ), aThis );
 			}
@@ -229,295 +173,35 @@ namespace nn9 {
 #endif	// #ifdef NN9_SAFETY_CHECK
 			using ValueTypeIn = typename _tTypeIn::value_type;
 			using ValueTypeOut = typename _tTypeOut::value_type;
-#ifdef __AVX512F__
-			if constexpr ( nn9::Types::IsBFloat16<ValueTypeIn>() ) {
-				if ( Utilities::IsAvx512FSupported() ) {
-					// Decode 16 bfloat16_t's at once for super-fast processing.
-					const bfloat16_t * pSrc = reinterpret_cast<const bfloat16_t *>(&_vIn[0]);
-					ValueTypeOut * pDst = reinterpret_cast<ValueTypeOut *>(&_vOut[0]);
-					size_t sSize = _vIn.size();
-					NN9_ALIGN( 64 )
-					float fTmp[16];
-
-					while ( sSize >= 16 ) {
-						__m512 mSrc = bfloat16::loadu_bf16_to_fp32_16( pSrc );
-						_mm512_store_ps( fTmp, mSrc );
-
-						if constexpr ( nn9::Types::IsBFloat16<ValueTypeOut>() ) {
-							Intrin::scast( _fFunc( fTmp[0] ), fTmp[0] );
-							Intrin::scast( _fFunc( fTmp[1] ), fTmp[1] );
-							Intrin::scast( _fFunc( fTmp[2] ), fTmp[2] );
-							Intrin::scast( _fFunc( fTmp[3] ), fTmp[3] );
-							Intrin::scast( _fFunc( fTmp[4] ), fTmp[4] );
-							Intrin::scast( _fFunc( fTmp[5] ), fTmp[5] );
-							Intrin::scast( _fFunc( fTmp[6] ), fTmp[6] );
-							Intrin::scast( _fFunc( fTmp[7] ), fTmp[7] );
-							Intrin::scast( _fFunc( fTmp[8] ), fTmp[8] );
-							Intrin::scast( _fFunc( fTmp[9] ), fTmp[9] );
-							Intrin::scast( _fFunc( fTmp[10] ), fTmp[10] );
-							Intrin::scast( _fFunc( fTmp[11] ), fTmp[11] );
-							Intrin::scast( _fFunc( fTmp[12] ), fTmp[12] );
-							Intrin::scast( _fFunc( fTmp[13] ), fTmp[13] );
-							Intrin::scast( _fFunc( fTmp[14] ), fTmp[14] );
-							Intrin::scast( _fFunc( fTmp[15] ), fTmp[15] );
-
-							__m512 mDst = _mm512_load_ps( fTmp );
-							bfloat16::storeu_fp32_to_bf16( reinterpret_cast<uint16_t *>(pDst), mDst );
-						}
-						else if constexpr ( nn9::Types::IsFloat16<ValueTypeOut>() ) {
-							Intrin::scast( _fFunc( fTmp[0] ), fTmp[0] );
-							Intrin::scast( _fFunc( fTmp[1] ), fTmp[1] );
-							Intrin::scast( _fFunc( fTmp[2] ), fTmp[2] );
-							Intrin::scast( _fFunc( fTmp[3] ), fTmp[3] );
-							Intrin::scast( _fFunc( fTmp[4] ), fTmp[4] );
-							Intrin::scast( _fFunc( fTmp[5] ), fTmp[5] );
-							Intrin::scast( _fFunc( fTmp[6] ), fTmp[6] );
-							Intrin::scast( _fFunc( fTmp[7] ), fTmp[7] );
-							Intrin::scast( _fFunc( fTmp[8] ), fTmp[8] );
-							Intrin::scast( _fFunc( fTmp[9] ), fTmp[9] );
-							Intrin::scast( _fFunc( fTmp[10] ), fTmp[10] );
-							Intrin::scast( _fFunc( fTmp[11] ), fTmp[11] );
-							Intrin::scast( _fFunc( fTmp[12] ), fTmp[12] );
-							Intrin::scast( _fFunc( fTmp[13] ), fTmp[13] );
-							Intrin::scast( _fFunc( fTmp[14] ), fTmp[14] );
-							Intrin::scast( _fFunc( fTmp[15] ), fTmp[15] );
-
-							__m512 mDst = _mm512_load_ps( fTmp );
-							nn9::float16::Convert16Float32ToFloat16( reinterpret_cast<nn9::float16 *>(pDst), mDst );
-						}
-						else {
-							Intrin::scast( _fFunc( fTmp[0] ), pDst[0] );
-							Intrin::scast( _fFunc( fTmp[1] ), pDst[1] );
-							Intrin::scast( _fFunc( fTmp[2] ), pDst[2] );
-							Intrin::scast( _fFunc( fTmp[3] ), pDst[3] );
-							Intrin::scast( _fFunc( fTmp[4] ), pDst[4] );
-							Intrin::scast( _fFunc( fTmp[5] ), pDst[5] );
-							Intrin::scast( _fFunc( fTmp[6] ), pDst[6] );
-							Intrin::scast( _fFunc( fTmp[7] ), pDst[7] );
-							Intrin::scast( _fFunc( fTmp[8] ), pDst[8] );
-							Intrin::scast( _fFunc( fTmp[9] ), pDst[9] );
-							Intrin::scast( _fFunc( fTmp[10] ), pDst[10] );
-							Intrin::scast( _fFunc( fTmp[11] ), pDst[11] );
-							Intrin::scast( _fFunc( fTmp[12] ), pDst[12] );
-							Intrin::scast( _fFunc( fTmp[13] ), pDst[13] );
-							Intrin::scast( _fFunc( fTmp[14] ), pDst[14] );
-							Intrin::scast( _fFunc( fTmp[15] ), pDst[15] );
-						}
-
-						sSize -= 16;
-						pSrc += 16;
-						pDst += 16;
-					}
-					while ( sSize-- ) {
-						Intrin::scast( _fFunc( (*pSrc++) ), (*pDst++) );
-					}
-					return _vOut;
-				}
-			}
-			if constexpr ( nn9::Types::IsFloat16<ValueTypeIn>() ) {
-				if ( Utilities::IsAvx512FSupported() ) {
-					nn9::float16 * pSrc = reinterpret_cast<nn9::float16 *>(&_vIn[0]);
-					ValueTypeOut * pDst = reinterpret_cast<ValueTypeOut *>(&_vOut[0]);
-					size_t sSize = _vIn.size();
+			if ( ParallelRun( _vIn.size(), std::max( sizeof( ValueTypeIn ), sizeof( ValueTypeOut ) ), [&]( size_t _sStart, size_t _sTotal ) {
+					const View<ValueTypeIn> vChunkIn( const_cast<ValueTypeIn *>(&_vIn[_sStart]), _sTotal, nullptr );
+					View<ValueTypeOut> vChunkOut( &_vOut[_sStart], _sTotal, nullptr );
+					Func<View<ValueTypeIn>, View<ValueTypeOut>>( vChunkIn, vChunkOut, _fFunc );
+				} ) ) { return _vOut; }
+			if constexpr ( nn9::Types::IsBFloat16<ValueTypeIn>() || nn9::Types::IsFloat16<ValueTypeIn>() ) {
+				const Kernels::NN9_TABLE & tTable = Kernels::Table();
+				constexpr Kernels::NN9_KERNEL_TYPE ktIn = KernelType<ValueTypeIn>();
+				if ( tTable.pfToF32[ktIn] ) {
+					// Decode NN9_TK_BLOCK halves at once for super-fast processing.
+					const ValueTypeIn * pSrc = _vIn.size() ? &_vIn[0] : nullptr;
+					ValueTypeOut * pDst = _vIn.size() ? &_vOut[0] : nullptr;
 					NN9_ALIGN( 64 )
-					float fTmp[16];
-
-					while ( sSize >= 16 ) {
-						__m512 mVal = nn9::float16::Convert16Float16ToFloat32( pSrc );
-						_mm512_store_ps( fTmp, mVal );
-
-						if constexpr ( nn9::Types::IsBFloat16<ValueTypeOut>() ) {
-							Intrin::scast( _fFunc( fTmp[0] ), fTmp[0] );
-							Intrin::scast( _fFunc( fTmp[1] ), fTmp[1] );
-							Intrin::scast( _fFunc( fTmp[2] ), fTmp[2] );
-							Intrin::scast( _fFunc( fTmp[3] ), fTmp[3] );
-							Intrin::scast( _fFunc( fTmp[4] ), fTmp[4] );
-							Intrin::scast( _fFunc( fTmp[5] ), fTmp[5] );
-							Intrin::scast( _fFunc( fTmp[6] ), fTmp[6] );
-							Intrin::scast( _fFunc( fTmp[7] ), fTmp[7] );
-							Intrin::scast( _fFunc( fTmp[8] ), fTmp[8] );
-							Intrin::scast( _fFunc( fTmp[9] ), fTmp[9] );
-							Intrin::scast( _fFunc( fTmp[10] ), fTmp[10] );
-							Intrin::scast( _fFunc( fTmp[11] ), fTmp[11] );
-							Intrin::scast( _fFunc( fTmp[12] ), fTmp[12] );
-							Intrin::scast( _fFunc( fTmp[13] ), fTmp[13] );
-							Intrin::scast( _fFunc( fTmp[14] ), fTmp[14] );
-							Intrin::scast( _fFunc( fTmp[15] ), fTmp[15] );
-
-							__m512 mDst = _mm512_load_ps( fTmp );
-							bfloat16::storeu_fp32_to_bf16( reinterpret_cast<uint16_t *>(pDst), mDst );
-						}
-						else if constexpr ( nn9::Types::IsFloat16<ValueTypeOut>() ) {
-							Intrin::scast( _fFunc( fTmp[0] ), fTmp[0] );
-							Intrin::scast( _fFunc( fTmp[1] ), fTmp[1] );
-							Intrin::scast( _fFunc( fTmp[2] ), fTmp[2] );
-							Intrin::scast( _fFunc( fTmp[3] ), fTmp[3] );
-							Intrin::scast( _fFunc( fTmp[4] ), fTmp[4] );
-							Intrin::scast( _fFunc( fTmp[5] ), fTmp[5] );
-							Intrin::scast( _fFunc( fTmp[6] ), fTmp[6] );
-							Intrin::scast( _fFunc( fTmp[7] ), fTmp[7] );
-							Intrin::scast( _fFunc( fTmp[8] ), fTmp[8] );
-							Intrin::scast( _fFunc( fTmp[9] ), fTmp[9] );
-							Intrin::scast( _fFunc( fTmp[10] ), fTmp[10] );
-							Intrin::scast( _fFunc( fTmp[11] ), fTmp[11] );
-							Intrin::scast( _fFunc( fTmp[12] ), fTmp[12] );
-							Intrin::scast( _fFunc( fTmp[13] ), fTmp[13] );
-							Intrin::scast( _fFunc( fTmp[14] ), fTmp[14] );
-							Intrin::scast( _fFunc( fTmp[15] ), fTmp[15] );
-
-							__m512 mDst = _mm512_load_ps( fTmp );
-							nn9::float16::Convert16Float32ToFloat16( reinterpret_cast<nn9::float16 *>(pDst), mDst );
-						}
-						else {
-							Intrin::scast( _fFunc( fTmp[0] ), pDst[0] );
-							Intrin::scast( _fFunc( fTmp[1] ), pDst[1] );
-							Intrin::scast( _fFunc( fTmp[2] ), pDst[2] );
-							Intrin::scast( _fFunc( fTmp[3] ), pDst[3] );
-							Intrin::scast( _fFunc( fTmp[4] ), pDst[4] );
-							Intrin::scast( _fFunc( fTmp[5] ), pDst[5] );
-							Intrin::scast( _fFunc( fTmp[6] ), pDst[6] );
-							Intrin::scast( _fFunc( fTmp[7] ), pDst[7] );
-							Intrin::scast( _fFunc( fTmp[8] ), pDst[8] );
-							Intrin::scast( _fFunc( fTmp[9] ), pDst[9] );
-							Intrin::scast( _fFunc( fTmp[10] ), pDst[10] );
-							Intrin::scast( _fFunc( fTmp[11] ), pDst[11] );
-							Intrin::scast( _fFunc( fTmp[12] ), pDst[12] );
-							Intrin::scast( _fFunc( fTmp[13] ), pDst[13] );
-							Intrin::scast( _fFunc( fTmp[14] ), pDst[14] );
-							Intrin::scast( _fFunc( fTmp[15] ), pDst[15] );
-						}
-
-						pSrc += 16;
-						sSize -= 16;
-					}
-					while ( sSize-- ) {
-						Intrin::scast( _fFunc( (*pSrc++) ), (*pDst++) );
-					}
-					return _vOut;
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if constexpr ( nn9::Types::IsBFloat16<ValueTypeIn>() ) {
-				if ( Utilities::IsAvx2Supported() ) {
-					// Decode 8 bfloat16_t's at once for super-fast processing.
-					const bfloat16_t * pSrc = reinterpret_cast<const bfloat16_t *>(&_vIn[0]);
-					ValueTypeOut * pDst = reinterpret_cast<ValueTypeOut *>(&_vOut[0]);
-					size_t sSize = _vIn.size();
-					NN9_ALIGN( 32 )
-					float fTmp[8];
-
-					while ( sSize >= 8 ) {
-						__m256 mSrc = bfloat16::loadu_bf16_to_fp32_8( pSrc );
-						_mm256_store_ps( fTmp, mSrc );
-
-						if constexpr ( nn9::Types::IsBFloat16<ValueTypeOut>() ) {
-							Intrin::scast( _fFunc( fTmp[0] ), fTmp[0] );
-							Intrin::scast( _fFunc( fTmp[1] ), fTmp[1] );
-							Intrin::scast( _fFunc( fTmp[2] ), fTmp[2] );
-							Intrin::scast( _fFunc( fTmp[3] ), fTmp[3] );
-							Intrin::scast( _fFunc( fTmp[4] ), fTmp[4] );
-							Intrin::scast( _fFunc( fTmp[5] ), fTmp[5] );
-							Intrin::scast( _fFunc( fTmp[6] ), fTmp[6] );
-							Intrin::scast( _fFunc( fTmp[7] ), fTmp[7] );
-
-							__m256 mDst = _mm256_load_ps( fTmp );
-							bfloat16::storeu_fp32_to_bf16( reinterpret_cast<uint16_t *>(pDst), mDst );
-						}
-						else if constexpr ( nn9::Types::IsFloat16<ValueTypeOut>() ) {
-							Intrin::scast( _fFunc( fTmp[0] ), fTmp[0] );
-							Intrin::scast( _fFunc( fTmp[1] ), fTmp[1] );
-							Intrin::scast( _fFunc( fTmp[2] ), fTmp[2] );
-							Intrin::scast( _fFunc( fTmp[3] ), fTmp[3] );
-							Intrin::scast( _fFunc( fTmp[4] ), fTmp[4] );
-							Intrin::scast( _fFunc( fTmp[5] ), fTmp[5] );
-							Intrin::scast( _fFunc( fTmp[6] ), fTmp[6] );
-							Intrin::scast( _fFunc( fTmp[7] ), fTmp[7] );
-
-							__m256 mDst = _mm256_load_ps( fTmp );
-							nn9::float16::Convert8Float32ToFloat16( reinterpret_cast<nn9::float16 *>(pDst), mDst );
+					float fBlock[NN9_TK_BLOCK];
+					for ( size_t I = 0; I < _vIn.size(); I += NN9_TK_BLOCK ) {
+						size_t sBlock = std::min<size_t>( _vIn.size() - I, NN9_TK_BLOCK );
+						tTable.pfToF32[ktIn]( pSrc + I, fBlock, sBlock );
+						if constexpr ( nn9::Types::IsBFloat16<ValueTypeOut>() || nn9::Types::IsFloat16<ValueTypeOut>() ) {
+							for ( size_t J = 0; J < sBlock; ++J ) { Intrin::scast( _fFunc( fBlock[J] ), fBlock[J] ); }
+							tTable.pfFromF32[KernelType<ValueTypeOut>()]( fBlock, pDst + I, sBlock );
 						}
 						else {
-							Intrin::scast( _fFunc( fTmp[0] ), pDst[0] );
-							Intrin::scast( _fFunc( fTmp[1] ), pDst[1] );
-							Intrin::scast( _fFunc( fTmp[2] ), pDst[2] );
-							Intrin::scast( _fFunc( fTmp[3] ), pDst[3] );
-							Intrin::scast( _fFunc( fTmp[4] ), pDst[4] );
-							Intrin::scast( _fFunc( fTmp[5] ), pDst[5] );
-							Intrin::scast( _fFunc( fTmp[6] ), pDst[6] );
-							Intrin::scast( _fFunc( fTmp[7] ), pDst[7] );
+							for ( size_t J = 0; J < sBlock; ++J ) { Intrin::scast( _fFunc( fBlock[J] ), pDst[I+J] ); }
 						}
-
-						sSize -= 8;
-						pSrc += 8;
-						pDst += 8;
-					}
-					while ( sSize-- ) {
-						Intrin::scast( _fFunc( (*pSrc++) ), (*pDst++) );
 					}
 					return _vOut;
 				}
 			}
-			if constexpr ( nn9::Types::IsFloat16<ValueTypeIn>() ) {
-				if ( Utilities::IsAvx2Supported() ) {
-					nn9::float16 * pSrc = reinterpret_cast<nn9::float16 *>(&_vIn[0]);
-					ValueTypeOut * pDst = reinterpret_cast<ValueTypeOut *>(&_vOut[0]);
-					size_t sSize = _vIn.size();
-					NN9_ALIGN( 32 )
-					float fTmp[8];
-
-					while ( sSize >= 8 ) {
-						__m256 mVal = nn9::float16::Convert8Float16ToFloat32( pSrc );
-						_mm256_store_ps( fTmp, mVal );
-
-						if constexpr ( nn9::Types::IsBFloat16<ValueTypeOut>() ) {
-							Intrin::scast( _fFunc( fTmp[0] ), fTmp[0] );
-							Intrin::scast( _fFunc( fTmp[1] ), fTmp[1] );
-							Intrin::scast( _fFunc( fTmp[2] ), fTmp[2] );
-							Intrin::scast( _fFunc( fTmp[3] ), fTmp[3] );
-							Intrin::scast( _fFunc( fTmp[4] ), fTmp[4] );
-							Intrin::scast( _fFunc( fTmp[5] ), fTmp[5] );
-							Intrin::scast( _fFunc( fTmp[6] ), fTmp[6] );
-							Intrin::scast( _fFunc( fTmp[7] ), fTmp[7] );
-
-							__m256 mDst = _mm256_load_ps( fTmp );
-							bfloat16::storeu_fp32_to_bf16( reinterpret_cast<uint16_t *>(pDst), mDst );
-						}
-						else if constexpr ( nn9::Types::IsFloat16<ValueTypeOut>() ) {
-							Intrin::scast( _fFunc( fTmp[0] ), fTmp[0] );
-							Intrin::scast( _fFunc( fTmp[1] ), fTmp[1] );
-							Intrin::scast( _fFunc( fTmp[2] ), fTmp[2] );
-							Intrin::scast( _fFunc( fTmp[3] ), fTmp[3] );
-							Intrin::scast( _fFunc( fTmp[4] ), fTmp[4] );
-							Intrin::scast( _fFunc( fTmp[5] ), fTmp[5] );
-							Intrin::scast( _fFunc( fTmp[6] ), fTmp[6] );
-							Intrin::scast( _fFunc( fTmp[7] ), fTmp[7] );
-
-							__m256 mDst = _mm256_load_ps( fTmp );
-							nn9::float16::Convert8Float32ToFloat16( reinterpret_cast<nn9::float16 *>(pDst), mDst );
-						}
-						else {
-							Intrin::scast( _fFunc( fTmp[0] ), pDst[0] );
-							Intrin::scast( _fFunc( fTmp[1] ), pDst[1] );
-							Intrin::scast( _fFunc( fTmp[2] ), pDst[2] );
-							Intrin::scast( _fFunc( fTmp[3] ), pDst[3] );
-							Intrin::scast( _fFunc( fTmp[4] ), pDst[4] );
-							Intrin::scast( _fFunc( fTmp[5] ), pDst[5] );
-							Intrin::scast( _fFunc( fTmp[6] ), pDst[6] );
-							Intrin::scast( _fFunc( fTmp[7] ), pDst[7] );
-						}
 
-						pSrc += 8;
-						sSize -= 8;
-					}
-					while ( sSize-- ) {
-						Intrin::scast( _fFunc( (*pSrc++) ), (*pDst++) );
-					}
-					return _vOut;
-				}
-			}
-#endif	// #ifdef __AVX2__
 
 			for ( size_t i = 0; i < _vIn.size(); ++i ) {
 				Intrin::scast( _fFunc( _vIn[i] ), _vOut[i] );
@@ -525,436 +209,796 @@ namespace nn9 {
 			return _vOut;
 		}
 
-#ifdef __AVX512F__
 		/**
-		 * Applies the given function to each item in the view using AVX-512.
+		 * Applies the given function to each item in a strided view.  Contiguous views and contiguous inner runs are processed in place by
+		 *	the flat kernel; other runs are gathered into contiguous blocks, processed, and scattered back.
 		 * 
-		 * \tparam _tType The view/container type.
-		 * \tparam _tAvx512Func The AVX-512 function type.
+		 * \tparam _tType The strided view type.
 		 * \tparam _tFunc The function type.
 		 * \param _vValues The input/output view to modify.
-		 * \param _fAvxFunc A pointer to the function to call on each item in the view.
 		 * \param _fFunc A pointer to the function to call on each item in the view.
 		 * \return Returns _vValues.
 		 **/
-		template <typename _tType, typename _tAvx512Func, typename _tFunc>
-		static _tType &												FuncAvx512( _tType &_vValues, _tAvx512Func _fAvxFunc, _tFunc _fFunc ) {
+		template <typename _tType, typename _tFunc>
+			requires IsStridedView<std::remove_cvref_t<_tType>>::value
+		static _tType &												Func( _tType &_vValues, _tFunc _fFunc ) {
 			using ValueType = typename _tType::value_type;
-			auto * pvtiIn = &_vValues[0];
-			auto sSize = _vValues.size();
-
-			if constexpr ( nn9::Types::SimdInt<ValueType>() ) {
-				if constexpr ( nn9::Types::IsInt8<ValueType>() || nn9::Types::IsUint8<ValueType>() ||
-					nn9::Types::IsInt16<ValueType>() || nn9::Types::IsUint16<ValueType>() ) {
-					if ( !Utilities::IsAvx512BWSupported() ) { goto End; }
-				}
-				constexpr size_t sRegSize = sizeof( __m512i ) / sizeof( ValueType );
-				while ( sSize >= sRegSize ) {
-					auto mReg = _mm512_loadu_epi64( pvtiIn );
-					mReg = _fAvxFunc( mReg );
-					Intrin::scast<ValueType>( mReg, pvtiIn );
-					sSize -= sRegSize;
-					pvtiIn += sRegSize;
-				}
-				goto End;	// To remove "unused label" warning.
-			}
-			else if constexpr ( nn9::Types::SimdFloat<ValueType>() ) {
-				constexpr size_t sRegSize = sizeof( __m512 ) / sizeof( float );
-				while ( sSize >= sRegSize ) {
-					__m512 mReg;
-					if constexpr ( nn9::Types::IsFloat16<ValueType>() ) {
-						mReg = nn9::float16::Convert16Float16ToFloat32( pvtiIn );
-					}
-					else if constexpr ( nn9::Types::IsBFloat16<ValueType>() ) {
-						mReg = nn9::bfloat16::loadu_bf16_to_fp32_16( pvtiIn );
-					}
-					else if constexpr ( nn9::Types::Is32BitFloat<ValueType>() ) {
-						mReg = _mm512_loadu_ps( reinterpret_cast<const float *>(pvtiIn) );
-					}
-					mReg = _fAvxFunc( mReg );
-					Intrin::scast<ValueType>( mReg, pvtiIn );
-					sSize -= sRegSize;
-					pvtiIn += sRegSize;
-				}
-				goto End;	// To remove "unused label" warning.
-			}
-			else if constexpr ( nn9::Types::SimdDouble<ValueType>() ) {
-				constexpr size_t sRegSize = sizeof( __m512d ) / sizeof( ValueType );
-				while ( sSize >= sRegSize ) {
-					auto mReg = _mm512_loadu_pd( pvtiIn );
-					mReg = _fAvxFunc( mReg );
-					Intrin::scast<ValueType>( mReg, pvtiIn );
-					sSize -= sRegSize;
-					pvtiIn += sRegSize;
-				}
-				goto End;	// To remove "unused label" warning.
-			}
-
-		End :
-			while ( sSize-- ) {
-				Intrin::scast( (*pvtiIn), (*pvtiIn) );
-				++pvtiIn;
-			}
-			return _vValues;
+			return StridedApply( _vValues, [&]( View<ValueType> &_vRun ) { Func<View<ValueType>>( _vRun, _fFunc ); } );
 		}
 
 		/**
-		 * Applies the given function to each item in the view.
+		 * Applies the given function to each item in a strided view.  Contiguous views are processed directly by the flat kernel; others
+		 *	are gathered into contiguous blocks, processed, and scattered back.
 		 * 
 		 * \tparam _tTypeIn The input view/container type.
 		 * \tparam _tTypeOut The output view/container type.
-		 * \tparam _tAvx512Func The AVX-512 function type.
 		 * \tparam _tFunc The function type.
 		 * \param _vIn The input view.
 		 * \param _vOut The output view.
-		 * \param _fAvxFunc A pointer to the function to call on each item in the view.
 		 * \param _fFunc A pointer to the function to call on each item in the view.
 		 * \throw If NN9_SAFETY_CHECK, throws if the views are not the same lengths.
 		 * \return Returns _vOut.
 		 **/
-		template <typename _tTypeIn, typename _tTypeOut, typename _tAvx512Func, typename _tFunc>
-		static _tTypeOut &											FuncAvx512( const _tTypeIn &_vIn, _tTypeOut &_vOut, _tAvx512Func _fAvxFunc, _tFunc _fFunc ) {
+		template <typename _tTypeIn, typename _tTypeOut, typename _tFunc>
+			requires (IsStridedView<std::remove_cvref_t<_tTypeIn>>::value || IsStridedView<std::remove_cvref_t<_tTypeOut>>::value)
+		static _tTypeOut &											Func( const _tTypeIn &_vIn, _tTypeOut &_vOut, _tFunc _fFunc ) {
 			using ValueTypeIn = typename _tTypeIn::value_type;
 			using ValueTypeOut = typename _tTypeOut::value_type;
-#ifdef NN9_SAFETY_CHECK
-			if ( _vIn.size() != _vOut.size() ) { throw std::runtime_error( "Math::FuncAvx512: The source and destination must both have the same number of elements." ); }
-#endif		// #ifdef NN9_SAFETY_CHECK
-
-			const auto * pvtiIn = &_vIn[0];
-			auto * pvtoOut = &_vOut[0];
-			auto sSize = _vIn.size();
-
-			if constexpr ( nn9::Types::SimdInt<ValueTypeIn>() ) {
-				if constexpr ( nn9::Types::IsInt8<ValueTypeIn>() || nn9::Types::IsUint8<ValueTypeIn>() ||
-					nn9::Types::IsInt16<ValueTypeIn>() || nn9::Types::IsUint16<ValueTypeIn>() ) {
-					if ( !Utilities::IsAvx512BWSupported() ) { goto End; }
-				}
-				constexpr size_t sRegSize = sizeof( __m512i ) / sizeof( ValueTypeIn );
-				while ( sSize >= sRegSize ) {
-					auto mReg = _mm512_loadu_epi8( pvtiIn );
-					mReg = _fAvxFunc( mReg );
-					Intrin::scast<ValueTypeIn>( mReg, pvtoOut );
-					sSize -= sRegSize;
-					pvtiIn += sRegSize;
-					pvtoOut += sRegSize;
-				}
-				goto End;	// To remove "unused label" warning.
-			}
-			else if constexpr ( nn9::Types::SimdFloat<ValueTypeIn>() ) {
-				constexpr size_t sRegSize = sizeof( __m512 ) / sizeof( float );
-				while ( sSize >= sRegSize ) {
-					__m512 mReg;
-					if constexpr ( nn9::Types::IsFloat16<ValueTypeIn>() ) {
-						mReg = nn9::float16::Convert16Float16ToFloat32( pvtiIn );
-					}
-					else if constexpr ( nn9::Types::IsBFloat16<ValueTypeIn>() ) {
-						mReg = nn9::bfloat16::loadu_bf16_to_fp32_16( pvtiIn );
-					}
-					else if constexpr ( nn9::Types::Is32BitFloat<ValueTypeIn>() ) {
-						mReg = _mm512_loadu_ps( reinterpret_cast<const float *>(pvtiIn) );
-					}
-					mReg = _fAvxFunc( mReg );
-					Intrin::scast<ValueTypeIn>( mReg, pvtoOut );
-					sSize -= sRegSize;
-					pvtiIn += sRegSize;
-					pvtoOut += sRegSize;
-				}
-				goto End;	// To remove "unused label" warning.
-			}
-			else if constexpr ( nn9::Types::SimdDouble<ValueTypeIn>() ) {
-				constexpr size_t sRegSize = sizeof( __m512d ) / sizeof( ValueTypeIn );
-				while ( sSize >= sRegSize ) {
-					auto mReg = _mm512_loadu_pd( pvtiIn );
-					mReg = _fAvxFunc( mReg );
-					Intrin::scast<ValueTypeIn>( mReg, pvtoOut );
-					sSize -= sRegSize;
-					pvtiIn += sRegSize;
-					pvtoOut += sRegSize;
-				}
-				goto End;	// To remove "unused label" warning.
-			}
-
-		End :
-			while ( sSize-- ) {
-				Intrin::scast( (*pvtiIn++), (*pvtoOut++) );
-			}
-			return _vOut;
+			return StridedApply( _vIn, _vOut, [&]( const View<ValueTypeIn> &_vRunIn, View<ValueTypeOut> &_vRunOut ) {
+				Func<View<ValueTypeIn>, View<ValueTypeOut>>( _vRunIn, _vRunOut, _fFunc );
+			} );
 		}
-#endif	// #ifdef __AVX512F__
 
-#ifdef __AVX2__
 		/**
-		 * Applies the given function to each item in the view using AVX2.
+		 * Applies a Kernels table entry to the view.  The view is split across threads as Func() splits it.
 		 * 
 		 * \tparam _tType The view/container type.
-		 * \tparam _tAvx2Func The AVX2 function type.
-		 * \tparam _tFunc The function type.
 		 * \param _vValues The input/output view to modify.
-		 * \param _fAvxFunc A pointer to the function to call on each item in the view.
-		 * \param _fFunc A pointer to the function to call on each item in the view.
+		 * \param _pfKernel The kernel to call on each contiguous run of the view.
 		 * \return Returns _vValues.
 		 **/
-		template <typename _tType, typename _tAvx2Func, typename _tFunc>
-		static _tType &												FuncAvx2( _tType &_vValues, _tAvx2Func _fAvxFunc, _tFunc _fFunc ) {
+		template <typename _tType>
+		static _tType &												KernelFunc( _tType &_vValues,
+			void (*_pfKernel)( const typename _tType::value_type *, typename _tType::value_type *, size_t ) ) {
 			using ValueType = typename _tType::value_type;
-			auto * pvtiIn = &_vValues[0];
-			auto sSize = _vValues.size();
-
-			if constexpr ( nn9::Types::SimdInt<ValueType>() ) {
-				constexpr size_t sRegSize = sizeof( __m256i ) / sizeof( ValueType );
-				while ( sSize >= sRegSize ) {
-					auto mReg = _mm256_loadu_epi64( pvtiIn );
-					mReg = _fAvxFunc( mReg );
-					Intrin::scast<ValueType>( mReg, pvtiIn );
-					sSize -= sRegSize;
-					pvtiIn += sRegSize;
-				}
-			}
-			else if constexpr ( nn9::Types::SimdFloat<ValueType>() ) {
-				constexpr size_t sRegSize = sizeof( __m256 ) / sizeof( float );
-				while ( sSize >= sRegSize ) {
-					__m256 mReg;
-					if constexpr ( nn9::Types::IsFloat16<ValueType>() ) {
-						mReg = nn9::float16::Convert8Float16ToFloat32( pvtiIn );
-					}
-					else if constexpr ( nn9::Types::IsBFloat16<ValueType>() ) {
-						mReg = nn9::bfloat16::loadu_bf16_to_fp32_8( pvtiIn );
-					}
-					else if constexpr ( nn9::Types::Is32BitFloat<ValueType>() ) {
-						mReg = _mm256_loadu_ps( reinterpret_cast<const float *>(pvtiIn) );
-					}
-					mReg = _fAvxFunc( mReg );
-					Intrin::scast<ValueType>( mReg, pvtiIn );
-					sSize -= sRegSize;
-					pvtiIn += sRegSize;
-				}
-			}
-			else if constexpr ( nn9::Types::SimdDouble<ValueType>() ) {
-				constexpr size_t sRegSize = sizeof( __m256d ) / sizeof( ValueType );
-				while ( sSize >= sRegSize ) {
-					auto mReg = _mm256_loadu_pd( reinterpret_cast<const double *>(pvtiIn) );
-					mReg = _fAvxFunc( mReg );
-					Intrin::scast<ValueType>( mReg, pvtiIn );
-					sSize -= sRegSize;
-					pvtiIn += sRegSize;
-				}
-			}
-
-			while ( sSize-- ) {
-				Intrin::scast( (*pvtiIn), (*pvtiIn) );
-				++pvtiIn;
-			}
+			if ( ParallelRun( _vValues.size(), sizeof( ValueType ), [&]( size_t _sStart, size_t _sTotal ) {
+					_pfKernel( &_vValues[_sStart], &_vValues[_sStart], _sTotal );
+				} ) ) { return _vValues; }
+			if ( _vValues.size() ) { _pfKernel( &_vValues[0], &_vValues[0], _vValues.size() ); }
 			return _vValues;
 		}
 
 		/**
-		 * Applies the given function to each item in the view.
+		 * Applies a Kernels table entry to the input view, storing the results in the output view.  The views are split across threads as
+		 *	Func() splits them.
 		 * 
 		 * \tparam _tTypeIn The input view/container type.
 		 * \tparam _tTypeOut The output view/container type.
-		 * \tparam _tAvx2Func The AVX-2 function type.
-		 * \tparam _tFunc The function type.
 		 * \param _vIn The input view.
 		 * \param _vOut The output view.
-		 * \param _fAvxFunc A pointer to the function to call on each item in the view.
-		 * \param _fFunc A pointer to the function to call on each item in the view.
+		 * \param _pfKernel The kernel to call on each contiguous run of the views.
 		 * \throw If NN9_SAFETY_CHECK, throws if the views are not the same lengths.
 		 * \return Returns _vOut.
 		 **/
-		template <typename _tTypeIn, typename _tTypeOut, typename _tAvx2Func, typename _tFunc>
-		static _tTypeOut &											FuncAvx2( const _tTypeIn &_vIn, _tTypeOut &_vOut, _tAvx2Func _fAvxFunc, _tFunc _fFunc ) {
+		template <typename _tTypeIn, typename _tTypeOut>
+		static _tTypeOut &											KernelFunc( const _tTypeIn &_vIn, _tTypeOut &_vOut,
+			void (*_pfKernel)( const typename _tTypeIn::value_type *, typename _tTypeOut::value_type *, size_t ) ) {
 			using ValueTypeIn = typename _tTypeIn::value_type;
 			using ValueTypeOut = typename _tTypeOut::value_type;
 #ifdef NN9_SAFETY_CHECK
-			if ( _vIn.size() != _vOut.size() ) { throw std::runtime_error( "Math::FuncAvx2: The source and destination must both have the same number of elements." ); }
+			if ( _vIn.size() != _vOut.size() ) { throw std::runtime_error( "Math::KernelFunc: The source and destination must both have the same number of elements." ); }
 #endif		// #ifdef NN9_SAFETY_CHECK
-
-			const auto * pvtiIn = &_vIn[0];
-			auto * pvtoOut = &_vOut[0];
-			auto sSize = _vIn.size();
-
-			if constexpr ( nn9::Types::SimdInt<ValueTypeIn>() ) {
-				constexpr size_t sRegSize = sizeof( __m256i ) / sizeof( ValueTypeIn );
-				while ( sSize >= sRegSize ) {
-					auto mReg = _mm256_loadu_epi8( pvtiIn );
-					mReg = _fAvxFunc( mReg );
-					Intrin::scast<ValueTypeIn>( mReg, pvtoOut );
-					sSize -= sRegSize;
-					pvtiIn += sRegSize;
-					pvtoOut += sRegSize;
-				}
-			}
-			else if constexpr ( nn9::Types::SimdFloat<ValueTypeIn>() ) {
-				constexpr size_t sRegSize = sizeof( __m256 ) / sizeof( float );
-				while ( sSize >= sRegSize ) {
-					__m256 mReg;
-					if constexpr ( nn9::Types::IsFloat16<ValueTypeIn>() ) {
-						mReg = nn9::float16::Convert8Float16ToFloat32( pvtiIn );
-					}
-					else if constexpr ( nn9::Types::IsBFloat16<ValueTypeIn>() ) {
-						mReg = nn9::bfloat16::loadu_bf16_to_fp32_8( pvtiIn );
-					}
-					else if constexpr ( nn9::Types::Is32BitFloat<ValueTypeIn>() ) {
-						mReg = _mm256_loadu_ps( reinterpret_cast<const float *>(pvtiIn) );
-					}
-					mReg = _fAvxFunc( mReg );
-					Intrin::scast<ValueTypeIn>( mReg, pvtoOut );
-					sSize -= sRegSize;
-					pvtiIn += sRegSize;
-					pvtoOut += sRegSize;
-				}
-			}
-			else if constexpr ( nn9::Types::SimdDouble<ValueTypeIn>() ) {
-				constexpr size_t sRegSize = sizeof( __m256d ) / sizeof( ValueTypeIn );
-				while ( sSize >= sRegSize ) {
-					auto mReg = _mm256_loadu_pd( pvtiIn );
-					mReg = _fAvxFunc( mReg );
-					Intrin::scast<ValueTypeIn>( mReg, pvtoOut );
-					sSize -= sRegSize;
-					pvtiIn += sRegSize;
-					pvtoOut += sRegSize;
-				}
-			}
-
-			while ( sSize-- ) {
-				Intrin::scast( (*pvtiIn++), (*pvtoOut++) );
-			}
+			if ( ParallelRun( _vIn.size(), std::max( sizeof( ValueTypeIn ), sizeof( ValueTypeOut ) ), [&]( size_t _sStart, size_t _sTotal ) {
+					_pfKernel( &_vIn[_sStart], &_vOut[_sStart], _sTotal );
+				} ) ) { return _vOut; }
+			if ( _vIn.size() ) { _pfKernel( &_vIn[0], &_vOut[0], _vIn.size() ); }
 			return _vOut;
 		}
-#endif	// #ifdef __AVX2__
-
-
-		// ===============================
-		// Trigonometric Functions
-		// ===============================
-		/**
-		 * Computes element-wise cos().
-		 * 
-		 * \tparam _tType The view/container type.
-		 * \param _vValues The input/output view.
-		 * \return Returns _vValues.
-		 */
-		template <typename _tType>
-		static _tType &												Cos( _tType &_vValues ) {
-			using Type = typename _tType::value_type;
-			if constexpr ( Types::IsBool<Type>() ) {
-				// cos( 1 ) = 0.5403023058681397650.
-				// cos( 0 ) = 1.
-				return Func<_tType>( _vValues, [](auto x) { return true; } );
-			}
-			return Func<_tType>( _vValues, [](auto x) { return static_cast<_tType::value_type>(std::cos( static_cast<double>(x) )); } );
-		}
 
 		/**
-		 * Applies Cos() to an array of inputs.
+		 * Applies a Kernels table entry to a strided view.  Contiguous inner runs are processed in place; other runs are gathered into
+		 *	contiguous blocks, processed, and scattered back.
 		 * 
-		 * \param _tType The view/container type.
+		 * \tparam _tType The strided view type.
 		 * \param _vValues The input/output view to modify.
+		 * \param _pfKernel The kernel to call on each contiguous run of the view.
 		 * \return Returns _vValues.
 		 **/
 		template <typename _tType>
-		static std::vector<_tType> &								Cos( std::vector<_tType> &_vValues ) {
-			for ( auto & aThis : _vValues ) { Cos( aThis ); }
-			return _vValues;
+			requires IsStridedView<std::remove_cvref_t<_tType>>::value
+		static _tType &												KernelFunc( _tType &_vValues,
+			void (*_pfKernel)( const typename _tType::value_type *, typename _tType::value_type *, size_t ) ) {
+			using ValueType = typename _tType::value_type;
+			return StridedApply( _vValues, [&]( View<ValueType> &_vRun ) { KernelFunc<View<ValueType>>( _vRun, _pfKernel ); } );
 		}
 
 		/**
-		 * Computes element-wise cos().
+		 * Applies a Kernels table entry to a strided input view, storing the results in an output view.  Contiguous views are processed
+		 *	directly; others are gathered into contiguous blocks, processed, and scattered back.
 		 * 
 		 * \tparam _tTypeIn The input view/container type.
 		 * \tparam _tTypeOut The output view/container type.
 		 * \param _vIn The input view.
 		 * \param _vOut The output view.
+		 * \param _pfKernel The kernel to call on each contiguous run of the views.
+		 * \throw If NN9_SAFETY_CHECK, throws if the views are not the same lengths.
 		 * \return Returns _vOut.
-		 */
+		 **/
 		template <typename _tTypeIn, typename _tTypeOut>
-		static _tTypeOut &											Cos( const _tTypeIn &_vIn, _tTypeOut &_vOut ) {
-			if constexpr ( Types::IsBool<_tTypeIn>() ) {
-				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return true; } );
-			}
-			return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return static_cast<_tTypeIn::value_type>(std::cos( static_cast<double>(x) )); } );
+			requires (IsStridedView<std::remove_cvref_t<_tTypeIn>>::value || IsStridedView<std::remove_cvref_t<_tTypeOut>>::value)
+		static _tTypeOut &											KernelFunc( const _tTypeIn &_vIn, _tTypeOut &_vOut,
+			void (*_pfKernel)( const typename _tTypeIn::value_type *, typename _tTypeOut::value_type *, size_t ) ) {
+			using ValueTypeIn = typename _tTypeIn::value_type;
+			using ValueTypeOut = typename _tTypeOut::value_type;
+			return StridedApply( _vIn, _vOut, [&]( const View<ValueTypeIn> &_vRunIn, View<ValueTypeOut> &_vRunOut ) {
+				KernelFunc<View<ValueTypeIn>, View<ValueTypeOut>>( _vRunIn, _vRunOut, _pfKernel );
+			} );
 		}
 
 		/**
-		 * Applies Cos() to an array of inputs and outputs.
+		 * Gets the Kernels::NN9_KERNEL_TYPE of a type.
+		 * 
+		 * \tparam _tType The type.
+		 * \return Returns the index of _tType in the Kernels conversion tables, or Kernels::NN9_KT_TOTAL if the tables do not convert it.
+		 **/
+		template <typename _tType>
+		static constexpr Kernels::NN9_KERNEL_TYPE					KernelType() {
+			if constexpr ( Types::IsInt8<_tType>() ) { return Kernels::NN9_KT_INT8; }
+			else if constexpr ( Types::IsUint8<_tType>() ) { return Kernels::NN9_KT_UINT8; }
+			else if constexpr ( Types::IsInt16<_tType>() ) { return Kernels::NN9_KT_INT16; }
+			else if constexpr ( Types::IsUint16<_tType>() ) { return Kernels::NN9_KT_UINT16; }
+			else if constexpr ( Types::IsInt32<_tType>() ) { return Kernels::NN9_KT_INT32; }
+			else if constexpr ( Types::IsUint32<_tType>() ) { return Kernels::NN9_KT_UINT32; }
+			else if constexpr ( Types::IsFloat16<_tType>() ) { return Kernels::NN9_KT_FLOAT16; }
+			else if constexpr ( Types::IsBFloat16<_tType>() ) { return Kernels::NN9_KT_BFLOAT16; }
+			else if constexpr ( Types::Is32BitFloat<_tType>() ) { return Kernels::NN9_KT_FLOAT32; }
+			else if constexpr ( Types::Is64BitFloat<_tType>() ) { return Kernels::NN9_KT_FLOAT64; }
+			else { return Kernels::NN9_KT_TOTAL; }
+		}
+
+		/**
+		 * The type Kernels::Table() computes a type's arithmetic in when the result fits the type: float for half, bfloat16, float, and
+		 *	integers narrower than 32 bits (whose sums, differences, and saturated products and quotients float holds exactly), and double for
+		 *	everything else.
+		 */
+		template <typename _tType>
+		using TableReal = typename std::conditional<Types::SimdFloat<_tType>() || (Types::IsInt<_tType>() && sizeof( _tType ) < 4), float, double>::type;
+
+		/**
+		 * Widens the input view to _tReal in blocks through Kernels::Table(), hands each block to a kernel, and narrows the results to the
+		 *	output view.  The views are split across threads as Func() splits them.
 		 * 
+		 * \tparam _tReal The type the kernel works in (float or double).
 		 * \tparam _tTypeIn The input view/container type.
 		 * \tparam _tTypeOut The output view/container type.
+		 * \tparam _tKernel The kernel type, called with (const _tReal *, _tReal *, size_t).  The arrays may be the same.
 		 * \param _vIn The input view.
-		 * \param _vOut The output view.
-		 * \throw If NN9_SAFETY_CHECK, throws if _vIn and _vOut are not the same lengths.
-		 * \return Returns _vOut.
-		 */
-		template <typename _tTypeIn, typename _tTypeOut>
-		static std::vector<_tTypeOut> &								Cos( const std::vector<_tTypeIn> &_vIn, std::vector<_tTypeOut> &_vOut ) {
+		 * \param _vOut The output view.  May be _vIn.
+		 * \param _kKernel The kernel.
+		 * \param _bNarrow If true, results from integer inputs are narrowed to the input type before being converted to the output type, as
+		 *	the scalar paths that compute in the input type do.
+		 * \throw If NN9_SAFETY_CHECK, throws if the views are not the same lengths.
+		 * \return Returns false if the tables cannot convert the types, in which case nothing is written.
+		 **/
+		template <typename _tReal, typename _tTypeIn, typename _tTypeOut, typename _tKernel>
+		static bool													TableApply( const _tTypeIn &_vIn, _tTypeOut &_vOut, _tKernel _kKernel, bool _bNarrow ) {
+			using ValueTypeIn = typename _tTypeIn::value_type;
+			using ValueTypeOut = typename _tTypeOut::value_type;
+			constexpr Kernels::NN9_KERNEL_TYPE ktIn = KernelType<ValueTypeIn>();
+			constexpr Kernels::NN9_KERNEL_TYPE ktOut = KernelType<ValueTypeOut>();
+			if constexpr ( ktIn == Kernels::NN9_KT_TOTAL || ktOut == Kernels::NN9_KT_TOTAL ) {
+				static_cast<void>(_vIn); static_cast<void>(_vOut); static_cast<void>(_kKernel); static_cast<void>(_bNarrow);
+				return false;
+			}
+			else {
 #ifdef NN9_SAFETY_CHECK
-			if ( _vIn.size() != _vOut.size() ) { throw std::runtime_error( "Math::Cos: Input and outputs must have the same number of elements." ); }
+				if ( _vIn.size() != _vOut.size() ) { throw std::runtime_error( "Math::TableApply: Input and outputs must have the same number of elements." ); }
 #endif	// #ifdef NN9_SAFETY_CHECK
+				constexpr bool bCanNarrow = Types::IsInt<ValueTypeIn>() && !std::is_same<ValueTypeIn, ValueTypeOut>::value;
+				void (*pfToReal)( const void *, _tReal *, size_t );
+				void (*pfFromReal)( const _tReal *, void *, size_t );
+				void (*pfFromRealIn)( const _tReal *, void *, size_t );
+				TableConverters<_tReal>( ktIn, ktOut, pfToReal, pfFromReal, pfFromRealIn );
+				if ( !pfToReal || !pfFromReal ) { return false; }
+				constexpr size_t sNarrowBlock = bCanNarrow ? size_t( NN9_TK_BLOCK ) : 1;
+
+				auto kRun = [&]( size_t _sStart, size_t _sTotal ) {
+					NN9_ALIGN( 64 )
+					_tReal rBlock[NN9_TK_BLOCK];
+					NN9_ALIGN( 64 )
+					ValueTypeIn vtiNarrow[sNarrowBlock];
+					for ( size_t I = 0; I < _sTotal; I += NN9_TK_BLOCK ) {
+						size_t sBlock = std::min<size_t>( _sTotal - I, NN9_TK_BLOCK );
+						const ValueTypeIn * pIn = &_vIn[_sStart+I];
+						ValueTypeOut * pOut = &_vOut[_sStart+I];
+						if constexpr ( std::is_same<ValueTypeIn, _tReal>::value && std::is_same<ValueTypeOut, _tReal>::value ) {
+							_kKernel( pIn, pOut, sBlock );
+						}
+						else {
+							if constexpr ( std::is_same<ValueTypeIn, _tReal>::value ) { _kKernel( pIn, rBlock, sBlock ); }
+							else {
+								pfToReal( pIn, rBlock, sBlock );
+								_kKernel( rBlock, rBlock, sBlock );
+							}
+							if constexpr ( bCanNarrow ) {
+								if ( _bNarrow ) {
+									pfFromRealIn( rBlock, vtiNarrow, sBlock );
+									pfToReal( vtiNarrow, rBlock, sBlock );
+								}
+							}
+							pfFromReal( rBlock, pOut, sBlock );
+						}
+					}
+				};
+				if ( !ParallelRun( _vIn.size(), std::max( sizeof( ValueTypeIn ), sizeof( ValueTypeOut ) ), kRun ) && _vIn.size() ) {
+					kRun( 0, _vIn.size() );
+				}
+				return true;
+			}
+		}
 
-			for ( size_t i = 0; i < _vIn.size(); ++i ) { Cos( _vIn[i], _vOut[i] ); }
-			return _vOut;
+		/**
+		 * Runs TableApply() over an input view where either side may be a strided view.  Contiguous views are processed directly; others are
+		 *	gathered into contiguous blocks, processed, and scattered back.
+		 * 
+		 * \tparam _tReal The type the kernel works in (float or double).
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \tparam _tKernel The kernel type, called with (const _tReal *, _tReal *, size_t).
+		 * \param _vIn The input view.
+		 * \param _vOut The output view.
+		 * \param _kKernel The kernel.
+		 * \param _bNarrow If true, results from integer inputs are narrowed to the input type before being converted to the output type.
+		 * \throw If NN9_SAFETY_CHECK, throws if the views are not the same lengths.
+		 * \return Returns false if the tables cannot convert the types, in which case nothing is written.
+		 **/
+		template <typename _tReal, typename _tTypeIn, typename _tTypeOut, typename _tKernel>
+			requires (IsStridedView<std::remove_cvref_t<_tTypeIn>>::value || IsStridedView<std::remove_cvref_t<_tTypeOut>>::value)
+		static bool													TableApply( const _tTypeIn &_vIn, _tTypeOut &_vOut, _tKernel _kKernel, bool _bNarrow ) {
+			using ValueTypeIn = typename _tTypeIn::value_type;
+			using ValueTypeOut = typename _tTypeOut::value_type;
+			// An empty run tells whether the tables can convert the types.
+			const View<ValueTypeIn> vEmptyIn( nullptr, 0, nullptr );
+			View<ValueTypeOut> vEmptyOut( nullptr, 0, nullptr );
+			if ( !TableApply<_tReal, View<ValueTypeIn>, View<ValueTypeOut>>( vEmptyIn, vEmptyOut, _kKernel, false ) ) { return false; }
+			StridedApply( _vIn, _vOut, [&]( const View<ValueTypeIn> &_vRunIn, View<ValueTypeOut> &_vRunOut ) {
+				TableApply<_tReal, View<ValueTypeIn>, View<ValueTypeOut>>( _vRunIn, _vRunOut, _kKernel, _bNarrow );
+			} );
+			return true;
 		}
 
 		/**
-		 * Computes element-wise sin().
+		 * Runs TableApply() over a view in place.
 		 * 
+		 * \tparam _tReal The type the kernel works in (float or double).
 		 * \tparam _tType The view/container type.
-		 * \param _vValues The input/output view.
-		 * \return Returns _vValues.
-		 */
-		template <typename _tType>
-		static _tType &												Sin( _tType &_vValues ) {
-			using Type = typename _tType::value_type;
-			if constexpr ( Types::IsBool<Type>() ) {
-				// sin( 1 ) = 1.
-				// sin( 0 ) = 0.
-				//return Func<_tType>( _vValues, [](auto x) { return x; } );
-				return _vValues;	// Assuming well formed bool values, no changes will be made via this operation.
-			}
-			return Func<_tType>( _vValues, [](auto x) { return static_cast<_tType::value_type>(std::sin( static_cast<double>(x) )); } );
+		 * \tparam _tKernel The kernel type, called with (const _tReal *, _tReal *, size_t).
+		 * \param _vValues The input/output view to modify.
+		 * \param _kKernel The kernel.
+		 * \return Returns false if the tables cannot convert the type, in which case nothing is written.
+		 **/
+		template <typename _tReal, typename _tType, typename _tKernel>
+		static bool													TableApply( _tType &_vValues, _tKernel _kKernel ) {
+			return TableApply<_tReal, _tType, _tType>( _vValues, _vValues, _kKernel, false );
 		}
 
 		/**
-		 * Applies Sin() to an array of inputs.
+		 * Runs TableApply() over a strided view in place.  Contiguous inner runs are processed in place; other runs are gathered into
+		 *	contiguous blocks, processed, and scattered back.
 		 * 
-		 * \param _tType The view/container type.
+		 * \tparam _tReal The type the kernel works in (float or double).
+		 * \tparam _tType The strided view type.
+		 * \tparam _tKernel The kernel type, called with (const _tReal *, _tReal *, size_t).
 		 * \param _vValues The input/output view to modify.
-		 * \return Returns _vValues.
+		 * \param _kKernel The kernel.
+		 * \return Returns false if the tables cannot convert the type, in which case nothing is written.
 		 **/
-		template <typename _tType>
-		static std::vector<_tType> &								Sin( std::vector<_tType> &_vValues ) {
-			for ( auto & aThis : _vValues ) { Sin( aThis ); }
-			return _vValues;
+		template <typename _tReal, typename _tType, typename _tKernel>
+			requires IsStridedView<std::remove_cvref_t<_tType>>::value
+		static bool													TableApply( _tType &_vValues, _tKernel _kKernel ) {
+			using ValueType = typename _tType::value_type;
+			View<ValueType> vEmpty( nullptr, 0, nullptr );
+			if ( !TableApply<_tReal, View<ValueType>>( vEmpty, _kKernel ) ) { return false; }
+			StridedApply( _vValues, [&]( View<ValueType> &_vRun ) { TableApply<_tReal, View<ValueType>>( _vRun, _kKernel ); } );
+			return true;
 		}
 
 		/**
-		 * Computes element-wise sin().
+		 * Gets the Kernels::Table() conversions between 2 element types and _tReal.
 		 * 
-		 * \tparam _tTypeIn The input view/container type.
-		 * \tparam _tTypeOut The output view/container type.
-		 * \param _vIn The input view.
-		 * \param _vOut The output view.
-		 * \return Returns _vOut.
-		 */
-		template <typename _tTypeIn, typename _tTypeOut>
-		static _tTypeOut &											Sin( const _tTypeIn &_vIn, _tTypeOut &_vOut ) {
-			if constexpr ( Types::IsBool<_tTypeIn>() ) {
-				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return x; } );
+		 * \tparam _tReal float or double.
+		 * \param _ktIn The input type.
+		 * \param _ktOut The output type.
+		 * \param _pfToReal Receives the conversion from _ktIn.
+		 * \param _pfFromReal Receives the conversion to _ktOut.
+		 * \param _pfFromRealIn Receives the conversion to _ktIn.
+		 **/
+		template <typename _tReal>
+		static inline void											TableConverters( Kernels::NN9_KERNEL_TYPE _ktIn, Kernels::NN9_KERNEL_TYPE _ktOut,
+			void (*&_pfToReal)( const void *, _tReal *, size_t ), void (*&_pfFromReal)( const _tReal *, void *, size_t ),
+			void (*&_pfFromRealIn)( const _tReal *, void *, size_t ) ) {
+			const Kernels::NN9_TABLE & tTable = Kernels::Table();
+			if constexpr ( std::is_same<_tReal, float>::value ) {
+				_pfToReal = tTable.pfToF32[_ktIn];
+				_pfFromReal = tTable.pfFromF32[_ktOut];
+				_pfFromRealIn = tTable.pfFromF32[_ktIn];
+			}
+			else {
+				_pfToReal = tTable.pfToF64[_ktIn];
+				_pfFromReal = tTable.pfFromF64[_ktOut];
+				_pfFromRealIn = tTable.pfFromF64[_ktIn];
 			}
-			return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return static_cast<_tTypeIn::value_type>(std::sin( static_cast<double>(x) )); } );
 		}
 
 		/**
-		 * Applies Sin() to an array of inputs and outputs.
+		 * Gets a Kernels::NN9_KERNEL_BINARY entry of Kernels::Table().
+		 * 
+		 * \tparam _tReal float or double.
+		 * \param _kbOp The operation.
+		 * \return Returns pfBinaryF32[_kbOp] or pfBinaryF64[_kbOp], which may be nullptr.
+		 **/
+		template <typename _tReal>
+		static inline auto											TableBinaryKernel( Kernels::NN9_KERNEL_BINARY _kbOp ) {
+			if constexpr ( std::is_same<_tReal, float>::value ) { return Kernels::Table().pfBinaryF32[_kbOp]; }
+			else { return Kernels::Table().pfBinaryF64[_kbOp]; }
+		}
+
+		/**
+		 * Applies a pair of Kernels table entries to the input view, storing the results in the output view.  Half, bfloat16, and float
+		 *	inputs are widened to float and handed to _pfF32; everything else is widened to double and handed to _pfF64.  Either view may be
+		 *	strided.
 		 * 
 		 * \tparam _tTypeIn The input view/container type.
 		 * \tparam _tTypeOut The output view/container type.
 		 * \param _vIn The input view.
-		 * \param _vOut The output view.
-		 * \throw If NN9_SAFETY_CHECK, throws if _vIn and _vOut are not the same lengths.
-		 * \return Returns _vOut.
-		 */
-		template <typename _tTypeIn, typename _tTypeOut>
+		 * \param _vOut The output view.  May be _vIn.
+		 * \param _pfF32 The float kernel.
+		 * \param _pfF64 The double kernel.
+		 * \param _bNarrow If true, results from integer inputs are narrowed to the input type before being converted to the output type, as
+		 *	SimdUnary()'s scalar path does.
+		 * \throw If NN9_SAFETY_CHECK, throws if the views are not the same lengths.
+		 * \return Returns false if the tables have no kernels for the types, in which case nothing is written.
+		 **/
+		template <typename _tTypeIn, typename _tTypeOut>
+		static bool													TableUnary( const _tTypeIn &_vIn, _tTypeOut &_vOut,
+			void (*_pfF32)( const float *, float *, size_t ), void (*_pfF64)( const double *, double *, size_t ), bool _bNarrow = false ) {
+			if constexpr ( Types::SimdFloat<typename _tTypeIn::value_type>() ) { return _pfF32 && TableApply<float>( _vIn, _vOut, _pfF32, _bNarrow ); }
+			else { return _pfF64 && TableApply<double>( _vIn, _vOut, _pfF64, _bNarrow ); }
+		}
+
+		/**
+		 * Applies a pair of Kernels table entries to the view in place.  The view may be strided.
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \param _vValues The input/output view to modify.
+		 * \param _pfF32 The float kernel.
+		 * \param _pfF64 The double kernel.
+		 * \return Returns false if the tables have no kernels for the type, in which case nothing is written.
+		 **/
+		template <typename _tType>
+		static bool													TableUnary( _tType &_vValues,
+			void (*_pfF32)( const float *, float *, size_t ), void (*_pfF64)( const double *, double *, size_t ) ) {
+			if constexpr ( Types::SimdFloat<typename _tType::value_type>() ) { return _pfF32 && TableApply<float>( _vValues, _pfF32 ); }
+			else { return _pfF64 && TableApply<double>( _vValues, _pfF64 ); }
+		}
+
+		/**
+		 * Applies a Kernels::NN9_KERNEL_UNARY operation to the input view, storing the results in the output view.
+		 * 
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vIn The input view.
+		 * \param _vOut The output view.
+		 * \param _kuOp The operation.
+		 * \return Returns false if the tables have no kernels for the types, in which case nothing is written.
+		 **/
+		template <typename _tTypeIn, typename _tTypeOut>
+		static bool													TableUnary( const _tTypeIn &_vIn, _tTypeOut &_vOut, Kernels::NN9_KERNEL_UNARY _kuOp ) {
+			const Kernels::NN9_TABLE & tTable = Kernels::Table();
+			return TableUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, tTable.pfUnaryF32[_kuOp], tTable.pfUnaryF64[_kuOp] );
+		}
+
+		/**
+		 * Applies a Kernels::NN9_KERNEL_UNARY operation to the view in place.
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \param _vValues The input/output view to modify.
+		 * \param _kuOp The operation.
+		 * \return Returns false if the tables have no kernels for the type, in which case nothing is written.
+		 **/
+		template <typename _tType>
+		static bool													TableUnary( _tType &_vValues, Kernels::NN9_KERNEL_UNARY _kuOp ) {
+			const Kernels::NN9_TABLE & tTable = Kernels::Table();
+			return TableUnary<_tType>( _vValues, tTable.pfUnaryF32[_kuOp], tTable.pfUnaryF64[_kuOp] );
+		}
+
+		/**
+		 * Computes x (op) s for each item of the input view through Kernels::Table(), storing the results in the output view.  Either view
+		 *	may be strided.
+		 * 
+		 * \tparam _tReal The type to compute in (float or double).
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vIn The input view.
+		 * \param _vOut The output view.  May be _vIn.
+		 * \param _kbOp The operation.
+		 * \param _rScalar The right-hand operand.
+		 * \param _bNarrow If true, results from integer inputs are narrowed to the input type before being converted to the output type.
+		 * \throw If NN9_SAFETY_CHECK, throws if the views are not the same lengths.
+		 * \return Returns false if the tables have no kernels for the types, in which case nothing is written.
+		 **/
+		template <typename _tReal, typename _tTypeIn, typename _tTypeOut>
+		static bool													TableScalar( const _tTypeIn &_vIn, _tTypeOut &_vOut, Kernels::NN9_KERNEL_BINARY _kbOp, _tReal _rScalar,
+			bool _bNarrow = false ) {
+			auto pfKernel = TableBinaryKernel<_tReal>( _kbOp );
+			if ( !pfKernel ) { return false; }
+			return TableApply<_tReal>( _vIn, _vOut, [pfKernel, _rScalar]( const _tReal * _prIn, _tReal * _prOut, size_t _sTotal ) {
+				pfKernel( _prIn, 1, &_rScalar, 0, _prOut, _sTotal );
+			}, _bNarrow );
+		}
+
+		/**
+		 * Computes x (op) s for each item of the view in place through Kernels::Table().  The view may be strided.
+		 * 
+		 * \tparam _tReal The type to compute in (float or double).
+		 * \tparam _tType The view/container type.
+		 * \param _vValues The input/output view to modify.
+		 * \param _kbOp The operation.
+		 * \param _rScalar The right-hand operand.
+		 * \return Returns false if the tables have no kernels for the type, in which case nothing is written.
+		 **/
+		template <typename _tReal, typename _tType>
+		static bool													TableScalar( _tType &_vValues, Kernels::NN9_KERNEL_BINARY _kbOp, _tReal _rScalar ) {
+			auto pfKernel = TableBinaryKernel<_tReal>( _kbOp );
+			if ( !pfKernel ) { return false; }
+			return TableApply<_tReal>( _vValues, [pfKernel, _rScalar]( const _tReal * _prIn, _tReal * _prOut, size_t _sTotal ) {
+				pfKernel( _prIn, 1, &_rScalar, 0, _prOut, _sTotal );
+			} );
+		}
+
+		/**
+		 * Computes a (op) b for each pair of items in two flat views through Kernels::Table(), storing the results in the output view.  Either
+		 *	input may have a single element, in which case that element is paired with every item in the other input.  The inputs are widened
+		 *	to _tReal in blocks and the results narrowed to the output type.  The views are split across threads as Func() splits them.
+		 * 
+		 * \tparam _tReal The type to compute in (float or double).
+		 * \tparam _tTypeA The left input view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vA The left input view.
+		 * \param _vB The right input view.
+		 * \param _vOut The output view.
+		 * \param _kbOp The operation.
+		 * \param _bNarrow If true, results from integer inputs are narrowed to the input type before being converted to the output type.
+		 * \throw If NN9_SAFETY_CHECK, throws if an input has neither 1 element nor as many elements as the output.
+		 * \return Returns false if the tables have no kernels for the types, in which case nothing is written.
+		 **/
+		template <typename _tReal, typename _tTypeA, typename _tTypeB, typename _tTypeOut>
+		static bool													TableBinary( const _tTypeA &_vA, const _tTypeB &_vB, _tTypeOut &_vOut, Kernels::NN9_KERNEL_BINARY _kbOp,
+			bool _bNarrow ) {
+			using ValueType = typename _tTypeA::value_type;
+			using ValueTypeOut = typename _tTypeOut::value_type;
+			static_assert( std::is_same<ValueType, typename _tTypeB::value_type>::value, "Math::TableBinary: Both inputs must have the same type." );
+			constexpr Kernels::NN9_KERNEL_TYPE ktIn = KernelType<ValueType>();
+			constexpr Kernels::NN9_KERNEL_TYPE ktOut = KernelType<ValueTypeOut>();
+			if constexpr ( ktIn == Kernels::NN9_KT_TOTAL || ktOut == Kernels::NN9_KT_TOTAL ) {
+				static_cast<void>(_vA); static_cast<void>(_vB); static_cast<void>(_vOut); static_cast<void>(_kbOp); static_cast<void>(_bNarrow);
+				return false;
+			}
+			else {
+				auto pfKernel = TableBinaryKernel<_tReal>( _kbOp );
+				void (*pfToReal)( const void *, _tReal *, size_t );
+				void (*pfFromReal)( const _tReal *, void *, size_t );
+				void (*pfFromRealIn)( const _tReal *, void *, size_t );
+				TableConverters<_tReal>( ktIn, ktOut, pfToReal, pfFromReal, pfFromRealIn );
+				if ( !pfKernel || !pfToReal || !pfFromReal ) { return false; }
+#ifdef NN9_SAFETY_CHECK
+				if ( !BinarySizesMatch( _vA, _vB, _vOut ) ) { throw std::runtime_error( "Math::TableBinary: Inputs must have 1 element or the same number of elements as the output." ); }
+#endif	// #ifdef NN9_SAFETY_CHECK
+				const size_t sSize = _vOut.size();
+				if ( !sSize ) { return true; }
+				constexpr bool bInReal = std::is_same<ValueType, _tReal>::value;
+				constexpr bool bCanNarrow = Types::IsInt<ValueType>() && !std::is_same<ValueType, ValueTypeOut>::value;
+				constexpr bool bOutReal = std::is_same<ValueTypeOut, _tReal>::value && !bCanNarrow;
+				constexpr size_t sInBlock = bInReal ? 1 : size_t( NN9_TK_BLOCK );
+				constexpr size_t sOutBlock = bOutReal ? 1 : size_t( NN9_TK_BLOCK );
+				constexpr size_t sNarrowBlock = bCanNarrow ? size_t( NN9_TK_BLOCK ) : 1;
+				const bool bSplatA = _vA.size() == 1;
+				const bool bSplatB = _vB.size() == 1;
+				// A single element is widened once and paired with every item.
+				_tReal rSplatA = _tReal( 0 ), rSplatB = _tReal( 0 );
+				if ( bSplatA ) { pfToReal( &_vA[0], &rSplatA, 1 ); }
+				if ( bSplatB ) { pfToReal( &_vB[0], &rSplatB, 1 ); }
+
+				auto kRun = [&]( size_t _sStart, size_t _sTotal ) {
+					NN9_ALIGN( 64 )
+					_tReal rBlockA[sInBlock];
+					NN9_ALIGN( 64 )
+					_tReal rBlockB[sInBlock];
+					NN9_ALIGN( 64 )
+					_tReal rBlockOut[sOutBlock];
+					NN9_ALIGN( 64 )
+					ValueType vtNarrow[sNarrowBlock];
+					for ( size_t I = 0; I < _sTotal; I += NN9_TK_BLOCK ) {
+						size_t sBlock = std::min<size_t>( _sTotal - I, NN9_TK_BLOCK );
+						const _tReal * prA = &rSplatA;
+						const _tReal * prB = &rSplatB;
+						if ( !bSplatA ) {
+							if constexpr ( bInReal ) { prA = &_vA[_sStart+I]; }
+							else {
+								pfToReal( &_vA[_sStart+I], rBlockA, sBlock );
+								prA = rBlockA;
+							}
+						}
+						if ( !bSplatB ) {
+							if constexpr ( bInReal ) { prB = &_vB[_sStart+I]; }
+							else {
+								pfToReal( &_vB[_sStart+I], rBlockB, sBlock );
+								prB = rBlockB;
+							}
+						}
+						if constexpr ( bOutReal ) { pfKernel( prA, bSplatA ? 0 : 1, prB, bSplatB ? 0 : 1, &_vOut[_sStart+I], sBlock ); }
+						else {
+							pfKernel( prA, bSplatA ? 0 : 1, prB, bSplatB ? 0 : 1, rBlockOut, sBlock );
+							if constexpr ( bCanNarrow ) {
+								if ( _bNarrow ) {
+									pfFromRealIn( rBlockOut, vtNarrow, sBlock );
+									pfToReal( vtNarrow, rBlockOut, sBlock );
+								}
+							}
+							pfFromReal( rBlockOut, &_vOut[_sStart+I], sBlock );
+						}
+					}
+				};
+				if ( !ParallelRun( sSize, std::max( sizeof( ValueType ), sizeof( ValueTypeOut ) ), kRun ) ) { kRun( 0, sSize ); }
+				return true;
+			}
+		}
+
+		/**
+		 * Applies a pair of Kernels table entries to the view, or the scalar function if the tables have no kernels for the type.  Half,
+		 *	bfloat16, and float values are computed as float, doubles as double, and everything else through double.
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \tparam _tFunc The scalar function type, called with double.
+		 * \param _vValues The input/output view to modify.
+		 * \param _pfF32 The float kernel.
+		 * \param _pfF64 The double kernel.
+		 * \param _fFunc The function to call on each item when the tables cannot be used.
+		 * \return Returns _vValues.
+		 **/
+		template <typename _tType, typename _tFunc>
+		static _tType &												SimdUnary( _tType &_vValues,
+			void (*_pfF32)( const float *, float *, size_t ), void (*_pfF64)( const double *, double *, size_t ), _tFunc _fFunc ) {
+			using Type = typename _tType::value_type;
+			if ( TableUnary<_tType>( _vValues, _pfF32, _pfF64 ) ) { return _vValues; }
+			return Func<_tType>( _vValues, [_fFunc](auto x) { return static_cast<Type>(_fFunc( static_cast<double>(x) )); } );
+		}
+
+		/**
+		 * Applies a pair of Kernels table entries to the input view, storing the results in the output view, or the scalar function if the
+		 *	tables have no kernels for the types.  Half, bfloat16, and float values are computed as float, doubles as double, and everything
+		 *	else through double.
+		 * 
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \tparam _tFunc The scalar function type, called with double.
+		 * \param _vIn The input view.
+		 * \param _vOut The output view.
+		 * \param _pfF32 The float kernel.
+		 * \param _pfF64 The double kernel.
+		 * \param _fFunc The function to call on each item when the tables cannot be used.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeIn, typename _tTypeOut, typename _tFunc>
+		static _tTypeOut &											SimdUnary( const _tTypeIn &_vIn, _tTypeOut &_vOut,
+			void (*_pfF32)( const float *, float *, size_t ), void (*_pfF64)( const double *, double *, size_t ), _tFunc _fFunc ) {
+			using TypeIn = typename _tTypeIn::value_type;
+			if ( TableUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, _pfF32, _pfF64, true ) ) { return _vOut; }
+			return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_fFunc](auto x) { return static_cast<TypeIn>(_fFunc( static_cast<double>(x) )); } );
+		}
+
+		/**
+		 * Applies a Kernels::NN9_KERNEL_UNARY operation to the view, or the scalar function if the tables have no kernels for the type.
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \tparam _tFunc The scalar function type, called with double.
+		 * \param _vValues The input/output view to modify.
+		 * \param _kuOp The operation.
+		 * \param _fFunc The function to call on each item when the tables cannot be used.
+		 * \return Returns _vValues.
+		 **/
+		template <typename _tType, typename _tFunc>
+		static _tType &												SimdUnary( _tType &_vValues, Kernels::NN9_KERNEL_UNARY _kuOp, _tFunc _fFunc ) {
+			const Kernels::NN9_TABLE & tTable = Kernels::Table();
+			return SimdUnary<_tType>( _vValues, tTable.pfUnaryF32[_kuOp], tTable.pfUnaryF64[_kuOp], _fFunc );
+		}
+
+		/**
+		 * Applies a Kernels::NN9_KERNEL_UNARY operation to the input view, storing the results in the output view, or the scalar function if
+		 *	the tables have no kernels for the types.
+		 * 
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \tparam _tFunc The scalar function type, called with double.
+		 * \param _vIn The input view.
+		 * \param _vOut The output view.
+		 * \param _kuOp The operation.
+		 * \param _fFunc The function to call on each item when the tables cannot be used.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeIn, typename _tTypeOut, typename _tFunc>
+		static _tTypeOut &											SimdUnary( const _tTypeIn &_vIn, _tTypeOut &_vOut, Kernels::NN9_KERNEL_UNARY _kuOp, _tFunc _fFunc ) {
+			const Kernels::NN9_TABLE & tTable = Kernels::Table();
+			return SimdUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, tTable.pfUnaryF32[_kuOp], tTable.pfUnaryF64[_kuOp], _fFunc );
+		}
+
+		/**
+		 * Applies the given function to each pair of items in two views.  Either input may have a single element, in which case that element is
+		 *	paired with every item in the other input.
+		 * 
+		 * \tparam _tTypeA The left input view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \tparam _tFunc The function type.
+		 * \param _vA The left input view.
+		 * \param _vB The right input view.
+		 * \param _vOut The output view.
+		 * \param _fFunc A pointer to the function to call on each pair of items.
+		 * \throw If NN9_SAFETY_CHECK, throws if an input has neither 1 element nor as many elements as the output.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeA, typename _tTypeB, typename _tTypeOut, typename _tFunc>
+		static _tTypeOut &											BinaryFunc( const _tTypeA &_vA, const _tTypeB &_vB, _tTypeOut &_vOut, _tFunc _fFunc ) {
+#ifdef NN9_SAFETY_CHECK
+			if ( !BinarySizesMatch( _vA, _vB, _vOut ) ) { throw std::runtime_error( "Math::BinaryFunc: Inputs must have 1 element or the same number of elements as the output." ); }
+#endif	// #ifdef NN9_SAFETY_CHECK
+			const size_t sSize = _vOut.size();
+			if ( !sSize ) { return _vOut; }
+
+			const auto * pA = &_vA[0];
+			const auto * pB = &_vB[0];
+			auto * pOut = &_vOut[0];
+			const size_t sStrideA = _vA.size() == 1 ? 0 : 1;
+			const size_t sStrideB = _vB.size() == 1 ? 0 : 1;
+			for ( size_t I = 0; I < sSize; ++I ) {
+				Intrin::scast( _fFunc( pA[I*sStrideA], pB[I*sStrideB] ), pOut[I] );
+			}
+			return _vOut;
+		}
+
+
+		// ===============================
+		// Trigonometric Functions
+		// ===============================
+		/**
+		 * Computes element-wise cos().
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \param _vValues The input/output view.
+		 * \return Returns _vValues.
+		 */
+		template <typename _tType>
+		static _tType &												Cos( _tType &_vValues ) {
+			using Type = typename _tType::value_type;
+			if constexpr ( Types::IsBool<Type>() ) {
+				// cos( 1 ) = 0.5403023058681397650.
+				// cos( 0 ) = 1.
+				return Func<_tType>( _vValues, [](auto x) { return true; } );
+			}
+			return SimdUnary<_tType>( _vValues, Kernels::NN9_KU_COS, [](auto x) { return std::cos( x ); } );
+		}
+
+		/**
+		 * Applies Cos() to an array of inputs.
+		 * 
+		 * \param _tType The view/container type.
+		 * \param _vValues The input/output view to modify.
+		 * \return Returns _vValues.
+		 **/
+		template <typename _tType>
+		static std::vector<_tType> &								Cos( std::vector<_tType> &_vValues ) {
+			for ( auto & aThis : _vValues ) { Cos( aThis ); }
+			return _vValues;
+		}
+
+		/**
+		 * Computes element-wise cos().
+		 * 
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vIn The input view.
+		 * \param _vOut The output view.
+		 * \return Returns _vOut.
+		 */
+		template <typename _tTypeIn, typename _tTypeOut>
+		static _tTypeOut &											Cos( const _tTypeIn &_vIn, _tTypeOut &_vOut ) {
+			if constexpr ( Types::IsBool<_tTypeIn>() ) {
+				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return true; } );
+			}
+			return SimdUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::NN9_KU_COS, [](auto x) { return std::cos( x ); } );
+		}
+
+		/**
+		 * Applies Cos() to an array of inputs and outputs.
+		 * 
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vIn The input view.
+		 * \param _vOut The output view.
+		 * \throw If NN9_SAFETY_CHECK, throws if _vIn and _vOut are not the same lengths.
+		 * \return Returns _vOut.
+		 */
+		template <typename _tTypeIn, typename _tTypeOut>
+		static std::vector<_tTypeOut> &								Cos( const std::vector<_tTypeIn> &_vIn, std::vector<_tTypeOut> &_vOut ) {
+#ifdef NN9_SAFETY_CHECK
+			if ( _vIn.size() != _vOut.size() ) { throw std::runtime_error( "Math::Cos: Input and outputs must have the same number of elements." ); }
+#endif	// #ifdef NN9_SAFETY_CHECK
+
+			for ( size_t i = 0; i < _vIn.size(); ++i ) { Cos( _vIn[i], _vOut[i] ); }
+			return _vOut;
+		}
+
+		/**
+		 * Computes element-wise sin().
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \param _vValues The input/output view.
+		 * \return Returns _vValues.
+		 */
+		template <typename _tType>
+		static _tType &												Sin( _tType &_vValues ) {
+			using Type = typename _tType::value_type;
+			if constexpr ( Types::IsBool<Type>() ) {
+				// sin( 1 ) = 1.
+				// sin( 0 ) = 0.
+				//return Func<_tType>( _vValues, [](auto x) { return x; } );
+				return _vValues;	// Assuming well formed bool values, no changes will be made via this operation.
+			}
+			return SimdUnary<_tType>( _vValues, Kernels::NN9_KU_SIN, [](auto x) { return std::sin( x ); } );
+		}
+
+		/**
+		 * Applies Sin() to an array of inputs.
+		 * 
+		 * \param _tType The view/container type.
+		 * \param _vValues The input/output view to modify.
+		 * \return Returns _vValues.
+		 **/
+		template <typename _tType>
+		static std::vector<_tType> &								Sin( std::vector<_tType> &_vValues ) {
+			for ( auto & aThis : _vValues ) { Sin( aThis ); }
+			return _vValues;
+		}
+
+		/**
+		 * Computes element-wise sin().
+		 * 
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vIn The input view.
+		 * \param _vOut The output view.
+		 * \return Returns _vOut.
+		 */
+		template <typename _tTypeIn, typename _tTypeOut>
+		static _tTypeOut &											Sin( const _tTypeIn &_vIn, _tTypeOut &_vOut ) {
+			if constexpr ( Types::IsBool<_tTypeIn>() ) {
+				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return x; } );
+			}
+			return SimdUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::NN9_KU_SIN, [](auto x) { return std::sin( x ); } );
+		}
+
+		/**
+		 * Applies Sin() to an array of inputs and outputs.
+		 * 
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vIn The input view.
+		 * \param _vOut The output view.
+		 * \throw If NN9_SAFETY_CHECK, throws if _vIn and _vOut are not the same lengths.
+		 * \return Returns _vOut.
+		 */
+		template <typename _tTypeIn, typename _tTypeOut>
 		static std::vector<_tTypeOut> &								Sin( const std::vector<_tTypeIn> &_vIn, std::vector<_tTypeOut> &_vOut ) {
 #ifdef NN9_SAFETY_CHECK
 			if ( _vIn.size() != _vOut.size() ) { throw std::runtime_error( "Math::Sin: Input and outputs must have the same number of elements." ); }
@@ -1396,7 +1440,13 @@ namespace nn9 {
 				//return Func<_tType>( _vValues, [](auto x) { return x; } );
 				return _vValues;	// Assuming well formed bool values, no changes will be made via this operation.
 			}
-			return Func<_tType>( _vValues, [](auto x) { return static_cast<_tType::value_type>(std::tanh( static_cast<double>(x) )); } );
+			if constexpr ( Types::Is32BitFloat<Type>() ) {
+				return KernelFunc<_tType>( _vValues, Kernels::Table().pfTanhF32 );
+			}
+			if constexpr ( Types::Is64BitFloat<Type>() ) {
+				return KernelFunc<_tType>( _vValues, Kernels::Table().pfTanhF64 );
+			}
+			return SimdUnary<_tType>( _vValues, Kernels::Table().pfTanhF32, Kernels::Table().pfTanhF64, [](auto x) { return std::tanh( x ); } );
 		}
 
 		/**
@@ -1423,10 +1473,19 @@ namespace nn9 {
 		 */
 		template <typename _tTypeIn, typename _tTypeOut>
 		static _tTypeOut &											Tanh( const _tTypeIn &_vIn, _tTypeOut &_vOut ) {
+			using TypeIn = typename _tTypeIn::value_type;
 			if constexpr ( Types::IsBool<_tTypeIn>() ) {
 				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return x; } );
 			}
-			return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return static_cast<_tTypeIn::value_type>(std::tanh( static_cast<double>(x) )); } );
+			if constexpr ( std::is_same<TypeIn, typename _tTypeOut::value_type>::value ) {
+				if constexpr ( Types::Is32BitFloat<TypeIn>() ) {
+					return KernelFunc<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::Table().pfTanhF32 );
+				}
+				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
+					return KernelFunc<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::Table().pfTanhF64 );
+				}
+			}
+			return SimdUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::Table().pfTanhF32, Kernels::Table().pfTanhF64, [](auto x) { return std::tanh( x ); } );
 		}
 
 		/**
@@ -1674,7 +1733,13 @@ namespace nn9 {
 				// exp( 0 ) = 1.
 				return Func<_tType>( _vValues, [](auto x) { return true; } );
 			}
-			return Func<_tType>( _vValues, [](auto x) { return static_cast<_tType::value_type>(std::exp( static_cast<double>(x) )); } );
+			if constexpr ( Types::Is32BitFloat<Type>() ) {
+				return KernelFunc<_tType>( _vValues, Kernels::Table().pfExpF32 );
+			}
+			if constexpr ( Types::Is64BitFloat<Type>() ) {
+				return KernelFunc<_tType>( _vValues, Kernels::Table().pfExpF64 );
+			}
+			return SimdUnary<_tType>( _vValues, Kernels::Table().pfExpF32, Kernels::Table().pfExpF64, [](auto x) { return std::exp( x ); } );
 		}
 
 		/**
@@ -1701,10 +1766,19 @@ namespace nn9 {
 		 */
 		template <typename _tTypeIn, typename _tTypeOut>
 		static _tTypeOut &											Exp( const _tTypeIn &_vIn, _tTypeOut &_vOut ) {
+			using TypeIn = typename _tTypeIn::value_type;
 			if constexpr ( Types::IsBool<_tTypeIn>() ) {
 				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return true; } );
 			}
-			return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return static_cast<_tTypeIn::value_type>(std::exp( static_cast<double>(x) )); } );
+			if constexpr ( std::is_same<TypeIn, typename _tTypeOut::value_type>::value ) {
+				if constexpr ( Types::Is32BitFloat<TypeIn>() ) {
+					return KernelFunc<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::Table().pfExpF32 );
+				}
+				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
+					return KernelFunc<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::Table().pfExpF64 );
+				}
+			}
+			return SimdUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::Table().pfExpF32, Kernels::Table().pfExpF64, [](auto x) { return std::exp( x ); } );
 		}
 
 		/**
@@ -1742,7 +1816,13 @@ namespace nn9 {
 				// log( 0 ) = -inf.
 				return Func<_tType>( _vValues, [](auto x) { return !x; } );
 			}
-			return Func<_tType>( _vValues, [](auto x) { return static_cast<_tType::value_type>(std::log( static_cast<double>(x) )); } );
+			if constexpr ( Types::Is32BitFloat<Type>() ) {
+				return KernelFunc<_tType>( _vValues, Kernels::Table().pfLogF32 );
+			}
+			if constexpr ( Types::Is64BitFloat<Type>() ) {
+				return KernelFunc<_tType>( _vValues, Kernels::Table().pfLogF64 );
+			}
+			return SimdUnary<_tType>( _vValues, Kernels::Table().pfLogF32, Kernels::Table().pfLogF64, [](auto x) { return std::log( x ); } );
 		}
 
 		/**
@@ -1769,10 +1849,19 @@ namespace nn9 {
 		 */
 		template <typename _tTypeIn, typename _tTypeOut>
 		static _tTypeOut &											Log( const _tTypeIn &_vIn, _tTypeOut &_vOut ) {
+			using TypeIn = typename _tTypeIn::value_type;
 			if constexpr ( Types::IsBool<_tTypeIn>() ) {
 				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return !x; } );
 			}
-			return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return static_cast<_tTypeIn::value_type>(std::log( static_cast<double>(x) )); } );
+			if constexpr ( std::is_same<TypeIn, typename _tTypeOut::value_type>::value ) {
+				if constexpr ( Types::Is32BitFloat<TypeIn>() ) {
+					return KernelFunc<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::Table().pfLogF32 );
+				}
+				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
+					return KernelFunc<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::Table().pfLogF64 );
+				}
+			}
+			return SimdUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::Table().pfLogF32, Kernels::Table().pfLogF64, [](auto x) { return std::log( x ); } );
 		}
 
 		/**
@@ -2014,7 +2103,7 @@ namespace nn9 {
 				// expm1( 0 ) = 0.
 				return Func<_tType>( _vValues, [](auto x) { return x; } );
 			}
-			return Func<_tType>( _vValues, [](auto x) { return std::expm1( static_cast<double>(x) ); } );
+			return SimdUnary<_tType>( _vValues, Kernels::NN9_KU_EXPM1, [](auto x) { return std::expm1( x ); } );
 		}
 
 		/**
@@ -2044,7 +2133,7 @@ namespace nn9 {
 			if constexpr ( Types::IsBool<_tTypeIn>() ) {
 				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return x; } );
 			}
-			return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return std::expm1( static_cast<double>(x) ); } );
+			return SimdUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::NN9_KU_EXPM1, [](auto x) { return std::expm1( x ); } );
 		}
 
 		/**
@@ -2150,7 +2239,7 @@ namespace nn9 {
 				// log1p( 0 ) = 0.
 				return Func<_tType>( _vValues, [](auto x) { return x; } );
 			}
-			return Func<_tType>( _vValues, [](auto x) { return static_cast<_tType::value_type>(std::log1p( static_cast<double>(x) )); } );
+			return SimdUnary<_tType>( _vValues, Kernels::NN9_KU_LOG1P, [](auto x) { return std::log1p( x ); } );
 		}
 
 		/**
@@ -2180,7 +2269,7 @@ namespace nn9 {
 			if constexpr ( Types::IsBool<_tTypeIn>() ) {
 				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return x; } );
 			}
-			return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return std::log1p( static_cast<double>(x) ); } );
+			return SimdUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::NN9_KU_LOG1P, [](auto x) { return std::log1p( x ); } );
 		}
 
 		/**
@@ -2289,93 +2378,7 @@ namespace nn9 {
 				//return Func<_tType>( _vValues, [](auto x) { return x; } );
 				return _vValues;	// Assuming well formed bool values, no changes will be made via x*x.
 			}
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsInt8<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return Intrin::SquareInt8( x ); }, [](auto x) { return int32_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsUint8<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return Intrin::SquareUint8( x ); }, [](auto x) { return uint32_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsInt16<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return Intrin::SquareInt16( x ); }, [](auto x) { return int32_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsUint16<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return Intrin::SquareUint16( x ); }, [](auto x) { return uint32_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsInt32<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return Intrin::SquareInt32( x ); }, [](auto x) { return int64_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsUint32<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return Intrin::SquareUint32( x ); }, [](auto x) { return uint64_t( x ) * x; } );
-				}
-
-				if constexpr ( Types::IsInt64<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return Intrin::SquareInt64( x ); }, [](auto x) {
-							constexpr int64_t i64Max = 3037000499ULL;
-							int64_t i64Abs = std::abs<int64_t>( x );
-							return (x * x * (i64Abs <= i64Max)) | ((i64Abs > i64Max) * INT64_MAX);
-						} );
-				}
-				if constexpr ( Types::IsUint64<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return Intrin::SquareUint64( x ); }, [](auto x) {
-							constexpr uint64_t ui64Max = 4294967295ULL;
-							return (x * x * (x <= ui64Max)) | ((x > ui64Max) * UINT64_MAX);
-						} );
-				}
-
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return _mm512_mul_ps( x, x ); }, [](auto x) { return x * x; } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return _mm512_mul_pd( x, x ); }, [](auto x) { return x * x; } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsInt8<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return Intrin::SquareInt8( x ); }, [](auto x) { return int32_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsUint8<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return Intrin::SquareUint8( x ); }, [](auto x) { return uint32_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsInt16<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return Intrin::SquareInt16( x ); }, [](auto x) { return int32_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsUint16<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return Intrin::SquareUint16( x ); }, [](auto x) { return uint32_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsInt32<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return Intrin::SquareInt32( x ); }, [](auto x) { return int64_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsUint32<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return Intrin::SquareUint32( x ); }, [](auto x) { return uint64_t( x ) * x; } );
-				}
-
-				if constexpr ( Types::IsInt64<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return Intrin::SquareInt64( x ); }, [](auto x) {
-							constexpr int64_t i64Max = 3037000499ULL;
-							int64_t i64Abs = std::abs<int64_t>( x );
-							return (x * x * (i64Abs <= i64Max)) | ((i64Abs > i64Max) * INT64_MAX);
-						} );
-				}
-				if constexpr ( Types::IsUint64<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return Intrin::SquareUint64( x ); }, [](auto x) {
-							constexpr uint64_t ui64Max = 4294967295ULL;
-							return (x * x * (x <= ui64Max)) | ((x > ui64Max) * UINT64_MAX);
-						} );
-				}
-
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return _mm256_mul_ps( x, x ); }, [](auto x) { return x * x; } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return _mm256_mul_pd( x, x ); }, [](auto x) { return x * x; } );
-				}
-			}
-#endif	// #ifdef __AVX2__
+			if ( TableUnary<_tType>( _vValues, Kernels::NN9_KU_SQUARE ) ) { return _vValues; }
 			if constexpr ( Types::IsInt8<Type>() || Types::IsUint8<Type>() ) {
 				return Func<_tType>( _vValues, [](auto x) { return int32_t( x ) * x; } );
 			}
@@ -2432,93 +2435,10 @@ namespace nn9 {
 		template <typename _tTypeIn, typename _tTypeOut>
 		static _tTypeOut &											Square( const _tTypeIn &_vIn, _tTypeOut &_vOut ) {
 			using TypeIn = typename _tTypeIn::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsInt8<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return Intrin::SquareInt8( x ); }, [](auto x) { return int32_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsUint8<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return Intrin::SquareUint8( x ); }, [](auto x) { return uint32_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsInt16<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return Intrin::SquareInt16( x ); }, [](auto x) { return int32_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsUint16<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return Intrin::SquareUint16( x ); }, [](auto x) { return uint32_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsInt32<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return Intrin::SquareInt32( x ); }, [](auto x) { return int64_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsUint32<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return Intrin::SquareUint32( x ); }, [](auto x) { return uint64_t( x ) * x; } );
-				}
-
-				if constexpr ( Types::IsInt64<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return Intrin::SquareInt64( x ); }, [](auto x) {
-							constexpr int64_t i64Max = 3037000499ULL;
-							int64_t i64Abs = std::abs<int64_t>( x );
-							return (x * x * (i64Abs <= i64Max)) | ((i64Abs > i64Max) * INT64_MAX);
-						} );
-				}
-				if constexpr ( Types::IsUint64<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return Intrin::SquareUint64( x ); }, [](auto x) {
-							constexpr uint64_t ui64Max = 4294967295ULL;
-							return (x * x * (x <= ui64Max)) | ((x > ui64Max) * UINT64_MAX);
-						} );
-				}
-
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm512_mul_ps( x, x ); }, [](auto x) { return x * x; } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm512_mul_pd( x, x ); }, [](auto x) { return x * x; } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsInt8<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return Intrin::SquareInt8( x ); }, [](auto x) { return int32_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsUint8<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return Intrin::SquareUint8( x ); }, [](auto x) { return uint32_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsInt16<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return Intrin::SquareInt16( x ); }, [](auto x) { return int32_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsUint16<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return Intrin::SquareUint16( x ); }, [](auto x) { return uint32_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsInt32<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return Intrin::SquareInt32( x ); }, [](auto x) { return int64_t( x ) * x; } );
-				}
-				if constexpr ( Types::IsUint32<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return Intrin::SquareUint32( x ); }, [](auto x) { return uint64_t( x ) * x; } );
-				}
-
-				if constexpr ( Types::IsInt64<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return Intrin::SquareInt64( x ); }, [](auto x) {
-							constexpr int64_t i64Max = 3037000499ULL;
-							int64_t i64Abs = std::abs<int64_t>( x );
-							return (x * x * (i64Abs <= i64Max)) | ((i64Abs > i64Max) * INT64_MAX);
-						} );
-				}
-				if constexpr ( Types::IsUint64<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return Intrin::SquareUint64( x ); }, [](auto x) {
-							constexpr uint64_t ui64Max = 4294967295ULL;
-							return (x * x * (x <= ui64Max)) | ((x > ui64Max) * UINT64_MAX);
-						} );
-				}
-
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm256_mul_ps( x, x ); }, [](auto x) { return x * x; } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm256_mul_pd( x, x ); }, [](auto x) { return x * x; } );
-				}
+			if constexpr ( !Types::IsInt32<TypeIn>() && !Types::IsUint32<TypeIn>() ) {
+				// Squares of 32-bit integers do not fit in a double's mantissa.
+				if ( TableUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::NN9_KU_SQUARE ) ) { return _vOut; }
 			}
-#endif	// #ifdef __AVX2__
 			if constexpr ( Types::IsInt8<TypeIn>() || Types::IsUint8<TypeIn>() ) {
 				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return int32_t( x ) * x; } );
 			}
@@ -2585,125 +2505,7 @@ namespace nn9 {
 				//return Func<_tType>( _vValues, [](auto x) { return x; } );
 				return _vValues;	// Assuming well formed bool values, no changes will be made via sqrt().
 			}
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsInt8<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							__m512 m0, m1, m2, m3;
-							Intrin::int8x64_to_float32x64( x, m0, m1, m2, m3 );
-							m0 = _mm512_sqrt_ps( m0 ); m1 = _mm512_sqrt_ps( m1 ); m2 = _mm512_sqrt_ps( m2 ); m3 = _mm512_sqrt_ps( m3 );
-							return Intrin::float32x64_to_int8x64( m0, m1, m2, m3 );
-						}, [](auto x) { return std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsUint8<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							__m512 m0, m1, m2, m3;
-							Intrin::uint8x64_to_float32x64( x, m0, m1, m2, m3 );
-							m0 = _mm512_sqrt_ps( m0 ); m1 = _mm512_sqrt_ps( m1 ); m2 = _mm512_sqrt_ps( m2 ); m3 = _mm512_sqrt_ps( m3 );
-							return Intrin::float32x64_to_uint8x64( m0, m1, m2, m3 );
-						}, [](auto x) { return std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsInt16<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							__m512 m0, m1;
-							Intrin::int16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm512_sqrt_ps( m0 ); m1 = _mm512_sqrt_ps( m1 );
-							return Intrin::float32x32_to_int16x32( m0, m1 );
-						}, [](auto x) { return std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsUint16<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							__m512 m0, m1;
-							Intrin::uint16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm512_sqrt_ps( m0 ); m1 = _mm512_sqrt_ps( m1 );
-							return Intrin::float32x32_to_uint16x32( m0, m1 );
-						}, [](auto x) { return std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsInt32<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							__m512 m0;
-							Intrin::int32x16_to_float32x16( x, m0 );
-							m0 = _mm512_sqrt_ps( m0 );
-							return Intrin::float32x16_to_int32x16( m0 );
-						}, [](auto x) { return std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsUint32<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							__m512 m0;
-							Intrin::uint32x16_to_float32x16( x, m0 );
-							m0 = _mm512_sqrt_ps( m0 );
-							return Intrin::float32x16_to_uint32x16( m0 );
-						}, [](auto x) { return std::sqrt<Type>( x ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return _mm512_sqrt_ps( x ); }, [](auto x) { return static_cast<Type>(std::sqrt( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return _mm512_sqrt_pd( x ); }, [](auto x) { return static_cast<Type>(std::sqrt( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsInt8<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							__m256 m0, m1, m2, m3;
-							Intrin::int8x32_to_float32x32( x, m0, m1, m2, m3 );
-							m0 = _mm256_sqrt_ps( m0 ); m1 = _mm256_sqrt_ps( m1 ); m2 = _mm256_sqrt_ps( m2 ); m3 = _mm256_sqrt_ps( m3 );
-							return Intrin::float32x32_to_int8x32( m0, m1, m2, m3 );
-						}, [](auto x) { return std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsUint8<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							__m256 m0, m1, m2, m3;
-							Intrin::uint8x32_to_float32x32( x, m0, m1, m2, m3 );
-							m0 = _mm256_sqrt_ps( m0 ); m1 = _mm256_sqrt_ps( m1 ); m2 = _mm256_sqrt_ps( m2 ); m3 = _mm256_sqrt_ps( m3 );
-							return Intrin::float32x32_to_uint8x32( m0, m1, m2, m3 );
-						}, [](auto x) { return std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsInt16<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							__m256 m0, m1;
-							Intrin::int16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm256_sqrt_ps( m0 ); m1 = _mm256_sqrt_ps( m1 );
-							return Intrin::float32x32_to_int16x32( m0, m1 );
-						}, [](auto x) { return std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsUint16<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							__m256 m0, m1;
-							Intrin::uint16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm256_sqrt_ps( m0 ); m1 = _mm256_sqrt_ps( m1 );
-							return Intrin::float32x32_to_uint16x32( m0, m1 );
-						}, [](auto x) { return std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsInt32<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							__m256 m0;
-							Intrin::int32x16_to_float32x16( x, m0 );
-							m0 = _mm256_sqrt_ps( m0 );
-							return Intrin::float32x16_to_int32x16( m0 );
-						}, [](auto x) { return std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsUint32<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							__m256 m0;
-							Intrin::uint32x16_to_float32x16( x, m0 );
-							m0 = _mm256_sqrt_ps( m0 );
-							return Intrin::float32x16_to_uint32x16( m0 );
-						}, [](auto x) { return std::sqrt<Type>( x ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return _mm256_sqrt_ps( x ); }, [](auto x) { return static_cast<Type>(std::sqrt( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return _mm256_sqrt_pd( x ); }, [](auto x) { return static_cast<Type>(std::sqrt( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX2__
+			if ( TableUnary<_tType>( _vValues, Kernels::NN9_KU_SQRT ) ) { return _vValues; }
 			if constexpr ( Types::IsInt<Type>() ) {
 				return Func<_tType>( _vValues, [](auto x) { return std::sqrt<Type>( x ); } );
 			}
@@ -2738,125 +2540,7 @@ namespace nn9 {
 		template <typename _tTypeIn, typename _tTypeOut>
 		static _tTypeOut &											Sqrt( const _tTypeIn &_vIn, _tTypeOut &_vOut ) {
 			using TypeIn = typename _tTypeIn::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsInt8<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m512 m0, m1, m2, m3;
-							Intrin::int8x64_to_float32x64( x, m0, m1, m2, m3 );
-							m0 = _mm512_sqrt_ps( m0 ); m1 = _mm512_sqrt_ps( m1 ); m2 = _mm512_sqrt_ps( m2 ); m3 = _mm512_sqrt_ps( m3 );
-							return Intrin::float32x64_to_int8x64( m0, m1, m2, m3 );
-						}, [](auto x) { return std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsUint8<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m512 m0, m1, m2, m3;
-							Intrin::uint8x64_to_float32x64( x, m0, m1, m2, m3 );
-							m0 = _mm512_sqrt_ps( m0 ); m1 = _mm512_sqrt_ps( m1 ); m2 = _mm512_sqrt_ps( m2 ); m3 = _mm512_sqrt_ps( m3 );
-							return Intrin::float32x64_to_uint8x64( m0, m1, m2, m3 );
-						}, [](auto x) { return std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsInt16<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m512 m0, m1;
-							Intrin::int16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm512_sqrt_ps( m0 ); m1 = _mm512_sqrt_ps( m1 );
-							return Intrin::float32x32_to_int16x32( m0, m1 );
-						}, [](auto x) { return std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsUint16<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m512 m0, m1;
-							Intrin::uint16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm512_sqrt_ps( m0 ); m1 = _mm512_sqrt_ps( m1 );
-							return Intrin::float32x32_to_uint16x32( m0, m1 );
-						}, [](auto x) { return std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsInt32<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m512 m0;
-							Intrin::int32x16_to_float32x16( x, m0 );
-							m0 = _mm512_sqrt_ps( m0 );
-							return Intrin::float32x16_to_int32x16( m0 );
-						}, [](auto x) { return std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsUint32<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m512 m0;
-							Intrin::uint32x16_to_float32x16( x, m0 );
-							m0 = _mm512_sqrt_ps( m0 );
-							return Intrin::float32x16_to_uint32x16( m0 );
-						}, [](auto x) { return std::sqrt<TypeIn>( x ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm512_sqrt_ps( x ); }, [](auto x) { return static_cast<TypeIn>(std::sqrt( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm512_sqrt_pd( x ); }, [](auto x) { return static_cast<TypeIn>(std::sqrt( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsInt8<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m256 m0, m1, m2, m3;
-							Intrin::int8x32_to_float32x32( x, m0, m1, m2, m3 );
-							m0 = _mm256_sqrt_ps( m0 ); m1 = _mm256_sqrt_ps( m1 ); m2 = _mm256_sqrt_ps( m2 ); m3 = _mm256_sqrt_ps( m3 );
-							return Intrin::float32x32_to_int8x32( m0, m1, m2, m3 );
-						}, [](auto x) { return std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsUint8<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m256 m0, m1, m2, m3;
-							Intrin::uint8x32_to_float32x32( x, m0, m1, m2, m3 );
-							m0 = _mm256_sqrt_ps( m0 ); m1 = _mm256_sqrt_ps( m1 ); m2 = _mm256_sqrt_ps( m2 ); m3 = _mm256_sqrt_ps( m3 );
-							return Intrin::float32x32_to_uint8x32( m0, m1, m2, m3 );
-						}, [](auto x) { return std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsInt16<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m256 m0, m1;
-							Intrin::int16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm256_sqrt_ps( m0 ); m1 = _mm256_sqrt_ps( m1 );
-							return Intrin::float32x32_to_int16x32( m0, m1 );
-						}, [](auto x) { return std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsUint16<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m256 m0, m1;
-							Intrin::uint16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm256_sqrt_ps( m0 ); m1 = _mm256_sqrt_ps( m1 );
-							return Intrin::float32x32_to_uint16x32( m0, m1 );
-						}, [](auto x) { return std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsInt32<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m256 m0;
-							Intrin::int32x16_to_float32x16( x, m0 );
-							m0 = _mm256_sqrt_ps( m0 );
-							return Intrin::float32x16_to_int32x16( m0 );
-						}, [](auto x) { return std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsUint32<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m256 m0;
-							Intrin::uint32x16_to_float32x16( x, m0 );
-							m0 = _mm256_sqrt_ps( m0 );
-							return Intrin::float32x16_to_uint32x16( m0 );
-						}, [](auto x) { return std::sqrt<TypeIn>( x ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm256_sqrt_ps( x ); }, [](auto x) { return static_cast<TypeIn>(std::sqrt( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm256_sqrt_pd( x ); }, [](auto x) { return static_cast<TypeIn>(std::sqrt( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX2__
+			if ( TableUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::NN9_KU_SQRT ) ) { return _vOut; }
 			if constexpr ( Types::IsInt<TypeIn>() ) {
 				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return std::sqrt<TypeIn>( x ); } );
 			}
@@ -2901,125 +2585,7 @@ namespace nn9 {
 				// rsqrt( 1 ): 1
 				return Func<_tType>( _vValues, [](auto x) { return true; } );
 			}
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsInt8<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							__m512 m0, m1, m2, m3;
-							Intrin::int8x64_to_float32x64( x, m0, m1, m2, m3 );
-							m0 = _mm512_rsqrt_ps( m0 ); m1 = _mm512_rsqrt_ps( m1 ); m2 = _mm512_rsqrt_ps( m2 ); m3 = _mm512_rsqrt_ps( m3 );
-							return Intrin::float32x64_to_int8x64_saturated( m0, m1, m2, m3 );
-						}, [](auto x) { return 1.0f / std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsUint8<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							__m512 m0, m1, m2, m3;
-							Intrin::uint8x64_to_float32x64( x, m0, m1, m2, m3 );
-							m0 = _mm512_rsqrt_ps( m0 ); m1 = _mm512_rsqrt_ps( m1 ); m2 = _mm512_rsqrt_ps( m2 ); m3 = _mm512_rsqrt_ps( m3 );
-							return Intrin::float32x64_to_uint8x64_saturated( m0, m1, m2, m3 );
-						}, [](auto x) { return 1.0f / std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsInt16<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							__m512 m0, m1;
-							Intrin::int16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm512_rsqrt_ps( m0 ); m1 = _mm512_rsqrt_ps( m1 );
-							return Intrin::float32x32_to_int16x32_saturated( m0, m1 );
-						}, [](auto x) { return 1.0f / std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsUint16<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							__m512 m0, m1;
-							Intrin::uint16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm512_rsqrt_ps( m0 ); m1 = _mm512_rsqrt_ps( m1 );
-							return Intrin::float32x32_to_uint16x32_saturated( m0, m1 );
-						}, [](auto x) { return 1.0f / std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsInt32<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							__m512 m0;
-							Intrin::int32x16_to_float32x16( x, m0 );
-							m0 = _mm512_rsqrt_ps( m0 );
-							return Intrin::float32x16_to_int32x16_saturated( m0 );
-						}, [](auto x) { return 1.0f / std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsUint32<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							__m512 m0;
-							Intrin::uint32x16_to_float32x16( x, m0 );
-							m0 = _mm512_rsqrt_ps( m0 );
-							return Intrin::float32x16_to_uint32x16_saturated( m0 );
-						}, [](auto x) { return 1.0f / std::sqrt<Type>( x ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return _mm512_rsqrt_ps( x ); }, [](auto x) { return static_cast<Type>(1.0f / std::sqrt( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return _mm512_rsqrt_pd( x ); }, [](auto x) { return static_cast<Type>(1.0 / std::sqrt( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsInt8<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							__m256 m0, m1, m2, m3;
-							Intrin::int8x32_to_float32x32( x, m0, m1, m2, m3 );
-							m0 = _mm256_rsqrt_ps( m0 ); m1 = _mm256_rsqrt_ps( m1 ); m2 = _mm256_rsqrt_ps( m2 ); m3 = _mm256_rsqrt_ps( m3 );
-							return Intrin::float32x32_to_int8x32_saturated( m0, m1, m2, m3 );
-						}, [](auto x) { return 1.0f / std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsUint8<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							__m256 m0, m1, m2, m3;
-							Intrin::uint8x32_to_float32x32( x, m0, m1, m2, m3 );
-							m0 = _mm256_rsqrt_ps( m0 ); m1 = _mm256_rsqrt_ps( m1 ); m2 = _mm256_rsqrt_ps( m2 ); m3 = _mm256_rsqrt_ps( m3 );
-							return Intrin::float32x32_to_uint8x32_saturated( m0, m1, m2, m3 );
-						}, [](auto x) { return 1.0f / std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsInt16<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							__m256 m0, m1;
-							Intrin::int16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm256_rsqrt_ps( m0 ); m1 = _mm256_rsqrt_ps( m1 );
-							return Intrin::float32x32_to_int16x32_saturated( m0, m1 );
-						}, [](auto x) { return 1.0f / std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsUint16<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							__m256 m0, m1;
-							Intrin::uint16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm256_rsqrt_ps( m0 ); m1 = _mm256_rsqrt_ps( m1 );
-							return Intrin::float32x32_to_uint16x32_saturated( m0, m1 );
-						}, [](auto x) { return 1.0f / std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsInt32<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							__m256 m0;
-							Intrin::int32x16_to_float32x16_saturated( x, m0 );
-							m0 = _mm256_rsqrt_ps( m0 );
-							return Intrin::float32x16_to_int32x16( m0 );
-						}, [](auto x) { return 1.0f / std::sqrt<Type>( x ); } );
-				}
-				if constexpr ( Types::IsUint32<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							__m256 m0;
-							Intrin::uint32x16_to_float32x16_saturated( x, m0 );
-							m0 = _mm256_rsqrt_ps( m0 );
-							return Intrin::float32x16_to_uint32x16( m0 );
-						}, [](auto x) { return 1.0f / std::sqrt<Type>( x ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return _mm256_rsqrt_ps( x ); }, [](auto x) { return static_cast<Type>(1.0f / std::sqrt( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return _mm256_rsqrt_pd( x ); }, [](auto x) { return static_cast<Type>(1.0 / std::sqrt( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX2__
+			if ( TableUnary<_tType>( _vValues, Kernels::NN9_KU_RSQRT ) ) { return _vValues; }
 			if constexpr ( Types::IsInt<Type>() ) {
 				return Func<_tType>( _vValues, [](auto x) { return 1.0f / std::sqrt<Type>( x ); } );
 			}
@@ -3054,125 +2620,7 @@ namespace nn9 {
 		template <typename _tTypeIn, typename _tTypeOut>
 		static _tTypeOut &											Rsqrt( const _tTypeIn &_vIn, _tTypeOut &_vOut ) {
 			using TypeIn = typename _tTypeIn::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsInt8<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m512 m0, m1, m2, m3;
-							Intrin::int8x64_to_float32x64( x, m0, m1, m2, m3 );
-							m0 = _mm512_rsqrt_ps( m0 ); m1 = _mm512_rsqrt_ps( m1 ); m2 = _mm512_rsqrt_ps( m2 ); m3 = _mm512_rsqrt_ps( m3 );
-							return Intrin::float32x64_to_int8x64_saturated( m0, m1, m2, m3 );
-						}, [](auto x) { return 1.0f / std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsUint8<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m512 m0, m1, m2, m3;
-							Intrin::uint8x64_to_float32x64( x, m0, m1, m2, m3 );
-							m0 = _mm512_rsqrt_ps( m0 ); m1 = _mm512_rsqrt_ps( m1 ); m2 = _mm512_rsqrt_ps( m2 ); m3 = _mm512_rsqrt_ps( m3 );
-							return Intrin::float32x64_to_uint8x64_saturated( m0, m1, m2, m3 );
-						}, [](auto x) { return 1.0f / std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsInt16<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m512 m0, m1;
-							Intrin::int16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm512_rsqrt_ps( m0 ); m1 = _mm512_rsqrt_ps( m1 );
-							return Intrin::float32x32_to_int16x32_saturated( m0, m1 );
-						}, [](auto x) { return 1.0f / std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsUint16<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m512 m0, m1;
-							Intrin::uint16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm512_rsqrt_ps( m0 ); m1 = _mm512_rsqrt_ps( m1 );
-							return Intrin::float32x32_to_uint16x32_saturated( m0, m1 );
-						}, [](auto x) { return 1.0f / std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsInt32<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m512 m0;
-							Intrin::int32x16_to_float32x16( x, m0 );
-							m0 = _mm512_rsqrt_ps( m0 );
-							return Intrin::float32x16_to_int32x16_saturated( m0 );
-						}, [](auto x) { return 1.0f / std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsUint32<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m512 m0;
-							Intrin::uint32x16_to_float32x16( x, m0 );
-							m0 = _mm512_rsqrt_ps( m0 );
-							return Intrin::float32x16_to_uint32x16_saturated( m0 );
-						}, [](auto x) { return 1.0f / std::sqrt<TypeIn>( x ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm512_rsqrt_ps( x ); }, [](auto x) { return static_cast<TypeIn>(1.0f / std::sqrt( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm512_rsqrt_pd( x ); }, [](auto x) { return static_cast<TypeIn>(1.0 / std::sqrt( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsInt8<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m256 m0, m1, m2, m3;
-							Intrin::int8x32_to_float32x32( x, m0, m1, m2, m3 );
-							m0 = _mm256_rsqrt_ps( m0 ); m1 = _mm256_rsqrt_ps( m1 ); m2 = _mm256_rsqrt_ps( m2 ); m3 = _mm256_rsqrt_ps( m3 );
-							return Intrin::float32x32_to_int8x32_saturated( m0, m1, m2, m3 );
-						}, [](auto x) { return 1.0f / std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsUint8<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m256 m0, m1, m2, m3;
-							Intrin::uint8x32_to_float32x32( x, m0, m1, m2, m3 );
-							m0 = _mm256_rsqrt_ps( m0 ); m1 = _mm256_rsqrt_ps( m1 ); m2 = _mm256_rsqrt_ps( m2 ); m3 = _mm256_rsqrt_ps( m3 );
-							return Intrin::float32x32_to_uint8x32_saturated( m0, m1, m2, m3 );
-						}, [](auto x) { return 1.0f / std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsInt16<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m256 m0, m1;
-							Intrin::int16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm256_rsqrt_ps( m0 ); m1 = _mm256_rsqrt_ps( m1 );
-							return Intrin::float32x32_to_int16x32_saturated( m0, m1 );
-						}, [](auto x) { return 1.0f / std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsUint16<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m256 m0, m1;
-							Intrin::uint16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm256_rsqrt_ps( m0 ); m1 = _mm256_rsqrt_ps( m1 );
-							return Intrin::float32x32_to_uint16x32_saturated( m0, m1 );
-						}, [](auto x) { return 1.0f / std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsInt32<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m256 m0;
-							Intrin::int32x16_to_float32x16( x, m0 );
-							m0 = _mm256_rsqrt_ps( m0 );
-							return Intrin::float32x16_to_int32x16_saturated( m0 );
-						}, [](auto x) { return 1.0f / std::sqrt<TypeIn>( x ); } );
-				}
-				if constexpr ( Types::IsUint32<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							__m256 m0;
-							Intrin::uint32x16_to_float32x16( x, m0 );
-							m0 = _mm256_rsqrt_ps( m0 );
-							return Intrin::float32x16_to_uint32x16_saturated( m0 );
-						}, [](auto x) { return 1.0f / std::sqrt<TypeIn>( x ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm256_rsqrt_ps( x ); }, [](auto x) { return static_cast<TypeIn>(1.0f / std::sqrt( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm256_rsqrt_pd( x ); }, [](auto x) { return static_cast<TypeIn>(1.0 / std::sqrt( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX2__
+			if ( TableUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::NN9_KU_RSQRT ) ) { return _vOut; }
 			if constexpr ( Types::IsInt<TypeIn>() ) {
 				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return 1.0f / std::sqrt<TypeIn>( x ); } );
 			}
@@ -3289,7 +2737,7 @@ namespace nn9 {
 				// erf( 0 ) = 0.
 				return Func<_tType>( _vValues, [](auto x) { return x; } );
 			}
-			return Func<_tType>( _vValues, [](auto x) { return static_cast<_tType::value_type>(std::erf( static_cast<double>(x) )); } );
+			return SimdUnary<_tType>( _vValues, Kernels::NN9_KU_ERF, [](auto x) { return std::erf( x ); } );
 		}
 
 		/**
@@ -3319,7 +2767,7 @@ namespace nn9 {
 			if constexpr ( Types::IsBool<_tTypeIn>() ) {
 				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return x; } );
 			}
-			return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return std::erf( static_cast<double>(x) ); } );
+			return SimdUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::NN9_KU_ERF, [](auto x) { return std::erf( x ); } );
 		}
 
 		/**
@@ -3696,28 +3144,11 @@ namespace nn9 {
 		template <typename _tType>
 		static _tType &												Ceil( _tType &_vValues ) {
 			using Type = typename _tType::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return _mm512_ceil_ps( x ); }, [](auto x) { return static_cast<Type>(std::ceil( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return _mm512_ceil_pd( x ); }, [](auto x) { return static_cast<Type>(std::ceil( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return _mm256_ceil_ps( x ); }, [](auto x) { return static_cast<Type>(std::ceil( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return _mm256_ceil_pd( x ); }, [](auto x) { return static_cast<Type>(std::ceil( x )); } );
-				}
+			if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() || Types::Is64BitFloat<Type>() ) {
+				if ( TableUnary<_tType>( _vValues, Kernels::NN9_KU_CEIL ) ) { return _vValues; }
+				return Func<_tType>( _vValues, [](auto x) { return std::ceil( static_cast<double>(x) ); } );
 			}
-#endif	// #ifdef __AVX2__
-			return _vValues;
+			else { return _vValues; }
 		}
 
 		/**
@@ -3745,28 +3176,11 @@ namespace nn9 {
 		template <typename _tTypeIn, typename _tTypeOut>
 		static _tTypeOut &											Ceil( const _tTypeIn &_vIn, _tTypeOut &_vOut ) {
 			using TypeIn = typename _tTypeIn::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm512_ceil_ps( x ); }, [](auto x) { return static_cast<TypeIn>(std::ceil( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm512_ceil_pd( x ); }, [](auto x) { return static_cast<TypeIn>(std::ceil( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm256_ceil_ps( x ); }, [](auto x) { return static_cast<TypeIn>(std::ceil( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm256_ceil_pd( x ); }, [](auto x) { return static_cast<TypeIn>(std::ceil( x )); } );
-				}
+			if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() || Types::Is64BitFloat<TypeIn>() ) {
+				if ( TableUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::NN9_KU_CEIL ) ) { return _vOut; }
+				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return static_cast<TypeIn>(std::ceil( static_cast<double>(x) )); } );
 			}
-#endif	// #ifdef __AVX2__
-			return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return x; } );
+			else { return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return x; } ); }
 		}
 
 		/**
@@ -3799,28 +3213,11 @@ namespace nn9 {
 		template <typename _tType>
 		static _tType &												Floor( _tType &_vValues ) {
 			using Type = typename _tType::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return _mm512_floor_ps( x ); }, [](auto x) { return static_cast<Type>(std::floor( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return _mm512_floor_pd( x ); }, [](auto x) { return static_cast<Type>(std::floor( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return _mm256_floor_ps( x ); }, [](auto x) { return static_cast<Type>(std::floor( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return _mm256_floor_pd( x ); }, [](auto x) { return static_cast<Type>(std::floor( x )); } );
-				}
+			if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() || Types::Is64BitFloat<Type>() ) {
+				if ( TableUnary<_tType>( _vValues, Kernels::NN9_KU_FLOOR ) ) { return _vValues; }
+				return Func<_tType>( _vValues, [](auto x) { return std::floor( static_cast<double>(x) ); } );
 			}
-#endif	// #ifdef __AVX2__
-			return _vValues;
+			else { return _vValues; }
 		}
 
 		/**
@@ -3848,28 +3245,11 @@ namespace nn9 {
 		template <typename _tTypeIn, typename _tTypeOut>
 		static _tTypeOut &											Floor( const _tTypeIn &_vIn, _tTypeOut &_vOut ) {
 			using TypeIn = typename _tTypeIn::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm512_floor_ps( x ); }, [](auto x) { return static_cast<TypeIn>(std::floor( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm512_floor_pd( x ); }, [](auto x) { return static_cast<TypeIn>(std::floor( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm256_floor_ps( x ); }, [](auto x) { return static_cast<TypeIn>(std::floor( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm256_floor_pd( x ); }, [](auto x) { return static_cast<TypeIn>(std::floor( x )); } );
-				}
+			if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() || Types::Is64BitFloat<TypeIn>() ) {
+				if ( TableUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::NN9_KU_FLOOR ) ) { return _vOut; }
+				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return static_cast<TypeIn>(std::floor( static_cast<double>(x) )); } );
 			}
-#endif	// #ifdef __AVX2__
-			return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return x; } );
+			else { return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return x; } ); }
 		}
 
 		/**
@@ -3902,28 +3282,11 @@ namespace nn9 {
 		template <typename _tType>
 		static _tType &												Round( _tType &_vValues ) {
 			using Type = typename _tType::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return _mm512_roundscale_ps( x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }, [](auto x) { return static_cast<Type>(std::round( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return _mm512_roundscale_pd( x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }, [](auto x) { return static_cast<Type>(std::round( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return _mm256_round_ps( x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }, [](auto x) { return static_cast<Type>(std::round( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return _mm256_round_pd( x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }, [](auto x) { return static_cast<Type>(std::round( x )); } );
-				}
+			if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() || Types::Is64BitFloat<Type>() ) {
+				if ( TableUnary<_tType>( _vValues, Kernels::NN9_KU_ROUND ) ) { return _vValues; }
+				return Func<_tType>( _vValues, [](auto x) { return std::round( static_cast<double>(x) ); } );
 			}
-#endif	// #ifdef __AVX2__
-			return _vValues;
+			else { return _vValues; }
 		}
 
 		/**
@@ -3951,28 +3314,11 @@ namespace nn9 {
 		template <typename _tTypeIn, typename _tTypeOut>
 		static _tTypeOut &											Round( const _tTypeIn &_vIn, _tTypeOut &_vOut ) {
 			using TypeIn = typename _tTypeIn::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm512_roundscale_ps( x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }, [](auto x) { return static_cast<TypeIn>(std::round( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm512_roundscale_pd( x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }, [](auto x) { return static_cast<TypeIn>(std::round( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm256_round_ps( x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }, [](auto x) { return static_cast<TypeIn>(std::round( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm256_round_pd( x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ); }, [](auto x) { return static_cast<TypeIn>(std::round( x )); } );
-				}
+			if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() || Types::Is64BitFloat<TypeIn>() ) {
+				if ( TableUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::NN9_KU_ROUND ) ) { return _vOut; }
+				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return static_cast<TypeIn>(std::round( static_cast<double>(x) )); } );
 			}
-#endif	// #ifdef __AVX2__
-			return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return x; } );
+			else { return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return x; } ); }
 		}
 
 		/**
@@ -4005,21 +3351,9 @@ namespace nn9 {
 		template <typename _tType>
 		static _tType &												RoundToEven( _tType &_vValues ) {
 			using Type = typename _tType::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return nn9::Intrin::RoundToEven( x ); }, [](auto x) { return static_cast<Type>(nn9::RoundToEven( static_cast<float>(x) )); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return nn9::Intrin::RoundToEven( x ); }, [](auto x) { return static_cast<Type>(nn9::RoundToEven( static_cast<float>(x) )); } );
-				}
+			if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() || Types::Is64BitFloat<Type>() ) {
+				if ( TableUnary<_tType>( _vValues, Kernels::NN9_KU_ROUND_EVEN ) ) { return _vValues; }
 			}
-#endif	// #ifdef __AVX2__
 
 			if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
 				return Func<_tType>( _vValues, [](auto x) { return nn9::RoundToEven( static_cast<float>(x) ); } );
@@ -4055,21 +3389,9 @@ namespace nn9 {
 		template <typename _tTypeIn, typename _tTypeOut>
 		static _tTypeOut &											RoundToEven( const _tTypeIn &_vIn, _tTypeOut &_vOut ) {
 			using TypeIn = typename _tTypeIn::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return nn9::Intrin::RoundToEven( x ); }, [](auto x) { return nn9::RoundToEven( x ); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return nn9::Intrin::RoundToEven( x ); }, [](auto x) { return nn9::RoundToEven( x ); } );
-				}
+			if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() || Types::Is64BitFloat<TypeIn>() ) {
+				if ( TableUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::NN9_KU_ROUND_EVEN ) ) { return _vOut; }
 			}
-#endif	// #ifdef __AVX2__
 
 			if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
 				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return nn9::RoundToEven( static_cast<float>(x) ); } );
@@ -4117,59 +3439,7 @@ namespace nn9 {
 			if constexpr ( Types::IsBool<Type>() || Types::IsUnsigned<Type>() ) {
 				return _vValues;
 			}
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsInt8<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							return _mm512_abs_epi8( x );
-						}, [](auto x) { return std::abs<double>( x ); } );
-				}
-				if constexpr ( Types::IsInt16<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							return _mm512_abs_epi16( x );
-						}, [](auto x) { return std::abs<double>( x ); } );
-				}
-				if constexpr ( Types::IsInt32<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							return _mm512_abs_epi32( x );
-						}, [](auto x) { return std::abs<double>( x ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return _mm512_abs_ps( x ); }, [](auto x) { return static_cast<float>(std::abs( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) { return _mm512_abs_pd( x ); }, [](auto x) { return static_cast<double>(std::abs( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsInt8<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							return _mm256_abs_epi8( x );
-						}, [](auto x) { return std::abs<double>( x ); } );
-				}
-				if constexpr ( Types::IsInt16<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							return _mm256_abs_epi16( x );
-						}, [](auto x) { return std::abs<double>( x ); } );
-				}
-				if constexpr ( Types::IsInt32<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							return _mm256_abs_epi32( x );
-						}, [](auto x) { return std::abs<double>( x ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return _mm256_abs_ps( x ); }, [](auto x) { return static_cast<float>(std::abs( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) { return _mm256_abs_pd( x ); }, [](auto x) { return static_cast<double>(std::abs( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX2__
+			if ( TableUnary<_tType>( _vValues, Kernels::NN9_KU_ABS ) ) { return _vValues; }
 			if constexpr ( Types::IsInt64<Type>() || Types::IsInt32<Type>() ) {
 				return Func<_tType>( _vValues, [](auto x) { return std::abs<double>( x ); } );
 			}
@@ -4212,59 +3482,7 @@ namespace nn9 {
 			if constexpr ( Types::IsBool<TypeIn>() || Types::IsUnsigned<TypeIn>() ) {
 				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return x; } );
 			}
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsInt8<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return _mm512_abs_epi8( x );
-						}, [](auto x) { return std::abs<double>( x ); } );
-				}
-				if constexpr ( Types::IsInt16<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return _mm512_abs_epi16( x );
-						}, [](auto x) { return std::abs<double>( x ); } );
-				}
-				if constexpr ( Types::IsInt32<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return _mm512_abs_epi32( x );
-						}, [](auto x) { return std::abs<double>( x ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm512_abs_ps( x ); }, [](auto x) { return static_cast<float>(std::abs( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm512_abs_pd( x ); }, [](auto x) { return static_cast<double>(std::abs( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsInt8<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return _mm256_abs_epi8( x );
-						}, [](auto x) { return std::abs<double>( x ); } );
-				}
-				if constexpr ( Types::IsInt16<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return _mm256_abs_epi16( x );
-						}, [](auto x) { return std::abs<double>( x ); } );
-				}
-				if constexpr ( Types::IsInt32<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return _mm256_abs_epi32( x );
-						}, [](auto x) { return std::abs<double>( x ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm256_abs_ps( x ); }, [](auto x) { return static_cast<float>(std::abs( static_cast<float>(x) )); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return _mm256_abs_pd( x ); }, [](auto x) { return static_cast<double>(std::abs( x )); } );
-				}
-			}
-#endif	// #ifdef __AVX2__
+			if ( TableUnary<_tTypeIn, _tTypeOut>( _vIn, _vOut, Kernels::NN9_KU_ABS ) ) { return _vOut; }
 			if constexpr ( Types::IsInt64<TypeIn>() || Types::IsInt32<TypeIn>() ) {
 				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return std::abs<double>( x ); } );
 			}
@@ -4314,99 +3532,20 @@ namespace nn9 {
 		static _tType &												Add( _tType &_vValues, _tScalarType _stScalar ) {
 			using Type = typename _tType::value_type;
 			
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsInt8<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							return _mm512_adds_epi8( x, _mm512_set1_epi8( static_cast<Type>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint8<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							return _mm512_adds_epu8( x, _mm512_set1_epi8( static_cast<Type>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsInt16<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							return _mm512_adds_epi16( x, _mm512_set1_epi16( static_cast<Type>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint16<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							return _mm512_adds_epi16( x, _mm512_set1_epi16( static_cast<Type>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsInt32<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							return Intrin::_mm512_adds_epi32( x, _mm512_set1_epi32( static_cast<Type>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint32<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [](auto x) {
-							return Intrin::_mm512_adds_epu32( x, _mm512_set1_epi32( static_cast<Type>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<Type>(_stScalar) ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) { return _mm512_add_ps( x, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); }, [](auto x) { return x + static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) { return _mm512_add_pd( x, _mm512_set1_pd( static_cast<Type>(_stScalar) ) ); }, [](auto x) { return x + static_cast<Type>(_stScalar); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsInt8<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							return _mm256_adds_epi8( x, _mm256_set1_epi8( static_cast<Type>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint8<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							return _mm256_adds_epu8( x, _mm256_set1_epi8( static_cast<Type>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsInt16<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							return _mm256_adds_epi16( x, _mm256_set1_epi16( static_cast<Type>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint16<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							return _mm256_adds_epi16( x, _mm256_set1_epi16( static_cast<Type>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsInt32<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							return Intrin::_mm256_adds_epi32( x, _mm256_set1_epi32( static_cast<Type>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint32<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [](auto x) {
-							return Intrin::_mm256_adds_epu32( x, _mm256_set1_epi32( static_cast<Type>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<Type>(_stScalar) ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) { return _mm256_add_ps( x, _mm256_set1_ps( static_cast<float>(_stScalar) ) ); }, [](auto x) { return x + static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) { return _mm256_add_pd( x, _mm256_set1_pd( static_cast<Type>(_stScalar) ) ); }, [](auto x) { return x + static_cast<Type>(_stScalar); } );
-				}
+			if constexpr ( Types::IsInt<Type>() ) {
+				if ( TableScalar<TableReal<Type>>( _vValues, Kernels::NN9_KB_ADD, static_cast<TableReal<Type>>(static_cast<Type>(_stScalar)) ) ) { return _vValues; }
 			}
-#endif	// #ifdef __AVX2__
+			else if ( TableScalar<TableReal<Type>>( _vValues, Kernels::NN9_KB_ADD, static_cast<TableReal<Type>>(_stScalar) ) ) { return _vValues; }
 			if constexpr ( Types::IsBool<Type>() ) {
-				return Func<_tType>( _vValues, [](auto x) { return static_cast<int16_t>( x ) + static_cast<int16_t>(_stScalar); } );
+				return Func<_tType>( _vValues, [_stScalar](auto x) { return static_cast<int16_t>( x ) + static_cast<int16_t>(_stScalar); } );
 			}
 			if constexpr ( Types::IsInt<Type>() ) {
-				return Func<_tType>( _vValues, [](auto x) { return nn9::adds( x, static_cast<Type>(_stScalar) ); } );
+				return Func<_tType>( _vValues, [_stScalar](auto x) { return nn9::adds( x, static_cast<Type>(_stScalar) ); } );
 			}
 			if constexpr ( Types::Is64BitFloat<Type>() ) {
-				return Func<_tType>( _vValues, [](auto x) { return x + static_cast<Type>(_stScalar); } );
+				return Func<_tType>( _vValues, [_stScalar](auto x) { return x + static_cast<Type>(_stScalar); } );
 			}
-			return Func<_tType>( _vValues, [](auto x) { return x + static_cast<float>(_stScalar); } );
+			return Func<_tType>( _vValues, [_stScalar](auto x) { return x + static_cast<float>(_stScalar); } );
 		}
 
 		/**
@@ -4434,99 +3573,20 @@ namespace nn9 {
 		template <typename _tTypeIn, typename _tTypeOut, typename _tScalarType>
 		static _tTypeOut &											Add( const _tTypeIn &_vIn, _tTypeOut &_vOut, _tScalarType _stScalar ) {
 			using TypeIn = typename _tTypeIn::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsInt8<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return _mm512_adds_epi8( x, _mm512_set1_epi8( static_cast<TypeIn>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint8<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return _mm512_adds_epu8( x, _mm512_set1_epi8( static_cast<TypeIn>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsInt16<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return _mm512_adds_epi16( x, _mm512_set1_epi16( static_cast<TypeIn>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint16<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return _mm512_adds_epi16( x, _mm512_set1_epi16( static_cast<TypeIn>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsInt32<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return Intrin::_mm512_adds_epi32( x, _mm512_set1_epi32( static_cast<TypeIn>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint32<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return Intrin::_mm512_adds_epu32( x, _mm512_set1_epi32( static_cast<TypeIn>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return _mm512_add_ps( x, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); }, [](auto x) { return x + static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return _mm512_add_pd( x, _mm512_set1_pd( static_cast<TypeIn>(_stScalar) ) ); }, [](auto x) { return x + static_cast<TypeIn>(_stScalar); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsInt8<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return _mm256_adds_epi8( x, _mm256_set1_epi8( static_cast<TypeIn>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint8<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return _mm256_adds_epu8( x, _mm256_set1_epi8( static_cast<TypeIn>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsInt16<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return _mm256_adds_epi16( x, _mm256_set1_epi16( static_cast<TypeIn>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint16<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return _mm256_adds_epi16( x, _mm256_set1_epi16( static_cast<TypeIn>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsInt32<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return Intrin::_mm256_adds_epi32( x, _mm256_set1_epi32( static_cast<TypeIn>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint32<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) {
-							return Intrin::_mm256_adds_epu32( x, _mm256_set1_epi32( static_cast<TypeIn>(_stScalar) ) );
-						}, [](auto x) { return nn9::adds( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return _mm256_add_ps( x, _mm256_set1_ps( static_cast<float>(_stScalar) ) ); }, [](auto x) { return x + static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return _mm256_add_pd( x, _mm256_set1_pd( static_cast<TypeIn>(_stScalar) ) ); }, [](auto x) { return x + static_cast<TypeIn>(_stScalar); } );
-				}
+			if constexpr ( Types::IsInt<TypeIn>() ) {
+				if ( TableScalar<TableReal<TypeIn>>( _vIn, _vOut, Kernels::NN9_KB_ADD, static_cast<TableReal<TypeIn>>(static_cast<TypeIn>(_stScalar)), true ) ) { return _vOut; }
 			}
-#endif	// #ifdef __AVX2__
+			else if ( TableScalar<TableReal<TypeIn>>( _vIn, _vOut, Kernels::NN9_KB_ADD, static_cast<TableReal<TypeIn>>(_stScalar) ) ) { return _vOut; }
 			if constexpr ( Types::IsBool<TypeIn>() ) {
-				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return static_cast<int16_t>( x ) + static_cast<int16_t>(_stScalar); } );
+				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return static_cast<int16_t>( x ) + static_cast<int16_t>(_stScalar); } );
 			}
 			if constexpr ( Types::IsInt<TypeIn>() ) {
-				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return nn9::adds( x, static_cast<TypeIn>(_stScalar) ); } );
+				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return nn9::adds( x, static_cast<TypeIn>(_stScalar) ); } );
 			}
 			if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return x + static_cast<TypeIn>(_stScalar); } );
+				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return x + static_cast<TypeIn>(_stScalar); } );
 			}
-			return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [](auto x) { return x + static_cast<float>(_stScalar); } );
+			return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return x + static_cast<float>(_stScalar); } );
 		}
 
 		/**
@@ -4560,89 +3620,10 @@ namespace nn9 {
 		static _tType &												Sub( _tType &_vValues, _tScalarType _stScalar ) {
 			using Type = typename _tType::value_type;
 			
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsInt8<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							return _mm512_subs_epi8( x, _mm512_set1_epi8( static_cast<Type>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint8<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							return _mm512_subs_epu8( x, _mm512_set1_epi8( static_cast<Type>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsInt16<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							return _mm512_subs_epi16( x, _mm512_set1_epi16( static_cast<Type>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint16<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							return _mm512_subs_epu16( x, _mm512_set1_epi16( static_cast<Type>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsInt32<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							return Intrin::_mm512_subs_epi32( x, _mm512_set1_epi32( static_cast<Type>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint32<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							return Intrin::_mm512_subs_epu32( x, _mm512_set1_epi32( static_cast<Type>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<Type>(_stScalar) ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) { return _mm512_sub_ps( x, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); }, [_stScalar](auto x) { return x + static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) { return _mm512_sub_pd( x, _mm512_set1_pd( static_cast<Type>(_stScalar) ) ); }, [_stScalar](auto x) { return x + static_cast<Type>(_stScalar); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsInt8<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							return _mm256_subs_epi8( x, _mm256_set1_epi8( static_cast<Type>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint8<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							return _mm256_subs_epu8( x, _mm256_set1_epi8( static_cast<Type>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsInt16<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							return _mm256_subs_epi16( x, _mm256_set1_epi16( static_cast<Type>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint16<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							return _mm256_subs_epi16( x, _mm256_set1_epi16( static_cast<Type>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsInt32<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							return Intrin::_mm256_subs_epi32( x, _mm256_set1_epi32( static_cast<Type>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<Type>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint32<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							return Intrin::_mm256_subs_epu32( x, _mm256_set1_epi32( static_cast<Type>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<Type>(_stScalar) ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) { return _mm256_sub_ps( x, _mm256_set1_ps( static_cast<float>(_stScalar) ) ); }, [_stScalar](auto x) { return x + static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) { return _mm256_sub_pd( x, _mm256_set1_pd( static_cast<Type>(_stScalar) ) ); }, [_stScalar](auto x) { return x + static_cast<Type>(_stScalar); } );
-				}
+			if constexpr ( Types::IsInt<Type>() ) {
+				if ( TableScalar<TableReal<Type>>( _vValues, Kernels::NN9_KB_SUB, static_cast<TableReal<Type>>(static_cast<Type>(_stScalar)) ) ) { return _vValues; }
 			}
-#endif	// #ifdef __AVX2__
+			else if ( TableScalar<TableReal<Type>>( _vValues, Kernels::NN9_KB_SUB, static_cast<TableReal<Type>>(_stScalar) ) ) { return _vValues; }
 			if constexpr ( Types::IsBool<Type>() ) {
 				return Func<_tType>( _vValues, [_stScalar](auto x) { return static_cast<int16_t>( x ) - static_cast<int16_t>(_stScalar); } );
 			}
@@ -4680,89 +3661,10 @@ namespace nn9 {
 		template <typename _tTypeIn, typename _tTypeOut, typename _tScalarType>
 		static _tTypeOut &											Sub( const _tTypeIn &_vIn, _tTypeOut &_vOut, _tScalarType _stScalar ) {
 			using TypeIn = typename _tTypeIn::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsInt8<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							return _mm512_subs_epi8( x, _mm512_set1_epi8( static_cast<TypeIn>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint8<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							return _mm512_subs_epu8( x, _mm512_set1_epi8( static_cast<TypeIn>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsInt16<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							return _mm512_subs_epi16( x, _mm512_set1_epi16( static_cast<TypeIn>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint16<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							return _mm512_subs_epi16( x, _mm512_set1_epi16( static_cast<TypeIn>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsInt32<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							return Intrin::_mm512_subs_epi32( x, _mm512_set1_epi32( static_cast<TypeIn>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint32<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							return Intrin::_mm512_subs_epu32( x, _mm512_set1_epi32( static_cast<TypeIn>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return _mm512_sub_ps( x, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); }, [_stScalar](auto x) { return x - static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return _mm512_sub_pd( x, _mm512_set1_pd( static_cast<TypeIn>(_stScalar) ) ); }, [_stScalar](auto x) { return x - static_cast<TypeIn>(_stScalar); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsInt8<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							return _mm256_subs_epi8( x, _mm256_set1_epi8( static_cast<TypeIn>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint8<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							return _mm256_subs_epu8( x, _mm256_set1_epi8( static_cast<TypeIn>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsInt16<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							return _mm256_subs_epi16( x, _mm256_set1_epi16( static_cast<TypeIn>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint16<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							return _mm256_subs_epi16( x, _mm256_set1_epi16( static_cast<TypeIn>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsInt32<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							return Intrin::_mm256_subs_epi32( x, _mm256_set1_epi32( static_cast<TypeIn>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-				if constexpr ( Types::IsUint32<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							return Intrin::_mm256_subs_epu32( x, _mm256_set1_epi32( static_cast<TypeIn>(_stScalar) ) );
-						}, [_stScalar](auto x) { return nn9::subs( x, static_cast<TypeIn>(_stScalar) ); } );
-				}
-
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return _mm256_sub_ps( x, _mm256_set1_ps( static_cast<float>(_stScalar) ) ); }, [_stScalar](auto x) { return x - static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return _mm256_sub_pd( x, _mm256_set1_pd( static_cast<TypeIn>(_stScalar) ) ); }, [_stScalar](auto x) { return x - static_cast<TypeIn>(_stScalar); } );
-				}
+			if constexpr ( Types::IsInt<TypeIn>() ) {
+				if ( TableScalar<TableReal<TypeIn>>( _vIn, _vOut, Kernels::NN9_KB_SUB, static_cast<TableReal<TypeIn>>(static_cast<TypeIn>(_stScalar)), true ) ) { return _vOut; }
 			}
-#endif	// #ifdef __AVX2__
+			else if ( TableScalar<TableReal<TypeIn>>( _vIn, _vOut, Kernels::NN9_KB_SUB, static_cast<TableReal<TypeIn>>(_stScalar) ) ) { return _vOut; }
 			if constexpr ( Types::IsBool<TypeIn>() ) {
 				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return static_cast<int16_t>( x ) - static_cast<int16_t>(_stScalar); } );
 			}
@@ -4805,125 +3707,8 @@ namespace nn9 {
 		template <typename _tType, typename _tScalarType>
 		static _tType &												Mul( _tType &_vValues, _tScalarType _stScalar ) {
 			using Type = typename _tType::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsInt8<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							__m512 m0, m1, m2, m3;
-							Intrin::int8x64_to_float32x64( x, m0, m1, m2, m3 );
-							m0 = _mm512_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm512_mul_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m2 = _mm512_mul_ps( m2, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m3 = _mm512_mul_ps( m3, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x64_to_int8x64_saturated( m0, m1, m2, m3 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint8<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							__m512 m0, m1, m2, m3;
-							Intrin::uint8x64_to_float32x64( x, m0, m1, m2, m3 );
-							m0 = _mm512_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm512_mul_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m2 = _mm512_mul_ps( m2, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m3 = _mm512_mul_ps( m3, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x64_to_uint8x64_saturated( m0, m1, m2, m3 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsInt16<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							__m512 m0, m1;
-							Intrin::int16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm512_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm512_mul_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_int16x32_saturated( m0, m1 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint16<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							__m512 m0, m1;
-							Intrin::uint16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm512_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm512_mul_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_uint16x32_saturated( m0, m1 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsInt32<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							__m512 m0;
-							Intrin::int32x16_to_float32x16( x, m0 );
-							m0 = _mm512_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x16_to_int32x16_saturated( m0 );
-						}, [_stScalar](auto x) { return static_cast<double>(x) * static_cast<double>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint32<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							__m512 m0;
-							Intrin::uint32x16_to_float32x16( x, m0 );
-							m0 = _mm512_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x16_to_uint32x16_saturated( m0 );
-						}, [_stScalar](auto x) { return static_cast<double>(x) * static_cast<double>(_stScalar); } );
-				}
-
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) { return _mm512_mul_ps( x, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); }, [_stScalar](auto x) { return x * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) { return _mm512_mul_pd( x, _mm512_set1_pd( static_cast<double>(_stScalar) ) ); }, [_stScalar](auto x) { return x * static_cast<Type>(_stScalar); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsInt8<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							__m256 m0, m1, m2, m3;
-							Intrin::int8x32_to_float32x32( x, m0, m1, m2, m3 );
-							m0 = _mm256_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm256_mul_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m2 = _mm256_mul_ps( m2, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m3 = _mm256_mul_ps( m3, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_int8x32_saturated( m0, m1, m2, m3 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint8<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							__m256 m0, m1, m2, m3;
-							Intrin::uint8x32_to_float32x32( x, m0, m1, m2, m3 );
-							m0 = _mm256_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm256_mul_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m2 = _mm256_mul_ps( m2, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m3 = _mm256_mul_ps( m3, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_uint8x32_saturated( m0, m1, m2, m3 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsInt16<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							__m256 m0, m1;
-							Intrin::int16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm256_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm256_mul_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_int16x32_saturated( m0, m1 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint16<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							__m256 m0, m1;
-							Intrin::uint16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm256_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm256_mul_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_uint16x32_saturated( m0, m1 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsInt32<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							__m256 m0;
-							Intrin::int32x16_to_float32x16_saturated( x, m0 );
-							m0 = _mm256_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x16_to_int32x16( m0 );
-						}, [_stScalar](auto x) { return static_cast<double>(x) * static_cast<double>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint32<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							__m256 m0;
-							Intrin::uint32x16_to_float32x16_saturated( x, m0 );
-							m0 = _mm256_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x16_to_uint32x16( m0 );
-						}, [_stScalar](auto x) { return static_cast<double>(x) * static_cast<double>(_stScalar); } );
-				}
-
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) { return _mm256_mul_ps( x, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); }, [_stScalar](auto x) { return x * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) { return _mm256_mul_pd( x, _mm512_set1_pd( static_cast<double>(_stScalar) ) ); }, [_stScalar](auto x) { return x * static_cast<Type>(_stScalar); } );
-				}
-			}
-#endif	// #ifdef __AVX2__
+			using Real = typename std::conditional<Types::IsInt<Type>(), double, TableReal<Type>>::type;
+			if ( TableScalar<Real>( _vValues, Kernels::NN9_KB_MUL, static_cast<Real>(_stScalar) ) ) { return _vValues; }
 			if constexpr ( Types::IsInt<Type>() ) {
 				return Func<_tType>( _vValues, [_stScalar](auto x) { return static_cast<double>(x) * static_cast<double>(_stScalar); } );
 			}
@@ -4958,125 +3743,8 @@ namespace nn9 {
 		template <typename _tTypeIn, typename _tTypeOut, typename _tScalarType>
 		static _tTypeOut &											Mul( const _tTypeIn &_vIn, _tTypeOut &_vOut, _tScalarType _stScalar ) {
 			using TypeIn = typename _tTypeIn::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsInt8<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m512 m0, m1, m2, m3;
-							Intrin::int8x64_to_float32x64( x, m0, m1, m2, m3 );
-							m0 = _mm512_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm512_mul_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m2 = _mm512_mul_ps( m2, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m3 = _mm512_mul_ps( m3, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x64_to_int8x64_saturated( m0, m1, m2, m3 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint8<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m512 m0, m1, m2, m3;
-							Intrin::uint8x64_to_float32x64( x, m0, m1, m2, m3 );
-							m0 = _mm512_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm512_mul_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m2 = _mm512_mul_ps( m2, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m3 = _mm512_mul_ps( m3, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x64_to_uint8x64_saturated( m0, m1, m2, m3 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsInt16<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m512 m0, m1;
-							Intrin::int16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm512_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm512_mul_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_int16x32_saturated( m0, m1 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint16<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m512 m0, m1;
-							Intrin::uint16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm512_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm512_mul_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_uint16x32_saturated( m0, m1 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsInt32<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m512 m0;
-							Intrin::int32x16_to_float32x16( x, m0 );
-							m0 = _mm512_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x16_to_int32x16_saturated( m0 );
-						}, [_stScalar](auto x) { return static_cast<double>(x) * static_cast<double>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint32<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m512 m0;
-							Intrin::uint32x16_to_float32x16( x, m0 );
-							m0 = _mm512_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x16_to_uint32x16_saturated( m0 );
-						}, [_stScalar](auto x) { return static_cast<double>(x) * static_cast<double>(_stScalar); } );
-				}
-
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return _mm512_mul_ps( x, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); }, [_stScalar](auto x) { return x * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return _mm512_mul_pd( x, _mm512_set1_pd( static_cast<double>(_stScalar) ) ); }, [_stScalar](auto x) { return x * static_cast<TypeIn>(_stScalar); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsInt8<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m256 m0, m1, m2, m3;
-							Intrin::int8x32_to_float32x32( x, m0, m1, m2, m3 );
-							m0 = _mm256_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm256_mul_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m2 = _mm256_mul_ps( m2, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m3 = _mm256_mul_ps( m3, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_int8x32_saturated( m0, m1, m2, m3 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint8<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m256 m0, m1, m2, m3;
-							Intrin::uint8x32_to_float32x32( x, m0, m1, m2, m3 );
-							m0 = _mm256_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm256_mul_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m2 = _mm256_mul_ps( m2, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m3 = _mm256_mul_ps( m3, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_uint8x32_saturated( m0, m1, m2, m3 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsInt16<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m256 m0, m1;
-							Intrin::int16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm256_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm256_mul_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_int16x32_saturated( m0, m1 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint16<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m256 m0, m1;
-							Intrin::uint16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm256_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm256_mul_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_uint16x32_saturated( m0, m1 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsInt32<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m256 m0;
-							Intrin::int32x16_to_float32x16( x, m0 );
-							m0 = _mm256_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x16_to_int32x16_saturated( m0 );
-						}, [_stScalar](auto x) { return static_cast<double>(x) * static_cast<double>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint32<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m256 m0;
-							Intrin::uint32x16_to_float32x16( x, m0 );
-							m0 = _mm256_mul_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x16_to_uint32x16_saturated( m0 );
-						}, [_stScalar](auto x) { return static_cast<double>(x) * static_cast<double>(_stScalar); } );
-				}
-
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return _mm256_mul_ps( x, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); }, [_stScalar](auto x) { return x * static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return _mm256_mul_pd( x, _mm512_set1_pd( static_cast<double>(_stScalar) ) ); }, [_stScalar](auto x) { return x * static_cast<TypeIn>(_stScalar); } );
-				}
-			}
-#endif	// #ifdef __AVX2__
+			using Real = typename std::conditional<Types::IsInt<TypeIn>(), double, TableReal<TypeIn>>::type;
+			if ( TableScalar<Real>( _vIn, _vOut, Kernels::NN9_KB_MUL, static_cast<Real>(_stScalar) ) ) { return _vOut; }
 			if constexpr ( Types::IsInt<TypeIn>() ) {
 				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return static_cast<double>(x) * static_cast<double>(_stScalar); } );
 			}
@@ -5116,125 +3784,8 @@ namespace nn9 {
 		template <typename _tType, typename _tScalarType>
 		static _tType &												Div( _tType &_vValues, _tScalarType _stScalar ) {
 			using Type = typename _tType::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsInt8<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							__m512 m0, m1, m2, m3;
-							Intrin::int8x64_to_float32x64( x, m0, m1, m2, m3 );
-							m0 = _mm512_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm512_div_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m2 = _mm512_div_ps( m2, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m3 = _mm512_div_ps( m3, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x64_to_int8x64_saturated( m0, m1, m2, m3 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint8<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							__m512 m0, m1, m2, m3;
-							Intrin::uint8x64_to_float32x64( x, m0, m1, m2, m3 );
-							m0 = _mm512_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm512_div_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m2 = _mm512_div_ps( m2, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m3 = _mm512_div_ps( m3, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x64_to_uint8x64_saturated( m0, m1, m2, m3 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsInt16<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							__m512 m0, m1;
-							Intrin::int16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm512_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm512_div_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_int16x32_saturated( m0, m1 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint16<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							__m512 m0, m1;
-							Intrin::uint16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm512_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm512_div_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_uint16x32_saturated( m0, m1 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsInt32<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							__m512 m0;
-							Intrin::int32x16_to_float32x16( x, m0 );
-							m0 = _mm512_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x16_to_int32x16_saturated( m0 );
-						}, [_stScalar](auto x) { return static_cast<double>(x) / static_cast<double>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint32<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) {
-							__m512 m0;
-							Intrin::uint32x16_to_float32x16( x, m0 );
-							m0 = _mm512_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x16_to_uint32x16_saturated( m0 );
-						}, [_stScalar](auto x) { return static_cast<double>(x) / static_cast<double>(_stScalar); } );
-				}
-
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) { return _mm512_div_ps( x, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); }, [_stScalar](auto x) { return x / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx512<_tType>( _vValues, [_stScalar](auto x) { return _mm512_div_pd( x, _mm512_set1_pd( static_cast<double>(_stScalar) ) ); }, [_stScalar](auto x) { return x / static_cast<Type>(_stScalar); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsInt8<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							__m256 m0, m1, m2, m3;
-							Intrin::int8x32_to_float32x32( x, m0, m1, m2, m3 );
-							m0 = _mm256_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm256_div_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m2 = _mm256_div_ps( m2, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m3 = _mm256_div_ps( m3, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_int8x32_saturated( m0, m1, m2, m3 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint8<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							__m256 m0, m1, m2, m3;
-							Intrin::uint8x32_to_float32x32( x, m0, m1, m2, m3 );
-							m0 = _mm256_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm256_div_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m2 = _mm256_div_ps( m2, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m3 = _mm256_div_ps( m3, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_uint8x32_saturated( m0, m1, m2, m3 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsInt16<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							__m256 m0, m1;
-							Intrin::int16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm256_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm256_div_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_int16x32_saturated( m0, m1 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint16<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							__m256 m0, m1;
-							Intrin::uint16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm256_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm256_div_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_uint16x32_saturated( m0, m1 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsInt32<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							__m256 m0;
-							Intrin::int32x16_to_float32x16_saturated( x, m0 );
-							m0 = _mm256_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x16_to_int32x16( m0 );
-						}, [_stScalar](auto x) { return static_cast<double>(x) / static_cast<double>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint32<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) {
-							__m256 m0;
-							Intrin::uint32x16_to_float32x16_saturated( x, m0 );
-							m0 = _mm256_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x16_to_uint32x16( m0 );
-						}, [_stScalar](auto x) { return static_cast<double>(x) / static_cast<double>(_stScalar); } );
-				}
-
-				if constexpr ( Types::IsFloat16<Type>() || Types::IsBFloat16<Type>() || Types::Is32BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) { return _mm256_div_ps( x, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); }, [_stScalar](auto x) { return x / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::Is64BitFloat<Type>() ) {
-					return FuncAvx2<_tType>( _vValues, [_stScalar](auto x) { return _mm256_div_pd( x, _mm512_set1_pd( static_cast<double>(_stScalar) ) ); }, [_stScalar](auto x) { return x / static_cast<Type>(_stScalar); } );
-				}
-			}
-#endif	// #ifdef __AVX2__
+			using Real = typename std::conditional<Types::IsInt<Type>(), double, TableReal<Type>>::type;
+			if ( TableScalar<Real>( _vValues, Kernels::NN9_KB_DIV, static_cast<Real>(_stScalar) ) ) { return _vValues; }
 			if constexpr ( Types::IsInt<Type>() ) {
 				return Func<_tType>( _vValues, [_stScalar](auto x) { return static_cast<double>(x) / static_cast<double>(_stScalar); } );
 			}
@@ -5269,125 +3820,8 @@ namespace nn9 {
 		template <typename _tTypeIn, typename _tTypeOut, typename _tScalarType>
 		static _tTypeOut &											Div( const _tTypeIn &_vIn, _tTypeOut &_vOut, _tScalarType _stScalar ) {
 			using TypeIn = typename _tTypeIn::value_type;
-#ifdef __AVX512F__
-			if ( Utilities::IsAvx512FSupported() ) {
-				if constexpr ( Types::IsInt8<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m512 m0, m1, m2, m3;
-							Intrin::int8x64_to_float32x64( x, m0, m1, m2, m3 );
-							m0 = _mm512_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm512_div_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m2 = _mm512_div_ps( m2, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m3 = _mm512_div_ps( m3, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x64_to_int8x64_saturated( m0, m1, m2, m3 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint8<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m512 m0, m1, m2, m3;
-							Intrin::uint8x64_to_float32x64( x, m0, m1, m2, m3 );
-							m0 = _mm512_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm512_div_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m2 = _mm512_div_ps( m2, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m3 = _mm512_div_ps( m3, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x64_to_uint8x64_saturated( m0, m1, m2, m3 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsInt16<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m512 m0, m1;
-							Intrin::int16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm512_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm512_div_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_int16x32_saturated( m0, m1 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint16<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m512 m0, m1;
-							Intrin::uint16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm512_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm512_div_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_uint16x32_saturated( m0, m1 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsInt32<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m512 m0;
-							Intrin::int32x16_to_float32x16( x, m0 );
-							m0 = _mm512_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x16_to_int32x16_saturated( m0 );
-						}, [_stScalar](auto x) { return static_cast<double>(x) / static_cast<double>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint32<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m512 m0;
-							Intrin::uint32x16_to_float32x16( x, m0 );
-							m0 = _mm512_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x16_to_uint32x16_saturated( m0 );
-						}, [_stScalar](auto x) { return static_cast<double>(x) / static_cast<double>(_stScalar); } );
-				}
-
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return _mm512_div_ps( x, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); }, [_stScalar](auto x) { return x / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx512<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return _mm512_div_pd( x, _mm512_set1_pd( static_cast<double>(_stScalar) ) ); }, [_stScalar](auto x) { return x / static_cast<TypeIn>(_stScalar); } );
-				}
-			}
-#endif	// #ifdef __AVX512F__
-
-#ifdef __AVX2__
-			if ( Utilities::IsAvx2Supported() ) {
-				if constexpr ( Types::IsInt8<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m256 m0, m1, m2, m3;
-							Intrin::int8x32_to_float32x32( x, m0, m1, m2, m3 );
-							m0 = _mm256_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm256_div_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m2 = _mm256_div_ps( m2, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m3 = _mm256_div_ps( m3, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_int8x32_saturated( m0, m1, m2, m3 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint8<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m256 m0, m1, m2, m3;
-							Intrin::uint8x32_to_float32x32( x, m0, m1, m2, m3 );
-							m0 = _mm256_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm256_div_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m2 = _mm256_div_ps( m2, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m3 = _mm256_div_ps( m3, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_uint8x32_saturated( m0, m1, m2, m3 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsInt16<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m256 m0, m1;
-							Intrin::int16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm256_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm256_div_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_int16x32_saturated( m0, m1 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint16<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m256 m0, m1;
-							Intrin::uint16x32_to_float32x32( x, m0, m1 );
-							m0 = _mm256_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); m1 = _mm256_div_ps( m1, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x32_to_uint16x32_saturated( m0, m1 );
-						}, [_stScalar](auto x) { return static_cast<float>(x) / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::IsInt32<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m256 m0;
-							Intrin::int32x16_to_float32x16( x, m0 );
-							m0 = _mm256_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x16_to_int32x16_saturated( m0 );
-						}, [_stScalar](auto x) { return static_cast<double>(x) / static_cast<double>(_stScalar); } );
-				}
-				if constexpr ( Types::IsUint32<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) {
-							__m256 m0;
-							Intrin::uint32x16_to_float32x16( x, m0 );
-							m0 = _mm256_div_ps( m0, _mm512_set1_ps( static_cast<float>(_stScalar) ) );
-							return Intrin::float32x16_to_uint32x16_saturated( m0 );
-						}, [_stScalar](auto x) { return static_cast<double>(x) / static_cast<double>(_stScalar); } );
-				}
-
-				if constexpr ( Types::IsFloat16<TypeIn>() || Types::IsBFloat16<TypeIn>() || Types::Is32BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return _mm256_div_ps( x, _mm512_set1_ps( static_cast<float>(_stScalar) ) ); }, [_stScalar](auto x) { return x / static_cast<float>(_stScalar); } );
-				}
-				if constexpr ( Types::Is64BitFloat<TypeIn>() ) {
-					return FuncAvx2<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return _mm256_div_pd( x, _mm512_set1_pd( static_cast<double>(_stScalar) ) ); }, [_stScalar](auto x) { return x / static_cast<TypeIn>(_stScalar); } );
-				}
-			}
-#endif	// #ifdef __AVX2__
+			using Real = typename std::conditional<Types::IsInt<TypeIn>(), double, TableReal<TypeIn>>::type;
+			if ( TableScalar<Real>( _vIn, _vOut, Kernels::NN9_KB_DIV, static_cast<Real>(_stScalar) ) ) { return _vOut; }
 			if constexpr ( Types::IsInt<TypeIn>() ) {
 				return Func<_tTypeIn, _tTypeOut>( _vIn, _vOut, [_stScalar](auto x) { return static_cast<double>(x) / static_cast<double>(_stScalar); } );
 			}
@@ -5416,6 +3850,2066 @@ namespace nn9 {
 			for ( size_t i = 0; i < _vIn.size(); ++i ) { Div( _vIn[i], _vOut[i], _stScalar ); }
 			return _vOut;
 		}
+
+
+		// ===============================
+		// Broadcasting Functions
+		// ===============================
+		/**
+		 * Computes element-wise a+b with NumPy-style broadcasting.  Shapes are aligned on their last dimensions and each dimension of _vA and _vB
+		 *	must either match _vOut or be 1.  Plain views are treated as 1-D.  Integer results saturate.
+		 * 
+		 * \tparam _tTypeA The left input view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vA The left input view.
+		 * \param _vB The right input view.
+		 * \param _vOut The output view.
+		 * \throw Throws if the inputs cannot be broadcast to the shape of _vOut.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeA, typename _tTypeB, typename _tTypeOut>
+		static _tTypeOut &											BroadcastAdd( const _tTypeA &_vA, const _tTypeB &_vB, _tTypeOut &_vOut ) {
+			using ValueType = typename _tTypeA::value_type;
+			using ValueTypeOut = typename _tTypeOut::value_type;
+			return BroadcastApply( _vA, _vB, _vOut, []( const View<ValueType> &_vRunA, const View<ValueType> &_vRunB, View<ValueTypeOut> &_vRunOut ) {
+				BinaryAdd( _vRunA, _vRunB, _vRunOut );
+			} );
+		}
+
+		/**
+		 * Computes element-wise a+b in place with NumPy-style broadcasting.  _vB is broadcast to the shape of _vA.
+		 * 
+		 * \tparam _tTypeA The input/output view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \param _vA The input/output view.
+		 * \param _vB The right input view.
+		 * \throw Throws if _vB cannot be broadcast to the shape of _vA.
+		 * \return Returns _vA.
+		 **/
+		template <typename _tTypeA, typename _tTypeB>
+		static _tTypeA &											BroadcastAdd( _tTypeA &_vA, const _tTypeB &_vB ) {
+			return BroadcastAdd( _vA, _vB, _vA );
+		}
+
+		/**
+		 * Computes element-wise a-b with NumPy-style broadcasting.  Shapes are aligned on their last dimensions and each dimension of _vA and _vB
+		 *	must either match _vOut or be 1.  Plain views are treated as 1-D.  Integer results saturate.
+		 * 
+		 * \tparam _tTypeA The left input view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vA The left input view.
+		 * \param _vB The right input view.
+		 * \param _vOut The output view.
+		 * \throw Throws if the inputs cannot be broadcast to the shape of _vOut.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeA, typename _tTypeB, typename _tTypeOut>
+		static _tTypeOut &											BroadcastSub( const _tTypeA &_vA, const _tTypeB &_vB, _tTypeOut &_vOut ) {
+			using ValueType = typename _tTypeA::value_type;
+			using ValueTypeOut = typename _tTypeOut::value_type;
+			return BroadcastApply( _vA, _vB, _vOut, []( const View<ValueType> &_vRunA, const View<ValueType> &_vRunB, View<ValueTypeOut> &_vRunOut ) {
+				BinarySub( _vRunA, _vRunB, _vRunOut );
+			} );
+		}
+
+		/**
+		 * Computes element-wise a-b in place with NumPy-style broadcasting.  _vB is broadcast to the shape of _vA.
+		 * 
+		 * \tparam _tTypeA The input/output view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \param _vA The input/output view.
+		 * \param _vB The right input view.
+		 * \throw Throws if _vB cannot be broadcast to the shape of _vA.
+		 * \return Returns _vA.
+		 **/
+		template <typename _tTypeA, typename _tTypeB>
+		static _tTypeA &											BroadcastSub( _tTypeA &_vA, const _tTypeB &_vB ) {
+			return BroadcastSub( _vA, _vB, _vA );
+		}
+
+		/**
+		 * Computes element-wise a*b with NumPy-style broadcasting.  Shapes are aligned on their last dimensions and each dimension of _vA and _vB
+		 *	must either match _vOut or be 1.  Plain views are treated as 1-D.  Integer results saturate.
+		 * 
+		 * \tparam _tTypeA The left input view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vA The left input view.
+		 * \param _vB The right input view.
+		 * \param _vOut The output view.
+		 * \throw Throws if the inputs cannot be broadcast to the shape of _vOut.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeA, typename _tTypeB, typename _tTypeOut>
+		static _tTypeOut &											BroadcastMul( const _tTypeA &_vA, const _tTypeB &_vB, _tTypeOut &_vOut ) {
+			using ValueType = typename _tTypeA::value_type;
+			using ValueTypeOut = typename _tTypeOut::value_type;
+			return BroadcastApply( _vA, _vB, _vOut, []( const View<ValueType> &_vRunA, const View<ValueType> &_vRunB, View<ValueTypeOut> &_vRunOut ) {
+				BinaryMul( _vRunA, _vRunB, _vRunOut );
+			} );
+		}
+
+		/**
+		 * Computes element-wise a*b in place with NumPy-style broadcasting.  _vB is broadcast to the shape of _vA.
+		 * 
+		 * \tparam _tTypeA The input/output view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \param _vA The input/output view.
+		 * \param _vB The right input view.
+		 * \throw Throws if _vB cannot be broadcast to the shape of _vA.
+		 * \return Returns _vA.
+		 **/
+		template <typename _tTypeA, typename _tTypeB>
+		static _tTypeA &											BroadcastMul( _tTypeA &_vA, const _tTypeB &_vB ) {
+			return BroadcastMul( _vA, _vB, _vA );
+		}
+
+		/**
+		 * Computes element-wise a/b with NumPy-style broadcasting.  Shapes are aligned on their last dimensions and each dimension of _vA and _vB
+		 *	must either match _vOut or be 1.  Plain views are treated as 1-D.  Integer results saturate.
+		 * 
+		 * \tparam _tTypeA The left input view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vA The left input view.
+		 * \param _vB The right input view.
+		 * \param _vOut The output view.
+		 * \throw Throws if the inputs cannot be broadcast to the shape of _vOut.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeA, typename _tTypeB, typename _tTypeOut>
+		static _tTypeOut &											BroadcastDiv( const _tTypeA &_vA, const _tTypeB &_vB, _tTypeOut &_vOut ) {
+			using ValueType = typename _tTypeA::value_type;
+			using ValueTypeOut = typename _tTypeOut::value_type;
+			return BroadcastApply( _vA, _vB, _vOut, []( const View<ValueType> &_vRunA, const View<ValueType> &_vRunB, View<ValueTypeOut> &_vRunOut ) {
+				BinaryDiv( _vRunA, _vRunB, _vRunOut );
+			} );
+		}
+
+		/**
+		 * Computes element-wise a/b in place with NumPy-style broadcasting.  _vB is broadcast to the shape of _vA.
+		 * 
+		 * \tparam _tTypeA The input/output view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \param _vA The input/output view.
+		 * \param _vB The right input view.
+		 * \throw Throws if _vB cannot be broadcast to the shape of _vA.
+		 * \return Returns _vA.
+		 **/
+		template <typename _tTypeA, typename _tTypeB>
+		static _tTypeA &											BroadcastDiv( _tTypeA &_vA, const _tTypeB &_vB ) {
+			return BroadcastDiv( _vA, _vB, _vA );
+		}
+
+		// ===============================
+		// Reduction Functions
+		// ===============================
+		/**
+		 * Gets the shape that results from reducing a shape over the given axes.
+		 * 
+		 * \param _vShape The shape to reduce.
+		 * \param _vAxes The axes over which to reduce.
+		 * \param _bKeepDims If true, reduced axes are kept with a size of 1; otherwise they are removed.
+		 * \throw Throws if an axis is out of range or repeated.
+		 * \return Returns the reduced shape.
+		 **/
+		static std::vector<size_t>									ReducedShape( const std::vector<size_t> &_vShape, const std::vector<size_t> &_vAxes, bool _bKeepDims = false ) {
+			const std::vector<bool> vReduced = ReduceAxes( _vShape.size(), _vAxes );
+			std::vector<size_t> vRet;
+			for ( size_t I = 0; I < _vShape.size(); ++I ) {
+				if ( !vReduced[I] ) { vRet.push_back( _vShape[I] ); }
+				else if ( _bKeepDims ) { vRet.push_back( 1 ); }
+			}
+			return vRet;
+		}
+
+		/**
+		 * Computes the sum of every element in a view.  bfloat16_t, float16, and float values are summed in float and everything else in double.
+		 *	Runs of values are summed with SIMD registers into leaves, and leaves are added pairwise.
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \param _vIn The input view.
+		 * \param _rmMode The summation mode.
+		 * \return Returns the sum, or 0 if the view is empty.
+		 **/
+		template <typename _tType>
+		static ReduceType<typename _tType::value_type>				Sum( const _tType &_vIn, NN9_REDUCE_MODE _rmMode = NN9_RM_PAIRWISE ) {
+			return ReduceAll<NN9_RO_SUM, ReduceType<typename _tType::value_type>>( _vIn, _rmMode, []( auto _aTotal, size_t ) { return _aTotal; } );
+		}
+
+		/**
+		 * Computes the sum of every element in a view with compensated (Kahan) summation.
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \param _vIn The input view.
+		 * \return Returns the sum, or 0 if the view is empty.
+		 **/
+		template <typename _tType>
+		static ReduceType<typename _tType::value_type>				KahanSum( const _tType &_vIn ) {
+			return Sum( _vIn, NN9_RM_KAHAN );
+		}
+
+		/**
+		 * Computes the mean of every element in a view.
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \param _vIn The input view.
+		 * \param _rmMode The summation mode.
+		 * \return Returns the mean, or NaN if the view is empty.
+		 **/
+		template <typename _tType>
+		static ReduceType<typename _tType::value_type>				Mean( const _tType &_vIn, NN9_REDUCE_MODE _rmMode = NN9_RM_PAIRWISE ) {
+			return ReduceAll<NN9_RO_SUM, ReduceType<typename _tType::value_type>>( _vIn, _rmMode, []( auto _aTotal, size_t _sCount ) {
+				return _aTotal / static_cast<decltype( _aTotal )>(_sCount);
+			} );
+		}
+
+		/**
+		 * Finds the largest element in a view.  NaN is returned if any element is NaN.
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \param _vIn The input view.
+		 * \throw Throws if the view is empty.
+		 * \return Returns the largest element.
+		 **/
+		template <typename _tType>
+		static typename _tType::value_type							Max( const _tType &_vIn ) {
+			return ReduceAll<NN9_RO_MAX, typename _tType::value_type>( _vIn, NN9_RM_PAIRWISE, []( auto _aTotal, size_t ) { return _aTotal; } );
+		}
+
+		/**
+		 * Finds the smallest element in a view.  NaN is returned if any element is NaN.
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \param _vIn The input view.
+		 * \throw Throws if the view is empty.
+		 * \return Returns the smallest element.
+		 **/
+		template <typename _tType>
+		static typename _tType::value_type							Min( const _tType &_vIn ) {
+			return ReduceAll<NN9_RO_MIN, typename _tType::value_type>( _vIn, NN9_RM_PAIRWISE, []( auto _aTotal, size_t ) { return _aTotal; } );
+		}
+
+		/**
+		 * Computes the 1-, 2-, or infinity-norm of every element in a view.
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \param _vIn The input view.
+		 * \param _dP The order of the norm: 1, 2, or INFINITY.
+		 * \param _rmMode The summation mode.
+		 * \throw Throws if _dP is not 1, 2, or INFINITY, or if _dP is INFINITY and the view is empty.
+		 * \return Returns the norm.
+		 **/
+		template <typename _tType>
+		static ReduceType<typename _tType::value_type>				Norm( const _tType &_vIn, double _dP = 2.0, NN9_REDUCE_MODE _rmMode = NN9_RM_PAIRWISE ) {
+			using Acc = ReduceType<typename _tType::value_type>;
+			if ( _dP == 2.0 ) { return ReduceAll<NN9_RO_SUM_SQ, Acc>( _vIn, _rmMode, []( auto _aTotal, size_t ) { return std::sqrt( _aTotal ); } ); }
+			if ( _dP == 1.0 ) { return ReduceAll<NN9_RO_SUM_ABS, Acc>( _vIn, _rmMode, []( auto _aTotal, size_t ) { return _aTotal; } ); }
+			if ( _dP == INFINITY ) { return ReduceAll<NN9_RO_MAX_ABS, Acc>( _vIn, _rmMode, []( auto _aTotal, size_t ) { return _aTotal; } ); }
+			throw std::invalid_argument( "Math::Norm: Only 1-, 2-, and infinity-norms are supported." );
+		}
+
+		/**
+		 * Finds the flat (row-major) index of the largest element in a view.  The first occurrence wins, and the first NaN beats everything.
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \param _vIn The input view.
+		 * \throw Throws if the view is empty.
+		 * \return Returns the index of the largest element.
+		 **/
+		template <typename _tType>
+		static size_t												ArgMax( const _tType &_vIn ) {
+			return ArgExtreme<true>( _vIn );
+		}
+
+		/**
+		 * Finds the flat (row-major) index of the smallest element in a view.  The first occurrence wins, and the first NaN beats everything.
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \param _vIn The input view.
+		 * \throw Throws if the view is empty.
+		 * \return Returns the index of the smallest element.
+		 **/
+		template <typename _tType>
+		static size_t												ArgMin( const _tType &_vIn ) {
+			return ArgExtreme<false>( _vIn );
+		}
+
+		/**
+		 * Sums a view over the given axes.  The shape of _vOut must be the shape of _vIn with the reduced axes removed or set to 1 (see
+		 *	ReducedShape()); dimensions of 1 are ignored when matching.  Plain views are treated as 1-D.  Reducing the innermost axis sums
+		 *	contiguous runs across SIMD lanes; reducing an outer axis adds whole rows into SIMD columns.  Large reductions are split across
+		 *	ThreadPool::Global(), either by output or, when there are too few outputs, into partial sums that are combined afterwards.
+		 * 
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vIn The input view.
+		 * \param _vAxes The axes over which to sum.
+		 * \param _vOut The output view.
+		 * \param _rmMode The summation mode.
+		 * \throw Throws if an axis is out of range or repeated or the output does not have the reduced shape.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeIn, typename _tTypeOut>
+		static _tTypeOut &											Sum( const _tTypeIn &_vIn, const std::vector<size_t> &_vAxes, _tTypeOut &_vOut, NN9_REDUCE_MODE _rmMode = NN9_RM_PAIRWISE ) {
+			return ReduceApply<NN9_RO_SUM>( _vIn, _vAxes, _vOut, _rmMode, []( auto _aTotal, size_t ) { return _aTotal; } );
+		}
+
+		/**
+		 * Averages a view over the given axes.  See Sum() for the layout rules.
+		 * 
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vIn The input view.
+		 * \param _vAxes The axes over which to average.
+		 * \param _vOut The output view.
+		 * \param _rmMode The summation mode.
+		 * \throw Throws if an axis is out of range or repeated or the output does not have the reduced shape.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeIn, typename _tTypeOut>
+		static _tTypeOut &											Mean( const _tTypeIn &_vIn, const std::vector<size_t> &_vAxes, _tTypeOut &_vOut, NN9_REDUCE_MODE _rmMode = NN9_RM_PAIRWISE ) {
+			return ReduceApply<NN9_RO_SUM>( _vIn, _vAxes, _vOut, _rmMode, []( auto _aTotal, size_t _sCount ) {
+				return _aTotal / static_cast<decltype( _aTotal )>(_sCount);
+			} );
+		}
+
+		/**
+		 * Finds the largest elements of a view over the given axes.  See Sum() for the layout rules.
+		 * 
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vIn The input view.
+		 * \param _vAxes The axes over which to search.
+		 * \param _vOut The output view.
+		 * \throw Throws if an axis is out of range or repeated, the output does not have the reduced shape, or a reduced axis is empty.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeIn, typename _tTypeOut>
+		static _tTypeOut &											Max( const _tTypeIn &_vIn, const std::vector<size_t> &_vAxes, _tTypeOut &_vOut ) {
+			return ReduceApply<NN9_RO_MAX>( _vIn, _vAxes, _vOut, NN9_RM_PAIRWISE, []( auto _aTotal, size_t ) { return _aTotal; } );
+		}
+
+		/**
+		 * Finds the smallest elements of a view over the given axes.  See Sum() for the layout rules.
+		 * 
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vIn The input view.
+		 * \param _vAxes The axes over which to search.
+		 * \param _vOut The output view.
+		 * \throw Throws if an axis is out of range or repeated, the output does not have the reduced shape, or a reduced axis is empty.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeIn, typename _tTypeOut>
+		static _tTypeOut &											Min( const _tTypeIn &_vIn, const std::vector<size_t> &_vAxes, _tTypeOut &_vOut ) {
+			return ReduceApply<NN9_RO_MIN>( _vIn, _vAxes, _vOut, NN9_RM_PAIRWISE, []( auto _aTotal, size_t ) { return _aTotal; } );
+		}
+
+		/**
+		 * Computes 1-, 2-, or infinity-norms of a view over the given axes.  See Sum() for the layout rules.
+		 * 
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vIn The input view.
+		 * \param _vAxes The axes over which to compute the norms.
+		 * \param _vOut The output view.
+		 * \param _dP The order of the norm: 1, 2, or INFINITY.
+		 * \param _rmMode The summation mode.
+		 * \throw Throws if _dP is not 1, 2, or INFINITY, an axis is out of range or repeated, or the output does not have the reduced shape.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeIn, typename _tTypeOut>
+		static _tTypeOut &											Norm( const _tTypeIn &_vIn, const std::vector<size_t> &_vAxes, _tTypeOut &_vOut, double _dP = 2.0, NN9_REDUCE_MODE _rmMode = NN9_RM_PAIRWISE ) {
+			if ( _dP == 2.0 ) { return ReduceApply<NN9_RO_SUM_SQ>( _vIn, _vAxes, _vOut, _rmMode, []( auto _aTotal, size_t ) { return std::sqrt( _aTotal ); } ); }
+			if ( _dP == 1.0 ) { return ReduceApply<NN9_RO_SUM_ABS>( _vIn, _vAxes, _vOut, _rmMode, []( auto _aTotal, size_t ) { return _aTotal; } ); }
+			if ( _dP == INFINITY ) { return ReduceApply<NN9_RO_MAX_ABS>( _vIn, _vAxes, _vOut, _rmMode, []( auto _aTotal, size_t ) { return _aTotal; } ); }
+			throw std::invalid_argument( "Math::Norm: Only 1-, 2-, and infinity-norms are supported." );
+		}
+
+		/**
+		 * Finds the indices of the largest elements of a view along an axis.  See Sum() for the layout rules.  The first occurrence wins, and
+		 *	the first NaN beats everything.
+		 * 
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vIn The input view.
+		 * \param _sAxis The axis along which to search.
+		 * \param _vOut The output view, which receives indices along _sAxis.
+		 * \throw Throws if the axis is out of range or empty or the output does not have the reduced shape.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeIn, typename _tTypeOut>
+		static _tTypeOut &											ArgMax( const _tTypeIn &_vIn, size_t _sAxis, _tTypeOut &_vOut ) {
+			return ArgExtreme<true>( _vIn, _sAxis, _vOut );
+		}
+
+		/**
+		 * Finds the indices of the smallest elements of a view along an axis.  See Sum() for the layout rules.  The first occurrence wins, and
+		 *	the first NaN beats everything.
+		 * 
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vIn The input view.
+		 * \param _sAxis The axis along which to search.
+		 * \param _vOut The output view, which receives indices along _sAxis.
+		 * \throw Throws if the axis is out of range or empty or the output does not have the reduced shape.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeIn, typename _tTypeOut>
+		static _tTypeOut &											ArgMin( const _tTypeIn &_vIn, size_t _sAxis, _tTypeOut &_vOut ) {
+			return ArgExtreme<false>( _vIn, _sAxis, _vOut );
+		}
+
+	protected :
+		// == Enumerations.
+		/** Reduction operations. */
+		enum NN9_REDUCE_OP : size_t {
+			NN9_RO_SUM,																					/**< Sum of the values. */
+			NN9_RO_SUM_SQ,																				/**< Sum of the squares of the values. */
+			NN9_RO_SUM_ABS,																				/**< Sum of the absolute values. */
+			NN9_RO_MAX,																					/**< Largest value. */
+			NN9_RO_MIN,																					/**< Smallest value. */
+			NN9_RO_MAX_ABS,																				/**< Largest absolute value. */
+		};
+
+
+		// == Types.
+		/** The accumulator type of a reduction.  Maximums and minimums of integers are found in the integer type and everything else in ReduceType<>. */
+		template <NN9_REDUCE_OP _roOp, typename _tType>
+		using ReduceAcc = typename std::conditional<(_roOp == NN9_RO_MAX || _roOp == NN9_RO_MIN) && !nn9::Types::SimdFloat<_tType>() && !nn9::Types::SimdDouble<_tType>(),
+			_tType, ReduceType<_tType>>::type;
+
+		/** A dimension of a reduction after sorting and collapsing. */
+		struct NN9_REDUCE_DIM {
+			size_t													sSize;						/**< The number of elements along the dimension. */
+			size_t													sStrideIn;					/**< The input stride, in elements. */
+			size_t													sStrideOut;					/**< The output stride, in elements.  0 for reduced dimensions. */
+			bool													bReduced;					/**< True if the dimension is reduced. */
+		};
+
+		/** The running state of 1 reduction. */
+		template <typename _tAcc>
+		struct NN9_REDUCE_STATE {
+			_tAcc													aLevels[64];				/**< Pairwise: the partial sum at each level of the cascade.  Level I holds 2^I leaves. */
+			uint64_t												ui64Leaves = 0;				/**< Pairwise: the number of leaves pushed, whose set bits mark the occupied levels. */
+			_tAcc													aLeaf = _tAcc( 0 );			/**< Pairwise: the leaf being filled. */
+			size_t													sLeaf = 0;					/**< Pairwise: the number of values in aLeaf. */
+			_tAcc													aSum = _tAcc( 0 );			/**< Kahan: the running sum. */
+			_tAcc													aComp = _tAcc( 0 );			/**< Kahan: the running compensation.  The total is aSum + aComp. */
+			_tAcc													aExt = _tAcc( 0 );			/**< Maximum/minimum: the running extreme. */
+		};
+
+		/** Scalar registers for the reduction kernels.  Each ISA provides the same members so that 1 set of kernels serves them all. */
+		template <typename _tAcc>
+		struct NN9_REDUCE_SCALAR {
+			typedef _tAcc											Acc;
+			typedef _tAcc											Reg;
+			static constexpr size_t									Lanes = 1;
+			static constexpr bool									FromTable = false;
+
+			template <typename _tType>
+			static inline Reg										Load( const _tType * _ptSrc ) { return static_cast<Acc>(*_ptSrc); }
+			static inline void										Store( Acc * _paDst, Reg _rVal ) { (*_paDst) = _rVal; }
+			static inline Reg										Set1( Acc _aVal ) { return _aVal; }
+			static inline Reg										Add( Reg _rA, Reg _rB ) { return _rA + _rB; }
+			static inline Reg										Sub( Reg _rA, Reg _rB ) { return _rA - _rB; }
+			static inline Reg										Mul( Reg _rA, Reg _rB ) { return _rA * _rB; }
+			static inline Reg										Abs( Reg _rA ) { return _rA < Acc( 0 ) ? -_rA : _rA; }
+			static inline Reg										Max( Reg _rAcc, Reg _rVal ) { return (_rVal != _rVal || _rVal > _rAcc) ? _rVal : _rAcc; }
+			static inline Reg										Min( Reg _rAcc, Reg _rVal ) { return (_rVal != _rVal || _rVal < _rAcc) ? _rVal : _rAcc; }
+		};
+
+		/**
+		 * Reductions through Kernels::Table().  Contiguous runs go to the table's pfFold* or pfKahan* entries and rows folded into column
+		 *	accumulators to pfFoldRow* or pfKahanRow*, with the first row's terms made by pfUnary*.  float16 and bfloat16 are widened to float
+		 *	through pfToF32 a block at a time.  Used only for float, float16, and bfloat16 into float or double into double.
+		 */
+		template <typename _tAcc>
+		struct NN9_REDUCE_TABLE : public NN9_REDUCE_SCALAR<_tAcc> {
+			static constexpr bool									FromTable = true;
+			static_assert( size_t( NN9_RO_SUM ) == size_t( Kernels::NN9_KR_SUM ) && size_t( NN9_RO_SUM_SQ ) == size_t( Kernels::NN9_KR_SUM_SQ ) &&
+				size_t( NN9_RO_SUM_ABS ) == size_t( Kernels::NN9_KR_SUM_ABS ) && size_t( NN9_RO_MAX ) == size_t( Kernels::NN9_KR_MAX ) &&
+				size_t( NN9_RO_MIN ) == size_t( Kernels::NN9_KR_MIN ) && size_t( NN9_RO_MAX_ABS ) == size_t( Kernels::NN9_KR_MAX_ABS ),
+				"Math::NN9_REDUCE_TABLE: NN9_REDUCE_OP and Kernels::NN9_KERNEL_REDUCE must match." );
+
+			/** Gets the kernel that folds a run into an accumulator. */
+			template <NN9_REDUCE_OP _roOp>
+			static inline auto										Fold() {
+				if constexpr ( std::is_same<_tAcc, double>::value ) { return Kernels::Table().pfFoldF64[_roOp]; }
+				else { return Kernels::Table().pfFoldF32[_roOp]; }
+			}
+			/** Gets the kernel that folds a row into column accumulators. */
+			template <NN9_REDUCE_OP _roOp>
+			static inline auto										FoldRow() {
+				if constexpr ( std::is_same<_tAcc, double>::value ) { return Kernels::Table().pfFoldRowF64[_roOp]; }
+				else { return Kernels::Table().pfFoldRowF32[_roOp]; }
+			}
+			/** Gets the kernel that adds a run to a Neumaier sum. */
+			template <NN9_REDUCE_OP _roOp>
+			static inline auto										Kahan() {
+				if constexpr ( std::is_same<_tAcc, double>::value ) { return Kernels::Table().pfKahanF64[_roOp]; }
+				else { return Kernels::Table().pfKahanF32[_roOp]; }
+			}
+			/** Gets the kernel that adds a row to column Kahan sums. */
+			template <NN9_REDUCE_OP _roOp>
+			static inline auto										KahanRow() {
+				if constexpr ( std::is_same<_tAcc, double>::value ) { return Kernels::Table().pfKahanRowF64[_roOp]; }
+				else { return Kernels::Table().pfKahanRowF32[_roOp]; }
+			}
+			/** Gets the kernel that widens values to the accumulator type. */
+			template <typename _tType>
+			static inline auto										ToAcc() {
+				if constexpr ( std::is_same<_tAcc, double>::value ) { return Kernels::Table().pfToF64[KernelType<_tType>()]; }
+				else { return Kernels::Table().pfToF32[KernelType<_tType>()]; }
+			}
+			/** Writes the terms that values add to a sum or extreme: the values, their squares, or their absolute values. */
+			template <NN9_REDUCE_OP _roOp>
+			static inline void										Terms( const _tAcc * _paIn, _tAcc * _paOut, size_t _sTotal ) {
+				if constexpr ( _roOp == NN9_RO_SUM_SQ || _roOp == NN9_RO_SUM_ABS || _roOp == NN9_RO_MAX_ABS ) {
+					constexpr Kernels::NN9_KERNEL_UNARY kuOp = _roOp == NN9_RO_SUM_SQ ? Kernels::NN9_KU_SQUARE : Kernels::NN9_KU_ABS;
+					if constexpr ( std::is_same<_tAcc, double>::value ) { Kernels::Table().pfUnaryF64[kuOp]( _paIn, _paOut, _sTotal ); }
+					else { Kernels::Table().pfUnaryF32[kuOp]( _paIn, _paOut, _sTotal ); }
+				}
+				else { std::copy( _paIn, _paIn + _sTotal, _paOut ); }
+			}
+		};
+
+
+		// == Members.
+		static inline std::atomic<size_t>							m_aParallelThreshold { NN9_P_THRESHOLD };	/**< Number of elements at or above which views are split across threads. */
+
+
+		// == Functions.
+		/**
+		 * Runs a flat in-place kernel over a strided view.  A contiguous view is handed to the kernel whole; otherwise contiguous runs are
+		 *	handed over directly and strided runs are gathered into blocks, processed, and scattered back.
+		 * 
+		 * \tparam _tType The strided view type.
+		 * \tparam _tKernel The kernel type, called with a View over contiguous data.
+		 * \param _vValues The input/output view to modify.
+		 * \param _kKernel The kernel to run.
+		 * \throw If NN9_SAFETY_CHECK, throws if the view has overlapping (expanded) elements.
+		 * \return Returns _vValues.
+		 **/
+		template <typename _tType, typename _tKernel>
+		static _tType &												StridedApply( _tType &_vValues, _tKernel _kKernel ) {
+			using ValueType = typename _tType::value_type;
+#ifdef NN9_SAFETY_CHECK
+			if ( _vValues.Overlaps() ) { throw std::runtime_error( "Math::StridedApply: Cannot write to an expanded view." ); }
+#endif	// #ifdef NN9_SAFETY_CHECK
+			if ( !_vValues.size() ) { return _vValues; }
+			if ( _vValues.IsContiguous() ) {
+				View<ValueType> vRun( _vValues.Data(), _vValues.size(), nullptr );
+				_kKernel( vRun );
+				return _vValues;
+			}
+			_vValues.ForEachRun( [&]( ValueType * _pRun, size_t _sTotal, size_t _sStride ) {
+				if ( _sStride == 1 ) {
+					View<ValueType> vRun( _pRun, _sTotal, nullptr );
+					_kKernel( vRun );
+					return;
+				}
+				NN9_ALIGN( 64 )
+				ValueType vtBlock[_tType::NN9_SV_BLOCK];
+				for ( size_t I = 0; I < _sTotal; I += _tType::NN9_SV_BLOCK ) {
+					size_t sBlock = std::min<size_t>( _sTotal - I, _tType::NN9_SV_BLOCK );
+					ValueType * pRun = _pRun + I * _sStride;
+					for ( size_t J = 0; J < sBlock; ++J ) { vtBlock[J] = pRun[J*_sStride]; }
+					View<ValueType> vRun( vtBlock, sBlock, nullptr );
+					_kKernel( vRun );
+					for ( size_t J = 0; J < sBlock; ++J ) { pRun[J*_sStride] = vtBlock[J]; }
+				}
+			} );
+			return _vValues;
+		}
+
+		/**
+		 * Runs a flat input/output kernel where either side may be a strided view.  If both sides are contiguous the kernel is run once
+		 *	over everything; otherwise non-contiguous sides are gathered into or scattered out of contiguous blocks.
+		 * 
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \tparam _tKernel The kernel type, called with Views over contiguous input and output data.
+		 * \param _vIn The input view.
+		 * \param _vOut The output view.
+		 * \param _kKernel The kernel to run.
+		 * \throw If NN9_SAFETY_CHECK, throws if the views are not the same lengths or the output has overlapping (expanded) elements.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeIn, typename _tTypeOut, typename _tKernel>
+		static _tTypeOut &											StridedApply( const _tTypeIn &_vIn, _tTypeOut &_vOut, _tKernel _kKernel ) {
+			using ValueTypeIn = typename _tTypeIn::value_type;
+			using ValueTypeOut = typename _tTypeOut::value_type;
+			constexpr bool bStridedIn = IsStridedView<std::remove_cvref_t<_tTypeIn>>::value;
+			constexpr bool bStridedOut = IsStridedView<std::remove_cvref_t<_tTypeOut>>::value;
+#ifdef NN9_SAFETY_CHECK
+			if ( _vIn.size() != _vOut.size() ) { throw std::runtime_error( "Math::StridedApply: Input and outputs must have the same number of elements." ); }
+			if constexpr ( bStridedOut ) {
+				if ( _vOut.Overlaps() ) { throw std::runtime_error( "Math::StridedApply: Cannot write to an expanded view." ); }
+			}
+#endif	// #ifdef NN9_SAFETY_CHECK
+			const size_t sSize = _vOut.size();
+			if ( !sSize ) { return _vOut; }
+
+			const ValueTypeIn * pIn = nullptr;
+			ValueTypeOut * pOut = nullptr;
+			if constexpr ( bStridedIn ) {
+				if ( _vIn.IsContiguous() ) { pIn = _vIn.Data(); }
+			}
+			else { pIn = &_vIn[0]; }
+			if constexpr ( bStridedOut ) {
+				if ( _vOut.IsContiguous() ) { pOut = _vOut.Data(); }
+			}
+			else { pOut = &_vOut[0]; }
+
+			if ( pIn && pOut ) {
+				const View<ValueTypeIn> vRunIn( const_cast<ValueTypeIn *>(pIn), sSize, nullptr );
+				View<ValueTypeOut> vRunOut( pOut, sSize, nullptr );
+				_kKernel( vRunIn, vRunOut );
+				return _vOut;
+			}
+
+			constexpr size_t sBlockSize = StridedView<ValueTypeOut>::NN9_SV_BLOCK;
+			NN9_ALIGN( 64 )
+			ValueTypeIn vtiBlock[sBlockSize];
+			NN9_ALIGN( 64 )
+			ValueTypeOut vtoBlock[sBlockSize];
+			for ( size_t I = 0; I < sSize; I += sBlockSize ) {
+				size_t sBlock = std::min<size_t>( sSize - I, sBlockSize );
+				const ValueTypeIn * pBlockIn = pIn ? pIn + I : vtiBlock;
+				ValueTypeOut * pBlockOut = pOut ? pOut + I : vtoBlock;
+				if constexpr ( bStridedIn ) {
+					if ( !pIn ) { _vIn.Gather( I, sBlock, vtiBlock ); }
+				}
+				const View<ValueTypeIn> vRunIn( const_cast<ValueTypeIn *>(pBlockIn), sBlock, nullptr );
+				View<ValueTypeOut> vRunOut( pBlockOut, sBlock, nullptr );
+				_kKernel( vRunIn, vRunOut );
+				if constexpr ( bStridedOut ) {
+					if ( !pOut ) { _vOut.Scatter( I, sBlock, vtoBlock ); }
+				}
+			}
+			return _vOut;
+		}
+
+		/** Saturated a+b.  Every binary operation provides the same members so that BinaryOp() serves them all; Kernel selects its entry in
+		 *	Kernels::NN9_TABLE::pfBinaryF32 and pfBinaryF64. */
+		struct NN9_BINARY_ADD {
+			static constexpr Kernels::NN9_KERNEL_BINARY				Kernel = Kernels::NN9_KB_ADD;
+
+			template <typename _tType>
+			static inline auto										Scalar( _tType _tA, _tType _tB ) {
+				if constexpr ( Types::IsBool<_tType>() ) { return static_cast<int16_t>(_tA) + static_cast<int16_t>(_tB); }
+				else if constexpr ( Types::IsInt<_tType>() ) { return nn9::adds( _tA, _tB ); }
+				else if constexpr ( Types::Is64BitFloat<_tType>() ) { return _tA + _tB; }
+				else { return static_cast<float>(_tA) + static_cast<float>(_tB); }
+			}
+		};
+
+		/** Saturated a-b. */
+		struct NN9_BINARY_SUB {
+			static constexpr Kernels::NN9_KERNEL_BINARY				Kernel = Kernels::NN9_KB_SUB;
+
+			template <typename _tType>
+			static inline auto										Scalar( _tType _tA, _tType _tB ) {
+				if constexpr ( Types::IsBool<_tType>() ) { return static_cast<int16_t>(_tA) - static_cast<int16_t>(_tB); }
+				else if constexpr ( Types::IsInt<_tType>() ) { return nn9::subs( _tA, _tB ); }
+				else if constexpr ( Types::Is64BitFloat<_tType>() ) { return _tA - _tB; }
+				else { return static_cast<float>(_tA) - static_cast<float>(_tB); }
+			}
+		};
+
+		/** a*b.  Integers are multiplied as doubles and saturated on the way back. */
+		struct NN9_BINARY_MUL {
+			static constexpr Kernels::NN9_KERNEL_BINARY				Kernel = Kernels::NN9_KB_MUL;
+
+			template <typename _tType>
+			static inline auto										Scalar( _tType _tA, _tType _tB ) {
+				if constexpr ( Types::IsInt<_tType>() ) { return static_cast<double>(_tA) * static_cast<double>(_tB); }
+				else if constexpr ( Types::Is64BitFloat<_tType>() ) { return _tA * _tB; }
+				else { return static_cast<float>(_tA) * static_cast<float>(_tB); }
+			}
+		};
+
+		/** a/b.  Integers are divided as doubles and saturated on the way back. */
+		struct NN9_BINARY_DIV {
+			static constexpr Kernels::NN9_KERNEL_BINARY				Kernel = Kernels::NN9_KB_DIV;
+
+			template <typename _tType>
+			static inline auto										Scalar( _tType _tA, _tType _tB ) {
+				if constexpr ( Types::IsInt<_tType>() ) { return static_cast<double>(_tA) / static_cast<double>(_tB); }
+				else if constexpr ( Types::Is64BitFloat<_tType>() ) { return _tA / _tB; }
+				else { return static_cast<float>(_tA) / static_cast<float>(_tB); }
+			}
+		};
+
+		/**
+		 * Computes element-wise a (op) b over two flat views, either of which may have a single element that is paired with every item in the
+		 *	other.  Runs through Kernels::Table() when it has kernels for the types (see TableBinary()) and falls back to _tOp::Scalar().
+		 *	Integer sums and differences are saturated to the input type first, as _tOp::Scalar() does; integer products and quotients are
+		 *	computed as float only when they are saturated back to an input type narrower than 32 bits, where float gives the same results,
+		 *	and as double otherwise.
+		 * 
+		 * \tparam _tOp The binary operation (NN9_BINARY_ADD, NN9_BINARY_SUB, NN9_BINARY_MUL, NN9_BINARY_DIV).
+		 * \tparam _tTypeA The left input view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vA The left input view.
+		 * \param _vB The right input view.
+		 * \param _vOut The output view.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tOp, typename _tTypeA, typename _tTypeB, typename _tTypeOut>
+		static _tTypeOut &											BinaryOp( const _tTypeA &_vA, const _tTypeB &_vB, _tTypeOut &_vOut ) {
+			using Type = typename _tTypeA::value_type;
+			using TypeOut = typename _tTypeOut::value_type;
+			constexpr bool bSaturate = _tOp::Kernel == Kernels::NN9_KB_ADD || _tOp::Kernel == Kernels::NN9_KB_SUB;
+			using Real = typename std::conditional<Types::IsInt<Type>() && !bSaturate && !std::is_same<Type, TypeOut>::value, double, TableReal<Type>>::type;
+			if ( TableBinary<Real>( _vA, _vB, _vOut, _tOp::Kernel, bSaturate ) ) { return _vOut; }
+			return BinaryFunc( _vA, _vB, _vOut, []( auto a, auto b ) { return _tOp::template Scalar<Type>( a, b ); } );
+		}
+
+		/**
+		 * Computes element-wise a+b over two flat views, either of which may have a single element that is paired with every item in the
+		 *	other.  Integer results saturate.
+		 * 
+		 * \tparam _tTypeA The left input view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vA The left input view.
+		 * \param _vB The right input view.
+		 * \param _vOut The output view.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeA, typename _tTypeB, typename _tTypeOut>
+		static _tTypeOut &											BinaryAdd( const _tTypeA &_vA, const _tTypeB &_vB, _tTypeOut &_vOut ) { return BinaryOp<NN9_BINARY_ADD>( _vA, _vB, _vOut ); }
+
+		/**
+		 * Computes element-wise a-b over two flat views, either of which may have a single element that is paired with every item in the
+		 *	other.  Integer results saturate.
+		 * 
+		 * \tparam _tTypeA The left input view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vA The left input view.
+		 * \param _vB The right input view.
+		 * \param _vOut The output view.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeA, typename _tTypeB, typename _tTypeOut>
+		static _tTypeOut &											BinarySub( const _tTypeA &_vA, const _tTypeB &_vB, _tTypeOut &_vOut ) { return BinaryOp<NN9_BINARY_SUB>( _vA, _vB, _vOut ); }
+
+		/**
+		 * Computes element-wise a*b over two flat views, either of which may have a single element that is paired with every item in the
+		 *	other.  Integer results saturate.
+		 * 
+		 * \tparam _tTypeA The left input view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vA The left input view.
+		 * \param _vB The right input view.
+		 * \param _vOut The output view.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeA, typename _tTypeB, typename _tTypeOut>
+		static _tTypeOut &											BinaryMul( const _tTypeA &_vA, const _tTypeB &_vB, _tTypeOut &_vOut ) { return BinaryOp<NN9_BINARY_MUL>( _vA, _vB, _vOut ); }
+
+		/**
+		 * Computes element-wise a/b over two flat views, either of which may have a single element that is paired with every item in the
+		 *	other.  Integer results saturate.
+		 * 
+		 * \tparam _tTypeA The left input view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vA The left input view.
+		 * \param _vB The right input view.
+		 * \param _vOut The output view.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeA, typename _tTypeB, typename _tTypeOut>
+		static _tTypeOut &											BinaryDiv( const _tTypeA &_vA, const _tTypeB &_vB, _tTypeOut &_vOut ) { return BinaryOp<NN9_BINARY_DIV>( _vA, _vB, _vOut ); }
+
+		/**
+		 * Runs a flat binary kernel over two inputs broadcast to the shape of an output.  Dimensions that are 1 in every operand are dropped and
+		 *	adjacent dimensions that are laid out back-to-back in every operand are merged, then the kernel is run once per innermost run.  An input
+		 *	that is broadcast along the innermost run (a column broadcast) is handed to the kernel as a single element; an input that is broadcast
+		 *	along an outer dimension (a row broadcast) simply has its run revisited.  Runs with other strides are gathered into and scattered out of
+		 *	contiguous blocks.
+		 * 
+		 * \tparam _tTypeA The left input view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \tparam _tKernel The kernel type, called with Views over contiguous left, right, and output data.  Inputs may have 1 element.
+		 * \param _vA The left input view.
+		 * \param _vB The right input view.
+		 * \param _vOut The output view.
+		 * \param _kKernel The kernel to run.
+		 * \throw Throws if the inputs cannot be broadcast to the shape of _vOut.  If NN9_SAFETY_CHECK, also throws if the output has overlapping
+		 *	(expanded) elements.
+		 * \return Returns _vOut.
+		 **/
+		template <typename _tTypeA, typename _tTypeB, typename _tTypeOut, typename _tKernel>
+		static _tTypeOut &											BroadcastApply( const _tTypeA &_vA, const _tTypeB &_vB, _tTypeOut &_vOut, _tKernel _kKernel ) {
+			using ValueType = typename _tTypeA::value_type;
+			using ValueTypeOut = typename _tTypeOut::value_type;
+			static_assert( std::is_same<ValueType, typename _tTypeB::value_type>::value, "Math::BroadcastApply: Both inputs must have the same type." );
+#ifdef NN9_SAFETY_CHECK
+			if constexpr ( IsStridedView<std::remove_cvref_t<_tTypeOut>>::value ) {
+				if ( _vOut.Overlaps() ) { throw std::runtime_error( "Math::BroadcastApply: Cannot write to an expanded view." ); }
+			}
+#endif	// #ifdef NN9_SAFETY_CHECK
+			std::vector<size_t> vShape, vStrideOut;
+			BroadcastLayout( _vOut, vShape, vStrideOut );
+			std::vector<size_t> vStrideA = BroadcastStrides( _vA, vShape );
+			std::vector<size_t> vStrideB = BroadcastStrides( _vB, vShape );
+			for ( auto I = vShape.size(); I--; ) {
+				if ( !vShape[I] ) { return _vOut; }
+			}
+
+			// Collapse.
+			std::vector<size_t> vDims, vA, vB, vO;
+			for ( size_t I = 0; I < vShape.size(); ++I ) {
+				if ( vShape[I] == 1 ) { continue; }
+				if ( vDims.size() && vA.back() == vStrideA[I] * vShape[I] && vB.back() == vStrideB[I] * vShape[I] && vO.back() == vStrideOut[I] * vShape[I] ) {
+					vDims.back() *= vShape[I];
+					vA.back() = vStrideA[I];
+					vB.back() = vStrideB[I];
+					vO.back() = vStrideOut[I];
+					continue;
+				}
+				vDims.push_back( vShape[I] );
+				vA.push_back( vStrideA[I] );
+				vB.push_back( vStrideB[I] );
+				vO.push_back( vStrideOut[I] );
+			}
+			if ( vDims.empty() ) {
+				vDims.push_back( 1 );
+				vA.push_back( 0 );
+				vB.push_back( 0 );
+				vO.push_back( 1 );
+			}
+
+			const ValueType * pA = BroadcastData( _vA );
+			const ValueType * pB = BroadcastData( _vB );
+			ValueTypeOut * pOut = BroadcastData( _vOut );
+			const size_t sRank = vDims.size() - 1;
+			const size_t sRun = vDims[sRank];
+			const size_t sStrideA = vA[sRank], sStrideB = vB[sRank], sStrideOut = vO[sRank];
+			size_t sOuter = 1;
+			for ( size_t I = 0; I < sRank; ++I ) { sOuter *= vDims[I]; }
+
+			std::vector<size_t> vIdx( sRank );
+			size_t sOffA = 0, sOffB = 0, sOffOut = 0;
+			for ( size_t O = 0; O < sOuter; ++O ) {
+				const ValueType * pRunA = pA + sOffA;
+				const ValueType * pRunB = pB + sOffB;
+				ValueTypeOut * pRunOut = pOut + sOffOut;
+				if ( sStrideA <= 1 && sStrideB <= 1 && sStrideOut == 1 ) {
+					const View<ValueType> vRunA( const_cast<ValueType *>(pRunA), sStrideA ? sRun : 1, nullptr );
+					const View<ValueType> vRunB( const_cast<ValueType *>(pRunB), sStrideB ? sRun : 1, nullptr );
+					View<ValueTypeOut> vRunOut( pRunOut, sRun, nullptr );
+					_kKernel( vRunA, vRunB, vRunOut );
+				}
+				else {
+					constexpr size_t sBlockSize = StridedView<ValueTypeOut>::NN9_SV_BLOCK;
+					NN9_ALIGN( 64 )
+					ValueType vtaBlock[sBlockSize];
+					NN9_ALIGN( 64 )
+					ValueType vtbBlock[sBlockSize];
+					NN9_ALIGN( 64 )
+					ValueTypeOut vtoBlock[sBlockSize];
+					for ( size_t I = 0; I < sRun; I += sBlockSize ) {
+						const size_t sBlock = std::min<size_t>( sRun - I, sBlockSize );
+						const ValueType * pBlockA = pRunA;
+						const ValueType * pBlockB = pRunB;
+						ValueTypeOut * pBlockOut = sStrideOut == 1 ? pRunOut + I : vtoBlock;
+						if ( sStrideA == 1 ) { pBlockA = pRunA + I; }
+						else if ( sStrideA ) {
+							for ( size_t J = 0; J < sBlock; ++J ) { vtaBlock[J] = pRunA[(I+J)*sStrideA]; }
+							pBlockA = vtaBlock;
+						}
+						if ( sStrideB == 1 ) { pBlockB = pRunB + I; }
+						else if ( sStrideB ) {
+							for ( size_t J = 0; J < sBlock; ++J ) { vtbBlock[J] = pRunB[(I+J)*sStrideB]; }
+							pBlockB = vtbBlock;
+						}
+						const View<ValueType> vRunA( const_cast<ValueType *>(pBlockA), sStrideA ? sBlock : 1, nullptr );
+						const View<ValueType> vRunB( const_cast<ValueType *>(pBlockB), sStrideB ? sBlock : 1, nullptr );
+						View<ValueTypeOut> vRunOut( pBlockOut, sBlock, nullptr );
+						_kKernel( vRunA, vRunB, vRunOut );
+						if ( sStrideOut != 1 ) {
+							for ( size_t J = 0; J < sBlock; ++J ) { pRunOut[(I+J)*sStrideOut] = vtoBlock[J]; }
+						}
+					}
+				}
+
+				// Advance the odometer over the outer dimensions.
+				for ( size_t I = sRank; I--; ) {
+					sOffA += vA[I];
+					sOffB += vB[I];
+					sOffOut += vO[I];
+					if ( ++vIdx[I] < vDims[I] ) { break; }
+					sOffA -= vA[I] * vDims[I];
+					sOffB -= vB[I] * vDims[I];
+					sOffOut -= vO[I] * vDims[I];
+					vIdx[I] = 0;
+				}
+			}
+			return _vOut;
+		}
+
+		/**
+		 * Gets the shape and strides of a view.  Plain views are treated as 1-D.
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \param _vView The view whose layout is to be gotten.
+		 * \param _vShape Holds the returned shape.
+		 * \param _vStrides Holds the returned strides, in elements.
+		 **/
+		template <typename _tType>
+		static void													BroadcastLayout( const _tType &_vView, std::vector<size_t> &_vShape, std::vector<size_t> &_vStrides ) {
+			if constexpr ( IsStridedView<std::remove_cvref_t<_tType>>::value ) {
+				_vShape = _vView.Shape();
+				_vStrides = _vView.Strides();
+			}
+			else {
+				_vShape.assign( 1, _vView.size() );
+				_vStrides.assign( 1, 1 );
+			}
+		}
+
+		/**
+		 * Gets the strides with which to walk an input broadcast to a given shape.  Broadcast dimensions get a stride of 0.
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \param _vView The input view.
+		 * \param _vShape The shape to which to broadcast the input.
+		 * \throw Throws if the input cannot be broadcast to _vShape.
+		 * \return Returns the strides of the input, one for each dimension in _vShape.
+		 **/
+		template <typename _tType>
+		static std::vector<size_t>									BroadcastStrides( const _tType &_vView, const std::vector<size_t> &_vShape ) {
+			std::vector<size_t> vShape, vStrides;
+			BroadcastLayout( _vView, vShape, vStrides );
+			if ( vShape.size() > _vShape.size() ) { throw std::invalid_argument( "Math::BroadcastStrides: Shapes cannot be broadcast." ); }
+
+			std::vector<size_t> vRet( _vShape.size() );
+			const size_t sLead = _vShape.size() - vShape.size();
+			for ( size_t I = 0; I < vShape.size(); ++I ) {
+				if ( vShape[I] == _vShape[sLead+I] ) { vRet[sLead+I] = vStrides[I]; }
+				else if ( vShape[I] != 1 ) { throw std::invalid_argument( "Math::BroadcastStrides: Shapes cannot be broadcast." ); }
+			}
+			return vRet;
+		}
+
+		/**
+		 * Gets a pointer to the first element of a view.
+		 * 
+		 * \tparam _tType The view/container type.
+		 * \param _vView The view.
+		 * \return Returns a pointer to the first element of the view, or nullptr if it is empty.
+		 **/
+		template <typename _tType>
+		static auto *												BroadcastData( _tType &_vView ) {
+			if constexpr ( IsStridedView<std::remove_cvref_t<_tType>>::value ) { return _vView.Data(); }
+			else { return _vView.size() ? &_vView[0] : nullptr; }
+		}
+
+		/**
+		 * Determines whether each input to a binary kernel has either 1 element or as many elements as the output.
+		 * 
+		 * \tparam _tTypeA The left input view/container type.
+		 * \tparam _tTypeB The right input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vA The left input view.
+		 * \param _vB The right input view.
+		 * \param _vOut The output view.
+		 * \return Returns true if the sizes of the views are compatible.
+		 **/
+		template <typename _tTypeA, typename _tTypeB, typename _tTypeOut>
+		static inline bool											BinarySizesMatch( const _tTypeA &_vA, const _tTypeB &_vB, const _tTypeOut &_vOut ) {
+			return (_vA.size() == _vOut.size() || _vA.size() == 1) && (_vB.size() == _vOut.size() || _vB.size() == 1);
+		}
+
+		/**
+		 * Determines whether a reduction operation is a sum.
+		 * 
+		 * \param _roOp The operation.
+		 * \return Returns true for sums and false for maximums and minimums.
+		 **/
+		static constexpr bool										ReduceIsSum( NN9_REDUCE_OP _roOp ) { return _roOp == NN9_RO_SUM || _roOp == NN9_RO_SUM_SQ || _roOp == NN9_RO_SUM_ABS; }
+
+		/**
+		 * Marks the axes of a reduction.
+		 * 
+		 * \param _sRank The number of dimensions.
+		 * \param _vAxes The axes over which to reduce.
+		 * \throw Throws if an axis is out of range or repeated.
+		 * \return Returns a flag for each dimension, true if it is reduced.
+		 **/
+		static std::vector<bool>									ReduceAxes( size_t _sRank, const std::vector<size_t> &_vAxes ) {
+			std::vector<bool> vRet( _sRank );
+			for ( auto I = _vAxes.size(); I--; ) {
+				if ( _vAxes[I] >= _sRank || vRet[_vAxes[I]] ) { throw std::invalid_argument( "Math::ReduceAxes: Axes must be unique and less than the number of dimensions." ); }
+				vRet[_vAxes[I]] = true;
+			}
+			return vRet;
+		}
+
+		/**
+		 * Gets the layout of a reduction.  Dimensions of 1 are dropped, kept dimensions are matched to the output, the rest are sorted by
+		 *	decreasing input stride (expanded dimensions first), and neighbors that walk memory as 1 are collapsed.
+		 * 
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vIn The input view.
+		 * \param _vAxes The axes over which to reduce.
+		 * \param _vOut The output view.
+		 * \param _vDims Holds the returned dimensions.
+		 * \param _sCount Holds the returned number of inputs reduced into each output.
+		 * \throw Throws if an axis is out of range or repeated or the output does not have the reduced shape.
+		 * \return Returns false if there are no outputs.
+		 **/
+		template <typename _tTypeIn, typename _tTypeOut>
+		static bool													ReduceLayout( const _tTypeIn &_vIn, const std::vector<size_t> &_vAxes, const _tTypeOut &_vOut,
+			std::vector<NN9_REDUCE_DIM> &_vDims, size_t &_sCount ) {
+			std::vector<size_t> vShape, vStrides, vShapeOut, vStridesOut;
+			BroadcastLayout( _vIn, vShape, vStrides );
+			BroadcastLayout( _vOut, vShapeOut, vStridesOut );
+			const std::vector<bool> vReduced = ReduceAxes( vShape.size(), _vAxes );
+
+			std::vector<NN9_REDUCE_DIM> vDims;
+			bool bEmpty = false;
+			size_t sOut = 0;
+			_sCount = 1;
+			for ( size_t I = 0; I < vShape.size(); ++I ) {
+				if ( vReduced[I] ) {
+					_sCount *= vShape[I];
+					if ( vShape[I] != 1 ) { vDims.push_back( { vShape[I], vStrides[I], 0, true } ); }
+					continue;
+				}
+				if ( vShape[I] == 1 ) { continue; }
+				while ( sOut < vShapeOut.size() && vShapeOut[sOut] == 1 ) { ++sOut; }
+				if ( sOut == vShapeOut.size() || vShapeOut[sOut] != vShape[I] ) {
+					throw std::invalid_argument( "Math::ReduceLayout: The output must have the shape of the input without the reduced axes." );
+				}
+				bEmpty = bEmpty || !vShape[I];
+				vDims.push_back( { vShape[I], vStrides[I], vStridesOut[sOut++], false } );
+			}
+			while ( sOut < vShapeOut.size() && vShapeOut[sOut] == 1 ) { ++sOut; }
+			if ( sOut != vShapeOut.size() ) { throw std::invalid_argument( "Math::ReduceLayout: The output must have the shape of the input without the reduced axes." ); }
+			if ( bEmpty ) { return false; }
+
+			std::stable_sort( vDims.begin(), vDims.end(), []( const NN9_REDUCE_DIM &_rdA, const NN9_REDUCE_DIM &_rdB ) {
+				return (_rdA.sStrideIn ? _rdA.sStrideIn : SIZE_MAX) > (_rdB.sStrideIn ? _rdB.sStrideIn : SIZE_MAX);
+			} );
+			_vDims.clear();
+			for ( const auto & rdDim : vDims ) {
+				if ( _vDims.size() ) {
+					NN9_REDUCE_DIM & rdOuter = _vDims.back();
+					if ( rdOuter.bReduced == rdDim.bReduced && rdOuter.sStrideIn == rdDim.sStrideIn * rdDim.sSize &&
+						(rdDim.bReduced || rdOuter.sStrideOut == rdDim.sStrideOut * rdDim.sSize) ) {
+						rdOuter.sSize *= rdDim.sSize;
+						rdOuter.sStrideIn = rdDim.sStrideIn;
+						rdOuter.sStrideOut = rdDim.sStrideOut;
+						continue;
+					}
+				}
+				_vDims.push_back( rdDim );
+			}
+			return true;
+		}
+
+		/**
+		 * Walks a range of the row-major elements of a layout, handing each run along the innermost dimension to a function.
+		 * 
+		 * \tparam _tFunc The function type, called with the offset of the run, its length, and its stride, all in elements.
+		 * \param _vShape The shape to walk.  If empty, a single element at offset 0 is walked.
+		 * \param _vStrides The strides of the shape, in elements.
+		 * \param _sStart The row-major index of the first element to walk.
+		 * \param _sTotal The number of elements to walk.
+		 * \param _fFunc The function to call.
+		 **/
+		template <typename _tFunc>
+		static void													ReduceWalk( const std::vector<size_t> &_vShape, const std::vector<size_t> &_vStrides, size_t _sStart, size_t _sTotal, const _tFunc &_fFunc ) {
+			if ( !_sTotal ) { return; }
+			if ( _vShape.empty() ) {
+				_fFunc( size_t( 0 ), _sTotal, size_t( 1 ) );
+				return;
+			}
+			const size_t sRank = _vShape.size() - 1;
+			const size_t sRun = _vShape[sRank];
+			const size_t sStride = _vStrides[sRank];
+			std::vector<size_t> vIdx( sRank );
+			size_t sInner = _sStart % sRun, sOuter = _sStart / sRun;
+			size_t sOffset = sInner * sStride;
+			for ( size_t I = sRank; I--; ) {
+				vIdx[I] = sOuter % _vShape[I];
+				sOuter /= _vShape[I];
+				sOffset += vIdx[I] * _vStrides[I];
+			}
+			while ( true ) {
+				const size_t sThis = std::min( sRun - sInner, _sTotal );
+				_fFunc( sOffset, sThis, sStride );
+				_sTotal -= sThis;
+				if ( !_sTotal ) { return; }
+				sOffset -= sInner * sStride;
+				sInner = 0;
+				for ( size_t I = sRank; I--; ) {
+					sOffset += _vStrides[I];
+					if ( ++vIdx[I] < _vShape[I] ) { break; }
+					sOffset -= _vStrides[I] * _vShape[I];
+					vIdx[I] = 0;
+				}
+			}
+		}
+
+		/**
+		 * Gets the input and output offsets of an output of a reduction.
+		 * 
+		 * \param _vShape The shape of the outputs.
+		 * \param _vStridesIn The input strides of the outputs.
+		 * \param _vStridesOut The output strides of the outputs.
+		 * \param _sIdx The row-major index of the output.
+		 * \param _sOffIn Holds the returned input offset.
+		 * \param _sOffOut Holds the returned output offset.
+		 **/
+		static inline void											ReduceOffsets( const std::vector<size_t> &_vShape, const std::vector<size_t> &_vStridesIn, const std::vector<size_t> &_vStridesOut,
+			size_t _sIdx, size_t &_sOffIn, size_t &_sOffOut ) {
+			_sOffIn = _sOffOut = 0;
+			for ( size_t I = _vShape.size(); I--; ) {
+				const size_t sThis = _sIdx % _vShape[I];
+				_sIdx /= _vShape[I];
+				_sOffIn += sThis * _vStridesIn[I];
+				_sOffOut += sThis * _vStridesOut[I];
+			}
+		}
+
+		/**
+		 * Gets the identity of a maximum or minimum.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tAcc The accumulator type.
+		 * \return Returns the value that never wins against any other.
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tAcc>
+		static constexpr _tAcc										ReduceIdentity() {
+			if constexpr ( _roOp == NN9_RO_MAX_ABS ) { return _tAcc( 0 ); }
+			else if constexpr ( _roOp == NN9_RO_MIN ) {
+				if constexpr ( std::numeric_limits<_tAcc>::has_infinity ) { return std::numeric_limits<_tAcc>::infinity(); }
+				else { return std::numeric_limits<_tAcc>::max(); }
+			}
+			else {
+				if constexpr ( std::numeric_limits<_tAcc>::has_infinity ) { return -std::numeric_limits<_tAcc>::infinity(); }
+				else { return std::numeric_limits<_tAcc>::lowest(); }
+			}
+		}
+
+		/**
+		 * Creates the initial state of a reduction.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tAcc The accumulator type.
+		 * \return Returns the initial state.
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tAcc>
+		static inline NN9_REDUCE_STATE<_tAcc>						ReduceInit() {
+			NN9_REDUCE_STATE<_tAcc> rsRet;
+			if constexpr ( !ReduceIsSum( _roOp ) ) { rsRet.aExt = ReduceIdentity<_roOp, _tAcc>(); }
+			return rsRet;
+		}
+
+		/**
+		 * Gets the term that a value adds to a sum: the value, its square, or its absolute value.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tR The register traits.
+		 * \param _rVal The value.
+		 * \return Returns the term.
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tR>
+		static inline typename _tR::Reg								ReduceTerm( typename _tR::Reg _rVal ) {
+			if constexpr ( _roOp == NN9_RO_SUM_SQ ) { return _tR::Mul( _rVal, _rVal ); }
+			else if constexpr ( _roOp == NN9_RO_SUM_ABS || _roOp == NN9_RO_MAX_ABS ) { return _tR::Abs( _rVal ); }
+			else { return _rVal; }
+		}
+
+		/**
+		 * Combines 2 partial results of an uncompensated reduction.  Maximums and minimums keep NaN.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tR The register traits.
+		 * \param _rA The left partial result.
+		 * \param _rB The right partial result.
+		 * \return Returns the combined result.
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tR>
+		static inline typename _tR::Reg								ReduceCombine( typename _tR::Reg _rA, typename _tR::Reg _rB ) {
+			if constexpr ( ReduceIsSum( _roOp ) ) { return _tR::Add( _rA, _rB ); }
+			else if constexpr ( _roOp == NN9_RO_MIN ) { return _tR::Min( _rA, _rB ); }
+			else { return _tR::Max( _rA, _rB ); }
+		}
+
+		/**
+		 * Folds a value into an accumulator.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tR The register traits.
+		 * \param _rAcc The accumulator.
+		 * \param _rVal The value.
+		 * \return Returns the updated accumulator.
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tR>
+		static inline typename _tR::Reg								ReduceStep( typename _tR::Reg _rAcc, typename _tR::Reg _rVal ) {
+			return ReduceCombine<_roOp, _tR>( _rAcc, ReduceTerm<_roOp, _tR>( _rVal ) );
+		}
+
+		/**
+		 * Folds a value into a Kahan sum.  The true sum is _rSum - _rComp.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tR The register traits.
+		 * \param _rSum The running sum.
+		 * \param _rComp The running compensation.
+		 * \param _rVal The value.
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tR>
+		static inline void											ReduceKahan( typename _tR::Reg &_rSum, typename _tR::Reg &_rComp, typename _tR::Reg _rVal ) {
+			const typename _tR::Reg rY = _tR::Sub( ReduceTerm<_roOp, _tR>( _rVal ), _rComp );
+			const typename _tR::Reg rT = _tR::Add( _rSum, rY );
+			_rComp = _tR::Sub( _tR::Sub( rT, _rSum ), rY );
+			_rSum = rT;
+		}
+
+		/**
+		 * Adds a value to a Neumaier sum.  The true sum is _tSum + _tComp.
+		 * 
+		 * \tparam _tAcc The accumulator type.
+		 * \param _tSum The running sum.
+		 * \param _tComp The running compensation.
+		 * \param _tVal The value to add.
+		 **/
+		template <typename _tAcc>
+		static inline void											ReduceNeumaier( _tAcc &_tSum, _tAcc &_tComp, _tAcc _tVal ) {
+			const _tAcc tT = _tSum + _tVal;
+			if ( std::abs( _tSum ) >= std::abs( _tVal ) ) { _tComp += (_tSum - tT) + _tVal; }
+			else { _tComp += (_tVal - tT) + _tSum; }
+			_tSum = tT;
+		}
+
+		/**
+		 * Folds the lanes of a register pairwise.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tR The register traits.
+		 * \param _rVal The register to fold.
+		 * \return Returns the folded lanes.
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tR>
+		static inline typename _tR::Acc								ReduceHorizontal( typename _tR::Reg _rVal ) {
+			using Scalar = NN9_REDUCE_SCALAR<typename _tR::Acc>;
+			NN9_ALIGN( 64 )
+			typename _tR::Acc aLanes[_tR::Lanes];
+			_tR::Store( aLanes, _rVal );
+			for ( size_t sWidth = _tR::Lanes / 2; sWidth; sWidth /= 2 ) {
+				for ( size_t I = 0; I < sWidth; ++I ) { aLanes[I] = ReduceCombine<_roOp, Scalar>( aLanes[I], aLanes[I+sWidth] ); }
+			}
+			return aLanes[0];
+		}
+
+		/**
+		 * Folds a pairwise leaf into the cascade of a reduction state.  Equal-sized partial sums are added as soon as they exist, so the
+		 *	error grows with the log of the number of leaves.
+		 * 
+		 * \tparam _tAcc The accumulator type.
+		 * \param _rsState The state.
+		 * \param _tLeaf The leaf to add.
+		 **/
+		template <typename _tAcc>
+		static inline void											ReducePushLeaf( NN9_REDUCE_STATE<_tAcc> &_rsState, _tAcc _tLeaf ) {
+			size_t I = 0;
+			for ( uint64_t ui64Count = _rsState.ui64Leaves; ui64Count & 1; ui64Count >>= 1, ++I ) { _tLeaf = _rsState.aLevels[I] + _tLeaf; }
+			_rsState.aLevels[I] = _tLeaf;
+			++_rsState.ui64Leaves;
+		}
+
+		/**
+		 * Gets the result of a reduction state.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tAcc The accumulator type.
+		 * \param _rsState The state.
+		 * \param _rmMode The summation mode.
+		 * \return Returns the result.
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tAcc>
+		static inline _tAcc											ReduceTotal( const NN9_REDUCE_STATE<_tAcc> &_rsState, NN9_REDUCE_MODE _rmMode ) {
+			if constexpr ( !ReduceIsSum( _roOp ) ) { return _rsState.aExt; }
+			else {
+				if ( _rmMode == NN9_RM_KAHAN ) { return _rsState.aSum + _rsState.aComp; }
+				_tAcc tRet = _rsState.aLeaf;
+				for ( size_t I = 0; (_rsState.ui64Leaves >> I) != 0; ++I ) {
+					if ( (_rsState.ui64Leaves >> I) & 1 ) { tRet = _rsState.aLevels[I] + tRet; }
+				}
+				return tRet;
+			}
+		}
+
+		/**
+		 * Combines the states of 2 reductions over neighboring ranges.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tAcc The accumulator type.
+		 * \param _rsA The state of the left range.
+		 * \param _rsB The state of the right range.
+		 * \param _rmMode The summation mode.
+		 * \return Returns the combined state.
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tAcc>
+		static NN9_REDUCE_STATE<_tAcc>								ReduceMerge( const NN9_REDUCE_STATE<_tAcc> &_rsA, const NN9_REDUCE_STATE<_tAcc> &_rsB, NN9_REDUCE_MODE _rmMode ) {
+			NN9_REDUCE_STATE<_tAcc> rsRet = ReduceInit<_roOp, _tAcc>();
+			if constexpr ( !ReduceIsSum( _roOp ) ) { rsRet.aExt = ReduceCombine<_roOp, NN9_REDUCE_SCALAR<_tAcc>>( _rsA.aExt, _rsB.aExt ); }
+			else if ( _rmMode == NN9_RM_KAHAN ) {
+				rsRet.aSum = _rsA.aSum;
+				rsRet.aComp = _rsA.aComp + _rsB.aComp;
+				ReduceNeumaier( rsRet.aSum, rsRet.aComp, _rsB.aSum );
+			}
+			else { rsRet.aLeaf = ReduceTotal<_roOp>( _rsA, _rmMode ) + ReduceTotal<_roOp>( _rsB, _rmMode ); }
+			return rsRet;
+		}
+
+		/**
+		 * Sums a block of contiguous values into 1 leaf with 4 independent accumulator registers.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tR The register traits.
+		 * \tparam _tType The value type.
+		 * \param _ptSrc The values.
+		 * \param _sTotal The number of values.
+		 * \return Returns the sum.
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tR, typename _tType>
+		static inline typename _tR::Acc								ReduceBlock( const _tType * _ptSrc, size_t _sTotal ) {
+			using Acc = typename _tR::Acc;
+			using Reg = typename _tR::Reg;
+			using Scalar = NN9_REDUCE_SCALAR<Acc>;
+			constexpr size_t sLanes = _tR::Lanes;
+			if constexpr ( _tR::FromTable ) { return _tR::template Fold<_roOp>()( _ptSrc, _sTotal, Acc( 0 ) ); }
+			else {
+				size_t I = 0;
+				Acc aRet = Acc( 0 );
+				if ( _sTotal >= sLanes ) {
+					Reg rA0 = _tR::Set1( Acc( 0 ) ), rA1 = rA0, rA2 = rA0, rA3 = rA0;
+					for ( ; I + sLanes * 4 <= _sTotal; I += sLanes * 4 ) {
+						rA0 = ReduceStep<_roOp, _tR>( rA0, _tR::Load( _ptSrc + I ) );
+						rA1 = ReduceStep<_roOp, _tR>( rA1, _tR::Load( _ptSrc + I + sLanes ) );
+						rA2 = ReduceStep<_roOp, _tR>( rA2, _tR::Load( _ptSrc + I + sLanes * 2 ) );
+						rA3 = ReduceStep<_roOp, _tR>( rA3, _tR::Load( _ptSrc + I + sLanes * 3 ) );
+					}
+					for ( ; I + sLanes <= _sTotal; I += sLanes ) { rA0 = ReduceStep<_roOp, _tR>( rA0, _tR::Load( _ptSrc + I ) ); }
+					aRet = ReduceHorizontal<_roOp, _tR>( _tR::Add( _tR::Add( rA0, rA1 ), _tR::Add( rA2, rA3 ) ) );
+				}
+				for ( ; I < _sTotal; ++I ) { aRet = ReduceStep<_roOp, Scalar>( aRet, Scalar::Load( _ptSrc + I ) ); }
+				return aRet;
+			}
+		}
+
+		/**
+		 * Folds a run of contiguous values into a reduction state.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tR The register traits.
+		 * \tparam _tType The value type.
+		 * \param _ptSrc The values.
+		 * \param _sTotal The number of values.
+		 * \param _rmMode The summation mode.
+		 * \param _rsState The state to update.
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tR, typename _tType>
+		static void													ReduceRun( const _tType * _ptSrc, size_t _sTotal, NN9_REDUCE_MODE _rmMode, NN9_REDUCE_STATE<typename _tR::Acc> &_rsState ) {
+			using Acc = typename _tR::Acc;
+			using Reg = typename _tR::Reg;
+			using Scalar = NN9_REDUCE_SCALAR<Acc>;
+			constexpr size_t sLanes = _tR::Lanes;
+			size_t I = 0;
+			if constexpr ( _tR::FromTable && !std::is_same<_tType, Acc>::value ) {
+				// Widened a leaf at a time, so pairwise leaves end where they do for the values themselves.
+				NN9_ALIGN( 64 )
+				Acc aBlock[NN9_R_LEAF];
+				for ( ; I < _sTotal; I += NN9_R_LEAF ) {
+					const size_t sBlock = std::min<size_t>( _sTotal - I, NN9_R_LEAF );
+					_tR::template ToAcc<_tType>()( _ptSrc + I, aBlock, sBlock );
+					ReduceRun<_roOp, _tR>( aBlock, sBlock, _rmMode, _rsState );
+				}
+			}
+			else if constexpr ( !ReduceIsSum( _roOp ) && _tR::FromTable ) { _rsState.aExt = _tR::template Fold<_roOp>()( _ptSrc, _sTotal, _rsState.aExt ); }
+			else if constexpr ( !ReduceIsSum( _roOp ) ) {
+				Acc aExt = _rsState.aExt;
+				if ( _sTotal >= sLanes ) {
+					Reg rA0 = _tR::Set1( aExt ), rA1 = rA0, rA2 = rA0, rA3 = rA0;
+					for ( ; I + sLanes * 4 <= _sTotal; I += sLanes * 4 ) {
+						rA0 = ReduceStep<_roOp, _tR>( rA0, _tR::Load( _ptSrc + I ) );
+						rA1 = ReduceStep<_roOp, _tR>( rA1, _tR::Load( _ptSrc + I + sLanes ) );
+						rA2 = ReduceStep<_roOp, _tR>( rA2, _tR::Load( _ptSrc + I + sLanes * 2 ) );
+						rA3 = ReduceStep<_roOp, _tR>( rA3, _tR::Load( _ptSrc + I + sLanes * 3 ) );
+					}
+					for ( ; I + sLanes <= _sTotal; I += sLanes ) { rA0 = ReduceStep<_roOp, _tR>( rA0, _tR::Load( _ptSrc + I ) ); }
+					rA0 = ReduceCombine<_roOp, _tR>( ReduceCombine<_roOp, _tR>( rA0, rA1 ), ReduceCombine<_roOp, _tR>( rA2, rA3 ) );
+					aExt = ReduceHorizontal<_roOp, _tR>( rA0 );
+				}
+				for ( ; I < _sTotal; ++I ) { aExt = ReduceStep<_roOp, Scalar>( aExt, Scalar::Load( _ptSrc + I ) ); }
+				_rsState.aExt = aExt;
+			}
+			else if ( _rmMode == NN9_RM_KAHAN ) {
+				if constexpr ( _tR::FromTable ) { _tR::template Kahan<_roOp>()( _ptSrc, _sTotal, &_rsState.aSum, &_rsState.aComp ); }
+				else {
+					if ( _sTotal >= sLanes * 2 ) {
+						Reg rS0 = _tR::Set1( Acc( 0 ) ), rC0 = rS0, rS1 = rS0, rC1 = rS0;
+						for ( ; I + sLanes * 2 <= _sTotal; I += sLanes * 2 ) {
+							ReduceKahan<_roOp, _tR>( rS0, rC0, _tR::Load( _ptSrc + I ) );
+							ReduceKahan<_roOp, _tR>( rS1, rC1, _tR::Load( _ptSrc + I + sLanes ) );
+						}
+						NN9_ALIGN( 64 )
+						Acc aSums[sLanes*2];
+						NN9_ALIGN( 64 )
+						Acc aComps[sLanes*2];
+						_tR::Store( aSums, rS0 );
+						_tR::Store( aSums + sLanes, rS1 );
+						_tR::Store( aComps, rC0 );
+						_tR::Store( aComps + sLanes, rC1 );
+						for ( size_t J = 0; J < sLanes * 2; ++J ) {
+							ReduceNeumaier( _rsState.aSum, _rsState.aComp, aSums[J] );
+							ReduceNeumaier( _rsState.aSum, _rsState.aComp, -aComps[J] );
+						}
+					}
+					for ( ; I < _sTotal; ++I ) { ReduceNeumaier( _rsState.aSum, _rsState.aComp, ReduceTerm<_roOp, Scalar>( Scalar::Load( _ptSrc + I ) ) ); }
+				}
+			}
+			else {
+				for ( ; I < _sTotal; I += NN9_R_LEAF ) {
+					const size_t sBlock = std::min<size_t>( _sTotal - I, NN9_R_LEAF );
+					_rsState.aLeaf += ReduceBlock<_roOp, _tR>( _ptSrc + I, sBlock );
+					_rsState.sLeaf += sBlock;
+					if ( _rsState.sLeaf >= NN9_R_LEAF ) {
+						ReducePushLeaf( _rsState, _rsState.aLeaf );
+						_rsState.aLeaf = Acc( 0 );
+						_rsState.sLeaf = 0;
+					}
+				}
+			}
+		}
+
+		/**
+		 * Folds a run of values with any stride into a reduction state.  Strided runs are gathered into contiguous blocks first.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tR The register traits.
+		 * \tparam _tType The value type.
+		 * \param _ptSrc The values.
+		 * \param _sTotal The number of values.
+		 * \param _sStride The stride between values, in elements.
+		 * \param _rmMode The summation mode.
+		 * \param _rsState The state to update.
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tR, typename _tType>
+		static void													ReduceStrided( const _tType * _ptSrc, size_t _sTotal, size_t _sStride, NN9_REDUCE_MODE _rmMode, NN9_REDUCE_STATE<typename _tR::Acc> &_rsState ) {
+			if ( _sStride == 1 ) {
+				ReduceRun<_roOp, _tR>( _ptSrc, _sTotal, _rmMode, _rsState );
+				return;
+			}
+			constexpr size_t sBlockSize = StridedView<_tType>::NN9_SV_BLOCK;
+			NN9_ALIGN( 64 )
+			_tType tBlock[sBlockSize];
+			for ( size_t I = 0; I < _sTotal; I += sBlockSize ) {
+				const size_t sBlock = std::min<size_t>( _sTotal - I, sBlockSize );
+				const _tType * ptRun = _ptSrc + I * _sStride;
+				for ( size_t J = 0; J < sBlock; ++J ) { tBlock[J] = ptRun[J*_sStride]; }
+				ReduceRun<_roOp, _tR>( tBlock, sBlock, _rmMode, _rsState );
+			}
+		}
+
+		/**
+		 * Folds a span of 1 row into column accumulators.  The length of the span must be a multiple of the register width.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tR The register traits.
+		 * \tparam _tType The value type.
+		 * \param _ptSrc The row.
+		 * \param _sBegin The first column of the span.
+		 * \param _sEnd The end of the span.
+		 * \param _paAcc The column accumulators.
+		 * \param _paComp The column compensations, used if _bKahan.
+		 * \param _bFirst If true, the row initializes the accumulators.
+		 * \param _bKahan If true, sums are compensated.
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tR, typename _tType>
+		static inline void											ReduceRowSpan( const _tType * _ptSrc, size_t _sBegin, size_t _sEnd, typename _tR::Acc * _paAcc, typename _tR::Acc * _paComp,
+			bool _bFirst, bool _bKahan ) {
+			using Acc = typename _tR::Acc;
+			using Reg = typename _tR::Reg;
+			if constexpr ( _tR::FromTable && !std::is_same<_tType, Acc>::value ) {
+				NN9_ALIGN( 64 )
+				Acc aRow[NN9_R_COLS];
+				for ( size_t I = _sBegin; I < _sEnd; I += NN9_R_COLS ) {
+					const size_t sBlock = std::min<size_t>( _sEnd - I, NN9_R_COLS );
+					_tR::template ToAcc<_tType>()( _ptSrc + I, aRow, sBlock );
+					ReduceRowSpan<_roOp, _tR>( aRow, 0, sBlock, _paAcc + I, _bKahan ? _paComp + I : _paComp, _bFirst, _bKahan );
+				}
+			}
+			else if constexpr ( _tR::FromTable ) {
+				if ( _bFirst ) {
+					_tR::template Terms<_roOp>( _ptSrc + _sBegin, _paAcc + _sBegin, _sEnd - _sBegin );
+					if ( _bKahan ) { std::fill( _paComp + _sBegin, _paComp + _sEnd, Acc( 0 ) ); }
+				}
+				else if ( _bKahan ) { _tR::template KahanRow<_roOp>()( _ptSrc + _sBegin, _paAcc + _sBegin, _paComp + _sBegin, _sEnd - _sBegin ); }
+				else { _tR::template FoldRow<_roOp>()( _ptSrc + _sBegin, _paAcc + _sBegin, _sEnd - _sBegin ); }
+			}
+			else if ( _bFirst ) {
+				const Reg rZero = _tR::Set1( Acc( 0 ) );
+				for ( size_t I = _sBegin; I < _sEnd; I += _tR::Lanes ) {
+					_tR::Store( _paAcc + I, ReduceTerm<_roOp, _tR>( _tR::Load( _ptSrc + I ) ) );
+					if ( _bKahan ) { _tR::Store( _paComp + I, rZero ); }
+				}
+			}
+			else if ( _bKahan ) {
+				for ( size_t I = _sBegin; I < _sEnd; I += _tR::Lanes ) {
+					Reg rSum = _tR::Load( _paAcc + I ), rComp = _tR::Load( _paComp + I );
+					ReduceKahan<_roOp, _tR>( rSum, rComp, _tR::Load( _ptSrc + I ) );
+					_tR::Store( _paAcc + I, rSum );
+					_tR::Store( _paComp + I, rComp );
+				}
+			}
+			else {
+				for ( size_t I = _sBegin; I < _sEnd; I += _tR::Lanes ) {
+					_tR::Store( _paAcc + I, ReduceStep<_roOp, _tR>( _tR::Load( _paAcc + I ), _tR::Load( _ptSrc + I ) ) );
+				}
+			}
+		}
+
+		/**
+		 * Folds a stack of rows into column accumulators.  The rows are walked in order and each is added across SIMD columns, so reducing an
+		 *	outer axis streams memory contiguously.  Pairwise sums collect NN9_R_LEAF_ROWS rows per leaf and add leaves in a cascade.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tR The register traits.
+		 * \tparam _tType The value type.
+		 * \param _ptBase The first column of the first row.
+		 * \param _sCols The number of columns, at most NN9_R_COLS.
+		 * \param _sColStride The stride between columns, in elements.
+		 * \param _vShape The shape of the rows.
+		 * \param _vStrides The strides of the rows, in elements.
+		 * \param _sStart The index of the first row to fold.
+		 * \param _sRows The number of rows to fold, at least 1.
+		 * \param _rmMode The summation mode.
+		 * \param _paTotal Holds the returned column results.
+		 * \param _paComp Holds the returned column compensations for Kahan sums.  The true sums are _paTotal[I] + _paComp[I].
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tR, typename _tType>
+		static void													ReduceColumns( const _tType * _ptBase, size_t _sCols, size_t _sColStride,
+			const std::vector<size_t> &_vShape, const std::vector<size_t> &_vStrides, size_t _sStart, size_t _sRows,
+			NN9_REDUCE_MODE _rmMode, typename _tR::Acc * _paTotal, typename _tR::Acc * _paComp ) {
+			using Acc = typename _tR::Acc;
+			const bool bPairwise = ReduceIsSum( _roOp ) && _rmMode == NN9_RM_PAIRWISE;
+			const bool bKahan = ReduceIsSum( _roOp ) && _rmMode == NN9_RM_KAHAN;
+			const size_t sVec = _sCols - _sCols % _tR::Lanes;
+			std::vector<_tType> vGather( _sColStride != 1 ? _sCols : 0 );
+			std::vector<Acc> vLeaf, vLevels;
+			uint64_t ui64Leaves = 0;
+			size_t sLeafRows = 0;
+			Acc * paAcc = _paTotal;
+			if ( bPairwise ) {
+				vLeaf.resize( _sCols );
+				paAcc = vLeaf.data();
+			}
+
+			bool bFirst = true;
+			ReduceWalk( _vShape, _vStrides, _sStart, _sRows, [&]( size_t _sOffset, size_t _sRun, size_t _sStride ) {
+				for ( size_t R = 0; R < _sRun; ++R ) {
+					const _tType * ptRow = _ptBase + _sOffset + R * _sStride;
+					if ( _sColStride != 1 ) {
+						for ( size_t J = 0; J < _sCols; ++J ) { vGather[J] = ptRow[J*_sColStride]; }
+						ptRow = vGather.data();
+					}
+					ReduceRowSpan<_roOp, _tR>( ptRow, 0, sVec, paAcc, _paComp, bFirst, bKahan );
+					ReduceRowSpan<_roOp, NN9_REDUCE_SCALAR<Acc>>( ptRow, sVec, _sCols, paAcc, _paComp, bFirst, bKahan );
+					bFirst = false;
+					if ( bPairwise && ++sLeafRows == NN9_R_LEAF_ROWS ) {
+						// Push the leaf into the cascade, adding it to each equal-sized partial sum below it.
+						size_t I = 0;
+						for ( uint64_t ui64Count = ui64Leaves; ui64Count & 1; ui64Count >>= 1, ++I ) {
+							const Acc * paLevel = &vLevels[I*_sCols];
+							for ( size_t J = 0; J < _sCols; ++J ) { paAcc[J] = paLevel[J] + paAcc[J]; }
+						}
+						if ( vLevels.size() < (I + 1) * _sCols ) { vLevels.resize( (I + 1) * _sCols ); }
+						std::copy( paAcc, paAcc + _sCols, &vLevels[I*_sCols] );
+						++ui64Leaves;
+						sLeafRows = 0;
+						bFirst = true;
+					}
+				}
+			} );
+
+			if ( bPairwise ) {
+				if ( sLeafRows ) { std::copy( paAcc, paAcc + _sCols, _paTotal ); }
+				else { std::fill( _paTotal, _paTotal + _sCols, Acc( 0 ) ); }
+				for ( size_t I = 0; (ui64Leaves >> I) != 0; ++I ) {
+					if ( (ui64Leaves >> I) & 1 ) {
+						const Acc * paLevel = &vLevels[I*_sCols];
+						for ( size_t J = 0; J < _sCols; ++J ) { _paTotal[J] = paLevel[J] + _paTotal[J]; }
+					}
+				}
+			}
+			else if ( bKahan ) {
+				// Kahan compensation is subtracted; the returned compensation is added.
+				for ( size_t J = 0; J < _sCols; ++J ) { _paComp[J] = -_paComp[J]; }
+			}
+		}
+
+		/**
+		 * Sums all elements of a view into a single value.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tRet The return type.
+		 * \tparam _tType The view/container type.
+		 * \tparam _tFinal The finalizer type, called with the result and the number of elements.
+		 * \param _vIn The input view.
+		 * \param _rmMode The summation mode.
+		 * \param _fFinal The finalizer.
+		 * \return Returns the finalized result.
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tRet, typename _tType, typename _tFinal>
+		static _tRet												ReduceAll( const _tType &_vIn, NN9_REDUCE_MODE _rmMode, const _tFinal &_fFinal ) {
+			std::vector<size_t> vShape, vStrides;
+			BroadcastLayout( _vIn, vShape, vStrides );
+			std::vector<size_t> vAxes( vShape.size() );
+			for ( size_t I = 0; I < vAxes.size(); ++I ) { vAxes[I] = I; }
+			_tRet tRet = _tRet( 0 );
+			View<_tRet> vOut( &tRet, 1, nullptr );
+			ReduceApply<_roOp>( _vIn, vAxes, vOut, _rmMode, _fFinal );
+			return tRet;
+		}
+
+		/**
+		 * Selects the widest register set the CPU supports for a reduction, or the kernel table for float and double, and runs it.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \tparam _tFinal The finalizer type, called with each result and the number of elements reduced into it.
+		 * \param _vIn The input view.
+		 * \param _vAxes The axes over which to reduce.
+		 * \param _vOut The output view.
+		 * \param _rmMode The summation mode.
+		 * \param _fFinal The finalizer.
+		 * \throw Throws if an axis is out of range or repeated, the output does not have the reduced shape, or a maximum or minimum is empty.
+		 * \return Returns _vOut.
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tTypeIn, typename _tTypeOut, typename _tFinal>
+		static _tTypeOut &											ReduceApply( const _tTypeIn &_vIn, const std::vector<size_t> &_vAxes, _tTypeOut &_vOut, NN9_REDUCE_MODE _rmMode, const _tFinal &_fFinal ) {
+			using ValueType = typename _tTypeIn::value_type;
+			using Acc = ReduceAcc<_roOp, ValueType>;
+			if constexpr ( (std::is_same<Acc, float>::value && nn9::Types::SimdFloat<ValueType>()) ||
+				(std::is_same<Acc, double>::value && nn9::Types::SimdDouble<ValueType>()) ) {
+				if ( NN9_REDUCE_TABLE<Acc>::template Fold<_roOp>() ) { return ReduceKernel<_roOp, NN9_REDUCE_TABLE<Acc>>( _vIn, _vAxes, _vOut, _rmMode, _fFinal ); }
+			}
+			return ReduceKernel<_roOp, NN9_REDUCE_SCALAR<Acc>>( _vIn, _vAxes, _vOut, _rmMode, _fFinal );
+		}
+
+		/**
+		 * Runs a reduction with the given register set.  If the innermost remaining dimension is reduced, each output folds contiguous runs
+		 *	across SIMD lanes (ReduceRun()); otherwise whole rows are folded into SIMD columns (ReduceColumns()).  Work is split across
+		 *	ThreadPool::Global() by output when there are enough outputs and otherwise by input, with the partial results combined in a fixed
+		 *	order.
+		 * 
+		 * \tparam _roOp The operation.
+		 * \tparam _tR The register traits.
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \tparam _tFinal The finalizer type, called with each result and the number of elements reduced into it.
+		 * \param _vIn The input view.
+		 * \param _vAxes The axes over which to reduce.
+		 * \param _vOut The output view.
+		 * \param _rmMode The summation mode.
+		 * \param _fFinal The finalizer.
+		 * \throw Throws if an axis is out of range or repeated, the output does not have the reduced shape, or a maximum or minimum is empty.
+		 *	If NN9_SAFETY_CHECK, also throws if the output has overlapping (expanded) elements.
+		 * \return Returns _vOut.
+		 **/
+		template <NN9_REDUCE_OP _roOp, typename _tR, typename _tTypeIn, typename _tTypeOut, typename _tFinal>
+		static _tTypeOut &											ReduceKernel( const _tTypeIn &_vIn, const std::vector<size_t> &_vAxes, _tTypeOut &_vOut, NN9_REDUCE_MODE _rmMode, const _tFinal &_fFinal ) {
+			using ValueType = typename _tTypeIn::value_type;
+			using ValueTypeOut = typename _tTypeOut::value_type;
+			using Acc = typename _tR::Acc;
+#ifdef NN9_SAFETY_CHECK
+			if constexpr ( IsStridedView<std::remove_cvref_t<_tTypeOut>>::value ) {
+				if ( _vOut.Overlaps() ) { throw std::runtime_error( "Math::ReduceKernel: Cannot write to an expanded view." ); }
+			}
+#endif	// #ifdef NN9_SAFETY_CHECK
+			std::vector<NN9_REDUCE_DIM> vDims;
+			size_t sCount;
+			if ( !ReduceLayout( _vIn, _vAxes, _vOut, vDims, sCount ) ) { return _vOut; }
+			const ValueType * ptIn = BroadcastData( _vIn );
+			ValueTypeOut * ptOut = BroadcastData( _vOut );
+
+			std::vector<size_t> vShapeK, vStridesKIn, vStridesKOut, vShapeR, vStridesR;
+			if ( !sCount ) {
+				if constexpr ( !ReduceIsSum( _roOp ) ) { throw std::invalid_argument( "Math::ReduceKernel: Cannot find the maximum or minimum of an empty range." ); }
+				else {
+					const ValueTypeOut vtoEmpty = static_cast<ValueTypeOut>(_fFinal( Acc( 0 ), size_t( 0 ) ));
+					size_t sOutputs = 1;
+					for ( const auto & rdDim : vDims ) {
+						if ( !rdDim.bReduced ) {
+							vShapeK.push_back( rdDim.sSize );
+							vStridesKOut.push_back( rdDim.sStrideOut );
+							sOutputs *= rdDim.sSize;
+						}
+					}
+					ReduceWalk( vShapeK, vStridesKOut, 0, sOutputs, [&]( size_t _sOffset, size_t _sRun, size_t _sStride ) {
+						for ( size_t I = 0; I < _sRun; ++I ) { ptOut[_sOffset+I*_sStride] = vtoEmpty; }
+					} );
+					return _vOut;
+				}
+			}
+			if ( vDims.empty() ) { vDims.push_back( { 1, 1, 0, true } ); }
+
+			const NN9_REDUCE_DIM rdInner = vDims.back();
+			size_t sOutputs = 1;
+			for ( size_t I = 0; I + 1 < vDims.size(); ++I ) {
+				if ( vDims[I].bReduced ) {
+					vShapeR.push_back( vDims[I].sSize );
+					vStridesR.push_back( vDims[I].sStrideIn );
+				}
+				else {
+					vShapeK.push_back( vDims[I].sSize );
+					vStridesKIn.push_back( vDims[I].sStrideIn );
+					vStridesKOut.push_back( vDims[I].sStrideOut );
+					sOutputs *= vDims[I].sSize;
+				}
+			}
+
+			ThreadPool & tpPool = ThreadPool::Global();
+			const size_t sChunk = std::max<size_t>( NN9_P_CHUNK_BYTES / sizeof( ValueType ) / NN9_P_CHUNK_ALIGN, 1 ) * NN9_P_CHUNK_ALIGN;
+			const bool bParallel = tpPool.Size() && sCount * sOutputs * (rdInner.bReduced ? 1 : rdInner.sSize) >= ParallelThreshold();
+			const bool bKahan = ReduceIsSum( _roOp ) && _rmMode == NN9_RM_KAHAN;
+			auto fMerge = [&]( const NN9_REDUCE_STATE<Acc> &_rsA, const NN9_REDUCE_STATE<Acc> &_rsB ) { return ReduceMerge<_roOp>( _rsA, _rsB, _rmMode ); };
+
+			if ( rdInner.bReduced ) {
+				// The innermost dimension is reduced: each output folds runs along it.
+				auto fReduce = [&]( size_t _sOffIn, size_t _sStart, size_t _sTotal ) {
+					NN9_REDUCE_STATE<Acc> rsState = ReduceInit<_roOp, Acc>();
+					if ( vShapeR.size() == 1 ) {
+						ReduceStrided<_roOp, _tR>( ptIn + _sOffIn + _sStart * vStridesR[0], _sTotal, vStridesR[0], _rmMode, rsState );
+					}
+					else {
+						ReduceWalk( vShapeR, vStridesR, _sStart, _sTotal, [&]( size_t _sOffset, size_t _sRun, size_t _sStride ) {
+							ReduceStrided<_roOp, _tR>( ptIn + _sOffIn + _sOffset, _sRun, _sStride, _rmMode, rsState );
+						} );
+					}
+					return rsState;
+				};
+				auto fOutputs = [&]( size_t _sBegin, size_t _sEnd ) {
+					for ( size_t I = _sBegin; I < _sEnd; ++I ) {
+						size_t sOffIn, sOffOut;
+						ReduceOffsets( vShapeK, vStridesKIn, vStridesKOut, I, sOffIn, sOffOut );
+						ptOut[sOffOut] = static_cast<ValueTypeOut>(_fFinal( ReduceTotal<_roOp>( fReduce( sOffIn, 0, sCount ), _rmMode ), sCount ));
+					}
+				};
+				vShapeR.push_back( rdInner.sSize );
+				vStridesR.push_back( rdInner.sStrideIn );
+
+				if ( !bParallel ) { fOutputs( 0, sOutputs ); }
+				else if ( sOutputs >= tpPool.Size() * 4 ) { tpPool.ParallelFor( 0, sOutputs, std::max<size_t>( sChunk / sCount, 1 ), fOutputs ); }
+				else {
+					// Too few outputs to go around; split each one and combine the partial results.
+					for ( size_t I = 0; I < sOutputs; ++I ) {
+						size_t sOffIn, sOffOut;
+						ReduceOffsets( vShapeK, vStridesKIn, vStridesKOut, I, sOffIn, sOffOut );
+						const NN9_REDUCE_STATE<Acc> rsState = tpPool.ParallelReduce( size_t( 0 ), sCount, sChunk, ReduceInit<_roOp, Acc>(),
+							[&]( size_t _sBegin, size_t _sEnd ) { return fReduce( sOffIn, _sBegin, _sEnd - _sBegin ); }, fMerge );
+						ptOut[sOffOut] = static_cast<ValueTypeOut>(_fFinal( ReduceTotal<_roOp>( rsState, _rmMode ), sCount ));
+					}
+				}
+				return _vOut;
+			}
+
+			// The innermost dimension is kept: fold rows into blocks of up to NN9_R_COLS columns.
+			const size_t sBlocks = (rdInner.sSize + NN9_R_COLS - 1) / NN9_R_COLS;
+			auto fWrite = [&]( size_t _sOffOut, size_t _sCol, size_t _sCols, const Acc * _paTotal, const Acc * _paComp ) {
+				ValueTypeOut * ptDst = ptOut + _sOffOut + _sCol * rdInner.sStrideOut;
+				for ( size_t J = 0; J < _sCols; ++J ) {
+					ptDst[J*rdInner.sStrideOut] = static_cast<ValueTypeOut>(_fFinal( bKahan ? _paTotal[J] + _paComp[J] : _paTotal[J], sCount ));
+				}
+			};
+			auto fItems = [&]( size_t _sBegin, size_t _sEnd ) {
+				// Column results followed by column compensations.
+				std::vector<Acc> vScratch( std::min<size_t>( rdInner.sSize, NN9_R_COLS ) * 2 );
+				for ( size_t I = _sBegin; I < _sEnd; ++I ) {
+					const size_t sCol = (I % sBlocks) * NN9_R_COLS;
+					const size_t sCols = std::min<size_t>( rdInner.sSize - sCol, NN9_R_COLS );
+					size_t sOffIn, sOffOut;
+					ReduceOffsets( vShapeK, vStridesKIn, vStridesKOut, I / sBlocks, sOffIn, sOffOut );
+					ReduceColumns<_roOp, _tR>( ptIn + sOffIn + sCol * rdInner.sStrideIn, sCols, rdInner.sStrideIn, vShapeR, vStridesR, 0, sCount, _rmMode,
+						vScratch.data(), vScratch.data() + sCols );
+					fWrite( sOffOut, sCol, sCols, vScratch.data(), vScratch.data() + sCols );
+				}
+			};
+
+			const size_t sItems = sOutputs * sBlocks;
+			if ( !bParallel ) { fItems( 0, sItems ); }
+			else if ( sItems >= tpPool.Size() * 4 ) { tpPool.ParallelFor( 0, sItems, 1, fItems ); }
+			else {
+				// Too few column blocks to go around; split the rows of each one and combine the partial results.
+				for ( size_t I = 0; I < sItems; ++I ) {
+					const size_t sCol = (I % sBlocks) * NN9_R_COLS;
+					const size_t sCols = std::min<size_t>( rdInner.sSize - sCol, NN9_R_COLS );
+					size_t sOffIn, sOffOut;
+					ReduceOffsets( vShapeK, vStridesKIn, vStridesKOut, I / sBlocks, sOffIn, sOffOut );
+					// Each partial holds the column results followed by the column compensations.
+					const std::vector<Acc> vResult = tpPool.ParallelReduce( size_t( 0 ), sCount, std::max<size_t>( sChunk / sCols, 1 ), std::vector<Acc>(),
+						[&]( size_t _sBegin, size_t _sEnd ) {
+							std::vector<Acc> vRet( sCols * 2 );
+							ReduceColumns<_roOp, _tR>( ptIn + sOffIn + sCol * rdInner.sStrideIn, sCols, rdInner.sStrideIn, vShapeR, vStridesR, _sBegin, _sEnd - _sBegin,
+								_rmMode, vRet.data(), vRet.data() + sCols );
+							return vRet;
+						},
+						[&]( const std::vector<Acc> &_vA, const std::vector<Acc> &_vB ) {
+							if ( _vA.empty() ) { return _vB; }
+							if ( _vB.empty() ) { return _vA; }
+							std::vector<Acc> vRet = _vA;
+							for ( size_t J = 0; J < sCols; ++J ) {
+								if constexpr ( !ReduceIsSum( _roOp ) ) { vRet[J] = ReduceCombine<_roOp, NN9_REDUCE_SCALAR<Acc>>( _vA[J], _vB[J] ); }
+								else if ( bKahan ) {
+									vRet[sCols+J] += _vB[sCols+J];
+									ReduceNeumaier( vRet[J], vRet[sCols+J], _vB[J] );
+								}
+								else { vRet[J] = _vA[J] + _vB[J]; }
+							}
+							return vRet;
+						} );
+					fWrite( sOffOut, sCol, sCols, vResult.data(), vResult.data() + sCols );
+				}
+			}
+			return _vOut;
+		}
+
+		/**
+		 * Finds the first extreme value in a run and folds it into a running extreme.  A NaN beats everything, so nothing is searched once the
+		 *	running extreme is NaN.
+		 * 
+		 * \tparam _bMax If true, the maximum is found; otherwise the minimum.
+		 * \tparam _tType The value type.
+		 * \tparam _tAcc The comparison type.
+		 * \param _ptSrc The values.
+		 * \param _sTotal The number of values.
+		 * \param _sStride The stride between values, in elements.
+		 * \param _sBase The index of the first value.
+		 * \param _tBest The running extreme.
+		 * \param _sBest The index of the running extreme, or SIZE_MAX if there is none yet.
+		 **/
+		template <bool _bMax, typename _tType, typename _tAcc>
+		static void													ArgRun( const _tType * _ptSrc, size_t _sTotal, size_t _sStride, size_t _sBase, _tAcc &_tBest, size_t &_sBest ) {
+			if ( _sBest != SIZE_MAX && _tBest != _tBest ) { return; }
+			size_t I = 0;
+			if constexpr ( nn9::Types::SimdFloat<_tType>() ) {
+				const auto pfArg = Kernels::Table().pfArgF32[_bMax ? Kernels::NN9_KR_MAX : Kernels::NN9_KR_MIN];
+				if ( pfArg && _sStride == 1 ) {
+					// float16 and bfloat16 are widened a block at a time; float is searched at most INT32_MAX values at a time.
+					NN9_ALIGN( 64 )
+					float fBlock[nn9::Types::Is32BitFloat<_tType>() ? 1 : NN9_R_LEAF];
+					while ( I < _sTotal ) {
+						size_t sBlock;
+						const float * pfBlock;
+						if constexpr ( nn9::Types::Is32BitFloat<_tType>() ) {
+							sBlock = std::min<size_t>( _sTotal - I, size_t( INT32_MAX ) );
+							pfBlock = _ptSrc + I;
+						}
+						else {
+							sBlock = std::min<size_t>( _sTotal - I, NN9_R_LEAF );
+							Kernels::Table().pfToF32[KernelType<_tType>()]( _ptSrc + I, fBlock, sBlock );
+							pfBlock = fBlock;
+						}
+						const size_t sIdx = pfArg( pfBlock, sBlock );
+						const float fVal = pfBlock[sIdx];
+						if ( _sBest == SIZE_MAX || fVal != fVal || (_bMax ? fVal > _tBest : fVal < _tBest) ) {
+							_tBest = static_cast<_tAcc>(fVal);
+							_sBest = _sBase + I + sIdx;
+							if ( fVal != fVal ) { return; }
+						}
+						I += sBlock;
+					}
+					return;
+				}
+			}
+			for ( ; I < _sTotal; ++I ) {
+				const _tAcc tVal = static_cast<_tAcc>(_ptSrc[I*_sStride]);
+				if ( _sBest == SIZE_MAX || tVal != tVal || (_bMax ? tVal > _tBest : tVal < _tBest) ) {
+					_tBest = tVal;
+					_sBest = _sBase + I;
+					if ( tVal != tVal ) { return; }
+				}
+			}
+		}
+
+		/**
+		 * Finds the flat index of the first extreme value in a view.
+		 * 
+		 * \tparam _bMax If true, the maximum is found; otherwise the minimum.
+		 * \tparam _tType The view/container type.
+		 * \param _vIn The input view.
+		 * \throw Throws if the view is empty.
+		 * \return Returns the index of the extreme.
+		 **/
+		template <bool _bMax, typename _tType>
+		static size_t												ArgExtreme( const _tType &_vIn ) {
+			using ValueType = typename _tType::value_type;
+			using Acc = ReduceAcc<_bMax ? NN9_RO_MAX : NN9_RO_MIN, ValueType>;
+			if ( !_vIn.size() ) { throw std::invalid_argument( "Math::ArgExtreme: Cannot find the index of the maximum or minimum of an empty range." ); }
+			Acc aBest = Acc( 0 );
+			size_t sBest = SIZE_MAX, sBase = 0;
+			if constexpr ( IsStridedView<std::remove_cvref_t<_tType>>::value ) {
+				_vIn.ForEachRun( [&]( const ValueType * _ptRun, size_t _sTotal, size_t _sStride ) {
+					ArgRun<_bMax>( _ptRun, _sTotal, _sStride, sBase, aBest, sBest );
+					sBase += _sTotal;
+				} );
+			}
+			else { ArgRun<_bMax>( &_vIn[0], _vIn.size(), 1, 0, aBest, sBest ); }
+			return sBest;
+		}
+
+		/**
+		 * Finds the first extreme value down each column of a stack of contiguous rows.  Rows are walked in order and compared across SIMD
+		 *	columns, so searching an outer axis streams memory contiguously.
+		 * 
+		 * \tparam _bMax If true, maximums are found; otherwise minimums.
+		 * \tparam _tType The value type.
+		 * \param _ptBase The first column of the first row.
+		 * \param _sCols The number of columns, at most NN9_R_COLS.
+		 * \param _sRows The number of rows, at most UINT32_MAX.
+		 * \param _sRowStride The stride between rows, in elements.
+		 * \param _pui32Idx Holds the returned row index of each column's extreme.
+		 **/
+		template <bool _bMax, typename _tType>
+		static void													ArgColumns( const _tType * _ptBase, size_t _sCols, size_t _sRows, size_t _sRowStride, uint32_t * _pui32Idx ) {
+			using Acc = ReduceAcc<_bMax ? NN9_RO_MAX : NN9_RO_MIN, _tType>;
+			std::vector<Acc> vBest( _sCols );
+			Acc * paBest = vBest.data();
+			for ( size_t J = 0; J < _sCols; ++J ) {
+				paBest[J] = static_cast<Acc>(_ptBase[J]);
+				_pui32Idx[J] = 0;
+			}
+			const auto pfArgRow = Kernels::Table().pfArgRowF32[_bMax ? Kernels::NN9_KR_MAX : Kernels::NN9_KR_MIN];
+			std::vector<float> vRow( nn9::Types::SimdFloat<_tType>() && !nn9::Types::Is32BitFloat<_tType>() && pfArgRow ? _sCols : 0 );
+			for ( size_t R = 1; R < _sRows; ++R ) {
+				const _tType * ptRow = _ptBase + R * _sRowStride;
+				if constexpr ( nn9::Types::SimdFloat<_tType>() ) {
+					if ( pfArgRow ) {
+						const float * pfRow = vRow.data();
+						if constexpr ( nn9::Types::Is32BitFloat<_tType>() ) { pfRow = ptRow; }
+						else { Kernels::Table().pfToF32[KernelType<_tType>()]( ptRow, vRow.data(), _sCols ); }
+						pfArgRow( pfRow, paBest, _pui32Idx, uint32_t( R ), _sCols );
+						continue;
+					}
+				}
+				for ( size_t J = 0; J < _sCols; ++J ) {
+					const Acc aVal = static_cast<Acc>(ptRow[J]);
+					if ( paBest[J] == paBest[J] && (aVal != aVal || (_bMax ? aVal > paBest[J] : aVal < paBest[J])) ) {
+						paBest[J] = aVal;
+						_pui32Idx[J] = uint32_t( R );
+					}
+				}
+			}
+		}
+
+		/**
+		 * Finds the indices of the first extreme values along an axis.
+		 * 
+		 * \tparam _bMax If true, maximums are found; otherwise minimums.
+		 * \tparam _tTypeIn The input view/container type.
+		 * \tparam _tTypeOut The output view/container type.
+		 * \param _vIn The input view.
+		 * \param _sAxis The axis along which to search.
+		 * \param _vOut The output view.
+		 * \throw Throws if the axis is out of range or empty or the output does not have the reduced shape.  If NN9_SAFETY_CHECK, also throws
+		 *	if the output has overlapping (expanded) elements.
+		 * \return Returns _vOut.
+		 **/
+		template <bool _bMax, typename _tTypeIn, typename _tTypeOut>
+		static _tTypeOut &											ArgExtreme( const _tTypeIn &_vIn, size_t _sAxis, _tTypeOut &_vOut ) {
+			using ValueType = typename _tTypeIn::value_type;
+			using ValueTypeOut = typename _tTypeOut::value_type;
+			using Acc = ReduceAcc<_bMax ? NN9_RO_MAX : NN9_RO_MIN, ValueType>;
+#ifdef NN9_SAFETY_CHECK
+			if constexpr ( IsStridedView<std::remove_cvref_t<_tTypeOut>>::value ) {
+				if ( _vOut.Overlaps() ) { throw std::runtime_error( "Math::ArgExtreme: Cannot write to an expanded view." ); }
+			}
+#endif	// #ifdef NN9_SAFETY_CHECK
+			std::vector<NN9_REDUCE_DIM> vDims;
+			size_t sCount;
+			if ( !ReduceLayout( _vIn, { _sAxis }, _vOut, vDims, sCount ) ) { return _vOut; }
+			if ( !sCount ) { throw std::invalid_argument( "Math::ArgExtreme: Cannot find the index of the maximum or minimum of an empty range." ); }
+			const ValueType * ptIn = BroadcastData( _vIn );
+			ValueTypeOut * ptOut = BroadcastData( _vOut );
+
+			// The axis collapses into at most 1 dimension.
+			size_t sAxisStride = 0;
+			std::vector<size_t> vShapeK, vStridesKIn, vStridesKOut;
+			for ( const auto & rdDim : vDims ) {
+				if ( rdDim.bReduced ) { sAxisStride = rdDim.sStrideIn; }
+				else {
+					vShapeK.push_back( rdDim.sSize );
+					vStridesKIn.push_back( rdDim.sStrideIn );
+					vStridesKOut.push_back( rdDim.sStrideOut );
+				}
+			}
+
+			ThreadPool & tpPool = ThreadPool::Global();
+			const bool bColumns = vShapeK.size() && vStridesKIn.back() == 1 && sAxisStride != 1 && sCount <= size_t( UINT32_MAX );
+			if ( bColumns ) {
+				// The innermost kept dimension is contiguous: compare whole rows down the axis.
+				const size_t sInner = vShapeK.back(), sInnerOut = vStridesKOut.back();
+				vShapeK.pop_back();
+				vStridesKIn.pop_back();
+				vStridesKOut.pop_back();
+				const size_t sBlocks = (sInner + NN9_R_COLS - 1) / NN9_R_COLS;
+				size_t sItems = sBlocks;
+				for ( auto I = vShapeK.size(); I--; ) { sItems *= vShapeK[I]; }
+				auto fItems = [&]( size_t _sBegin, size_t _sEnd ) {
+					std::vector<uint32_t> vIdx( std::min<size_t>( sInner, NN9_R_COLS ) );
+					for ( size_t I = _sBegin; I < _sEnd; ++I ) {
+						const size_t sCol = (I % sBlocks) * NN9_R_COLS;
+						const size_t sCols = std::min<size_t>( sInner - sCol, NN9_R_COLS );
+						size_t sOffIn, sOffOut;
+						ReduceOffsets( vShapeK, vStridesKIn, vStridesKOut, I / sBlocks, sOffIn, sOffOut );
+						ArgColumns<_bMax>( ptIn + sOffIn + sCol, sCols, sCount, sAxisStride, vIdx.data() );
+						for ( size_t J = 0; J < sCols; ++J ) { ptOut[sOffOut+(sCol+J)*sInnerOut] = static_cast<ValueTypeOut>(vIdx[J]); }
+					}
+				};
+				if ( tpPool.Size() && sItems > 1 && sItems * sCount * NN9_R_COLS >= ParallelThreshold() ) { tpPool.ParallelFor( 0, sItems, 1, fItems ); }
+				else { fItems( 0, sItems ); }
+				return _vOut;
+			}
+
+			size_t sOutputs = 1;
+			for ( auto I = vShapeK.size(); I--; ) { sOutputs *= vShapeK[I]; }
+			auto fOutputs = [&]( size_t _sBegin, size_t _sEnd ) {
+				for ( size_t I = _sBegin; I < _sEnd; ++I ) {
+					size_t sOffIn, sOffOut;
+					ReduceOffsets( vShapeK, vStridesKIn, vStridesKOut, I, sOffIn, sOffOut );
+					Acc aBest = Acc( 0 );
+					size_t sBest = SIZE_MAX;
+					ArgRun<_bMax>( ptIn + sOffIn, sCount, sAxisStride, 0, aBest, sBest );
+					ptOut[sOffOut] = static_cast<ValueTypeOut>(sBest);
+				}
+			};
+			if ( tpPool.Size() && sOutputs > 1 && sOutputs * sCount >= ParallelThreshold() ) {
+				const size_t sChunk = std::max<size_t>( NN9_P_CHUNK_BYTES / sizeof( ValueType ), 1 );
+				tpPool.ParallelFor( 0, sOutputs, std::max<size_t>( sChunk / sCount, 1 ), fOutputs );
+			}
+			else { fOutputs( 0, sOutputs ); }
+			return _vOut;
+		}
 	};
 
 }	// namespace nn9
@@ -0,0 +1,571 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Fused optimizer steps (SGD with momentum, Adam, and AdamW).  Each parameter, its gradient, and its optimizer state are read
+ *	once and written once per step, with the kernel table's SIMD steps (see Kernels), and every tensor in a parameter group is updated by 1 parallel launch.
+ */
+
+#pragma once
+
+#include "../Foundation/NN9Kernels.h"
+#include "../Tensor/NN9StridedView.h"
+#include "../Tensor/NN9Tensor.h"
+#include "../Types/NN9BFloat16.h"
+#include "../Types/NN9Types.h"
+#include "../Utilities/NN9ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+
+namespace nn9 {
+
+	/**
+	 * Class Optimizer
+	 * \brief Fused optimizer steps.
+	 *
+	 * Description: Fused optimizer steps.  Written with Math::Mul() and Math::Add(), an Adam step makes 6 to 10 passes over every weight;
+	 *	here each element of the parameter, gradient, and state is loaded once, updated in registers, and stored once.  A parameter group is
+	 *	treated as 1 flat range of elements spanning all of its tensors, so that many small tensors (biases, norms) share threads with the large
+	 *	ones in a single ThreadPool launch instead of 1 launch each.
+	 *
+	 * float and double parameters are updated in their own precision.  bfloat16_t parameters are their own master weights: they are widened
+	 *	to float, updated against float state, and narrowed with stochastic rounding, so that updates smaller than half a bfloat16 ulp still move
+	 *	the weight by the right amount on average instead of being rounded away.  The random bits come from a hash of the seed, the tensor's
+	 *	index in the group, and the element's index, so results do not depend on the number of threads.
+	 */
+	class Optimizer {
+	public :
+		// == Enumerations.
+		/** Tuning constants. */
+		enum NN9_OPTIMIZER : size_t {
+			NN9_O_PARALLEL_GRAIN				= 16384,								/**< The fewest elements given to each thread. */
+		};
+
+
+		// == Types.
+		/** SGD hyperparameters. */
+		struct NN9_SGD_PARAMS {
+			NN9_SGD_PARAMS( double _dLr = 0.01, double _dMomentum = 0.0, double _dDampening = 0.0, double _dWeightDecay = 0.0, bool _bNesterov = false ) :
+				dLr( _dLr ),
+				dMomentum( _dMomentum ),
+				dDampening( _dDampening ),
+				dWeightDecay( _dWeightDecay ),
+				bNesterov( _bNesterov ) {
+			}
+
+
+			// == Members.
+			double								dLr;									/**< The learning rate. */
+			double								dMomentum;								/**< The momentum.  If 0, no momentum buffer is used. */
+			double								dDampening;								/**< The dampening applied to the gradient added to the momentum buffer. */
+			double								dWeightDecay;							/**< The L2 penalty added to the gradient. */
+			bool								bNesterov;								/**< If true, Nesterov momentum is used. */
+		};
+
+		/** Adam and AdamW hyperparameters. */
+		struct NN9_ADAM_PARAMS {
+			NN9_ADAM_PARAMS( double _dLr = 0.001, double _dBeta1 = 0.9, double _dBeta2 = 0.999, double _dEps = 1.0e-8, double _dWeightDecay = 0.0, bool _bDecoupled = false ) :
+				dLr( _dLr ),
+				dBeta1( _dBeta1 ),
+				dBeta2( _dBeta2 ),
+				dEps( _dEps ),
+				dWeightDecay( _dWeightDecay ),
+				bDecoupled( _bDecoupled ) {
+			}
+
+
+			// == Members.
+			double								dLr;									/**< The learning rate. */
+			double								dBeta1;									/**< The decay of the first moment. */
+			double								dBeta2;									/**< The decay of the second moment. */
+			double								dEps;									/**< Added to the square root of the second moment. */
+			double								dWeightDecay;							/**< The weight decay. */
+			bool								bDecoupled;								/**< If true, the weight decay is applied to the weight directly (AdamW) instead of added to the gradient. */
+		};
+
+		/** A parameter and its gradient and state.  Every tensor must be contiguous and have the parameter's shape. */
+		struct NN9_PARAM {
+			NN9_PARAM( Tensor * _ptParam = nullptr, Tensor * _ptGrad = nullptr, Tensor * _ptState0 = nullptr, Tensor * _ptState1 = nullptr ) :
+				ptParam( _ptParam ),
+				ptGrad( _ptGrad ),
+				ptState0( _ptState0 ),
+				ptState1( _ptState1 ) {
+			}
+
+
+			// == Members.
+			Tensor *							ptParam;								/**< The parameter: NN9_T_FLOAT, NN9_T_DOUBLE, or NN9_T_BFLOAT16. */
+			Tensor *							ptGrad;									/**< The gradient, of the parameter's type. */
+			Tensor *							ptState0;								/**< The SGD momentum buffer or the Adam first moment: NN9_T_DOUBLE for double parameters, otherwise NN9_T_FLOAT.  Start it at 0. */
+			Tensor *							ptState1;								/**< The Adam second moment, of the same type as ptState0.  Start it at 0. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Applies 1 SGD step to every parameter in a group.  Each element is updated as:
+		 *	g = grad + weight_decay * p
+		 *	buf = momentum * buf + (1 - dampening) * g
+		 *	g = nesterov ? g + momentum * buf : buf
+		 *	p -= lr * g
+		 * The momentum buffer (ptState0) is required only when the momentum is not 0.
+		 *
+		 * \param _vParams The parameter group.
+		 * \param _spParms The hyperparameters.
+		 * \param _ui64Seed The seed for the stochastic rounding of bfloat16_t parameters.  Pass a different value each step.
+		 * \throw Throws if a tensor is missing or has the wrong type or shape, or if a tensor is not contiguous.
+		 **/
+		static void													Sgd( const std::vector<NN9_PARAM> &_vParams, const NN9_SGD_PARAMS &_spParms, uint64_t _ui64Seed = 0 ) {
+			Group( "Optimizer::Sgd", _vParams, _spParms.dMomentum != 0.0, false, [&]( auto _tTag, const auto &_vSegs ) {
+				using Type = decltype( _tTag );
+				using Scalar = typename std::conditional<std::is_same<Type, double>::value, double, float>::type;
+				NN9_SGD_CONSTS<Scalar> scConsts;
+				scConsts.sLr = Scalar( _spParms.dLr );
+				scConsts.sMomentum = Scalar( _spParms.dMomentum );
+				scConsts.sDampening = Scalar( 1.0 - _spParms.dDampening );
+				scConsts.sWeightDecay = Scalar( _spParms.dWeightDecay );
+				scConsts.bNesterov = _spParms.bNesterov;
+				Launch( _vSegs, _ui64Seed, [&]( size_t _sTotal, Type * _ptParam, const Type * _ptGrad, Scalar * _psState0, Scalar *, uint32_t _ui32Key, uint32_t _ui32Idx ) {
+					SgdStep( _sTotal, _ptParam, _ptGrad, _psState0, scConsts, _ui32Key, _ui32Idx );
+				} );
+			} );
+		}
+
+		/**
+		 * Applies 1 SGD step to a parameter.
+		 *
+		 * \param _tParam The parameter.
+		 * \param _tGrad The gradient.
+		 * \param _ptMomentum The momentum buffer, or nullptr if the momentum is 0.
+		 * \param _spParms The hyperparameters.
+		 * \param _ui64Seed The seed for the stochastic rounding of bfloat16_t parameters.
+		 * \throw Throws if a tensor is missing or has the wrong type or shape, or if a tensor is not contiguous.
+		 **/
+		static void													Sgd( Tensor &_tParam, Tensor &_tGrad, Tensor * _ptMomentum, const NN9_SGD_PARAMS &_spParms, uint64_t _ui64Seed = 0 ) {
+			Sgd( std::vector<NN9_PARAM>{ NN9_PARAM( &_tParam, &_tGrad, _ptMomentum ) }, _spParms, _ui64Seed );
+		}
+
+		/**
+		 * Applies 1 Adam (or, if bDecoupled is set, AdamW) step to every parameter in a group.  Each element is updated as:
+		 *	g = grad + weight_decay * p						(Adam)
+		 *	p *= 1 - lr * weight_decay						(AdamW)
+		 *	m = beta1 * m + (1 - beta1) * g
+		 *	v = beta2 * v + (1 - beta2) * g * g
+		 *	p -= lr / (1 - beta1^t) * m / (sqrt( v / (1 - beta2^t) ) + eps)
+		 *
+		 * \param _vParams The parameter group.  ptState0 and ptState1 are required.
+		 * \param _apParms The hyperparameters.
+		 * \param _ui64Step The 1-based step number t, used for bias correction.
+		 * \param _ui64Seed The seed for the stochastic rounding of bfloat16_t parameters.  Pass a different value each step.
+		 * \throw Throws if a tensor is missing or has the wrong type or shape, if a tensor is not contiguous, or if _ui64Step is 0.
+		 **/
+		static void													Adam( const std::vector<NN9_PARAM> &_vParams, const NN9_ADAM_PARAMS &_apParms, uint64_t _ui64Step, uint64_t _ui64Seed = 0 ) {
+			if ( !_ui64Step ) { throw std::invalid_argument( "Optimizer::Adam: Steps start at 1." ); }
+			Group( "Optimizer::Adam", _vParams, true, true, [&]( auto _tTag, const auto &_vSegs ) {
+				using Type = decltype( _tTag );
+				using Scalar = typename std::conditional<std::is_same<Type, double>::value, double, float>::type;
+				const double dBias1 = 1.0 - std::pow( _apParms.dBeta1, double( _ui64Step ) );
+				const double dBias2 = 1.0 - std::pow( _apParms.dBeta2, double( _ui64Step ) );
+				NN9_ADAM_CONSTS<Scalar> acConsts;
+				acConsts.sBeta1 = Scalar( _apParms.dBeta1 );
+				acConsts.sOneMinusBeta1 = Scalar( 1.0 - _apParms.dBeta1 );
+				acConsts.sBeta2 = Scalar( _apParms.dBeta2 );
+				acConsts.sOneMinusBeta2 = Scalar( 1.0 - _apParms.dBeta2 );
+				acConsts.sStepSize = Scalar( _apParms.dLr / dBias1 );
+				acConsts.sInvSqrtBias2 = Scalar( 1.0 / std::sqrt( dBias2 ) );
+				acConsts.sEps = Scalar( _apParms.dEps );
+				acConsts.sL2 = Scalar( _apParms.bDecoupled ? 0.0 : _apParms.dWeightDecay );
+				acConsts.sDecay = Scalar( _apParms.bDecoupled ? 1.0 - _apParms.dLr * _apParms.dWeightDecay : 1.0 );
+				Launch( _vSegs, _ui64Seed, [&]( size_t _sTotal, Type * _ptParam, const Type * _ptGrad, Scalar * _psState0, Scalar * _psState1, uint32_t _ui32Key, uint32_t _ui32Idx ) {
+					AdamStep( _sTotal, _ptParam, _ptGrad, _psState0, _psState1, acConsts, _ui32Key, _ui32Idx );
+				} );
+			} );
+		}
+
+		/**
+		 * Applies 1 Adam (or, if bDecoupled is set, AdamW) step to a parameter.
+		 *
+		 * \param _tParam The parameter.
+		 * \param _tGrad The gradient.
+		 * \param _tM The first moment.
+		 * \param _tV The second moment.
+		 * \param _apParms The hyperparameters.
+		 * \param _ui64Step The 1-based step number.
+		 * \param _ui64Seed The seed for the stochastic rounding of bfloat16_t parameters.
+		 * \throw Throws if a tensor has the wrong type or shape, if a tensor is not contiguous, or if _ui64Step is 0.
+		 **/
+		static void													Adam( Tensor &_tParam, Tensor &_tGrad, Tensor &_tM, Tensor &_tV, const NN9_ADAM_PARAMS &_apParms, uint64_t _ui64Step, uint64_t _ui64Seed = 0 ) {
+			Adam( std::vector<NN9_PARAM>{ NN9_PARAM( &_tParam, &_tGrad, &_tM, &_tV ) }, _apParms, _ui64Step, _ui64Seed );
+		}
+
+		/**
+		 * Applies 1 AdamW step to every parameter in a group.  This is Adam() with bDecoupled set.
+		 *
+		 * \param _vParams The parameter group.  ptState0 and ptState1 are required.
+		 * \param _apParms The hyperparameters.  bDecoupled is ignored.
+		 * \param _ui64Step The 1-based step number.
+		 * \param _ui64Seed The seed for the stochastic rounding of bfloat16_t parameters.
+		 * \throw Throws if a tensor is missing or has the wrong type or shape, if a tensor is not contiguous, or if _ui64Step is 0.
+		 **/
+		static void													AdamW( const std::vector<NN9_PARAM> &_vParams, const NN9_ADAM_PARAMS &_apParms, uint64_t _ui64Step, uint64_t _ui64Seed = 0 ) {
+			NN9_ADAM_PARAMS apParms = _apParms;
+			apParms.bDecoupled = true;
+			Adam( _vParams, apParms, _ui64Step, _ui64Seed );
+		}
+
+		/**
+		 * Rounds a float to bfloat16_t stochastically: the result is the bfloat16_t above or below the value with probability proportional to
+		 *	its nearness, so the expected result is the value itself.  The random bits are a hash of _ui32Key and _ui32Idx; the SIMD kernels round
+		 *	element _ui32Idx exactly the same way.
+		 *
+		 * \param _fVal The value to round.
+		 * \param _ui32Key The key for the random bits.
+		 * \param _ui32Idx The element index for the random bits.
+		 * \return Returns the rounded value.
+		 **/
+		static inline bfloat16_t									StochasticRound( float _fVal, uint32_t _ui32Key, uint32_t _ui32Idx ) {
+			uint32_t ui32Bits;
+			std::memcpy( &ui32Bits, &_fVal, sizeof( ui32Bits ) );
+			// Keep NaN payloads out of the low bits so that the carry cannot turn them into infinity.
+			if ( _fVal != _fVal ) { ui32Bits |= 0x00400000; }
+			ui32Bits += Hash( _ui32Idx * 0x9E3779B9U + _ui32Key ) >> 16;
+			return bfloat16_t::FromBits( static_cast<uint16_t>(ui32Bits >> 16) );
+		}
+
+
+	protected :
+		// == Types.
+		/** SGD constants in the compute precision. */
+		template <typename _tScalar>
+		using NN9_SGD_CONSTS = Kernels::NN9_SGD_CONSTS<_tScalar>;
+
+		/** Adam constants in the compute precision, with the bias corrections folded in. */
+		template <typename _tScalar>
+		using NN9_ADAM_CONSTS = Kernels::NN9_ADAM_CONSTS<_tScalar>;
+
+		/** A contiguous run of elements of 1 parameter. */
+		template <typename _tType, typename _tScalar>
+		struct NN9_SEGMENT {
+			_tType *							ptParam;								/**< The parameter. */
+			const _tType *						ptGrad;									/**< The gradient. */
+			_tScalar *							psState0;								/**< The first state, or nullptr. */
+			_tScalar *							psState1;								/**< The second state, or nullptr. */
+			size_t								sTotal;									/**< The number of elements. */
+			uint32_t							ui32Index;								/**< The tensor's index in the group, for the stochastic-rounding key. */
+		};
+
+		/** Scalar registers for SgdKernel() and AdamKernel(), which run when the kernel table has no SIMD step. */
+		template <typename _tScalar>
+		struct NN9_ISA_SCALAR {
+			typedef _tScalar								Scalar;
+			typedef _tScalar								Reg;
+			static constexpr size_t							Lanes = 1;
+
+			template <typename _tType>
+			static inline Reg								Load( const _tType * _ptSrc ) { return static_cast<Scalar>(*_ptSrc); }
+			static inline void								Store( Scalar * _psDst, Reg _rVal ) { (*_psDst) = _rVal; }
+			static inline void								StoreSr( bfloat16_t * _pbDst, Reg _rVal, uint32_t _ui32Key, uint32_t _ui32Idx ) { (*_pbDst) = StochasticRound( float( _rVal ), _ui32Key, _ui32Idx ); }
+			static inline Reg								Set1( Scalar _sVal ) { return _sVal; }
+			static inline Reg								Add( Reg _rA, Reg _rB ) { return _rA + _rB; }
+			static inline Reg								Sub( Reg _rA, Reg _rB ) { return _rA - _rB; }
+			static inline Reg								Mul( Reg _rA, Reg _rB ) { return _rA * _rB; }
+			static inline Reg								Div( Reg _rA, Reg _rB ) { return _rA / _rB; }
+			static inline Reg								Sqrt( Reg _rA ) { return std::sqrt( _rA ); }
+		};
+
+
+		// == Functions.
+		/**
+		 * Mixes the bits of a 32-bit value (the MurmurHash3 finalizer).
+		 *
+		 * \param _ui32Val The value to mix.
+		 * \return Returns the mixed value.
+		 **/
+		static inline uint32_t										Hash( uint32_t _ui32Val ) {
+			_ui32Val ^= _ui32Val >> 16;
+			_ui32Val *= 0x85EBCA6BU;
+			_ui32Val ^= _ui32Val >> 13;
+			_ui32Val *= 0xC2B2AE35U;
+			_ui32Val ^= _ui32Val >> 16;
+			return _ui32Val;
+		}
+
+		/**
+		 * Stores an updated parameter, rounding stochastically if it is bfloat16_t.
+		 *
+		 * \tparam _tIsa The register traits.
+		 * \tparam _tType The parameter type.
+		 * \param _ptDst The destination.
+		 * \param _rVal The value to store.
+		 * \param _ui32Key The stochastic-rounding key.
+		 * \param _ui32Idx The index of the first element.
+		 **/
+		template <typename _tIsa, typename _tType>
+		static inline void											StoreParam( _tType * _ptDst, typename _tIsa::Reg _rVal, uint32_t _ui32Key, uint32_t _ui32Idx ) {
+			if constexpr ( Types::IsBFloat16<_tType>() ) { _tIsa::StoreSr( _ptDst, _rVal, _ui32Key, _ui32Idx ); }
+			else { _tIsa::Store( _ptDst, _rVal ); }
+		}
+
+		/**
+		 * Applies an SGD step to a run of elements on the calling thread with portable code.  The elements left over after the last full
+		 *	register are done with scalars.
+		 *
+		 * \tparam _tIsa The register traits.
+		 * \tparam _tType The parameter type.
+		 * \param _sTotal The number of elements.
+		 * \param _ptParam The parameters.
+		 * \param _ptGrad The gradients.
+		 * \param _psMom The momentum buffer, or nullptr if the momentum is 0.
+		 * \param _scConsts The constants.
+		 * \param _ui32Key The stochastic-rounding key.
+		 * \param _ui32Idx The index of the first element within its tensor.
+		 **/
+		template <typename _tIsa, typename _tType>
+		static void													SgdKernel( size_t _sTotal, _tType * _ptParam, const _tType * _ptGrad, typename _tIsa::Scalar * _psMom,
+			const NN9_SGD_CONSTS<typename _tIsa::Scalar> &_scConsts, uint32_t _ui32Key, uint32_t _ui32Idx ) {
+			using Reg = typename _tIsa::Reg;
+			const Reg rLr = _tIsa::Set1( _scConsts.sLr );
+			const Reg rMom = _tIsa::Set1( _scConsts.sMomentum );
+			const Reg rDamp = _tIsa::Set1( _scConsts.sDampening );
+			const Reg rWd = _tIsa::Set1( _scConsts.sWeightDecay );
+			const bool bWd = _scConsts.sWeightDecay != 0;
+			size_t I = 0;
+			for ( ; I + _tIsa::Lanes <= _sTotal; I += _tIsa::Lanes ) {
+				Reg rP = _tIsa::Load( _ptParam + I );
+				Reg rG = _tIsa::Load( _ptGrad + I );
+				if ( bWd ) { rG = _tIsa::Add( rG, _tIsa::Mul( rWd, rP ) ); }
+				if ( _psMom ) {
+					const Reg rB = _tIsa::Add( _tIsa::Mul( rMom, _tIsa::Load( _psMom + I ) ), _tIsa::Mul( rDamp, rG ) );
+					_tIsa::Store( _psMom + I, rB );
+					rG = _scConsts.bNesterov ? _tIsa::Add( rG, _tIsa::Mul( rMom, rB ) ) : rB;
+				}
+				StoreParam<_tIsa>( _ptParam + I, _tIsa::Sub( rP, _tIsa::Mul( rLr, rG ) ), _ui32Key, _ui32Idx + uint32_t( I ) );
+			}
+			if constexpr ( _tIsa::Lanes > 1 ) {
+				if ( I < _sTotal ) {
+					SgdKernel<NN9_ISA_SCALAR<typename _tIsa::Scalar>>( _sTotal - I, _ptParam + I, _ptGrad + I, _psMom ? _psMom + I : nullptr, _scConsts,
+						_ui32Key, _ui32Idx + uint32_t( I ) );
+				}
+			}
+		}
+
+		/**
+		 * Applies an Adam step to a run of elements on the calling thread with portable code.  The elements left over after the last full
+		 *	register are done with scalars.
+		 *
+		 * \tparam _tIsa The register traits.
+		 * \tparam _tType The parameter type.
+		 * \param _sTotal The number of elements.
+		 * \param _ptParam The parameters.
+		 * \param _ptGrad The gradients.
+		 * \param _psM The first moments.
+		 * \param _psV The second moments.
+		 * \param _acConsts The constants.
+		 * \param _ui32Key The stochastic-rounding key.
+		 * \param _ui32Idx The index of the first element within its tensor.
+		 **/
+		template <typename _tIsa, typename _tType>
+		static void													AdamKernel( size_t _sTotal, _tType * _ptParam, const _tType * _ptGrad, typename _tIsa::Scalar * _psM, typename _tIsa::Scalar * _psV,
+			const NN9_ADAM_CONSTS<typename _tIsa::Scalar> &_acConsts, uint32_t _ui32Key, uint32_t _ui32Idx ) {
+			using Reg = typename _tIsa::Reg;
+			const Reg rBeta1 = _tIsa::Set1( _acConsts.sBeta1 );
+			const Reg rOneMinusBeta1 = _tIsa::Set1( _acConsts.sOneMinusBeta1 );
+			const Reg rBeta2 = _tIsa::Set1( _acConsts.sBeta2 );
+			const Reg rOneMinusBeta2 = _tIsa::Set1( _acConsts.sOneMinusBeta2 );
+			const Reg rStepSize = _tIsa::Set1( _acConsts.sStepSize );
+			const Reg rInvSqrtBias2 = _tIsa::Set1( _acConsts.sInvSqrtBias2 );
+			const Reg rEps = _tIsa::Set1( _acConsts.sEps );
+			const Reg rL2 = _tIsa::Set1( _acConsts.sL2 );
+			const Reg rDecay = _tIsa::Set1( _acConsts.sDecay );
+			const bool bL2 = _acConsts.sL2 != 0;
+			const bool bDecay = _acConsts.sDecay != 1;
+			size_t I = 0;
+			for ( ; I + _tIsa::Lanes <= _sTotal; I += _tIsa::Lanes ) {
+				Reg rP = _tIsa::Load( _ptParam + I );
+				Reg rG = _tIsa::Load( _ptGrad + I );
+				if ( bL2 ) { rG = _tIsa::Add( rG, _tIsa::Mul( rL2, rP ) ); }
+				if ( bDecay ) { rP = _tIsa::Mul( rP, rDecay ); }
+				const Reg rM = _tIsa::Add( _tIsa::Mul( rBeta1, _tIsa::Load( _psM + I ) ), _tIsa::Mul( rOneMinusBeta1, rG ) );
+				const Reg rV = _tIsa::Add( _tIsa::Mul( rBeta2, _tIsa::Load( _psV + I ) ), _tIsa::Mul( rOneMinusBeta2, _tIsa::Mul( rG, rG ) ) );
+				_tIsa::Store( _psM + I, rM );
+				_tIsa::Store( _psV + I, rV );
+				const Reg rDenom = _tIsa::Add( _tIsa::Mul( _tIsa::Sqrt( rV ), rInvSqrtBias2 ), rEps );
+				StoreParam<_tIsa>( _ptParam + I, _tIsa::Sub( rP, _tIsa::Div( _tIsa::Mul( rStepSize, rM ), rDenom ) ), _ui32Key, _ui32Idx + uint32_t( I ) );
+			}
+			if constexpr ( _tIsa::Lanes > 1 ) {
+				if ( I < _sTotal ) {
+					AdamKernel<NN9_ISA_SCALAR<typename _tIsa::Scalar>>( _sTotal - I, _ptParam + I, _ptGrad + I, _psM + I, _psV + I, _acConsts,
+						_ui32Key, _ui32Idx + uint32_t( I ) );
+				}
+			}
+		}
+
+		/**
+		 * Applies an SGD step to a run of elements on the calling thread, through the kernel table's step when it has one.
+		 *
+		 * \tparam _tType The parameter type.
+		 * \tparam _tScalar The compute type.
+		 * \param _sTotal The number of elements.
+		 * \param _ptParam The parameters.
+		 * \param _ptGrad The gradients.
+		 * \param _psMom The momentum buffer, or nullptr if the momentum is 0.
+		 * \param _scConsts The constants.
+		 * \param _ui32Key The stochastic-rounding key.
+		 * \param _ui32Idx The index of the first element within its tensor.
+		 **/
+		template <typename _tType, typename _tScalar>
+		static void													SgdStep( size_t _sTotal, _tType * _ptParam, const _tType * _ptGrad, _tScalar * _psMom,
+			const NN9_SGD_CONSTS<_tScalar> &_scConsts, uint32_t _ui32Key, uint32_t _ui32Idx ) {
+			const Kernels::NN9_TABLE & tTable = Kernels::Table();
+			if constexpr ( std::is_same<_tType, double>::value ) {
+				if ( tTable.pfSgdF64 ) { return tTable.pfSgdF64( _sTotal, _ptParam, _ptGrad, _psMom, _scConsts, _ui32Key, _ui32Idx ); }
+			}
+			else if constexpr ( Types::IsBFloat16<_tType>() ) {
+				if ( tTable.pfSgdBf16 ) {
+					return tTable.pfSgdBf16( _sTotal, reinterpret_cast<uint16_t *>(_ptParam), reinterpret_cast<const uint16_t *>(_ptGrad), _psMom, _scConsts,
+						_ui32Key, _ui32Idx );
+				}
+			}
+			else {
+				if ( tTable.pfSgdF32 ) { return tTable.pfSgdF32( _sTotal, _ptParam, _ptGrad, _psMom, _scConsts, _ui32Key, _ui32Idx ); }
+			}
+			SgdKernel<NN9_ISA_SCALAR<_tScalar>>( _sTotal, _ptParam, _ptGrad, _psMom, _scConsts, _ui32Key, _ui32Idx );
+		}
+
+		/**
+		 * Applies an Adam step to a run of elements on the calling thread, through the kernel table's step when it has one.
+		 *
+		 * \tparam _tType The parameter type.
+		 * \tparam _tScalar The compute type.
+		 * \param _sTotal The number of elements.
+		 * \param _ptParam The parameters.
+		 * \param _ptGrad The gradients.
+		 * \param _psM The first moments.
+		 * \param _psV The second moments.
+		 * \param _acConsts The constants.
+		 * \param _ui32Key The stochastic-rounding key.
+		 * \param _ui32Idx The index of the first element within its tensor.
+		 **/
+		template <typename _tType, typename _tScalar>
+		static void													AdamStep( size_t _sTotal, _tType * _ptParam, const _tType * _ptGrad, _tScalar * _psM, _tScalar * _psV,
+			const NN9_ADAM_CONSTS<_tScalar> &_acConsts, uint32_t _ui32Key, uint32_t _ui32Idx ) {
+			const Kernels::NN9_TABLE & tTable = Kernels::Table();
+			if constexpr ( std::is_same<_tType, double>::value ) {
+				if ( tTable.pfAdamF64 ) { return tTable.pfAdamF64( _sTotal, _ptParam, _ptGrad, _psM, _psV, _acConsts, _ui32Key, _ui32Idx ); }
+			}
+			else if constexpr ( Types::IsBFloat16<_tType>() ) {
+				if ( tTable.pfAdamBf16 ) {
+					return tTable.pfAdamBf16( _sTotal, reinterpret_cast<uint16_t *>(_ptParam), reinterpret_cast<const uint16_t *>(_ptGrad), _psM, _psV, _acConsts,
+						_ui32Key, _ui32Idx );
+				}
+			}
+			else {
+				if ( tTable.pfAdamF32 ) { return tTable.pfAdamF32( _sTotal, _ptParam, _ptGrad, _psM, _psV, _acConsts, _ui32Key, _ui32Idx ); }
+			}
+			AdamKernel<NN9_ISA_SCALAR<_tScalar>>( _sTotal, _ptParam, _ptGrad, _psM, _psV, _acConsts, _ui32Key, _ui32Idx );
+		}
+
+		/**
+		 * Checks a parameter group, splits it by parameter type, and calls _fFunc once per type that is present with a value of that type (used
+		 *	only for its type) and the group's segments of that type.
+		 *
+		 * \tparam _tFunc The function type.
+		 * \param _pcName The name of the calling function, for exceptions.
+		 * \param _vParams The parameter group.
+		 * \param _bState0 If true, ptState0 is required.  Otherwise it is ignored.
+		 * \param _bState1 If true, ptState1 is required.  Otherwise it is ignored.
+		 * \param _fFunc The function to call.
+		 * \throw Throws if a tensor is missing or has the wrong type or shape, or if a tensor is not contiguous.
+		 **/
+		template <typename _tFunc>
+		static void													Group( const char * _pcName, const std::vector<NN9_PARAM> &_vParams, bool _bState0, bool _bState1, const _tFunc &_fFunc ) {
+			auto aFail = [&]( const char * _pcMsg ) { throw std::invalid_argument( std::string( _pcName ) + ": " + _pcMsg ); };
+			auto aCheck = [&]( const Tensor * _ptTensor, const Tensor &_tParam, NN9_TYPE _tType ) {
+				if ( !_ptTensor ) { aFail( "A required tensor is missing." ); }
+				if ( _ptTensor->Type() != _tType ) { aFail( "A gradient must have its parameter's type, and state must be float (double for double parameters)." ); }
+				if ( _ptTensor->Shape() != _tParam.Shape() ) { aFail( "Every tensor must have its parameter's shape." ); }
+				if ( !_ptTensor->IsContiguous() ) { aFail( "Every tensor must be contiguous." ); }
+			};
+			std::vector<NN9_SEGMENT<float, float>> vFloat;
+			std::vector<NN9_SEGMENT<double, double>> vDouble;
+			std::vector<NN9_SEGMENT<bfloat16_t, float>> vBf16;
+			auto aAdd = [&]( auto &_vSegs, const NN9_PARAM &_pParam, uint32_t _ui32Index ) {
+				using Seg = typename std::remove_reference<decltype( _vSegs )>::type::value_type;
+				using Type = typename std::remove_pointer<decltype( Seg::ptParam )>::type;
+				using Scalar = typename std::remove_pointer<decltype( Seg::psState0 )>::type;
+				const NN9_TYPE tState = std::is_same<Scalar, double>::value ? NN9_T_DOUBLE : NN9_T_FLOAT;
+				aCheck( _pParam.ptGrad, (*_pParam.ptParam), _pParam.ptParam->Type() );
+				if ( _bState0 ) { aCheck( _pParam.ptState0, (*_pParam.ptParam), tState ); }
+				if ( _bState1 ) { aCheck( _pParam.ptState1, (*_pParam.ptParam), tState ); }
+				Seg sSeg;
+				sSeg.ptParam = _pParam.ptParam->Strided<Type>().Data();
+				sSeg.ptGrad = _pParam.ptGrad->Strided<Type>().Data();
+				sSeg.psState0 = _bState0 ? _pParam.ptState0->Strided<Scalar>().Data() : nullptr;
+				sSeg.psState1 = _bState1 ? _pParam.ptState1->Strided<Scalar>().Data() : nullptr;
+				sSeg.sTotal = 1;
+				for ( auto sDim : _pParam.ptParam->Shape() ) { sSeg.sTotal *= sDim; }
+				sSeg.ui32Index = _ui32Index;
+				if ( sSeg.sTotal ) { _vSegs.push_back( sSeg ); }
+			};
+			for ( size_t I = 0; I < _vParams.size(); ++I ) {
+				const NN9_PARAM & pParam = _vParams[I];
+				if ( !pParam.ptParam ) { aFail( "A required tensor is missing." ); }
+				if ( !pParam.ptParam->IsContiguous() ) { aFail( "Every tensor must be contiguous." ); }
+				switch ( pParam.ptParam->Type() ) {
+					case NN9_T_FLOAT : { aAdd( vFloat, pParam, uint32_t( I ) ); break; }
+					case NN9_T_DOUBLE : { aAdd( vDouble, pParam, uint32_t( I ) ); break; }
+					case NN9_T_BFLOAT16 : { aAdd( vBf16, pParam, uint32_t( I ) ); break; }
+					default : { aFail( "Parameters must be NN9_T_FLOAT, NN9_T_DOUBLE, or NN9_T_BFLOAT16." ); }
+				}
+			}
+			if ( vFloat.size() ) { _fFunc( float(), vFloat ); }
+			if ( vDouble.size() ) { _fFunc( double(), vDouble ); }
+			if ( vBf16.size() ) { _fFunc( bfloat16_t(), vBf16 ); }
+		}
+
+		/**
+		 * Runs a kernel over every element of a list of segments in 1 parallel launch.  The segments are treated as 1 flat range, which is split
+		 *	into pieces of at least NN9_O_PARALLEL_GRAIN elements; each piece calls _fKernel once for each segment it covers.
+		 *
+		 * \tparam _tSeg The segment type.
+		 * \tparam _tKernel The kernel type, called as _fKernel( sTotal, ptParam, ptGrad, psState0, psState1, ui32Key, ui32Idx ).
+		 * \param _vSegs The segments.
+		 * \param _ui64Seed The stochastic-rounding seed.
+		 * \param _fKernel The kernel.
+		 **/
+		template <typename _tSeg, typename _tKernel>
+		static void													Launch( const std::vector<_tSeg> &_vSegs, uint64_t _ui64Seed, const _tKernel &_fKernel ) {
+			std::vector<size_t> vStart( _vSegs.size() + 1 );
+			std::vector<uint32_t> vKeys( _vSegs.size() );
+			vStart[0] = 0;
+			for ( size_t I = 0; I < _vSegs.size(); ++I ) {
+				vStart[I+1] = vStart[I] + _vSegs[I].sTotal;
+				vKeys[I] = Hash( uint32_t( _ui64Seed ) ^ Hash( uint32_t( _ui64Seed >> 32 ) + _vSegs[I].ui32Index * 0x85EBCA77U ) );
+			}
+
+			const size_t sTotal = vStart.back();
+			ThreadPool & tpPool = ThreadPool::Global();
+			size_t sGrain = std::max<size_t>( sTotal / (std::max<size_t>( tpPool.Size(), 1 ) * 4), NN9_O_PARALLEL_GRAIN );
+			sGrain = (sGrain + 63) & ~size_t( 63 );
+			tpPool.ParallelFor( 0, sTotal, sGrain, [&]( size_t _sBegin, size_t _sEnd ) {
+				size_t sSeg = size_t( std::upper_bound( vStart.begin(), vStart.end(), _sBegin ) - vStart.begin() ) - 1;
+				for ( ; sSeg < _vSegs.size() && vStart[sSeg] < _sEnd; ++sSeg ) {
+					const _tSeg & sThis = _vSegs[sSeg];
+					const size_t sFrom = std::max( _sBegin, vStart[sSeg] ) - vStart[sSeg];
+					const size_t sTo = std::min( _sEnd, vStart[sSeg+1] ) - vStart[sSeg];
+					_fKernel( sTo - sFrom, sThis.ptParam + sFrom, sThis.ptGrad + sFrom,
+						sThis.psState0 ? sThis.psState0 + sFrom : nullptr, sThis.psState1 ? sThis.psState1 + sFrom : nullptr,
+						vKeys[sSeg], uint32_t( sFrom ) );
+				}
+			} );
+		}
+	};
+
+}	// namespace nn9
@@ -0,0 +1,485 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: 8-bit integer matrix multiplication.  Multiplies uint8_t or int8_t activations by pre-packed int8_t weights into int32_t
+ *	accumulators with vpdpbusd (AVX-512 VNNI or AVX-VNNI), pmaddubsw (AVX2), or scalar code.
+ */
+
+#pragma once
+
+#include "../Foundation/NN9AlignmentAllocator.h"
+#include "../Foundation/NN9Intrin.h"
+#include "../Foundation/NN9Kernels.h"
+#include "NN9Quantize.h"
+#include "../Tensor/NN9Tensor.h"
+#include "../Types/NN9Types.h"
+#include "../Utilities/NN9ThreadPool.h"
+#include "../Utilities/NN9Utilities.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace nn9 {
+
+	/**
+	 * Class QGemm
+	 * \brief 8-bit integer matrix multiplication.
+	 *
+	 * Description: 8-bit integer matrix multiplication.  Computes C = (A - zA) * B, where A is an M x K matrix of uint8_t or int8_t values
+	 *	with zero point zA, B is a K x N matrix of symmetric int8_t weights (zero point 0), and C is an M x N matrix of int32_t values.
+	 *	B is packed once by PackB() into 16-column panels holding 4 consecutive k values per column, which is the operand layout of
+	 *	vpdpbusd and pmaddubsw, and its column sums are kept so that the zero point of A is removed with 1 subtraction per output.
+	 *	int8_t activations are shifted to uint8_t by adding 128 (and 128 is added to their zero point), since both instructions multiply
+	 *	unsigned bytes by signed bytes.
+	 *
+	 * pmaddubsw adds pairs of products into saturating 16-bit values, which overflow once |b| > 64.  When any weight is outside [-64, 64],
+	 *	the AVX2 kernel splits each byte of A into nibbles and multiplies them separately, at about half the speed.
+	 *
+	 * The SIMD micro-kernels are the pfGemmI8 entries of Kernels::Table(), so they are picked at run time whatever instruction sets the
+	 *	build targets.
+	 */
+	class QGemm {
+	public :
+		// == Enumerations.
+		/** Blocking constants. */
+		enum NN9_QGEMM : size_t {
+			NN9_QG_PANEL						= Kernels::NN9_KG_I8_PANEL,				/**< Columns in each packed panel of B. */
+			NN9_QG_KGROUP						= Kernels::NN9_KG_I8_KGROUP,			/**< Consecutive k values multiplied by each step. */
+			NN9_QG_KC							= 1024,									/**< Depth of each packed block of A.  A packed sliver of B this deep stays in L1. */
+			NN9_QG_MC_PANELS					= 16,									/**< Mr-row slivers in each packed block of A. */
+			NN9_QG_NR_MAX						= 32,									/**< The widest micro-kernel tile.  Packed B is padded to a multiple of this. */
+			NN9_QG_PARALLEL_OPS					= 1 << 20,								/**< M * N * K below which a multiply runs on the calling thread. */
+		};
+
+		/** Micro-kernels. */
+		enum NN9_QGEMM_KERNEL : size_t {
+			NN9_QK_AUTO,																/**< The fastest kernel the CPU supports. */
+			NN9_QK_AVX512VNNI,															/**< vpdpbusd on 512-bit registers. */
+			NN9_QK_AVXVNNI,																/**< vpdpbusd on 256-bit registers (AVX-VNNI). */
+			NN9_QK_AVX2,																/**< pmaddubsw and pmaddwd. */
+			NN9_QK_SCALAR,																/**< Plain C++. */
+		};
+
+
+		// == Types.
+		/** A 64-byte-aligned buffer. */
+		template <typename _tType>
+		using PackBuffer = std::vector<_tType, AlignmentAllocator<_tType, 64>>;
+
+		/** A packed K x N matrix of int8_t weights. */
+		struct NN9_PACKED_B {
+			size_t								sK = 0;									/**< The number of rows (the depth). */
+			size_t								sN = 0;									/**< The number of columns. */
+			size_t								sKp = 0;								/**< The depth rounded up to a multiple of NN9_QG_KGROUP. */
+			PackBuffer<int8_t>					vData;									/**< Panels of NN9_QG_PANEL columns, each sKp * NN9_QG_PANEL bytes. */
+			std::vector<int32_t>				vColSums;								/**< The sum of each column. */
+			bool								bSmall = true;							/**< True if every weight is in [-64, 64]. */
+
+			/**
+			 * Gets the bytes between the starts of 2 panels.
+			 *
+			 * \return Returns the size of a panel.
+			 **/
+			size_t								PanelStride() const { return sKp * NN9_QG_PANEL; }
+		};
+
+
+		// == Functions.
+		/**
+		 * Packs a K x N matrix of int8_t weights.  B is addressed by a row stride and a column stride in elements, so a transposed matrix
+		 *	(such as an [N, K] weight tensor) is packed by swapping its strides.
+		 *
+		 * \param _sK The number of rows in B.
+		 * \param _sN The number of columns in B.
+		 * \param _pi8B The first element of B.
+		 * \param _sRowB The distance between rows of B.
+		 * \param _sColB The distance between columns of B.
+		 * \return Returns the packed matrix.
+		 **/
+		static NN9_PACKED_B											PackB( size_t _sK, size_t _sN, const int8_t * _pi8B, size_t _sRowB, size_t _sColB ) {
+			NN9_PACKED_B pbRet;
+			pbRet.sK = _sK;
+			pbRet.sN = _sN;
+			pbRet.sKp = RoundUp( _sK, NN9_QG_KGROUP );
+			const size_t sPanels = RoundUp( _sN, NN9_QG_NR_MAX ) / NN9_QG_PANEL;
+			pbRet.vData.assign( sPanels * pbRet.PanelStride(), 0 );
+			pbRet.vColSums.assign( _sN, 0 );
+			for ( size_t J = 0; J < _sN; ++J ) {
+				int8_t * pi8Panel = pbRet.vData.data() + (J / NN9_QG_PANEL) * pbRet.PanelStride() + (J % NN9_QG_PANEL) * NN9_QG_KGROUP;
+				int32_t i32Sum = 0;
+				for ( size_t K = 0; K < _sK; ++K ) {
+					const int8_t i8Val = _pi8B[K*_sRowB+J*_sColB];
+					pi8Panel[(K/NN9_QG_KGROUP)*NN9_QG_PANEL*NN9_QG_KGROUP+K%NN9_QG_KGROUP] = i8Val;
+					i32Sum += i8Val;
+					if ( i8Val < -64 || i8Val > 64 ) { pbRet.bSmall = false; }
+				}
+				pbRet.vColSums[J] = i32Sum;
+			}
+			return pbRet;
+		}
+
+		/**
+		 * Packs a 2-dimensional NN9_T_QINT8 tensor of weights.
+		 *
+		 * \param _tB The [K, N] weights, or [N, K] if _bTrans.
+		 * \param _bTrans If true, the weights are used transposed.
+		 * \throw Throws if _tB is not a 2-dimensional NN9_T_QINT8 tensor.
+		 * \return Returns the packed matrix.
+		 **/
+		static NN9_PACKED_B											PackB( Tensor &_tB, bool _bTrans = false ) {
+			if ( _tB.Type() != NN9_T_QINT8 || _tB.Shape().size() != 2 ) {
+				throw std::invalid_argument( "QGemm::PackB: Weights must be a 2-dimensional NN9_T_QINT8 tensor." );
+			}
+			size_t sK = _tB.Shape()[0], sN = _tB.Shape()[1];
+			size_t sRowB = _tB.Strides()[0], sColB = _tB.Strides()[1];
+			if ( _bTrans ) { std::swap( sK, sN ); std::swap( sRowB, sColB ); }
+			return PackB( sK, sN, _tB.Strided<int8_t>().Data(), sRowB, sColB );
+		}
+
+		/**
+		 * Computes C = (A - zA) * B.
+		 *
+		 * \tparam _tA The type of A: uint8_t or int8_t.
+		 * \param _sM The number of rows in A and C.
+		 * \param _ptA The first element of A, which is row-major.
+		 * \param _sRowA The distance between rows of A.
+		 * \param _i32ZeroA The zero point of A.
+		 * \param _pbB The packed weights.
+		 * \param _pi32C The first element of C, which is row-major.
+		 * \param _sRowC The distance between rows of C.
+		 * \param _qkKernel The micro-kernel.  Kernels the CPU does not support fall back to the next-fastest one.
+		 **/
+		template <typename _tA>
+		static void													Run( size_t _sM, const _tA * _ptA, size_t _sRowA, int32_t _i32ZeroA,
+			const NN9_PACKED_B &_pbB, int32_t * _pi32C, size_t _sRowC, NN9_QGEMM_KERNEL _qkKernel = NN9_QK_AUTO ) {
+			static_assert( std::is_same<_tA, uint8_t>::value || std::is_same<_tA, int8_t>::value, "QGemm::Run: A must be uint8_t or int8_t." );
+			if ( !_sM || !_pbB.sN ) { return; }
+			if constexpr ( std::is_same<_tA, int8_t>::value ) { _i32ZeroA += 128; }
+
+			switch ( Resolve( _qkKernel ) ) {
+				case NN9_QK_AVX512VNNI : {
+					return Blocked<NN9_ISA_TABLE<Kernels::NN9_KG_I8_AVX512VNNI_MR, Kernels::NN9_KG_I8_AVX512VNNI_NR, Kernels::NN9_KQ_AVX512VNNI>>( _sM, _ptA, _sRowA, _i32ZeroA, _pbB, _pi32C, _sRowC );
+				}
+				case NN9_QK_AVXVNNI : {
+					return Blocked<NN9_ISA_TABLE<Kernels::NN9_KG_I8_AVXVNNI_MR, Kernels::NN9_KG_I8_AVXVNNI_NR, Kernels::NN9_KQ_AVXVNNI>>( _sM, _ptA, _sRowA, _i32ZeroA, _pbB, _pi32C, _sRowC );
+				}
+				case NN9_QK_AVX2 : {
+					if ( _pbB.bSmall ) { return Blocked<NN9_ISA_TABLE<Kernels::NN9_KG_I8_AVX2_MR, Kernels::NN9_KG_I8_AVX2_NR, Kernels::NN9_KQ_AVX2>>( _sM, _ptA, _sRowA, _i32ZeroA, _pbB, _pi32C, _sRowC ); }
+					return Blocked<NN9_ISA_TABLE<Kernels::NN9_KG_I8_AVX2_MR, Kernels::NN9_KG_I8_AVX2_NR, Kernels::NN9_KQ_AVX2_SPLIT>>( _sM, _ptA, _sRowA, _i32ZeroA, _pbB, _pi32C, _sRowC );
+				}
+				default : {
+					return Blocked<NN9_ISA_SCALAR>( _sM, _ptA, _sRowA, _i32ZeroA, _pbB, _pi32C, _sRowC );
+				}
+			}
+		}
+
+		/**
+		 * Multiplies a quantized [..., K] tensor by packed weights.  The result is an NN9_T_QINT32 tensor of shape [..., N] whose scale is
+		 *	the scale of A times _fScaleB and whose zero point is 0; requantize it with Quantize::Requantize().
+		 *
+		 * \param _tA The NN9_T_QUINT8 or NN9_T_QINT8 activations.
+		 * \param _pbB The packed weights.
+		 * \param _fScaleB The scale of the weights.
+		 * \param _qkKernel The micro-kernel.
+		 * \throw Throws if _tA is not NN9_T_QUINT8 or NN9_T_QINT8 or its last dimension is not K.
+		 * \return Returns the int32_t accumulators.
+		 **/
+		static Tensor												MatMul( const Tensor &_tA, const NN9_PACKED_B &_pbB, float _fScaleB = 1.0f, NN9_QGEMM_KERNEL _qkKernel = NN9_QK_AUTO ) {
+			if ( _tA.Type() != NN9_T_QUINT8 && _tA.Type() != NN9_T_QINT8 ) {
+				throw std::invalid_argument( "QGemm::MatMul: A must be NN9_T_QUINT8 or NN9_T_QINT8." );
+			}
+			if ( _tA.Shape().empty() || _tA.Shape().back() != _pbB.sK ) {
+				throw std::invalid_argument( "QGemm::MatMul: The last dimension of A must match the depth of B." );
+			}
+			Tensor tA = _tA.Contiguous();
+			std::vector<size_t> vShape = tA.Shape();
+			vShape.back() = _pbB.sN;
+			std::vector<size_t> vStride( vShape.size(), 1 );
+			for ( size_t I = vShape.size() - 1; I > 0; --I ) { vStride[I-1] = vStride[I] * vShape[I]; }
+			Tensor tRet( vShape, vStride, NN9_T_QINT32, tA.QuantizeScale() * _fScaleB, 0.0 );
+
+			const size_t sM = _pbB.sN ? tRet.Strided<int32_t>().size() / _pbB.sN : 0;
+			const int32_t i32Zero = int32_t( tA.QuantizeZero() );
+			if ( tA.Type() == NN9_T_QUINT8 ) {
+				Run( sM, tA.Strided<uint8_t>().Data(), _pbB.sK, i32Zero, _pbB, tRet.Strided<int32_t>().Data(), _pbB.sN, _qkKernel );
+			}
+			else {
+				Run( sM, tA.Strided<int8_t>().Data(), _pbB.sK, i32Zero, _pbB, tRet.Strided<int32_t>().Data(), _pbB.sN, _qkKernel );
+			}
+			return tRet;
+		}
+
+		/**
+		 * Determines the kernel to use.  Kernels the CPU does not support fall back to the next-fastest one.
+		 *
+		 * \param _qkKernel The requested kernel.
+		 * \return Returns the kernel that will run.
+		 **/
+		static NN9_QGEMM_KERNEL										Resolve( NN9_QGEMM_KERNEL _qkKernel ) {
+			const auto & pfGemmI8 = Kernels::Table().pfGemmI8;
+			if ( _qkKernel == NN9_QK_AUTO ) { _qkKernel = NN9_QK_AVX512VNNI; }
+			if ( _qkKernel == NN9_QK_AVX512VNNI && pfGemmI8[Kernels::NN9_KQ_AVX512VNNI] ) { return NN9_QK_AVX512VNNI; }
+			if ( _qkKernel == NN9_QK_AVX512VNNI ) { _qkKernel = NN9_QK_AVXVNNI; }
+			if ( _qkKernel == NN9_QK_AVXVNNI && pfGemmI8[Kernels::NN9_KQ_AVXVNNI] ) { return NN9_QK_AVXVNNI; }
+			if ( _qkKernel == NN9_QK_AVXVNNI ) { _qkKernel = NN9_QK_AVX2; }
+			if ( _qkKernel == NN9_QK_AVX2 && pfGemmI8[Kernels::NN9_KQ_AVX2] ) { return NN9_QK_AVX2; }
+			return NN9_QK_SCALAR;
+		}
+
+
+	protected :
+		// == Types.
+		/**
+		 * Scalar micro-kernel.  Reg holds Lanes int32_t accumulators, AOp is 4 bytes of A broadcast to every lane, and BOp is 4 bytes of B
+		 *	for each lane, as in the int8_t register traits of the per-instruction-set kernel files.
+		 */
+		struct NN9_ISA_SCALAR {
+			typedef int32_t									Reg;
+			typedef const uint8_t *							AOp;
+			typedef const int8_t *							BOp;
+			static constexpr size_t							Lanes = 1;
+			static constexpr size_t							Mr = 4;
+			static constexpr size_t							Nv = 4;
+			static constexpr bool							FromTable = false;
+
+			static inline Reg								Zero() { return 0; }
+			static inline AOp								SetA( const uint8_t * _pui8A ) { return _pui8A; }
+			static inline BOp								LoadB( const int8_t * _pi8B ) { return _pi8B; }
+			static inline Reg								Load( const int32_t * _pi32Src ) { return (*_pi32Src); }
+			static inline void								Store( int32_t * _pi32Dst, Reg _rVal ) { (*_pi32Dst) = _rVal; }
+			static inline Reg								Add( Reg _rA, Reg _rB ) { return _rA + _rB; }
+			static inline Reg								Dp( Reg _rAcc, AOp _aA, BOp _bB ) {
+				return _rAcc + int32_t( _aA[0] ) * _bB[0] + int32_t( _aA[1] ) * _bB[1] + int32_t( _aA[2] ) * _bB[2] + int32_t( _aA[3] ) * _bB[3];
+			}
+		};
+
+		/**
+		 * Micro-kernels from Kernels::Table().  Each full tile goes to the table's pfGemmI8 entry; the members of NN9_ISA_SCALAR serve
+		 *	nothing else.  Lanes is 1 and Nv is the width of the tile so that Blocked() sizes its tiles as the table's kernels expect.
+		 *
+		 * \tparam _sMr The rows in a tile.
+		 * \tparam _sNr The columns in a tile.
+		 * \tparam _kqKernel The table entry.
+		 */
+		template <size_t _sMr, size_t _sNr, Kernels::NN9_KERNEL_INT8 _kqKernel>
+		struct NN9_ISA_TABLE : public NN9_ISA_SCALAR {
+			static constexpr size_t							Mr = _sMr;
+			static constexpr size_t							Nv = _sNr;
+			static constexpr bool							FromTable = true;
+
+			/** Gets the tile kernel. */
+			static inline auto								Kernel() { return Kernels::Table().pfGemmI8[_kqKernel]; }
+		};
+
+
+		// == Functions.
+		/**
+		 * The blocked multiply.  The rows of A are split into blocks of Mr * NN9_QG_MC_PANELS and the columns of B into groups of panels; each
+		 *	task packs its block of A 1 KC-deep slice at a time and runs the micro-kernel over its columns, then removes the zero point of A.
+		 *
+		 * \tparam _tIsa The micro-kernel ISA.
+		 * \tparam _tA The type of A: uint8_t or int8_t.
+		 * \param _sM The number of rows in A and C.
+		 * \param _ptA The first element of A.
+		 * \param _sRowA The distance between rows of A.
+		 * \param _i32ZeroA The zero point of A after any shift to uint8_t.
+		 * \param _pbB The packed weights.
+		 * \param _pi32C The first element of C.
+		 * \param _sRowC The distance between rows of C.
+		 **/
+		template <typename _tIsa, typename _tA>
+		static void													Blocked( size_t _sM, const _tA * _ptA, size_t _sRowA, int32_t _i32ZeroA,
+			const NN9_PACKED_B &_pbB, int32_t * _pi32C, size_t _sRowC ) {
+			constexpr size_t sMr = _tIsa::Mr;
+			constexpr size_t sNr = _tIsa::Nv * _tIsa::Lanes;
+			constexpr size_t sMc = sMr * NN9_QG_MC_PANELS;
+			const size_t sN = _pbB.sN, sK = _pbB.sK;
+
+			if ( !sK ) {
+				for ( size_t I = 0; I < _sM; ++I ) { std::fill( _pi32C + I * _sRowC, _pi32C + I * _sRowC + sN, 0 ); }
+				return;
+			}
+
+			ThreadPool & tpPool = ThreadPool::Global();
+			const bool bParallel = tpPool.Size() && double( _sM ) * double( sN ) * double( sK ) > double( NN9_QG_PARALLEL_OPS );
+			const size_t sBlocksM = (_sM + sMc - 1) / sMc;
+			const size_t sTilesN = (sN + sNr - 1) / sNr;
+			size_t sSplitsN = 1;
+			if ( bParallel ) {
+				const size_t sWanted = tpPool.Size() * 2;
+				sSplitsN = std::min( sTilesN, std::max<size_t>( 1, (sWanted + sBlocksM - 1) / sBlocksM ) );
+			}
+			const size_t sTilesPerSplit = (sTilesN + sSplitsN - 1) / sSplitsN;
+			sSplitsN = (sTilesN + sTilesPerSplit - 1) / sTilesPerSplit;
+
+			auto aTask = [&]( size_t _sBegin, size_t _sEnd ) {
+				thread_local PackBuffer<uint8_t> vPackA;
+				vPackA.resize( sMc * NN9_QG_KC );
+				NN9_ALIGN( 64 )
+				int32_t i32Tile[sMr*sNr];
+				for ( size_t T = _sBegin; T < _sEnd; ++T ) {
+					const size_t IC = (T / sSplitsN) * sMc;
+					const size_t sMcThis = std::min( sMc, _sM - IC );
+					const size_t sColStart = (T % sSplitsN) * sTilesPerSplit * sNr;
+					const size_t sColEnd = std::min( sN, sColStart + sTilesPerSplit * sNr );
+					for ( size_t PC = 0; PC < sK; PC += NN9_QG_KC ) {
+						const size_t sKc = std::min<size_t>( NN9_QG_KC, sK - PC );
+						const size_t sKp = RoundUp( sKc, NN9_QG_KGROUP );
+						const bool bAdd = PC != 0;
+						for ( size_t IR = 0; IR < sMcThis; IR += sMr ) {
+							PackA<sMr>( sKc, std::min( sMr, sMcThis - IR ), _ptA + (IC + IR) * _sRowA + PC, _sRowA, vPackA.data() + IR * sKp );
+						}
+						for ( size_t sCol = sColStart; sCol < sColEnd; sCol += sNr ) {
+							const size_t sNrThis = std::min( sNr, sN - sCol );
+							const int8_t * pi8B = _pbB.vData.data() + (sCol / NN9_QG_PANEL) * _pbB.PanelStride() + (sCol % NN9_QG_PANEL) * NN9_QG_KGROUP + PC * NN9_QG_PANEL;
+							for ( size_t IR = 0; IR < sMcThis; IR += sMr ) {
+								const size_t sMrThis = std::min( sMr, sMcThis - IR );
+								int32_t * pi32C = _pi32C + (IC + IR) * _sRowC + sCol;
+								const uint8_t * pui8A = vPackA.data() + IR * sKp;
+								if ( sMrThis == sMr && sNrThis == sNr ) {
+									MicroKernel<_tIsa>( sKp / NN9_QG_KGROUP, pui8A, pi8B, _pbB.PanelStride(), pi32C, _sRowC, bAdd );
+								}
+								else {
+									// Edge tiles go through a local tile.
+									MicroKernel<_tIsa>( sKp / NN9_QG_KGROUP, pui8A, pi8B, _pbB.PanelStride(), i32Tile, sNr, false );
+									for ( size_t I = 0; I < sMrThis; ++I ) {
+										for ( size_t J = 0; J < sNrThis; ++J ) {
+											int32_t & i32C = pi32C[I*_sRowC+J];
+											i32C = bAdd ? i32C + i32Tile[I*sNr+J] : i32Tile[I*sNr+J];
+										}
+									}
+								}
+							}
+						}
+					}
+					if ( _i32ZeroA ) {
+						for ( size_t I = IC; I < IC + sMcThis; ++I ) {
+							int32_t * pi32C = _pi32C + I * _sRowC;
+							for ( size_t J = sColStart; J < sColEnd; ++J ) { pi32C[J] -= _i32ZeroA * _pbB.vColSums[J]; }
+						}
+					}
+				}
+			};
+			const size_t sTasks = sBlocksM * sSplitsN;
+			if ( bParallel ) { tpPool.ParallelFor( 0, sTasks, 1, aTask ); }
+			else { aTask( 0, sTasks ); }
+		}
+
+		/**
+		 * Packs an Mr-row sliver of A into groups of 4 consecutive k values per row, shifting int8_t values to uint8_t and padding missing
+		 *	rows and the missing k values of the final group with 0.
+		 *
+		 * \tparam _sMr The rows in a sliver.
+		 * \tparam _tA The type of A: uint8_t or int8_t.
+		 * \param _sK The number of columns to pack.
+		 * \param _sRows The number of valid rows (at most _sMr).
+		 * \param _ptA The first element of the sliver.
+		 * \param _sRowA The distance between rows of A.
+		 * \param _pui8Dst The packed output.
+		 **/
+		template <size_t _sMr, typename _tA>
+		static void													PackA( size_t _sK, size_t _sRows, const _tA * _ptA, size_t _sRowA, uint8_t * _pui8Dst ) {
+			const size_t sGroups = RoundUp( _sK, NN9_QG_KGROUP ) / NN9_QG_KGROUP;
+			if ( _sRows < _sMr || _sK % NN9_QG_KGROUP ) {
+				std::memset( _pui8Dst, 0, sGroups * _sMr * NN9_QG_KGROUP );
+			}
+			const uint8_t ui8Shift = std::is_same<_tA, int8_t>::value ? 0x80 : 0x00;
+			const size_t sWhole = _sK / NN9_QG_KGROUP;
+			for ( size_t I = 0; I < _sRows; ++I ) {
+				const uint8_t * pui8Src = reinterpret_cast<const uint8_t *>(_ptA + I * _sRowA);
+				uint8_t * pui8Dst = _pui8Dst + I * NN9_QG_KGROUP;
+				for ( size_t G = 0; G < sWhole; ++G ) {
+					uint32_t ui32Val;
+					std::memcpy( &ui32Val, pui8Src + G * NN9_QG_KGROUP, sizeof( ui32Val ) );
+					ui32Val ^= ui8Shift * 0x01010101U;
+					std::memcpy( pui8Dst + G * _sMr * NN9_QG_KGROUP, &ui32Val, sizeof( ui32Val ) );
+				}
+				for ( size_t K = sWhole * NN9_QG_KGROUP; K < _sK; ++K ) {
+					pui8Dst[sWhole*_sMr*NN9_QG_KGROUP+K%NN9_QG_KGROUP] = uint8_t( pui8Src[K] ^ ui8Shift );
+				}
+			}
+		}
+
+		/**
+		 * Computes a full Mr x Nr tile of C (or adds it to C) from a packed sliver of A and packed panels of B.
+		 *
+		 * \tparam _tIsa The micro-kernel ISA.
+		 * \param _sSteps The number of 4-deep groups.
+		 * \param _pui8A The packed sliver of A.
+		 * \param _pi8B The first group of the tile's first column in packed B.
+		 * \param _sPanelStride The bytes between the starts of 2 panels of B.
+		 * \param _pi32C The top-left element of the tile of C.
+		 * \param _sRowC The distance between rows of C.
+		 * \param _bAdd If true, the tile is added to C instead of replacing it.
+		 **/
+		template <typename _tIsa>
+		static inline void											MicroKernel( size_t _sSteps, const uint8_t * _pui8A, const int8_t * _pi8B, size_t _sPanelStride,
+			int32_t * _pi32C, size_t _sRowC, bool _bAdd ) {
+			if constexpr ( _tIsa::FromTable ) { _tIsa::Kernel()( _sSteps, _pui8A, _pi8B, _sPanelStride, _pi32C, _sRowC, _bAdd ); }
+			else { MicroKernel<_tIsa>( _sSteps, _pui8A, _pi8B, _sPanelStride, _pi32C, _sRowC, _bAdd, std::make_index_sequence<_tIsa::Mr * _tIsa::Nv>() ); }
+		}
+
+		/**
+		 * Computes a full Mr x Nr tile of C (or adds it to C).  The accumulators are expanded from an index sequence so that every compiler
+		 *	keeps them in registers.
+		 *
+		 * \tparam _tIsa The micro-kernel ISA.
+		 * \tparam _sIdx The accumulator indices, 0 to Mr * Nv - 1; accumulator I holds row I / Nv, register I % Nv.
+		 * \param _sSteps The number of 4-deep groups.
+		 * \param _pui8A The packed sliver of A.
+		 * \param _pi8B The first group of the tile's first column in packed B.
+		 * \param _sPanelStride The bytes between the starts of 2 panels of B.
+		 * \param _pi32C The top-left element of the tile of C.
+		 * \param _sRowC The distance between rows of C.
+		 * \param _bAdd If true, the tile is added to C instead of replacing it.
+		 **/
+		template <typename _tIsa, size_t ... _sIdx>
+		static inline void											MicroKernel( size_t _sSteps, const uint8_t * _pui8A, const int8_t * _pi8B, size_t _sPanelStride,
+			int32_t * _pi32C, size_t _sRowC, bool _bAdd, std::index_sequence<_sIdx...> ) {
+			using Reg = typename _tIsa::Reg;
+			constexpr size_t sMr = _tIsa::Mr;
+			constexpr size_t sNv = _tIsa::Nv;
+			constexpr size_t sLanes = _tIsa::Lanes;
+			constexpr size_t sGroup = NN9_QG_PANEL * NN9_QG_KGROUP;
+
+			// Register V covers columns V * Lanes and up, which may lie in a later panel.
+			const int8_t * pi8B[sNv];
+			for ( size_t V = 0; V < sNv; ++V ) {
+				pi8B[V] = _pi8B + ((V * sLanes) / NN9_QG_PANEL) * _sPanelStride + ((V * sLanes) % NN9_QG_PANEL) * NN9_QG_KGROUP;
+			}
+			Reg rAcc[sMr*sNv] = { ((void)_sIdx, _tIsa::Zero())... };
+			for ( size_t K = 0; K < _sSteps; ++K ) {
+				typename _tIsa::BOp bB[sNv];
+				for ( size_t V = 0; V < sNv; ++V ) { bB[V] = _tIsa::LoadB( pi8B[V] + K * sGroup ); }
+				((rAcc[_sIdx] = _tIsa::Dp( rAcc[_sIdx], _tIsa::SetA( _pui8A + (_sIdx / sNv) * NN9_QG_KGROUP ), bB[_sIdx%sNv] )), ...);
+				_pui8A += sMr * NN9_QG_KGROUP;
+			}
+
+			if ( _bAdd ) {
+				(_tIsa::Store( _pi32C + (_sIdx / sNv) * _sRowC + (_sIdx % sNv) * sLanes,
+					_tIsa::Add( _tIsa::Load( _pi32C + (_sIdx / sNv) * _sRowC + (_sIdx % sNv) * sLanes ), rAcc[_sIdx] ) ), ...);
+			}
+			else {
+				(_tIsa::Store( _pi32C + (_sIdx / sNv) * _sRowC + (_sIdx % sNv) * sLanes, rAcc[_sIdx] ), ...);
+			}
+		}
+
+		/**
+		 * Rounds a value up to a multiple of another.
+		 *
+		 * \param _sVal The value to round.
+		 * \param _sMultiple The multiple.
+		 * \return Returns the smallest multiple of _sMultiple that is at least _sVal.
+		 **/
+		static inline constexpr size_t								RoundUp( size_t _sVal, size_t _sMultiple ) { return (_sVal + _sMultiple - 1) / _sMultiple * _sMultiple; }
+	};
+
+}	// namespace nn9
@@ -0,0 +1,371 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Linear (affine) quantization.  Converts float values to 8-bit integers with a scale and a zero point, converts them back,
+ *	and requantizes 32-bit accumulators from the integer GEMM back to 8 bits.
+ */
+
+#pragma once
+
+#include "../Foundation/NN9Kernels.h"
+#include "NN9Math.h"
+#include "../Tensor/NN9Tensor.h"
+#include "../Types/NN9Types.h"
+#include "../Utilities/NN9ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+
+namespace nn9 {
+
+	/**
+	 * Class Quantize
+	 * \brief Linear (affine) quantization.
+	 *
+	 * Description: Linear (affine) quantization.  A real value r is stored as q = clamp( round( r / scale ) + zero ), and read back as
+	 *	r = (q - zero) * scale.  NN9_T_QUINT8 tensors hold uint8_t values, NN9_T_QINT8 tensors hold int8_t values, and NN9_T_QINT32 tensors
+	 *	hold int32_t values (usually GEMM accumulators).  A per-tensor scale and zero point are kept in the tensor; per-channel scales are
+	 *	kept by the caller, since a tensor holds only one.  Rounding is to nearest-even and r / scale is computed as r * (1 / scale) so
+	 *	that the vector and scalar paths give the same results.
+	 */
+	class Quantize {
+	public :
+		// == Enumerations.
+		/** Tuning constants. */
+		enum NN9_QUANTIZE : size_t {
+			NN9_Q_GRAIN							= 1 << 16,										/**< Elements per parallel subrange. */
+		};
+
+
+		// == Types.
+		/** The scale and zero point of a quantized range. */
+		struct NN9_QPARAMS {
+			float								fScale = 1.0f;									/**< The real value of 1 step. */
+			int32_t								i32Zero = 0;									/**< The quantized value of a real 0. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Gets the range of a quantized type.
+		 *
+		 * \tparam _tQ The quantized type: int8_t, uint8_t, or int32_t.
+		 * \return Returns the smallest value used.  int8_t uses -127 rather than -128 so that symmetric ranges stay symmetric.
+		 **/
+		template <typename _tQ>
+		static constexpr int32_t								Min() { return std::is_same<_tQ, int8_t>::value ? -127 : int32_t( std::numeric_limits<_tQ>::min() ); }
+
+		/**
+		 * Gets the range of a quantized type.
+		 *
+		 * \tparam _tQ The quantized type: int8_t, uint8_t, or int32_t.
+		 * \return Returns the largest value used.
+		 **/
+		template <typename _tQ>
+		static constexpr int32_t								Max() { return int32_t( std::numeric_limits<_tQ>::max() ); }
+
+		/**
+		 * Chooses the scale and zero point that map [_fMin, _fMax] onto a quantized type.  The range is widened to include 0 so that 0 is
+		 *	exact (padding and ReLU outputs depend on this).
+		 *
+		 * \tparam _tQ The quantized type: int8_t or uint8_t.
+		 * \param _fMin The smallest real value.
+		 * \param _fMax The largest real value.
+		 * \param _bSymmetric If true, the range is made symmetric around 0 and the zero point is the middle of the type (0 for int8_t, 128
+		 *	for uint8_t).
+		 * \return Returns the scale and zero point.
+		 **/
+		template <typename _tQ>
+		static NN9_QPARAMS										ChooseParams( float _fMin, float _fMax, bool _bSymmetric = false ) {
+			constexpr int32_t i32Min = Min<_tQ>(), i32Max = Max<_tQ>();
+			_fMin = std::min( _fMin, 0.0f );
+			_fMax = std::max( _fMax, 0.0f );
+			NN9_QPARAMS qpRet;
+			if ( _bSymmetric ) {
+				const float fAbs = std::max( -_fMin, _fMax );
+				qpRet.i32Zero = std::is_same<_tQ, int8_t>::value ? 0 : (i32Max + 1) / 2;
+				qpRet.fScale = fAbs / float( i32Max - qpRet.i32Zero );
+			}
+			else {
+				qpRet.fScale = (_fMax - _fMin) / float( i32Max - i32Min );
+			}
+			if ( !(qpRet.fScale > 0.0f) || !std::isfinite( qpRet.fScale ) ) { qpRet.fScale = 1.0f; }
+			if ( !_bSymmetric ) {
+				qpRet.i32Zero = int32_t( std::clamp( std::nearbyint( float( i32Min ) - _fMin / qpRet.fScale ), float( i32Min ), float( i32Max ) ) );
+			}
+			return qpRet;
+		}
+
+		/**
+		 * Chooses the scale and zero point covering an array of float values.
+		 *
+		 * \tparam _tQ The quantized type: int8_t or uint8_t.
+		 * \param _pfSrc The values.
+		 * \param _sTotal The number of values.
+		 * \param _bSymmetric If true, the range is made symmetric around 0.
+		 * \return Returns the scale and zero point.
+		 **/
+		template <typename _tQ>
+		static NN9_QPARAMS										ChooseParams( const float * _pfSrc, size_t _sTotal, bool _bSymmetric = false ) {
+			float fMin = 0.0f, fMax = 0.0f;
+			for ( size_t I = 0; I < _sTotal; ++I ) {
+				if ( _pfSrc[I] < fMin ) { fMin = _pfSrc[I]; }
+				if ( _pfSrc[I] > fMax ) { fMax = _pfSrc[I]; }
+			}
+			return ChooseParams<_tQ>( fMin, fMax, _bSymmetric );
+		}
+
+		/**
+		 * Quantizes float values: _ptDst[I] = clamp( round( _pfSrc[I] / _fScale ) + _i32Zero ).  NaN becomes the smallest value.
+		 *
+		 * \tparam _tQ The quantized type: int8_t or uint8_t.
+		 * \param _pfSrc The values to quantize.
+		 * \param _ptDst The quantized output.
+		 * \param _sTotal The number of values.
+		 * \param _fScale The scale.
+		 * \param _i32Zero The zero point.
+		 **/
+		template <typename _tQ>
+		static void												QuantizeLinear( const float * _pfSrc, _tQ * _ptDst, size_t _sTotal, float _fScale, int32_t _i32Zero ) {
+			Parallel( _sTotal, [=]( size_t _sBegin, size_t _sEnd ) {
+				ScaleToQ<_tQ>( nullptr, _pfSrc + _sBegin, _ptDst + _sBegin, _sEnd - _sBegin, 1.0f / _fScale, _i32Zero );
+			} );
+		}
+
+		/**
+		 * Dequantizes values: _pfDst[I] = (_ptSrc[I] - _i32Zero) * _fScale.
+		 *
+		 * \tparam _tQ The quantized type: int8_t, uint8_t, or int32_t.
+		 * \param _ptSrc The quantized values.
+		 * \param _pfDst The float output.
+		 * \param _sTotal The number of values.
+		 * \param _fScale The scale.
+		 * \param _i32Zero The zero point.
+		 **/
+		template <typename _tQ>
+		static void												DequantizeLinear( const _tQ * _ptSrc, float * _pfDst, size_t _sTotal, float _fScale, int32_t _i32Zero ) {
+			const auto pfKernel = Kernels::Table().pfDequantize[Math::KernelType<_tQ>()];
+			Parallel( _sTotal, [=]( size_t _sBegin, size_t _sEnd ) {
+				if ( pfKernel ) { pfKernel( _ptSrc + _sBegin, _pfDst + _sBegin, _sEnd - _sBegin, _fScale, _i32Zero ); }
+				else {
+					for ( size_t I = _sBegin; I < _sEnd; ++I ) { _pfDst[I] = float( int32_t( _ptSrc[I] ) - _i32Zero ) * _fScale; }
+				}
+			} );
+		}
+
+		/**
+		 * Requantizes a row-major matrix of 32-bit accumulators to 8 bits: _ptDst[I,J] = clamp( round( _pi32Src[I,J] * _pfScale[J] ) + _i32Zero ).
+		 *	For accumulators of A * B with scales sA and sB[J], the output with scale sOut uses _pfScale[J] = sA * sB[J] / sOut.
+		 *
+		 * \tparam _tQ The quantized output type: int8_t or uint8_t.
+		 * \param _pi32Src The accumulators.
+		 * \param _ptDst The quantized output.
+		 * \param _sRows The number of rows.
+		 * \param _sCols The number of columns.
+		 * \param _pfScale The multipliers, 1 per column, or a single multiplier if _bPerChannel is false.
+		 * \param _bPerChannel If true, _pfScale holds 1 multiplier per column.
+		 * \param _i32Zero The output zero point.
+		 **/
+		template <typename _tQ>
+		static void												Requantize( const int32_t * _pi32Src, _tQ * _ptDst, size_t _sRows, size_t _sCols,
+			const float * _pfScale, bool _bPerChannel, int32_t _i32Zero ) {
+			if ( !_bPerChannel ) {
+				const float fScale = (*_pfScale);
+				Parallel( _sRows * _sCols, [=]( size_t _sBegin, size_t _sEnd ) {
+					ScaleToQ<_tQ>( nullptr, _pi32Src + _sBegin, _ptDst + _sBegin, _sEnd - _sBegin, fScale, _i32Zero );
+				} );
+				return;
+			}
+			ThreadPool::Global().ParallelFor( 0, _sRows, std::max<size_t>( 1, NN9_Q_GRAIN / std::max<size_t>( _sCols, 1 ) ), [=]( size_t _sBegin, size_t _sEnd ) {
+				for ( size_t I = _sBegin; I < _sEnd; ++I ) {
+					ScaleToQ<_tQ>( _pfScale, _pi32Src + I * _sCols, _ptDst + I * _sCols, _sCols, 1.0f, _i32Zero );
+				}
+			} );
+		}
+
+		/**
+		 * Quantizes a tensor with a single scale and zero point chosen from its range.
+		 *
+		 * \param _tSrc The tensor to quantize.  It is converted to float first if necessary.
+		 * \param _tType The quantized type: NN9_T_QUINT8 or NN9_T_QINT8.
+		 * \param _bSymmetric If true, the range is made symmetric around 0.
+		 * \throw Throws if _tType is not NN9_T_QUINT8 or NN9_T_QINT8.
+		 * \return Returns a contiguous tensor of type _tType whose QuantizeScale() and QuantizeZero() hold the parameters.
+		 **/
+		static Tensor											QuantizeTensor( const Tensor &_tSrc, NN9_TYPE _tType = NN9_T_QUINT8, bool _bSymmetric = false ) {
+			Tensor tFloat = _tSrc.Type() == NN9_T_FLOAT ? _tSrc.Contiguous() : _tSrc.CopyAs( NN9_T_FLOAT ).Contiguous();
+			const float * pfSrc = tFloat.Strided<float>().Data();
+			const size_t sTotal = tFloat.Strided<float>().size();
+			switch ( _tType ) {
+				case NN9_T_QUINT8 : {
+					NN9_QPARAMS qpParms = ChooseParams<uint8_t>( pfSrc, sTotal, _bSymmetric );
+					Tensor tRet( tFloat.Shape(), tFloat.Strides(), _tType, qpParms.fScale, qpParms.i32Zero );
+					QuantizeLinear( pfSrc, tRet.Strided<uint8_t>().Data(), sTotal, qpParms.fScale, qpParms.i32Zero );
+					return tRet;
+				}
+				case NN9_T_QINT8 : {
+					NN9_QPARAMS qpParms = ChooseParams<int8_t>( pfSrc, sTotal, _bSymmetric );
+					Tensor tRet( tFloat.Shape(), tFloat.Strides(), _tType, qpParms.fScale, qpParms.i32Zero );
+					QuantizeLinear( pfSrc, tRet.Strided<int8_t>().Data(), sTotal, qpParms.fScale, qpParms.i32Zero );
+					return tRet;
+				}
+				default : {
+					throw std::invalid_argument( "Quantize::QuantizeTensor: Type must be NN9_T_QUINT8 or NN9_T_QINT8." );
+				}
+			}
+		}
+
+		/**
+		 * Quantizes a tensor to NN9_T_QINT8 with a symmetric scale per index along 1 axis (per output channel, for weights).  The tensor's
+		 *	own scale is set to 1 and its zero point to 0.
+		 *
+		 * \param _tSrc The tensor to quantize.  It is converted to float first if necessary.
+		 * \param _sAxis The channel axis.
+		 * \param _vScales Receives 1 scale per channel.
+		 * \throw Throws if _sAxis is out of range.
+		 * \return Returns a contiguous NN9_T_QINT8 tensor.
+		 **/
+		static Tensor											QuantizePerChannel( const Tensor &_tSrc, size_t _sAxis, std::vector<float> &_vScales ) {
+			if ( _sAxis >= _tSrc.Shape().size() ) {
+				throw std::invalid_argument( "Quantize::QuantizePerChannel: Axis out of range." );
+			}
+			Tensor tFloat = _tSrc.Type() == NN9_T_FLOAT ? _tSrc.Contiguous() : _tSrc.CopyAs( NN9_T_FLOAT ).Contiguous();
+			const float * pfSrc = tFloat.Strided<float>().Data();
+			const size_t sChannels = tFloat.Shape()[_sAxis], sInner = tFloat.Strides()[_sAxis];
+			const size_t sOuter = tFloat.Strided<float>().size() / std::max<size_t>( sChannels * sInner, 1 );
+
+			std::vector<float> vMax( sChannels, 0.0f );
+			for ( size_t O = 0; O < sOuter; ++O ) {
+				for ( size_t C = 0; C < sChannels; ++C ) {
+					const float * pfThis = pfSrc + (O * sChannels + C) * sInner;
+					for ( size_t I = 0; I < sInner; ++I ) { vMax[C] = std::max( vMax[C], std::abs( pfThis[I] ) ); }
+				}
+			}
+			_vScales.resize( sChannels );
+			for ( size_t C = 0; C < sChannels; ++C ) { _vScales[C] = ChooseParams<int8_t>( -vMax[C], vMax[C], true ).fScale; }
+
+			Tensor tRet( tFloat.Shape(), tFloat.Strides(), NN9_T_QINT8, 1.0, 0.0 );
+			int8_t * pi8Dst = tRet.Strided<int8_t>().Data();
+			ThreadPool::Global().ParallelFor( 0, sOuter * sChannels, 0, [&]( size_t _sBegin, size_t _sEnd ) {
+				for ( size_t R = _sBegin; R < _sEnd; ++R ) {
+					ScaleToQ<int8_t>( nullptr, pfSrc + R * sInner, pi8Dst + R * sInner, sInner, 1.0f / _vScales[R%sChannels], 0 );
+				}
+			} );
+			return tRet;
+		}
+
+		/**
+		 * Dequantizes a tensor using its own scale and zero point.
+		 *
+		 * \param _tSrc The NN9_T_QUINT8, NN9_T_QINT8, or NN9_T_QINT32 tensor.
+		 * \throw Throws if _tSrc is not a quantized type.
+		 * \return Returns a contiguous NN9_T_FLOAT tensor.
+		 **/
+		static Tensor											Dequantize( const Tensor &_tSrc ) {
+			Tensor tQ = _tSrc.Contiguous();
+			Tensor tRet( tQ.Shape(), tQ.Strides(), NN9_T_FLOAT, 1.0, 0.0 );
+			float * pfDst = tRet.Strided<float>().Data();
+			const float fScale = float( tQ.QuantizeScale() );
+			const int32_t i32Zero = int32_t( tQ.QuantizeZero() );
+			switch ( tQ.Type() ) {
+				case NN9_T_QUINT8 : { DequantizeLinear( tQ.Strided<uint8_t>().Data(), pfDst, tQ.Strided<uint8_t>().size(), fScale, i32Zero ); break; }
+				case NN9_T_QINT8 : { DequantizeLinear( tQ.Strided<int8_t>().Data(), pfDst, tQ.Strided<int8_t>().size(), fScale, i32Zero ); break; }
+				case NN9_T_QINT32 : { DequantizeLinear( tQ.Strided<int32_t>().Data(), pfDst, tQ.Strided<int32_t>().size(), fScale, i32Zero ); break; }
+				default : {
+					throw std::invalid_argument( "Quantize::Dequantize: Tensor must be NN9_T_QUINT8, NN9_T_QINT8, or NN9_T_QINT32." );
+				}
+			}
+			return tRet;
+		}
+
+		/**
+		 * Dequantizes an NN9_T_QINT8 tensor made by QuantizePerChannel().
+		 *
+		 * \param _tSrc The NN9_T_QINT8 tensor.
+		 * \param _sAxis The channel axis.
+		 * \param _vScales 1 scale per channel.
+		 * \throw Throws if _tSrc is not NN9_T_QINT8 or the scales do not match the axis.
+		 * \return Returns a contiguous NN9_T_FLOAT tensor.
+		 **/
+		static Tensor											Dequantize( const Tensor &_tSrc, size_t _sAxis, const std::vector<float> &_vScales ) {
+			if ( _tSrc.Type() != NN9_T_QINT8 ) {
+				throw std::invalid_argument( "Quantize::Dequantize: Tensor must be NN9_T_QINT8." );
+			}
+			if ( _sAxis >= _tSrc.Shape().size() || _vScales.size() != _tSrc.Shape()[_sAxis] ) {
+				throw std::invalid_argument( "Quantize::Dequantize: There must be 1 scale per index along the axis." );
+			}
+			Tensor tQ = _tSrc.Contiguous();
+			Tensor tRet( tQ.Shape(), tQ.Strides(), NN9_T_FLOAT, 1.0, 0.0 );
+			const int8_t * pi8Src = tQ.Strided<int8_t>().Data();
+			float * pfDst = tRet.Strided<float>().Data();
+			const size_t sChannels = _vScales.size(), sInner = tQ.Strides()[_sAxis];
+			const size_t sRows = tQ.Strided<int8_t>().size() / std::max<size_t>( sInner, 1 );
+			ThreadPool::Global().ParallelFor( 0, sRows, 0, [&]( size_t _sBegin, size_t _sEnd ) {
+				for ( size_t R = _sBegin; R < _sEnd; ++R ) {
+					const float fScale = _vScales[R%sChannels];
+					for ( size_t I = 0; I < sInner; ++I ) { pfDst[R*sInner+I] = float( pi8Src[R*sInner+I] ) * fScale; }
+				}
+			} );
+			return tRet;
+		}
+
+
+	protected :
+		// == Functions.
+		/**
+		 * Runs a function over [0, _sTotal) in NN9_Q_GRAIN subranges on the ThreadPool, or directly when the range is small.
+		 *
+		 * \tparam _tFunc The function type, called as _fFunc( size_t _sBegin, size_t _sEnd ).
+		 * \param _sTotal The size of the range.
+		 * \param _fFunc The function.
+		 **/
+		template <typename _tFunc>
+		static void												Parallel( size_t _sTotal, const _tFunc &_fFunc ) {
+			if ( _sTotal <= NN9_Q_GRAIN ) { _fFunc( 0, _sTotal ); }
+			else { ThreadPool::Global().ParallelFor( 0, _sTotal, NN9_Q_GRAIN, _fFunc ); }
+		}
+
+		/**
+		 * Scales values and converts them to a quantized type: _ptDst[I] = clamp( round( _ptSrc[I] * _fScale * _pfScale[I] ) + _i32Zero ).
+		 *	The value is clamped before rounding, as a float, so that overflow and NaN do not reach the integer conversion.
+		 *
+		 * \tparam _tQ The quantized type: int8_t or uint8_t.
+		 * \tparam _tSrc The source type: float or int32_t.
+		 * \param _pfScale Per-element multipliers, or nullptr for none.
+		 * \param _ptSrc The source values.
+		 * \param _ptDst The quantized output.
+		 * \param _sTotal The number of values.
+		 * \param _fScale The multiplier applied to every value.
+		 * \param _i32Zero The zero point.
+		 **/
+		template <typename _tQ, typename _tSrc>
+		static void												ScaleToQ( const float * _pfScale, const _tSrc * _ptSrc, _tQ * _ptDst, size_t _sTotal, float _fScale, int32_t _i32Zero ) {
+			const Kernels::NN9_TABLE & tTable = Kernels::Table();
+			constexpr Kernels::NN9_KERNEL_TYPE ktType = Math::KernelType<_tQ>();
+			if constexpr ( std::is_same<_tSrc, float>::value ) {
+				if ( tTable.pfQuantizeF32[ktType] ) { tTable.pfQuantizeF32[ktType]( _pfScale, _ptSrc, _ptDst, _sTotal, _fScale, _i32Zero ); return; }
+			}
+			else {
+				if ( tTable.pfQuantizeI32[ktType] ) { tTable.pfQuantizeI32[ktType]( _pfScale, _ptSrc, _ptDst, _sTotal, _fScale, _i32Zero ); return; }
+			}
+			const float fLo = float( Min<_tQ>() - _i32Zero ), fHi = float( Max<_tQ>() - _i32Zero );
+			for ( size_t I = 0; I < _sTotal; ++I ) {
+				// Mirrors maxps/minps, which return the second operand when either is NaN.
+				float fVal = float( _ptSrc[I] ) * _fScale;
+				if ( _pfScale ) { fVal *= _pfScale[I]; }
+				fVal = fVal > fLo ? fVal : fLo;
+				fVal = fVal < fHi ? fVal : fHi;
+				_ptDst[I] = _tQ( int32_t( std::nearbyint( fVal ) ) + _i32Zero );
+			}
+		}
+	};
+
+}	// namespace nn9
@@ -0,0 +1,648 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Fused softmax, log-softmax, and log-sum-exp.  Each row is reduced to its maximum and the sum of exponentials in 1 or 2
+ *	passes and then written in 1 more, with SIMD exp() and float or double internals, spreading rows over the ThreadPool.
+ */
+
+#pragma once
+
+#include "NN9Math.h"
+#include "../Foundation/NN9Kernels.h"
+#include "../Tensor/NN9StridedView.h"
+#include "../Tensor/NN9Tensor.h"
+#include "../Types/NN9BFloat16.h"
+#include "../Types/NN9Float16.h"
+#include "../Types/NN9Types.h"
+#include "../Utilities/NN9ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+
+namespace nn9 {
+
+	/**
+	 * Class Softmax
+	 * \brief Fused softmax, log-softmax, and log-sum-exp.
+	 *
+	 * Description: Fused softmax, log-softmax, and log-sum-exp along 1 axis.  Rather than separate max, subtract, exp, sum, and divide passes
+	 *	over the whole tensor, each row is finished while it is in cache.  Rows of up to NN9_S_CACHE_COLS elements find their maximum first and
+	 *	then exponentiate each element once, keeping the exponentials for the final scale.  Longer rows keep a running maximum per lane and
+	 *	rescale the running sum whenever the maximum grows, so that the input is streamed from memory once before the output is written.
+	 *	float16 and bfloat16_t are widened to float on load and narrowed once on store; double is computed in double.
+	 */
+	class Softmax {
+	public :
+		// == Enumerations.
+		/** The operations. */
+		enum NN9_SOFTMAX_OP : size_t {
+			NN9_SO_SOFTMAX,																				/**< exp( x - max ) / sum( exp( x - max ) ). */
+			NN9_SO_LOG_SOFTMAX,																			/**< x - log( sum( exp( x ) ) ). */
+			NN9_SO_LOG_SUM_EXP,																			/**< log( sum( exp( x ) ) ), 1 value per row. */
+		};
+
+		/** Tuning constants. */
+		enum NN9_SOFTMAX : size_t {
+			NN9_S_CACHE_COLS					= 16384,								/**< Rows up to this long are read again from cache instead of rescaled online. */
+			NN9_S_PARALLEL_GRAIN				= 16384,								/**< The fewest elements given to each thread. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Runs an operation over each row of a matrix.  Rows and columns are addressed by strides in elements, so any axis of a tensor can be
+		 *	passed as the row.  For NN9_SO_LOG_SUM_EXP, the output has 1 element per row and _sColOut is ignored.
+		 *
+		 * \tparam _tType The element type: float, double, bfloat16_t, or nn9::float16.
+		 * \param _soOp The operation.
+		 * \param _sRows The number of rows.
+		 * \param _sCols The number of elements in each row.
+		 * \param _ptIn The first element of the input.
+		 * \param _sRowIn The distance between input rows.
+		 * \param _sColIn The distance between input columns.
+		 * \param _ptOut The first element of the output.
+		 * \param _sRowOut The distance between output rows.
+		 * \param _sColOut The distance between output columns.
+		 **/
+		template <typename _tType>
+		static void													Rows( NN9_SOFTMAX_OP _soOp, size_t _sRows, size_t _sCols,
+			const _tType * _ptIn, size_t _sRowIn, size_t _sColIn,
+			_tType * _ptOut, size_t _sRowOut, size_t _sColOut ) {
+			static_assert( Types::SimdFloat<_tType>() || Types::SimdDouble<_tType>(), "Softmax::Rows: The type must be float, double, bfloat16_t, or nn9::float16." );
+			using Scalar = typename std::conditional<Types::SimdDouble<_tType>(), double, float>::type;
+			if ( !_sRows ) { return; }
+			if ( NN9_ISA_TABLE<Scalar>::Kernel() ) {
+				return Dispatch<NN9_ISA_TABLE<Scalar>>( _soOp, _sRows, _sCols, _ptIn, _sRowIn, _sColIn, _ptOut, _sRowOut, _sColOut );
+			}
+			Dispatch<NN9_ISA_SCALAR<Scalar>>( _soOp, _sRows, _sCols, _ptIn, _sRowIn, _sColIn, _ptOut, _sRowOut, _sColOut );
+		}
+
+		/**
+		 * Computes the softmax along 1 axis.  _svOut has the same shape as _svIn and may be the same view.
+		 *
+		 * \tparam _tType The element type: float, double, bfloat16_t, or nn9::float16.
+		 * \param _svIn The input.
+		 * \param _svOut The output.
+		 * \param _sAxis The axis along which the values sum to 1.
+		 * \throw Throws if the shapes do not match, the axis is invalid, or _svOut has overlapping elements.
+		 * \return Returns _svOut.
+		 **/
+		template <typename _tType>
+		static StridedView<_tType> &								Forward( const StridedView<_tType> &_svIn, StridedView<_tType> &_svOut, size_t _sAxis ) {
+			return Apply( NN9_SO_SOFTMAX, _svIn, _svOut, _sAxis );
+		}
+
+		/**
+		 * Computes the log-softmax along 1 axis.  _svOut has the same shape as _svIn and may be the same view.
+		 *
+		 * \tparam _tType The element type: float, double, bfloat16_t, or nn9::float16.
+		 * \param _svIn The input.
+		 * \param _svOut The output.
+		 * \param _sAxis The axis along which the exponentials of the values sum to 1.
+		 * \throw Throws if the shapes do not match, the axis is invalid, or _svOut has overlapping elements.
+		 * \return Returns _svOut.
+		 **/
+		template <typename _tType>
+		static StridedView<_tType> &								LogForward( const StridedView<_tType> &_svIn, StridedView<_tType> &_svOut, size_t _sAxis ) {
+			return Apply( NN9_SO_LOG_SOFTMAX, _svIn, _svOut, _sAxis );
+		}
+
+		/**
+		 * Computes log( sum( exp( x ) ) ) along 1 axis.  _svOut has the shape of _svIn with the axis either removed or set to 1.
+		 *
+		 * \tparam _tType The element type: float, double, bfloat16_t, or nn9::float16.
+		 * \param _svIn The input.
+		 * \param _svOut The output.
+		 * \param _sAxis The axis to reduce.
+		 * \throw Throws if the shapes do not match, the axis is invalid, or _svOut has overlapping elements.
+		 * \return Returns _svOut.
+		 **/
+		template <typename _tType>
+		static StridedView<_tType> &								LogSumExp( const StridedView<_tType> &_svIn, StridedView<_tType> &_svOut, size_t _sAxis ) {
+			return Apply( NN9_SO_LOG_SUM_EXP, _svIn, _svOut, _sAxis );
+		}
+
+		/**
+		 * Computes the softmax along 1 axis of a tensor.  Both tensors must have the same type, which must be NN9_T_FLOAT, NN9_T_DOUBLE,
+		 *	NN9_T_BFLOAT16, or NN9_T_FLOAT16.
+		 *
+		 * \param _tIn The input.
+		 * \param _tOut The output.
+		 * \param _sAxis The axis along which the values sum to 1.
+		 * \throw Throws if the types are not supported or do not match, or if the shapes do not match.
+		 * \return Returns _tOut.
+		 **/
+		static Tensor &												Forward( Tensor &_tIn, Tensor &_tOut, size_t _sAxis ) { return Apply( NN9_SO_SOFTMAX, _tIn, _tOut, _sAxis ); }
+
+		/**
+		 * Computes the log-softmax along 1 axis of a tensor.  Both tensors must have the same type, which must be NN9_T_FLOAT, NN9_T_DOUBLE,
+		 *	NN9_T_BFLOAT16, or NN9_T_FLOAT16.
+		 *
+		 * \param _tIn The input.
+		 * \param _tOut The output.
+		 * \param _sAxis The axis along which the exponentials of the values sum to 1.
+		 * \throw Throws if the types are not supported or do not match, or if the shapes do not match.
+		 * \return Returns _tOut.
+		 **/
+		static Tensor &												LogForward( Tensor &_tIn, Tensor &_tOut, size_t _sAxis ) { return Apply( NN9_SO_LOG_SOFTMAX, _tIn, _tOut, _sAxis ); }
+
+		/**
+		 * Computes log( sum( exp( x ) ) ) along 1 axis of a tensor.  Both tensors must have the same type, which must be NN9_T_FLOAT,
+		 *	NN9_T_DOUBLE, NN9_T_BFLOAT16, or NN9_T_FLOAT16.
+		 *
+		 * \param _tIn The input.
+		 * \param _tOut The output, with the axis removed or set to 1.
+		 * \param _sAxis The axis to reduce.
+		 * \throw Throws if the types are not supported or do not match, or if the shapes do not match.
+		 * \return Returns _tOut.
+		 **/
+		static Tensor &												LogSumExp( Tensor &_tIn, Tensor &_tOut, size_t _sAxis ) { return Apply( NN9_SO_LOG_SUM_EXP, _tIn, _tOut, _sAxis ); }
+
+
+	protected :
+		// == Types.
+		/** Scalar registers.  Every ISA provides the same members so that 1 set of row kernels serves them all. */
+		template <typename _tScalar>
+		struct NN9_ISA_SCALAR {
+			typedef _tScalar								Scalar;
+			typedef _tScalar								Reg;
+			static constexpr size_t							Lanes = 1;
+			static constexpr bool							FromTable = false;
+
+			template <typename _tType>
+			static inline Reg								Load( const _tType * _ptSrc ) { return static_cast<Scalar>(*_ptSrc); }
+			template <typename _tType>
+			static inline void								Store( _tType * _ptDst, Reg _rVal ) { (*_ptDst) = static_cast<_tType>(_rVal); }
+			static inline Reg								Set1( Scalar _sVal ) { return _sVal; }
+			static inline Reg								Add( Reg _rA, Reg _rB ) { return _rA + _rB; }
+			static inline Reg								Sub( Reg _rA, Reg _rB ) { return _rA - _rB; }
+			static inline Reg								Mul( Reg _rA, Reg _rB ) { return _rA * _rB; }
+			static inline Reg								Max( Reg _rA, Reg _rB ) { return _rA > _rB ? _rA : _rB; }
+			static inline Reg								Exp( Reg _rA ) { return std::exp( _rA ); }
+			/** Replaces -inf lanes with 0. */
+			static inline Reg								FiniteOrZero( Reg _rA ) { return _rA == -std::numeric_limits<Scalar>::infinity() ? Scalar( 0 ) : _rA; }
+			static inline Scalar							HMax( Reg _rA ) { return _rA; }
+			static inline Scalar							HAdd( Reg _rA ) { return _rA; }
+		};
+
+		/**
+		 * Rows through Kernels::Table().  Each row goes whole to the table's pfSoftmaxF32 or pfSoftmaxF64 once it is contiguous in Scalar, so
+		 *	float16 and bfloat16_t rows are widened through pfToF32 and narrowed through pfFromF32; the members of NN9_ISA_SCALAR serve nothing
+		 *	else.
+		 */
+		template <typename _tScalar>
+		struct NN9_ISA_TABLE : public NN9_ISA_SCALAR<_tScalar> {
+			static constexpr bool							FromTable = true;
+			static_assert( size_t( NN9_SO_SOFTMAX ) == size_t( Kernels::NN9_KS_SOFTMAX ) && size_t( NN9_SO_LOG_SOFTMAX ) == size_t( Kernels::NN9_KS_LOG_SOFTMAX ) &&
+				size_t( NN9_SO_LOG_SUM_EXP ) == size_t( Kernels::NN9_KS_LOG_SUM_EXP ), "Softmax::NN9_ISA_TABLE: NN9_SOFTMAX_OP and Kernels::NN9_KERNEL_SOFTMAX must match." );
+
+			/** Gets the row kernel. */
+			static inline auto								Kernel() {
+				if constexpr ( std::is_same<_tScalar, double>::value ) { return Kernels::Table().pfSoftmaxF64; }
+				else { return Kernels::Table().pfSoftmaxF32; }
+			}
+		};
+
+
+		// == Functions.
+		/**
+		 * Checks the shapes of a tensor operation and runs it over every row along the axis.
+		 *
+		 * \tparam _tType The element type.
+		 * \param _soOp The operation.
+		 * \param _svIn The input.
+		 * \param _svOut The output.
+		 * \param _sAxis The axis along which each row runs.
+		 * \throw Throws if the shapes do not match, the axis is invalid, or _svOut has overlapping elements.
+		 * \return Returns _svOut.
+		 **/
+		template <typename _tType>
+		static StridedView<_tType> &								Apply( NN9_SOFTMAX_OP _soOp, const StridedView<_tType> &_svIn, StridedView<_tType> &_svOut, size_t _sAxis ) {
+			const auto & vShape = _svIn.Shape();
+			const auto & vShapeO = _svOut.Shape();
+			if ( _sAxis >= vShape.size() ) { throw std::out_of_range( "Softmax::Apply: Invalid axis." ); }
+			if ( _svOut.Overlaps() ) { throw std::invalid_argument( "Softmax::Apply: Cannot write to an expanded view." ); }
+
+			// The output strides of the dimensions other than the axis, in the order of the input dimensions.
+			std::vector<size_t> vStridesO;
+			size_t sColOut = 0;
+			if ( _soOp == NN9_SO_LOG_SUM_EXP ) {
+				const bool bKeep = vShapeO.size() == vShape.size();
+				if ( !bKeep && vShapeO.size() + 1 != vShape.size() ) { throw std::invalid_argument( "Softmax::Apply: The output must have the input shape without the axis." ); }
+				for ( size_t I = 0, J = 0; I < vShape.size(); ++I ) {
+					if ( I == _sAxis ) {
+						if ( bKeep && vShapeO[J++] != 1 ) { throw std::invalid_argument( "Softmax::Apply: The output must have the input shape without the axis." ); }
+						continue;
+					}
+					if ( vShapeO[J] != vShape[I] ) { throw std::invalid_argument( "Softmax::Apply: The output must have the input shape without the axis." ); }
+					vStridesO.push_back( _svOut.Strides()[J++] );
+				}
+			}
+			else {
+				if ( vShapeO != vShape ) { throw std::invalid_argument( "Softmax::Apply: The input and output must have the same shape." ); }
+				for ( size_t I = 0; I < vShape.size(); ++I ) {
+					if ( I != _sAxis ) { vStridesO.push_back( _svOut.Strides()[I] ); }
+				}
+				sColOut = _svOut.Strides()[_sAxis];
+			}
+
+			// Rows are numbered over the dimensions other than the axis.  The innermost of those is passed to Rows() as its row stride and the
+			//	rest are walked here.
+			std::vector<size_t> vShapeR, vStridesI;
+			for ( size_t I = 0; I < vShape.size(); ++I ) {
+				if ( I != _sAxis ) {
+					vShapeR.push_back( vShape[I] );
+					vStridesI.push_back( _svIn.Strides()[I] );
+				}
+			}
+			const size_t sCols = vShape[_sAxis], sColIn = _svIn.Strides()[_sAxis];
+			size_t sInner = 1, sRowIn = 0, sRowOut = 0;
+			if ( vShapeR.size() ) {
+				sInner = vShapeR.back();
+				sRowIn = vStridesI.back();
+				sRowOut = vStridesO.back();
+				vShapeR.pop_back();
+			}
+			size_t sOuter = 1;
+			for ( auto sDim : vShapeR ) { sOuter *= sDim; }
+			for ( size_t O = 0; O < sOuter; ++O ) {
+				size_t sOffI = 0, sOffO = 0, sIdx = O;
+				for ( size_t I = vShapeR.size(); I--; ) {
+					const size_t sThis = sIdx % vShapeR[I];
+					sIdx /= vShapeR[I];
+					sOffI += sThis * vStridesI[I];
+					sOffO += sThis * vStridesO[I];
+				}
+				Rows<_tType>( _soOp, sInner, sCols, _svIn.Data() + sOffI, sRowIn, sColIn, _svOut.Data() + sOffO, sRowOut, sColOut );
+			}
+			return _svOut;
+		}
+
+		/**
+		 * Runs a tensor operation on the tensors' element type.
+		 *
+		 * \param _soOp The operation.
+		 * \param _tIn The input.
+		 * \param _tOut The output.
+		 * \param _sAxis The axis along which each row runs.
+		 * \throw Throws if the types are not supported or do not match, or if the shapes do not match.
+		 * \return Returns _tOut.
+		 **/
+		static Tensor &												Apply( NN9_SOFTMAX_OP _soOp, Tensor &_tIn, Tensor &_tOut, size_t _sAxis ) {
+			if ( _tIn.Type() != _tOut.Type() ) {
+				throw std::invalid_argument( "Softmax::Apply: Both tensors must have the same type." );
+			}
+#define NN9_SOFTMAX_APPLY( CASE, TYPE )																								\
+	case CASE : {																													\
+		auto svOut = _tOut.Strided<TYPE>();																							\
+		Apply<TYPE>( _soOp, _tIn.Strided<TYPE>(), svOut, _sAxis );																	\
+		return _tOut;																												\
+	}
+			switch ( _tIn.Type() ) {
+				NN9_SOFTMAX_APPLY( NN9_T_FLOAT, float )
+				NN9_SOFTMAX_APPLY( NN9_T_DOUBLE, double )
+				NN9_SOFTMAX_APPLY( NN9_T_BFLOAT16, bfloat16_t )
+				NN9_SOFTMAX_APPLY( NN9_T_FLOAT16, nn9::float16 )
+				default : {
+					throw std::invalid_argument( "Softmax::Apply: Unsupported tensor type." );
+				}
+			}
+#undef NN9_SOFTMAX_APPLY
+		}
+
+		/**
+		 * Runs an operation over each row with the given registers, spreading the rows over the ThreadPool.  Rows that are not contiguous, or
+		 *	that the table needs in a wider type, are gathered into Scalar first and their results scattered afterwards.
+		 *
+		 * \tparam _tIsa The register traits.
+		 * \tparam _tType The element type.
+		 * \param _soOp The operation.
+		 * \param _sRows The number of rows.
+		 * \param _sCols The number of elements in each row.
+		 * \param _ptIn The first element of the input.
+		 * \param _sRowIn The distance between input rows.
+		 * \param _sColIn The distance between input columns.
+		 * \param _ptOut The first element of the output.
+		 * \param _sRowOut The distance between output rows.
+		 * \param _sColOut The distance between output columns.
+		 **/
+		template <typename _tIsa, typename _tType>
+		static void													Dispatch( NN9_SOFTMAX_OP _soOp, size_t _sRows, size_t _sCols,
+			const _tType * _ptIn, size_t _sRowIn, size_t _sColIn,
+			_tType * _ptOut, size_t _sRowOut, size_t _sColOut ) {
+			using Scalar = typename _tIsa::Scalar;
+			constexpr bool bWiden = _tIsa::FromTable && !std::is_same<_tType, Scalar>::value;
+			const bool bGatherIn = bWiden || (_sColIn != 1 && _sCols > 1);
+			const bool bScatterOut = bWiden || (_soOp != NN9_SO_LOG_SUM_EXP && _sColOut != 1 && _sCols > 1);
+			const size_t sColsOut = _soOp == NN9_SO_LOG_SUM_EXP ? 1 : _sCols;
+			// A softmax keeps the exponentials of a short row for the final scale.  They are written straight to the output if it holds Scalar.
+			const bool bKeepExp = _soOp == NN9_SO_SOFTMAX && _sCols <= NN9_S_CACHE_COLS;
+			const bool bExpInOut = bKeepExp && !bScatterOut && std::is_same<_tType, Scalar>::value;
+
+			auto aRows = [&]( size_t _sBegin, size_t _sEnd ) {
+				std::vector<Scalar> vIn( bGatherIn ? _sCols : 0 ), vOut( bScatterOut ? sColsOut : 0 ), vExp( (bKeepExp && !bExpInOut) ? _sCols : 0 );
+				for ( size_t R = _sBegin; R < _sEnd; ++R ) {
+					const _tType * ptIn = _ptIn + R * _sRowIn;
+					_tType * ptOut = _ptOut + R * _sRowOut;
+					if ( bGatherIn ) {
+						if constexpr ( bWiden ) {
+							if ( _sColIn == 1 ) { Kernels::Table().pfToF32[Math::KernelType<_tType>()]( ptIn, vIn.data(), _sCols ); }
+						}
+						if ( !bWiden || _sColIn != 1 ) {
+							for ( size_t I = 0; I < _sCols; ++I ) { vIn[I] = static_cast<Scalar>(ptIn[I*_sColIn]); }
+						}
+						Row<_tIsa>( _soOp, vIn.data(), _sCols, ptOut, vOut.data(), vExp.data(), bScatterOut, bExpInOut );
+					}
+					else if constexpr ( !bWiden ) {
+						Row<_tIsa>( _soOp, ptIn, _sCols, ptOut, vOut.data(), vExp.data(), bScatterOut, bExpInOut );
+					}
+					if ( bScatterOut ) {
+						if constexpr ( bWiden ) {
+							if ( _sColOut == 1 || sColsOut == 1 ) { Kernels::Table().pfFromF32[Math::KernelType<_tType>()]( vOut.data(), ptOut, sColsOut ); }
+						}
+						if ( !bWiden || (_sColOut != 1 && sColsOut != 1) ) {
+							for ( size_t I = 0; I < sColsOut; ++I ) { ptOut[I*_sColOut] = static_cast<_tType>(vOut[I]); }
+						}
+					}
+				}
+			};
+			const size_t sGrain = std::max<size_t>( 1, NN9_S_PARALLEL_GRAIN / std::max<size_t>( 1, _sCols ) );
+			if ( _sRows > sGrain ) { ThreadPool::Global().ParallelFor( 0, _sRows, sGrain, aRows ); }
+			else { aRows( 0, _sRows ); }
+		}
+
+		/**
+		 * Runs an operation over 1 contiguous row.
+		 *
+		 * \tparam _tIsa The register traits.
+		 * \tparam _tIn The input type: the element type, or Scalar if the row was gathered.
+		 * \tparam _tType The element type.
+		 * \param _soOp The operation.
+		 * \param _ptIn The row.
+		 * \param _sCols The number of elements in the row.
+		 * \param _ptOut The output row, or the output value for NN9_SO_LOG_SUM_EXP.
+		 * \param _psScatter The contiguous output if _bScatter.
+		 * \param _psExp Scratch for the exponentials of a softmax of at most NN9_S_CACHE_COLS elements, unless _bExpInOut.
+		 * \param _bScatter If true, the row is written to _psScatter instead of _ptOut.
+		 * \param _bExpInOut If true, the exponentials of a softmax are kept in _ptOut.
+		 **/
+		template <typename _tIsa, typename _tIn, typename _tType>
+		static void													Row( NN9_SOFTMAX_OP _soOp, const _tIn * _ptIn, size_t _sCols, _tType * _ptOut,
+			typename _tIsa::Scalar * _psScatter, typename _tIsa::Scalar * _psExp, bool _bScatter, bool _bExpInOut ) {
+			using Scalar = typename _tIsa::Scalar;
+			if constexpr ( _tIsa::FromTable ) {
+				Scalar * psOut = _psScatter;
+				if constexpr ( std::is_same<_tType, Scalar>::value ) {
+					if ( !_bScatter ) { psOut = _ptOut; }
+				}
+				_tIsa::Kernel()( static_cast<Kernels::NN9_KERNEL_SOFTMAX>(_soOp), _ptIn, _sCols, psOut, _sCols > NN9_S_CACHE_COLS );
+				return;
+			}
+			constexpr Scalar sInf = std::numeric_limits<Scalar>::infinity();
+			Scalar sMax, sSum;
+			Scalar * psExp = nullptr;
+			if ( _soOp == NN9_SO_SOFTMAX && _sCols <= NN9_S_CACHE_COLS ) {
+				psExp = _bExpInOut ? reinterpret_cast<Scalar *>(_ptOut) : _psExp;
+			}
+			if ( _sCols <= NN9_S_CACHE_COLS ) {
+				sMax = RowMax<_tIsa>( _ptIn, _sCols );
+				sSum = RowSumExp<_tIsa>( _ptIn, _sCols, sMax, psExp );
+			}
+			else { RowOnline<_tIsa>( _ptIn, _sCols, sMax, sSum ); }
+
+			// An empty row or a row of -inf sums to 0 (Max() drops NaN, which instead reaches the sum).
+			const bool bZero = sMax == -sInf && sSum == sSum;
+			if ( _soOp == NN9_SO_LOG_SUM_EXP ) {
+				(*_ptOut) = static_cast<_tType>(bZero ? -sInf : sMax + std::log( sSum ));
+				return;
+			}
+			// Such a row has no defined softmax.
+			const Scalar sNan = std::numeric_limits<Scalar>::quiet_NaN();
+			if ( _soOp == NN9_SO_SOFTMAX ) {
+				const Scalar sScale = bZero ? sNan : Scalar( 1 ) / sSum;
+				if ( _bScatter ) {
+					if ( psExp ) { RowScale<_tIsa>( psExp, _sCols, sScale, _psScatter ); }
+					else { RowExpScale<_tIsa>( _ptIn, _sCols, sMax, sScale, _psScatter ); }
+				}
+				else {
+					if ( psExp ) { RowScale<_tIsa>( psExp, _sCols, sScale, _ptOut ); }
+					else { RowExpScale<_tIsa>( _ptIn, _sCols, sMax, sScale, _ptOut ); }
+				}
+			}
+			else {
+				const Scalar sLse = bZero ? sNan : sMax + std::log( sSum );
+				if ( _bScatter ) { RowSubtract<_tIsa>( _ptIn, _sCols, sLse, _psScatter ); }
+				else { RowSubtract<_tIsa>( _ptIn, _sCols, sLse, _ptOut ); }
+			}
+		}
+
+		/**
+		 * Replaces -inf with 0.  Subtracting it instead of a maximum of -inf keeps exp( -inf - max ) at 0 rather than NaN.
+		 *
+		 * \tparam _tScalar The value type.
+		 * \param _sVal The value.
+		 * \return Returns 0 if _sVal is -inf, otherwise _sVal.
+		 **/
+		template <typename _tScalar>
+		static inline _tScalar										FiniteOrZero( _tScalar _sVal ) { return _sVal == -std::numeric_limits<_tScalar>::infinity() ? _tScalar( 0 ) : _sVal; }
+
+		/**
+		 * Finds the largest value in a row.  NaN values propagate through the sum instead.
+		 *
+		 * \tparam _tIsa The register traits.
+		 * \tparam _tIn The input type.
+		 * \param _ptIn The row.
+		 * \param _sCols The number of elements in the row.
+		 * \return Returns the largest value, or -inf for an empty row.
+		 **/
+		template <typename _tIsa, typename _tIn>
+		static typename _tIsa::Scalar								RowMax( const _tIn * _ptIn, size_t _sCols ) {
+			using Scalar = typename _tIsa::Scalar;
+			constexpr size_t L = _tIsa::Lanes;
+			Scalar sMax = -std::numeric_limits<Scalar>::infinity();
+			size_t I = 0;
+			if ( _sCols >= L ) {
+				auto rMax0 = _tIsa::Load( _ptIn ), rMax1 = rMax0;
+				for ( I = L; I + 2 * L <= _sCols; I += 2 * L ) {
+					rMax0 = _tIsa::Max( rMax0, _tIsa::Load( _ptIn + I ) );
+					rMax1 = _tIsa::Max( rMax1, _tIsa::Load( _ptIn + I + L ) );
+				}
+				for ( ; I + L <= _sCols; I += L ) { rMax0 = _tIsa::Max( rMax0, _tIsa::Load( _ptIn + I ) ); }
+				sMax = _tIsa::HMax( _tIsa::Max( rMax0, rMax1 ) );
+			}
+			for ( ; I < _sCols; ++I ) {
+				const Scalar sVal = static_cast<Scalar>(_ptIn[I]);
+				sMax = sVal > sMax ? sVal : sMax;
+			}
+			return sMax;
+		}
+
+		/**
+		 * Sums exp( x - max ) over a row, optionally keeping each exponential.
+		 *
+		 * \tparam _tIsa The register traits.
+		 * \tparam _tIn The input type.
+		 * \param _ptIn The row.
+		 * \param _sCols The number of elements in the row.
+		 * \param _sMax The largest value in the row.
+		 * \param _psExp If not nullptr, receives each exponential.
+		 * \return Returns the sum.
+		 **/
+		template <typename _tIsa, typename _tIn>
+		static typename _tIsa::Scalar								RowSumExp( const _tIn * _ptIn, size_t _sCols, typename _tIsa::Scalar _sMax, typename _tIsa::Scalar * _psExp ) {
+			using Scalar = typename _tIsa::Scalar;
+			constexpr size_t L = _tIsa::Lanes;
+			// A row of -inf subtracts 0 so that its exponentials are 0 rather than NaN.
+			const Scalar sMax = FiniteOrZero( _sMax );
+			const auto rMax = _tIsa::Set1( sMax );
+			auto rSum0 = _tIsa::Set1( Scalar( 0 ) ), rSum1 = rSum0;
+			size_t I = 0;
+			for ( ; I + 2 * L <= _sCols; I += 2 * L ) {
+				const auto rE0 = _tIsa::Exp( _tIsa::Sub( _tIsa::Load( _ptIn + I ), rMax ) );
+				const auto rE1 = _tIsa::Exp( _tIsa::Sub( _tIsa::Load( _ptIn + I + L ), rMax ) );
+				if ( _psExp ) {
+					_tIsa::Store( _psExp + I, rE0 );
+					_tIsa::Store( _psExp + I + L, rE1 );
+				}
+				rSum0 = _tIsa::Add( rSum0, rE0 );
+				rSum1 = _tIsa::Add( rSum1, rE1 );
+			}
+			for ( ; I + L <= _sCols; I += L ) {
+				const auto rE = _tIsa::Exp( _tIsa::Sub( _tIsa::Load( _ptIn + I ), rMax ) );
+				if ( _psExp ) { _tIsa::Store( _psExp + I, rE ); }
+				rSum0 = _tIsa::Add( rSum0, rE );
+			}
+			Scalar sSum = _tIsa::HAdd( _tIsa::Add( rSum0, rSum1 ) );
+			for ( ; I < _sCols; ++I ) {
+				const Scalar sE = std::exp( static_cast<Scalar>(_ptIn[I]) - sMax );
+				if ( _psExp ) { _psExp[I] = sE; }
+				sSum += sE;
+			}
+			return sSum;
+		}
+
+		/**
+		 * Finds the largest value in a row and the sum of exp( x - max ) in 1 pass.  Each lane keeps its own maximum and sum, and when a block
+		 *	of registers raises the maximum, the sum is multiplied by exp( old - new ) once for the whole block.
+		 *
+		 * \tparam _tIsa The register traits.
+		 * \tparam _tIn The input type.
+		 * \param _ptIn The row.
+		 * \param _sCols The number of elements in the row.
+		 * \param _sMax Holds the returned maximum.
+		 * \param _sSum Holds the returned sum.
+		 **/
+		template <typename _tIsa, typename _tIn>
+		static void													RowOnline( const _tIn * _ptIn, size_t _sCols, typename _tIsa::Scalar &_sMax, typename _tIsa::Scalar &_sSum ) {
+			using Scalar = typename _tIsa::Scalar;
+			constexpr size_t L = _tIsa::Lanes;
+			auto rMax = _tIsa::Set1( -std::numeric_limits<Scalar>::infinity() );
+			auto rSum = _tIsa::Set1( Scalar( 0 ) );
+			size_t I = 0;
+			for ( ; I + 4 * L <= _sCols; I += 4 * L ) {
+				const auto rX0 = _tIsa::Load( _ptIn + I ), rX1 = _tIsa::Load( _ptIn + I + L );
+				const auto rX2 = _tIsa::Load( _ptIn + I + 2 * L ), rX3 = _tIsa::Load( _ptIn + I + 3 * L );
+				const auto rNew = _tIsa::Max( rMax, _tIsa::Max( _tIsa::Max( rX0, rX1 ), _tIsa::Max( rX2, rX3 ) ) );
+				// Lanes still at -inf subtract 0 so that exp() gives 0 rather than NaN.
+				const auto rSafe = _tIsa::FiniteOrZero( rNew );
+				const auto rE01 = _tIsa::Add( _tIsa::Exp( _tIsa::Sub( rX0, rSafe ) ), _tIsa::Exp( _tIsa::Sub( rX1, rSafe ) ) );
+				const auto rE23 = _tIsa::Add( _tIsa::Exp( _tIsa::Sub( rX2, rSafe ) ), _tIsa::Exp( _tIsa::Sub( rX3, rSafe ) ) );
+				rSum = _tIsa::Add( _tIsa::Mul( rSum, _tIsa::Exp( _tIsa::Sub( rMax, rSafe ) ) ), _tIsa::Add( rE01, rE23 ) );
+				rMax = rNew;
+			}
+			for ( ; I + L <= _sCols; I += L ) {
+				const auto rX = _tIsa::Load( _ptIn + I );
+				const auto rNew = _tIsa::Max( rMax, rX );
+				const auto rSafe = _tIsa::FiniteOrZero( rNew );
+				rSum = _tIsa::Add( _tIsa::Mul( rSum, _tIsa::Exp( _tIsa::Sub( rMax, rSafe ) ) ), _tIsa::Exp( _tIsa::Sub( rX, rSafe ) ) );
+				rMax = rNew;
+			}
+
+			// Rescale every lane to the row maximum, then fold in the tail.
+			Scalar sMax = _tIsa::HMax( rMax );
+			for ( size_t J = I; J < _sCols; ++J ) {
+				const Scalar sVal = static_cast<Scalar>(_ptIn[J]);
+				sMax = sVal > sMax ? sVal : sMax;
+			}
+			const Scalar sSafe = FiniteOrZero( sMax );
+			Scalar sSum = _tIsa::HAdd( _tIsa::Mul( rSum, _tIsa::Exp( _tIsa::Sub( rMax, _tIsa::Set1( sSafe ) ) ) ) );
+			for ( ; I < _sCols; ++I ) { sSum += std::exp( static_cast<Scalar>(_ptIn[I]) - sSafe ); }
+			_sMax = sMax;
+			_sSum = sSum;
+		}
+
+		/**
+		 * Writes exponentials multiplied by a scale.
+		 *
+		 * \tparam _tIsa The register traits.
+		 * \tparam _tOut The output type.
+		 * \param _psExp The exponentials.  May be the same as _ptOut.
+		 * \param _sCols The number of elements in the row.
+		 * \param _sScale The reciprocal of the sum.
+		 * \param _ptOut The output row.
+		 **/
+		template <typename _tIsa, typename _tOut>
+		static void													RowScale( const typename _tIsa::Scalar * _psExp, size_t _sCols, typename _tIsa::Scalar _sScale, _tOut * _ptOut ) {
+			using Scalar = typename _tIsa::Scalar;
+			constexpr size_t L = _tIsa::Lanes;
+			const auto rScale = _tIsa::Set1( _sScale );
+			size_t I = 0;
+			for ( ; I + L <= _sCols; I += L ) { _tIsa::Store( _ptOut + I, _tIsa::Mul( _tIsa::Load( _psExp + I ), rScale ) ); }
+			for ( ; I < _sCols; ++I ) { _ptOut[I] = static_cast<_tOut>(Scalar( _psExp[I] * _sScale )); }
+		}
+
+		/**
+		 * Writes exp( x - max ) multiplied by a scale.
+		 *
+		 * \tparam _tIsa The register traits.
+		 * \tparam _tIn The input type.
+		 * \tparam _tOut The output type.
+		 * \param _ptIn The row.
+		 * \param _sCols The number of elements in the row.
+		 * \param _sMax The largest value in the row.
+		 * \param _sScale The reciprocal of the sum.
+		 * \param _ptOut The output row.
+		 **/
+		template <typename _tIsa, typename _tIn, typename _tOut>
+		static void													RowExpScale( const _tIn * _ptIn, size_t _sCols, typename _tIsa::Scalar _sMax, typename _tIsa::Scalar _sScale, _tOut * _ptOut ) {
+			using Scalar = typename _tIsa::Scalar;
+			constexpr size_t L = _tIsa::Lanes;
+			const Scalar sMax = FiniteOrZero( _sMax );
+			const auto rMax = _tIsa::Set1( sMax ), rScale = _tIsa::Set1( _sScale );
+			size_t I = 0;
+			for ( ; I + L <= _sCols; I += L ) {
+				_tIsa::Store( _ptOut + I, _tIsa::Mul( _tIsa::Exp( _tIsa::Sub( _tIsa::Load( _ptIn + I ), rMax ) ), rScale ) );
+			}
+			for ( ; I < _sCols; ++I ) { _ptOut[I] = static_cast<_tOut>(Scalar( std::exp( static_cast<Scalar>(_ptIn[I]) - sMax ) * _sScale )); }
+		}
+
+		/**
+		 * Writes x - log( sum( exp( x ) ) ).
+		 *
+		 * \tparam _tIsa The register traits.
+		 * \tparam _tIn The input type.
+		 * \tparam _tOut The output type.
+		 * \param _ptIn The row.
+		 * \param _sCols The number of elements in the row.
+		 * \param _sLse The log of the sum of the exponentials.
+		 * \param _ptOut The output row.
+		 **/
+		template <typename _tIsa, typename _tIn, typename _tOut>
+		static void													RowSubtract( const _tIn * _ptIn, size_t _sCols, typename _tIsa::Scalar _sLse, _tOut * _ptOut ) {
+			using Scalar = typename _tIsa::Scalar;
+			constexpr size_t L = _tIsa::Lanes;
+			const auto rLse = _tIsa::Set1( _sLse );
+			size_t I = 0;
+			for ( ; I + L <= _sCols; I += L ) { _tIsa::Store( _ptOut + I, _tIsa::Sub( _tIsa::Load( _ptIn + I ), rLse ) ); }
+			for ( ; I < _sCols; ++I ) { _ptOut[I] = static_cast<_tOut>(Scalar( static_cast<Scalar>(_ptIn[I]) - _sLse )); }
+		}
+	};
+
+}	// namespace nn9
@@ -0,0 +1,402 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A native tensor checkpoint file.  A small header index is followed by each tensor's raw data, each starting on a page boundary so
+ *	that tensors can be mapped straight out of the file without copies.
+ */
+
+#include "NN9Checkpoint.h"
+#include "../Files/NN9FileMap.h"
+#include "../Utilities/NN9Crc.h"
+#include "../Utilities/NN9ThreadPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <thread>
+
+
+namespace nn9 {
+
+	/** The bytes every checkpoint starts with. */
+	static const uint8_t g_ui8CheckpointMagic[8] = { 'N', 'N', '9', 'C', 'K', 'P', 'T', '\0' };
+
+	/**
+	 * Rounds a file position up to the next data boundary.
+	 *
+	 * \param _ui64Pos The position to round.
+	 * \return Returns the rounded position.
+	 **/
+	static inline uint64_t AlignData( uint64_t _ui64Pos ) {
+		return (_ui64Pos + (Checkpoint::NN9_C_DATA_ALIGN - 1)) & ~uint64_t( Checkpoint::NN9_C_DATA_ALIGN - 1 );
+	}
+
+	/**
+	 * Checks that strides describe the contiguous row-major layout of a shape and gets the number of elements.
+	 *
+	 * \param _vShape The shape.
+	 * \param _vStride The strides.
+	 * \param _ui64Elements Holds the number of elements on success.
+	 * \return Returns false if the strides are not contiguous or the element count does not fit in 64 bits.
+	 **/
+	static bool ContiguousElements( const std::vector<size_t> &_vShape, const std::vector<size_t> &_vStride, uint64_t &_ui64Elements ) {
+		if ( _vShape.size() != _vStride.size() ) { return false; }
+		uint64_t ui64Elements = 1;
+		for ( size_t I = _vShape.size(); I > 0; --I ) {
+			if ( _vStride[I-1] != ui64Elements ) { return false; }
+			uint64_t ui64Dim = _vShape[I-1];
+			if ( ui64Dim && ui64Elements > std::numeric_limits<uint64_t>::max() / ui64Dim ) { return false; }
+			ui64Elements *= ui64Dim;
+		}
+		_ui64Elements = ui64Elements;
+		return true;
+	}
+
+	/**
+	 * Appends a value to a byte buffer.
+	 *
+	 * \param _tVal The value to append.
+	 * \param _vOut The buffer to which to append the value.
+	 **/
+	template <typename _tType>
+	static inline void Put( _tType _tVal, std::vector<uint8_t> &_vOut ) {
+		size_t sPos = _vOut.size();
+		_vOut.resize( sPos + sizeof( _tType ) );
+		std::memcpy( &_vOut[sPos], &_tVal, sizeof( _tType ) );
+	}
+
+	/**
+	 * Reads a value from a byte buffer.
+	 *
+	 * \param _pui8Data The buffer from which to read.
+	 * \param _sSize The size of the buffer.
+	 * \param _sPos The read position, advanced past the value.
+	 * \param _tVal Holds the value read.
+	 * \return Returns false if the buffer is too short.
+	 **/
+	template <typename _tType>
+	static inline bool Get( const uint8_t * _pui8Data, size_t _sSize, size_t &_sPos, _tType &_tVal ) {
+		if ( _sPos > _sSize || _sSize - _sPos < sizeof( _tType ) ) { return false; }
+		std::memcpy( &_tVal, _pui8Data + _sPos, sizeof( _tType ) );
+		_sPos += sizeof( _tType );
+		return true;
+	}
+
+	Checkpoint::Checkpoint() {
+	}
+	Checkpoint::~Checkpoint() {
+		Close();
+	}
+
+	// == Functions.
+	/**
+	 * Writes tensors to a checkpoint file.  Tensors are copied into the file and their CRCs calculated concurrently.
+	 *
+	 * \param _pFile The file to create.
+	 * \param _vTensors Pairs of unique names and tensors to write.  Every tensor must be contiguous.
+	 * \param _ptpPool The pool on which to write the tensors.  If nullptr, a temporary pool with one thread per core is used.
+	 * \return Returns an error code indicating the result of the operation.  NN9_E_INVALID_PARAMETER is returned if a tensor is nullptr, is
+	 *	not contiguous, or has a duplicate name.
+	 **/
+	NN9_ERRORS Checkpoint::Write( const std::filesystem::path &_pFile, const std::vector<std::pair<std::string, Tensor *>> &_vTensors,
+		ThreadPool * _ptpPool ) {
+		try {
+			std::vector<NN9_RECORD> vRecords( _vTensors.size() );
+			std::map<std::string, size_t> mNames;
+			for ( size_t I = 0; I < _vTensors.size(); ++I ) {
+				Tensor * ptTensor = _vTensors[I].second;
+				if ( !ptTensor || !mNames.emplace( _vTensors[I].first, I ).second ) { return NN9_E_INVALID_PARAMETER; }
+				auto & rRecord = vRecords[I];
+				rRecord.sName = _vTensors[I].first;
+				rRecord.tType = ptTensor->Type();
+				// Open() accepts only row-major strides, so those are written in place of whatever a size-1 dimension happens to hold.
+				if ( !ptTensor->IsContiguous() ) { return NN9_E_INVALID_PARAMETER; }
+				rRecord.vShape = ptTensor->Shape();
+				rRecord.vStride.resize( rRecord.vShape.size() );
+				uint64_t ui64Elements = 1;
+				for ( size_t J = rRecord.vShape.size(); J > 0; --J ) {
+					rRecord.vStride[J-1] = static_cast<size_t>(ui64Elements);
+					ui64Elements *= rRecord.vShape[J-1];
+				}
+				rRecord.dQuantizeScale = ptTensor->QuantizeScale();
+				rRecord.dQuantizeZero = ptTensor->QuantizeZero();
+				rRecord.ui64Size = ptTensor->Size();
+			}
+
+			// Index entries have no variable-width numbers, so the index size (and from it every data offset) is known before the CRCs are.
+			std::vector<uint8_t> vIndex;
+			for ( auto & rRecord : vRecords ) {
+				WriteRecord( rRecord, vIndex );
+			}
+			uint64_t ui64Pos = AlignData( NN9_C_HEADER_SIZE + vIndex.size() );
+			for ( auto & rRecord : vRecords ) {
+				rRecord.ui64Offset = ui64Pos;
+				ui64Pos = AlignData( ui64Pos + rRecord.ui64Size );
+			}
+
+			FileMap fmFile;
+			NN9_ERRORS eError = fmFile.Create( _pFile );
+			if ( eError != NN9_E_SUCCESS ) { return eError; }
+			eError = fmFile.SetSize( ui64Pos );
+			if ( eError != NN9_E_SUCCESS ) { return eError; }
+
+			// Build the CRC tables before the workers race to do it.
+			Crc::GetCrc( nullptr, 0 );
+
+			std::unique_ptr<ThreadPool> uptpLocal;
+			if ( !_ptpPool ) {
+				uptpLocal = std::make_unique<ThreadPool>( std::max<size_t>( std::thread::hardware_concurrency(), 1 ) );
+				_ptpPool = uptpLocal.get();
+			}
+			std::vector<std::future<NN9_ERRORS>> vResults;
+			vResults.reserve( vRecords.size() );
+			for ( size_t I = 0; I < vRecords.size(); ++I ) {
+				vResults.emplace_back( _ptpPool->Submit( [&fmFile, &vRecords, &_vTensors, I]() -> NN9_ERRORS {
+					auto & rRecord = vRecords[I];
+					if ( !rRecord.ui64Size ) {
+						rRecord.ui32Crc = Crc::GetCrc( nullptr, 0 );
+						return NN9_E_SUCCESS;
+					}
+					auto vSrc = _vTensors[I].second->FullView<uint8_t>();
+					void * pvBase;
+					size_t sBaseSize;
+					uint8_t * pui8Dst = fmFile.MapRegion( rRecord.ui64Offset, static_cast<size_t>(rRecord.ui64Size), pvBase, sBaseSize );
+					if ( !pui8Dst ) { return NN9_E_WRITE_FAILED; }
+					std::memcpy( pui8Dst, &vSrc[0], vSrc.size() );
+					FileMap::UnmapRegion( pvBase, sBaseSize );
+					rRecord.ui32Crc = Crc::GetCrc( &vSrc[0], vSrc.size() );
+					return NN9_E_SUCCESS;
+				} ) );
+			}
+			// Every task has to finish before leaving, even after an error, because they reference our locals.
+			for ( auto & fResult : vResults ) {
+				NN9_ERRORS eThis;
+				try {
+					eThis = fResult.get();
+				}
+				catch ( ... ) { eThis = NN9_E_WRITE_FAILED; }
+				if ( eError == NN9_E_SUCCESS ) { eError = eThis; }
+			}
+			if ( eError != NN9_E_SUCCESS ) { return eError; }
+
+			// Now the index can be written with its CRCs.
+			vIndex.clear();
+			for ( auto & rRecord : vRecords ) {
+				WriteRecord( rRecord, vIndex );
+			}
+			std::vector<uint8_t> vHeader;
+			vHeader.reserve( NN9_C_HEADER_SIZE + vIndex.size() );
+			vHeader.insert( vHeader.end(), std::begin( g_ui8CheckpointMagic ), std::end( g_ui8CheckpointMagic ) );
+			Put<uint32_t>( NN9_C_VERSION, vHeader );
+			Put<uint32_t>( static_cast<uint32_t>(vRecords.size()), vHeader );
+			Put<uint64_t>( NN9_C_HEADER_SIZE, vHeader );
+			Put<uint64_t>( vIndex.size(), vHeader );
+			Put<uint32_t>( Crc::GetCrc( vIndex.data(), vIndex.size() ), vHeader );
+			Put<uint32_t>( NN9_C_DATA_ALIGN, vHeader );
+			vHeader.resize( NN9_C_HEADER_SIZE );
+			vHeader.insert( vHeader.end(), vIndex.begin(), vIndex.end() );
+
+			void * pvBase;
+			size_t sBaseSize;
+			uint8_t * pui8Dst = fmFile.MapRegion( 0, vHeader.size(), pvBase, sBaseSize );
+			if ( !pui8Dst ) { return NN9_E_WRITE_FAILED; }
+			std::memcpy( pui8Dst, vHeader.data(), vHeader.size() );
+			FileMap::UnmapRegion( pvBase, sBaseSize );
+			return NN9_E_SUCCESS;
+		}
+		catch ( ... ) { return NN9_E_OUT_OF_MEMORY; }
+	}
+
+	/**
+	 * Opens a checkpoint file and reads its index.  No tensor data is read.
+	 *
+	 * \param _pFile The file to open.
+	 * \return Returns an error code indicating the result of the operation.
+	 **/
+	NN9_ERRORS Checkpoint::Open( const std::filesystem::path &_pFile ) {
+		Close();
+		try {
+			auto spfmFile = std::make_shared<FileMap>();
+			NN9_ERRORS eError = spfmFile->OpenReadOnly( _pFile );
+			if ( eError != NN9_E_SUCCESS ) { return eError; }
+			uint64_t ui64FileSize = spfmFile->Size();
+			if ( ui64FileSize < NN9_C_HEADER_SIZE ) { return NN9_E_BAD_FILE_FORMAT; }
+
+			uint32_t ui32Version, ui32Total, ui32IndexCrc, ui32Align;
+			uint64_t ui64IndexOffset, ui64IndexSize;
+			{
+				void * pvBase;
+				size_t sBaseSize;
+				const uint8_t * pui8Header = spfmFile->MapRegion( 0, NN9_C_HEADER_SIZE, pvBase, sBaseSize );
+				if ( !pui8Header ) { return NN9_E_READ_FAILED; }
+				bool bMagic = std::memcmp( pui8Header, g_ui8CheckpointMagic, sizeof( g_ui8CheckpointMagic ) ) == 0;
+				size_t sPos = sizeof( g_ui8CheckpointMagic );
+				Get( pui8Header, NN9_C_HEADER_SIZE, sPos, ui32Version );
+				Get( pui8Header, NN9_C_HEADER_SIZE, sPos, ui32Total );
+				Get( pui8Header, NN9_C_HEADER_SIZE, sPos, ui64IndexOffset );
+				Get( pui8Header, NN9_C_HEADER_SIZE, sPos, ui64IndexSize );
+				Get( pui8Header, NN9_C_HEADER_SIZE, sPos, ui32IndexCrc );
+				Get( pui8Header, NN9_C_HEADER_SIZE, sPos, ui32Align );
+				FileMap::UnmapRegion( pvBase, sBaseSize );
+				if ( !bMagic ) { return NN9_E_BAD_FILE_FORMAT; }
+			}
+			if ( ui32Version > NN9_C_VERSION ) { return NN9_E_UNSUPPORTED_FEATURE; }
+			if ( ui64IndexOffset > ui64FileSize || ui64IndexSize > ui64FileSize - ui64IndexOffset ) { return NN9_E_BAD_FILE_FORMAT; }
+
+			std::vector<NN9_RECORD> vRecords;
+			std::map<std::string, size_t> mIndex;
+			if ( ui64IndexSize ) {
+				void * pvBase;
+				size_t sBaseSize;
+				const uint8_t * pui8Index = spfmFile->MapRegion( ui64IndexOffset, static_cast<size_t>(ui64IndexSize), pvBase, sBaseSize );
+				if ( !pui8Index ) { return NN9_E_READ_FAILED; }
+				eError = NN9_E_SUCCESS;
+				if ( Crc::GetCrc( pui8Index, static_cast<uintptr_t>(ui64IndexSize) ) != ui32IndexCrc ) { eError = NN9_E_BAD_CRC; }
+				else {
+					size_t sPos = 0;
+					vRecords.resize( ui32Total );
+					for ( uint32_t I = 0; I < ui32Total && eError == NN9_E_SUCCESS; ++I ) {
+						if ( !ReadRecord( pui8Index, static_cast<size_t>(ui64IndexSize), sPos, vRecords[I] ) ) { eError = NN9_E_BAD_FILE_FORMAT; }
+					}
+				}
+				FileMap::UnmapRegion( pvBase, sBaseSize );
+				if ( eError != NN9_E_SUCCESS ) { return eError; }
+			}
+			else if ( ui32Total ) { return NN9_E_BAD_FILE_FORMAT; }
+
+			for ( size_t I = 0; I < vRecords.size(); ++I ) {
+				auto & rRecord = vRecords[I];
+				// Tensors are mapped with the strides Tensor::FromFile() computes, so the stored ones must match them.
+				uint64_t ui64Elements, ui64Size = Types::SizeOf( rRecord.tType );
+				if ( rRecord.vShape.empty() || !ContiguousElements( rRecord.vShape, rRecord.vStride, ui64Elements ) ||
+					(ui64Elements && ui64Size > std::numeric_limits<uint64_t>::max() / ui64Elements) ||
+					ui64Elements * ui64Size != rRecord.ui64Size ||
+					rRecord.ui64Offset > ui64FileSize || rRecord.ui64Size > ui64FileSize - rRecord.ui64Offset ||
+					!mIndex.emplace( rRecord.sName, I ).second ) {
+					return NN9_E_BAD_FILE_FORMAT;
+				}
+			}
+
+			m_spfmFile = std::move( spfmFile );
+			m_vRecords = std::move( vRecords );
+			m_mIndex = std::move( mIndex );
+			return NN9_E_SUCCESS;
+		}
+		catch ( ... ) { return NN9_E_OUT_OF_MEMORY; }
+	}
+
+	/**
+	 * Closes the checkpoint.  Tensors already loaded from it remain valid.
+	 **/
+	void Checkpoint::Close() {
+		// Loaded tensors hold their own references to the file.
+		m_spfmFile.reset();
+		m_vRecords.clear();
+		m_mIndex.clear();
+	}
+
+	/**
+	 * Creates a tensor over the named tensor's data in the file.  The data is mapped, not read, so only the pages actually used are ever
+	 *	loaded.  The tensor is copy-on-write and never modifies the file.
+	 *
+	 * \param _sName The name of the tensor to load.
+	 * \param _bVerify If true, the tensor's CRC is checked first, which reads all of its data.
+	 * \throw Throws if the tensor does not exist, could not be mapped, or failed verification.
+	 * \return Returns the tensor.
+	 **/
+	Tensor Checkpoint::Load( const std::string &_sName, bool _bVerify ) const {
+		auto aIt = m_mIndex.find( _sName );
+		if ( aIt == m_mIndex.end() ) {
+			throw std::out_of_range( "Checkpoint::Load: Tensor not found." );
+		}
+		if ( _bVerify && Verify( _sName ) != NN9_E_SUCCESS ) {
+			throw std::runtime_error( "Checkpoint::Load: Tensor failed verification." );
+		}
+		const auto & rRecord = m_vRecords[aIt->second];
+		Tensor tRet = Tensor::FromFile( m_spfmFile, rRecord.ui64Offset, rRecord.vShape, rRecord.tType );
+		tRet.m_dQuantizeScale = rRecord.dQuantizeScale;
+		tRet.m_dQuantizeZero = rRecord.dQuantizeZero;
+		return tRet;
+	}
+
+	/**
+	 * Checks the CRC of the named tensor's data.
+	 *
+	 * \param _sName The name of the tensor to verify.
+	 * \return Returns NN9_E_SUCCESS if the data is intact, NN9_E_BAD_CRC if not, or another error code if the data could not be read.
+	 **/
+	NN9_ERRORS Checkpoint::Verify( const std::string &_sName ) const {
+		auto aIt = m_mIndex.find( _sName );
+		if ( aIt == m_mIndex.end() ) { return NN9_E_INVALID_PARAMETER; }
+		const auto & rRecord = m_vRecords[aIt->second];
+		if ( !rRecord.ui64Size ) { return rRecord.ui32Crc == Crc::GetCrc( nullptr, 0 ) ? NN9_E_SUCCESS : NN9_E_BAD_CRC; }
+
+		void * pvBase;
+		size_t sBaseSize;
+		const uint8_t * pui8Data = m_spfmFile->MapRegion( rRecord.ui64Offset, static_cast<size_t>(rRecord.ui64Size), pvBase, sBaseSize );
+		if ( !pui8Data ) { return NN9_E_READ_FAILED; }
+		uint32_t ui32Crc = Crc::GetCrc( pui8Data, static_cast<uintptr_t>(rRecord.ui64Size) );
+		FileMap::UnmapRegion( pvBase, sBaseSize );
+		return ui32Crc == rRecord.ui32Crc ? NN9_E_SUCCESS : NN9_E_BAD_CRC;
+	}
+
+	/**
+	 * Serializes an index entry.
+	 *
+	 * \param _rRecord The entry to serialize.
+	 * \param _vOut The buffer to which to append the entry.
+	 **/
+	void Checkpoint::WriteRecord( const NN9_RECORD &_rRecord, std::vector<uint8_t> &_vOut ) {
+		Put<uint32_t>( static_cast<uint32_t>(_rRecord.sName.size()), _vOut );
+		_vOut.insert( _vOut.end(), _rRecord.sName.begin(), _rRecord.sName.end() );
+		Put<uint32_t>( static_cast<uint32_t>(_rRecord.tType), _vOut );
+		Put<uint32_t>( static_cast<uint32_t>(_rRecord.vShape.size()), _vOut );
+		for ( auto sDim : _rRecord.vShape ) { Put<uint64_t>( sDim, _vOut ); }
+		for ( auto sStride : _rRecord.vStride ) { Put<uint64_t>( sStride, _vOut ); }
+		Put<double>( _rRecord.dQuantizeScale, _vOut );
+		Put<double>( _rRecord.dQuantizeZero, _vOut );
+		Put<uint64_t>( _rRecord.ui64Offset, _vOut );
+		Put<uint64_t>( _rRecord.ui64Size, _vOut );
+		Put<uint32_t>( _rRecord.ui32Crc, _vOut );
+	}
+
+	/**
+	 * Deserializes an index entry.
+	 *
+	 * \param _pui8Data The serialized index.
+	 * \param _sSize The size of the serialized index.
+	 * \param _sPos The read position, advanced past the entry.
+	 * \param _rRecord Holds the deserialized entry.
+	 * \return Returns false if the index is truncated or malformed.
+	 **/
+	bool Checkpoint::ReadRecord( const uint8_t * _pui8Data, size_t _sSize, size_t &_sPos, NN9_RECORD &_rRecord ) {
+		uint32_t ui32Len, ui32Type, ui32Dims;
+		if ( !Get( _pui8Data, _sSize, _sPos, ui32Len ) || ui32Len > _sSize - _sPos ) { return false; }
+		_rRecord.sName.assign( reinterpret_cast<const char *>(_pui8Data + _sPos), ui32Len );
+		_sPos += ui32Len;
+		if ( !Get( _pui8Data, _sSize, _sPos, ui32Type ) || ui32Type >= NN9_T_OTHER ) { return false; }
+		_rRecord.tType = static_cast<NN9_TYPE>(ui32Type);
+		if ( !Get( _pui8Data, _sSize, _sPos, ui32Dims ) || uint64_t( ui32Dims ) * 16 > _sSize - _sPos ) { return false; }
+		_rRecord.vShape.resize( ui32Dims );
+		_rRecord.vStride.resize( ui32Dims );
+		for ( auto & sDim : _rRecord.vShape ) {
+			uint64_t ui64Val;
+			if ( !Get( _pui8Data, _sSize, _sPos, ui64Val ) ) { return false; }
+			sDim = static_cast<size_t>(ui64Val);
+		}
+		for ( auto & sStride : _rRecord.vStride ) {
+			uint64_t ui64Val;
+			if ( !Get( _pui8Data, _sSize, _sPos, ui64Val ) ) { return false; }
+			sStride = static_cast<size_t>(ui64Val);
+		}
+		return Get( _pui8Data, _sSize, _sPos, _rRecord.dQuantizeScale ) &&
+			Get( _pui8Data, _sSize, _sPos, _rRecord.dQuantizeZero ) &&
+			Get( _pui8Data, _sSize, _sPos, _rRecord.ui64Offset ) &&
+			Get( _pui8Data, _sSize, _sPos, _rRecord.ui64Size ) &&
+			Get( _pui8Data, _sSize, _sPos, _rRecord.ui32Crc );
+	}
+
+}	// namespace nn9
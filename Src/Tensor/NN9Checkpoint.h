@@ -0,0 +1,162 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A native tensor checkpoint file.  A small header index is followed by each tensor's raw data, each starting on a page boundary so
+ *	that tensors can be mapped straight out of the file without copies.
+ */
+
+#pragma once
+
+#include "NN9Tensor.h"
+#include "../Errors/NN9Errors.h"
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace nn9 {
+
+	class FileMap;
+	class ThreadPool;
+
+	/**
+	 * Class Checkpoint
+	 * \brief A native tensor checkpoint file.
+	 *
+	 * Description: A native tensor checkpoint file.  A small header index is followed by each tensor's raw data, each starting on a page boundary so
+	 *	that tensors can be mapped straight out of the file without copies.
+	 */
+	class Checkpoint {
+	public :
+		Checkpoint();
+		~Checkpoint();
+
+
+		// == Enumerations.
+		/** File-format constants. */
+		enum NN9_CHECKPOINT : uint32_t {
+			NN9_C_VERSION						= 1,									/**< The current file version. */
+			NN9_C_HEADER_SIZE					= 64,									/**< Size of the fixed header that precedes the index. */
+			NN9_C_DATA_ALIGN					= 4096,									/**< Alignment of each tensor's data within the file. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Writes tensors to a checkpoint file.  Tensors are copied into the file and their CRCs calculated concurrently.
+		 *
+		 * \param _pFile The file to create.
+		 * \param _vTensors Pairs of unique names and tensors to write.  Every tensor must be contiguous.
+		 * \param _ptpPool The pool on which to write the tensors.  If nullptr, a temporary pool with one thread per core is used.
+		 * \return Returns an error code indicating the result of the operation.  NN9_E_INVALID_PARAMETER is returned if a tensor is nullptr,
+		 *	is not contiguous, or has a duplicate name.
+		 **/
+		static NN9_ERRORS						Write( const std::filesystem::path &_pFile, const std::vector<std::pair<std::string, Tensor *>> &_vTensors,
+			ThreadPool * _ptpPool = nullptr );
+
+		/**
+		 * Opens a checkpoint file and reads its index.  No tensor data is read.
+		 *
+		 * \param _pFile The file to open.
+		 * \return Returns an error code indicating the result of the operation.
+		 **/
+		NN9_ERRORS								Open( const std::filesystem::path &_pFile );
+
+		/**
+		 * Closes the checkpoint.  Tensors already loaded from it remain valid.
+		 **/
+		void									Close();
+
+		/**
+		 * Gets the number of tensors in the checkpoint.
+		 *
+		 * \return Returns the number of tensors in the checkpoint.
+		 **/
+		size_t									Total() const { return m_vRecords.size(); }
+
+		/**
+		 * Gets the name of a tensor by index.
+		 *
+		 * \param _sIdx The index of the tensor.
+		 * \return Returns the name of the tensor.
+		 **/
+		const std::string &						Name( size_t _sIdx ) const { return m_vRecords[_sIdx].sName; }
+
+		/**
+		 * Determines whether the checkpoint contains a tensor with the given name.
+		 *
+		 * \param _sName The name of the tensor.
+		 * \return Returns true if the tensor exists in the checkpoint.
+		 **/
+		bool									Has( const std::string &_sName ) const { return m_mIndex.find( _sName ) != m_mIndex.end(); }
+
+		/**
+		 * Creates a tensor over the named tensor's data in the file.  The data is mapped, not read, so only the pages actually used are ever
+		 *	loaded.  The tensor is copy-on-write and never modifies the file.
+		 *
+		 * \param _sName The name of the tensor to load.
+		 * \param _bVerify If true, the tensor's CRC is checked first, which reads all of its data.
+		 * \throw Throws if the tensor does not exist, could not be mapped, or failed verification.
+		 * \return Returns the tensor.
+		 **/
+		Tensor									Load( const std::string &_sName, bool _bVerify = false ) const;
+
+		/**
+		 * Checks the CRC of the named tensor's data.
+		 *
+		 * \param _sName The name of the tensor to verify.
+		 * \return Returns NN9_E_SUCCESS if the data is intact, NN9_E_BAD_CRC if not, or another error code if the data could not be read.
+		 **/
+		NN9_ERRORS								Verify( const std::string &_sName ) const;
+
+
+	protected :
+		// == Types.
+		/** An index entry. */
+		struct NN9_RECORD {
+			std::string							sName;									/**< The tensor's name. */
+			NN9_TYPE							tType = NN9_T_FLOAT;					/**< The tensor's data type. */
+			std::vector<size_t>					vShape;									/**< The tensor's shape. */
+			std::vector<size_t>					vStride;								/**< The tensor's strides. */
+			double								dQuantizeScale = 1.0;					/**< Quantize scale. */
+			double								dQuantizeZero = 0.0;					/**< Quantize 0 point. */
+			uint64_t							ui64Offset = 0;							/**< Offset of the data within the file. */
+			uint64_t							ui64Size = 0;							/**< Size of the data, in bytes. */
+			uint32_t							ui32Crc = 0;							/**< CRC of the data. */
+		};
+
+
+		// == Members.
+		std::shared_ptr<FileMap>				m_spfmFile;								/**< The opened checkpoint file. */
+		std::vector<NN9_RECORD>					m_vRecords;								/**< The index, in file order. */
+		std::map<std::string, size_t>			m_mIndex;								/**< Maps names to m_vRecords indices. */
+
+
+		// == Functions.
+		/**
+		 * Serializes an index entry.
+		 *
+		 * \param _rRecord The entry to serialize.
+		 * \param _vOut The buffer to which to append the entry.
+		 **/
+		static void								WriteRecord( const NN9_RECORD &_rRecord, std::vector<uint8_t> &_vOut );
+
+		/**
+		 * Deserializes an index entry.
+		 *
+		 * \param _pui8Data The serialized index.
+		 * \param _sSize The size of the serialized index.
+		 * \param _sPos The read position, advanced past the entry.
+		 * \param _rRecord Holds the deserialized entry.
+		 * \return Returns false if the index is truncated or malformed.
+		 **/
+		static bool								ReadRecord( const uint8_t * _pui8Data, size_t _sSize, size_t &_sPos, NN9_RECORD &_rRecord );
+	};
+
+}	// namespace nn9
@@ -0,0 +1,401 @@
+/**
+ * Copyright L. Spiro 2024
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: An N-D view over a buffer with arbitrary per-dimension strides.  Slicing, transposing, permuting, and expanding only change
+ *	the shape and strides, so none of them copy any data.
+ */
+
+#pragma once
+
+#include "../Buffers/NN9Buffer.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+
+namespace nn9 {
+
+	/**
+	 * Class StridedView
+	 * \brief An N-D view over a buffer with arbitrary per-dimension strides.
+	 *
+	 * Description: An N-D view over a buffer with arbitrary per-dimension strides.  Slicing, transposing, permuting, and expanding only change
+	 *	the shape and strides, so none of them copy any data.  Iteration walks runs along the innermost dimension after merging every pair of
+	 *	dimensions that are laid out back-to-back, so a view that is contiguous in memory is a single run no matter its shape.
+	 */
+	template <typename _tDataType>
+	class StridedView {
+	public :
+		StridedView( View<_tDataType> _vBase, const std::vector<size_t> &_vShape, const std::vector<size_t> &_vStride ) :
+			m_vBase( std::move( _vBase ) ),
+			m_pData( m_vBase.size() ? &m_vBase[0] : nullptr ),
+			m_vShape( _vShape ),
+			m_vStride( _vStride ) {
+			if ( m_vShape.size() != m_vStride.size() ) {
+				throw std::invalid_argument( "StridedView: Shape and strides must have the same number of dimensions." );
+			}
+			Collapse();
+		}
+
+
+		// == Enumerations.
+		/** Iteration constants. */
+		enum NN9_STRIDED_VIEW : size_t {
+			NN9_SV_BLOCK									= 512,											/**< Elements per block when non-contiguous data is gathered into contiguous scratch. */
+		};
+
+
+		// == Types.
+		typedef _tDataType									value_type;										/**< std::vector<>-compatible value_type definition. */
+
+
+		// == Operators.
+		/**
+		 * Accesses an element by its N-D index.
+		 *
+		 * \param _aArgs The indices, one for each dimension of the view.
+		 * \throw If NN9_SAFETY_CHECK, throws if the number of arguments does not match the view shape or any index is out of range.
+		 * \return Returns a reference to the element.
+		 **/
+		template <typename ... Arg>
+		_tDataType &										operator () ( Arg ... _aArgs ) const {
+#ifdef NN9_SAFETY_CHECK
+			if ( sizeof...( _aArgs ) != m_vShape.size() ) {
+				throw std::invalid_argument( "StridedView::(): Number of arguments does not match view dimensions." );
+			}
+#endif	// #ifdef NN9_SAFETY_CHECK
+			size_t sOffset = 0;
+			size_t sDim = 0;
+			((sOffset += Index( sDim++, static_cast<size_t>(_aArgs) )), ...);
+			return m_pData[sOffset];
+		}
+
+
+		// == Functions.
+		/**
+		 * Retrieves the total number of elements in the view.
+		 *
+		 * \return Returns the number of elements in the view.
+		 **/
+		std::size_t											size() const { return m_sTotal; }
+
+		/**
+		 * Gets the shape of the view.
+		 *
+		 * \return Returns the size of each dimension.
+		 **/
+		const std::vector<size_t> &							Shape() const { return m_vShape; }
+
+		/**
+		 * Gets the strides of the view.
+		 *
+		 * \return Returns the stride, in elements, of each dimension.
+		 **/
+		const std::vector<size_t> &							Strides() const { return m_vStride; }
+
+		/**
+		 * Gets a pointer to the element at index 0 in every dimension.
+		 *
+		 * \return Returns a pointer to the first element of the view.
+		 **/
+		_tDataType *										Data() const { return m_pData; }
+
+		/**
+		 * Determines whether the elements of the view are packed back-to-back in memory in row-major order.
+		 *
+		 * \return Returns true if the view can be treated as a flat array of size() elements starting at Data().
+		 **/
+		bool												IsContiguous() const {
+			return m_vRunShape.empty() || (m_vRunShape.size() == 1 && m_vRunStride[0] == 1);
+		}
+
+		/**
+		 * Determines whether more than one element of the view refers to the same memory, as happens after Expand().  Such views must not
+		 *	be written.
+		 *
+		 * \return Returns true if any dimension with more than 1 element has a stride of 0.
+		 **/
+		bool												Overlaps() const {
+			for ( size_t I = 0; I < m_vRunStride.size(); ++I ) {
+				if ( m_vRunStride[I] == 0 ) { return true; }
+			}
+			return false;
+		}
+
+		/**
+		 * Accesses an element by its N-D index.
+		 *
+		 * \param _vIdx The indices, one for each dimension of the view.
+		 * \throw If NN9_SAFETY_CHECK, throws if the number of indices does not match the view shape or any index is out of range.
+		 * \return Returns a reference to the element.
+		 **/
+		_tDataType &										At( const std::vector<size_t> &_vIdx ) const {
+#ifdef NN9_SAFETY_CHECK
+			if ( _vIdx.size() != m_vShape.size() ) {
+				throw std::invalid_argument( "StridedView::At: Number of indices does not match view dimensions." );
+			}
+#endif	// #ifdef NN9_SAFETY_CHECK
+			size_t sOffset = 0;
+			for ( size_t I = 0; I < _vIdx.size(); ++I ) {
+				sOffset += Index( I, _vIdx[I] );
+			}
+			return m_pData[sOffset];
+		}
+
+		/**
+		 * Creates a view of a range along one dimension.
+		 *
+		 * \param _sDim The dimension to slice.
+		 * \param _sStart The first index to keep.
+		 * \param _sEnd One past the last index to keep.
+		 * \param _sStep The distance between kept indices.
+		 * \throw Throws if the dimension or range is invalid.
+		 * \return Returns the sliced view.
+		 **/
+		StridedView<_tDataType>								Slice( size_t _sDim, size_t _sStart, size_t _sEnd, size_t _sStep = 1 ) const {
+			if ( _sDim >= m_vShape.size() ) { throw std::out_of_range( "StridedView::Slice: Invalid dimension." ); }
+			if ( _sStart > _sEnd || _sEnd > m_vShape[_sDim] || _sStep == 0 ) { throw std::out_of_range( "StridedView::Slice: Invalid range." ); }
+			StridedView<_tDataType> svRet( (*this) );
+			if ( _sEnd > _sStart ) { svRet.m_pData += _sStart * m_vStride[_sDim]; }
+			svRet.m_vShape[_sDim] = (_sEnd - _sStart + _sStep - 1) / _sStep;
+			svRet.m_vStride[_sDim] *= _sStep;
+			svRet.Collapse();
+			return svRet;
+		}
+
+		/**
+		 * Creates a view with two dimensions swapped.
+		 *
+		 * \param _sDim0 The first dimension to swap.
+		 * \param _sDim1 The second dimension to swap.
+		 * \throw Throws if either dimension is invalid.
+		 * \return Returns the transposed view.
+		 **/
+		StridedView<_tDataType>								Transpose( size_t _sDim0, size_t _sDim1 ) const {
+			if ( _sDim0 >= m_vShape.size() || _sDim1 >= m_vShape.size() ) { throw std::out_of_range( "StridedView::Transpose: Invalid dimension." ); }
+			StridedView<_tDataType> svRet( (*this) );
+			std::swap( svRet.m_vShape[_sDim0], svRet.m_vShape[_sDim1] );
+			std::swap( svRet.m_vStride[_sDim0], svRet.m_vStride[_sDim1] );
+			svRet.Collapse();
+			return svRet;
+		}
+
+		/**
+		 * Creates a view with its dimensions reordered.  Dimension I of the result is dimension _vOrder[I] of this view.
+		 *
+		 * \param _vOrder The new order of the dimensions.
+		 * \throw Throws if _vOrder is not a permutation of this view's dimensions.
+		 * \return Returns the permuted view.
+		 **/
+		StridedView<_tDataType>								Permute( const std::vector<size_t> &_vOrder ) const {
+			if ( _vOrder.size() != m_vShape.size() ) { throw std::invalid_argument( "StridedView::Permute: Order must list every dimension once." ); }
+			std::vector<bool> vUsed( m_vShape.size() );
+			StridedView<_tDataType> svRet( (*this) );
+			for ( size_t I = 0; I < _vOrder.size(); ++I ) {
+				if ( _vOrder[I] >= m_vShape.size() || vUsed[_vOrder[I]] ) { throw std::invalid_argument( "StridedView::Permute: Order must list every dimension once." ); }
+				vUsed[_vOrder[I]] = true;
+				svRet.m_vShape[I] = m_vShape[_vOrder[I]];
+				svRet.m_vStride[I] = m_vStride[_vOrder[I]];
+			}
+			svRet.Collapse();
+			return svRet;
+		}
+
+		/**
+		 * Creates a view broadcast to a larger shape.  Dimensions are matched from the innermost out; each must either match the new size
+		 *	or be 1, and new outer dimensions may be added.  Expanded dimensions have a stride of 0 and the result must not be written.
+		 *
+		 * \param _vShape The shape to which to expand.
+		 * \throw Throws if the view cannot be broadcast to the given shape.
+		 * \return Returns the expanded view.
+		 **/
+		StridedView<_tDataType>								Expand( const std::vector<size_t> &_vShape ) const {
+			if ( _vShape.size() < m_vShape.size() ) { throw std::invalid_argument( "StridedView::Expand: Cannot remove dimensions." ); }
+			StridedView<_tDataType> svRet( (*this) );
+			size_t sLead = _vShape.size() - m_vShape.size();
+			svRet.m_vShape = _vShape;
+			svRet.m_vStride.assign( _vShape.size(), 0 );
+			for ( size_t I = 0; I < m_vShape.size(); ++I ) {
+				if ( m_vShape[I] == _vShape[sLead+I] ) {
+					svRet.m_vStride[sLead+I] = m_vStride[I];
+				}
+				else if ( m_vShape[I] != 1 ) { throw std::invalid_argument( "StridedView::Expand: Only dimensions of size 1 can be expanded." ); }
+			}
+			svRet.Collapse();
+			return svRet;
+		}
+
+		/**
+		 * Calls a function on every run of elements in row-major order.  A run is a stretch along the innermost dimension after merging
+		 *	dimensions that are laid out back-to-back.  The function receives a pointer to the first element of the run, the number of
+		 *	elements in the run, and the stride between them.
+		 *
+		 * \param _fFunc The function to call on each run.
+		 **/
+		template <typename _tFunc>
+		void												ForEachRun( _tFunc _fFunc ) const {
+			Walk( 0, m_sTotal, _fFunc );
+		}
+
+		/**
+		 * Calls a function on every element in row-major order.
+		 *
+		 * \param _fFunc The function to call on each element.
+		 **/
+		template <typename _tFunc>
+		void												ForEach( _tFunc _fFunc ) const {
+			Walk( 0, m_sTotal, [&]( _tDataType * _pRun, size_t _sTotal, size_t _sStride ) {
+				if ( _sStride == 1 ) {
+					for ( size_t I = 0; I < _sTotal; ++I ) { _fFunc( _pRun[I] ); }
+				}
+				else {
+					for ( size_t I = 0; I < _sTotal; ++I ) { _fFunc( _pRun[I*_sStride] ); }
+				}
+			} );
+		}
+
+		/**
+		 * Copies elements in row-major order out of the view.
+		 *
+		 * \param _sStart The row-major index of the first element to copy.
+		 * \param _sTotal The number of elements to copy.
+		 * \param _pDst The destination array.
+		 **/
+		void												Gather( size_t _sStart, size_t _sTotal, _tDataType * _pDst ) const {
+			Walk( _sStart, _sTotal, [&]( const _tDataType * _pRun, size_t _sRun, size_t _sStride ) {
+				for ( size_t I = 0; I < _sRun; ++I ) { (*_pDst++) = _pRun[I*_sStride]; }
+			} );
+		}
+
+		/**
+		 * Copies elements in row-major order into the view.
+		 *
+		 * \param _sStart The row-major index of the first element to write.
+		 * \param _sTotal The number of elements to write.
+		 * \param _pSrc The source array.
+		 **/
+		void												Scatter( size_t _sStart, size_t _sTotal, const _tDataType * _pSrc ) const {
+			Walk( _sStart, _sTotal, [&]( _tDataType * _pRun, size_t _sRun, size_t _sStride ) {
+				for ( size_t I = 0; I < _sRun; ++I ) { _pRun[I*_sStride] = (*_pSrc++); }
+			} );
+		}
+
+
+	protected :
+		// == Members.
+		View<_tDataType>									m_vBase;										/**< Keeps the buffer mapped and referenced. */
+		_tDataType *										m_pData;										/**< The element at index 0 in every dimension. */
+		std::vector<size_t>									m_vShape;										/**< Size of each dimension. */
+		std::vector<size_t>									m_vStride;										/**< Stride, in elements, of each dimension. */
+		std::vector<size_t>									m_vRunShape;									/**< The shape with size-1 dimensions removed and back-to-back dimensions merged. */
+		std::vector<size_t>									m_vRunStride;									/**< Strides matching m_vRunShape. */
+		size_t												m_sTotal = 0;									/**< Total elements in the view. */
+
+
+		// == Functions.
+		/**
+		 * Gets the offset of an index along a dimension.
+		 *
+		 * \param _sDim The dimension.
+		 * \param _sIdx The index along the dimension.
+		 * \throw If NN9_SAFETY_CHECK, throws if the index is out of range.
+		 * \return Returns the offset, in elements, from Data().
+		 **/
+		size_t												Index( size_t _sDim, size_t _sIdx ) const {
+#ifdef NN9_SAFETY_CHECK
+			if ( _sIdx >= m_vShape[_sDim] ) {
+				throw std::out_of_range( "StridedView::Index: Index out of range." );
+			}
+#endif	// #ifdef NN9_SAFETY_CHECK
+			return _sIdx * m_vStride[_sDim];
+		}
+
+		/**
+		 * Recalculates the element count and the merged run shape after the shape or strides change.
+		 **/
+		void												Collapse() {
+			m_sTotal = 1;
+			for ( auto sDim : m_vShape ) { m_sTotal *= sDim; }
+
+			m_vRunShape.clear();
+			m_vRunStride.clear();
+			if ( !m_sTotal ) {
+				m_vRunShape.push_back( 0 );
+				m_vRunStride.push_back( 1 );
+				return;
+			}
+			for ( size_t I = 0; I < m_vShape.size(); ++I ) {
+				if ( m_vShape[I] == 1 ) { continue; }
+				// An outer dimension that steps exactly over the inner one merges into it.
+				if ( !m_vRunShape.empty() && m_vRunStride.back() == m_vStride[I] * m_vShape[I] ) {
+					m_vRunShape.back() *= m_vShape[I];
+					m_vRunStride.back() = m_vStride[I];
+				}
+				else {
+					m_vRunShape.push_back( m_vShape[I] );
+					m_vRunStride.push_back( m_vStride[I] );
+				}
+			}
+		}
+
+		/**
+		 * Visits a row-major range of elements one run at a time.
+		 *
+		 * \param _sStart The row-major index of the first element to visit.
+		 * \param _sTotal The number of elements to visit.
+		 * \param _fFunc The function to call with each run's pointer, length, and stride.
+		 **/
+		template <typename _tFunc>
+		void												Walk( size_t _sStart, size_t _sTotal, _tFunc &&_fFunc ) const {
+			if ( !_sTotal ) { return; }
+			if ( m_vRunShape.empty() ) {
+				_fFunc( m_pData, _sTotal, size_t( 1 ) );
+				return;
+			}
+			const size_t sOuterDims = m_vRunShape.size() - 1;
+			const size_t sInner = m_vRunShape[sOuterDims];
+			const size_t sInnerStride = m_vRunStride[sOuterDims];
+
+			size_t sInnerIdx = _sStart % sInner;
+			size_t sOuter = _sStart / sInner;
+			size_t sOffset = 0;
+			std::vector<size_t> vIdx( sOuterDims );
+			for ( size_t I = sOuterDims; I--; ) {
+				vIdx[I] = sOuter % m_vRunShape[I];
+				sOuter /= m_vRunShape[I];
+				sOffset += vIdx[I] * m_vRunStride[I];
+			}
+
+			while ( _sTotal ) {
+				size_t sRun = std::min( sInner - sInnerIdx, _sTotal );
+				_fFunc( m_pData + sOffset + sInnerIdx * sInnerStride, sRun, sInnerStride );
+				_sTotal -= sRun;
+				sInnerIdx = 0;
+				for ( size_t I = sOuterDims; I--; ) {
+					sOffset += m_vRunStride[I];
+					if ( ++vIdx[I] < m_vRunShape[I] ) { break; }
+					sOffset -= m_vRunStride[I] * m_vRunShape[I];
+					vIdx[I] = 0;
+				}
+			}
+		}
+	};
+
+
+	/**
+	 * Determines whether a type is a StridedView.
+	 **/
+	template <typename _tType>
+	struct IsStridedView : std::false_type {};
+
+	/**
+	 * Determines whether a type is a StridedView.
+	 **/
+	template <typename _tDataType>
+	struct IsStridedView<StridedView<_tDataType>> : std::true_type {};
+
+}	// namespace nn9
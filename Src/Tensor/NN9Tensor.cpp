@@ -9,16 +9,18 @@
 #include "NN9Tensor.h"
 #include "../Ops/NN9Init.h"
 
+#include <algorithm>
+
 
 namespace nn9 {
 
 	// == Constructors.
 	Tensor::Tensor( const std::vector<size_t> &_vShape, const std::vector<size_t> &_vStride, NN9_TYPE _tType,
 		double _dQuantizeScale, double _dQuantizeZero ) :
-		m_vShape( _vShape ),
-		m_vStride( _vStride ),
 		m_dQuantizeScale( _dQuantizeScale ),
-		m_dQuantizeZero( _dQuantizeZero ) {
+		m_dQuantizeZero( _dQuantizeZero ),
+		m_vShape( _vShape ),
+		m_vStride( _vStride ) {
 
 		m_sSize = 1;
 		for ( size_t sDim : m_vShape ) {
@@ -27,6 +29,41 @@ namespace nn9 {
 
 		m_pbBuffer = BufferManager::GblBufferManager.CreateBuffer( _tType, m_sSize, this );
 	}
+	Tensor::Tensor( std::shared_ptr<FileMap> _spfmFile, uint64_t _ui64Offset, const std::vector<size_t> &_vShape, NN9_TYPE _tType ) :
+		m_vShape( _vShape ) {
+		if ( m_vShape.size() == 0 ) {
+			throw std::invalid_argument( "Tensor: There must be at least 1 dimension." );
+		}
+		m_sSize = 1;
+		for ( size_t sDim : m_vShape ) {
+			m_sSize *= sDim;
+		}
+
+		CalculateStrides();
+		m_pbBuffer = BufferManager::GblBufferManager.CreateBuffer( _tType, m_sSize, std::move( _spfmFile ), _ui64Offset, this, true );
+	}
+	Tensor::Tensor( Buffer * _pbArena, size_t _sOffset, const std::vector<size_t> &_vShape, NN9_TYPE _tType ) :
+		m_vShape( _vShape ) {
+		if ( m_vShape.size() == 0 ) {
+			throw std::invalid_argument( "Tensor: There must be at least 1 dimension." );
+		}
+		m_sSize = 1;
+		for ( size_t sDim : m_vShape ) {
+			m_sSize *= sDim;
+		}
+
+		CalculateStrides();
+		m_pbBuffer = BufferManager::GblBufferManager.CreateBuffer( _tType, m_sSize, _pbArena, _sOffset, this );
+	}
+	Tensor::Tensor( const Tensor &_tSrc, const std::vector<size_t> &_vShape, const std::vector<size_t> &_vStride ) :
+		m_dQuantizeScale( _tSrc.m_dQuantizeScale ),
+		m_dQuantizeZero( _tSrc.m_dQuantizeZero ),
+		m_vShape( _vShape ),
+		m_vStride( _vStride ),
+		m_pbBuffer( _tSrc.m_pbBuffer ),
+		m_sSize( _tSrc.m_sSize ) {
+		m_pbBuffer->AddHolder();
+	}
 	Tensor::~Tensor() {
 		BufferManager::GblBufferManager.DeleteBuffer( m_pbBuffer );
 	}
@@ -109,6 +146,160 @@ namespace nn9 {
 		return tRet;
 	}
 
+	/**
+	 * Creates a tensor directly over data in a file without copying it.  Pages are read on first access and shared with every other mapping
+	 *	of the file.  The file is never written: modifying the tensor copies the touched pages privately.
+	 * 
+	 * \param _spfmFile The opened file.  FileMap::OpenReadOnly() is enough and lets other readers share the file.
+	 * \param _ui64Offset The byte offset of the tensor's data within the file.
+	 * \param _vShape The shape of the tensor.
+	 * \param _tType The data type of the tensor.
+	 * \throw Throws if the shape is empty or the data extends beyond the end of the file.
+	 * \return Returns the tensor.
+	 **/
+	Tensor Tensor::FromFile( std::shared_ptr<FileMap> _spfmFile, uint64_t _ui64Offset, const std::vector<size_t> &_vShape, NN9_TYPE _tType ) {
+		return Tensor( std::move( _spfmFile ), _ui64Offset, _vShape, _tType );
+	}
+
+	/**
+	 * Determines whether the tensor's elements are laid out in row-major order with no gaps.
+	 * 
+	 * \return Returns true if the strides match those of a freshly created tensor of the same shape.
+	 **/
+	bool Tensor::IsContiguous() const {
+		size_t sStride = 1;
+		for ( size_t I = m_vShape.size(); I > 0; --I ) {
+			// The stride of a size-1 dimension is never used.
+			if ( m_vShape[I-1] != 1 && m_vStride[I-1] != sStride ) { return false; }
+			sStride *= m_vShape[I-1];
+		}
+		return true;
+	}
+
+	/**
+	 * Gets a tensor sharing this tensor's buffer that is laid out in row-major order with no gaps.  Every tensor is: the shape changes
+	 *	only re-express the existing layout, and strided layouts exist only as a StridedView (see Strided()).  Nothing is copied.
+	 * 
+	 * \throw Throws if NN9_SAFETY_CHECK is defined and the tensor is not contiguous.
+	 * \return Returns a contiguous tensor with this tensor's values.
+	 **/
+	Tensor Tensor::Contiguous() const {
+#ifdef NN9_SAFETY_CHECK
+		if ( !IsContiguous() ) {
+			throw std::logic_error( "Tensor::Contiguous: The tensor is not contiguous." );
+		}
+#endif	// #ifdef NN9_SAFETY_CHECK
+		return Tensor( (*this), m_vShape, m_vStride );
+	}
+
+	/**
+	 * Gets a tensor with a new shape over the same values.  The result shares this tensor's buffer.
+	 * 
+	 * \param _vShape The new shape.  It must have the same number of elements as the current shape.
+	 * \throw Throws if the new shape is empty or has a different number of elements, or if the tensor is not contiguous.  Every tensor
+	 *	is (see Contiguous()), so the last case indicates a bug.
+	 * \return Returns the reshaped tensor.
+	 **/
+	Tensor Tensor::Reshape( const std::vector<size_t> &_vShape ) const {
+		if ( _vShape.size() == 0 ) {
+			throw std::invalid_argument( "Tensor::Reshape: There must be at least 1 dimension." );
+		}
+		size_t sOld = 1, sNew = 1;
+		for ( size_t sDim : m_vShape ) { sOld *= sDim; }
+		for ( size_t sDim : _vShape ) { sNew *= sDim; }
+		if ( sOld != sNew ) {
+			throw std::invalid_argument( "Tensor::Reshape: The new shape must have the same number of elements." );
+		}
+
+		// Contiguous layouts can always be re-expressed.
+		std::vector<size_t> vStride;
+		if ( !ViewStrides( m_vShape, m_vStride, _vShape, vStride ) ) {
+			throw std::logic_error( "Tensor::Reshape: The tensor is not contiguous." );
+		}
+		return Tensor( (*this), _vShape, vStride );
+	}
+
+	/**
+	 * Merges a range of dimensions into one.  For example, flattening { 60000, 28, 28 } from dimension 1 gives { 60000, 784 }.
+	 * 
+	 * \param _sStart The first dimension to merge.
+	 * \param _sEnd The last dimension to merge.  Values past the last dimension are clamped to it.
+	 * \throw Throws if _sStart is out of range or after _sEnd.
+	 * \return Returns the flattened tensor, which shares this tensor's buffer.
+	 **/
+	Tensor Tensor::Flatten( size_t _sStart, size_t _sEnd ) const {
+		_sEnd = std::min( _sEnd, m_vShape.size() - 1 );
+		if ( _sStart > _sEnd ) {
+			throw std::out_of_range( "Tensor::Flatten: Invalid dimension range." );
+		}
+		std::vector<size_t> vShape( m_vShape.begin(), m_vShape.begin() + _sStart );
+		size_t sMerged = 1;
+		for ( size_t I = _sStart; I <= _sEnd; ++I ) { sMerged *= m_vShape[I]; }
+		vShape.push_back( sMerged );
+		vShape.insert( vShape.end(), m_vShape.begin() + _sEnd + 1, m_vShape.end() );
+		return Reshape( vShape );
+	}
+
+	/**
+	 * Removes every dimension of size 1.  A tensor with only size-1 dimensions becomes { 1 }.
+	 * 
+	 * \return Returns the squeezed tensor, which always shares this tensor's buffer.
+	 **/
+	Tensor Tensor::Squeeze() const {
+		std::vector<size_t> vShape, vStride;
+		for ( size_t I = 0; I < m_vShape.size(); ++I ) {
+			if ( m_vShape[I] != 1 ) {
+				vShape.push_back( m_vShape[I] );
+				vStride.push_back( m_vStride[I] );
+			}
+		}
+		if ( vShape.size() == 0 ) {
+			vShape.push_back( 1 );
+			vStride.push_back( 1 );
+		}
+		return Tensor( (*this), vShape, vStride );
+	}
+
+	/**
+	 * Removes a dimension of size 1.  The only dimension of a 1-D tensor is kept.
+	 * 
+	 * \param _sDim The dimension to remove.
+	 * \throw Throws if the dimension is out of range or its size is not 1.
+	 * \return Returns the squeezed tensor, which always shares this tensor's buffer.
+	 **/
+	Tensor Tensor::Squeeze( size_t _sDim ) const {
+		if ( _sDim >= m_vShape.size() ) {
+			throw std::out_of_range( "Tensor::Squeeze: Invalid dimension." );
+		}
+		if ( m_vShape[_sDim] != 1 ) {
+			throw std::invalid_argument( "Tensor::Squeeze: Only dimensions of size 1 can be removed." );
+		}
+		if ( m_vShape.size() == 1 ) { return Tensor( (*this), m_vShape, m_vStride ); }
+		std::vector<size_t> vShape( m_vShape ), vStride( m_vStride );
+		vShape.erase( vShape.begin() + _sDim );
+		vStride.erase( vStride.begin() + _sDim );
+		return Tensor( (*this), vShape, vStride );
+	}
+
+	/**
+	 * Inserts a dimension of size 1.
+	 * 
+	 * \param _sDim The index the new dimension will have.  Can be up to the current number of dimensions.
+	 * \throw Throws if the dimension is out of range.
+	 * \return Returns the unsqueezed tensor, which always shares this tensor's buffer.
+	 **/
+	Tensor Tensor::Unsqueeze( size_t _sDim ) const {
+		if ( _sDim > m_vShape.size() ) {
+			throw std::out_of_range( "Tensor::Unsqueeze: Invalid dimension." );
+		}
+		std::vector<size_t> vShape( m_vShape ), vStride( m_vStride );
+		// Give the new dimension the stride it would have in a contiguous layout so that IsContiguous() is unaffected.
+		size_t sStride = _sDim < m_vShape.size() ? m_vStride[_sDim] * m_vShape[_sDim] : 1;
+		vShape.insert( vShape.begin() + _sDim, 1 );
+		vStride.insert( vStride.begin() + _sDim, sStride );
+		return Tensor( (*this), vShape, vStride );
+	}
+
 	/**
 	 * Calculates the stride table.
 	 **/
@@ -121,4 +312,54 @@ namespace nn9 {
 		}
 	}
 
+	/**
+	 * Finds strides that let a new shape walk existing data in the same row-major order.  This is possible whenever each group of
+	 *	old dimensions that the new shape splits or merges is itself laid out back-to-back.
+	 * 
+	 * \param _vShape The current shape.
+	 * \param _vStride The current strides.
+	 * \param _vNewShape The new shape, with the same number of elements.
+	 * \param _vNewStride Holds the new strides on success.
+	 * \return Returns true if the new shape can be expressed over the existing layout.
+	 **/
+	bool Tensor::ViewStrides( const std::vector<size_t> &_vShape, const std::vector<size_t> &_vStride,
+		const std::vector<size_t> &_vNewShape, std::vector<size_t> &_vNewStride ) {
+		_vNewStride.assign( _vNewShape.size(), 0 );
+		size_t sTotal = 1;
+		for ( size_t sDim : _vShape ) { sTotal *= sDim; }
+		if ( sTotal == 0 ) {
+			// Nothing is ever read, so any strides work; use contiguous ones.
+			size_t sStride = 1;
+			for ( size_t I = _vNewShape.size(); I > 0; --I ) {
+				_vNewStride[I-1] = sStride;
+				sStride *= std::max<size_t>( _vNewShape[I-1], 1 );
+			}
+			return true;
+		}
+
+		// Walk both shapes from the innermost dimension.  Each "chunk" is a run of old dimensions that are back-to-back in memory; the new
+		//	dimensions covering the same elements can then be given strides that are multiples of the chunk's innermost stride.
+		size_t sNewDim = _vNewShape.size();
+		size_t sChunkStride = _vStride.back();
+		size_t sOldElements = 1, sNewElements = 1;
+		for ( size_t I = _vShape.size(); I > 0; --I ) {
+			size_t sDim = I - 1;
+			sOldElements *= _vShape[sDim];
+			if ( sDim == 0 || (_vShape[sDim-1] != 1 && _vStride[sDim-1] != sOldElements * sChunkStride) ) {
+				while ( sNewDim > 0 && (sNewElements < sOldElements || _vNewShape[sNewDim-1] == 1) ) {
+					_vNewStride[sNewDim-1] = sNewElements * sChunkStride;
+					sNewElements *= _vNewShape[sNewDim-1];
+					--sNewDim;
+				}
+				if ( sNewElements != sOldElements ) { return false; }
+				if ( sDim > 0 ) {
+					sChunkStride = _vStride[sDim-1];
+					sOldElements = 1;
+					sNewElements = 1;
+				}
+			}
+		}
+		return sNewDim == 0;
+	}
+
 }	// namespace nn9
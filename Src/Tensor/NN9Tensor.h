@@ -11,6 +11,7 @@
 #include "../Buffers/NN9Buffer.h"
 #include "../Buffers/NN9BufferManager.h"
 #include "../Foundation/NN9RefCnt.h"
+#include "NN9StridedView.h"
 
 #include <cstdarg>
 #include <initializer_list>
@@ -38,6 +39,9 @@ namespace nn9 {
 				int32_t i32Cnt = _tOther.m_aCnt;
 				m_aCnt = i32Cnt;
 
+				// Buffer references are forwarded to the owning tensor, which is now this one.  Shared buffers have no owner.
+				if ( m_pbBuffer && m_pbBuffer->Owner() == &_tOther ) { m_pbBuffer->SetOwner( this ); }
+
 				_tOther.m_pbBuffer = nullptr;
 				_tOther.m_sSize = 0;
 				_tOther.m_dQuantizeScale = 1.0;
@@ -45,7 +49,7 @@ namespace nn9 {
 				_tOther.m_aCnt = 0;
 			}
 		}
-		Tensor( std::initializer_list<size_t> _ilShape, NN9_TYPE _tType ) :
+		Tensor( std::initializer_list<size_t> _ilShape, NN9_TYPE _tType, NN9_BUFFER_INIT _biInit = NN9_BI_UNINITIALIZED ) :
 			m_vShape( _ilShape ) {
 			if ( m_vShape.size() == 0 ) {
 				throw std::invalid_argument( "Tensor: There must be at least 1 dimension." );
@@ -56,7 +60,7 @@ namespace nn9 {
 			}
 
 			CalculateStrides();
-			m_pbBuffer = BufferManager::GblBufferManager.CreateBuffer( _tType, m_sSize, this );
+			m_pbBuffer = BufferManager::GblBufferManager.CreateBuffer( _tType, m_sSize, this, _biInit );
 		}
 		template <typename _tInitType>
 		Tensor( std::initializer_list<size_t> _ilShape, NN9_TYPE _tType, _tInitType _tInitValue ) :
@@ -101,6 +105,14 @@ namespace nn9 {
 
 				NN9_SET( NN9_T_COMPLEX64, std::complex<float> )
 				NN9_SET( NN9_T_COMPLEX128, std::complex<double> )
+				default : {
+					// The buffer is created uninitialized; types without a conversion are left zeroed as before.
+					auto aView = m_pbBuffer->FullView<uint8_t>();
+					auto aSize = aView.size();
+					for ( size_t I = 0; I < aSize; ++I ) {
+						aView[I] = 0;
+					}
+				}
 			}
 #undef NN9_SET
 		}
@@ -198,6 +210,41 @@ namespace nn9 {
 		 **/
 		size_t											DimSize( size_t _sIdx ) const { return m_vShape[_sIdx]; }
 
+		/**
+		 * Gets the shape of the tensor.
+		 * 
+		 * \return Returns the size of each dimension.
+		 **/
+		const std::vector<size_t> &						Shape() const { return m_vShape; }
+
+		/**
+		 * Gets the strides of the tensor.
+		 * 
+		 * \return Returns the stride, in elements, of each dimension.
+		 **/
+		const std::vector<size_t> &						Strides() const { return m_vStride; }
+
+		/**
+		 * Gets the data type of the tensor.
+		 * 
+		 * \return Returns the data type of the tensor.
+		 **/
+		NN9_TYPE										Type() const { return m_pbBuffer->Type(); }
+
+		/**
+		 * Gets the quantization scale.
+		 * 
+		 * \return Returns the quantization scale.
+		 **/
+		double											QuantizeScale() const { return m_dQuantizeScale; }
+
+		/**
+		 * Gets the quantization zero point.
+		 * 
+		 * \return Returns the quantization zero point.
+		 **/
+		double											QuantizeZero() const { return m_dQuantizeZero; }
+
 		/**
 		 * Gets a view to the whole buffer.
 		 * 
@@ -222,6 +269,79 @@ namespace nn9 {
 			return m_pbBuffer->RangeView<_tType>( _sStart, _sTotal );
 		}
 
+		/**
+		 * Gets an N-D view of the whole tensor using its shape and strides.
+		 * 
+		 * \tparam _tType The tensor's element type.
+		 * \throw If NN9_SAFETY_CHECK, throws if _tType is not the same size as the tensor's element type.
+		 * \return Returns a strided view of the entire tensor.
+		 **/
+		template <typename _tType>
+		StridedView<_tType>								Strided() {
+#ifdef NN9_SAFETY_CHECK
+			if ( sizeof( _tType ) != Types::SizeOf( Type() ) ) {
+				throw std::invalid_argument( "Tensor::Strided: View type must match the tensor type." );
+			}
+#endif	// #ifdef NN9_SAFETY_CHECK
+			return StridedView<_tType>( FullView<_tType>(), m_vShape, m_vStride );
+		}
+
+		/**
+		 * Gets a view of a range along one dimension without copying.
+		 * 
+		 * \tparam _tType The tensor's element type.
+		 * \param _sDim The dimension to slice.
+		 * \param _sStart The first index to keep.
+		 * \param _sEnd One past the last index to keep.
+		 * \param _sStep The distance between kept indices.
+		 * \throw Throws if the dimension or range is invalid.
+		 * \return Returns the sliced view.
+		 **/
+		template <typename _tType>
+		StridedView<_tType>								Slice( size_t _sDim, size_t _sStart, size_t _sEnd, size_t _sStep = 1 ) {
+			return Strided<_tType>().Slice( _sDim, _sStart, _sEnd, _sStep );
+		}
+
+		/**
+		 * Gets a view with two dimensions swapped without copying.
+		 * 
+		 * \tparam _tType The tensor's element type.
+		 * \param _sDim0 The first dimension to swap.
+		 * \param _sDim1 The second dimension to swap.
+		 * \throw Throws if either dimension is invalid.
+		 * \return Returns the transposed view.
+		 **/
+		template <typename _tType>
+		StridedView<_tType>								Transpose( size_t _sDim0, size_t _sDim1 ) {
+			return Strided<_tType>().Transpose( _sDim0, _sDim1 );
+		}
+
+		/**
+		 * Gets a view with the dimensions reordered without copying.  Dimension I of the result is dimension _vOrder[I] of the tensor.
+		 * 
+		 * \tparam _tType The tensor's element type.
+		 * \param _vOrder The new order of the dimensions.
+		 * \throw Throws if _vOrder is not a permutation of the tensor's dimensions.
+		 * \return Returns the permuted view.
+		 **/
+		template <typename _tType>
+		StridedView<_tType>								Permute( const std::vector<size_t> &_vOrder ) {
+			return Strided<_tType>().Permute( _vOrder );
+		}
+
+		/**
+		 * Gets a read-only view broadcast to a larger shape without copying.
+		 * 
+		 * \tparam _tType The tensor's element type.
+		 * \param _vShape The shape to which to expand.  Each tensor dimension must match or be 1.
+		 * \throw Throws if the tensor cannot be broadcast to the given shape.
+		 * \return Returns the expanded view.
+		 **/
+		template <typename _tType>
+		StridedView<_tType>								Expand( const std::vector<size_t> &_vShape ) {
+			return Strided<_tType>().Expand( _vShape );
+		}
+
 		/**
 		 * For a 1-D tensor, puts the full buffer view into a single vector entry.  For 2-D tensors, such that X is the flat first dimension
 		 *	and Y is the 2nd dimension, puts the full buffer into views spread across vector entries.  The number of views will be the Y
@@ -364,6 +484,80 @@ namespace nn9 {
 		 **/
 		Tensor											CopyAs( NN9_TYPE _tNewType ) const;
 
+		/**
+		 * Determines whether the tensor's elements are laid out in row-major order with no gaps.
+		 * 
+		 * \return Returns true if the strides match those of a freshly created tensor of the same shape.
+		 **/
+		bool											IsContiguous() const;
+
+		/**
+		 * Gets a tensor sharing this tensor's buffer that is laid out in row-major order with no gaps.  Every tensor is: the shape changes
+		 *	below only re-express the existing layout, and strided layouts exist only as a StridedView (see Strided()).  Nothing is copied.
+		 * 
+		 * \throw Throws if NN9_SAFETY_CHECK is defined and the tensor is not contiguous.
+		 * \return Returns a contiguous tensor with this tensor's values.
+		 **/
+		Tensor											Contiguous() const;
+
+		/**
+		 * Gets a tensor with a new shape over the same values.  The result shares this tensor's buffer.
+		 * 
+		 * \param _vShape The new shape.  It must have the same number of elements as the current shape.
+		 * \throw Throws if the new shape is empty or has a different number of elements, or if the tensor is not contiguous.  Every tensor
+		 *	is (see Contiguous()), so the last case indicates a bug.
+		 * \return Returns the reshaped tensor.
+		 **/
+		Tensor											Reshape( const std::vector<size_t> &_vShape ) const;
+
+		/**
+		 * Merges a range of dimensions into one.  For example, flattening { 60000, 28, 28 } from dimension 1 gives { 60000, 784 }.
+		 * 
+		 * \param _sStart The first dimension to merge.
+		 * \param _sEnd The last dimension to merge.  Values past the last dimension are clamped to it.
+		 * \throw Throws if _sStart is out of range or after _sEnd.
+		 * \return Returns the flattened tensor, which shares this tensor's buffer.
+		 **/
+		Tensor											Flatten( size_t _sStart = 0, size_t _sEnd = ~size_t( 0 ) ) const;
+
+		/**
+		 * Removes every dimension of size 1.  A tensor with only size-1 dimensions becomes { 1 }.
+		 * 
+		 * \return Returns the squeezed tensor, which always shares this tensor's buffer.
+		 **/
+		Tensor											Squeeze() const;
+
+		/**
+		 * Removes a dimension of size 1.  The only dimension of a 1-D tensor is kept.
+		 * 
+		 * \param _sDim The dimension to remove.
+		 * \throw Throws if the dimension is out of range or its size is not 1.
+		 * \return Returns the squeezed tensor, which always shares this tensor's buffer.
+		 **/
+		Tensor											Squeeze( size_t _sDim ) const;
+
+		/**
+		 * Inserts a dimension of size 1.
+		 * 
+		 * \param _sDim The index the new dimension will have.  Can be up to the current number of dimensions.
+		 * \throw Throws if the dimension is out of range.
+		 * \return Returns the unsqueezed tensor, which always shares this tensor's buffer.
+		 **/
+		Tensor											Unsqueeze( size_t _sDim ) const;
+
+		/**
+		 * Creates a tensor directly over data in a file without copying it.  Pages are read on first access and shared with every other mapping
+		 *	of the file.  The file is never written: modifying the tensor copies the touched pages privately.
+		 * 
+		 * \param _spfmFile The opened file.  FileMap::OpenReadOnly() is enough and lets other readers share the file.
+		 * \param _ui64Offset The byte offset of the tensor's data within the file.
+		 * \param _vShape The shape of the tensor.
+		 * \param _tType The data type of the tensor.
+		 * \throw Throws if the shape is empty or the data extends beyond the end of the file.
+		 * \return Returns the tensor.
+		 **/
+		static Tensor									FromFile( std::shared_ptr<FileMap> _spfmFile, uint64_t _ui64Offset, const std::vector<size_t> &_vShape, NN9_TYPE _tType );
+
 
 	protected :
 		// == Members.
@@ -378,6 +572,9 @@ namespace nn9 {
 		// == Constructors.
 		Tensor( const std::vector<size_t> &_vShape, const std::vector<size_t> &_vStride, NN9_TYPE _tType,
 			double _dQuantizeScale, double _dQuantizeZero );
+		Tensor( std::shared_ptr<FileMap> _spfmFile, uint64_t _ui64Offset, const std::vector<size_t> &_vShape, NN9_TYPE _tType );
+		Tensor( Buffer * _pbArena, size_t _sOffset, const std::vector<size_t> &_vShape, NN9_TYPE _tType );
+		Tensor( const Tensor &_tSrc, const std::vector<size_t> &_vShape, const std::vector<size_t> &_vStride );
 			
 
 		// == Functions.
@@ -385,6 +582,27 @@ namespace nn9 {
 		 * Calculates the stride table.
 		 **/
 		void											CalculateStrides();
+
+		/**
+		 * Finds strides that let a new shape walk existing data in the same row-major order.  This is possible whenever each group of
+		 *	old dimensions that the new shape splits or merges is itself laid out back-to-back.
+		 * 
+		 * \param _vShape The current shape.
+		 * \param _vStride The current strides.
+		 * \param _vNewShape The new shape, with the same number of elements.
+		 * \param _vNewStride Holds the new strides on success.
+		 * \return Returns true if the new shape can be expressed over the existing layout.
+		 **/
+		static bool										ViewStrides( const std::vector<size_t> &_vShape, const std::vector<size_t> &_vStride,
+			const std::vector<size_t> &_vNewShape, std::vector<size_t> &_vNewStride );
+
+
+	private :
+		friend class									Checkpoint;
+		friend class									Graph;
+		friend class									QGemm;
+		friend class									Quantize;
+		friend class									Tape;
 	};
 
 }	// namespace nn9
@@ -566,7 +566,8 @@ namespace nn9 {
 		__m512i mShift = _mm512_sub_epi32( _mm512_set1_epi32( 125 ), mExpo );
 		__m512i mSubnorm = _mm512_srlv_epi32( mMantSubnorm, mShift );
 		mSubnorm = _mm512_srli_epi32( _mm512_add_epi32( mSubnorm, _mm512_set1_epi32( 1 ) ), 1 );
-		mSubnorm = _mm512_and_epi32( mSubnorm, _mm512_set1_epi32( 0x03FF ) );
+		// Rounding can carry into 0x0400, the smallest normal value, so the exponent bit is kept.
+		mSubnorm = _mm512_and_epi32( mSubnorm, _mm512_set1_epi32( 0x07FF ) );
 		mSubnorm = _mm512_or_epi32( mSubnorm, mSign );
 
 		// Special cases (NaN and Infinity).
@@ -737,7 +738,8 @@ namespace nn9 {
 		// For variable shifts in AVX2, use _mm256_srlv_epi32.
 		__m256i mSubnormTemp = _mm256_srlv_epi32( mMantSubnorm, mShift );
 		mSubnormTemp = _mm256_srli_epi32( _mm256_add_epi32( mSubnormTemp, _mm256_set1_epi32( 1 ) ), 1 );
-		mSubnormTemp = _mm256_and_si256( mSubnormTemp, _mm256_set1_epi32( 0x03FF ) );
+		// Rounding can carry into 0x0400, the smallest normal value, so the exponent bit is kept.
+		mSubnormTemp = _mm256_and_si256( mSubnormTemp, _mm256_set1_epi32( 0x07FF ) );
 		__m256i mSubnorm = _mm256_or_si256( mSubnormTemp, mSign );
 
 		// Special cases (NaN and Infinity).
@@ -9,34 +9,22 @@
 #include "NN9ThreadPool.h"
 #include "../OS/NN9Os.h"
 
+#include <algorithm>
+
 namespace nn9 {
 
+    // == Members.
+    thread_local ThreadPool * ThreadPool::m_ptpOwner = nullptr;					/**< The pool of which the calling thread is a worker. */
+    thread_local size_t ThreadPool::m_sWorkerIndex = 0;							/**< The index of the calling worker within m_ptpOwner. */
+
+    // == Functions.
     ThreadPool::ThreadPool( size_t _tThreads ) :
-        m_bStop( false ) {
+        m_sThreads( _tThreads ),
+        m_pdDeques( new NN9_DEQUE[_tThreads] ),
+        m_pqShared( new NN9_QUEUE() ) {
+        m_vWorkers.reserve( _tThreads );
         for ( size_t i = 0; i < _tThreads; ++i ) {
-            m_vWorkers.emplace_back(
-                [this] {
-                    for (;;) {
-                        std::function<void()> fTask;
-
-                        // Acquire lock and wait for tasks.
-                        {
-                            std::unique_lock<std::mutex> ulLock( this->m_mQueueMutex );
-                            this->m_cvCondition.wait(
-                                ulLock, [this] { return this->m_bStop || !this->m_qTasks.empty(); });
-
-                            // Exit condition.
-                            if ( this->m_bStop && this->m_qTasks.empty() ) { return; }
-
-                            // Get the next task.
-                            fTask = std::move( this->m_qTasks.front() );
-                            this->m_qTasks.pop();
-                        }
-
-                        // Execute the task.
-                        fTask();
-                    }
-                });
+            m_vWorkers.emplace_back( [this, i] { WorkerLoop( i ); } );
 
             // Set thread affinity to associate each thread with a different core.
             std::thread & tWorker = m_vWorkers.back();
@@ -47,13 +35,11 @@ namespace nn9 {
     }
     ThreadPool::~ThreadPool() {
         // Indicate that the pool is stopping.
-        {
-            std::unique_lock<std::mutex> ulLock( m_mQueueMutex );
-            m_bStop = true;
-        }
+        m_bStop.store( true, std::memory_order_seq_cst );
 
         // Wake up all threads to finish execution.
-        m_cvCondition.notify_all();
+        m_aWake.fetch_add( 1, std::memory_order_seq_cst );
+        m_aWake.notify_all();
 
         // Join all threads.
         for ( std::thread & tWorker : m_vWorkers ) {
@@ -61,4 +47,272 @@ namespace nn9 {
         }
     }
 
+    /**
+     * Pushes a caller-owned task without allocating.  From a worker of this pool the task goes onto the worker's own deque, otherwise it
+     *	goes onto the shared queue.  If the target queue is full, or the pool has no workers, the task is run immediately on the calling
+     *	thread.
+     *
+     * \param _ptTask The task to push.  Its paPending counter, if any, must already account for this push.
+     * \throws std::runtime_error if the thread pool is stopped.
+     */
+    void ThreadPool::Push( NN9_TASK * _ptTask ) {
+        if ( m_bStop.load( std::memory_order_relaxed ) ) {
+            throw std::runtime_error( "ThreadPool::Push: Cannot push to a stopped ThreadPool." );
+        }
+        bool bQueued = false;
+        if ( m_ptpOwner == this ) { bQueued = m_pdDeques[m_sWorkerIndex].Push( _ptTask ); }
+        if ( !bQueued && m_sThreads ) { bQueued = m_pqShared->Push( _ptTask ); }
+        if ( !bQueued ) {
+            Run( _ptTask );
+            return;
+        }
+        WakeOne();
+    }
+
+    /**
+     * Waits for a counter to reach 0, running queued tasks on the calling thread until it does.
+     *
+     * \param _aPending The counter to wait on, typically the paPending of tasks given to Push().
+     */
+    void ThreadPool::Wait( const std::atomic<size_t> &_aPending ) {
+        size_t sIdle = 0;
+        while ( _aPending.load( std::memory_order_acquire ) ) {
+            NN9_TASK * ptTask = FindTask();
+            if ( ptTask ) {
+                Run( ptTask );
+                sIdle = 0;
+                continue;
+            }
+            if ( ++sIdle < NN9_TP_SPINS || m_ptpOwner ) {
+                // Workers keep helping rather than sleeping so that tasks from the shared queue cannot be starved by nested waits.
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Sleep until some counter reaches 0, re-checking ours after registering so that the signal cannot be missed.
+            uint32_t ui32Done = m_aDone.load( std::memory_order_seq_cst );
+            m_aWaiters.fetch_add( 1, std::memory_order_seq_cst );
+            if ( _aPending.load( std::memory_order_seq_cst ) ) { m_aDone.wait( ui32Done, std::memory_order_seq_cst ); }
+            m_aWaiters.fetch_sub( 1, std::memory_order_relaxed );
+            sIdle = 0;
+        }
+    }
+
+    /**
+     * Gets the shared pool, with one thread per core, that is used for data-parallel operations.  It is created on first use.
+     *
+     * \return Returns the shared pool.
+     */
+    ThreadPool & ThreadPool::Global() {
+        static ThreadPool tpPool( std::max<size_t>( std::thread::hardware_concurrency(), 1 ) );
+        return tpPool;
+    }
+
+    /**
+     * The main loop of each worker.
+     *
+     * \param _sIndex The index of the worker.
+     */
+    void ThreadPool::WorkerLoop( size_t _sIndex ) {
+        m_ptpOwner = this;
+        m_sWorkerIndex = _sIndex;
+        size_t sIdle = 0;
+        for (;;) {
+            NN9_TASK * ptTask = FindTask();
+            if ( ptTask ) {
+                Run( ptTask );
+                sIdle = 0;
+                continue;
+            }
+            if ( ++sIdle < NN9_TP_SPINS ) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Register as a sleeper before the final look so that a concurrent Push() either is seen here or sees the sleeper and wakes it.
+            uint32_t ui32Wake = m_aWake.load( std::memory_order_seq_cst );
+            m_aSleepers.fetch_add( 1, std::memory_order_seq_cst );
+            ptTask = FindTask();
+            if ( ptTask ) {
+                m_aSleepers.fetch_sub( 1, std::memory_order_relaxed );
+                Run( ptTask );
+                sIdle = 0;
+                continue;
+            }
+            // Exit condition.
+            if ( m_bStop.load( std::memory_order_seq_cst ) ) {
+                m_aSleepers.fetch_sub( 1, std::memory_order_relaxed );
+                return;
+            }
+            m_aWake.wait( ui32Wake, std::memory_order_seq_cst );
+            m_aSleepers.fetch_sub( 1, std::memory_order_relaxed );
+            sIdle = 0;
+        }
+    }
+
+    /**
+     * Finds a task to run: first from the calling worker's own deque, then from the shared queue, then by stealing from other workers.
+     *
+     * \return Returns a task or nullptr if none was found.
+     */
+    ThreadPool::NN9_TASK * ThreadPool::FindTask() {
+        NN9_TASK * ptTask = nullptr;
+        if ( m_ptpOwner == this ) {
+            ptTask = m_pdDeques[m_sWorkerIndex].Take();
+            if ( ptTask ) { return ptTask; }
+        }
+        ptTask = m_pqShared->Pop();
+        if ( ptTask ) { return ptTask; }
+
+        // Steal, starting from a pseudo-random victim so that thieves spread out.
+        const size_t sTotal = m_sThreads;
+        if ( !sTotal ) { return nullptr; }
+        static thread_local uint32_t ui32Seed = static_cast<uint32_t>(std::hash<std::thread::id>()( std::this_thread::get_id() )) | 1;
+        ui32Seed ^= ui32Seed << 13;
+        ui32Seed ^= ui32Seed >> 17;
+        ui32Seed ^= ui32Seed << 5;
+        const size_t sStart = ui32Seed % sTotal;
+        for ( size_t I = 0; I < sTotal; ++I ) {
+            size_t sVictim = (sStart + I) % sTotal;
+            if ( m_ptpOwner == this && sVictim == m_sWorkerIndex ) { continue; }
+            ptTask = m_pdDeques[sVictim].Steal();
+            if ( ptTask ) { return ptTask; }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Runs a task and signals its counter.
+     *
+     * \param _ptTask The task to run.
+     */
+    void ThreadPool::Run( NN9_TASK * _ptTask ) {
+        // Read the counter first: the task may be freed by its own function (Submit()) or by its waiter as soon as the counter reaches 0.
+        std::atomic<size_t> * paPending = _ptTask->paPending;
+        _ptTask->pfFunc( _ptTask->pvParm );
+        if ( paPending && paPending->fetch_sub( 1, std::memory_order_seq_cst ) == 1 ) {
+            m_aDone.fetch_add( 1, std::memory_order_seq_cst );
+            if ( m_aWaiters.load( std::memory_order_seq_cst ) ) { m_aDone.notify_all(); }
+        }
+    }
+
+    /**
+     * Wakes a sleeping worker, if any.
+     */
+    void ThreadPool::WakeOne() {
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        if ( m_aSleepers.load( std::memory_order_seq_cst ) ) {
+            m_aWake.fetch_add( 1, std::memory_order_seq_cst );
+            m_aWake.notify_one();
+        }
+    }
+
+    /**
+     * Pushes a task onto the bottom of the deque.  Owner only.
+     *
+     * \param _ptTask The task to push.
+     * \return Returns false if the deque is full.
+     */
+    bool ThreadPool::NN9_DEQUE::Push( NN9_TASK * _ptTask ) {
+        int64_t i64Bottom = aBottom.load( std::memory_order_relaxed );
+        int64_t i64Top = aTop.load( std::memory_order_acquire );
+        if ( i64Bottom - i64Top >= int64_t( NN9_TP_DEQUE_SIZE ) ) { return false; }
+        aTasks[i64Bottom&(NN9_TP_DEQUE_SIZE-1)].store( _ptTask, std::memory_order_relaxed );
+        aBottom.store( i64Bottom + 1, std::memory_order_release );
+        return true;
+    }
+
+    /**
+     * Takes the most recently pushed task from the bottom of the deque.  Owner only.
+     *
+     * \return Returns the task or nullptr if the deque is empty.
+     */
+    ThreadPool::NN9_TASK * ThreadPool::NN9_DEQUE::Take() {
+        int64_t i64Bottom = aBottom.load( std::memory_order_relaxed ) - 1;
+        aBottom.store( i64Bottom, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        int64_t i64Top = aTop.load( std::memory_order_relaxed );
+        if ( i64Top > i64Bottom ) {
+            // Empty.
+            aBottom.store( i64Bottom + 1, std::memory_order_relaxed );
+            return nullptr;
+        }
+        NN9_TASK * ptTask = aTasks[i64Bottom&(NN9_TP_DEQUE_SIZE-1)].load( std::memory_order_relaxed );
+        if ( i64Top == i64Bottom ) {
+            // Last task: race any thieves for it.
+            if ( !aTop.compare_exchange_strong( i64Top, i64Top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) ) { ptTask = nullptr; }
+            aBottom.store( i64Bottom + 1, std::memory_order_relaxed );
+        }
+        return ptTask;
+    }
+
+    /**
+     * Steals the oldest task from the top of the deque.
+     *
+     * \return Returns the task or nullptr if the deque is empty or another thread won the race.
+     */
+    ThreadPool::NN9_TASK * ThreadPool::NN9_DEQUE::Steal() {
+        int64_t i64Top = aTop.load( std::memory_order_acquire );
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        int64_t i64Bottom = aBottom.load( std::memory_order_acquire );
+        if ( i64Top >= i64Bottom ) { return nullptr; }
+        NN9_TASK * ptTask = aTasks[i64Top&(NN9_TP_DEQUE_SIZE-1)].load( std::memory_order_relaxed );
+        if ( !aTop.compare_exchange_strong( i64Top, i64Top + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) ) { return nullptr; }
+        return ptTask;
+    }
+
+    ThreadPool::NN9_QUEUE::NN9_QUEUE() {
+        for ( size_t I = 0; I < NN9_TP_QUEUE_SIZE; ++I ) {
+            cCells[I].aSequence.store( I, std::memory_order_relaxed );
+            cCells[I].ptTask = nullptr;
+        }
+    }
+
+    /**
+     * Adds a task to the queue.
+     *
+     * \param _ptTask The task to add.
+     * \return Returns false if the queue is full.
+     */
+    bool ThreadPool::NN9_QUEUE::Push( NN9_TASK * _ptTask ) {
+        size_t sPos = aEnqueue.load( std::memory_order_relaxed );
+        NN9_CELL * pcCell;
+        for (;;) {
+            pcCell = &cCells[sPos&(NN9_TP_QUEUE_SIZE-1)];
+            size_t sSeq = pcCell->aSequence.load( std::memory_order_acquire );
+            intptr_t iptrDiff = intptr_t( sSeq ) - intptr_t( sPos );
+            if ( iptrDiff == 0 ) {
+                if ( aEnqueue.compare_exchange_weak( sPos, sPos + 1, std::memory_order_relaxed ) ) { break; }
+            }
+            else if ( iptrDiff < 0 ) { return false; }
+            else { sPos = aEnqueue.load( std::memory_order_relaxed ); }
+        }
+        pcCell->ptTask = _ptTask;
+        pcCell->aSequence.store( sPos + 1, std::memory_order_release );
+        return true;
+    }
+
+    /**
+     * Removes the oldest task from the queue.
+     *
+     * \return Returns the task or nullptr if the queue is empty.
+     */
+    ThreadPool::NN9_TASK * ThreadPool::NN9_QUEUE::Pop() {
+        size_t sPos = aDequeue.load( std::memory_order_relaxed );
+        NN9_CELL * pcCell;
+        for (;;) {
+            pcCell = &cCells[sPos&(NN9_TP_QUEUE_SIZE-1)];
+            size_t sSeq = pcCell->aSequence.load( std::memory_order_acquire );
+            intptr_t iptrDiff = intptr_t( sSeq ) - intptr_t( sPos + 1 );
+            if ( iptrDiff == 0 ) {
+                if ( aDequeue.compare_exchange_weak( sPos, sPos + 1, std::memory_order_relaxed ) ) { break; }
+            }
+            else if ( iptrDiff < 0 ) { return nullptr; }
+            else { sPos = aDequeue.load( std::memory_order_relaxed ); }
+        }
+        NN9_TASK * ptTask = pcCell->ptTask;
+        pcCell->aSequence.store( sPos + NN9_TP_QUEUE_SIZE, std::memory_order_release );
+        return ptTask;
+    }
+
 }	// namespace nn9
@@ -8,14 +8,18 @@
 
 #pragma once
 
-#include <vector>
-#include <thread>
-#include <queue>
-#include <mutex>
-#include <condition_variable>
+#include "../Foundation/NN9Macros.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
 #include <functional>
 #include <future>
+#include <memory>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 // Include platform-specific headers
 #if defined( __APPLE__ )
@@ -27,9 +31,11 @@ namespace nn9 {
 
     /**
 	 * Class ThreadPool
-	 * \brief A simple thread pool implementation that supports task submission and thread affinity.
+	 * \brief A work-stealing thread pool that supports task submission and thread affinity.
 	 *
-	 * Description: A thread pool, providing worker threads associated with cores and results obtained with future promises.
+	 * Description: A thread pool, providing worker threads associated with cores and results obtained with future promises.  Each worker
+	 *	owns a Chase-Lev deque; tasks pushed from a worker go onto its own deque and tasks pushed from any other thread go onto a shared
+	 *	lock-free queue.  Idle workers steal from each other and threads blocked in Wait() run tasks while they wait.
 	 */
 	class ThreadPool {
 	public :
@@ -37,6 +43,27 @@ namespace nn9 {
 		~ThreadPool();                          // Destructor: Joins all threads.
 
 
+		// == Enumerations.
+		/** Queue sizes. */
+		enum NN9_THREAD_POOL : size_t {
+			NN9_TP_DEQUE_SIZE					= 1 << 12,								/**< Tasks each worker deque can hold.  Must be a power of 2. */
+			NN9_TP_QUEUE_SIZE					= 1 << 12,								/**< Tasks the shared queue can hold.  Must be a power of 2. */
+			NN9_TP_SPINS						= 64,									/**< Times an idle worker looks for work before sleeping. */
+		};
+
+
+		// == Types.
+		/**
+		 * A task that can be pushed without allocating.  The task is owned by the caller and must stay alive until it has run; the same task
+		 *	may be pushed several times, in which case it runs once per push.  pfFunc must not throw.
+		 */
+		struct NN9_TASK {
+			void								(* pfFunc)( void * ) = nullptr;			/**< The function to run. */
+			void *								pvParm = nullptr;						/**< The parameter passed to pfFunc. */
+			std::atomic<size_t> *				paPending = nullptr;					/**< If not nullptr, decremented after each run of pfFunc. */
+		};
+
+
 		// == Functions.
 		/**
 		 * \brief Submits a task to the thread pool.
@@ -55,13 +82,234 @@ namespace nn9 {
 		inline auto								Submit( F && _fF, Args && ... _aArgs )
 			-> std::future<typename std::invoke_result_t<F, Args ...>>;
 
+		/**
+		 * Pushes a caller-owned task without allocating.  From a worker of this pool the task goes onto the worker's own deque, otherwise it
+		 *	goes onto the shared queue.  If the target queue is full, or the pool has no workers, the task is run immediately on the calling
+		 *	thread.
+		 *
+		 * \param _ptTask The task to push.  Its paPending counter, if any, must already account for this push.
+		 * \throws std::runtime_error if the thread pool is stopped.
+		 */
+		void									Push( NN9_TASK * _ptTask );
+
+		/**
+		 * Waits for a counter to reach 0, running queued tasks on the calling thread until it does.
+		 *
+		 * \param _aPending The counter to wait on, typically the paPending of tasks given to Push().
+		 */
+		void									Wait( const std::atomic<size_t> &_aPending );
+
+		/**
+		 * Calls a function over subranges of [_sBegin, _sEnd) in parallel and returns once all have finished.  The range is split in halves
+		 *	recursively, with one half pushed for other threads to steal and the other half run by the caller, down to subranges of at most
+		 *	_sGrain indices.  Split points fall on multiples of _sGrain from _sBegin, so every subrange but the last is exactly _sGrain long.
+		 *	Nothing is allocated and calls may be nested freely, including from inside _fFunc.
+		 *
+		 * \tparam _tFunc The function type, called as _fFunc( size_t _sSubBegin, size_t _sSubEnd ).
+		 * \param _sBegin The start of the range.
+		 * \param _sEnd The end of the range.
+		 * \param _sGrain The largest subrange to pass to _fFunc.  If 0, a grain giving about 4 subranges per thread is used.
+		 * \param _fFunc The function to call on each subrange.
+		 * \throw Rethrows the first exception thrown by _fFunc, after all subranges have stopped.
+		 */
+		template <typename _tFunc>
+		inline void								ParallelFor( size_t _sBegin, size_t _sEnd, size_t _sGrain, const _tFunc &_fFunc );
+
+		/**
+		 * Maps subranges of [_sBegin, _sEnd) to values in parallel and combines the values.  The range is split exactly as in ParallelFor()
+		 *	and values are combined pairwise up the same tree, left with right, so the result does not depend on which threads ran what.
+		 *
+		 * \tparam _tType The value type.  Must be copy-assignable.
+		 * \tparam _tMap The map type, called as _mMap( size_t _sSubBegin, size_t _sSubEnd ) and returning a _tType.
+		 * \tparam _tCombine The combine type, called as _cCombine( const _tType &_tLeft, const _tType &_tRight ) and returning a _tType.
+		 * \param _sBegin The start of the range.
+		 * \param _sEnd The end of the range.
+		 * \param _sGrain The largest subrange to pass to _mMap.  If 0, a grain giving about 4 subranges per thread is used.
+		 * \param _tIdentity The value returned for an empty range.
+		 * \param _mMap The function mapping a subrange to a value.
+		 * \param _cCombine The function combining 2 values.
+		 * \throw Rethrows the first exception thrown by _mMap or _cCombine, after all subranges have stopped.
+		 * \return Returns the combined value.
+		 */
+		template <typename _tType, typename _tMap, typename _tCombine>
+		inline _tType							ParallelReduce( size_t _sBegin, size_t _sEnd, size_t _sGrain, const _tType &_tIdentity,
+			const _tMap &_mMap, const _tCombine &_cCombine );
+
+		/**
+		 * Gets the number of worker threads in the pool.
+		 *
+		 * \return Returns the number of worker threads in the pool.
+		 */
+		inline size_t							Size() const { return m_sThreads; }
+
+		/**
+		 * Determines whether the calling thread is a worker thread of any ThreadPool.
+		 *
+		 * \return Returns true if the calling thread is a pool worker.
+		 */
+		static inline bool						IsWorker() { return m_ptpOwner != nullptr; }
+
+		/**
+		 * Gets the shared pool, with one thread per core, that is used for data-parallel operations.  It is created on first use.
+		 *
+		 * \return Returns the shared pool.
+		 */
+		static ThreadPool &						Global();
+
 
 	private :
+		// == Types.
+		/**
+		 * A fixed-size Chase-Lev deque.  Only the owning worker calls Push() and Take(); any thread may call Steal().
+		 */
+		struct NN9_ALIGN( 64 ) NN9_DEQUE {
+			std::atomic<int64_t>				aTop = 0;								/**< The index stolen from. */
+			NN9_ALIGN( 64 ) std::atomic<int64_t>
+												aBottom = 0;							/**< The index the owner pushes to and takes from. */
+			NN9_ALIGN( 64 ) std::atomic<NN9_TASK *>
+												aTasks[NN9_TP_DEQUE_SIZE];				/**< The ring of tasks. */
+
+
+			// == Functions.
+			/**
+			 * Pushes a task onto the bottom of the deque.  Owner only.
+			 *
+			 * \param _ptTask The task to push.
+			 * \return Returns false if the deque is full.
+			 */
+			bool								Push( NN9_TASK * _ptTask );
+
+			/**
+			 * Takes the most recently pushed task from the bottom of the deque.  Owner only.
+			 *
+			 * \return Returns the task or nullptr if the deque is empty.
+			 */
+			NN9_TASK *							Take();
+
+			/**
+			 * Steals the oldest task from the top of the deque.
+			 *
+			 * \return Returns the task or nullptr if the deque is empty or another thread won the race.
+			 */
+			NN9_TASK *							Steal();
+		};
+
+		/**
+		 * A fixed-size multi-producer/multi-consumer queue used for tasks pushed from outside the pool.
+		 */
+		struct NN9_QUEUE {
+			/** A slot in the ring. */
+			struct NN9_CELL {
+				std::atomic<size_t>				aSequence;								/**< The enqueue/dequeue generation of the slot. */
+				NN9_TASK *						ptTask;									/**< The task held in the slot. */
+			};
+
+			NN9_QUEUE();
+
+			NN9_ALIGN( 64 ) std::atomic<size_t>	aEnqueue = 0;							/**< The next enqueue position. */
+			NN9_ALIGN( 64 ) std::atomic<size_t>	aDequeue = 0;							/**< The next dequeue position. */
+			NN9_ALIGN( 64 ) NN9_CELL			cCells[NN9_TP_QUEUE_SIZE];				/**< The ring of tasks. */
+
+
+			// == Functions.
+			/**
+			 * Adds a task to the queue.
+			 *
+			 * \param _ptTask The task to add.
+			 * \return Returns false if the queue is full.
+			 */
+			bool								Push( NN9_TASK * _ptTask );
+
+			/**
+			 * Removes the oldest task from the queue.
+			 *
+			 * \return Returns the task or nullptr if the queue is empty.
+			 */
+			NN9_TASK *							Pop();
+		};
+
+
+		/**
+		 * The shared state of a ParallelReduce() call.
+		 */
+		template <typename _tType, typename _tMap, typename _tCombine>
+		struct NN9_REDUCE {
+			NN9_REDUCE( ThreadPool * _ptpPool, size_t _sGrain, const _tType &_tIdentity, const _tMap &_mMap, const _tCombine &_cCombine ) :
+				ptpPool( _ptpPool ),
+				sGrain( _sGrain ),
+				tIdentity( _tIdentity ),
+				mMap( _mMap ),
+				cCombine( _cCombine ) {
+			}
+
+			ThreadPool *						ptpPool;								/**< The pool to push to. */
+			size_t								sGrain;									/**< The largest subrange. */
+			const _tType &						tIdentity;								/**< The value of a skipped or empty subrange. */
+			const _tMap &						mMap;									/**< Maps a subrange to a value. */
+			const _tCombine &					cCombine;								/**< Combines 2 values. */
+			std::atomic<bool>					aFailed { false };						/**< Set once anything has thrown. */
+			std::exception_ptr					epError;								/**< The first exception thrown. */
+
+
+			// == Functions.
+			/**
+			 * Reduces a subrange, pushing its right half and running its left half.  Never throws.
+			 *
+			 * \param _sBegin The start of the subrange.
+			 * \param _sEnd The end of the subrange.
+			 * \return Returns the reduced value of the subrange.
+			 */
+			_tType								Reduce( size_t _sBegin, size_t _sEnd );
+
+			/**
+			 * Records the exception currently being handled, keeping only the first.
+			 */
+			void								Fail() {
+				if ( !aFailed.exchange( true ) ) { epError = std::current_exception(); }
+			}
+		};
+
+
+		// == Members.
 		std::vector<std::thread>                m_vWorkers;                             /**< Vector holding all worker threads. */
-		std::queue<std::function<void()>>       m_qTasks;                               /**< Task queue where incoming tasks are stored. */
-		std::mutex                              m_mQueueMutex;                          /**< Mutex for synchronizing access to the task queue. */
-		std::condition_variable                 m_cvCondition;                          /**< Condition variable for notifying worker threads of new tasks. */
-		bool                                    m_bStop;                                /**< Flag indicating whether the thread pool is stopping. */
+		const size_t							m_sThreads;								/**< The number of workers, fixed before any are started. */
+		std::unique_ptr<NN9_DEQUE []>			m_pdDeques;								/**< One deque per worker. */
+		std::unique_ptr<NN9_QUEUE>				m_pqShared;								/**< Tasks pushed from outside the pool. */
+		std::atomic<uint32_t>					m_aWake = 0;							/**< Incremented to wake sleeping workers. */
+		std::atomic<uint32_t>					m_aDone = 0;							/**< Incremented to wake threads blocked in Wait(). */
+		std::atomic<size_t>						m_aSleepers = 0;						/**< Workers sleeping on m_aWake. */
+		std::atomic<size_t>						m_aWaiters = 0;							/**< Threads sleeping on m_aDone. */
+		std::atomic<bool>                       m_bStop = false;                        /**< Flag indicating whether the thread pool is stopping. */
+		static thread_local ThreadPool *		m_ptpOwner;								/**< The pool of which the calling thread is a worker. */
+		static thread_local size_t				m_sWorkerIndex;							/**< The index of the calling worker within m_ptpOwner. */
+
+
+		// == Functions.
+		/**
+		 * The main loop of each worker.
+		 *
+		 * \param _sIndex The index of the worker.
+		 */
+		void									WorkerLoop( size_t _sIndex );
+
+		/**
+		 * Finds a task to run: first from the calling worker's own deque, then from the shared queue, then by stealing from other workers.
+		 *
+		 * \return Returns a task or nullptr if none was found.
+		 */
+		NN9_TASK *								FindTask();
+
+		/**
+		 * Runs a task and signals its counter.
+		 *
+		 * \param _ptTask The task to run.
+		 */
+		void									Run( NN9_TASK * _ptTask );
+
+		/**
+		 * Wakes a sleeping worker, if any.
+		 */
+		void									WakeOne();
 	};
 
 
@@ -87,28 +335,136 @@ namespace nn9 {
 		-> std::future<typename std::invoke_result_t<F, Args ...>> {
 		using return_type = typename std::invoke_result_t<F, Args ...>;
 
-		// Create a packaged task.
-		auto aTask = std::make_shared<std::packaged_task<return_type()>>(
-			std::bind( std::forward<F>( _fF ), std::forward<Args>( _aArgs ) ... ));
+		// Don't allow adding tasks after stopping the pool.
+		if ( m_bStop.load( std::memory_order_relaxed ) ) {
+			throw std::runtime_error( "ThreadPool::Submit: Cannot submit to a stopped ThreadPool." );
+		}
+
+		// The packaged task and the pool task live together and are freed once the task has run.
+		struct NN9_OWNED {
+			NN9_TASK							tTask;
+			std::packaged_task<return_type()>	ptTask;
+		};
+		std::unique_ptr<NN9_OWNED> upoTask( new NN9_OWNED{ {},
+			std::packaged_task<return_type()>( std::bind( std::forward<F>( _fF ), std::forward<Args>( _aArgs ) ... ) ) } );
+		upoTask->tTask.pfFunc = []( void * _pvParm ) {
+			std::unique_ptr<NN9_OWNED> upoThis( static_cast<NN9_OWNED *>(_pvParm) );
+			upoThis->ptTask();
+		};
+		upoTask->tTask.pvParm = upoTask.get();
 
 		// Get the future.
-		std::future<return_type> fRes = aTask->get_future();
+		std::future<return_type> fRes = upoTask->ptTask.get_future();
 
-		// Add the task to the queue.
-		{
-			std::unique_lock<std::mutex> ulLock( m_mQueueMutex );
+		Push( &upoTask->tTask );
+		upoTask.release();
+		return fRes;
+	}
 
-			// Don't allow adding tasks after stopping the pool.
-			if ( m_bStop ) {
-				throw std::runtime_error( "ThreadPool::Submit: Cannot submit to a stopped ThreadPool." );
-			}
+	/**
+	 * Calls a function over subranges of [_sBegin, _sEnd) in parallel and returns once all have finished.  The range is split in halves
+	 *	recursively, with one half pushed for other threads to steal and the other half run by the caller, down to subranges of at most
+	 *	_sGrain indices.  Split points fall on multiples of _sGrain from _sBegin, so every subrange but the last is exactly _sGrain long.
+	 *	Nothing is allocated and calls may be nested freely, including from inside _fFunc.
+	 *
+	 * \tparam _tFunc The function type, called as _fFunc( size_t _sSubBegin, size_t _sSubEnd ).
+	 * \param _sBegin The start of the range.
+	 * \param _sEnd The end of the range.
+	 * \param _sGrain The largest subrange to pass to _fFunc.  If 0, a grain giving about 4 subranges per thread is used.
+	 * \param _fFunc The function to call on each subrange.
+	 * \throw Rethrows the first exception thrown by _fFunc, after all subranges have stopped.
+	 */
+	template <typename _tFunc>
+	inline void ThreadPool::ParallelFor( size_t _sBegin, size_t _sEnd, size_t _sGrain, const _tFunc &_fFunc ) {
+		// A reduction over a dummy value; the combine step compiles away.
+		const char cNone = 0;
+		ParallelReduce( _sBegin, _sEnd, _sGrain, cNone,
+			[&]( size_t _sSubBegin, size_t _sSubEnd ) { _fFunc( _sSubBegin, _sSubEnd ); return cNone; },
+			[]( char, char ) { return char( 0 ); } );
+	}
 
-			m_qTasks.emplace( [aTask]() { (*aTask)(); } );
+	/**
+	 * Maps subranges of [_sBegin, _sEnd) to values in parallel and combines the values.  The range is split exactly as in ParallelFor()
+	 *	and values are combined pairwise up the same tree, left with right, so the result does not depend on which threads ran what.
+	 *
+	 * \tparam _tType The value type.  Must be copy-assignable.
+	 * \tparam _tMap The map type, called as _mMap( size_t _sSubBegin, size_t _sSubEnd ) and returning a _tType.
+	 * \tparam _tCombine The combine type, called as _cCombine( const _tType &_tLeft, const _tType &_tRight ) and returning a _tType.
+	 * \param _sBegin The start of the range.
+	 * \param _sEnd The end of the range.
+	 * \param _sGrain The largest subrange to pass to _mMap.  If 0, a grain giving about 4 subranges per thread is used.
+	 * \param _tIdentity The value returned for an empty range.
+	 * \param _mMap The function mapping a subrange to a value.
+	 * \param _cCombine The function combining 2 values.
+	 * \throw Rethrows the first exception thrown by _mMap or _cCombine, after all subranges have stopped.
+	 * \return Returns the combined value.
+	 */
+	template <typename _tType, typename _tMap, typename _tCombine>
+	inline _tType ThreadPool::ParallelReduce( size_t _sBegin, size_t _sEnd, size_t _sGrain, const _tType &_tIdentity,
+		const _tMap &_mMap, const _tCombine &_cCombine ) {
+		if ( _sEnd <= _sBegin ) { return _tIdentity; }
+		const size_t sTotal = _sEnd - _sBegin;
+		if ( !_sGrain ) { _sGrain = std::max<size_t>( sTotal / (std::max<size_t>( m_sThreads, 1 ) * 4), 1 ); }
+		if ( sTotal <= _sGrain ) { return _mMap( _sBegin, _sEnd ); }
+
+		NN9_REDUCE<_tType, _tMap, _tCombine> rReduce( this, _sGrain, _tIdentity, _mMap, _cCombine );
+		_tType tResult = rReduce.Reduce( _sBegin, _sEnd );
+		if ( rReduce.epError ) { std::rethrow_exception( rReduce.epError ); }
+		return tResult;
+	}
+
+	/**
+	 * Reduces a subrange, pushing its right half and running its left half.  Never throws.
+	 *
+	 * \param _sBegin The start of the subrange.
+	 * \param _sEnd The end of the subrange.
+	 * \return Returns the reduced value of the subrange.
+	 */
+	template <typename _tType, typename _tMap, typename _tCombine>
+	inline _tType ThreadPool::NN9_REDUCE<_tType, _tMap, _tCombine>::Reduce( size_t _sBegin, size_t _sEnd ) {
+		if ( aFailed.load( std::memory_order_relaxed ) ) { return tIdentity; }
+		const size_t sPieces = (_sEnd - _sBegin + sGrain - 1) / sGrain;
+		if ( sPieces <= 1 ) {
+			try { return mMap( _sBegin, _sEnd ); }
+			catch ( ... ) { Fail(); return tIdentity; }
+		}
+		const size_t sMid = _sBegin + (sPieces / 2) * sGrain;
+		if ( !ptpPool->m_sThreads ) {
+			// Without workers both halves run here, still split and combined along the same tree.
+			_tType tLeft = Reduce( _sBegin, sMid );
+			_tType tRight = Reduce( sMid, _sEnd );
+			if ( aFailed.load( std::memory_order_relaxed ) ) { return tIdentity; }
+			try { return cCombine( tLeft, tRight ); }
+			catch ( ... ) { Fail(); return tIdentity; }
 		}
 
-		// Notify one waiting thread.
-		m_cvCondition.notify_one();
-		return fRes;
+		// The right half goes to the pool; it lives on this stack frame until Wait() returns.
+		struct NN9_RIGHT {
+			NN9_REDUCE *						prThis;
+			size_t								sBegin;
+			size_t								sEnd;
+			_tType								tResult;
+		} rRight { this, sMid, _sEnd, tIdentity };
+		std::atomic<size_t> aPending = 1;
+		NN9_TASK tTask;
+		tTask.pfFunc = []( void * _pvParm ) {
+			NN9_RIGHT * prRight = static_cast<NN9_RIGHT *>(_pvParm);
+			prRight->tResult = prRight->prThis->Reduce( prRight->sBegin, prRight->sEnd );
+		};
+		tTask.pvParm = &rRight;
+		tTask.paPending = &aPending;
+		try { ptpPool->Push( &tTask ); }
+		catch ( ... ) {
+			// The pool is stopping; run the right half here.
+			aPending = 0;
+			rRight.tResult = Reduce( rRight.sBegin, rRight.sEnd );
+		}
+
+		_tType tLeft = Reduce( _sBegin, sMid );
+		ptpPool->Wait( aPending );
+		if ( aFailed.load( std::memory_order_relaxed ) ) { return tIdentity; }
+		try { return cCombine( tLeft, rRight.tResult ); }
+		catch ( ... ) { Fail(); return tIdentity; }
 	}
 
 }	// namespace nn9
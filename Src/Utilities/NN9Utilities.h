@@ -1035,6 +1035,15 @@ namespace nn9 {
 			return FeatureSet::AVX_VNNI();
 		}
 
+		/**
+		 * Is AVX-512 VNNI supported?
+		 *
+		 * \return Returns true if AVX-512 VNNI is supported.
+		 **/
+		static inline bool									IsAvx512VNNISupported() {
+			return FeatureSet::AVX512VNNI();
+		}
+
 		/**
 		 * Is NEON supported?
 		 *